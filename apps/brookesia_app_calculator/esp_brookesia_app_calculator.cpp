@@ -53,6 +53,7 @@ Calculator::Calculator():
         .enable_default_screen = 1,
         .enable_recycle_resource = 0,
         .enable_resize_visual_area = 1,
+        .enable_retain_screen = 1,
     },
 },
 {
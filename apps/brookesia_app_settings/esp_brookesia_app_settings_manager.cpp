@@ -176,6 +176,10 @@ namespace esp_brookesia::apps
     {
         ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
+        // Stop the storage service from posting UI commands, then drop the pending ones
+        _storage_service_connection.disconnect();
+        LvCommandQueue::getInstance().cancel(this);
+
         if (!checkClosed())
         {
             ESP_UTILS_CHECK_FALSE_EXIT(processClose(), "Close failed");
@@ -191,7 +195,7 @@ namespace esp_brookesia::apps
         ESP_UTILS_CHECK_FALSE_RETURN(initWlan(), false, "Init WLAN failed");
 
         auto &storage_service = StorageNVS::requestInstance();
-        storage_service.connectEventSignal([this](const StorageNVS::Event &event)
+        _storage_service_connection = storage_service.connectEventSignal([this](const StorageNVS::Event &event)
                                            {
         if ((event.operation != StorageNVS::Operation::UpdateNVS) || (event.sender == this)) {
             ESP_UTILS_LOGD("Ignore event: operation(%d), sender(%p)", static_cast<int>(event.operation), event.sender);
@@ -1590,39 +1594,42 @@ namespace esp_brookesia::apps
     {
         ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
-        if (ui.checkInitialized())
-        {
-            LvLockGuard gui_guard;
-
-            // Process WLAN switch
-            lv_obj_t *wlan_sw = ui.screen_wlan.getElementObject(
-                static_cast<int>(SettingsUI_ScreenWlanContainerIndex::CONTROL),
-                static_cast<int>(SettingsUI_ScreenWlanCellIndex::CONTROL_SW),
-                SettingsUI_WidgetCellElement::RIGHT_SWITCH);
-            ESP_UTILS_CHECK_NULL_RETURN(wlan_sw, false, "Get WLAN switch failed");
-            if (is_open)
+        // Update in the LVGL task instead of locking it, only the latest value is applied
+        auto tag = static_cast<uint32_t>(StorageCommandTag::WLAN_SWITCH);
+        ESP_UTILS_CHECK_FALSE_RETURN(LvCommandQueue::getInstance().post(this, tag, [this, is_open]()
+                                                                        {
+            if (ui.checkInitialized())
             {
-                lv_obj_add_state(wlan_sw, LV_STATE_CHECKED);
+                // Process WLAN switch
+                lv_obj_t *wlan_sw = ui.screen_wlan.getElementObject(
+                    static_cast<int>(SettingsUI_ScreenWlanContainerIndex::CONTROL),
+                    static_cast<int>(SettingsUI_ScreenWlanCellIndex::CONTROL_SW),
+                    SettingsUI_WidgetCellElement::RIGHT_SWITCH);
+                ESP_UTILS_CHECK_NULL_EXIT(wlan_sw, "Get WLAN switch failed");
+                if (is_open)
+                {
+                    lv_obj_add_state(wlan_sw, LV_STATE_CHECKED);
+                }
+                else
+                {
+                    lv_obj_remove_state(wlan_sw, LV_STATE_CHECKED);
+                }
+                lv_obj_send_event(wlan_sw, LV_EVENT_VALUE_CHANGED, nullptr);
             }
             else
             {
-                lv_obj_remove_state(wlan_sw, LV_STATE_CHECKED);
-            }
-            lv_obj_send_event(wlan_sw, LV_EVENT_VALUE_CHANGED, nullptr);
-        }
-        else
-        {
-            boost::thread([this, is_open]()
-                          {
-            ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+                boost::thread([this, is_open]()
+                              {
+                ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
-            _is_wlan_sw_flag = is_open;
-            ESP_UTILS_CHECK_FALSE_EXIT(
-                forceWlanOperation(is_open ? WlanOperation::START : WlanOperation::STOP, WLAN_START_WAIT_TIMEOUT_MS),
-                "Force WLAN operation start/stop failed"
-            ); })
-                .detach();
-        }
+                _is_wlan_sw_flag = is_open;
+                ESP_UTILS_CHECK_FALSE_EXIT(
+                    forceWlanOperation(is_open ? WlanOperation::START : WlanOperation::STOP, WLAN_START_WAIT_TIMEOUT_MS),
+                    "Force WLAN operation start/stop failed"
+                ); })
+                    .detach();
+            } }),
+                                     false, "Post WLAN switch update failed");
 
         return true;
     }
@@ -1631,17 +1638,22 @@ namespace esp_brookesia::apps
     {
         ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
-        if (ui.checkInitialized())
-        {
-            LvLockGuard gui_guard;
+        // Update in the LVGL task instead of locking it, only the latest value is applied
+        auto tag = static_cast<uint32_t>(StorageCommandTag::VOLUME);
+        ESP_UTILS_CHECK_FALSE_RETURN(LvCommandQueue::getInstance().post(this, tag, [this, volume]()
+                                                                        {
+            if (!ui.checkInitialized())
+            {
+                return;
+            }
 
             auto volume_slider = ui.screen_sound.getElementObject(
                 static_cast<int>(SettingsUI_ScreenSoundContainerIndex::VOLUME),
                 static_cast<int>(SettingsUI_ScreenSoundCellIndex::VOLUME_SLIDER),
                 SettingsUI_WidgetCellElement::CENTER_SLIDER);
-            ESP_UTILS_CHECK_NULL_RETURN(volume_slider, false, "Get cell volume slider failed");
-            lv_slider_set_value(volume_slider, volume, LV_ANIM_OFF);
-        }
+            ESP_UTILS_CHECK_NULL_EXIT(volume_slider, "Get cell volume slider failed");
+            lv_slider_set_value(volume_slider, volume, LV_ANIM_OFF); }),
+                                     false, "Post volume update failed");
 
         return true;
     }
@@ -1650,17 +1662,22 @@ namespace esp_brookesia::apps
     {
         ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
-        if (ui.checkInitialized())
-        {
-            LvLockGuard gui_guard;
+        // Update in the LVGL task instead of locking it, only the latest value is applied
+        auto tag = static_cast<uint32_t>(StorageCommandTag::BRIGHTNESS);
+        ESP_UTILS_CHECK_FALSE_RETURN(LvCommandQueue::getInstance().post(this, tag, [this, brightness]()
+                                                                        {
+            if (!ui.checkInitialized())
+            {
+                return;
+            }
 
             auto brightness_slider = ui.screen_display.getElementObject(
                 static_cast<int>(SettingsUI_ScreenDisplayContainerIndex::BRIGHTNESS),
                 static_cast<int>(SettingsUI_ScreenDisplayCellIndex::BRIGHTNESS_SLIDER),
                 SettingsUI_WidgetCellElement::CENTER_SLIDER);
-            ESP_UTILS_CHECK_NULL_RETURN(brightness_slider, false, "Get cell display slider failed");
-            lv_slider_set_value(brightness_slider, brightness, LV_ANIM_OFF);
-        }
+            ESP_UTILS_CHECK_NULL_EXIT(brightness_slider, "Get cell display slider failed");
+            lv_slider_set_value(brightness_slider, brightness, LV_ANIM_OFF); }),
+                                     false, "Post brightness update failed");
 
         return true;
     }
@@ -176,6 +176,13 @@ namespace esp_brookesia::apps
             SCAN_STOP,
         };
         using WlanEvent = std::variant<wifi_event_t, ip_event_t>;
+        // Keys of the UI commands posted by the storage service
+        enum class StorageCommandTag : uint32_t
+        {
+            WLAN_SWITCH,
+            VOLUME,
+            BRIGHTNESS,
+        };
 
         // // Data
         // friend WlanGeneraState operator|(WlanGeneraState lhs, WlanGeneraState rhs);
@@ -282,6 +289,7 @@ namespace esp_brookesia::apps
         static void onWlanEventHandler(void *arg, esp_event_base_t event_base, int32_t event_id, void *event_data);
         SettingsUI_ScreenWlan::WlanData getWlanDataFromApInfo(wifi_ap_record_t &ap_info);
 
+        boost::signals2::scoped_connection _storage_service_connection;
         UI_Screen _ui_current_screen;
         std::atomic<bool> _is_ui_initialized = false;
         // All screens
@@ -0,0 +1,184 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include "audio_uplink_encoder.hpp"
+
+namespace esp_brookesia::ai_framework {
+
+namespace {
+
+constexpr char BASE64_CHARS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Output characters of each 12 bits of input
+constexpr auto BASE64_PAIRS = []() {
+    std::array<std::array<char, 2>, 4096> pairs{};
+    for (size_t i = 0; i < pairs.size(); i++) {
+        pairs[i] = {BASE64_CHARS[i >> 6], BASE64_CHARS[i & 0x3F]};
+    }
+    return pairs;
+}();
+
+// Last 1 or 2 bytes, with padding
+size_t encode_tail(const uint8_t *src, size_t size, char *dst)
+{
+    if (size == 0) {
+        return 0;
+    }
+    uint32_t value = static_cast<uint32_t>(src[0]) << 16;
+    if (size > 1) {
+        value |= static_cast<uint32_t>(src[1]) << 8;
+    }
+    dst[0] = BASE64_CHARS[(value >> 18) & 0x3F];
+    dst[1] = BASE64_CHARS[(value >> 12) & 0x3F];
+    dst[2] = (size > 1) ? BASE64_CHARS[(value >> 6) & 0x3F] : '=';
+    dst[3] = '=';
+
+    return 4;
+}
+
+} // namespace
+
+size_t Base64Encoder::encode(const uint8_t *src, size_t size, char *dst)
+{
+    char *out = dst;
+    size_t full_size = size - size % 3;
+    for (size_t i = 0; i < full_size; i += 3) {
+        uint32_t value = (static_cast<uint32_t>(src[i]) << 16) | (static_cast<uint32_t>(src[i + 1]) << 8) | src[i + 2];
+        std::memcpy(out, BASE64_PAIRS[value >> 12].data(), 2);
+        std::memcpy(out + 2, BASE64_PAIRS[value & 0xFFF].data(), 2);
+        out += 4;
+    }
+    out += encode_tail(src + full_size, size - full_size, out);
+
+    return out - dst;
+}
+
+size_t Base64Encoder::encodeScalar(const uint8_t *src, size_t size, char *dst)
+{
+    char *out = dst;
+    size_t full_size = size - size % 3;
+    for (size_t i = 0; i < full_size; i += 3) {
+        uint32_t value = (static_cast<uint32_t>(src[i]) << 16) | (static_cast<uint32_t>(src[i + 1]) << 8) | src[i + 2];
+        out[0] = BASE64_CHARS[(value >> 18) & 0x3F];
+        out[1] = BASE64_CHARS[(value >> 12) & 0x3F];
+        out[2] = BASE64_CHARS[(value >> 6) & 0x3F];
+        out[3] = BASE64_CHARS[value & 0x3F];
+        out += 4;
+    }
+    out += encode_tail(src + full_size, size - full_size, out);
+
+    return out - dst;
+}
+
+bool AudioUplinkEncoder::begin(const Config &config, SendFunction send)
+{
+    if ((config.frame_size == 0) || (config.max_batch_frames == 0) || !send) {
+        return false;
+    }
+
+    end();
+
+    size_t max_size = config.frame_size * config.max_batch_frames;
+    try {
+        pending_data_.reserve(max_size);
+        for (auto &buffer : encoded_buffers_) {
+            buffer.resize(Base64Encoder::getEncodedSize(max_size) + 1);
+        }
+    } catch (const std::bad_alloc &) {
+        end();
+        return false;
+    }
+    config_ = config;
+    send_ = std::move(send);
+
+    return true;
+}
+
+void AudioUplinkEncoder::end()
+{
+    pending_data_ = {};
+    for (auto &buffer : encoded_buffers_) {
+        buffer = {};
+    }
+    send_ = nullptr;
+    pending_frames_ = 0;
+    encoded_index_ = 0;
+    batch_frames_ = 1;
+    statistics_ = {};
+}
+
+bool AudioUplinkEncoder::push(const uint8_t *data, size_t size)
+{
+    if (!send_ || (size > config_.frame_size)) {
+        return false;
+    }
+
+    // Within the reserved capacity, no allocation
+    pending_data_.insert(pending_data_.end(), data, data + size);
+    pending_frames_++;
+    statistics_.pushed_frames++;
+
+    if (pending_frames_ < batch_frames_) {
+        return true;
+    }
+
+    return sendPending();
+}
+
+bool AudioUplinkEncoder::flush()
+{
+    if (!send_ || (pending_frames_ == 0)) {
+        return true;
+    }
+
+    return sendPending();
+}
+
+void AudioUplinkEncoder::reset()
+{
+    pending_data_.clear();
+    pending_frames_ = 0;
+    batch_frames_ = 1;
+}
+
+bool AudioUplinkEncoder::sendPending()
+{
+    auto &buffer = encoded_buffers_[encoded_index_];
+    size_t encoded_size = Base64Encoder::encode(pending_data_.data(), pending_data_.size(), buffer.data());
+    buffer[encoded_size] = '\0';
+    size_t frames = pending_frames_;
+    pending_data_.clear();
+    pending_frames_ = 0;
+
+    auto start_time = std::chrono::steady_clock::now();
+    bool result = send_(buffer.data(), encoded_size);
+    auto duration = std::chrono::steady_clock::now() - start_time;
+
+    // The next batch is encoded into the other buffer, this one stays valid until the next send returns
+    encoded_index_ ^= 1;
+
+    // Batch more frames while the link is slow, fewer once it recovers
+    if (duration > std::chrono::milliseconds(config_.congestion_threshold_ms)) {
+        statistics_.congested_sends++;
+        batch_frames_ = std::min(batch_frames_ * 2, config_.max_batch_frames);
+    } else if (batch_frames_ > 1) {
+        batch_frames_--;
+    }
+
+    if (!result) {
+        statistics_.failed_batches++;
+        return false;
+    }
+    statistics_.sent_batches++;
+    statistics_.max_batch_frames = std::max(statistics_.max_batch_frames, frames);
+    statistics_.encoded_bytes += encoded_size;
+
+    return true;
+}
+
+} // namespace esp_brookesia::ai_framework
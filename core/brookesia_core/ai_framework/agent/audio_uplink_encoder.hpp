@@ -0,0 +1,135 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace esp_brookesia::ai_framework {
+
+/**
+ * @brief Base64 encoding of the uplink audio
+ *
+ * The default kernel converts each 3 input bytes with two lookups in a table of the 4096 pairs of output characters
+ * (8 KB of constant data), the scalar kernel with four lookups in the table of the 64 characters. Both write the
+ * padding but no null terminator.
+ */
+class Base64Encoder {
+public:
+    static constexpr size_t getEncodedSize(size_t size)
+    {
+        return ((size + 2) / 3) * 4;
+    }
+
+    /**
+     * @brief Encode with the pair table kernel
+     *
+     * @param[in] src Bytes to encode
+     * @param[in] size Number of bytes
+     * @param[out] dst Output of `getEncodedSize(size)` characters
+     * @return Number of characters written
+     */
+    static size_t encode(const uint8_t *src, size_t size, char *dst);
+
+    /**
+     * @brief Encode with the portable scalar kernel, same output as `encode()`
+     */
+    static size_t encodeScalar(const uint8_t *src, size_t size, char *dst);
+};
+
+/**
+ * @brief Streaming encoder of the uplink audio: buffers the recorded frames, encodes them in base64 and hands them
+ *        to the send function
+ *
+ * The buffers are allocated once in `begin()` and reused for the whole conversation. The output is null-terminated
+ * and double-buffered: the data of a send stays valid until the next send returns, so the send function may hand it
+ * over to another task instead of copying it. When a send is slower than the congestion threshold, the following
+ * frames are batched into a single send (up to `max_batch_frames`), and the batch shrinks again one frame per fast
+ * send. A batch is encoded as a whole, it decodes to its frames concatenated.
+ *
+ * @note Not thread-safe, meant to be driven by the audio read task only
+ */
+class AudioUplinkEncoder {
+public:
+    using SendFunction = std::function<bool(const char *data, size_t size)>;
+
+    struct Config {
+        size_t frame_size = 1024;               // Bytes of a recorded frame
+        size_t max_batch_frames = 4;            // Frames sent at once at most when the link is congested
+        uint32_t congestion_threshold_ms = 100; // Duration of a send above which the link is considered congested
+    };
+
+    struct Statistics {
+        size_t pushed_frames = 0;
+        size_t sent_batches = 0;
+        size_t failed_batches = 0;
+        size_t congested_sends = 0;
+        size_t max_batch_frames = 0;    // Largest batch sent
+        uint64_t encoded_bytes = 0;
+    };
+
+    /**
+     * @brief Allocate the buffers
+     *
+     * @param[in] config Configuration
+     * @param[in] send Function sending the base64 of a batch, returns false on failure
+     * @return true if successful, false if the configuration is invalid or out of memory
+     */
+    bool begin(const Config &config, SendFunction send);
+
+    /**
+     * @brief Release the buffers, the pending frames are dropped
+     */
+    void end();
+
+    /**
+     * @brief Add recorded data, sent once a batch is complete
+     *
+     * @param[in] data Recorded data, at most `frame_size` bytes
+     * @param[in] size Number of bytes
+     * @return false if not begun, the data is too large, or a send failed
+     */
+    bool push(const uint8_t *data, size_t size);
+
+    /**
+     * @brief Send the pending frames now, even if the batch is not complete
+     *
+     * @return true if nothing was pending or the send succeeded
+     */
+    bool flush();
+
+    /**
+     * @brief Drop the pending frames, e.g. when the uplink is paused, and restart with batches of one frame
+     */
+    void reset();
+
+    size_t getBatchFrames() const
+    {
+        return batch_frames_;
+    }
+    const Statistics &getStatistics() const
+    {
+        return statistics_;
+    }
+
+private:
+    bool sendPending();
+
+    Config config_;
+    SendFunction send_;
+    std::vector<uint8_t> pending_data_;
+    size_t pending_frames_ = 0;
+    std::array<std::vector<char>, 2> encoded_buffers_;
+    size_t encoded_index_ = 0;
+    size_t batch_frames_ = 1;
+    Statistics statistics_;
+};
+
+} // namespace esp_brookesia::ai_framework
@@ -4,7 +4,9 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <chrono>
 #include <mutex>
+#include <optional>
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
@@ -23,12 +25,16 @@
 #include "esp_coze_utils.h"
 #include "http_client_request.h"
 #include "cJSON.h"
-#include "mbedtls/base64.h"
 #include "boost/thread.hpp"
 #include "private/esp_brookesia_ai_agent_utils.hpp"
 #include "audio_processor.h"
 #include "function_calling.hpp"
+#include "audio_uplink_encoder.hpp"
+#include "coze_token_cache.hpp"
 #include "coze_chat_app.hpp"
+#if ESP_BROOKESIA_AGENT_PERSIST_COZE_TOKEN
+#include "nvs.h"
+#endif
 
 /*
  * 说话超时与静音延时相关配置：
@@ -43,6 +49,14 @@
  */
 #define AUDIO_RECORDER_READ_SIZE (1024)
 
+/*
+ * 音频上行批量发送参数：
+ * - AUDIO_UPLINK_MAX_BATCH_FRAMES：链路拥塞时单次发送合并的最大读取块数
+ * - AUDIO_UPLINK_CONGESTION_THRESHOLD_MS：单次发送耗时超过该值即视为链路拥塞（毫秒）
+ */
+#define AUDIO_UPLINK_MAX_BATCH_FRAMES (4)
+#define AUDIO_UPLINK_CONGESTION_THRESHOLD_MS (100)
+
 /*
  * 聊天中断参数：
  * - COZE_INTERRUPT_TIMES：发送取消上行音频的次数，用于尽快打断云端识别
@@ -51,6 +65,26 @@
 #define COZE_INTERRUPT_TIMES (20)
 #define COZE_INTERRUPT_INTERVAL_MS (100)
 
+/*
+ * 访问令牌缓存参数：
+ * - COZE_TOKEN_DURATION_S：申请的令牌有效期（秒）
+ * - COZE_TOKEN_REFRESH_MARGIN_S：令牌过期前提前在后台刷新的时间（秒）
+ * - COZE_TOKEN_REFRESH_THREAD_*：后台刷新线程配置（签发 JWT 与 HTTPS 请求需要较大的栈）
+ * - COZE_TOKEN_NVS_NAMESPACE/COZE_TOKEN_NVS_KEY_*：令牌持久化使用的独立 NVS 命名空间与键（不超过 15 个字符），
+ *   不经过 NVS 存储服务，令牌不会广播给其监听者
+ * - COZE_TOKEN_CLOCK_SYNCED_YEAR：系统时间达到该年份才视为已同步（SNTP），之前缓存的令牌均视为过期
+ */
+#define COZE_TOKEN_DURATION_S (86399)
+#define COZE_TOKEN_REFRESH_MARGIN_S (3600)
+#define COZE_TOKEN_REFRESH_THREAD_NAME "coze_token"
+#define COZE_TOKEN_REFRESH_THREAD_STACK_SIZE (8 * 1024)
+#define COZE_TOKEN_REFRESH_THREAD_STACK_CAPS_EXT (true)
+#define COZE_TOKEN_NVS_NAMESPACE "coze_token"
+#define COZE_TOKEN_NVS_KEY_TOKEN "token"
+#define COZE_TOKEN_NVS_KEY_EXPIRES_AT "expires_at"
+#define COZE_TOKEN_NVS_KEY_FINGERPRINT "fingerprint"
+#define COZE_TOKEN_CLOCK_SYNCED_YEAR (2024)
+
 using namespace esp_brookesia::ai_framework;
 
 /*
@@ -89,6 +123,10 @@ struct coze_chat_t
 static struct coze_chat_t coze_chat = {};
 // 获取访问令牌（access_token）的授权 URL，遵循 Coze 平台接口
 static const char *coze_authorization_url = "https://api.coze.cn/api/permission/oauth2/token";
+// 访问令牌缓存：重连时令牌有效则跳过 JWT 签发与 HTTP 请求
+static CozeTokenCache coze_token_cache;
+// 令牌缓存所属的代理身份指纹，代理信息变化时重建缓存
+static int32_t coze_token_fingerprint = 0;
 
 // 信号通道：用于向 UI/上层模块广播状态变化与事件
 boost::signals2::signal<void(const std::string &emoji)> coze_chat_emoji_signal; // 发送表情事件
@@ -341,7 +379,8 @@ static void audio_event_callback(esp_coze_chat_event_t event, char *data, void *
             ESP_UTILS_LOGE("Failed to parse JSON data");
             return;
         }
-        // debug
+#if ESP_UTILS_CONF_LOG_LEVEL == ESP_UTILS_LOG_LEVEL_DEBUG
+        // 仅在调试日志级别打印，避免在函数调用路径上分配和格式化 JSON
         cJSON *json_item = NULL;
         cJSON_ArrayForEach(json_item, json_data)
         {
@@ -349,11 +388,11 @@ static void audio_event_callback(esp_coze_chat_event_t event, char *data, void *
             char *value = cJSON_Print(json_item);
             if (key && value)
             {
-                ESP_UTILS_LOGI("Key: %s, Value: %s", key, value);
+                ESP_UTILS_LOGD("Key: %s, Value: %s", key, value);
                 cJSON_free(value);
             }
         }
-        //
+#endif
 
         cJSON *data_json = cJSON_GetObjectItem(json_data, "data");
         if (data_json == NULL)
@@ -387,27 +426,23 @@ static void audio_event_callback(esp_coze_chat_event_t event, char *data, void *
             return;
         }
 
-        cJSON *first_tool_call = cJSON_GetArrayItem(tool_calls, 0);
-        if (first_tool_call == NULL)
+        if (cJSON_GetArraySize(tool_calls) == 0)
         {
-            ESP_UTILS_LOGE("No first tool call found in tool_calls");
+            ESP_UTILS_LOGE("No tool call found in tool_calls");
             cJSON_Delete(json_data);
             return;
         }
 
-        char *function_str = cJSON_Print(first_tool_call);
-        if (function_str)
+        // 同一轮的多个工具调用依次解析参数后交给函数调用线程池执行
+        cJSON *tool_call = NULL;
+        cJSON_ArrayForEach(tool_call, tool_calls)
         {
-            ESP_UTILS_LOGI("Function JSON: %s", function_str);
-            free(function_str);
-        }
-        else
-        {
-            ESP_UTILS_LOGE("Failed to print function JSON");
+            if (!FunctionDefinitionList::requestInstance().invokeFunction(tool_call))
+            {
+                ESP_UTILS_LOGE("Invoke tool call failed");
+            }
         }
 
-        FunctionDefinitionList::requestInstance().invokeFunction(first_tool_call);
-
         cJSON_Delete(json_data);
     }
     else if (event == ESP_COZE_CHAT_EVENT_CHAT_SUBTITLE_EVENT)
@@ -497,18 +532,18 @@ void generate_random_string(char *output, size_t length)
  * 功能：基于 Agent 信息构建 JWT 并向授权服务器申请 access_token
  * 参数：
  *  - agent_info：代理信息（包含 app_id、公私钥、设备信息等）
- * 返回：分配的 access_token 字符串（由调用者负责 free）；NULL 表示失败
- * 使用示例：
- *   char *token = coze_get_access_token(info);
+ * 返回：access_token 及其过期时间；std::nullopt 表示失败
+ * 使用说明：
+ *  - 仅由令牌缓存在令牌缺失或即将过期时调用，重连时请使用 coze_token_cache.getToken()
  */
-static char *coze_get_access_token(const CozeChatAgentInfo &agent_info)
+static std::optional<CozeTokenCache::Token> coze_fetch_access_token(const CozeChatAgentInfo &agent_info)
 {
     // 构建 JWT payload：包含签发方、受众、签发/过期时间、随机 jti、会话上下文等
     cJSON *payload_json = cJSON_CreateObject();
     if (!payload_json)
     {
         ESP_UTILS_LOGE("Failed to create payload_json");
-        return NULL;
+        return std::nullopt;
     }
     char random_str[33] = {0};
     generate_random_string(random_str, 32);
@@ -531,7 +566,7 @@ static char *coze_get_access_token(const CozeChatAgentInfo &agent_info)
     {
         ESP_UTILS_LOGE("Failed to print payload_json");
         cJSON_Delete(payload_json);
-        return NULL;
+        return std::nullopt;
     }
     ESP_UTILS_LOGD("payload_str: %s\n", payload_str);
     char *formatted_payload_str = cJSON_Print(payload_json);
@@ -552,7 +587,7 @@ static char *coze_get_access_token(const CozeChatAgentInfo &agent_info)
     {
         ESP_UTILS_LOGE("Failed to create JWT");
         // payload_json and payload_str already freed above
-        return NULL;
+        return std::nullopt;
     }
 
     // 组装 Authorization 头（Bearer 模式）
@@ -561,7 +596,7 @@ static char *coze_get_access_token(const CozeChatAgentInfo &agent_info)
     {
         ESP_UTILS_LOGE("Failed to allocate authorization");
         free(jwt);
-        return NULL;
+        return std::nullopt;
     }
     sprintf(authorization, "Bearer %s", jwt);
     ESP_UTILS_LOGD("Authorization: %s", authorization);
@@ -572,9 +607,9 @@ static char *coze_get_access_token(const CozeChatAgentInfo &agent_info)
         ESP_UTILS_LOGE("Failed to create http_req_json");
         free(jwt);
         free(authorization);
-        return NULL;
+        return std::nullopt;
     }
-    cJSON_AddNumberToObject(http_req_json, "duration_seconds", 86399);
+    cJSON_AddNumberToObject(http_req_json, "duration_seconds", COZE_TOKEN_DURATION_S);
     cJSON_AddStringToObject(http_req_json, "grant_type", "urn:ietf:params:oauth:grant-type:jwt-bearer");
     char *http_req_json_str = cJSON_PrintUnformatted(http_req_json);
     if (!http_req_json_str)
@@ -583,7 +618,7 @@ static char *coze_get_access_token(const CozeChatAgentInfo &agent_info)
         free(jwt);
         free(authorization);
         cJSON_Delete(http_req_json);
-        return NULL;
+        return std::nullopt;
     }
 
     // 构造 HTTP 请求头
@@ -598,10 +633,15 @@ static char *coze_get_access_token(const CozeChatAgentInfo &agent_info)
     if (ret != ESP_OK)
     {
         ESP_UTILS_LOGE("HTTP POST failed");
-        return NULL;
+        free(jwt);
+        free(authorization);
+        cJSON_Delete(http_req_json);
+        free(http_req_json_str);
+        free(response.body);
+        return std::nullopt;
     }
 
-    char *access_token = NULL;
+    std::optional<CozeTokenCache::Token> access_token;
     if (response.body)
     {
         // 解析响应 JSON，提取 access_token、expires_in、token_type 等
@@ -614,17 +654,30 @@ static char *coze_get_access_token(const CozeChatAgentInfo &agent_info)
             if (cJSON_IsString(access_token_item) && access_token_item->valuestring != NULL)
             {
                 ESP_UTILS_LOGD("access_token: %s\n", access_token_item->valuestring);
-                access_token = strdup(access_token_item->valuestring);
+                access_token = CozeTokenCache::Token{
+                    .access_token = access_token_item->valuestring,
+                    .expires_at = CozeTokenCache::Clock::now() + std::chrono::seconds(COZE_TOKEN_DURATION_S),
+                };
             }
             else
             {
                 ESP_UTILS_LOGE("access_token is invalid or not exist");
             }
 
+            // expires_in 为过期时刻的 Unix 时间戳；若为相对秒数则按当前时间换算
             cJSON *expires_in_item = cJSON_GetObjectItem(root, "expires_in");
-            if (cJSON_IsNumber(expires_in_item))
+            if (cJSON_IsNumber(expires_in_item) && access_token.has_value())
             {
                 ESP_UTILS_LOGD("expires_in: %d\n", expires_in_item->valueint);
+                auto expires_in = static_cast<int64_t>(cJSON_GetNumberValue(expires_in_item));
+                if (expires_in > COZE_TOKEN_DURATION_S)
+                {
+                    access_token->expires_at = CozeTokenCache::Clock::from_time_t(static_cast<time_t>(expires_in));
+                }
+                else if (expires_in > 0)
+                {
+                    access_token->expires_at = CozeTokenCache::Clock::now() + std::chrono::seconds(expires_in);
+                }
             }
 
             cJSON *token_type_item = cJSON_GetObjectItem(root, "token_type");
@@ -730,9 +783,25 @@ static void audio_data_read_task(void *pv)
 
     uint8_t *data = (uint8_t *)esp_gmf_oal_calloc(1, AUDIO_RECORDER_READ_SIZE);
     int ret = 0;
-    size_t base64_len = 0;
-    unsigned char *base64_data = NULL;
-    size_t output_len = 0;
+
+    // 上行编码器：缓冲区在整个会话中复用，链路拥塞时合并多个读取块为一次发送
+    AudioUplinkEncoder uplink_encoder;
+    AudioUplinkEncoder::Config uplink_config = {
+        .frame_size = AUDIO_RECORDER_READ_SIZE,
+        .max_batch_frames = AUDIO_UPLINK_MAX_BATCH_FRAMES,
+        .congestion_threshold_ms = AUDIO_UPLINK_CONGESTION_THRESHOLD_MS,
+    };
+    bool is_encoder_ready = uplink_encoder.begin(uplink_config, [coze_chat](const char *base64_data, size_t size)
+    {
+        return esp_coze_chat_send_audio_data(coze_chat->chat, const_cast<char *>(base64_data), size) == ESP_OK;
+    });
+    if ((data == NULL) || !is_encoder_ready)
+    {
+        ESP_UTILS_LOGE("Failed to allocate memory for uplink audio");
+        esp_gmf_oal_free(data);
+        vTaskDelete(NULL);
+        return;
+    }
 
     while (true)
     {
@@ -740,27 +809,16 @@ static void audio_data_read_task(void *pv)
         // 仅在聊天启动、处于唤醒态、未暂停/未休眠、且当前非说话态时上传音频
         if (coze_chat->chat_start && coze_chat->wakeup && !coze_chat->chat_pause && !coze_chat->chat_sleep && !coze_chat->speaking)
         {
-            // Calculate required buffer size for Base64 (4 * (n + 2) / 3) + 1 for null terminator
-            base64_len = ((ret + 2) / 3) * 4 + 1;
-            base64_data = (unsigned char *)esp_gmf_oal_calloc(1, base64_len);
-
-            if (base64_data)
-            {
-                if (mbedtls_base64_encode(base64_data, base64_len, &output_len, data, ret) == 0)
-                {
-                    esp_coze_chat_send_audio_data(coze_chat->chat, (char *)base64_data, output_len);
-                }
-                else
-                {
-                    ESP_UTILS_LOGE("Base64 encode failed");
-                }
-                esp_gmf_oal_free(base64_data);
-            }
-            else
+            if ((ret > 0) && !uplink_encoder.push(data, ret))
             {
-                ESP_UTILS_LOGE("Failed to allocate memory for base64 data");
+                ESP_UTILS_LOGD("Failed to send uplink audio");
             }
         }
+        else
+        {
+            // 停止上传时丢弃未发送的数据，恢复后从单块发送开始
+            uplink_encoder.reset();
+        }
         // heap_caps_check_integrity_all(true);
     }
 }
@@ -821,6 +879,131 @@ extern "C" esp_err_t coze_chat_app_init(void)
     return ESP_OK;
 }
 
+/*
+ * 功能：计算代理身份的指纹（FNV-1a），用于区分不同代理签发的令牌
+ * 参数：
+ *  - agent_info：代理身份信息
+ * 返回：32 位指纹
+ */
+static int32_t coze_get_agent_fingerprint(const CozeChatAgentInfo &agent_info)
+{
+    uint32_t hash = 2166136261u;
+    for (const auto *field : {
+                &agent_info.app_id, &agent_info.session_name, &agent_info.device_id, &agent_info.custom_consumer,
+                &agent_info.user_id, &agent_info.public_key
+            })
+    {
+        for (auto c : *field)
+        {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+        }
+        hash = (hash ^ 0xFF) * 16777619u;
+    }
+
+    return static_cast<int32_t>(hash);
+}
+
+/*
+ * 功能：判断系统时间是否已同步（如通过 SNTP），令牌的过期时间为绝对时间，未同步前无法判断
+ * 返回：true 表示已同步
+ */
+static bool coze_is_clock_synced()
+{
+    time_t now = time(nullptr);
+    struct tm time_info = {};
+    localtime_r(&now, &time_info);
+
+    return (time_info.tm_year + 1900) >= COZE_TOKEN_CLOCK_SYNCED_YEAR;
+}
+
+/*
+ * 功能：按代理身份启动访问令牌缓存（首次调用或代理信息变化时），并从 NVS 恢复有效的令牌
+ * 参数：
+ *  - agent_info：代理身份信息
+ * 返回：true 表示缓存可用；false 表示启动失败
+ */
+static bool coze_token_cache_begin(const CozeChatAgentInfo &agent_info)
+{
+    int32_t fingerprint = coze_get_agent_fingerprint(agent_info);
+    if (coze_token_cache.isStarted())
+    {
+        if (fingerprint == coze_token_fingerprint)
+        {
+            return true;
+        }
+        coze_token_cache.end();
+    }
+    coze_token_fingerprint = fingerprint;
+
+    CozeTokenCache::LoadFunction load = nullptr;
+    CozeTokenCache::StoreFunction store = nullptr;
+#if ESP_BROOKESIA_AGENT_PERSIST_COZE_TOKEN
+    // 默认 NVS 分区须已加密（CONFIG_NVS_ENCRYPTION），令牌直接写入其独立命名空间
+    load = [fingerprint]() -> std::optional<CozeTokenCache::Token>
+    {
+        nvs_handle_t handle = 0;
+        if (nvs_open(COZE_TOKEN_NVS_NAMESPACE, NVS_READONLY, &handle) != ESP_OK)
+        {
+            return std::nullopt;
+        }
+        std::optional<CozeTokenCache::Token> token;
+        int32_t stored_fingerprint = 0;
+        int64_t expires_at = 0;
+        size_t token_size = 0;
+        if ((nvs_get_i32(handle, COZE_TOKEN_NVS_KEY_FINGERPRINT, &stored_fingerprint) == ESP_OK) &&
+            (stored_fingerprint == fingerprint) &&
+            (nvs_get_i64(handle, COZE_TOKEN_NVS_KEY_EXPIRES_AT, &expires_at) == ESP_OK) &&
+            (nvs_get_str(handle, COZE_TOKEN_NVS_KEY_TOKEN, nullptr, &token_size) == ESP_OK) && (token_size > 0))
+        {
+            std::string access_token(token_size, '\0');
+            if (nvs_get_str(handle, COZE_TOKEN_NVS_KEY_TOKEN, access_token.data(), &token_size) == ESP_OK)
+            {
+                access_token.resize(token_size - 1);
+                token = CozeTokenCache::Token{
+                    .access_token = std::move(access_token),
+                    .expires_at = CozeTokenCache::Clock::from_time_t(static_cast<time_t>(expires_at)),
+                };
+            }
+        }
+        nvs_close(handle);
+        return token;
+    };
+    store = [fingerprint](const CozeTokenCache::Token &token)
+    {
+        nvs_handle_t handle = 0;
+        ESP_UTILS_CHECK_FALSE_EXIT(
+            nvs_open(COZE_TOKEN_NVS_NAMESPACE, NVS_READWRITE, &handle) == ESP_OK, "Open token namespace failed"
+        );
+        auto expires_at = static_cast<int64_t>(CozeTokenCache::Clock::to_time_t(token.expires_at));
+        bool is_stored = (nvs_set_str(handle, COZE_TOKEN_NVS_KEY_TOKEN, token.access_token.c_str()) == ESP_OK) &&
+                         (nvs_set_i64(handle, COZE_TOKEN_NVS_KEY_EXPIRES_AT, expires_at) == ESP_OK) &&
+                         (nvs_set_i32(handle, COZE_TOKEN_NVS_KEY_FINGERPRINT, fingerprint) == ESP_OK) &&
+                         (nvs_commit(handle) == ESP_OK);
+        nvs_close(handle);
+        ESP_UTILS_CHECK_FALSE_EXIT(is_stored, "Persist access token failed");
+    };
+#endif
+
+    CozeTokenCache::Config config = {
+        .refresh_margin = std::chrono::seconds(COZE_TOKEN_REFRESH_MARGIN_S),
+        .is_clock_synced = coze_is_clock_synced,
+    };
+    // 后台刷新线程继承此处的线程配置
+    esp_utils::thread_config_guard thread_config(esp_utils::ThreadConfig{
+        .name = COZE_TOKEN_REFRESH_THREAD_NAME,
+        .stack_size = COZE_TOKEN_REFRESH_THREAD_STACK_SIZE,
+        .stack_in_ext = COZE_TOKEN_REFRESH_THREAD_STACK_CAPS_EXT,
+    });
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        coze_token_cache.begin(config, [agent_info]()
+    {
+        return coze_fetch_access_token(agent_info);
+    }, load, store), false, "Begin token cache failed"
+    );
+
+    return true;
+}
+
 /*
  * 功能：启动 Coze 聊天（获取 token、初始化会话、设置参数并开始）
  * 参数：
@@ -832,9 +1015,10 @@ extern "C" esp_err_t coze_chat_app_start(const CozeChatAgentInfo &agent_info, co
 {
     ESP_UTILS_LOG_TRACE_GUARD();
 
-    char *token_str = NULL;
-    token_str = coze_get_access_token(agent_info);
-    if (token_str == NULL)
+    // 令牌有效时直接使用缓存，跳过 JWT 签发与 HTTP 请求
+    ESP_UTILS_CHECK_FALSE_RETURN(coze_token_cache_begin(agent_info), ESP_FAIL, "Failed to begin token cache");
+    auto token = coze_token_cache.getToken();
+    if (!token.has_value())
     {
         ESP_UTILS_LOGE("Failed to get access token");
         return ESP_FAIL;
@@ -847,7 +1031,7 @@ extern "C" esp_err_t coze_chat_app_start(const CozeChatAgentInfo &agent_info, co
     chat_config.user_id = const_cast<char *>(agent_info.user_id.c_str());
     chat_config.bot_id = const_cast<char *>(robot_info.bot_id.c_str());
     chat_config.voice_id = const_cast<char *>(robot_info.voice_id.c_str());
-    chat_config.access_token = token_str;
+    chat_config.access_token = const_cast<char *>(token->c_str());
     chat_config.uplink_audio_type = ESP_COZE_CHAT_AUDIO_TYPE_G711A;
     chat_config.audio_callback = audio_data_callback;
     chat_config.event_callback = audio_event_callback;
@@ -860,7 +1044,9 @@ extern "C" esp_err_t coze_chat_app_start(const CozeChatAgentInfo &agent_info, co
     esp_err_t ret = esp_coze_chat_init(&chat_config, &coze_chat.chat);
     ESP_UTILS_CHECK_FALSE_RETURN(ret == ESP_OK, ret, "esp_coze_chat_init failed(%s)", esp_err_to_name(ret));
 
-    static auto func_call = FunctionDefinitionList::requestInstance().getJson();
+    // 每次连接时重新获取，包含工具提供者（如服务）在此期间新增的工具
+    static std::string func_call;
+    func_call = FunctionDefinitionList::requestInstance().getJson();
 
     esp_coze_parameters_kv_t param[] = {
         {"func_call", const_cast<char *>(func_call.c_str())},
@@ -868,12 +1054,16 @@ extern "C" esp_err_t coze_chat_app_start(const CozeChatAgentInfo &agent_info, co
     ret = esp_coze_set_chat_config_parameters(coze_chat.chat, param);
     ESP_UTILS_CHECK_FALSE_RETURN(ret == ESP_OK, ret, "esp_coze_set_chat_config_parameters failed(%s)", esp_err_to_name(ret));
     ret = esp_coze_chat_start(coze_chat.chat);
-    ESP_UTILS_CHECK_FALSE_RETURN(ret == ESP_OK, ret, "esp_coze_chat_start failed(%s)", esp_err_to_name(ret));
+    if (ret != ESP_OK)
+    {
+        // 令牌可能已被服务端吊销，下次连接时重新申请
+        coze_token_cache.invalidate();
+        ESP_UTILS_LOGE("esp_coze_chat_start failed(%s)", esp_err_to_name(ret));
+        return ret;
+    }
 
     coze_chat.chat_start = true;
 
-    free(token_str);
-
     return ESP_OK;
 }
 
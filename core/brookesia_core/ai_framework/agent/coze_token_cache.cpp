@@ -0,0 +1,191 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include "coze_token_cache.hpp"
+
+namespace esp_brookesia::ai_framework {
+
+CozeTokenCache::~CozeTokenCache()
+{
+    end();
+}
+
+bool CozeTokenCache::begin(const Config &config, FetchFunction fetch, LoadFunction load, StoreFunction store)
+{
+    if (!fetch || isStarted()) {
+        return false;
+    }
+
+    // Loaded before taking the lock, the storage may be slow
+    std::optional<Token> loaded_token;
+    if (load) {
+        loaded_token = load();
+    }
+
+    {
+        std::lock_guard lock(mutex_);
+        config_ = config;
+        fetch_ = std::move(fetch);
+        store_ = std::move(store);
+        is_stopping_ = false;
+        auto now = Clock::now();
+        // Its expiry can't be checked before the clock is set
+        if (loaded_token.has_value() && isClockSynced()) {
+            setToken(std::move(loaded_token.value()), now);
+            if (isValid(now)) {
+                statistics_.loaded_count++;
+            } else {
+                token_.reset();
+                refresh_time_.reset();
+            }
+        }
+    }
+
+    refresher_ = boost::thread([this]() {
+        runRefresher();
+    });
+
+    return true;
+}
+
+void CozeTokenCache::end()
+{
+    {
+        std::lock_guard lock(mutex_);
+        if (!fetch_) {
+            return;
+        }
+        is_stopping_ = true;
+    }
+    cv_.notify_all();
+    if (refresher_.joinable()) {
+        refresher_.join();
+    }
+
+    std::unique_lock lock(mutex_);
+    cv_.wait(lock, [this]() {
+        return !is_fetching_;
+    });
+    fetch_ = nullptr;
+    store_ = nullptr;
+    token_.reset();
+    refresh_time_.reset();
+}
+
+std::optional<std::string> CozeTokenCache::getToken()
+{
+    std::unique_lock lock(mutex_);
+    if (!fetch_) {
+        return std::nullopt;
+    }
+
+    auto now = Clock::now();
+    if (isValid(now)) {
+        // Fetched before the clock was set, its refresh is only known now
+        if (!refresh_time_.has_value()) {
+            scheduleRefresh(now);
+            cv_.notify_all();
+        }
+        statistics_.hit_count++;
+        return token_->access_token;
+    }
+    if (!fetch(lock, false) || !token_.has_value()) {
+        return std::nullopt;
+    }
+
+    return token_->access_token;
+}
+
+void CozeTokenCache::invalidate()
+{
+    std::lock_guard lock(mutex_);
+    token_.reset();
+    refresh_time_.reset();
+}
+
+bool CozeTokenCache::isValid(Clock::time_point now) const
+{
+    return token_.has_value() && isClockSynced() && (token_->expires_at - config_.min_remaining > now);
+}
+
+void CozeTokenCache::setToken(Token token, Clock::time_point now)
+{
+    token_ = std::move(token);
+    if (isClockSynced()) {
+        scheduleRefresh(now);
+    } else {
+        refresh_time_.reset();
+    }
+}
+
+void CozeTokenCache::scheduleRefresh(Clock::time_point now)
+{
+    // Before the margin, or halfway through the lifetime for the tokens shorter than the margin
+    auto lifetime = std::max(Clock::duration::zero(), token_->expires_at - now);
+    refresh_time_ = now + std::max<Clock::duration>(lifetime - config_.refresh_margin, lifetime / 2);
+}
+
+bool CozeTokenCache::fetch(std::unique_lock<std::mutex> &lock, bool is_background)
+{
+    if (is_fetching_) {
+        cv_.wait(lock, [this]() {
+            return !is_fetching_;
+        });
+        // Without a set clock, only the token of that fetch is kept
+        return isValid(Clock::now()) || (!isClockSynced() && token_.has_value());
+    }
+
+    is_fetching_ = true;
+    auto fetch_function = fetch_;
+    auto store_function = store_;
+    lock.unlock();
+    auto token = fetch_function();
+    if (token.has_value() && store_function) {
+        store_function(token.value());
+    }
+    lock.lock();
+    is_fetching_ = false;
+
+    auto now = Clock::now();
+    statistics_.fetch_count++;
+    if (is_background) {
+        statistics_.background_fetch_count++;
+    }
+    if (!token.has_value()) {
+        statistics_.failed_fetch_count++;
+        // Keep the current token while it lasts, and try again later
+        if (!isClockSynced()) {
+            token_.reset();
+            refresh_time_.reset();
+        } else if (is_background) {
+            refresh_time_ = now + config_.retry_interval;
+        }
+    } else {
+        setToken(std::move(token.value()), now);
+    }
+    cv_.notify_all();
+
+    return token.has_value();
+}
+
+void CozeTokenCache::runRefresher()
+{
+    std::unique_lock lock(mutex_);
+    while (!is_stopping_) {
+        if (!refresh_time_.has_value()) {
+            cv_.wait(lock);
+            continue;
+        }
+        auto refresh_time = refresh_time_.value();
+        if (Clock::now() < refresh_time) {
+            cv_.wait_until(lock, refresh_time);
+            continue;
+        }
+        fetch(lock, true);
+    }
+}
+
+} // namespace esp_brookesia::ai_framework
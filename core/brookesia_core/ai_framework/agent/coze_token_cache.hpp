@@ -0,0 +1,132 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include "boost/thread.hpp"
+
+namespace esp_brookesia::ai_framework {
+
+/**
+ * @brief Cache of the Coze access token, so that a (re)connect only signs a JWT and requests a token when the cached
+ *        one is about to expire
+ *
+ * The token is loaded from the persistent storage on `begin()` if still valid, and stored there after each fetch. A
+ * background thread fetches a new token `refresh_margin` before the cached one expires, retrying every
+ * `retry_interval` on failure. Concurrent fetches are merged: a caller of `getToken()` during a background refresh
+ * waits for its result instead of requesting another token.
+ *
+ * The expiry is a wall clock time. Until `Config::is_clock_synced` reports that the system clock is set (e.g. by SNTP),
+ * the loaded token is dropped, and each `getToken()` fetches a new token which is neither cached nor refreshed.
+ *
+ * @note The background thread is created by `begin()`, with the thread configuration of the caller
+ */
+class CozeTokenCache {
+public:
+    using Clock = std::chrono::system_clock;
+
+    struct Token {
+        std::string access_token;
+        Clock::time_point expires_at;
+    };
+    using FetchFunction = std::function<std::optional<Token>()>;
+    using LoadFunction = std::function<std::optional<Token>()>;
+    using StoreFunction = std::function<void(const Token &token)>;
+    using ClockSyncedFunction = std::function<bool()>;
+
+    struct Config {
+        std::chrono::seconds refresh_margin{3600};      // Refreshed in the background this long before it expires
+        std::chrono::seconds min_remaining{60};         // Not handed out anymore when it expires sooner than this
+        std::chrono::seconds retry_interval{30};        // Between the attempts of a failed background refresh
+        ClockSyncedFunction is_clock_synced = nullptr;  // Whether the system clock is set, always set if empty
+    };
+
+    struct Statistics {
+        size_t hit_count = 0;           // `getToken()` answered from the cache
+        size_t fetch_count = 0;         // Tokens requested, including the failed requests
+        size_t failed_fetch_count = 0;
+        size_t background_fetch_count = 0;
+        size_t loaded_count = 0;        // Tokens loaded from the persistent storage
+    };
+
+    CozeTokenCache() = default;
+    ~CozeTokenCache();
+
+    CozeTokenCache(const CozeTokenCache &) = delete;
+    CozeTokenCache &operator=(const CozeTokenCache &) = delete;
+
+    /**
+     * @brief Start the cache and its background refresh
+     *
+     * @param[in] config Configuration
+     * @param[in] fetch Function requesting a new token (blocking)
+     * @param[in] load Optional function loading the token from the persistent storage
+     * @param[in] store Optional function saving a new token to the persistent storage
+     * @return true if started, false if already started or `fetch` is empty
+     */
+    bool begin(const Config &config, FetchFunction fetch, LoadFunction load = nullptr, StoreFunction store = nullptr);
+
+    /**
+     * @brief Stop the background refresh and drop the token, waits for a fetch in progress
+     */
+    void end();
+
+    /**
+     * @brief Get a valid token, from the cache if possible, otherwise fetched now (blocking)
+     *
+     * @return The access token, std::nullopt if not started or the fetch failed
+     */
+    std::optional<std::string> getToken();
+
+    /**
+     * @brief Drop the cached token, e.g. when rejected by the server, the next `getToken()` fetches a new one
+     */
+    void invalidate();
+
+    bool isStarted() const
+    {
+        std::lock_guard lock(mutex_);
+        return static_cast<bool>(fetch_);
+    }
+
+    Statistics getStatistics() const
+    {
+        std::lock_guard lock(mutex_);
+        return statistics_;
+    }
+
+private:
+    bool isClockSynced() const
+    {
+        return !config_.is_clock_synced || config_.is_clock_synced();
+    }
+    bool isValid(Clock::time_point now) const;
+    void setToken(Token token, Clock::time_point now);
+    void scheduleRefresh(Clock::time_point now);
+    // Fetch a token with the lock released during the request, or wait for the fetch in progress
+    bool fetch(std::unique_lock<std::mutex> &lock, bool is_background);
+    void runRefresher();
+
+    Config config_;
+    FetchFunction fetch_;
+    StoreFunction store_;
+    std::optional<Token> token_;
+    std::optional<Clock::time_point> refresh_time_; // Of the background refresh, none without token or synced clock
+    bool is_fetching_ = false;
+    bool is_stopping_ = false;
+    Statistics statistics_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    boost::thread refresher_;
+};
+
+} // namespace esp_brookesia::ai_framework
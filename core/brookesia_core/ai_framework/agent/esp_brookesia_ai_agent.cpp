@@ -11,6 +11,9 @@
 #include "audio_processor.h"
 #include "function_calling.hpp"
 #include "esp_brookesia_ai_agent.hpp"
+#if ESP_BROOKESIA_AGENT_ENABLE_SERVICE_TOOLS
+#   include "brookesia/service_manager/service/tool_adapter.hpp"
+#endif
 
 #define SEND_CHAT_EVENT_TIMEOUT_MS              (1000)
 
@@ -122,6 +125,19 @@ bool Agent::begin()
         });
     }
 
+#if ESP_BROOKESIA_AGENT_ENABLE_SERVICE_TOOLS
+    // The functions of the running services, found after the ones of the list
+    static service::ServiceToolAdapter service_tool_adapter;
+    FunctionDefinitionList::requestInstance().setToolProvider({
+        .get_json = []() {
+            return *service_tool_adapter.get_tools_json();
+        },
+        .invoke = [](const std::string & name, std::string_view arguments) {
+            return service_tool_adapter.has_tool(name) && service_tool_adapter.call_tool_async(name, arguments).valid();
+        },
+    });
+#endif
+
     _flags.is_begun = true;
 
     del_function.release();
@@ -140,6 +156,10 @@ bool Agent::del()
     }
     _connections.clear();
 
+#if ESP_BROOKESIA_AGENT_ENABLE_SERVICE_TOOLS
+    FunctionDefinitionList::requestInstance().setToolProvider({});
+#endif
+
     bool ret = true;
     if (!sendChatEvent(ChatEvent::Stop, true, SEND_CHAT_EVENT_TIMEOUT_MS)) {
         ESP_UTILS_LOGE("Stop chat event failed");
@@ -0,0 +1,173 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include "function_call_executor.hpp"
+
+namespace esp_brookesia::ai_framework {
+
+FunctionCallExecutor::~FunctionCallExecutor()
+{
+    end();
+}
+
+bool FunctionCallExecutor::begin(const Config &config)
+{
+    if ((config.worker_num == 0) || (config.max_queue_size == 0) || isBegun()) {
+        return false;
+    }
+
+    std::lock_guard lock(mutex_);
+    config_ = config;
+    is_stopping_ = false;
+    try {
+        for (size_t i = 0; i < config.worker_num; i++) {
+            workers_.emplace_back([this]() {
+                runWorker();
+            });
+        }
+    } catch (const boost::thread_resource_error &) {
+        // Run with the workers created so far
+        if (workers_.empty()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void FunctionCallExecutor::end()
+{
+    std::vector<boost::thread> workers;
+    {
+        std::lock_guard lock(mutex_);
+        is_stopping_ = true;
+        workers.swap(workers_);
+    }
+    cv_.notify_all();
+    for (auto &worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+bool FunctionCallExecutor::post(Key key, Task task, bool is_serial)
+{
+    std::unique_lock lock(mutex_);
+    auto &state = key_states_[key];
+    if (workers_.empty() || is_stopping_ || (pending_count_ >= config_.max_queue_size)) {
+        state.statistics.rejected_count++;
+        return false;
+    }
+
+    Call call{key, std::move(task), is_serial, Clock::now()};
+    if (is_serial && state.is_serial_running) {
+        state.serial_calls.push_back(std::move(call));
+    } else {
+        if (is_serial) {
+            state.is_serial_running = true;
+        }
+        queue_.push_back(std::move(call));
+    }
+    pending_count_++;
+    state.statistics.queue_depth++;
+    state.statistics.max_queue_depth = std::max(state.statistics.max_queue_depth, state.statistics.queue_depth);
+    lock.unlock();
+    cv_.notify_one();
+
+    return true;
+}
+
+bool FunctionCallExecutor::run(Key key, const Task &task)
+{
+    auto start_time = Clock::now();
+    bool is_failed = !invokeTask(task);
+
+    std::lock_guard lock(mutex_);
+    recordCall(key_states_[key].statistics, start_time, start_time, is_failed);
+
+    return !is_failed;
+}
+
+FunctionCallExecutor::Statistics FunctionCallExecutor::getStatistics(Key key) const
+{
+    std::lock_guard lock(mutex_);
+    auto it = key_states_.find(key);
+    if (it == key_states_.end()) {
+        return {};
+    }
+
+    return it->second.statistics;
+}
+
+bool FunctionCallExecutor::invokeTask(const Task &task)
+{
+    try {
+        task();
+    } catch (...) {
+        return false;
+    }
+
+    return true;
+}
+
+void FunctionCallExecutor::recordCall(
+    Statistics &statistics, Clock::time_point post_time, Clock::time_point start_time, bool is_failed
+)
+{
+    auto to_us = [](Clock::duration duration) {
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+    };
+    statistics.call_count++;
+    if (is_failed) {
+        statistics.failed_count++;
+    }
+    statistics.last_latency_us = to_us(Clock::now() - post_time);
+    statistics.max_latency_us = std::max(statistics.max_latency_us, statistics.last_latency_us);
+    statistics.total_latency_us += statistics.last_latency_us;
+    statistics.max_wait_us = std::max(statistics.max_wait_us, to_us(start_time - post_time));
+}
+
+void FunctionCallExecutor::runWorker()
+{
+    std::unique_lock lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this]() {
+            return is_stopping_ || !queue_.empty();
+        });
+        if (queue_.empty()) {
+            return;
+        }
+
+        auto call = std::move(queue_.front());
+        queue_.pop_front();
+        pending_count_--;
+        key_states_[call.key].statistics.queue_depth--;
+        auto start_time = Clock::now();
+        lock.unlock();
+
+        // A failed call still releases the next serial call of its key
+        bool is_failed = !invokeTask(call.task);
+        call.task = nullptr;
+
+        lock.lock();
+        auto &state = key_states_[call.key];
+        recordCall(state.statistics, call.post_time, start_time, is_failed);
+
+        // The next serial call of the key is due, ahead of the calls posted after it
+        if (call.is_serial) {
+            if (state.serial_calls.empty()) {
+                state.is_serial_running = false;
+            } else {
+                queue_.push_front(std::move(state.serial_calls.front()));
+                state.serial_calls.pop_front();
+                cv_.notify_one();
+            }
+        }
+    }
+}
+
+} // namespace esp_brookesia::ai_framework
@@ -0,0 +1,144 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include "boost/thread.hpp"
+
+namespace esp_brookesia::ai_framework {
+
+/**
+ * @brief Bounded pool of worker threads running the function calls of the agent
+ *
+ * The calls are queued and run by at most `worker_num` threads, created once in `begin()`. A call posted with a
+ * serial key never runs at the same time as another call of the same key: it waits behind it in the order of posting,
+ * without holding a worker. Each key keeps the statistics of its calls.
+ *
+ * @note The workers are created with the thread configuration of the caller of `begin()`
+ */
+class FunctionCallExecutor {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Task = std::function<void()>;
+    using Key = size_t;
+
+    struct Config {
+        size_t worker_num = 2;      // Calls running at the same time at most
+        size_t max_queue_size = 8;  // Calls waiting at most, the next ones are rejected
+    };
+
+    struct Statistics {
+        size_t call_count = 0;          // Calls run
+        size_t failed_count = 0;        // Calls which threw an exception, also counted in `call_count`
+        size_t rejected_count = 0;      // Calls rejected because the queue was full
+        size_t queue_depth = 0;         // Calls waiting now, for a worker or behind a call of the same key
+        size_t max_queue_depth = 0;
+        uint32_t last_latency_us = 0;   // From the post to the end of the call
+        uint32_t max_latency_us = 0;
+        uint64_t total_latency_us = 0;
+        uint32_t max_wait_us = 0;       // From the post to the start of the call
+    };
+
+    FunctionCallExecutor() = default;
+    ~FunctionCallExecutor();
+
+    FunctionCallExecutor(const FunctionCallExecutor &) = delete;
+    FunctionCallExecutor &operator=(const FunctionCallExecutor &) = delete;
+
+    /**
+     * @brief Create the workers
+     *
+     * @param[in] config Configuration
+     * @return true if successful, false if already begun or the configuration is invalid
+     */
+    bool begin(const Config &config);
+
+    /**
+     * @brief Run the queued calls, then stop the workers
+     */
+    void end();
+
+    /**
+     * @brief Queue a call
+     *
+     * @param[in] key Key of the statistics, usually the index of the function
+     * @param[in] task Call to run
+     * @param[in] is_serial Whether the call waits for the calls of the same key posted before it
+     * @return true if queued, false if not begun or the queue is full
+     */
+    bool post(Key key, Task task, bool is_serial = false);
+
+    /**
+     * @brief Run a call on the caller thread, counted in the statistics of the key
+     *
+     * @param[in] key Key of the statistics
+     * @param[in] task Call to run
+     * @return true if the call returned, false if it threw an exception
+     */
+    bool run(Key key, const Task &task);
+
+    bool isBegun() const
+    {
+        std::lock_guard lock(mutex_);
+        return !workers_.empty();
+    }
+
+    /**
+     * @brief Get the statistics of a key, all zero if it has never been posted
+     */
+    Statistics getStatistics(Key key) const;
+
+    /**
+     * @brief Get the number of calls waiting, for a worker or behind a call of the same key
+     */
+    size_t getQueueDepth() const
+    {
+        std::lock_guard lock(mutex_);
+        return pending_count_;
+    }
+
+private:
+    struct Call {
+        Key key;
+        Task task;
+        bool is_serial;
+        Clock::time_point post_time;
+    };
+
+    struct KeyState {
+        Statistics statistics;
+        bool is_serial_running = false;
+        std::deque<Call> serial_calls;  // Waiting for the serial call of the key which is running
+    };
+
+    // Run a call, an exception is reported as a failed call instead of ending the worker
+    static bool invokeTask(const Task &task);
+    // Called with the lock held
+    void recordCall(
+        Statistics &statistics, Clock::time_point post_time, Clock::time_point start_time, bool is_failed
+    );
+    void runWorker();
+
+    Config config_;
+    std::deque<Call> queue_;
+    std::map<Key, KeyState> key_states_;
+    size_t pending_count_ = 0;
+    bool is_stopping_ = false;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<boost::thread> workers_;
+};
+
+} // namespace esp_brookesia::ai_framework
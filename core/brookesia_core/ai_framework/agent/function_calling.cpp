@@ -3,11 +3,17 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
-#include "boost/thread.hpp"
+#include <algorithm>
+#include <exception>
+#include <memory>
 #include "private/esp_brookesia_ai_agent_utils.hpp"
 #include "function_calling.hpp"
 
-#define THREAD_STACK_SIZE_BIG   (10 * 1024)
+#define EXECUTOR_WORKER_NUM             (2)
+#define EXECUTOR_MAX_QUEUE_SIZE         (8)
+#define EXECUTOR_THREAD_NAME            "func_call"
+#define EXECUTOR_THREAD_STACK_SIZE      (10 * 1024)
+#define EXECUTOR_THREAD_STACK_CAPS_EXT  (true)
 
 namespace esp_brookesia::ai_framework {
 
@@ -88,23 +94,14 @@ void FunctionDefinition::setCallback(Callback callback, std::optional<CallbackTh
     thread_config_ = thread_config;
 }
 
-bool FunctionDefinition::invoke(const cJSON *args) const
+void FunctionDefinition::setSerialized(bool serialized)
 {
-    ESP_UTILS_LOGD("Invoking function: %s", name_.c_str());
-    if (!callback_) {
-        ESP_UTILS_LOGW("Function %s has no callback", name_.c_str());
-        return false;
-    }
-
-    // char *param_str = cJSON_Print(args);
-    // if (param_str) {
-    //     ESP_UTILS_LOGI("Parameters JSON: %s", param_str);
-    //     free(param_str);
-    // } else {
-    //     ESP_UTILS_LOGE("Failed to print parameters JSON");
-    // }
+    serialized_ = serialized;
+}
 
-    std::vector<FunctionParameter> params = parameters_;
+bool FunctionDefinition::parseArguments(const cJSON *args, std::vector<FunctionParameter> &params) const
+{
+    params = parameters_;
     for (auto &param : params) {
         cJSON *value = cJSON_GetObjectItem(args, param.name().c_str());
         auto name = param.name().c_str();
@@ -137,14 +134,26 @@ bool FunctionDefinition::invoke(const cJSON *args) const
         }
     }
 
-    if (thread_config_ != std::nullopt) {
-        esp_utils::thread_config_guard thread_config(*thread_config_);
-        boost::thread([this, params]() {
-            ESP_UTILS_LOG_TRACE_GUARD();
-            callback_(params);
-        }).detach();
-    } else {
+    return true;
+}
+
+bool FunctionDefinition::invoke(const std::vector<FunctionParameter> &params) const
+{
+    ESP_UTILS_LOGD("Invoking function: %s", name_.c_str());
+    if (!callback_) {
+        ESP_UTILS_LOGW("Function %s has no callback", name_.c_str());
+        return false;
+    }
+
+    // Logged here with the name of the function, the executor reports the call as failed
+    try {
         callback_(params);
+    } catch (const std::exception &e) {
+        ESP_UTILS_LOGE("Function %s threw an exception: %s", name_.c_str(), e.what());
+        throw;
+    } catch (...) {
+        ESP_UTILS_LOGE("Function %s threw an unknown exception", name_.c_str());
+        throw;
     }
 
     return true;
@@ -206,6 +215,19 @@ std::string FunctionDefinition::getJson() const
 }
 
 // FunctionDefinitionList implementation
+FunctionDefinitionList::FunctionDefinitionList()
+    : executor_config_{
+    .worker_num = EXECUTOR_WORKER_NUM,
+    .max_queue_size = EXECUTOR_MAX_QUEUE_SIZE,
+    .thread_config = {
+        .name = EXECUTOR_THREAD_NAME,
+        .stack_size = EXECUTOR_THREAD_STACK_SIZE,
+        .stack_in_ext = EXECUTOR_THREAD_STACK_CAPS_EXT,
+    },
+}
+{
+}
+
 FunctionDefinitionList &FunctionDefinitionList::requestInstance()
 {
     static FunctionDefinitionList instance;
@@ -216,10 +238,54 @@ void FunctionDefinitionList::addFunction(const FunctionDefinition &func)
 {
     function_index_[func.name()] = functions_.size();
     functions_.push_back(func);
+    functions_json_.reset();
     ESP_UTILS_LOGD("Added function to list: %s, index: %zu", func.name().c_str(), functions_.size() - 1);
 }
 
-bool FunctionDefinitionList::invokeFunction(const cJSON *function_call) const
+void FunctionDefinitionList::setToolProvider(ToolProvider provider)
+{
+    tool_provider_ = std::move(provider);
+}
+
+bool FunctionDefinitionList::configureExecutor(const ExecutorConfig &config)
+{
+    std::lock_guard lock(executor_mutex_);
+    ESP_UTILS_CHECK_FALSE_RETURN(!executor_.isBegun(), false, "Executor already begun");
+
+    executor_config_ = config;
+
+    return true;
+}
+
+bool FunctionDefinitionList::beginExecutor()
+{
+    std::lock_guard lock(executor_mutex_);
+    if (executor_.isBegun()) {
+        return true;
+    }
+
+    // The workers run the callbacks of all the functions, so they get the largest stack, and the internal memory if
+    // any function needs it
+    auto thread_config = executor_config_.thread_config;
+    for (const auto &func : functions_) {
+        if (func.threadConfig().has_value()) {
+            thread_config.stack_size = std::max(thread_config.stack_size, func.threadConfig()->stack_size);
+            thread_config.stack_in_ext = thread_config.stack_in_ext && func.threadConfig()->stack_in_ext;
+        }
+    }
+
+    esp_utils::thread_config_guard thread_config_guard(thread_config);
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        executor_.begin({
+        .worker_num = executor_config_.worker_num,
+        .max_queue_size = executor_config_.max_queue_size,
+    }), false, "Begin executor failed"
+    );
+
+    return true;
+}
+
+bool FunctionDefinitionList::invokeFunction(const cJSON *function_call)
 {
     ESP_UTILS_LOG_TRACE_GUARD();
 
@@ -235,115 +301,130 @@ bool FunctionDefinitionList::invokeFunction(const cJSON *function_call) const
 
     ESP_UTILS_LOGD("Processing function call: %s", name->valuestring);
 
+    // The parsed JSON must outlive the parsing of the parameters below, but not the call
+    std::unique_ptr<cJSON, decltype(&cJSON_Delete)> args_obj(nullptr, cJSON_Delete);
+    std::unique_ptr<cJSON, decltype(&cJSON_Delete)> action_obj(nullptr, cJSON_Delete);
+    const char *function_name = name->valuestring;
+    const cJSON *function_args = nullptr;
     if (cJSON_IsString(arguments)) {
-        ESP_UTILS_LOGD("Arguments is string: %s", arguments->valuestring);
-
-        // Parse arguments JSON string
-        cJSON *args_obj = cJSON_Parse(arguments->valuestring);
-        if (args_obj == nullptr) {
-            goto next;
-        }
+        args_obj.reset(cJSON_Parse(arguments->valuestring));
+        function_args = args_obj.get();
+
+        // The arguments may wrap the actual call in an `action_json_str` field
+        cJSON *action_json_str = cJSON_GetObjectItem(args_obj.get(), "action_json_str");
+        if (action_json_str && cJSON_IsString(action_json_str)) {
+            action_obj.reset(cJSON_Parse(action_json_str->valuestring));
+            ESP_UTILS_CHECK_NULL_RETURN(
+                action_obj, false, "Failed to parse action_json_str: %s", action_json_str->valuestring
+            );
 
-        {
-            // Check if contains action_json_str field
-            cJSON *action_json_str = cJSON_GetObjectItem(args_obj, "action_json_str");
-            if (action_json_str && cJSON_IsString(action_json_str)) {
-                ESP_UTILS_LOGD("Found action_json_str: %s", action_json_str->valuestring);
-
-                // Parse JSON from action_json_str
-                cJSON *action_obj = cJSON_Parse(action_json_str->valuestring);
-                if (!action_obj) {
-                    ESP_UTILS_LOGE("Failed to parse action_json_str: %s", action_json_str->valuestring);
-                    cJSON_Delete(args_obj);
-                    return false;
-                }
-
-                // Get actual function name and arguments
-                cJSON *actual_name = cJSON_GetObjectItem(action_obj, "name");
-                cJSON *actual_args = cJSON_GetObjectItem(action_obj, "arguments");
-
-                if (!actual_name || !cJSON_IsString(actual_name) || !actual_args) {
-                    ESP_UTILS_LOGE("Action JSON missing required fields or wrong types");
-                    cJSON_Delete(action_obj);
-                    cJSON_Delete(args_obj);
-                    return false;
-                }
-
-                // Print debug information
-                char *debug_str = cJSON_Print(action_obj);
-                if (debug_str) {
-                    ESP_UTILS_LOGD("Parsed action JSON: %s", debug_str);
-                    free(debug_str);
-                }
-
-                // Find and call the corresponding function
-                auto it = function_index_.find(actual_name->valuestring);
-                if (it == function_index_.end()) {
-                    ESP_UTILS_LOGE("Function not found: %s", actual_name->valuestring);
-                    cJSON_Delete(action_obj);
-                    cJSON_Delete(args_obj);
-                    return false;
-                }
-
-                ESP_UTILS_LOGD("Found function %s, index: %zu", actual_name->valuestring, it->second);
-
-                // Call the callback function
-                bool result = functions_[it->second].invoke(actual_args);
-
-                cJSON_Delete(action_obj);
-                cJSON_Delete(args_obj);
-                return result;
-            }
+            cJSON *actual_name = cJSON_GetObjectItem(action_obj.get(), "name");
+            cJSON *actual_args = cJSON_GetObjectItem(action_obj.get(), "arguments");
+            ESP_UTILS_CHECK_FALSE_RETURN(
+                actual_name && cJSON_IsString(actual_name) && actual_args, false,
+                "Action JSON missing required fields or wrong types"
+            );
+            function_name = actual_name->valuestring;
+            function_args = actual_args;
         }
+    } else if (cJSON_IsObject(arguments)) {
+        function_args = arguments;
+    } else {
+        ESP_UTILS_LOGE("Arguments is neither string nor object");
+        return false;
+    }
 
-next:
-        // Standard JSON parameter handling
-        auto it = function_index_.find(name->valuestring);
-        if (it == function_index_.end()) {
-            ESP_UTILS_LOGE("Function not found: %s", name->valuestring);
-            if (args_obj != nullptr) {
-                cJSON_Delete(args_obj);
-            }
-            return false;
+    auto it = function_index_.find(function_name);
+    if ((it == function_index_.end()) && tool_provider_.invoke) {
+        ESP_UTILS_LOGD("Function %s not in list, invoke it through the tool provider", function_name);
+        // Reuse the received text if the arguments are not wrapped, otherwise print them once
+        if (function_args == args_obj.get()) {
+            return tool_provider_.invoke(function_name, arguments->valuestring);
         }
+        std::unique_ptr<char, decltype(&cJSON_free)> args_str(cJSON_PrintUnformatted(function_args), cJSON_free);
+        ESP_UTILS_CHECK_NULL_RETURN(args_str, false, "Print arguments of %s failed", function_name);
+        return tool_provider_.invoke(function_name, args_str.get());
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(it != function_index_.end(), false, "Function not found: %s", function_name);
+    auto index = it->second;
+    const auto &func = functions_[index];
+
+    ESP_UTILS_LOGD("Found function %s, index: %zu", function_name, index);
+
+    // Parsed once on the caller thread, the call only gets the typed parameters
+    std::vector<FunctionParameter> params;
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        func.parseArguments(function_args, params), false, "Parse arguments of %s failed", function_name
+    );
+
+    if (!func.threadConfig().has_value()) {
+        bool result = false;
+        bool is_returned = executor_.run(index, [&]() {
+            result = func.invoke(params);
+        });
+        return is_returned && result;
+    }
 
-        ESP_UTILS_LOGD("Found function %s, index: %zu", name->valuestring, it->second);
-
-        // Call the callback function
-        bool result = functions_[it->second].invoke(args_obj);
-
-        if (args_obj != nullptr) {
-            cJSON_Delete(args_obj);
-        }
-        return result;
-    } else if (cJSON_IsObject(arguments)) {
-        // Process object type parameters directly
-        auto it = function_index_.find(name->valuestring);
-        if (it == function_index_.end()) {
-            ESP_UTILS_LOGE("Function not found: %s", name->valuestring);
-            return false;
-        }
+    ESP_UTILS_CHECK_FALSE_RETURN(beginExecutor(), false, "Begin executor failed");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        // The queued call owns a copy of the definition, it doesn't depend on the lifetime of the list
+        executor_.post(index, [func, params = std::move(params)]() {
+        ESP_UTILS_LOG_TRACE_GUARD();
+        func.invoke(params);
+    }, func.serialized()), false, "Queue call of %s failed (%zu calls waiting)", function_name,
+    executor_.getQueueDepth()
+    );
 
-        ESP_UTILS_LOGD("Found function %s, index: %zu", name->valuestring, it->second);
+    return true;
+}
 
-        // Call the callback function
-        bool result = functions_[it->second].invoke(arguments);
-        return result;
+std::optional<FunctionDefinitionList::Statistics> FunctionDefinitionList::getStatistics(const std::string &name) const
+{
+    auto it = function_index_.find(name);
+    if (it == function_index_.end()) {
+        return std::nullopt;
     }
 
-    ESP_UTILS_LOGE("Arguments is neither string nor object");
-    return false;
+    return executor_.getStatistics(it->second);
 }
 
-std::string FunctionDefinitionList::getJson() const
+std::string FunctionDefinitionList::getJson()
 {
-    std::string json = "{\"functions\":[";
-    for (size_t i = 0; i < functions_.size(); ++i) {
-        json += functions_[i].getJson();
-        if (i < functions_.size() - 1) {
-            json += ",";
+    // The functions are only added at startup, so their descriptors are built once
+    if (!functions_json_.has_value()) {
+        std::string json;
+        for (size_t i = 0; i < functions_.size(); ++i) {
+            json += functions_[i].getJson();
+            if (i < functions_.size() - 1) {
+                json += ",";
+            }
         }
+        functions_json_ = std::move(json);
+    }
+
+    // The tools of the provider may change, e.g. when a service is started, so they are merged on each request
+    std::string tools_json;
+    if (tool_provider_.get_json) {
+        tools_json = tool_provider_.get_json();
+        auto begin = tools_json.find('[');
+        auto end = tools_json.rfind(']');
+        if ((begin == std::string::npos) || (end == std::string::npos) || (end <= begin)) {
+            ESP_UTILS_LOGE("Invalid tools JSON of the provider, ignored");
+            tools_json.clear();
+        } else {
+            tools_json = tools_json.substr(begin + 1, end - begin - 1);
+            if (tools_json.find_first_not_of(" \t\r\n") == std::string::npos) {
+                tools_json.clear();
+            }
+        }
+    }
+
+    std::string json = "{\"functions\":[";
+    json += functions_json_.value();
+    if (!functions_json_->empty() && !tools_json.empty()) {
+        json += ",";
     }
+    json += tools_json;
     json += "]}";
     return json;
 }
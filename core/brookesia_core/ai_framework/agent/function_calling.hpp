@@ -5,14 +5,17 @@
  */
 #pragma once
 
+#include <deque>
 #include <map>
 #include <string>
+#include <string_view>
 #include <optional>
 #include <functional>
 #include <vector>
 #include <mutex>
 #include "cJSON.h"
 #include "thread/esp_utils_thread.hpp"
+#include "function_call_executor.hpp"
 
 namespace esp_brookesia::ai_framework {
 
@@ -82,12 +85,40 @@ public:
     void addParameter(
         const std::string &name, const std::string &description, FunctionParameter::ValueType type, bool required = true
     );
+    /**
+     * @brief Set the callback of the function
+     *
+     * @param[in] callback Callback
+     * @param[in] thread_config Without it, the callback runs on the thread of the chat events. With it, the callback
+     *                          runs on a worker of `FunctionDefinitionList`, whose stack is at least `stack_size`
+     */
     void setCallback(Callback callback, std::optional<CallbackThreadConfig> thread_config = std::nullopt);
-    bool invoke(const cJSON *args) const;
-    std::string name() const
+    /**
+     * @brief Run the calls of the function one at a time, in the order of the tool calls, e.g. when the callback
+     *        is not reentrant
+     */
+    void setSerialized(bool serialized);
+    /**
+     * @brief Parse the arguments of a tool call into the typed parameters
+     *
+     * @param[in] args JSON object of the arguments
+     * @param[out] params Parameters of the function, with the values of the arguments
+     * @return true if successful, false if a required argument is missing or an argument has the wrong type
+     */
+    bool parseArguments(const cJSON *args, std::vector<FunctionParameter> &params) const;
+    bool invoke(const std::vector<FunctionParameter> &params) const;
+    const std::string &name() const
     {
         return name_;
     }
+    const std::optional<CallbackThreadConfig> &threadConfig() const
+    {
+        return thread_config_;
+    }
+    bool serialized() const
+    {
+        return serialized_;
+    }
     std::string getJson() const;
 
 private:
@@ -96,23 +127,79 @@ private:
     std::vector<FunctionParameter> parameters_;
     Callback callback_;
     std::optional<CallbackThreadConfig> thread_config_;
+    bool serialized_ = false;
 };
 
+/**
+ * @brief Registry of the functions the agent can call
+ *
+ * The calls of the functions with a thread configuration are dispatched onto a bounded pool of workers, created on the
+ * first call, instead of a thread each. The other calls run on the thread of the chat events.
+ */
 class FunctionDefinitionList {
 public:
+    struct ExecutorConfig {
+        size_t worker_num;
+        size_t max_queue_size;
+        // Stack raised to the largest one of the thread configurations of the functions
+        esp_utils::ThreadConfig thread_config;
+    };
+    using Statistics = FunctionCallExecutor::Statistics;
+    /**
+     * @brief Source of tools defined outside of this list, e.g. the functions of the services of
+     *        `brookesia_service_manager` through its `ServiceToolAdapter`
+     */
+    struct ToolProvider {
+        // JSON array of the descriptors of the tools, in the same format as `FunctionDefinition::getJson()`
+        std::function<std::string()> get_json;
+        // Call a tool with its arguments as JSON text, returns false if the tool is not found or the call failed
+        std::function<bool(const std::string &name, std::string_view arguments)> invoke;
+    };
+
     FunctionDefinitionList(const FunctionDefinitionList &) = delete;
     FunctionDefinitionList &operator=(const FunctionDefinitionList &) = delete;
 
     static FunctionDefinitionList &requestInstance();
     void addFunction(const FunctionDefinition &func);
-    bool invokeFunction(const cJSON *function_call) const;
-    std::string getJson() const;
+    /**
+     * @brief Set the provider of the tools which are not in this list, called for the names not found in it
+     */
+    void setToolProvider(ToolProvider provider);
+    /**
+     * @brief Configure the workers of the function calls, only before the first call
+     *
+     * @return true if successful, false if the workers are already created
+     */
+    bool configureExecutor(const ExecutorConfig &config);
+    bool invokeFunction(const cJSON *function_call);
+    /**
+     * @brief Get the call count, queue depth and latencies of a function
+     *
+     * @return Statistics, std::nullopt if the function is not found
+     */
+    std::optional<Statistics> getStatistics(const std::string &name) const;
+    /**
+     * @brief Get the number of calls waiting, for a worker or behind a call of the same function
+     */
+    size_t getQueueDepth() const
+    {
+        return executor_.getQueueDepth();
+    }
+    std::string getJson();
 
 private:
-    FunctionDefinitionList() = default;
+    FunctionDefinitionList();
+
+    bool beginExecutor();
 
-    std::vector<FunctionDefinition> functions_;
+    // The queued calls refer to their function, which must not move
+    std::deque<FunctionDefinition> functions_;
     std::map<std::string, size_t> function_index_;
+    std::optional<std::string> functions_json_;  // Descriptors of the functions, built on the first request
+    ToolProvider tool_provider_;
+    ExecutorConfig executor_config_;
+    FunctionCallExecutor executor_;
+    std::mutex executor_mutex_;
 };
 
 } // namespace esp_brookesia::ai_framework
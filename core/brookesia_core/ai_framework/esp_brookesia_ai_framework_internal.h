@@ -30,6 +30,22 @@
 #           define ESP_BROOKESIA_AGENT_ENABLE_DEBUG_LOG  (0)
 #       endif
 #   endif
+
+#   if !defined(ESP_BROOKESIA_AGENT_PERSIST_COZE_TOKEN)
+#       if defined(CONFIG_ESP_BROOKESIA_AGENT_PERSIST_COZE_TOKEN)
+#           define ESP_BROOKESIA_AGENT_PERSIST_COZE_TOKEN  CONFIG_ESP_BROOKESIA_AGENT_PERSIST_COZE_TOKEN
+#       else
+#           define ESP_BROOKESIA_AGENT_PERSIST_COZE_TOKEN  (0)
+#       endif
+#   endif
+
+#   if !defined(ESP_BROOKESIA_AGENT_ENABLE_SERVICE_TOOLS)
+#       if defined(CONFIG_ESP_BROOKESIA_AGENT_ENABLE_SERVICE_TOOLS)
+#           define ESP_BROOKESIA_AGENT_ENABLE_SERVICE_TOOLS  CONFIG_ESP_BROOKESIA_AGENT_ENABLE_SERVICE_TOOLS
+#       else
+#           define ESP_BROOKESIA_AGENT_ENABLE_SERVICE_TOOLS  (0)
+#       endif
+#   endif
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -7,7 +7,9 @@
 #include <filesystem>
 #include <vector>
 #include <fstream>
+#include <cstring>
 #include "esp_heap_caps.h"
+#include "esp_timer.h"
 #include "esp_brookesia_gui_internal.h"
 #if !ESP_BROOKESIA_ANIM_PLAYER_ENABLE_DEBUG_LOG
 #   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
@@ -21,12 +23,62 @@
 #define ANIM_EVENT_THREAD_STACK_SIZE        (10 * 1024)
 #define ANIM_EVENT_THREAD_STACK_CAPS_EXT    (true)
 
+#define ANIM_FLUSH_THREAD_NAME              "anim_flush"
+#define ANIM_FLUSH_THREAD_STACK_SIZE        (6 * 1024)
+#define ANIM_FLUSH_THREAD_STACK_CAPS_EXT    (true)
+
+#define ANIM_PIXEL_SIZE                     (2)     // RGB565
+#define ANIM_DIRTY_BAND_ROWS                (8)
+
 namespace fs = std::filesystem;
 
 namespace esp_brookesia::gui {
 
 AnimPlayer::FlushReadySignal AnimPlayer::flush_ready_signal;
 AnimPlayer::AnimationStopSignal AnimPlayer::animation_stop_signal;
+std::mutex AnimPlayer::_dirty_mutex;
+std::map<AnimPlayer::DirtyRect, AnimPlayer::DirtyCanvas> AnimPlayer::_dirty_canvases;
+uint32_t AnimPlayer::_dirty_seq = 0;
+
+namespace {
+
+uint64_t hash_rows(const uint8_t *data, size_t size)
+{
+    // FNV-1a over 32-bit words, the rows of RGB565 regions are always 4-byte multiples in practice
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    size_t words = size / sizeof(uint32_t);
+    for (size_t i = 0; i < words; i++) {
+        uint32_t word;
+        memcpy(&word, data + i * sizeof(uint32_t), sizeof(word));
+        hash = (hash ^ word) * 0x100000001b3ULL;
+    }
+    for (size_t i = words * sizeof(uint32_t); i < size; i++) {
+        hash = (hash ^ data[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+inline uint32_t elapsed_us(int64_t start_us)
+{
+    return static_cast<uint32_t>(esp_timer_get_time() - start_us);
+}
+
+inline std::tuple<int, int, int, int> get_canvas_rect(const AnimPlayerCanvasConfig &config)
+{
+    return std::make_tuple(
+               config.coord_x, config.coord_y, config.coord_x + config.width, config.coord_y + config.height
+           );
+}
+
+// The end coordinates are exclusive
+inline bool check_rect_overlapped(const std::tuple<int, int, int, int> &a, const std::tuple<int, int, int, int> &b)
+{
+    auto [a_x1, a_y1, a_x2, a_y2] = a;
+    auto [b_x1, b_y1, b_x2, b_y2] = b;
+    return (a_x1 < b_x2) && (b_x1 < a_x2) && (a_y1 < b_y2) && (b_y1 < a_y2);
+}
+
+} // namespace
 
 AnimPlayer::~AnimPlayer()
 {
@@ -80,6 +132,55 @@ bool AnimPlayer::begin(const AnimPlayerData &data)
         }
     }
 
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(
+        _flush = std::make_unique<FlushContext>(), false, "Failed to create flush context"
+    );
+    _flush->enable_pipeline = data.flags.enable_pipeline;
+    _flush->enable_dirty_rect = data.flags.enable_dirty_rect;
+    if (_flush->enable_pipeline) {
+        ESP_UTILS_LOGD("Enable flush pipeline");
+
+        _flush->free_slots = {0, 1};
+        esp_utils::thread_config_guard thread_config(esp_utils::ThreadConfig{
+            .name = ANIM_FLUSH_THREAD_NAME,
+            .stack_size = ANIM_FLUSH_THREAD_STACK_SIZE,
+            .stack_in_ext = ANIM_FLUSH_THREAD_STACK_CAPS_EXT,
+        });
+        _flush->thread = boost::thread([this] {
+            ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+            auto &flush = *_flush;
+            std::unique_lock<std::mutex> lock(flush.mutex);
+            while (!flush.thread_need_exit)
+            {
+                if (flush.ready_slots.empty()) {
+                    flush.cv.wait_for(lock, std::chrono::milliseconds(THREAD_EXIT_CHECK_INTERVAL_MS));
+                    continue;
+                }
+
+                int index = flush.ready_slots.front();
+                flush.ready_slots.pop();
+                flush.flushing_slot = index;
+                flush.is_flush_done = false;
+                auto &slot = flush.slots[index];
+                auto start_us = esp_timer_get_time();
+
+                lock.unlock();
+                flush_ready_signal(slot.x_start, slot.y_start, slot.x_end, slot.y_end, slot.buffer.get(), this);
+                lock.lock();
+
+                while (!flush.is_flush_done && !flush.thread_need_exit) {
+                    flush.cv.wait_for(lock, std::chrono::milliseconds(THREAD_EXIT_CHECK_INTERVAL_MS));
+                }
+                commitDirtyRegion(slot.dirty, flush.is_flush_done && flush.is_slot_drawn);
+                flush.frame_flush_us += elapsed_us(start_us);
+                flush.flushing_slot = -1;
+                flush.free_slots.push_back(index);
+                flush.cv.notify_all();
+            }
+        });
+    }
+
     {
         anim_player_config_t config = {
             .flush_cb = [](anim_player_handle_t handle, int x1, int y1, int x2, int y2, const void *data)
@@ -104,7 +205,9 @@ bool AnimPlayer::begin(const AnimPlayerData &data)
                 int x_end = std::min(x_start + width, canvas_config.coord_x + canvas_config.width);
                 int y_end = std::min(y_start + height, canvas_config.coord_y + canvas_config.height);
 
-                flush_ready_signal(x_start, y_start, x_end, y_end, data, self);
+                self->processDecodedRegion(
+                    x_start, y_start, x_end, y_end, data, static_cast<size_t>(x2 - x1) * ANIM_PIXEL_SIZE
+                );
             },
             .update_cb = [](anim_player_handle_t handle, player_event_t event)
             {
@@ -112,13 +215,17 @@ bool AnimPlayer::begin(const AnimPlayerData &data)
 
                 // ESP_UTILS_LOGD("Param: handle(%p), event(%d)", handle, static_cast<int>(event));
 
+                auto *self = static_cast<AnimPlayer *>(anim_player_get_user_data(handle));
+                ESP_UTILS_CHECK_NULL_EXIT(self, "Invalid user data");
+
+                if (event == PLAYER_EVENT_ONE_FRAME_DONE) {
+                    self->processFrameDone();
+                    return;
+                }
                 if ((event != PLAYER_EVENT_ALL_FRAME_DONE) && (event != PLAYER_EVENT_IDLE)) {
                     return;
                 }
 
-                auto *self = static_cast<AnimPlayer *>(anim_player_get_user_data(handle));
-                ESP_UTILS_CHECK_NULL_EXIT(self, "Invalid user data");
-
                 std::unique_lock<std::mutex> lock(self->_player_mutex);
 
                 if (event == PLAYER_EVENT_ALL_FRAME_DONE) {
@@ -235,10 +342,23 @@ bool AnimPlayer::del()
     }
 
     if (_player_handle != nullptr) {
+        // The flush thread keeps running, so a decoder waiting for a free slot can exit
         anim_player_deinit(_player_handle);
         _player_handle = nullptr;
     }
 
+    if (_flush != nullptr) {
+        {
+            std::lock_guard lock(_flush->mutex);
+            _flush->thread_need_exit = true;
+            _flush->cv.notify_all();
+        }
+        if (_flush->thread.joinable()) {
+            _flush->thread.join();
+        }
+        _flush.reset();
+    }
+
     if (_assets_handle != nullptr) {
         mmap_assets_del(_assets_handle);
         _assets_handle = nullptr;
@@ -296,17 +416,60 @@ bool AnimPlayer::sendEvent(const Event &event, bool clear_queue, EventFuture *fu
     return true;
 }
 
-bool AnimPlayer::notifyFlushFinished() const
+bool AnimPlayer::notifyFlushFinished(bool is_drawn) const
 {
     // ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
     ESP_UTILS_CHECK_NULL_RETURN(_player_handle, false, "Invalid handle");
+    ESP_UTILS_CHECK_NULL_RETURN(_flush, false, "Invalid flush context");
+
+    std::unique_lock<std::mutex> lock(_flush->mutex);
+    if (_flush->enable_pipeline && !_flush->is_direct_flush) {
+        // The decoder is already released, only the slot is released here
+        _flush->is_flush_done = true;
+        _flush->is_slot_drawn = is_drawn;
+        _flush->cv.notify_all();
+        return true;
+    }
+    commitDirtyRegion(_flush->direct_dirty, is_drawn);
+    _flush->is_direct_flush = false;
+    _flush->cv.notify_all();
+
+    auto flush_us = elapsed_us(_flush->flush_start_us);
+    _flush->frame_flush_us += flush_us;
+    _flush->frame_wait_us += flush_us;
+    _flush->decoder_release_us = esp_timer_get_time();
+    lock.unlock();
 
     anim_player_flush_ready(_player_handle);
 
     return true;
 }
 
+AnimPlayer::Stats AnimPlayer::getStats() const
+{
+    ESP_UTILS_CHECK_NULL_RETURN(_flush, Stats{}, "Invalid flush context");
+
+    std::lock_guard lock(_flush->mutex);
+
+    return _flush->stats;
+}
+
+void AnimPlayer::resetStats()
+{
+    ESP_UTILS_CHECK_NULL_EXIT(_flush, "Invalid flush context");
+
+    std::lock_guard lock(_flush->mutex);
+
+    _flush->stats = {};
+}
+
+void AnimPlayer::invalidateDirtyRegions()
+{
+    std::lock_guard lock(_dirty_mutex);
+    _dirty_canvases.clear();
+}
+
 bool AnimPlayer::loadAnimationConfig(const AnimPlayerPartitionConfig &partition_config)
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
@@ -506,6 +669,9 @@ bool AnimPlayer::processEvent(std::shared_ptr<EventWrapper> event_wrapper)
             break;
         }
         case Operation::Stop:
+            // Make sure no pending region is drawn over the cleared area
+            ESP_UTILS_CHECK_FALSE_RETURN(waitFlushIdle(), false, "Failed to wait flush idle");
+            resetDirtyRegions();
             animation_stop_signal(
                 _canvas_config.coord_x, _canvas_config.coord_y, _canvas_config.coord_x + _canvas_config.width,
                 _canvas_config.coord_y + _canvas_config.height, this
@@ -527,4 +693,271 @@ bool AnimPlayer::processEvent(std::shared_ptr<EventWrapper> event_wrapper)
     return true;
 }
 
+void AnimPlayer::processDecodedRegion(
+    int x_start, int y_start, int x_end, int y_end, const void *data, size_t stride
+)
+{
+    auto &flush = *_flush;
+    auto now_us = esp_timer_get_time();
+    auto src = static_cast<const uint8_t *>(data);
+
+    std::unique_lock<std::mutex> lock(flush.mutex);
+
+    // Timing of the decoder: the first region of a frame follows the idle time, the others the decoding time
+    if (flush.decoder_release_us != 0) {
+        flush.frame_decode_us += static_cast<uint32_t>(now_us - flush.decoder_release_us);
+    } else if (flush.frame_done_us != 0) {
+        flush.stats.last_idle_time_us = static_cast<uint32_t>(now_us - flush.frame_done_us);
+    }
+    flush.stats.region_count++;
+
+    // Only flush the rows between the first and the last changed bands
+    int rows = y_end - y_start;
+    DirtyRect dirty_rect = std::make_tuple(x_start, y_start, x_end, y_end);
+    uint32_t dirty_seq = 0;
+    // The hashes are only recorded once the region is drawn, see `commitDirtyRegion()`
+    auto set_pending_dirty = [&](PendingDirtyRegion & pending) {
+        pending.rect = dirty_rect;
+        pending.band_hashes.assign(flush.band_hashes.begin(), flush.band_hashes.end());
+        pending.seq = dirty_seq;
+    };
+    if (flush.enable_dirty_rect && (rows > 0)) {
+        int band_num = (rows + ANIM_DIRTY_BAND_ROWS - 1) / ANIM_DIRTY_BAND_ROWS;
+        flush.band_hashes.resize(band_num);
+        for (int band = 0; band < band_num; band++) {
+            int band_rows = std::min(ANIM_DIRTY_BAND_ROWS, rows - band * ANIM_DIRTY_BAND_ROWS);
+            flush.band_hashes[band] = hash_rows(src + band * ANIM_DIRTY_BAND_ROWS * stride, band_rows * stride);
+        }
+
+        int first_dirty = -1;
+        int last_dirty = -1;
+        if (!checkRegionDirty(x_start, y_start, x_end, y_end, first_dirty, last_dirty, dirty_seq)) {
+            flush.stats.skipped_region_count++;
+            flush.stats.skipped_bytes += static_cast<uint64_t>(rows) * stride;
+            lock.unlock();
+            releaseDecoder();
+            return;
+        }
+
+        int dirty_y_end = std::min(y_start + (last_dirty + 1) * ANIM_DIRTY_BAND_ROWS, y_end);
+        int dirty_y_start = y_start + first_dirty * ANIM_DIRTY_BAND_ROWS;
+        src += first_dirty * ANIM_DIRTY_BAND_ROWS * stride;
+        flush.stats.skipped_bytes += static_cast<uint64_t>(rows - (dirty_y_end - dirty_y_start)) * stride;
+        y_start = dirty_y_start;
+        y_end = dirty_y_end;
+        rows = y_end - y_start;
+    }
+    flush.stats.flushed_bytes += static_cast<uint64_t>(rows) * stride;
+
+    if (!flush.enable_pipeline) {
+        set_pending_dirty(flush.direct_dirty);
+        flush.flush_start_us = esp_timer_get_time();
+        lock.unlock();
+        // The decoder is released by `notifyFlushFinished()`
+        flush_ready_signal(x_start, y_start, x_end, y_end, src, this);
+        return;
+    }
+
+    // Wait for a free slot, then copy the region so the decoder can go on with the next one
+    auto wait_start_us = esp_timer_get_time();
+    while (flush.free_slots.empty() && !flush.thread_need_exit) {
+        flush.cv.wait_for(lock, std::chrono::milliseconds(THREAD_EXIT_CHECK_INTERVAL_MS));
+    }
+    flush.frame_wait_us += elapsed_us(wait_start_us);
+    if (flush.thread_need_exit) {
+        // Not drawn, the region is fully flushed next time
+        set_pending_dirty(flush.direct_dirty);
+        commitDirtyRegion(flush.direct_dirty, false);
+        lock.unlock();
+        releaseDecoder();
+        return;
+    }
+
+    int index = flush.free_slots.back();
+    size_t size = static_cast<size_t>(rows) * stride;
+    if (!reserveSlotBuffer(index, size)) {
+        // Flush from the decoder buffer once the previous regions are drawn, the decoder is released by
+        // `notifyFlushFinished()`
+        while ((!flush.ready_slots.empty() || (flush.flushing_slot >= 0)) && !flush.thread_need_exit) {
+            flush.cv.wait_for(lock, std::chrono::milliseconds(THREAD_EXIT_CHECK_INTERVAL_MS));
+        }
+        flush.is_direct_flush = true;
+        set_pending_dirty(flush.direct_dirty);
+        flush.flush_start_us = esp_timer_get_time();
+        lock.unlock();
+        flush_ready_signal(x_start, y_start, x_end, y_end, src, this);
+        return;
+    }
+    flush.free_slots.pop_back();
+    auto &slot = flush.slots[index];
+    memcpy(slot.buffer.get(), src, size);
+    slot.x_start = x_start;
+    slot.y_start = y_start;
+    slot.x_end = x_end;
+    slot.y_end = y_end;
+    set_pending_dirty(slot.dirty);
+    flush.ready_slots.push(index);
+    flush.cv.notify_all();
+    lock.unlock();
+
+    releaseDecoder();
+}
+
+void AnimPlayer::processFrameDone()
+{
+    auto &flush = *_flush;
+
+    std::lock_guard lock(flush.mutex);
+
+    auto &stats = flush.stats;
+    stats.frame_count++;
+    stats.last_decode_time_us = flush.frame_decode_us;
+    stats.max_decode_time_us = std::max(stats.max_decode_time_us, flush.frame_decode_us);
+    stats.last_flush_time_us = flush.frame_flush_us;
+    stats.max_flush_time_us = std::max(stats.max_flush_time_us, flush.frame_flush_us);
+    stats.last_wait_time_us = flush.frame_wait_us;
+    stats.max_wait_time_us = std::max(stats.max_wait_time_us, flush.frame_wait_us);
+    flush.frame_decode_us = 0;
+    flush.frame_flush_us = 0;
+    flush.frame_wait_us = 0;
+    flush.decoder_release_us = 0;
+    flush.frame_done_us = esp_timer_get_time();
+}
+
+void AnimPlayer::releaseDecoder()
+{
+    {
+        std::lock_guard lock(_flush->mutex);
+        _flush->decoder_release_us = esp_timer_get_time();
+    }
+    anim_player_flush_ready(_player_handle);
+}
+
+bool AnimPlayer::waitFlushIdle()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    std::unique_lock<std::mutex> lock(_flush->mutex);
+    while (!_flush->thread_need_exit && !_event_thread_need_exit &&
+            (!_flush->ready_slots.empty() || (_flush->flushing_slot >= 0) || _flush->is_direct_flush)) {
+        _flush->cv.wait_for(lock, std::chrono::milliseconds(THREAD_EXIT_CHECK_INTERVAL_MS));
+    }
+
+    return true;
+}
+
+bool AnimPlayer::reserveSlotBuffer(int index, size_t size)
+{
+    auto &slot = _flush->slots[index];
+    if (slot.buffer_size >= size) {
+        return true;
+    }
+
+    // The slots are read by the display DMA, so they are kept in internal memory instead of the heap of the decoder
+    slot.buffer.reset();
+    slot.buffer_size = 0;
+    auto buffer = static_cast<uint8_t *>(heap_caps_malloc(size, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL));
+    ESP_UTILS_CHECK_NULL_RETURN(buffer, false, "Failed to allocate flush slot(%d bytes)", static_cast<int>(size));
+    slot.buffer.reset(buffer);
+    slot.buffer_size = size;
+
+    return true;
+}
+
+bool AnimPlayer::checkRegionDirty(
+    int x_start, int y_start, int x_end, int y_end, int &first_dirty_band, int &last_dirty_band, uint32_t &seq
+)
+{
+    auto &band_hashes = _flush->band_hashes;
+    DirtyRect region = std::make_tuple(x_start, y_start, x_end, y_end);
+    DirtyRect canvas_rect = get_canvas_rect(_canvas_config);
+
+    std::lock_guard lock(_dirty_mutex);
+
+    auto &canvas = _dirty_canvases[canvas_rect];
+    auto &hashes = canvas.regions[region].band_hashes;
+    bool is_new_region = (hashes.size() != band_hashes.size());
+    first_dirty_band = -1;
+    last_dirty_band = -1;
+    for (size_t band = 0; band < band_hashes.size(); band++) {
+        if (is_new_region || (hashes[band] != band_hashes[band])) {
+            if (first_dirty_band < 0) {
+                first_dirty_band = static_cast<int>(band);
+            }
+            last_dirty_band = static_cast<int>(band);
+        }
+    }
+    if (first_dirty_band < 0) {
+        return false;
+    }
+
+    // The content of the region is unknown until its flush is done, and the one of the other regions it overlaps,
+    // of this canvas or of the others, is drawn over
+    for (auto &[rect, other_canvas] : _dirty_canvases) {
+        if (!check_rect_overlapped(rect, region)) {
+            continue;
+        }
+        for (auto it = other_canvas.regions.begin(); it != other_canvas.regions.end();) {
+            if (((&other_canvas != &canvas) || (it->first != region)) && check_rect_overlapped(it->first, region)) {
+                it = other_canvas.regions.erase(it);
+            } else {
+                it++;
+            }
+        }
+    }
+    auto &dirty_region = canvas.regions[region];
+    dirty_region.band_hashes.clear();
+    // `0` is kept for "nothing to record"
+    if (++_dirty_seq == 0) {
+        _dirty_seq = 1;
+    }
+    dirty_region.pending_seq = _dirty_seq;
+    seq = _dirty_seq;
+
+    return true;
+}
+
+void AnimPlayer::commitDirtyRegion(PendingDirtyRegion &pending, bool is_drawn) const
+{
+    if (pending.seq == 0) {
+        return;
+    }
+
+    std::lock_guard lock(_dirty_mutex);
+
+    auto canvas_it = _dirty_canvases.find(get_canvas_rect(_canvas_config));
+    if (canvas_it != _dirty_canvases.end()) {
+        auto &regions = canvas_it->second.regions;
+        auto it = regions.find(pending.rect);
+        // Dropped if the regions were invalidated or drawn over by another flush in the meantime
+        if ((it != regions.end()) && (it->second.pending_seq == pending.seq)) {
+            if (is_drawn) {
+                // Swapped, so the buffers are reused instead of allocated by each region
+                it->second.band_hashes.swap(pending.band_hashes);
+                it->second.pending_seq = 0;
+            } else {
+                regions.erase(it);
+            }
+        }
+    }
+    pending.seq = 0;
+}
+
+void AnimPlayer::resetDirtyRegions()
+{
+    DirtyRect canvas_rect = get_canvas_rect(_canvas_config);
+
+    // The canvas is cleared, so are the regions of all the canvases it overlaps
+    std::lock_guard lock(_dirty_mutex);
+    for (auto &[rect, canvas] : _dirty_canvases) {
+        for (auto it = canvas.regions.begin(); it != canvas.regions.end();) {
+            if (check_rect_overlapped(it->first, canvas_rect)) {
+                it = canvas.regions.erase(it);
+            } else {
+                it++;
+            }
+        }
+    }
+}
+
 } // namespace esp_brookesia::gui
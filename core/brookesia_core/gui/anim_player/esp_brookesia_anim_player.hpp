@@ -5,15 +5,20 @@
  */
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <future>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <queue>
+#include <tuple>
 #include <variant>
 #include <vector>
 #include "boost/signals2/signal.hpp"
 #include "boost/thread.hpp"
+#include "esp_heap_caps.h"
 #include "esp_mmap_assets.h"
 #include "anim_player.h"
 
@@ -70,6 +75,8 @@ struct AnimPlayerData {
     } task;
     struct {
         int enable_data_swap_bytes: 1;
+        int enable_pipeline: 1;     // Decode the next region while the current one is flushed, with ping-pong buffers
+        int enable_dirty_rect: 1;   // Only flush the rows which changed since the last flush of the same region
     } flags;
 };
 
@@ -109,6 +116,24 @@ public:
 
     using EventFuture = std::future<void>;
 
+    /**
+     * @brief Per-frame timing and flush statistics. The "last" values are those of the last completed frame.
+     */
+    struct Stats {
+        uint32_t frame_count;
+        uint32_t region_count;              // Regions delivered by the decoder
+        uint32_t skipped_region_count;      // Regions not flushed because nothing changed
+        uint64_t flushed_bytes;
+        uint64_t skipped_bytes;             // Bytes not flushed thanks to the dirty-rect tracking
+        uint32_t last_decode_time_us;       // Decoding of a frame, except its first region
+        uint32_t max_decode_time_us;
+        uint32_t last_flush_time_us;        // Flushing of a frame by the display
+        uint32_t max_flush_time_us;
+        uint32_t last_wait_time_us;         // Decoder blocked by the flush in a frame
+        uint32_t max_wait_time_us;
+        uint32_t last_idle_time_us;         // Between two frames, includes the frame pacing and the first region
+    };
+
     using FlushReadySignal = boost::signals2::signal <
                              void(int x_start, int y_start, int x_end, int y_end, const void *data, AnimPlayer *player)
                              >;
@@ -130,7 +155,22 @@ public:
 
     bool sendEvent(const Event &event, bool clear_queue, EventFuture *future = nullptr);
 
-    bool notifyFlushFinished() const;
+    /**
+     * @brief Notify that the region of `flush_ready_signal` is flushed, must be called once for each region
+     *
+     * @param[in] is_drawn Whether the region reached the screen. The dirty-rect tracking only records the drawn
+     *                     regions, so a region which is not drawn is fully flushed next time.
+     */
+    bool notifyFlushFinished(bool is_drawn = true) const;
+
+    Stats getStats() const;
+    void resetStats();
+
+    /**
+     * @brief Forget the flushed content of all canvases, should be called when the screen is cleared by others,
+     *        so the next frames are fully flushed.
+     */
+    static void invalidateDirtyRegions();
 
     static FlushReadySignal flush_ready_signal;
     static AnimationStopSignal animation_stop_signal;
@@ -142,6 +182,15 @@ private:
         std::shared_ptr<EventPromise> promise;
     };
 
+    // Dirty-rect tracking, keys are `(x_start, y_start, x_end, y_end)`
+    using DirtyRect = std::tuple<int, int, int, int>;
+    // Band hashes of a region being flushed, recorded as drawn once its flush succeeds
+    struct PendingDirtyRegion {
+        DirtyRect rect;
+        std::vector<uint64_t> band_hashes;
+        uint32_t seq = 0;               // `0` if there is nothing to record
+    };
+
     bool loadAnimationConfig(const AnimPlayerPartitionConfig &partition_config);
     bool loadAnimationConfig(const AnimPlayerAnimAddress *anim_address, int num);
     bool loadAnimationConfig(const AnimPlayerAnimPath *anim_path, int num);
@@ -149,6 +198,16 @@ private:
     bool waitPlayerIdle();
     bool waitPlayerState(OperationState state);
     bool processEvent(std::shared_ptr<EventWrapper> event_wrapper);
+    void processDecodedRegion(int x_start, int y_start, int x_end, int y_end, const void *data, size_t stride);
+    void processFrameDone();
+    void releaseDecoder();
+    bool waitFlushIdle();
+    bool reserveSlotBuffer(int index, size_t size);
+    bool checkRegionDirty(
+        int x_start, int y_start, int x_end, int y_end, int &first_dirty_band, int &last_dirty_band, uint32_t &seq
+    );
+    void commitDirtyRegion(PendingDirtyRegion &pending, bool is_drawn) const;
+    void resetDirtyRegions();
 
     bool _is_begun = false;
     AnimPlayerCanvasConfig _canvas_config = {};
@@ -171,6 +230,58 @@ private:
     std::condition_variable _player_condition;
     anim_player_handle_t _player_handle = nullptr;
     mmap_assets_handle_t _assets_handle = nullptr;
+
+    // Flush pipeline and statistics, all protected by `_flush->mutex`
+    struct FlushSlot {
+        std::unique_ptr<uint8_t, void(*)(void *)> buffer{nullptr, heap_caps_free};   // Internal DMA-capable memory
+        size_t buffer_size = 0;
+        int x_start = 0;
+        int y_start = 0;
+        int x_end = 0;
+        int y_end = 0;
+        PendingDirtyRegion dirty;
+    };
+    struct FlushContext {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool enable_pipeline = false;
+        bool enable_dirty_rect = false;
+        // Pipeline
+        std::array<FlushSlot, 2> slots;
+        std::queue<int> ready_slots;
+        std::vector<int> free_slots;
+        int flushing_slot = -1;
+        bool is_flush_done = false;
+        bool is_direct_flush = false;   // A region is flushed from the decoder buffer, since no slot could be allocated
+        bool is_slot_drawn = false;
+        bool thread_need_exit = false;
+        boost::thread thread;
+        // Dirty-rect, hashes of the row bands of the current region, and the region flushed without a slot
+        std::vector<uint64_t> band_hashes;
+        PendingDirtyRegion direct_dirty;
+        // Timing
+        int64_t decoder_release_us = 0;
+        int64_t frame_done_us = 0;
+        int64_t flush_start_us = 0;
+        uint32_t frame_decode_us = 0;
+        uint32_t frame_flush_us = 0;
+        uint32_t frame_wait_us = 0;
+        Stats stats = {};
+    };
+    std::unique_ptr<FlushContext> _flush;
+
+    // Dirty-rect tracking of the content on screen, shared by the players drawing to the same canvas, so a region
+    // drawn by one player is never skipped by another one
+    struct DirtyRegion {
+        std::vector<uint64_t> band_hashes;  // Hashes of the row bands on screen, empty while being flushed
+        uint32_t pending_seq = 0;           // Sequence of the flush in progress, only this one may record its hashes
+    };
+    struct DirtyCanvas {
+        std::map<DirtyRect, DirtyRegion> regions;
+    };
+    static std::mutex _dirty_mutex;
+    static std::map<DirtyRect, DirtyCanvas> _dirty_canvases;
+    static uint32_t _dirty_seq;
 };
 
 } // namespace esp_brookesia::gui
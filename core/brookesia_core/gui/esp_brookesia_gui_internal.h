@@ -58,6 +58,13 @@
 #           define ESP_BROOKESIA_LVGL_CANVAS_ENABLE_DEBUG_LOG  (0)
 #       endif
 #   endif
+#   if !defined(ESP_BROOKESIA_LVGL_COMMAND_QUEUE_ENABLE_DEBUG_LOG)
+#       if defined(CONFIG_ESP_BROOKESIA_LVGL_COMMAND_QUEUE_ENABLE_DEBUG_LOG)
+#           define ESP_BROOKESIA_LVGL_COMMAND_QUEUE_ENABLE_DEBUG_LOG  CONFIG_ESP_BROOKESIA_LVGL_COMMAND_QUEUE_ENABLE_DEBUG_LOG
+#       else
+#           define ESP_BROOKESIA_LVGL_COMMAND_QUEUE_ENABLE_DEBUG_LOG  (0)
+#       endif
+#   endif
 #   if !defined(ESP_BROOKESIA_LVGL_CONTAINER_ENABLE_DEBUG_LOG)
 #       if defined(CONFIG_ESP_BROOKESIA_LVGL_CONTAINER_ENABLE_DEBUG_LOG)
 #           define ESP_BROOKESIA_LVGL_CONTAINER_ENABLE_DEBUG_LOG  CONFIG_ESP_BROOKESIA_LVGL_CONTAINER_ENABLE_DEBUG_LOG
@@ -93,6 +100,13 @@
 #           define ESP_BROOKESIA_LVGL_OBJECT_ENABLE_DEBUG_LOG  (0)
 #       endif
 #   endif
+#   if !defined(ESP_BROOKESIA_LVGL_SCALED_FONT_ENABLE_DEBUG_LOG)
+#       if defined(CONFIG_ESP_BROOKESIA_LVGL_SCALED_FONT_ENABLE_DEBUG_LOG)
+#           define ESP_BROOKESIA_LVGL_SCALED_FONT_ENABLE_DEBUG_LOG  CONFIG_ESP_BROOKESIA_LVGL_SCALED_FONT_ENABLE_DEBUG_LOG
+#       else
+#           define ESP_BROOKESIA_LVGL_SCALED_FONT_ENABLE_DEBUG_LOG  (0)
+#       endif
+#   endif
 #   if !defined(ESP_BROOKESIA_LVGL_SCREEN_ENABLE_DEBUG_LOG)
 #       if defined(CONFIG_ESP_BROOKESIA_LVGL_SCREEN_ENABLE_DEBUG_LOG)
 #           define ESP_BROOKESIA_LVGL_SCREEN_ENABLE_DEBUG_LOG  CONFIG_ESP_BROOKESIA_LVGL_SCREEN_ENABLE_DEBUG_LOG
@@ -109,6 +123,14 @@
 #   endif
 #endif
 
+#if !defined(ESP_BROOKESIA_LVGL_SCALED_FONT_CACHE_SIZE)
+#   if defined(CONFIG_ESP_BROOKESIA_LVGL_SCALED_FONT_CACHE_SIZE)
+#       define ESP_BROOKESIA_LVGL_SCALED_FONT_CACHE_SIZE  CONFIG_ESP_BROOKESIA_LVGL_SCALED_FONT_CACHE_SIZE
+#   else
+#       define ESP_BROOKESIA_LVGL_SCALED_FONT_CACHE_SIZE  (64 * 1024)
+#   endif
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////// Squareline ////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
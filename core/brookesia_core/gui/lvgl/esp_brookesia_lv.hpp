@@ -6,10 +6,13 @@
 #pragma once
 #include "esp_brookesia_lv_animation.hpp"
 #include "esp_brookesia_lv_canvas.hpp"
+#include "esp_brookesia_lv_command_queue.hpp"
 #include "esp_brookesia_lv_container.hpp"
 #include "esp_brookesia_lv_display.hpp"
+#include "esp_brookesia_lv_glyph_cache.hpp"
 #include "esp_brookesia_lv_helper.hpp"
 #include "esp_brookesia_lv_lock.hpp"
 #include "esp_brookesia_lv_object.hpp"
+#include "esp_brookesia_lv_scaled_font.hpp"
 #include "esp_brookesia_lv_screen.hpp"
 #include "esp_brookesia_lv_timer.hpp"
@@ -0,0 +1,264 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <utility>
+#include "esp_brookesia_gui_internal.h"
+#if !ESP_BROOKESIA_LVGL_COMMAND_QUEUE_ENABLE_DEBUG_LOG
+#   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
+#endif
+#include "private/esp_brookesia_lv_utils.hpp"
+#include "esp_brookesia_lv_command_queue.hpp"
+
+namespace esp_brookesia::gui {
+
+LvCommandQueue &LvCommandQueue::getInstance()
+{
+    static LvCommandQueue s_instance;
+    return s_instance;
+}
+
+LvCommandQueue::~LvCommandQueue()
+{
+    // Release the pending commands without executing them
+    Node *node = takePending();
+    while (node != nullptr) {
+        Node *next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+bool LvCommandQueue::begin(uint32_t period_ms)
+{
+    ESP_UTILS_LOG_TRACE_GUARD();
+
+    ESP_UTILS_LOGD("Param: period_ms(%d)", static_cast<int>(period_ms));
+
+    if (checkRunning()) {
+        ESP_UTILS_LOGD("Already running");
+        _user_count++;
+        return true;
+    }
+
+    _timer = lv_timer_create([](lv_timer_t *t) {
+        auto queue = static_cast<LvCommandQueue *>(lv_timer_get_user_data(t));
+        ESP_UTILS_CHECK_NULL_EXIT(queue, "Invalid queue");
+
+        queue->drain();
+    }, period_ms, this);
+    ESP_UTILS_CHECK_NULL_RETURN(_timer, false, "Create drain timer failed");
+    _user_count = 1;
+
+    return true;
+}
+
+bool LvCommandQueue::del()
+{
+    ESP_UTILS_LOG_TRACE_GUARD();
+
+    if (!checkRunning()) {
+        return true;
+    }
+    if (--_user_count > 0) {
+        ESP_UTILS_LOGD("Still used by %d users", _user_count);
+        return true;
+    }
+
+    // Flush the pending commands so the posters' updates are not lost
+    drain();
+
+    lv_timer_delete(_timer);
+    _timer = nullptr;
+
+    return true;
+}
+
+bool LvCommandQueue::post(Command command)
+{
+    return post(nullptr, 0, std::move(command));
+}
+
+bool LvCommandQueue::post(const void *target, uint32_t tag, Command command)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(command.operator bool(), false, "Invalid command");
+
+    Node *node = new (std::nothrow) Node{nullptr, target, tag, std::move(command)};
+    ESP_UTILS_CHECK_NULL_RETURN(node, false, "Alloc command node failed");
+
+    return push(node);
+}
+
+bool LvCommandQueue::push(Node *node)
+{
+    Node *head = _head.load(std::memory_order_relaxed);
+    do {
+        node->next = head;
+    } while (!_head.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+    _posted_count.fetch_add(1, std::memory_order_relaxed);
+
+    return true;
+}
+
+LvCommandQueue::Node *LvCommandQueue::takePending()
+{
+    // The posted commands are newer than the ones already taken, so they go in front
+    Node *node = _head.exchange(nullptr, std::memory_order_acquire);
+    if (node == nullptr) {
+        return std::exchange(_pending, nullptr);
+    }
+    Node *tail = node;
+    while (tail->next != nullptr) {
+        tail = tail->next;
+    }
+    tail->next = std::exchange(_pending, nullptr);
+
+    return node;
+}
+
+size_t LvCommandQueue::cancel(const void *target)
+{
+    ESP_UTILS_LOG_TRACE_GUARD();
+
+    ESP_UTILS_CHECK_NULL_RETURN(target, 0, "Invalid target");
+
+    size_t cancelled = 0;
+
+    // Keep the other commands for the next drain, in their order
+    Node **link = &_pending;
+    *link = takePending();
+    while (*link != nullptr) {
+        Node *node = *link;
+        if (node->target == target) {
+            *link = node->next;
+            delete node;
+            cancelled++;
+        } else {
+            link = &node->next;
+        }
+    }
+
+    // The commands not executed yet by the current drain, if cancelled by one of its commands
+    if (_is_draining) {
+        for (size_t i = _drain_index + 1; i < _drain_nodes.size(); i++) {
+            Node *node = _drain_nodes[i];
+            if ((node != nullptr) && (node->target == target)) {
+                _drain_nodes[i] = nullptr;
+                delete node;
+                cancelled++;
+            }
+        }
+    }
+
+    std::erase_if(_key_drain_seqs, [target](const auto & item) {
+        return item.first.target == target;
+    });
+
+    ESP_UTILS_LOGD("Cancelled %d commands of target(%p)", static_cast<int>(cancelled), target);
+
+    return cancelled;
+}
+
+size_t LvCommandQueue::drain()
+{
+    if (_is_draining) {
+        // The commands of this drain are still executed in order, the new ones are left to the next drain
+        return 0;
+    }
+
+    // Take all pending commands at once, the list is ordered from the newest to the oldest
+    Node *node = takePending();
+    if (node == nullptr) {
+        return 0;
+    }
+
+    auto start_time = std::chrono::steady_clock::now();
+
+    // Walk from the newest to the oldest, keep only the newest command of each key
+    uint32_t coalesced = 0;
+    _drain_seq++;
+    while (node != nullptr) {
+        Node *next = node->next;
+        bool keep = true;
+        if (node->target != nullptr) {
+            auto [it, is_inserted] = _key_drain_seqs.try_emplace(Key{node->target, node->tag}, _drain_seq);
+            if (is_inserted || (it->second != _drain_seq)) {
+                it->second = _drain_seq;
+            } else {
+                keep = false;
+            }
+        }
+        if (keep) {
+            _drain_nodes.push_back(node);
+        } else {
+            delete node;
+            coalesced++;
+        }
+        node = next;
+    }
+
+    // Execute in posting order
+    std::reverse(_drain_nodes.begin(), _drain_nodes.end());
+    uint32_t executed = 0;
+    _is_draining = true;
+    for (_drain_index = 0; _drain_index < _drain_nodes.size(); _drain_index++) {
+        node = _drain_nodes[_drain_index];
+        if (node == nullptr) {
+            continue;
+        }
+        node->command();
+        delete node;
+        executed++;
+    }
+    _is_draining = false;
+    _drain_nodes.clear();
+
+    uint32_t drain_time_us = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                 std::chrono::steady_clock::now() - start_time
+                             ).count());
+    ESP_UTILS_LOGD("Drained %d commands (coalesced: %d) in %d us", static_cast<int>(executed),
+                   static_cast<int>(coalesced), static_cast<int>(drain_time_us));
+
+    _executed_count.fetch_add(executed, std::memory_order_relaxed);
+    _coalesced_count.fetch_add(coalesced, std::memory_order_relaxed);
+    _frame_count.fetch_add(1, std::memory_order_relaxed);
+    _last_frame_commands.store(executed, std::memory_order_relaxed);
+    if (executed > _max_frame_commands.load(std::memory_order_relaxed)) {
+        _max_frame_commands.store(executed, std::memory_order_relaxed);
+    }
+    if (drain_time_us > _max_drain_time_us.load(std::memory_order_relaxed)) {
+        _max_drain_time_us.store(drain_time_us, std::memory_order_relaxed);
+    }
+
+    return executed;
+}
+
+LvCommandQueue::Stats LvCommandQueue::getStats() const
+{
+    return Stats{
+        .posted_count = _posted_count.load(std::memory_order_relaxed),
+        .executed_count = _executed_count.load(std::memory_order_relaxed),
+        .coalesced_count = _coalesced_count.load(std::memory_order_relaxed),
+        .frame_count = _frame_count.load(std::memory_order_relaxed),
+        .last_frame_commands = _last_frame_commands.load(std::memory_order_relaxed),
+        .max_frame_commands = _max_frame_commands.load(std::memory_order_relaxed),
+        .max_drain_time_us = _max_drain_time_us.load(std::memory_order_relaxed),
+    };
+}
+
+void LvCommandQueue::resetStats()
+{
+    _posted_count.store(0, std::memory_order_relaxed);
+    _executed_count.store(0, std::memory_order_relaxed);
+    _coalesced_count.store(0, std::memory_order_relaxed);
+    _frame_count.store(0, std::memory_order_relaxed);
+    _last_frame_commands.store(0, std::memory_order_relaxed);
+    _max_frame_commands.store(0, std::memory_order_relaxed);
+    _max_drain_time_us.store(0, std::memory_order_relaxed);
+}
+
+} // namespace esp_brookesia::gui
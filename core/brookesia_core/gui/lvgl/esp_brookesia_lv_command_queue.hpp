@@ -0,0 +1,141 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include "lvgl.h"
+
+namespace esp_brookesia::gui {
+
+/**
+ * @brief Lock-free multi-producer / single-consumer queue of UI commands.
+ *
+ * Any thread can post commands without taking `LvLock`. The commands are executed in the LVGL thread once per
+ * refresh period by an internal LVGL timer. Commands posted with a target and a tag are coalesced: when several
+ * commands with the same (target, tag) are pending, only the latest one is executed.
+ *
+ * The target also owns its commands: before it is deleted, it should stop the posters (e.g. disconnect the signals
+ * which post) and then `cancel()` its pending commands.
+ */
+class LvCommandQueue {
+public:
+    using Command = std::function<void()>;
+
+    struct Stats {
+        uint32_t posted_count;          // Total number of posted commands
+        uint32_t executed_count;        // Total number of executed commands
+        uint32_t coalesced_count;       // Total number of commands dropped because a newer one had the same key
+        uint32_t frame_count;           // Number of drains which executed at least one command
+        uint32_t last_frame_commands;   // Number of commands executed by the last non-empty drain
+        uint32_t max_frame_commands;    // Maximum number of commands executed by a single drain
+        uint32_t max_drain_time_us;     // Maximum time spent by a single drain
+    };
+
+    /**
+     * @brief Start draining the queue in the LVGL thread. Should be called with LVGL locked.
+     *
+     * @note Each user calls `begin()` and `del()` in pairs, the drain timer is deleted with the last user
+     *
+     * @param[in] period_ms Drain period, default is the LVGL refresh period, only used by the first user
+     * @return true if success, otherwise false
+     */
+    bool begin(uint32_t period_ms = LV_DEF_REFR_PERIOD);
+    bool del();
+
+    /**
+     * @brief Post a command which is always executed. Thread-safe and never blocks.
+     */
+    bool post(Command command);
+
+    /**
+     * @brief Post a command coalesced by (target, tag), only the latest pending one is executed.
+     *        Thread-safe and never blocks.
+     *
+     * @param[in] target Object the command applies to, usually the widget or its owner
+     * @param[in] tag    Identify the property of the target, such as "clock" or "battery"
+     */
+    bool post(const void *target, uint32_t tag, Command command);
+
+    /**
+     * @brief Drop the pending commands of a target without executing them. Should be called with LVGL locked.
+     *
+     * @param[in] target Target of the commands
+     * @return Number of dropped commands
+     */
+    size_t cancel(const void *target);
+
+    /**
+     * @brief Execute all pending commands in the calling thread. Should be called with LVGL locked.
+     *
+     * @return Number of executed commands, 0 if called from a command
+     */
+    size_t drain();
+
+    bool checkRunning() const
+    {
+        return (_timer != nullptr);
+    }
+    Stats getStats() const;
+    void resetStats();
+
+    static LvCommandQueue &getInstance();
+
+private:
+    struct Node {
+        Node *next;
+        const void *target;
+        uint32_t tag;
+        Command command;
+    };
+    struct Key {
+        const void *target;
+        uint32_t tag;
+
+        bool operator==(const Key &other) const
+        {
+            return (target == other.target) && (tag == other.tag);
+        }
+    };
+    struct KeyHash {
+        size_t operator()(const Key &key) const
+        {
+            return std::hash<const void *>()(key.target) ^ (static_cast<size_t>(key.tag) * 0x9e3779b9U);
+        }
+    };
+
+    LvCommandQueue() = default;
+    ~LvCommandQueue();
+    LvCommandQueue(const LvCommandQueue &) = delete;
+    LvCommandQueue &operator=(const LvCommandQueue &) = delete;
+
+    bool push(Node *node);
+    Node *takePending();
+
+    std::atomic<Node *> _head = nullptr;
+    // Only used in the LVGL thread
+    lv_timer_t *_timer = nullptr;
+    int _user_count = 0;
+    Node *_pending = nullptr;                               // Taken by `cancel()`, from the newest to the oldest
+    std::vector<Node *> _drain_nodes;                       // Reused by the drains, in the posting order
+    size_t _drain_index = 0;                                // Command being executed by the current drain
+    bool _is_draining = false;
+    uint32_t _drain_seq = 0;
+    std::unordered_map<Key, uint32_t, KeyHash> _key_drain_seqs; // Last drain which executed a key, kept across drains
+    // Statistics
+    std::atomic<uint32_t> _posted_count = 0;
+    std::atomic<uint32_t> _executed_count = 0;
+    std::atomic<uint32_t> _coalesced_count = 0;
+    std::atomic<uint32_t> _frame_count = 0;
+    std::atomic<uint32_t> _last_frame_commands = 0;
+    std::atomic<uint32_t> _max_frame_commands = 0;
+    std::atomic<uint32_t> _max_drain_time_us = 0;
+};
+
+} // namespace esp_brookesia::gui
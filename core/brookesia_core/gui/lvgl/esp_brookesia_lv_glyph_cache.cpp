@@ -0,0 +1,250 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include "esp_brookesia_lv_glyph_cache.hpp"
+
+using namespace std;
+
+namespace esp_brookesia::gui {
+
+namespace {
+
+inline uint32_t elapsed_us(const chrono::steady_clock::time_point &start)
+{
+    return static_cast<uint32_t>(
+               chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count()
+           );
+}
+
+// Source pixels covered by each destination pixel along one axis, with their weights
+struct Spans {
+    vector<int> first;
+    vector<int> count;
+    vector<float> weights;  // `count[i]` weights per destination pixel, from `offsets[i]`
+    vector<int> offsets;
+
+    void build(int src_size, float src_start, float step, int dst_size)
+    {
+        first.resize(dst_size);
+        count.resize(dst_size);
+        offsets.resize(dst_size);
+        weights.clear();
+        for (int i = 0; i < dst_size; i++) {
+            float start = src_start + i * step;
+            float end = start + step;
+            int begin_px = max(static_cast<int>(floorf(start)), 0);
+            int end_px = min(static_cast<int>(ceilf(end)), src_size);
+            first[i] = begin_px;
+            count[i] = max(end_px - begin_px, 0);
+            offsets[i] = static_cast<int>(weights.size());
+            for (int px = begin_px; px < end_px; px++) {
+                weights.push_back(min(end, px + 1.0f) - max(start, static_cast<float>(px)));
+            }
+        }
+    }
+};
+
+} // namespace
+
+GlyphCache::GlyphCache(size_t memory_budget)
+    : _memory_budget(memory_budget)
+{
+}
+
+void GlyphCache::setMemoryBudget(size_t memory_budget)
+{
+    lock_guard lock(_mutex);
+
+    _memory_budget = memory_budget;
+    evictByBudget(0);
+}
+
+size_t GlyphCache::getMemoryBudget(void) const
+{
+    lock_guard lock(_mutex);
+
+    return _memory_budget;
+}
+
+bool GlyphCache::get(
+    const void *font, uint32_t glyph_id, uint16_t width, uint16_t height, const RenderFunction &render,
+    uint8_t *dst, uint32_t dst_stride
+)
+{
+    if ((dst == nullptr) || (dst_stride < width)) {
+        return false;
+    }
+
+    lock_guard lock(_mutex);
+
+    Key key{font, glyph_id};
+    auto it = _entries.find(key);
+    if (it != _entries.end()) {
+        auto &entry = it->second;
+        _lru_keys.splice(_lru_keys.begin(), _lru_keys, entry.lru_it);
+        _hit_count++;
+        copyBitmap(entry, dst, dst_stride);
+        return true;
+    }
+    _miss_count++;
+
+    auto start_time = chrono::steady_clock::now();
+    size_t required_bytes = static_cast<size_t>(width) * height;
+    if (!evictByBudget(required_bytes)) {
+        // Too large or no cache, render into the destination directly
+        for (int y = 0; y < height; y++) {
+            memset(dst + y * dst_stride, 0, width);
+        }
+        return render(dst, dst_stride);
+    }
+
+    Entry entry;
+    entry.bitmap.assign(required_bytes, 0);
+    entry.width = width;
+    entry.height = height;
+    if (!render(entry.bitmap.data(), width)) {
+        return false;
+    }
+    _last_render_time_us = elapsed_us(start_time);
+    _max_render_time_us = max(_max_render_time_us, _last_render_time_us);
+
+    copyBitmap(entry, dst, dst_stride);
+    _lru_keys.push_front(key);
+    entry.lru_it = _lru_keys.begin();
+    _used_bytes += required_bytes;
+    _entries.emplace(key, std::move(entry));
+
+    return true;
+}
+
+void GlyphCache::remove(const void *font)
+{
+    lock_guard lock(_mutex);
+
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        auto current_it = it++;
+        if (current_it->first.font == font) {
+            removeEntry(current_it);
+        }
+    }
+}
+
+void GlyphCache::clear(void)
+{
+    lock_guard lock(_mutex);
+
+    while (!_entries.empty()) {
+        removeEntry(_entries.begin());
+    }
+}
+
+GlyphCache::Stats GlyphCache::getStats(void) const
+{
+    lock_guard lock(_mutex);
+
+    return Stats{
+        .glyph_num = _entries.size(),
+        .used_bytes = _used_bytes,
+        .hit_count = _hit_count,
+        .miss_count = _miss_count,
+        .evicted_count = _evicted_count,
+        .last_render_time_us = _last_render_time_us,
+        .max_render_time_us = _max_render_time_us,
+    };
+}
+
+void GlyphCache::scaleBitmap(
+    const uint8_t *src, int src_width, int src_height, uint32_t src_stride, float src_x, float src_y, float step,
+    uint8_t *dst, int dst_width, int dst_height, uint32_t dst_stride
+)
+{
+    if ((src == nullptr) || (dst == nullptr) || (step <= 0) || (dst_width <= 0) || (dst_height <= 0)) {
+        return;
+    }
+
+    // Reused by the glyphs rendered on the same thread
+    thread_local Spans x_spans;
+    thread_local Spans y_spans;
+    thread_local vector<float> columns;
+    x_spans.build(src_width, src_x, step, dst_width);
+    y_spans.build(src_height, src_y, step, dst_height);
+
+    // Horizontal pass, only on the source rows used by the vertical one
+    int row_begin = src_height;
+    int row_end = 0;
+    for (int y = 0; y < dst_height; y++) {
+        if (y_spans.count[y] > 0) {
+            row_begin = min(row_begin, y_spans.first[y]);
+            row_end = max(row_end, y_spans.first[y] + y_spans.count[y]);
+        }
+    }
+    columns.assign(static_cast<size_t>(max(row_end - row_begin, 0)) * dst_width, 0);
+    for (int row = row_begin; row < row_end; row++) {
+        const uint8_t *src_row = src + row * src_stride;
+        float *column_row = columns.data() + static_cast<size_t>(row - row_begin) * dst_width;
+        for (int x = 0; x < dst_width; x++) {
+            const float *weights = x_spans.weights.data() + x_spans.offsets[x];
+            const uint8_t *src_px = src_row + x_spans.first[x];
+            float sum = 0;
+            for (int i = 0; i < x_spans.count[x]; i++) {
+                sum += src_px[i] * weights[i];
+            }
+            column_row[x] = sum;
+        }
+    }
+
+    // Vertical pass, normalized by the area of a destination pixel
+    float normalize = 1.0f / (step * step);
+    for (int y = 0; y < dst_height; y++) {
+        uint8_t *dst_row = dst + y * dst_stride;
+        const float *weights = y_spans.weights.data() + y_spans.offsets[y];
+        for (int x = 0; x < dst_width; x++) {
+            float sum = 0;
+            for (int i = 0; i < y_spans.count[y]; i++) {
+                sum += columns[static_cast<size_t>(y_spans.first[y] + i - row_begin) * dst_width + x] * weights[i];
+            }
+            dst_row[x] = static_cast<uint8_t>(min(lroundf(sum * normalize), 255L));
+        }
+    }
+}
+
+void GlyphCache::removeEntry(unordered_map<Key, Entry, KeyHash>::iterator it)
+{
+    _used_bytes -= it->second.bitmap.size();
+    _lru_keys.erase(it->second.lru_it);
+    _entries.erase(it);
+}
+
+bool GlyphCache::evictByBudget(size_t required_bytes)
+{
+    auto fits = [&]() {
+        return (required_bytes <= _memory_budget) && (_used_bytes <= _memory_budget - required_bytes);
+    };
+
+    // Don't flush the cache for a glyph which can never fit
+    if (required_bytes > _memory_budget) {
+        return false;
+    }
+    while (!fits() && !_lru_keys.empty()) {
+        removeEntry(_entries.find(_lru_keys.back()));
+        _evicted_count++;
+    }
+
+    return fits();
+}
+
+void GlyphCache::copyBitmap(const Entry &entry, uint8_t *dst, uint32_t dst_stride)
+{
+    const uint8_t *src = entry.bitmap.data();
+    for (int y = 0; y < entry.height; y++) {
+        memcpy(dst + y * dst_stride, src + y * entry.width, entry.width);
+    }
+}
+
+} // namespace esp_brookesia::gui
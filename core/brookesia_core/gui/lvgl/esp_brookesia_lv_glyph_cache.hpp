@@ -0,0 +1,132 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace esp_brookesia::gui {
+
+/**
+ * @brief Cache of the glyph bitmaps rasterized at runtime, shared by all the fonts and sizes.
+ *
+ * Bitmaps are 8-bit coverage (A8) with a stride of their width. A lookup copies the bitmap out, so any entry can be
+ * evicted (LRU) to keep the cache under its memory budget. It is thread-safe, as the glyphs may be drawn by the draw
+ * units of LVGL on other threads.
+ *
+ * @note It doesn't depend on LVGL, see `esp_brookesia_lv_scaled_font.hpp` for the fonts using it.
+ */
+class GlyphCache {
+public:
+    /**
+     * @brief Render a glyph into a zero-filled bitmap with the given stride, return `false` if it failed
+     */
+    using RenderFunction = std::function<bool(uint8_t *bitmap, uint32_t stride)>;
+
+    struct Stats {
+        size_t glyph_num;
+        size_t used_bytes;              // Memory used by all cached bitmaps
+        uint32_t hit_count;
+        uint32_t miss_count;
+        uint32_t evicted_count;
+        uint32_t last_render_time_us;
+        uint32_t max_render_time_us;
+    };
+
+    /**
+     * @param[in] memory_budget Max bytes of all cached bitmaps, `0` disables the cache (glyphs are rendered on every
+     *                          lookup)
+     */
+    explicit GlyphCache(size_t memory_budget = 0);
+
+    GlyphCache(const GlyphCache &) = delete;
+    GlyphCache &operator=(const GlyphCache &) = delete;
+
+    void setMemoryBudget(size_t memory_budget);
+    size_t getMemoryBudget(void) const;
+
+    /**
+     * @brief Copy the bitmap of a glyph out, render and cache it first if needed.
+     *
+     * @param[in] font Identifies the font and size of the glyph, e.g. the address of the font
+     * @param[in] glyph_id Index of the glyph in the font
+     * @param[in] width Width of the bitmap, must be the same for all the lookups of the glyph
+     * @param[in] height Height of the bitmap, must be the same for all the lookups of the glyph
+     * @param[in] render Called on a miss, with the lock of the cache held, so the renderings never run concurrently
+     * @param[out] dst Destination of the bitmap, at least `dst_stride * height` bytes
+     * @param[in] dst_stride Stride of the destination, at least `width`
+     *
+     * @return `false` if the glyph is not cached and the rendering failed
+     */
+    bool get(
+        const void *font, uint32_t glyph_id, uint16_t width, uint16_t height, const RenderFunction &render,
+        uint8_t *dst, uint32_t dst_stride
+    );
+    /**
+     * @brief Drop the glyphs of a font, call it before the font is freed
+     */
+    void remove(const void *font);
+    void clear(void);
+
+    Stats getStats(void) const;
+
+    /**
+     * @brief Resample an 8-bit coverage bitmap with a box filter.
+     *
+     * Each destination pixel `(x, y)` averages the source area from `(src_x + x * step, src_y + y * step)` to
+     * `(src_x + (x + 1) * step, src_y + (y + 1) * step)`, in source pixels, which may be fractional and reach outside
+     * the source (the outside is empty). `step` is the inverse of the scale, e.g. `2` halves the size.
+     */
+    static void scaleBitmap(
+        const uint8_t *src, int src_width, int src_height, uint32_t src_stride, float src_x, float src_y, float step,
+        uint8_t *dst, int dst_width, int dst_height, uint32_t dst_stride
+    );
+
+private:
+    struct Key {
+        const void *font;
+        uint32_t glyph_id;
+
+        bool operator==(const Key &other) const
+        {
+            return (font == other.font) && (glyph_id == other.glyph_id);
+        }
+    };
+    struct KeyHash {
+        size_t operator()(const Key &key) const
+        {
+            return std::hash<const void *>()(key.font) ^ (static_cast<size_t>(key.glyph_id) * 0x9E3779B1u);
+        }
+    };
+    struct Entry {
+        std::vector<uint8_t> bitmap;
+        uint16_t width = 0;
+        uint16_t height = 0;
+        std::list<Key>::iterator lru_it;
+    };
+
+    void removeEntry(std::unordered_map<Key, Entry, KeyHash>::iterator it);
+    bool evictByBudget(size_t required_bytes);
+    static void copyBitmap(const Entry &entry, uint8_t *dst, uint32_t dst_stride);
+
+    mutable std::mutex _mutex;
+    size_t _memory_budget = 0;
+    std::list<Key> _lru_keys;   // Front is the most recently used
+    std::unordered_map<Key, Entry, KeyHash> _entries;
+    size_t _used_bytes = 0;
+    uint32_t _hit_count = 0;
+    uint32_t _miss_count = 0;
+    uint32_t _evicted_count = 0;
+    uint32_t _last_render_time_us = 0;
+    uint32_t _max_render_time_us = 0;
+};
+
+} // namespace esp_brookesia::gui
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <string>
 #include <cmath>
+#include <cstring>
 #include "esp_brookesia_gui_internal.h"
 #if !ESP_BROOKESIA_LVGL_HELPER_ENABLE_DEBUG_LOG
 #   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
@@ -321,4 +322,81 @@ lv_anim_path_cb_t getLvAnimPathCb(StyleAnimation::AnimationPathType type)
     return nullptr;
 }
 
+bool updateLvLabelText(lv_obj_t *label, const char *text)
+{
+    const char *current_text = lv_label_get_text(label);
+    if ((current_text != nullptr) && (strcmp(current_text, text) == 0)) {
+        return false;
+    }
+    lv_label_set_text(label, text);
+
+    return true;
+}
+
+bool updateLvObjStyle(lv_obj_t *obj, lv_style_prop_t prop, lv_style_value_t value, lv_style_selector_t selector)
+{
+    lv_style_value_t current_value = {};
+
+    // The whole value is compared, whatever its type. At worst, an unchanged value set by others is set again
+    if ((lv_obj_get_local_style_prop(obj, prop, &current_value, selector) == LV_STYLE_RES_FOUND) &&
+            (memcmp(&current_value, &value, sizeof(value)) == 0)) {
+        return false;
+    }
+    lv_obj_set_local_style_prop(obj, prop, value, selector);
+
+    return true;
+}
+
+bool updateLvObjStyleNum(lv_obj_t *obj, lv_style_prop_t prop, int32_t value, lv_style_selector_t selector)
+{
+    lv_style_value_t style_value = {};
+    style_value.num = value;
+
+    return updateLvObjStyle(obj, prop, style_value, selector);
+}
+
+bool updateLvObjStylePtr(lv_obj_t *obj, lv_style_prop_t prop, const void *value, lv_style_selector_t selector)
+{
+    lv_style_value_t style_value = {};
+    style_value.ptr = value;
+
+    return updateLvObjStyle(obj, prop, style_value, selector);
+}
+
+bool updateLvObjStyleColor(lv_obj_t *obj, lv_style_prop_t prop, lv_color_t value, lv_style_selector_t selector)
+{
+    lv_style_value_t style_value = {};
+    style_value.color = value;
+
+    return updateLvObjStyle(obj, prop, style_value, selector);
+}
+
+bool updateLvObjSize(lv_obj_t *obj, int32_t width, int32_t height)
+{
+    bool is_width_changed = updateLvObjStyleNum(obj, LV_STYLE_WIDTH, width);
+    bool is_height_changed = updateLvObjStyleNum(obj, LV_STYLE_HEIGHT, height);
+
+    return is_width_changed || is_height_changed;
+}
+
+bool updateLvImageSrc(lv_obj_t *image, const void *src)
+{
+    if (lv_image_get_src(image) == src) {
+        return false;
+    }
+    lv_image_set_src(image, src);
+
+    return true;
+}
+
+bool updateLvImageScale(lv_obj_t *image, uint32_t scale)
+{
+    if (lv_image_get_scale(image) == static_cast<int32_t>(scale)) {
+        return false;
+    }
+    lv_image_set_scale(image, scale);
+
+    return true;
+}
+
 } // namespace esp_brookesia::gui
@@ -70,6 +70,21 @@ bool getLvInternalFontBySize(uint8_t size_px, const lv_font_t **font);
 lv_color_t getLvRandomColor(void);
 lv_indev_t *getLvInputDev(const lv_display_t *display, lv_indev_type_t type);
 lv_anim_path_cb_t getLvAnimPathCb(esp_brookesia::gui::StyleAnimation::AnimationPathType type);
+
+/**
+ * @brief Retained updates, the object is only touched if the value changes. Setting the same value would still
+ *        invalidate the object, and refresh the layout for most of the style properties.
+ *
+ * @return true if the value changed, otherwise false
+ */
+bool updateLvLabelText(lv_obj_t *label, const char *text);
+bool updateLvObjStyle(lv_obj_t *obj, lv_style_prop_t prop, lv_style_value_t value, lv_style_selector_t selector = 0);
+bool updateLvObjStyleNum(lv_obj_t *obj, lv_style_prop_t prop, int32_t value, lv_style_selector_t selector = 0);
+bool updateLvObjStylePtr(lv_obj_t *obj, lv_style_prop_t prop, const void *value, lv_style_selector_t selector = 0);
+bool updateLvObjStyleColor(lv_obj_t *obj, lv_style_prop_t prop, lv_color_t value, lv_style_selector_t selector = 0);
+bool updateLvObjSize(lv_obj_t *obj, int32_t width, int32_t height);
+bool updateLvImageSrc(lv_obj_t *image, const void *src);
+bool updateLvImageScale(lv_obj_t *image, uint32_t scale);
 } // namespace esp_brookesia::gui
 
 #define ESP_BROOKESIA_MAKE_LV_OBJ_PTR(type, parent) \
@@ -3,6 +3,7 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <chrono>
 #include "esp_brookesia_gui_internal.h"
 #if !ESP_BROOKESIA_LVGL_LOCK_ENABLE_DEBUG_LOG
 #   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
@@ -34,9 +35,25 @@ bool LvLock::lock(int timeout_ms)
     ESP_UTILS_LOGD("Param: timeout_ms(%d)", timeout_ms);
 
     ESP_UTILS_CHECK_FALSE_RETURN(lock_cb_.operator bool(), false, "Lock callback not registered");
+
+    auto start_time = std::chrono::steady_clock::now();
     ESP_UTILS_CHECK_FALSE_RETURN(lock_cb_(timeout_ms), false, "Lock callback failed");
+    uint32_t wait_time_us = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::chrono::steady_clock::now() - start_time
+                            ).count());
+
     lock_count_++;
-    ESP_UTILS_LOGD("Locked count: %d", static_cast<int>(lock_count_));
+    ESP_UTILS_LOGD("Locked count: %d, wait time: %d us", static_cast<int>(lock_count_), static_cast<int>(wait_time_us));
+
+    stats_lock_count_.fetch_add(1, std::memory_order_relaxed);
+    stats_total_wait_time_us_.fetch_add(wait_time_us, std::memory_order_relaxed);
+    if (wait_time_us > 1000) {
+        stats_contended_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+    uint32_t max_wait_time_us = stats_max_wait_time_us_.load(std::memory_order_relaxed);
+    while ((wait_time_us > max_wait_time_us) &&
+            !stats_max_wait_time_us_.compare_exchange_weak(max_wait_time_us, wait_time_us, std::memory_order_relaxed)) {
+    }
 
     return true;
 }
@@ -55,6 +72,24 @@ bool LvLock::unlock()
     return true;
 }
 
+LvLock::Stats LvLock::getStats() const
+{
+    return Stats{
+        .lock_count = stats_lock_count_.load(std::memory_order_relaxed),
+        .contended_count = stats_contended_count_.load(std::memory_order_relaxed),
+        .total_wait_time_us = stats_total_wait_time_us_.load(std::memory_order_relaxed),
+        .max_wait_time_us = stats_max_wait_time_us_.load(std::memory_order_relaxed),
+    };
+}
+
+void LvLock::resetStats()
+{
+    stats_lock_count_.store(0, std::memory_order_relaxed);
+    stats_contended_count_.store(0, std::memory_order_relaxed);
+    stats_total_wait_time_us_.store(0, std::memory_order_relaxed);
+    stats_max_wait_time_us_.store(0, std::memory_order_relaxed);
+}
+
 LvLockGuard::LvLockGuard()
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <functional>
 
 namespace esp_brookesia::gui {
@@ -15,9 +16,19 @@ public:
     using LockCallback = std::function<bool(int timeout_ms)>;
     using UnlockCallback = std::function<bool()>;
 
+    struct Stats {
+        uint32_t lock_count;            // Number of successful locks
+        uint32_t contended_count;       // Number of locks which waited longer than 1 ms
+        uint64_t total_wait_time_us;    // Accumulated time spent waiting for the lock
+        uint32_t max_wait_time_us;      // Maximum time spent waiting for a single lock
+    };
+
     bool lock(int timeout_ms = -1);
     bool unlock();
 
+    Stats getStats() const;
+    void resetStats();
+
     static LvLock &getInstance();
     static void registerCallbacks(LockCallback lock_cb, UnlockCallback unlock_cb);
 
@@ -30,6 +41,11 @@ private:
     LockCallback lock_cb_;
     UnlockCallback unlock_cb_;
     std::atomic<size_t> lock_count_ = 0;
+    // Statistics
+    std::atomic<uint32_t> stats_lock_count_ = 0;
+    std::atomic<uint32_t> stats_contended_count_ = 0;
+    std::atomic<uint64_t> stats_total_wait_time_us_ = 0;
+    std::atomic<uint32_t> stats_max_wait_time_us_ = 0;
 };
 
 class LvLockGuard {
@@ -0,0 +1,221 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include "esp_brookesia_gui_internal.h"
+#if !ESP_BROOKESIA_LVGL_SCALED_FONT_ENABLE_DEBUG_LOG
+#   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
+#endif
+#include "private/esp_brookesia_lv_utils.hpp"
+#include "esp_brookesia_lv_scaled_font.hpp"
+
+using namespace std;
+
+namespace esp_brookesia::gui {
+
+namespace {
+
+struct ScaledFont {
+    lv_font_t font;
+    LvScaledFontDsc dsc;
+};
+
+// Box of a glyph once scaled, rounded outwards, and the area of the master it comes from
+struct ScaledGlyphBox {
+    int32_t ofs_x;
+    int32_t ofs_y;
+    uint16_t box_w;
+    uint16_t box_h;
+    float src_x;
+    float src_y;
+    float step;
+};
+
+ScaledGlyphBox scaleGlyphBox(const LvScaledFontDsc &dsc, const lv_font_fmt_txt_glyph_dsc_t &master_glyph)
+{
+    if ((master_glyph.box_w == 0) || (master_glyph.box_h == 0)) {
+        return {};
+    }
+
+    float scale = static_cast<float>(dsc.size_px) / dsc.master_size_px;
+    int32_t left = static_cast<int32_t>(floorf(master_glyph.ofs_x * scale));
+    int32_t right = static_cast<int32_t>(ceilf((master_glyph.ofs_x + master_glyph.box_w) * scale));
+    int32_t bottom = static_cast<int32_t>(floorf(master_glyph.ofs_y * scale));
+    int32_t top = static_cast<int32_t>(ceilf((master_glyph.ofs_y + master_glyph.box_h) * scale));
+
+    // The rows of the bitmaps go from the top to the bottom
+    return ScaledGlyphBox{
+        .ofs_x = left,
+        .ofs_y = bottom,
+        .box_w = static_cast<uint16_t>(right - left),
+        .box_h = static_cast<uint16_t>(top - bottom),
+        .src_x = left / scale - master_glyph.ofs_x,
+        .src_y = (master_glyph.ofs_y + master_glyph.box_h) - top / scale,
+        .step = 1 / scale,
+    };
+}
+
+bool isFmtTxtFont(const lv_font_t *font)
+{
+    return (font != nullptr) && (font->get_glyph_dsc == lv_font_get_glyph_dsc_fmt_txt) && (font->dsc != nullptr);
+}
+
+/**
+ * The master glyphs are decoded into it. It is shared by all the renderings without any lock of its own, so it must
+ * only be used from the render callback of `GlyphCache::get()`, which is called with the lock of the glyph cache held.
+ */
+lv_draw_buf_t *getMasterDrawBuf(uint32_t width, uint32_t height)
+{
+    static lv_draw_buf_t *draw_buf = nullptr;
+
+    if ((draw_buf != nullptr) && (draw_buf->header.w >= width) && (draw_buf->header.h >= height)) {
+        return draw_buf;
+    }
+    if (draw_buf != nullptr) {
+        width = max<uint32_t>(width, draw_buf->header.w);
+        height = max<uint32_t>(height, draw_buf->header.h);
+        lv_draw_buf_destroy(draw_buf);
+    }
+    draw_buf = lv_draw_buf_create(width, height, LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+
+    return draw_buf;
+}
+
+// Only called from the render callback of the glyph cache, see `getMasterDrawBuf()`
+bool renderGlyph(
+    const LvScaledFontDsc &dsc, uint32_t glyph_id, const ScaledGlyphBox &box, uint8_t *bitmap, uint32_t stride
+)
+{
+    auto master_fmt_dsc = static_cast<const lv_font_fmt_txt_dsc_t *>(dsc.master->dsc);
+    const auto &master_glyph = master_fmt_dsc->glyph_dsc[glyph_id];
+
+    lv_draw_buf_t *master_draw_buf = getMasterDrawBuf(master_glyph.box_w, master_glyph.box_h);
+    ESP_UTILS_CHECK_NULL_RETURN(master_draw_buf, false, "Create master draw buffer failed");
+
+    lv_font_glyph_dsc_t master_glyph_dsc = {};
+    master_glyph_dsc.resolved_font = dsc.master;
+    master_glyph_dsc.gid.index = glyph_id;
+    master_glyph_dsc.box_w = master_glyph.box_w;
+    master_glyph_dsc.box_h = master_glyph.box_h;
+    // `LV_FONT_GLYPH_FORMAT_A1/2/4/8` are the bpp, they are decoded to A8 anyway
+    master_glyph_dsc.format = static_cast<lv_font_glyph_format_t>(master_fmt_dsc->bpp);
+    ESP_UTILS_CHECK_NULL_RETURN(
+        dsc.master->get_glyph_bitmap(&master_glyph_dsc, master_draw_buf), false, "Get master glyph(%d) failed",
+        static_cast<int>(glyph_id)
+    );
+
+    GlyphCache::scaleBitmap(
+        static_cast<const uint8_t *>(master_draw_buf->data), master_glyph.box_w, master_glyph.box_h,
+        lv_draw_buf_width_to_stride(master_glyph.box_w, LV_COLOR_FORMAT_A8), box.src_x, box.src_y, box.step,
+        bitmap, box.box_w, box.box_h, stride
+    );
+
+    return true;
+}
+
+} // namespace
+
+bool getLvScaledFontGlyphDsc(const lv_font_t *font, lv_font_glyph_dsc_t *dsc, uint32_t letter, uint32_t letter_next)
+{
+    auto scaled_dsc = static_cast<const LvScaledFontDsc *>(font->dsc);
+    const lv_font_t *master = scaled_dsc->master;
+
+    // Not through `lv_font_get_glyph_dsc()`, the missing glyphs are left to the fallback of the scaled font
+    if (!master->get_glyph_dsc(master, dsc, letter, letter_next)) {
+        return false;
+    }
+
+    // The index of the glyph in the master is kept, for the bitmap
+    auto master_fmt_dsc = static_cast<const lv_font_fmt_txt_dsc_t *>(master->dsc);
+    auto box = scaleGlyphBox(*scaled_dsc, master_fmt_dsc->glyph_dsc[dsc->gid.index]);
+    dsc->adv_w = static_cast<uint16_t>(lroundf(static_cast<float>(dsc->adv_w) * scaled_dsc->size_px /
+                                       scaled_dsc->master_size_px));
+    dsc->box_w = box.box_w;
+    dsc->box_h = box.box_h;
+    dsc->ofs_x = static_cast<int16_t>(box.ofs_x);
+    dsc->ofs_y = static_cast<int16_t>(box.ofs_y);
+    dsc->format = LV_FONT_GLYPH_FORMAT_A8;
+    dsc->resolved_font = font;
+
+    return true;
+}
+
+const void *getLvScaledFontGlyphBitmap(lv_font_glyph_dsc_t *dsc, lv_draw_buf_t *draw_buf)
+{
+    const lv_font_t *font = dsc->resolved_font;
+    if ((dsc->box_w == 0) || (dsc->box_h == 0) || (draw_buf == nullptr)) {
+        return nullptr;
+    }
+
+    auto scaled_dsc = static_cast<const LvScaledFontDsc *>(font->dsc);
+    auto master_fmt_dsc = static_cast<const lv_font_fmt_txt_dsc_t *>(scaled_dsc->master->dsc);
+    uint32_t glyph_id = dsc->gid.index;
+    auto box = scaleGlyphBox(*scaled_dsc, master_fmt_dsc->glyph_dsc[glyph_id]);
+
+    bool is_ok = getLvScaledFontCache().get(font, glyph_id, box.box_w, box.box_h,
+    [&](uint8_t *bitmap, uint32_t stride) {
+        return renderGlyph(*scaled_dsc, glyph_id, box, bitmap, stride);
+    }, static_cast<uint8_t *>(draw_buf->data), draw_buf->header.stride);
+    ESP_UTILS_CHECK_FALSE_RETURN(is_ok, nullptr, "Render glyph(%d) of font(%d px) failed", static_cast<int>(glyph_id),
+                                 scaled_dsc->size_px);
+
+    return draw_buf;
+}
+
+const lv_font_t *getLvScaledFont(const lv_font_t *master, uint8_t master_size_px, uint8_t size_px)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(isFmtTxtFont(master), nullptr, "Invalid master font");
+    ESP_UTILS_CHECK_FALSE_RETURN((master_size_px > 0) && (size_px > 0), nullptr, "Invalid size");
+
+    // Never freed, the fonts may be used by any style
+    static map<pair<const lv_font_t *, uint8_t>, unique_ptr<ScaledFont>> fonts;
+    static mutex fonts_mutex;
+
+    lock_guard lock(fonts_mutex);
+    auto &scaled_font = fonts[{master, size_px}];
+    if (scaled_font != nullptr) {
+        return &scaled_font->font;
+    }
+
+    ESP_UTILS_LOGD("Create font(%d px) from master(%d px)", size_px, master_size_px);
+
+    scaled_font = make_unique<ScaledFont>();
+    scaled_font->dsc = LvScaledFontDsc{master, master_size_px, size_px};
+    scaled_font->font = makeLvScaledFont(scaled_font->dsc);
+
+    return &scaled_font->font;
+}
+
+lv_font_t makeLvScaledFont(const LvScaledFontDsc &dsc)
+{
+    const lv_font_t *master = dsc.master;
+    float scale = static_cast<float>(dsc.size_px) / dsc.master_size_px;
+
+    lv_font_t font = {};
+    font.get_glyph_dsc = getLvScaledFontGlyphDsc;
+    font.get_glyph_bitmap = getLvScaledFontGlyphBitmap;
+    font.line_height = lroundf(master->line_height * scale);
+    font.base_line = lroundf(master->base_line * scale);
+    font.subpx = LV_FONT_SUBPX_NONE;
+    font.underline_position = static_cast<int8_t>(lroundf(master->underline_position * scale));
+    font.underline_thickness = static_cast<int8_t>(max(lroundf(master->underline_thickness * scale), 1L));
+    font.dsc = &dsc;
+    font.fallback = master->fallback;
+
+    return font;
+}
+
+GlyphCache &getLvScaledFontCache(void)
+{
+    static GlyphCache cache(ESP_BROOKESIA_LVGL_SCALED_FONT_CACHE_SIZE);
+
+    return cache;
+}
+
+} // namespace esp_brookesia::gui
@@ -0,0 +1,58 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+#include "esp_brookesia_lv_helper.hpp"
+#include "esp_brookesia_lv_glyph_cache.hpp"
+
+namespace esp_brookesia::gui {
+
+/**
+ * @brief Descriptor (`lv_font_t::dsc`) of a font rendered from a larger master font.
+ *
+ * The glyphs are scaled down from the master when they are drawn for the first time, then kept in the glyph cache
+ * shared by all the scaled fonts (see `getLvScaledFontCache()`), so a single master replaces the fonts baked at every
+ * size.
+ */
+struct LvScaledFontDsc {
+    const lv_font_t *master;    // Must be a `lv_font_fmt_txt` font, e.g. generated by `lv_font_conv`
+    uint8_t master_size_px;
+    uint8_t size_px;
+};
+
+/**
+ * @brief Callbacks of the scaled fonts, set by `makeLvScaledFont()`
+ */
+bool getLvScaledFontGlyphDsc(const lv_font_t *font, lv_font_glyph_dsc_t *dsc, uint32_t letter, uint32_t letter_next);
+const void *getLvScaledFontGlyphBitmap(lv_font_glyph_dsc_t *dsc, lv_draw_buf_t *draw_buf);
+
+/**
+ * @brief Get a font scaled from a master font, created on the first call for each master and size. The metrics are
+ *        the ones of the master scaled.
+ *
+ * @return `nullptr` if the master is not a `lv_font_fmt_txt` font or the size is invalid
+ */
+const lv_font_t *getLvScaledFont(const lv_font_t *master, uint8_t master_size_px, uint8_t size_px);
+
+/**
+ * @brief Make a scaled font, with the metrics of the master scaled, e.g. to define one statically:
+ *
+ * @code
+ * static const LvScaledFontDsc font_16_dsc = {&font_48, 48, 16};
+ * const lv_font_t font_16 = makeLvScaledFont(font_16_dsc);
+ * @endcode
+ *
+ * @param[in] dsc Descriptor of the font, must outlive it. The master must be a `lv_font_fmt_txt` font
+ */
+lv_font_t makeLvScaledFont(const LvScaledFontDsc &dsc);
+
+/**
+ * @brief Get the glyph cache of all the scaled fonts, e.g. to change its budget or read its statistics
+ */
+GlyphCache &getLvScaledFontCache(void);
+
+} // namespace esp_brookesia::gui
@@ -26,6 +26,9 @@ using NameStylesheetMap = std::unordered_map<std::string, std::shared_ptr<T>>;
 template <typename T>
 using ResolutionNameStylesheetMap = std::map<uint32_t, NameStylesheetMap<T>>;
 
+template <typename T>
+using ResolutionNameStaticStylesheetMap = std::map<uint32_t, std::unordered_map<std::string, const T *>>;
+
 // *INDENT-OFF*
 template <typename T>
 class StylesheetManager {
@@ -36,6 +39,18 @@ public:
     virtual bool calibrateScreenSize(StyleSize &size) = 0;
 
     bool addStylesheet(const char *name, const StyleSize &screen_size, const T &stylesheet);
+    /**
+     * @brief Add a stylesheet without copying it, it is only copied and calibrated when it is first used, so the
+     *        stylesheets of the other resolutions cost neither RAM nor boot time
+     *
+     * @param name The name of the stylesheet
+     * @param screen_size The screen size of the stylesheet
+     * @param stylesheet The stylesheet, must have a static storage duration (e.g. `constexpr`, kept in flash)
+     *
+     * @return true if success, otherwise false
+     *
+     */
+    bool addStaticStylesheet(const char *name, const StyleSize &screen_size, const T &stylesheet);
     bool activateStylesheet(const StyleSize &screen_size, const T &stylesheet);
     bool activateStylesheet(const char *name, const StyleSize &screen_size);
 
@@ -81,6 +96,10 @@ protected:
 
 private:
     ResolutionNameStylesheetMap<T> _resolution_name_stylesheet_map;
+    // Not calibrated yet, moved to `_resolution_name_stylesheet_map` once used
+    ResolutionNameStaticStylesheetMap<T> _resolution_name_static_stylesheet_map;
+
+    const T *calibrateStaticStylesheet(uint32_t resolution, const StyleSize &screen_size, const char *name);
 
     uint32_t getResolution(const StyleSize &screen_size)
     {
@@ -130,6 +149,10 @@ bool StylesheetManager<T>::addStylesheet(const char *name, const StyleSize &scre
 
     // Check if the resolution is already exist
     resolution = getResolution(calibrate_size);
+    auto it_static_map = _resolution_name_static_stylesheet_map.find(resolution);
+    if (it_static_map != _resolution_name_static_stylesheet_map.end()) {
+        it_static_map->second.erase(name);
+    }
     auto it_resolution_map = _resolution_name_stylesheet_map.find(resolution);
     // If not exist, create a new map which contains the name and data
     if (it_resolution_map == _resolution_name_stylesheet_map.end()) {
@@ -150,6 +173,33 @@ bool StylesheetManager<T>::addStylesheet(const char *name, const StyleSize &scre
     return true;
 }
 
+template <typename T>
+bool StylesheetManager<T>::addStaticStylesheet(const char *name, const StyleSize &screen_size, const T &stylesheet)
+{
+    StyleSize calibrate_size = screen_size;
+
+    // ESP_UTILS_CHECK_NULL_RETURN(name, false, "Invalid name");
+    if (name == nullptr) {
+        return false;
+    }
+
+    // ESP_UTILS_CHECK_FALSE_RETURN(calibrateScreenSize(calibrate_size), false, "Invalid screen size");
+    // ESP_UTILS_LOGD("Add static stylesheet(%s - %dx%d)", name, calibrate_size.width, calibrate_size.height);
+    if (!calibrateScreenSize(calibrate_size)) {
+        return false;
+    }
+
+    // Overwrite the stylesheet with the same name and resolution, if any
+    uint32_t resolution = getResolution(calibrate_size);
+    auto it_resolution_map = _resolution_name_stylesheet_map.find(resolution);
+    if (it_resolution_map != _resolution_name_stylesheet_map.end()) {
+        it_resolution_map->second.erase(name);
+    }
+    _resolution_name_static_stylesheet_map[resolution][std::string(name)] = &stylesheet;
+
+    return true;
+}
+
 template <typename T>
 bool StylesheetManager<T>::activateStylesheet(const StyleSize &screen_size,
         const T &stylesheet)
@@ -214,6 +264,9 @@ size_t StylesheetManager<T>::getStylesheetCount(void) const
     for (auto &name_stylesheet_map : _resolution_name_stylesheet_map) {
         count += name_stylesheet_map.second.size();
     }
+    for (auto &name_stylesheet_map : _resolution_name_static_stylesheet_map) {
+        count += name_stylesheet_map.second.size();
+    }
 
     return count;
 }
@@ -268,13 +321,13 @@ const T *StylesheetManager<T>::getStylesheet(const char *name, const StyleSize &
     resolution = getResolution(calibrate_size);
     auto it_resolution_map = _resolution_name_stylesheet_map.find(resolution);
     if (it_resolution_map == _resolution_name_stylesheet_map.end()) {
-        return nullptr;
+        return calibrateStaticStylesheet(resolution, calibrate_size, name);
     }
 
     // If exist, check if the name is already exist
     auto it_name_map = it_resolution_map->second.find(name);
     if (it_name_map == it_resolution_map->second.end()) {
-        return nullptr;
+        return calibrateStaticStylesheet(resolution, calibrate_size, name);
     }
 
     return it_name_map->second.get();
@@ -295,16 +348,18 @@ const T *StylesheetManager<T>::getStylesheet(const StyleSize &screen_size)
     // Check if the resolution is already exist
     resolution = getResolution(calibrate_size);
     auto it_resolution_map = _resolution_name_stylesheet_map.find(resolution);
-    if (it_resolution_map == _resolution_name_stylesheet_map.end()) {
-        return nullptr;
+    if ((it_resolution_map != _resolution_name_stylesheet_map.end()) && !it_resolution_map->second.empty()) {
+        return it_resolution_map->second.begin()->second.get();
     }
 
-    auto name_map = it_resolution_map->second;
-    if (name_map.empty()) {
+    // Otherwise, calibrate the first static one
+    auto it_static_map = _resolution_name_static_stylesheet_map.find(resolution);
+    if ((it_static_map == _resolution_name_static_stylesheet_map.end()) || it_static_map->second.empty()) {
         return nullptr;
     }
+    std::string name = it_static_map->second.begin()->first;
 
-    return name_map.begin()->second.get();
+    return calibrateStaticStylesheet(resolution, calibrate_size, name.c_str());
 }
 
 template <typename T>
@@ -312,10 +367,45 @@ bool StylesheetManager<T>::del(void)
 {
     _active_stylesheet = {};
     _resolution_name_stylesheet_map.clear();
+    _resolution_name_static_stylesheet_map.clear();
 
     return true;
 }
 
+template <typename T>
+const T *StylesheetManager<T>::calibrateStaticStylesheet(
+    uint32_t resolution, const StyleSize &screen_size, const char *name
+)
+{
+    auto it_static_map = _resolution_name_static_stylesheet_map.find(resolution);
+    if (it_static_map == _resolution_name_static_stylesheet_map.end()) {
+        return nullptr;
+    }
+    auto it_name_map = it_static_map->second.find(name);
+    if (it_name_map == it_static_map->second.end()) {
+        return nullptr;
+    }
+
+    // ESP_UTILS_LOGD("Calibrate static stylesheet(%s - %dx%d)", name, screen_size.width, screen_size.height);
+    std::shared_ptr<T> calibration_stylesheet = std::make_shared<T>(*it_name_map->second);
+    // ESP_UTILS_CHECK_NULL_RETURN(calibration_stylesheet, nullptr, "Create stylesheet failed");
+    if (calibration_stylesheet == nullptr) {
+        return nullptr;
+    }
+    // ESP_UTILS_CHECK_FALSE_RETURN(
+    //     calibrateStylesheet(screen_size, *calibration_stylesheet), nullptr, "Invalid stylesheet"
+    // );
+    if (!calibrateStylesheet(screen_size, *calibration_stylesheet)) {
+        return nullptr;
+    }
+
+    auto &stylesheet = _resolution_name_stylesheet_map[resolution][it_name_map->first];
+    stylesheet = calibration_stylesheet;
+    it_static_map->second.erase(it_name_map);
+
+    return stylesheet.get();
+}
+
 } // namespace esp_brookesia::gui
 
 template <typename T>
@@ -0,0 +1,47 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "esp_brookesia_systems_internal.h"
+
+#if ESP_BROOKESIA_BASE_ENABLE_SCALED_FONTS
+#include "lvgl/esp_brookesia_lv_scaled_font.hpp"
+#include "base/assets/esp_brookesia_base_assets.h"
+
+using esp_brookesia::gui::LvScaledFontDsc;
+using esp_brookesia::gui::makeLvScaledFont;
+
+/**
+ * All the sizes are rendered from the 48 px font at runtime, the baked ones are not built (see `CMakeLists.txt`). The
+ * metrics are the ones of the master scaled, the same as the sizes served by `getLvScaledFont()`. They are set
+ * during the static initialization, the master is a constant so it is always ready before.
+ */
+#define MAISON_NEUE_BOOK_SCALED_FONT(size)                                              \
+    static const LvScaledFontDsc maison_neue_book_##size##_dsc = {                      \
+        &esp_brookesia_font_maison_neue_book_48, 48, size                               \
+    };                                                                                   \
+    const lv_font_t esp_brookesia_font_maison_neue_book_##size = makeLvScaledFont(maison_neue_book_##size##_dsc)
+
+MAISON_NEUE_BOOK_SCALED_FONT(8);
+MAISON_NEUE_BOOK_SCALED_FONT(10);
+MAISON_NEUE_BOOK_SCALED_FONT(12);
+MAISON_NEUE_BOOK_SCALED_FONT(14);
+MAISON_NEUE_BOOK_SCALED_FONT(16);
+MAISON_NEUE_BOOK_SCALED_FONT(18);
+MAISON_NEUE_BOOK_SCALED_FONT(20);
+MAISON_NEUE_BOOK_SCALED_FONT(22);
+MAISON_NEUE_BOOK_SCALED_FONT(24);
+MAISON_NEUE_BOOK_SCALED_FONT(26);
+MAISON_NEUE_BOOK_SCALED_FONT(28);
+MAISON_NEUE_BOOK_SCALED_FONT(30);
+MAISON_NEUE_BOOK_SCALED_FONT(32);
+MAISON_NEUE_BOOK_SCALED_FONT(34);
+MAISON_NEUE_BOOK_SCALED_FONT(36);
+MAISON_NEUE_BOOK_SCALED_FONT(38);
+MAISON_NEUE_BOOK_SCALED_FONT(40);
+MAISON_NEUE_BOOK_SCALED_FONT(42);
+MAISON_NEUE_BOOK_SCALED_FONT(44);
+MAISON_NEUE_BOOK_SCALED_FONT(46);
+
+#endif // ESP_BROOKESIA_BASE_ENABLE_SCALED_FONTS
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <algorithm>
+#include <vector>
+#include "esp_heap_caps.h"
 #include "esp_brookesia_systems_internal.h"
 #if !ESP_BROOKESIA_BASE_APP_ENABLE_DEBUG_LOG
 #   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
@@ -22,6 +24,20 @@ using namespace esp_brookesia::gui;
 
 namespace esp_brookesia::systems::base {
 
+static size_t getLvMemoryUsedSize(void)
+{
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    lv_mem_monitor_t monitor = {};
+    lv_mem_monitor(&monitor);
+
+    return monitor.total_size - monitor.free_size;
+#else
+    // LVGL allocates from the system heap (e.g. `CONFIG_LV_USE_CLIB_MALLOC`), which `lv_mem_monitor()` can't see. The
+    // size also counts the allocations of the other tasks, so it is only meaningful as a difference around `run()`
+    return heap_caps_get_total_size(MALLOC_CAP_8BIT) - heap_caps_get_free_size(MALLOC_CAP_8BIT);
+#endif
+}
+
 bool App::checkInitialized(void) const
 {
     return (_id >= APP_ID_MIN) && (_system_context != nullptr) && (_system_context->getManager().getInstalledApp(_id) == this);
@@ -126,10 +142,10 @@ bool App::endRecordResource(void)
             (resource_loop_count++ <  RESOURCE_LOOP_COUNT_MAX); i++) {
         screen = (lv_obj_t *)disp->screens[i];
         // Record or update the record information of the screen
-        _resource_screens_class_parent_map[screen] = {screen->class_p, (lv_obj_t *)screen->parent};
-        if (find(_resource_screens.begin(), _resource_screens.end(), screen) == _resource_screens.end()) {
-            // Only record the newest timer
-            _resource_screens.push_back(screen);
+        auto [screen_it, is_new] = _resource_screens.insert_or_assign(
+                                       screen, make_pair(screen->class_p, (lv_obj_t *)screen->parent)
+                                   );
+        if (is_new) {
             _resource_screen_count++;
             // Move screens to visual area when loaded only if needed
             if (_active_config.flags.enable_resize_visual_area) {
@@ -144,7 +160,6 @@ bool App::endRecordResource(void)
     }
     if ((_resource_head_screen_index >= (int)disp->screen_cnt) || (resource_loop_count >= RESOURCE_LOOP_COUNT_MAX)) {
         _resource_screens.clear();
-        _resource_screens_class_parent_map.clear();
         _resource_screen_count = 0;
         ret = false;
         ESP_UTILS_LOGE("record screen fail");
@@ -158,10 +173,10 @@ bool App::endRecordResource(void)
     while ((timer_node != nullptr) && (timer_node != _resource_head_timer) &&
             (resource_loop_count++ < RESOURCE_LOOP_COUNT_MAX)) {
         // Record or update the record information of the timer
-        _resource_timers_cb_usr_map[timer_node] = {(lv_timer_cb_t)timer_node->timer_cb, timer_node->user_data};
-        if (find(_resource_timers.begin(), _resource_timers.end(), timer_node) == _resource_timers.end()) {
-            // Only record the newest timer
-            _resource_timers.push_back(timer_node);
+        auto [timer_it, is_new] = _resource_timers.insert_or_assign(
+                                      timer_node, make_pair((lv_timer_cb_t)timer_node->timer_cb, timer_node->user_data)
+                                  );
+        if (is_new) {
             _resource_timer_count++;
         } else {
             ESP_UTILS_LOGD("Timer(@0x%p) is already recorded", timer_node);
@@ -171,7 +186,6 @@ bool App::endRecordResource(void)
     if (((timer_node == nullptr) && (_resource_head_timer != nullptr)) ||
             (resource_loop_count >= RESOURCE_LOOP_COUNT_MAX)) {
         _resource_timers.clear();
-        _resource_timers_cb_usr_map.clear();
         _resource_timer_count = 0;
         ret = false;
         ESP_UTILS_LOGE("record timer fail");
@@ -183,10 +197,8 @@ bool App::endRecordResource(void)
     anim_node = (lv_anim_t *)_lv_ll_get_head(&LV_ANIM_LL_DEFAULT());
     while ((anim_node != nullptr) && (anim_node != _resource_head_anim)) {
         // Record or update the record information of the animation
-        _resource_anims_var_exec_map[anim_node] = {anim_node->var, anim_node->exec_cb};
-        if (find(_resource_anims.begin(), _resource_anims.end(), anim_node) == _resource_anims.end()) {
-            // Only record the newest timer
-            _resource_anims.push_back(anim_node);
+        auto [anim_it, is_new] = _resource_anims.insert_or_assign(anim_node, make_pair(anim_node->var, anim_node->exec_cb));
+        if (is_new) {
             _resource_anim_count++;
         } else {
             ESP_UTILS_LOGD("Animation(@0x%p) is already recorded", anim_node);
@@ -195,7 +207,6 @@ bool App::endRecordResource(void)
     }
     if ((anim_node == nullptr) && (_resource_head_anim != nullptr)) {
         _resource_anims.clear();
-        _resource_anims_var_exec_map.clear();
         _resource_anim_count = 0;
         ESP_UTILS_LOGE("record animation fail");
     } else {
@@ -218,42 +229,45 @@ bool App::cleanRecordResource(void)
     ESP_UTILS_LOGD("App(%s: %d) clean resource", getName(), _id);
 
     bool ret = true;
-    bool do_clean = false;
     int resource_loop_count = 0;
     int resource_clean_count = 0;
     lv_display_t *disp = nullptr;
     lv_obj_t *screen_node = nullptr;
     lv_timer_t *timer_node = nullptr;
     lv_anim_t *anim_node = nullptr;
+    vector<lv_obj_t *> clean_screens;
+    vector<lv_timer_t *> clean_timers;
+    vector<pair<void *, lv_anim_exec_xcb_t>> clean_anims;
 
     disp = _system_context->getDisplayDevice();
     ESP_UTILS_CHECK_NULL_RETURN(disp, false, "Invalid display");
 
+    // The existing resources are collected in one pass, then deleted. Only those matching their recorded information
+    // are deleted, the others have been deleted by the app and their memory may be reused
+
     // Screen
     resource_loop_count = 0;
     resource_clean_count = 0;
-    for (int i = 0; (i < (int)disp->screen_cnt) && (resource_loop_count++ <  RESOURCE_LOOP_COUNT_MAX);) {
-        do_clean = false;
+    for (int i = 0; (i < (int)disp->screen_cnt) && (clean_screens.size() < _resource_screens.size()) &&
+            (resource_loop_count++ < RESOURCE_LOOP_COUNT_MAX); i++) {
         screen_node = (lv_obj_t *)disp->screens[i];
-        auto screen_it = find(_resource_screens.begin(), _resource_screens.end(), screen_node);
-        if (screen_it != _resource_screens.end()) {
-            auto screen_map_it = _resource_screens_class_parent_map.find(screen_node);
-            if (screen_map_it == _resource_screens_class_parent_map.end()) {
-                ESP_UTILS_LOGE("Screen class parent map not found");
-            } else {
-                if ((screen_node->class_p == screen_map_it->second.first) &&
-                        (screen_node->parent == screen_map_it->second.second)) {
-                    lv_obj_del(screen_node);
-                    do_clean = true;
-                    resource_clean_count++;
-                } else {
-                    ESP_UTILS_LOGD("Screen(@0x%p) information is not matched, skip", screen_node);
-                }
-                _resource_screens.erase(screen_it);
-                _resource_screens_class_parent_map.erase(screen_map_it);
-            }
+        auto screen_it = _resource_screens.find(screen_node);
+        if (screen_it == _resource_screens.end()) {
+            continue;
+        }
+        if ((screen_node->class_p == screen_it->second.first) && (screen_node->parent == screen_it->second.second)) {
+            clean_screens.push_back(screen_node);
+        } else {
+            ESP_UTILS_LOGD("Screen(@0x%p) information is not matched, skip", screen_node);
+        }
+    }
+    for (auto screen : clean_screens) {
+        // The delete event of a screen may delete another one
+        auto screens_end = disp->screens + disp->screen_cnt;
+        if (find(disp->screens, screens_end, screen) != screens_end) {
+            lv_obj_del(screen);
+            resource_clean_count++;
         }
-        i = do_clean ? 0 : i + 1;
     }
     if (resource_loop_count >= RESOURCE_LOOP_COUNT_MAX) {
         ret = false;
@@ -266,28 +280,21 @@ bool App::cleanRecordResource(void)
     resource_loop_count = 0;
     resource_clean_count = 0;
     timer_node = lv_timer_get_next(nullptr);
-    while ((timer_node != nullptr) && (_resource_timers.size() > 0) &&
+    while ((timer_node != nullptr) && (clean_timers.size() < _resource_timers.size()) &&
             (resource_loop_count++ < RESOURCE_LOOP_COUNT_MAX)) {
-        do_clean = false;
-        auto timer_it = find(_resource_timers.begin(), _resource_timers.end(), timer_node);
+        auto timer_it = _resource_timers.find(timer_node);
         if (timer_it != _resource_timers.end()) {
-            auto timer_map_it = _resource_timers_cb_usr_map.find(timer_node);
-            if (timer_map_it == _resource_timers_cb_usr_map.end()) {
-                ESP_UTILS_LOGE("Timer cb usr map not found");
-            } else  {
-                if ((timer_map_it->second.first == timer_node->timer_cb) &&
-                        (timer_map_it->second.second == timer_node->user_data)) {
-                    lv_timer_del(timer_node);
-                    do_clean = true;
-                    resource_clean_count++;
-                } else {
-                    ESP_UTILS_LOGD("Timer(@0x%p) information is not matched, skip", timer_node);
-                }
-                _resource_timers.erase(timer_it);
-                _resource_timers_cb_usr_map.erase(timer_map_it);
+            if ((timer_it->second.first == timer_node->timer_cb) && (timer_it->second.second == timer_node->user_data)) {
+                clean_timers.push_back(timer_node);
+            } else {
+                ESP_UTILS_LOGD("Timer(@0x%p) information is not matched, skip", timer_node);
             }
         }
-        timer_node = do_clean ? lv_timer_get_next(nullptr) : lv_timer_get_next(timer_node);
+        timer_node = lv_timer_get_next(timer_node);
+    }
+    for (auto timer : clean_timers) {
+        lv_timer_del(timer);
+        resource_clean_count++;
     }
     if (resource_loop_count >= RESOURCE_LOOP_COUNT_MAX) {
         ret = false;
@@ -300,36 +307,27 @@ bool App::cleanRecordResource(void)
     resource_loop_count = 0;
     resource_clean_count = 0;
     anim_node = (lv_anim_t *)_lv_ll_get_head(&LV_ANIM_LL_DEFAULT());
-    while ((anim_node != nullptr) && (_resource_anims.size() > 0) &&
+    while ((anim_node != nullptr) && (clean_anims.size() < _resource_anims.size()) &&
             (resource_loop_count++ < RESOURCE_LOOP_COUNT_MAX)) {
-        do_clean = false;
-        auto anim_it = find(_resource_anims.begin(), _resource_anims.end(), anim_node);
+        auto anim_it = _resource_anims.find(anim_node);
         if (anim_it != _resource_anims.end()) {
-            auto anim_map_it = _resource_anims_var_exec_map.find(anim_node);
-            if (anim_map_it == _resource_anims_var_exec_map.end()) {
-                ESP_UTILS_LOGE("Animation var exec map not found");
-            } else  {
-                if ((anim_map_it->second.first == anim_node->var) &&
-                        (anim_map_it->second.second == anim_node->exec_cb)) {
-                    if (lv_anim_del(anim_node->var, anim_node->exec_cb)) {
-                        do_clean = true;
-                        resource_clean_count++;
-                    } else {
-                        ESP_UTILS_LOGE("Delete animation failed");
-                    }
-                } else {
-                    ESP_UTILS_LOGD("Anim(@0x%p) information is not matched, skip", anim_node);
-                }
-                _resource_anims.erase(anim_it);
-                _resource_anims_var_exec_map.erase(anim_map_it);
+            if ((anim_it->second.first == anim_node->var) && (anim_it->second.second == anim_node->exec_cb)) {
+                clean_anims.push_back(anim_it->second);
+            } else {
+                ESP_UTILS_LOGD("Anim(@0x%p) information is not matched, skip", anim_node);
             }
         }
-        anim_node = do_clean ? (lv_anim_t *)_lv_ll_get_head(&LV_ANIM_LL_DEFAULT()) :
-                    (lv_anim_t *)_lv_ll_get_next(&LV_ANIM_LL_DEFAULT(), anim_node);
+        anim_node = (lv_anim_t *)_lv_ll_get_next(&LV_ANIM_LL_DEFAULT(), anim_node);
+    }
+    for (auto &[var, exec_cb] : clean_anims) {
+        // Animations with the same variable and callback are deleted together
+        if (lv_anim_del(var, exec_cb)) {
+            resource_clean_count++;
+        }
     }
     if (resource_loop_count >= RESOURCE_LOOP_COUNT_MAX) {
         ret = false;
-        ESP_UTILS_LOGE("Clean timer loop count exceed max");
+        ESP_UTILS_LOGE("Clean anim loop count exceed max");
     } else {
         ESP_UTILS_LOGD("Clean anim(%d), miss(%d): ", resource_clean_count, _resource_anim_count - resource_clean_count);
     }
@@ -395,6 +393,7 @@ bool App::processUninstall(void)
     _resource_screens.clear();
     _resource_timers.clear();
     _resource_anims.clear();
+    _resource_memory_size = 0;
 
     ESP_UTILS_CHECK_FALSE_RETURN(delExtra(), false, "Begin extra failed");
     ESP_UTILS_CHECK_FALSE_RETURN(deinit(), false, "Deinit failed");
@@ -405,6 +404,7 @@ bool App::processUninstall(void)
 bool App::processRun()
 {
     bool ret = true;
+    size_t memory_used_size = 0;
 
     ESP_UTILS_CHECK_FALSE_RETURN(checkInitialized(), false, "Not initialized");
     ESP_UTILS_LOGD("App(%s: %d) run", getName(), _id);
@@ -417,6 +417,8 @@ bool App::processRun()
     ESP_UTILS_CHECK_FALSE_RETURN(saveRecentScreen(false), false, "Save recent screen before run failed");
     ESP_UTILS_CHECK_FALSE_RETURN(resetRecordResource(), false, "Reset record resource failed");
     ESP_UTILS_CHECK_FALSE_RETURN(startRecordResource(), false, "Start record resource failed");
+    // The memory of a retained app is limited by the manager
+    memory_used_size = _active_config.flags.enable_retain_screen ? getLvMemoryUsedSize() : 0;
     if (_active_config.flags.enable_default_screen) {
         ESP_UTILS_CHECK_FALSE_RETURN(initDefaultScreen(), false, "Create active screen failed");
     }
@@ -427,6 +429,11 @@ bool App::processRun()
         ret = false;
     }
     ESP_UTILS_CHECK_FALSE_RETURN(endRecordResource(), false, "Start record resource failed");
+    if (_active_config.flags.enable_retain_screen) {
+        size_t used_size = getLvMemoryUsedSize();
+        _resource_memory_size = (used_size > memory_used_size) ? (used_size - memory_used_size) : 0;
+        ESP_UTILS_LOGD("Resource memory size: %d", static_cast<int>(_resource_memory_size));
+    }
     if (!saveRecentScreen(true)) {
         ESP_UTILS_LOGE("Save recent screen after run failed");
         ret = false;
@@ -666,17 +673,14 @@ bool App::resetRecordResource(void)
     // Screen
     _resource_screen_count = 0;
     _resource_screens.clear();
-    _resource_screens_class_parent_map.clear();
 
     // Timer
     _resource_timer_count = 0;
     _resource_timers.clear();
-    _resource_timers_cb_usr_map.clear();
 
     // Animation
     _resource_anim_count = 0;
     _resource_anims.clear();
-    _resource_anims_var_exec_map.clear();
 
     _flags.is_resource_recording = false;
 
@@ -8,6 +8,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include "lvgl.h"
 #include "lvgl/esp_brookesia_lv_helper.hpp"
 #include "more/esp_utils_plugin_registry.hpp"
@@ -72,6 +73,12 @@ public:
                                                         status bar. Otherwise, the app's screens will be displayed in full screen,
                                                         but some areas might be not visible. The app can call the `getVisualArea()`
                                                         function to retrieve the final visual area */
+            uint8_t enable_retain_screen: 1;        /*!< If this flag is enabled, the core can run the app in the
+                                                        background when the UI is idle, and keeps its screens paused
+                                                        when it closes itself (within the retain limits of the manager).
+                                                        Then starting the app only resumes it and loads its screen. The
+                                                        `close()` function is only called when the retained app is
+                                                        evicted, or when it's closed from the recents screen */
         } flags;                                    /*!< Core app config flags */
     };
 
@@ -462,13 +469,13 @@ private:
     // lv_obj_t *_temp_screen;
     lv_timer_t *_resource_head_timer = nullptr;
     lv_anim_t *_resource_head_anim = nullptr;
-    std::list <lv_obj_t *> _resource_screens = {};
-    std::list <lv_timer_t *> _resource_timers = {};
-    std::list <lv_anim_t *> _resource_anims = {};
-    // These maps are meant to store additional information about the recorded resources to prevent accidental cleanup
-    std::map<lv_obj_t *, std::pair<const lv_obj_class_t *, lv_obj_t *>> _resource_screens_class_parent_map;
-    std::map<lv_timer_t *, std::pair<lv_timer_cb_t, void *>> _resource_timers_cb_usr_map;
-    std::map<lv_anim_t *, std::pair<void *, lv_anim_exec_xcb_t>> _resource_anims_var_exec_map;
+    // Only the resources created since the start of the recording are added. The recorded information is checked
+    // before the cleanup to prevent deleting a resource whose memory has been reused
+    std::unordered_map<lv_obj_t *, std::pair<const lv_obj_class_t *, lv_obj_t *>> _resource_screens;
+    std::unordered_map<lv_timer_t *, std::pair<lv_timer_cb_t, void *>> _resource_timers;
+    std::unordered_map<lv_anim_t *, std::pair<void *, lv_anim_exec_xcb_t>> _resource_anims;
+    // LVGL memory used by the resources created in `run()`, `0` if it can't be measured
+    size_t _resource_memory_size = 0;
 };
 
 }
@@ -10,6 +10,7 @@
 #endif
 #include "private/esp_brookesia_base_utils.hpp"
 #include "gui/lvgl/esp_brookesia_lv_lock.hpp"
+#include "gui/lvgl/esp_brookesia_lv_command_queue.hpp"
 #include "squareline/ui_comp/ui_comp.h"
 #include "esp_brookesia_base_context.hpp"
 
@@ -179,6 +180,22 @@ bool Context::unlockLv()
     return true;
 }
 
+bool Context::postLv(std::function<void()> command)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(LvCommandQueue::getInstance().post(std::move(command)), false, "Post failed");
+
+    return true;
+}
+
+bool Context::postLv(const void *target, uint32_t tag, std::function<void()> command)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        LvCommandQueue::getInstance().post(target, tag, std::move(command)), false, "Post failed"
+    );
+
+    return true;
+}
+
 bool Context::begin(void)
 {
     gui::LvObjSharedPtr event_obj = nullptr;
@@ -220,6 +237,9 @@ bool Context::begin(void)
     _navigate_event_code = navigate_event_code;
     _app_event_code = app_event_code;
 
+    // Start draining the UI commands posted by non-GUI tasks
+    ESP_UTILS_CHECK_FALSE_RETURN(LvCommandQueue::getInstance().begin(), false, "Begin LVGL command queue failed");
+
     // Initialize cores
     ESP_UTILS_CHECK_FALSE_GOTO(_display.begin(), err, "Begin core display failed");
     ESP_UTILS_CHECK_FALSE_GOTO(_manager.begin(), err, "Begin core manager failed");
@@ -247,6 +267,11 @@ bool Context::del(void)
         return true;
     }
 
+    // Apply the pending UI commands while their objects still exist, the last context stops the drain timer
+    if (!LvCommandQueue::getInstance().del()) {
+        ESP_UTILS_LOGE("Delete LVGL command queue failed");
+        ret = false;
+    }
     if (!_manager.del()) {
         ESP_UTILS_LOGE("Delete core manager failed");
         ret = false;
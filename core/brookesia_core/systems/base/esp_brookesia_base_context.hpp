@@ -5,6 +5,7 @@
  */
 #pragma once
 
+#include <functional>
 #include <memory>
 #include "style/esp_brookesia_gui_style.hpp"
 #include "esp_brookesia_base_display.hpp"
@@ -118,6 +119,12 @@ public:
     /* LVGL */
     bool lockLv(int timeout = -1);
     bool unlockLv();
+    /**
+     * @brief Post a UI command from any task without locking LVGL, it will be executed in the LVGL task.
+     *        Commands posted with the same (target, tag) are coalesced, only the latest one is executed.
+     */
+    bool postLv(std::function<void()> command);
+    bool postLv(const void *target, uint32_t tag, std::function<void()> command);
 
     /* App */
     bool initAppFromRegistry(std::vector<Manager::RegistryAppInfo> &app_infos)
@@ -6,6 +6,7 @@
 #include "esp_brookesia_systems_internal.h"
 #include "lvgl/esp_brookesia_lv_container.hpp"
 #include "lvgl/esp_brookesia_lv_helper.hpp"
+#include "lvgl/esp_brookesia_lv_scaled_font.hpp"
 #include "lvgl/esp_brookesia_lv_screen.hpp"
 #include <src/core/lv_obj_style_gen.h>
 #include <src/display/lv_display.h>
@@ -16,6 +17,7 @@
 #include "esp_brookesia_base_display.hpp"
 #include "esp_brookesia_base_app.hpp"
 #include "esp_brookesia_base_context.hpp"
+#include "base/assets/esp_brookesia_base_assets.h"
 
 using namespace std;
 using namespace esp_brookesia::gui;
@@ -208,6 +210,7 @@ bool Display::del(void)
     _system_screen_obj = nullptr;
     _main_screen = nullptr;
     _system_screen = nullptr;
+    _icon_cache.clear();
     _container_style_index = 0;
     _default_size_font_map.clear();
     _default_height_font_map.clear();
@@ -251,6 +254,12 @@ bool Display::updateByNewData(void)
     // Text
     _default_size_font_map = _update_size_font_map;
 
+    // Icon cache
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        _icon_cache.setConfig({.memory_budget = _core_data.icon_cache.memory_budget}), false,
+        "Set icon cache config failed"
+    );
+
     // Container styles
     for (size_t i = 0; i < _container_styles.size(); i++) {
         lv_style_set_outline_width(&_container_styles[i], _core_data.container.styles[i].outline_width);
@@ -281,10 +290,18 @@ bool Display::calibrateCoreData(Data &data)
     // Check if all default fonts are set, if not, use internal fonts
     for (int i = StyleFont::FONT_SIZE_MIN; i <= StyleFont::FONT_SIZE_MAX; i += 2) {
         if (_update_size_font_map.find(i) == _update_size_font_map.end()) {
+#if ESP_BROOKESIA_BASE_ENABLE_SCALED_FONTS
+            ESP_UTILS_LOGW("Default font size(%d) is not found, try to use scaled font instead", i);
+            font_resource = getLvScaledFont(&esp_brookesia_font_maison_neue_book_48, 48, i);
+            if (font_resource == nullptr) {
+                continue;
+            }
+#else
             ESP_UTILS_LOGW("Default font size(%d) is not found, try to use internal font instead", i);
             if (!esp_brookesia_core_utils_get_internal_font_by_size(i, &font_resource)) {
                 continue;
             }
+#endif
             _update_size_font_map[i] = font_resource;
             if (_update_height_font_map.find(font_resource->line_height) == _update_height_font_map.end()) {
                 _update_height_font_map[font_resource->line_height] = font_resource;
@@ -331,6 +348,12 @@ const lv_font_t *Display::getFontBySize(int size_px) const
     );
 
     auto it = _update_size_font_map.find(size_px);
+#if ESP_BROOKESIA_BASE_ENABLE_SCALED_FONTS
+    // The sizes without a default font, e.g. the odd ones, are scaled from the largest one
+    if (it == _update_size_font_map.end()) {
+        return getLvScaledFont(&esp_brookesia_font_maison_neue_book_48, 48, size_px);
+    }
+#endif
     ESP_UTILS_CHECK_FALSE_RETURN(it != _update_size_font_map.end(), nullptr, "Font size(%d) is not found", size_px);
 
     return it->second;
@@ -10,6 +10,7 @@
 #include "lvgl.h"
 #include "lvgl/esp_brookesia_lv.hpp"
 #include "esp_brookesia_base_app.hpp"
+#include "esp_brookesia_base_icon_cache.hpp"
 
 namespace esp_brookesia::systems::base {
 
@@ -47,6 +48,9 @@ public:
                 gui::StyleColor outline_color;
             } styles[DEBUG_STYLES_NUM];
         } container;
+        struct {
+            size_t memory_budget;   // Max bytes of the icons rendered at their display size, `0` scales them on draw
+        } icon_cache;
         // std::array<DisplayFonts, gui::STYLE_FONT_TYPE_MAX> fonts{};
         // std::array<DisplayDebugStyles, DEBUG_STYLES_NUM> debug_styles{};
     };
@@ -102,6 +106,10 @@ public:
         return _system_screen_obj.get();
     }
     lv_style_t *getCoreContainerStyle(void);
+    IconCache &getIconCache(void)
+    {
+        return _icon_cache;
+    }
 
     bool calibrateCoreObjectSize(
         const esp_brookesia::gui::StyleSize &parent, esp_brookesia::gui::StyleSize &target
@@ -167,6 +175,7 @@ private:
     std::map<uint8_t, const lv_font_t *> _default_height_font_map;
     std::map<uint8_t, const lv_font_t *> _update_size_font_map;
     std::map<uint8_t, const lv_font_t *> _update_height_font_map;
+    IconCache _icon_cache;
 };
 
 } // namespace esp_brookesia::systems::base
@@ -0,0 +1,243 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <chrono>
+#include "esp_brookesia_systems_internal.h"
+#if !ESP_BROOKESIA_BASE_DISPLAY_ENABLE_DEBUG_LOG
+#   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
+#endif
+#include "private/esp_brookesia_base_utils.hpp"
+#include "esp_brookesia_base_icon_cache.hpp"
+
+#define ICON_COLOR_FORMAT   (LV_COLOR_FORMAT_ARGB8888)
+
+using namespace std;
+
+namespace esp_brookesia::systems::base {
+
+namespace {
+
+inline uint32_t elapsed_us(const chrono::steady_clock::time_point &start)
+{
+    return static_cast<uint32_t>(
+               chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count()
+           );
+}
+
+} // namespace
+
+IconCache::~IconCache()
+{
+    clear();
+}
+
+bool IconCache::setConfig(const Config &config)
+{
+    ESP_UTILS_LOGD("Set config: memory_budget(%d)", static_cast<int>(config.memory_budget));
+
+    _config = config;
+    if (_config.memory_budget == 0) {
+        // Keep the icons being displayed, they are freed by `release()`
+        evictByBudget(SIZE_MAX);
+    } else {
+        evictByBudget(0);
+    }
+
+    return true;
+}
+
+const lv_draw_buf_t *IconCache::acquire(const void *image, const gui::StyleSize &size)
+{
+    ESP_UTILS_CHECK_NULL_RETURN(image, nullptr, "Invalid image");
+    ESP_UTILS_CHECK_FALSE_RETURN((size.width > 0) && (size.height > 0), nullptr, "Invalid size");
+
+    if (_config.memory_budget == 0) {
+        return nullptr;
+    }
+
+    Key key{image, size.width, size.height};
+    auto it = _entries.find(key);
+    if (it != _entries.end()) {
+        auto &entry = it->second;
+        _lru_keys.splice(_lru_keys.begin(), _lru_keys, entry.lru_it);
+        entry.ref_count++;
+        _hit_count++;
+        return entry.buffer;
+    }
+    _miss_count++;
+
+    size_t required_bytes = static_cast<size_t>(lv_draw_buf_width_to_stride(size.width, ICON_COLOR_FORMAT)) *
+                            size.height;
+    if (!evictByBudget(required_bytes)) {
+        ESP_UTILS_LOGD(
+            "No room for icon(@0x%p, %dx%d), %d/%d bytes used", image, size.width, size.height,
+            static_cast<int>(_used_bytes), static_cast<int>(_config.memory_budget)
+        );
+        return nullptr;
+    }
+
+    auto start_time = chrono::steady_clock::now();
+    lv_draw_buf_t *buffer = render(image, size);
+    ESP_UTILS_CHECK_NULL_RETURN(buffer, nullptr, "Render icon(@0x%p, %dx%d) failed", image, size.width, size.height);
+    _last_render_time_us = elapsed_us(start_time);
+    _max_render_time_us = max(_max_render_time_us, _last_render_time_us);
+
+    _lru_keys.push_front(key);
+    auto &entry = _entries[key];
+    entry.buffer = buffer;
+    entry.ref_count = 1;
+    entry.lru_it = _lru_keys.begin();
+    _used_bytes += buffer->data_size;
+
+    ESP_UTILS_LOGD(
+        "Render icon(@0x%p, %dx%d): %d bytes, %d us", image, size.width, size.height,
+        static_cast<int>(buffer->data_size), static_cast<int>(_last_render_time_us)
+    );
+
+    return buffer;
+}
+
+bool IconCache::release(const void *image, const gui::StyleSize &size)
+{
+    auto it = _entries.find(Key{image, size.width, size.height});
+    ESP_UTILS_CHECK_FALSE_RETURN(it != _entries.end(), false, "Icon(@0x%p, %dx%d) not found", image, size.width,
+                                 size.height);
+
+    auto &entry = it->second;
+    ESP_UTILS_CHECK_FALSE_RETURN(entry.ref_count > 0, false, "Icon(@0x%p, %dx%d) not acquired", image, size.width,
+                                 size.height);
+    entry.ref_count--;
+
+    // Unused icons are kept for the next user until they are evicted, unless the cache has been disabled
+    if ((entry.ref_count == 0) && (_config.memory_budget == 0)) {
+        removeEntry(it);
+    }
+
+    return true;
+}
+
+void IconCache::clear(void)
+{
+    while (!_entries.empty()) {
+        removeEntry(_entries.begin());
+    }
+}
+
+IconCache::Stats IconCache::getStats(void) const
+{
+    return Stats{
+        .entry_num = _entries.size(),
+        .used_bytes = _used_bytes,
+        .hit_count = _hit_count,
+        .miss_count = _miss_count,
+        .evicted_count = _evicted_count,
+        .last_render_time_us = _last_render_time_us,
+        .max_render_time_us = _max_render_time_us,
+    };
+}
+
+int IconCache::calculateScale(const void *image, const gui::StyleSize &size)
+{
+    lv_image_header_t header = {};
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (lv_image_decoder_get_info(image, &header) == LV_RESULT_OK) && (header.w > 0) && (header.h > 0),
+        LV_SCALE_NONE, "Get image info failed"
+    );
+
+    float factor = min(static_cast<float>(size.width) / header.w, static_cast<float>(size.height) / header.h);
+
+    return static_cast<int>(factor * LV_SCALE_NONE);
+}
+
+void IconCache::removeEntry(map<Key, Entry>::iterator it)
+{
+    auto &entry = it->second;
+    // The image cache may still hold the source, drop it before the buffer is freed
+    lv_image_cache_drop(entry.buffer);
+    _used_bytes -= entry.buffer->data_size;
+    lv_draw_buf_destroy(entry.buffer);
+    _lru_keys.erase(entry.lru_it);
+    _entries.erase(it);
+}
+
+bool IconCache::evictByBudget(size_t required_bytes)
+{
+    auto fits = [&]() {
+        return (required_bytes <= _config.memory_budget) && (_used_bytes <= _config.memory_budget - required_bytes);
+    };
+
+    // Evict the least recently used icons which are not displayed
+    auto lru_it = _lru_keys.end();
+    while (!fits() && (lru_it != _lru_keys.begin())) {
+        --lru_it;
+        auto it = _entries.find(*lru_it);
+        if (it->second.ref_count > 0) {
+            continue;
+        }
+        ESP_UTILS_LOGD("Evict icon(@0x%p, %dx%d)", get<0>(*lru_it), get<1>(*lru_it), get<2>(*lru_it));
+        // The next one is still valid after the erase
+        lru_it = next(lru_it);
+        removeEntry(it);
+        _evicted_count++;
+    }
+
+    return fits();
+}
+
+lv_draw_buf_t *IconCache::render(const void *image, const gui::StyleSize &size)
+{
+    lv_image_header_t header = {};
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (lv_image_decoder_get_info(image, &header) == LV_RESULT_OK) && (header.w > 0) && (header.h > 0),
+        nullptr, "Get image info failed"
+    );
+
+    lv_draw_buf_t *buffer = lv_draw_buf_create(size.width, size.height, ICON_COLOR_FORMAT, LV_STRIDE_AUTO);
+    ESP_UTILS_CHECK_NULL_RETURN(buffer, nullptr, "Create draw buffer failed");
+    lv_draw_buf_clear(buffer, nullptr);
+
+    // Draw through a layer over the buffer, with the same transform as `lv_image` would apply on every redraw. No
+    // object is created, so the screens are left untouched
+    lv_area_t buffer_area = {};
+    buffer_area.x2 = size.width - 1;
+    buffer_area.y2 = size.height - 1;
+    lv_layer_t layer = {};
+    layer.draw_buf = buffer;
+    layer.color_format = ICON_COLOR_FORMAT;
+    layer.buf_area = buffer_area;
+    layer._clip_area = buffer_area;
+    layer.phy_clip_area = buffer_area;
+
+    int scale = calculateScale(image, size);
+    lv_draw_image_dsc_t draw_dsc;
+    lv_draw_image_dsc_init(&draw_dsc);
+    draw_dsc.src = image;
+    draw_dsc.scale_x = scale;
+    draw_dsc.scale_y = scale;
+    draw_dsc.pivot.x = header.w / 2;
+    draw_dsc.pivot.y = header.h / 2;
+    draw_dsc.antialias = 1;
+    // The area of the image before the transform, centered in the buffer
+    lv_area_t area = {};
+    area.x1 = (size.width - static_cast<int32_t>(header.w)) / 2;
+    area.y1 = (size.height - static_cast<int32_t>(header.h)) / 2;
+    area.x2 = area.x1 + header.w - 1;
+    area.y2 = area.y1 + header.h - 1;
+    lv_draw_image(&layer, &draw_dsc, &area);
+
+    // Wait for the draw units to finish, as `lv_canvas_finish_layer()` does
+    while (layer.draw_task_head != nullptr) {
+        lv_draw_dispatch_wait_for_request();
+        if (!lv_draw_dispatch_layer(lv_display_get_default(), &layer)) {
+            lv_draw_wait_for_finish();
+            lv_draw_dispatch_request();
+        }
+    }
+
+    return buffer;
+}
+
+} // namespace esp_brookesia::systems::base
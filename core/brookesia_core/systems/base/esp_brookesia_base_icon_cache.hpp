@@ -0,0 +1,97 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <tuple>
+#include "lvgl/esp_brookesia_lv_helper.hpp"
+
+namespace esp_brookesia::systems::base {
+
+/**
+ * @brief Cache of icon images rasterized at their display size.
+ *
+ * An image scaled by `lv_image_set_scale()` is transformed by LVGL on every redraw. Instead, each icon is rendered
+ * once per target size (keeping the aspect ratio, centered) into an ARGB8888 draw buffer, which is then drawn
+ * without any transform. Entries are shared by all the users of the same image and size, and reference counted:
+ * only the unused ones are evicted (LRU) to keep the cache under its memory budget.
+ */
+class IconCache {
+public:
+    struct Config {
+        size_t memory_budget;           // Max bytes of all rendered icons, `0` disables the cache
+    };
+
+    struct Stats {
+        size_t entry_num;
+        size_t used_bytes;              // Memory used by all rendered icons
+        uint32_t hit_count;
+        uint32_t miss_count;
+        uint32_t evicted_count;
+        uint32_t last_render_time_us;
+        uint32_t max_render_time_us;
+    };
+
+    IconCache() = default;
+    ~IconCache();
+
+    IconCache(const IconCache &) = delete;
+    IconCache &operator=(const IconCache &) = delete;
+
+    bool setConfig(const Config &config);
+    const Config &getConfig(void) const
+    {
+        return _config;
+    }
+
+    /**
+     * @brief Get the image rendered at the size, render it if needed. Each successful call must be paired with a
+     *        `release()` of the same image and size once the buffer is not displayed anymore.
+     *
+     * @return Draw buffer usable as image source, `nullptr` if the cache is disabled, the budget is used by the
+     *         icons being displayed or the rendering failed. The caller should scale the original image instead.
+     */
+    const lv_draw_buf_t *acquire(const void *image, const gui::StyleSize &size);
+    bool release(const void *image, const gui::StyleSize &size);
+    /**
+     * @brief Free all the rendered icons, including the acquired ones. Only call it when no icon is displayed.
+     */
+    void clear(void);
+
+    Stats getStats(void) const;
+
+    /**
+     * @brief Calculate the scale to fit an image into a size, keeping the aspect ratio.
+     */
+    static int calculateScale(const void *image, const gui::StyleSize &size);
+
+private:
+    using Key = std::tuple<const void *, int, int>;
+
+    struct Entry {
+        lv_draw_buf_t *buffer = nullptr;
+        uint32_t ref_count = 0;
+        std::list<Key>::iterator lru_it;
+    };
+
+    void removeEntry(std::map<Key, Entry>::iterator it);
+    bool evictByBudget(size_t required_bytes);
+    static lv_draw_buf_t *render(const void *image, const gui::StyleSize &size);
+
+    Config _config = {};
+    std::list<Key> _lru_keys;   // Front is the most recently used
+    std::map<Key, Entry> _entries;
+    size_t _used_bytes = 0;
+    uint32_t _hit_count = 0;
+    uint32_t _miss_count = 0;
+    uint32_t _evicted_count = 0;
+    uint32_t _last_render_time_us = 0;
+    uint32_t _max_render_time_us = 0;
+};
+
+} // namespace esp_brookesia::systems::base
@@ -3,6 +3,7 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <chrono>
 #include <cstring>
 #include <cmath>
 #include "esp_brookesia_systems_internal.h"
@@ -14,11 +15,27 @@
 #include "esp_brookesia_base_manager.hpp"
 #include "esp_brookesia_base_context.hpp"
 
+#define APP_PREWARM_TIMER_PERIOD_MS     (200)
+#define APP_PREWARM_IDLE_TIME_MS        (1000)
+// The prewarm runs the app in a timer callback, only the apps whose measured cold launch fits are prewarmed
+#define APP_PREWARM_RUN_TIME_MAX_MS     (50)
+
 using namespace std;
 using namespace esp_brookesia::gui;
 
 namespace esp_brookesia::systems::base {
 
+namespace {
+
+inline uint32_t elapsed_us(const chrono::steady_clock::time_point &start)
+{
+    return static_cast<uint32_t>(
+               chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count()
+           );
+}
+
+} // namespace
+
 Manager::Manager(Context &core, const Data &data):
     _system_context(core),
     _core_data(data)
@@ -105,6 +122,13 @@ int Manager::uninstallApp(App *app)
     }
     ESP_UTILS_CHECK_FALSE_RETURN(it->second == app, false, "App(%d) is not installed", app_id);
 
+    // Close the app if it's retained in the background
+    _prewarm_app_ids.remove(app_id);
+    _id_app_launch_stats_map.erase(app_id);
+    if (checkAppRetained(app_id) && !closeRetainedApp(app)) {
+        ESP_UTILS_LOGE("Close retained app failed");
+    }
+
     // Process display
     ESP_UTILS_CHECK_FALSE_RETURN(display.processAppUninstall(app), false, "Display process app uninstall failed");
 
@@ -212,6 +236,8 @@ bool Manager::startApp(int id)
 {
     App *app = NULL;
     App *app_old = NULL;
+    bool is_retained = checkAppRetained(id);
+    auto start_time = chrono::steady_clock::now();
 
     // Check if the app is already running
     auto find_ret = _id_running_app_map.find(id);
@@ -220,6 +246,7 @@ bool Manager::startApp(int id)
         ESP_UTILS_LOGD("App(%d) is already running, just resume it", app->_id);
         // If so, resume app
         ESP_UTILS_CHECK_FALSE_RETURN(processAppResume(app), false, "Resume app failed");
+        updateAppLaunchStats(app, true, elapsed_us(start_time));
 
         return true;
     }
@@ -248,6 +275,7 @@ bool Manager::startApp(int id)
     // Add app to running_app_map
     ESP_UTILS_CHECK_FALSE_GOTO(_id_running_app_map.insert(pair <int, App *>(id, app)).second, err,
                                "Insert app to running map failed");
+    updateAppLaunchStats(app, is_retained, elapsed_us(start_time));
 
     return true;
 
@@ -261,6 +289,7 @@ bool Manager::processAppRun(App *app)
 {
     bool is_display_run = false;
     bool is_app_run = false;
+    bool is_app_retained = false;
     Display &display = _system_context.getDisplay();
 
     ESP_UTILS_CHECK_NULL_RETURN(app, false, "Invalid app");
@@ -269,8 +298,14 @@ bool Manager::processAppRun(App *app)
     // Process display, and get the visual area of the app
     ESP_UTILS_CHECK_FALSE_RETURN(is_display_run = display.processAppRun(app), false, "Process display before app run failed");
 
-    // Process app
-    ESP_UTILS_CHECK_FALSE_GOTO(is_app_run = app->processRun(), err, "Process app run failed");
+    // Process app, a retained app has already run and only loads its screen
+    is_app_retained = checkAppRetained(app->_id);
+    if (is_app_retained) {
+        ESP_UTILS_CHECK_FALSE_GOTO(takeRetainedApp(app), err, "Take retained app failed");
+        ESP_UTILS_CHECK_FALSE_GOTO(is_app_run = app->processResume(), err, "Process app resume failed");
+    } else {
+        ESP_UTILS_CHECK_FALSE_GOTO(is_app_run = app->processRun(), err, "Process app run failed");
+    }
 
     // Process extra
     ESP_UTILS_CHECK_FALSE_GOTO(processAppRunExtra(app), err, "Process app run extra failed");
@@ -287,6 +322,9 @@ err:
     if (is_app_run && !app->processClose(true)) {
         ESP_UTILS_LOGE("App process close failed");
     }
+    if (is_app_retained && !is_app_run && (app->_status != App::Status::CLOSED) && !app->processClose(false)) {
+        ESP_UTILS_LOGE("Retained app process close failed");
+    }
     ESP_UTILS_CHECK_FALSE_RETURN(display.processMainScreenLoad(), false, "Display load main screen failed");
 
     return false;
@@ -376,16 +414,182 @@ bool Manager::processAppClose(App *app)
         _active_app = nullptr;
     }
 
+    // Prewarm the closed app again when the UI is idle, then the next start is a fresh screen swap
+    if (checkAppPrewarmable(app)) {
+        _prewarm_app_ids.remove(app->_id);
+        _prewarm_app_ids.push_back(app->_id);
+        if (_app_prewarm_timer != nullptr) {
+            lv_timer_resume(_app_prewarm_timer.get());
+        }
+    }
+
+    return true;
+}
+
+bool Manager::processAppRetain(App *app)
+{
+    Display &display = _system_context.getDisplay();
+
+    ESP_UTILS_CHECK_NULL_RETURN(app, false, "Invalid app");
+    ESP_UTILS_LOGD("Process app(%d) retain", app->_id);
+
+    // Process app, pause it instead of closing it, its screens are kept
+    ESP_UTILS_CHECK_FALSE_RETURN(app->processPause(), false, "App process pause failed");
+    if (_core_data.flags.enable_app_save_snapshot) {
+        if (!releaseAppSnapshot(app)) {
+            ESP_UTILS_LOGE("Release app snapshot failed");
+        }
+    }
+
+    // Process display and extra like closing it, load main screen if the app is showing
+    ESP_UTILS_CHECK_FALSE_RETURN(display.processAppClose(app), false, "Display process close failed");
+    ESP_UTILS_CHECK_FALSE_RETURN(processAppCloseExtra(app), false, "Process app close extra failed");
+
+    // Move app from running map to retained map and update active app
+    ESP_UTILS_CHECK_FALSE_RETURN(_id_running_app_map.erase(app->_id) > 0, false, "Remove app from running map failed");
+    if (_active_app == app) {
+        _active_app = nullptr;
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(retainApp(app), false, "Retain app failed");
+
+    return true;
+}
+
+bool Manager::prewarmApp(int id)
+{
+    ESP_UTILS_LOGD("Prewarm app(%d)", id);
+
+    App *app = getInstalledApp(id);
+    ESP_UTILS_CHECK_NULL_RETURN(app, false, "Invalid app");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (_core_data.retain.max_app_num > 0) && app->getCoreActiveData().flags.enable_retain_screen, false,
+        "App(%d) can't be retained", id
+    );
+
+    if (checkAppRetained(id) || (getRunningAppById(id) != nullptr)) {
+        ESP_UTILS_LOGD("App(%d) is already retained or running", id);
+        return true;
+    }
+
+    lv_obj_t *last_screen = lv_disp_get_scr_act(_system_context.getDisplayDevice());
+    ESP_UTILS_CHECK_NULL_RETURN(last_screen, false, "Invalid active screen");
+
+    // Run and pause the app in the background, the last screen is loaded back before any refresh
+    bool ret = app->processRun() && app->processPause();
+    lv_scr_load(last_screen);
+    ESP_UTILS_CHECK_FALSE_RETURN(ret, false, "Run app in background failed");
+
+    if (!checkAppRetainable(app)) {
+        ESP_UTILS_LOGW(
+            "App(%d) memory(%d) exceeds the retain budget, close it", id, static_cast<int>(app->_resource_memory_size)
+        );
+        ESP_UTILS_CHECK_FALSE_RETURN(app->processClose(false), false, "App process close failed");
+        return true;
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(retainApp(app), false, "Retain app failed");
+
+    return true;
+}
+
+Manager::AppLaunchStats Manager::getAppLaunchStats(int id) const
+{
+    auto it = _id_app_launch_stats_map.find(id);
+    if (it == _id_app_launch_stats_map.end()) {
+        return {};
+    }
+
+    return it->second;
+}
+
+bool Manager::checkAppRetainable(App *app) const
+{
+    ESP_UTILS_CHECK_NULL_RETURN(app, false, "Invalid app");
+
+    return (_core_data.retain.max_app_num > 0) && app->getCoreActiveData().flags.enable_retain_screen &&
+           ((_core_data.retain.memory_budget == 0) || (app->_resource_memory_size <= _core_data.retain.memory_budget));
+}
+
+bool Manager::checkAppPrewarmable(App *app) const
+{
+    ESP_UTILS_CHECK_NULL_RETURN(app, false, "Invalid app");
+
+    // The cost of `run()` is only known after a cold launch, which also measures the memory for the retain budget
+    auto it = _id_app_launch_stats_map.find(app->_id);
+    return checkAppRetainable(app) && (it != _id_app_launch_stats_map.end()) && (it->second.cold_num > 0) &&
+           (it->second.max_cold_time_us <= APP_PREWARM_RUN_TIME_MAX_MS * 1000);
+}
+
+bool Manager::retainApp(App *app)
+{
+    ESP_UTILS_CHECK_NULL_RETURN(app, false, "Invalid app");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        _id_retained_app_map.insert(pair <int, App *>(app->_id, app)).second, false, "Insert app to retained map failed"
+    );
+
+    _retained_app_ids.push_front(app->_id);
+    _retained_memory_size += app->_resource_memory_size;
+
+    // Evict the least recently retained apps
+    const size_t memory_budget = _core_data.retain.memory_budget;
+    while (((int)_retained_app_ids.size() > _core_data.retain.max_app_num) ||
+            ((memory_budget != 0) && (_retained_memory_size > memory_budget))) {
+        App *app_old = _id_retained_app_map[_retained_app_ids.back()];
+        ESP_UTILS_LOGD("Evict retained app(%d)", app_old->_id);
+        ESP_UTILS_CHECK_FALSE_RETURN(closeRetainedApp(app_old), false, "Close retained app failed");
+    }
+    ESP_UTILS_LOGD(
+        "Retained apps: num(%d), memory(%d)", static_cast<int>(_retained_app_ids.size()),
+        static_cast<int>(_retained_memory_size)
+    );
+
+    return true;
+}
+
+bool Manager::takeRetainedApp(App *app)
+{
+    ESP_UTILS_CHECK_NULL_RETURN(app, false, "Invalid app");
+    ESP_UTILS_CHECK_FALSE_RETURN(_id_retained_app_map.erase(app->_id) > 0, false, "App is not retained");
+
+    _retained_app_ids.remove(app->_id);
+    _retained_memory_size -= min(_retained_memory_size, app->_resource_memory_size);
+
+    return true;
+}
+
+bool Manager::closeRetainedApp(App *app)
+{
+    ESP_UTILS_CHECK_NULL_RETURN(app, false, "Invalid app");
+    ESP_UTILS_LOGD("Close retained app(%d)", app->_id);
+
+    ESP_UTILS_CHECK_FALSE_RETURN(takeRetainedApp(app), false, "Take retained app failed");
+    // The app isn't shown, its resources are cleaned immediately
+    ESP_UTILS_CHECK_FALSE_RETURN(app->processClose(false), false, "App process close failed");
+
     return true;
 }
 
+void Manager::updateAppLaunchStats(App *app, bool is_hot, uint32_t time_us)
+{
+    auto &stats = _id_app_launch_stats_map[app->_id];
+    if (is_hot) {
+        stats.hot_num++;
+        stats.last_hot_time_us = time_us;
+        stats.max_hot_time_us = max(stats.max_hot_time_us, time_us);
+    } else {
+        stats.cold_num++;
+        stats.last_cold_time_us = time_us;
+        stats.max_cold_time_us = max(stats.max_cold_time_us, time_us);
+    }
+    ESP_UTILS_LOGI("App(%s: %d) %s launch: %d us", app->getName(), app->_id, is_hot ? "hot" : "cold", (int)time_us);
+}
+
 bool Manager::saveAppSnapshot(App *app)
 {
 #if !LV_USE_SNAPSHOT
     ESP_UTILS_CHECK_FALSE_RETURN(false, false, "`LV_USE_SNAPSHOT` is not enabled");
 #else
+    bool ret = false;
     bool resize_app_screen = false;
-    lv_res_t ret = LV_RES_INV;
     lv_area_t app_screen_area = {};
     lv_draw_buf_t *snapshot_buffer = nullptr;
 
@@ -406,31 +610,26 @@ bool Manager::saveAppSnapshot(App *app)
         resize_app_screen = true;
     }
 
-    auto it = _id_app_snapshot_map.find(app->_id);
+    // Take the full-resolution snapshot into a temporary buffer, only the encoded one is kept
     auto color_format = _system_context.getDisplayDevice()->color_format;
-    snapshot_buffer = (it != _id_app_snapshot_map.end()) ? it->second : nullptr;
-
-    if ((snapshot_buffer == nullptr) || (snapshot_buffer->header.w != lv_area_get_width(&app_screen_area)) ||
-            (snapshot_buffer->header.h != lv_area_get_height(&app_screen_area))) {
-        if (snapshot_buffer != nullptr) {
-            lv_draw_buf_destroy(snapshot_buffer);
-        }
-        snapshot_buffer = lv_snapshot_create_draw_buf(app->_active_screen, color_format);
-        ESP_UTILS_CHECK_NULL_GOTO(snapshot_buffer, err, "Create snapshot buffer failed");
-    }
-
-    // And take snapshot for recent screen
-    ret = lv_snapshot_take_to_draw_buf(app->_active_screen, color_format, snapshot_buffer);
-    ESP_UTILS_CHECK_FALSE_GOTO(ret == LV_RESULT_OK, err, "Take snapshot fail");
-
-    _id_app_snapshot_map[app->_id] = snapshot_buffer;
-    if (resize_app_screen) {
-        app->_active_screen->coords = app_screen_area;
+    snapshot_buffer = lv_snapshot_take(app->_active_screen, color_format);
+    ESP_UTILS_CHECK_NULL_GOTO(snapshot_buffer, end, "Take snapshot fail");
+    ESP_UTILS_CHECK_FALSE_GOTO(
+        _app_snapshot_cache.save(app->_id, snapshot_buffer), end, "Save snapshot to cache failed"
+    );
+    ret = true;
+
+    {
+        auto stats = _app_snapshot_cache.getStats();
+        ESP_UTILS_LOGD(
+            "App snapshots: num(%d), encoded(%d), raw(%d), evicted(%d), encode time(%d us)",
+            static_cast<int>(stats.entry_num), static_cast<int>(stats.encoded_bytes),
+            static_cast<int>(stats.raw_bytes), static_cast<int>(stats.evicted_count),
+            static_cast<int>(stats.last_encode_time_us)
+        );
     }
 
-    return true;
-
-err:
+end:
     if (snapshot_buffer != nullptr) {
         lv_draw_buf_destroy(snapshot_buffer);
     }
@@ -438,7 +637,7 @@ err:
         app->_active_screen->coords = app_screen_area;
     }
 
-    return false;
+    return ret;
 #endif
 }
 
@@ -447,16 +646,18 @@ bool Manager::releaseAppSnapshot(App *app)
     ESP_UTILS_CHECK_NULL_RETURN(app, false, "Invalid app");
     ESP_UTILS_LOGD("Release app(%d) snapshot", app->_id);
 
-    auto it = _id_app_snapshot_map.find(app->_id);
-    if (it == _id_app_snapshot_map.end()) {
-        return true;
-    }
+    _app_snapshot_cache.remove(app->_id);
 
-    auto snapshot_buffer = it->second;
-    if (snapshot_buffer != nullptr) {
-        lv_draw_buf_destroy(snapshot_buffer);
-    }
-    ESP_UTILS_CHECK_FALSE_RETURN(_id_app_snapshot_map.erase(app->_id) > 0, false, "Free snapshot failed");
+    return true;
+}
+
+bool Manager::setAppSnapshotTargetSize(const gui::StyleSize &size)
+{
+    ESP_UTILS_LOGD("Set app snapshot target size(%dx%d)", size.width, size.height);
+
+    auto config = _app_snapshot_cache.getConfig();
+    config.target_size = size;
+    ESP_UTILS_CHECK_FALSE_RETURN(_app_snapshot_cache.setConfig(config), false, "Set snapshot cache config failed");
 
     return true;
 }
@@ -524,16 +725,27 @@ App *Manager::getRunningAppById(int id)
 
 const lv_draw_buf_t *Manager::getAppSnapshot(int id)
 {
-    auto it = _id_app_snapshot_map.find(id);
-    ESP_UTILS_CHECK_FALSE_RETURN(it != _id_app_snapshot_map.end(), nullptr, "App snapshot not found");
-
-    return it->second;
+    // The snapshot may be evicted by the memory budget, the caller should fall back to the app icon
+    return _app_snapshot_cache.get(id);
 }
 
 bool Manager::begin(void)
 {
     ESP_UTILS_LOGD("Begin(@0x%p)", this);
 
+    ESP_UTILS_CHECK_FALSE_RETURN(_app_snapshot_cache.setConfig({
+        .target_size = _system_context.getData().screen_size,
+        .memory_budget = _core_data.snapshot.memory_budget,
+    }), false, "Set snapshot cache config failed");
+
+    if (_core_data.retain.max_app_num > 0) {
+        _app_prewarm_timer = ESP_BROOKESIA_MAKE_LV_TIMER_PTR(onAppPrewarmTimerCallback, APP_PREWARM_TIMER_PERIOD_MS, this);
+        ESP_UTILS_CHECK_NULL_RETURN(_app_prewarm_timer, false, "Create app prewarm timer failed");
+        if (_prewarm_app_ids.empty()) {
+            lv_timer_pause(_app_prewarm_timer.get());
+        }
+    }
+
     ESP_UTILS_CHECK_FALSE_RETURN(_system_context.registerAppEventCallback(onAppEventCallback, this), false,
                                  "Register app event failed");
     ESP_UTILS_CHECK_FALSE_GOTO(_system_context.registerNavigateEventCallback(onNavigationEventCallback, this), err,
@@ -561,6 +773,8 @@ bool Manager::del(void)
         }
     }
 
+    _app_prewarm_timer.reset();
+    _prewarm_app_ids.clear();
     _app_free_id = 0;
     _active_app = nullptr;
     for (auto app : id_installed_app_map) {
@@ -571,7 +785,11 @@ bool Manager::del(void)
     }
     _id_installed_app_map.clear();
     _id_running_app_map.clear();
-    _id_app_snapshot_map.clear();
+    _id_retained_app_map.clear();
+    _retained_app_ids.clear();
+    _retained_memory_size = 0;
+    _id_app_launch_stats_map.clear();
+    _app_snapshot_cache.clear();
 
     return ret;
 }
@@ -602,7 +820,13 @@ void Manager::onAppEventCallback(lv_event_t *event)
         ESP_UTILS_LOGD("Stop app(%d)", id);
         app = manager->getRunningAppById(id);
         ESP_UTILS_CHECK_NULL_EXIT(app, "Invalid app");
-        ESP_UTILS_CHECK_FALSE_EXIT(manager->processAppClose(app), "Close app failed");
+        // Keep the app paused in the background if it closes itself while shown (e.g. in its `back()`), then starting
+        // it again only loads its screen. The paused apps closed from the recents screen are closed
+        if ((app->_status == App::Status::RUNNING) && manager->checkAppRetainable(app)) {
+            ESP_UTILS_CHECK_FALSE_EXIT(manager->processAppRetain(app), "Retain app failed");
+        } else {
+            ESP_UTILS_CHECK_FALSE_EXIT(manager->processAppClose(app), "Close app failed");
+        }
         break;
     default:
         break;
@@ -627,4 +851,35 @@ void Manager::onNavigationEventCallback(lv_event_t *event)
     ESP_UTILS_CHECK_FALSE_EXIT(manager->processNavigationEvent(navigation_type), "Process navigation bar event failed");
 }
 
+void Manager::onAppPrewarmTimerCallback(lv_timer_t *timer)
+{
+    Manager *manager = nullptr;
+
+    ESP_UTILS_CHECK_NULL_EXIT(timer, "Invalid timer");
+
+    manager = (Manager *)lv_timer_get_user_data(timer);
+    ESP_UTILS_CHECK_NULL_EXIT(manager, "Invalid manager");
+
+    if (manager->_prewarm_app_ids.empty()) {
+        lv_timer_pause(timer);
+        return;
+    }
+    // Only prewarm when no app is shown and the UI is idle, one app per period
+    if ((manager->_active_app != nullptr) ||
+            (lv_display_get_inactive_time(manager->_system_context.getDisplayDevice()) < APP_PREWARM_IDLE_TIME_MS)) {
+        return;
+    }
+
+    int id = manager->_prewarm_app_ids.front();
+    manager->_prewarm_app_ids.pop_front();
+    App *app = manager->getInstalledApp(id);
+    if ((app == nullptr) || !manager->checkAppPrewarmable(app)) {
+        ESP_UTILS_LOGD("App(%d) can't be prewarmed, skip it", id);
+        return;
+    }
+    if (!manager->prewarmApp(id)) {
+        ESP_UTILS_LOGE("Prewarm app(%d) failed", id);
+    }
+}
+
 } // namespace esp_brookesia::systems::base
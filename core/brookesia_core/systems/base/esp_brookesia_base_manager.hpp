@@ -6,11 +6,13 @@
 #pragma once
 
 #include <tuple>
+#include <list>
 #include <map>
 #include <unordered_map>
 #include "lvgl/esp_brookesia_lv_helper.hpp"
 #include "esp_brookesia_base_app.hpp"
 #include "esp_brookesia_base_display.hpp"
+#include "esp_brookesia_base_snapshot_cache.hpp"
 
 namespace esp_brookesia::systems::base {
 
@@ -34,6 +36,22 @@ public:
         struct {
             uint8_t enable_app_save_snapshot: 1;
         } flags;
+        struct {
+            size_t memory_budget;   // Max bytes of all saved app snapshots, `0` means unlimited
+        } snapshot;
+        struct {
+            int max_app_num;        // Max number of retained apps (with `enable_retain_screen`), `0` disables it
+            size_t memory_budget;   // Max memory taken by the `run()` of all retained apps, `0` means unlimited
+        } retain;
+    };
+
+    struct AppLaunchStats {
+        uint32_t cold_num;              // Launches which ran the app
+        uint32_t hot_num;               // Launches which resumed the retained or paused app
+        uint32_t last_cold_time_us;
+        uint32_t max_cold_time_us;
+        uint32_t last_hot_time_us;
+        uint32_t max_hot_time_us;
     };
 
     using RegistryAppInfo = std::tuple<std::string, std::shared_ptr<App>>;
@@ -72,6 +90,37 @@ public:
         return _active_app;
     }
     const lv_draw_buf_t *getAppSnapshot(int id);
+    bool setAppSnapshotTargetSize(const gui::StyleSize &size);
+    void releaseAppSnapshotDecoded(void)
+    {
+        _app_snapshot_cache.releaseDecoded();
+    }
+    SnapshotCache::Stats getAppSnapshotStats(void) const
+    {
+        return _app_snapshot_cache.getStats();
+    }
+
+    /**
+     * @brief Run the app in the background and retain its paused screens, then starting it is only a screen swap.
+     *        Apps with `enable_retain_screen` are also prewarmed automatically when the UI is idle after they are
+     *        closed, if their measured cold launch is short enough to run in a timer callback.
+     *
+     * @note  This runs the whole `run()` of the app in the calling context, call it where blocking LVGL is fine
+     */
+    bool prewarmApp(int id);
+    bool checkAppRetained(int id) const
+    {
+        return (_id_retained_app_map.find(id) != _id_retained_app_map.end());
+    }
+    uint8_t getRetainedAppCount(void) const
+    {
+        return _id_retained_app_map.size();
+    }
+    size_t getRetainedMemorySize(void) const
+    {
+        return _retained_memory_size;
+    }
+    AppLaunchStats getAppLaunchStats(int id) const;
 
 protected:
     virtual bool processAppRunExtra(App *app)
@@ -99,6 +148,7 @@ protected:
     bool processAppResume(App *app);
     bool processAppPause(App *app);
     bool processAppClose(App *app);
+    bool processAppRetain(App *app);
     bool saveAppSnapshot(App *app);
     bool releaseAppSnapshot(App *app);
     void resetActiveApp(void);
@@ -110,15 +160,29 @@ private:
     bool begin(void);
     bool del(void);
     bool startApp(int id);
+    bool checkAppRetainable(App *app) const;
+    bool checkAppPrewarmable(App *app) const;
+    bool retainApp(App *app);
+    bool takeRetainedApp(App *app);
+    bool closeRetainedApp(App *app);
+    void updateAppLaunchStats(App *app, bool is_hot, uint32_t time_us);
 
     static void onAppEventCallback(lv_event_t *event);
     static void onNavigationEventCallback(lv_event_t *event);
+    static void onAppPrewarmTimerCallback(lv_timer_t *timer);
 
     uint32_t _app_free_id{App::APP_ID_MIN};
     App *_active_app{nullptr};
     std::unordered_map <int, App *> _id_installed_app_map;
     std::unordered_map <int, App *> _id_running_app_map;
-    std::unordered_map <int, lv_draw_buf_t *> _id_app_snapshot_map;
+    SnapshotCache _app_snapshot_cache;
+    // Retained apps, paused in the background and not shown in the recents screen
+    std::list<int> _retained_app_ids;     // Front is the most recently retained
+    std::unordered_map <int, App *> _id_retained_app_map;
+    size_t _retained_memory_size = 0;
+    std::list<int> _prewarm_app_ids;
+    gui::LvTimerSharedPtr _app_prewarm_timer;
+    std::unordered_map <int, AppLaunchStats> _id_app_launch_stats_map;
     // Navigation
     NavigateType _navigate_type{NavigateType::MAX};
 };
@@ -0,0 +1,327 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include "esp_brookesia_systems_internal.h"
+#if !ESP_BROOKESIA_BASE_MANAGER_ENABLE_DEBUG_LOG
+#   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
+#endif
+#include "private/esp_brookesia_base_utils.hpp"
+#include "esp_brookesia_base_snapshot_cache.hpp"
+
+/**
+ * The snapshot is encoded with a pixel based PackBits scheme:
+ *  - control byte `c < 128`: `c + 1` literal pixels follow
+ *  - control byte `c >= 128`: the next pixel is repeated `c - 126` times
+ */
+#define ENCODE_LITERAL_MAX      (128)
+#define ENCODE_REPEAT_MIN       (2)
+#define ENCODE_REPEAT_MAX       (129)
+#define ENCODE_REPEAT_FLAG      (0x80)
+
+using namespace std;
+
+namespace esp_brookesia::systems::base {
+
+namespace {
+
+inline uint32_t elapsed_us(const chrono::steady_clock::time_point &start)
+{
+    return static_cast<uint32_t>(
+               chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count()
+           );
+}
+
+} // namespace
+
+SnapshotCache::~SnapshotCache()
+{
+    clear();
+}
+
+bool SnapshotCache::setConfig(const Config &config)
+{
+    ESP_UTILS_LOGD(
+        "Set config: target_size(%dx%d), memory_budget(%d)", config.target_size.width, config.target_size.height,
+        static_cast<int>(config.memory_budget)
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (config.target_size.width >= 0) && (config.target_size.height >= 0), false, "Invalid target size"
+    );
+
+    _config = config;
+    evictByBudget(-1);
+
+    return true;
+}
+
+bool SnapshotCache::save(int id, const lv_draw_buf_t *snapshot)
+{
+    ESP_UTILS_CHECK_NULL_RETURN(snapshot, false, "Invalid snapshot");
+    ESP_UTILS_CHECK_NULL_RETURN(snapshot->data, false, "Invalid snapshot data");
+
+    uint32_t src_w = snapshot->header.w;
+    uint32_t src_h = snapshot->header.h;
+    auto color_format = static_cast<lv_color_format_t>(snapshot->header.cf);
+    ESP_UTILS_CHECK_FALSE_RETURN((src_w > 0) && (src_h > 0), false, "Invalid snapshot size");
+    ESP_UTILS_CHECK_FALSE_RETURN(lv_color_format_get_size(color_format) > 0, false, "Unsupported color format");
+
+    // Downscale to fit in the target size and keep the aspect ratio
+    uint32_t dst_w = src_w;
+    uint32_t dst_h = src_h;
+    if ((_config.target_size.width > 0) && (_config.target_size.height > 0)) {
+        float factor = min(static_cast<float>(_config.target_size.width) / src_w,
+                           static_cast<float>(_config.target_size.height) / src_h);
+        if (factor < 1.0f) {
+            dst_w = max<uint32_t>(static_cast<uint32_t>(src_w * factor), 1);
+            dst_h = max<uint32_t>(static_cast<uint32_t>(src_h * factor), 1);
+        }
+    }
+
+    auto start_time = chrono::steady_clock::now();
+    vector<uint8_t> encoded;
+    ESP_UTILS_CHECK_FALSE_RETURN(encode(snapshot, dst_w, dst_h, encoded), false, "Encode snapshot failed");
+    _last_encode_time_us = elapsed_us(start_time);
+    _max_encode_time_us = max(_max_encode_time_us, _last_encode_time_us);
+
+    // Replace the old one if exists
+    remove(id);
+
+    _lru_ids.push_front(id);
+    auto &entry = _entries[id];
+    entry.width = dst_w;
+    entry.height = dst_h;
+    entry.color_format = color_format;
+    entry.raw_size = snapshot->data_size;
+    entry.encoded = std::move(encoded);
+    entry.encoded.shrink_to_fit();
+    entry.lru_it = _lru_ids.begin();
+    _encoded_bytes += entry.encoded.size();
+    _raw_bytes += entry.raw_size;
+
+    ESP_UTILS_LOGD(
+        "Save snapshot(%d): %dx%d -> %dx%d, %d -> %d bytes, %d us", id, static_cast<int>(src_w),
+        static_cast<int>(src_h), static_cast<int>(dst_w), static_cast<int>(dst_h),
+        static_cast<int>(entry.raw_size), static_cast<int>(entry.encoded.size()),
+        static_cast<int>(_last_encode_time_us)
+    );
+
+    evictByBudget(id);
+
+    return true;
+}
+
+const lv_draw_buf_t *SnapshotCache::get(int id)
+{
+    auto it = _entries.find(id);
+    if (it == _entries.end()) {
+        ESP_UTILS_LOGD("Snapshot(%d) not found", id);
+        return nullptr;
+    }
+
+    auto &entry = it->second;
+    _lru_ids.splice(_lru_ids.begin(), _lru_ids, entry.lru_it);
+    if (entry.decoded != nullptr) {
+        return entry.decoded;
+    }
+
+    auto start_time = chrono::steady_clock::now();
+    lv_draw_buf_t *decoded = lv_draw_buf_create(entry.width, entry.height, entry.color_format, LV_STRIDE_AUTO);
+    ESP_UTILS_CHECK_NULL_RETURN(decoded, nullptr, "Create decoded buffer failed");
+    if (!decode(entry, decoded)) {
+        lv_draw_buf_destroy(decoded);
+        ESP_UTILS_CHECK_FALSE_RETURN(false, nullptr, "Decode snapshot(%d) failed", id);
+    }
+    _last_decode_time_us = elapsed_us(start_time);
+    _max_decode_time_us = max(_max_decode_time_us, _last_decode_time_us);
+
+    entry.decoded = decoded;
+    _decoded_bytes += decoded->data_size;
+
+    ESP_UTILS_LOGD("Decode snapshot(%d): %d us", id, static_cast<int>(_last_decode_time_us));
+
+    return decoded;
+}
+
+bool SnapshotCache::remove(int id)
+{
+    auto it = _entries.find(id);
+    if (it == _entries.end()) {
+        return false;
+    }
+
+    auto &entry = it->second;
+    releaseEntryDecoded(entry);
+    _encoded_bytes -= entry.encoded.size();
+    _raw_bytes -= entry.raw_size;
+    _lru_ids.erase(entry.lru_it);
+    _entries.erase(it);
+
+    return true;
+}
+
+void SnapshotCache::releaseDecoded(void)
+{
+    for (auto &[id, entry] : _entries) {
+        releaseEntryDecoded(entry);
+    }
+}
+
+void SnapshotCache::clear(void)
+{
+    releaseDecoded();
+    _entries.clear();
+    _lru_ids.clear();
+    _encoded_bytes = 0;
+    _raw_bytes = 0;
+}
+
+SnapshotCache::Stats SnapshotCache::getStats(void) const
+{
+    return Stats{
+        .entry_num = _entries.size(),
+        .encoded_bytes = _encoded_bytes,
+        .decoded_bytes = _decoded_bytes,
+        .raw_bytes = _raw_bytes,
+        .evicted_count = _evicted_count,
+        .last_encode_time_us = _last_encode_time_us,
+        .max_encode_time_us = _max_encode_time_us,
+        .last_decode_time_us = _last_decode_time_us,
+        .max_decode_time_us = _max_decode_time_us,
+    };
+}
+
+void SnapshotCache::releaseEntryDecoded(Entry &entry)
+{
+    if (entry.decoded == nullptr) {
+        return;
+    }
+
+    // The image cache may still hold the source, drop it before the buffer is freed
+    lv_image_cache_drop(entry.decoded);
+    _decoded_bytes -= entry.decoded->data_size;
+    lv_draw_buf_destroy(entry.decoded);
+    entry.decoded = nullptr;
+}
+
+void SnapshotCache::evictByBudget(int keep_id)
+{
+    if (_config.memory_budget == 0) {
+        return;
+    }
+
+    while ((_encoded_bytes > _config.memory_budget) && !_lru_ids.empty()) {
+        int id = _lru_ids.back();
+        if (id == keep_id) {
+            // Never evict the snapshot which was just saved
+            break;
+        }
+        ESP_UTILS_LOGD("Evict snapshot(%d)", id);
+        remove(id);
+        _evicted_count++;
+    }
+}
+
+bool SnapshotCache::encode(const lv_draw_buf_t *src, uint32_t dst_w, uint32_t dst_h, vector<uint8_t> &out)
+{
+    const uint32_t px_size = lv_color_format_get_size(static_cast<lv_color_format_t>(src->header.cf));
+    const uint32_t src_w = src->header.w;
+    const uint32_t src_h = src->header.h;
+    const uint32_t src_stride = src->header.stride;
+    const size_t pixel_num = static_cast<size_t>(dst_w) * dst_h;
+
+    // Precompute the nearest source column of each destination column
+    vector<uint32_t> src_x_offsets(dst_w);
+    for (uint32_t x = 0; x < dst_w; x++) {
+        src_x_offsets[x] = (static_cast<uint64_t>(x) * src_w / dst_w) * px_size;
+    }
+    auto pixel = [&](size_t index) -> const uint8_t * {
+        uint32_t y = index / dst_w;
+        uint32_t x = index % dst_w;
+        uint32_t src_y = static_cast<uint64_t>(y) * src_h / dst_h;
+        return src->data + static_cast<size_t>(src_y) * src_stride + src_x_offsets[x];
+    };
+    auto same_pixel = [&](size_t a, size_t b) {
+        return memcmp(pixel(a), pixel(b), px_size) == 0;
+    };
+
+    out.clear();
+    out.reserve(pixel_num * px_size / 4);
+    size_t i = 0;
+    while (i < pixel_num) {
+        // Repeat run
+        size_t run = 1;
+        while ((i + run < pixel_num) && (run < ENCODE_REPEAT_MAX) && same_pixel(i, i + run)) {
+            run++;
+        }
+        if (run >= ENCODE_REPEAT_MIN) {
+            out.push_back(static_cast<uint8_t>(ENCODE_REPEAT_FLAG + run - ENCODE_REPEAT_MIN));
+            const uint8_t *p = pixel(i);
+            out.insert(out.end(), p, p + px_size);
+            i += run;
+            continue;
+        }
+
+        // Literal run, stop before the next repeat run
+        size_t literal = 1;
+        while ((i + literal < pixel_num) && (literal < ENCODE_LITERAL_MAX)) {
+            if ((i + literal + 1 < pixel_num) && same_pixel(i + literal, i + literal + 1)) {
+                break;
+            }
+            literal++;
+        }
+        out.push_back(static_cast<uint8_t>(literal - 1));
+        for (size_t j = 0; j < literal; j++) {
+            const uint8_t *p = pixel(i + j);
+            out.insert(out.end(), p, p + px_size);
+        }
+        i += literal;
+    }
+
+    return true;
+}
+
+bool SnapshotCache::decode(const Entry &entry, lv_draw_buf_t *dst)
+{
+    const uint32_t px_size = lv_color_format_get_size(entry.color_format);
+    const uint32_t stride = dst->header.stride;
+    const size_t pixel_num = static_cast<size_t>(entry.width) * entry.height;
+    const uint8_t *in = entry.encoded.data();
+    const uint8_t *in_end = in + entry.encoded.size();
+
+    size_t index = 0;
+    auto dst_pixel = [&](size_t i) -> uint8_t * {
+        return dst->data + (i / entry.width) * stride + (i % entry.width) * px_size;
+    };
+    while ((in < in_end) && (index < pixel_num)) {
+        uint8_t control = *in++;
+        if (control & ENCODE_REPEAT_FLAG) {
+            size_t run = control - ENCODE_REPEAT_FLAG + ENCODE_REPEAT_MIN;
+            ESP_UTILS_CHECK_FALSE_RETURN(
+                (in + px_size <= in_end) && (index + run <= pixel_num), false, "Corrupted repeat run"
+            );
+            for (size_t j = 0; j < run; j++) {
+                memcpy(dst_pixel(index++), in, px_size);
+            }
+            in += px_size;
+        } else {
+            size_t literal = control + 1;
+            ESP_UTILS_CHECK_FALSE_RETURN(
+                (in + literal * px_size <= in_end) && (index + literal <= pixel_num), false, "Corrupted literal run"
+            );
+            for (size_t j = 0; j < literal; j++) {
+                memcpy(dst_pixel(index++), in, px_size);
+                in += px_size;
+            }
+        }
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(index == pixel_num, false, "Incomplete snapshot data");
+
+    return true;
+}
+
+} // namespace esp_brookesia::systems::base
@@ -0,0 +1,104 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include "lvgl/esp_brookesia_lv_helper.hpp"
+
+namespace esp_brookesia::systems::base {
+
+/**
+ * @brief Cache of app snapshots for the recents screen.
+ *
+ * Snapshots are downscaled to the target size (keeping the aspect ratio) and run-length encoded per pixel, all
+ * encoded snapshots are kept under a memory budget with LRU eviction. The draw buffer used by LVGL is only
+ * decoded on demand and can be released as soon as the snapshots are not shown.
+ */
+class SnapshotCache {
+public:
+    struct Config {
+        gui::StyleSize target_size;     // Max size of a stored snapshot, `0` keeps the original size
+        size_t memory_budget;           // Max bytes of all encoded snapshots, `0` means unlimited
+    };
+
+    struct Stats {
+        size_t entry_num;
+        size_t encoded_bytes;           // Memory used by all encoded snapshots
+        size_t decoded_bytes;           // Memory used by the decoded draw buffers
+        size_t raw_bytes;               // Memory the snapshots would use without downscaling and encoding
+        uint32_t evicted_count;
+        uint32_t last_encode_time_us;
+        uint32_t max_encode_time_us;
+        uint32_t last_decode_time_us;
+        uint32_t max_decode_time_us;
+    };
+
+    SnapshotCache() = default;
+    ~SnapshotCache();
+
+    SnapshotCache(const SnapshotCache &) = delete;
+    SnapshotCache &operator=(const SnapshotCache &) = delete;
+
+    bool setConfig(const Config &config);
+    const Config &getConfig(void) const
+    {
+        return _config;
+    }
+
+    /**
+     * @brief Downscale and encode a full-resolution snapshot, the source buffer is not kept.
+     */
+    bool save(int id, const lv_draw_buf_t *snapshot);
+    /**
+     * @brief Get the decoded snapshot, decode it if needed. The buffer is valid until `releaseDecoded()`,
+     *        `remove()` or `clear()` is called.
+     *
+     * @return Decoded draw buffer, `nullptr` if the snapshot is not found or has been evicted
+     */
+    const lv_draw_buf_t *get(int id);
+    bool remove(int id);
+    void releaseDecoded(void);
+    void clear(void);
+
+    bool checkExist(int id) const
+    {
+        return (_entries.find(id) != _entries.end());
+    }
+    Stats getStats(void) const;
+
+private:
+    struct Entry {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        lv_color_format_t color_format = LV_COLOR_FORMAT_UNKNOWN;
+        size_t raw_size = 0;
+        std::vector<uint8_t> encoded;
+        lv_draw_buf_t *decoded = nullptr;
+        std::list<int>::iterator lru_it;
+    };
+
+    void releaseEntryDecoded(Entry &entry);
+    void evictByBudget(int keep_id);
+    static bool encode(const lv_draw_buf_t *src, uint32_t dst_w, uint32_t dst_h, std::vector<uint8_t> &out);
+    static bool decode(const Entry &entry, lv_draw_buf_t *dst);
+
+    Config _config = {};
+    std::list<int> _lru_ids;    // Front is the most recently used
+    std::unordered_map<int, Entry> _entries;
+    size_t _encoded_bytes = 0;
+    size_t _decoded_bytes = 0;
+    size_t _raw_bytes = 0;
+    uint32_t _evicted_count = 0;
+    uint32_t _last_encode_time_us = 0;
+    uint32_t _max_encode_time_us = 0;
+    uint32_t _last_decode_time_us = 0;
+    uint32_t _max_decode_time_us = 0;
+};
+
+} // namespace esp_brookesia::systems::base
@@ -60,6 +60,14 @@
 #   endif
 #endif
 
+#if !defined(ESP_BROOKESIA_BASE_ENABLE_SCALED_FONTS)
+#   if defined(CONFIG_ESP_BROOKESIA_BASE_ENABLE_SCALED_FONTS)
+#       define ESP_BROOKESIA_BASE_ENABLE_SCALED_FONTS  CONFIG_ESP_BROOKESIA_BASE_ENABLE_SCALED_FONTS
+#   else
+#       define ESP_BROOKESIA_BASE_ENABLE_SCALED_FONTS  (0)
+#   endif
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////// Phone //////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -48,7 +48,7 @@ bool Phone::begin(void)
     if (getStylesheetCount() == 0) {
         ESP_UTILS_LOGW("No phone stylesheet is added, adding default dark stylesheet(%s)",
                        _default_stylesheet_dark.core.name);
-        ESP_UTILS_CHECK_FALSE_GOTO(ret = addStylesheet(_default_stylesheet_dark), end,
+        ESP_UTILS_CHECK_FALSE_GOTO(ret = addStaticStylesheet(_default_stylesheet_dark), end,
                                    "Failed to add default stylesheet");
     }
     // Check if any phone stylesheet is activated, if not, activate default stylesheet
@@ -60,6 +60,14 @@ bool Phone::begin(void)
         ESP_UTILS_LOGW("No phone stylesheet is activated, try to find first stylesheet with display size(%dx%d)",
                        display_size.width, display_size.height);
         default_find_data = getStylesheet(display_size);
+        // E.g. only the built-in stylesheets are added, and none has the display size
+        if (default_find_data == nullptr) {
+            ESP_UTILS_LOGW("No phone stylesheet matches, adding default dark stylesheet(%s)",
+                           _default_stylesheet_dark.core.name);
+            ESP_UTILS_CHECK_FALSE_GOTO(ret = addStaticStylesheet(_default_stylesheet_dark), end,
+                                       "Failed to add default stylesheet");
+            default_find_data = getStylesheet(display_size);
+        }
         ESP_UTILS_CHECK_NULL_GOTO(default_find_data, end, "Failed to get default stylesheet");
 
         ret = activateStylesheet(*default_find_data);
@@ -144,6 +152,36 @@ bool Phone::addStylesheet(const Stylesheet *stylesheet)
     return true;
 }
 
+bool Phone::addStaticStylesheet(const Stylesheet &stylesheet)
+{
+    ESP_UTILS_LOGD("Add phone(0x%p) static stylesheet", this);
+
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        StylesheetManager::addStaticStylesheet(stylesheet.core.name, stylesheet.core.screen_size, stylesheet),
+        false, "Failed to add phone static stylesheet"
+    );
+
+    return true;
+}
+
+bool Phone::addBuiltinStylesheets(void)
+{
+    ESP_UTILS_LOGD("Add phone(0x%p) built-in stylesheets", this);
+
+    static const Stylesheet *const builtin_stylesheets[] = {
+        &STYLESHEET_320_240_DARK, &STYLESHEET_320_480_DARK, &STYLESHEET_480_480_DARK, &STYLESHEET_480_800_DARK,
+        &STYLESHEET_720_1280_DARK, &STYLESHEET_800_480_DARK, &STYLESHEET_800_1280_DARK, &STYLESHEET_1024_600_DARK,
+        &STYLESHEET_1280_800_DARK,
+    };
+    for (auto stylesheet : builtin_stylesheets) {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            addStaticStylesheet(*stylesheet), false, "Failed to add built-in stylesheet(%s)", stylesheet->core.name
+        );
+    }
+
+    return true;
+}
+
 bool Phone::activateStylesheet(const Stylesheet &stylesheet)
 {
     ESP_UTILS_LOGD("Activate phone(0x%p) stylesheet", this);
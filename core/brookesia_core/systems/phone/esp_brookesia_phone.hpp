@@ -44,6 +44,15 @@ public:
 
     bool addStylesheet(const Stylesheet &stylesheet);
     bool addStylesheet(const Stylesheet *stylesheet);
+    /**
+     * @brief Add a stylesheet with a static storage duration (e.g. `constexpr`), calibrated only if it is used
+     */
+    bool addStaticStylesheet(const Stylesheet &stylesheet);
+    /**
+     * @brief Add all the built-in dark stylesheets, as static ones. `begin()` then activates the one of the display
+     *        resolution, only it is copied into RAM and calibrated.
+     */
+    bool addBuiltinStylesheets(void);
     bool activateStylesheet(const Stylesheet &stylesheet);
     bool activateStylesheet(const Stylesheet *stylesheet);
 
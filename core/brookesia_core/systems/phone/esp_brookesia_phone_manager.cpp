@@ -124,6 +124,11 @@ bool Manager::begin(void)
         _recents_screen_drag_tan_threshold = tan(data.recents_screen.drag_snapshot_angle_threshold * M_PI / 180);
         lv_obj_add_event_cb(recents_screen->getEventObject(), onRecentsScreenSnapshotDeletedEventCallback,
                             recents_screen->getSnapshotDeletedEventCode(), this);
+        // Store app snapshots at the size of the recents screen card instead of full resolution
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            setAppSnapshotTargetSize(display.getData().recents_screen.data.snapshot_table.snapshot.image.main_size),
+            false, "Set app snapshot target size failed"
+        );
         // Register gesture event
         if (gesture != nullptr) {
             ESP_UTILS_LOGD("Enable recents_screen gesture");
@@ -857,6 +862,21 @@ bool Manager::processRecentsScreenHide(void)
     ESP_UTILS_CHECK_NULL_RETURN(recents_screen, false, "Invalid recents_screen");
     ESP_UTILS_CHECK_FALSE_RETURN(recents_screen->setVisible(false), false, "Hide recents_screen failed");
 
+    // Point the snapshot images back to the app icons, then release the decoded snapshots
+    for (int i = 0; i < getRunningAppCount(); i++) {
+        App *phone_app = static_cast<App *>(getRunningAppByIdenx(i));
+        ESP_UTILS_CHECK_NULL_RETURN(phone_app, false, "Invalid running app");
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            phone_app->updateRecentsScreenSnapshotConf(nullptr), false, "App(%d) update snapshot conf failed",
+            phone_app->getId()
+        );
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            recents_screen->updateSnapshotImage(phone_app->getId()), false,
+            "Recents screen update snapshot(%d) image failed", phone_app->getId()
+        );
+    }
+    releaseAppSnapshotDecoded();
+
     // Load the main screen if there is no active app
     if (active_app == nullptr) {
         ESP_UTILS_CHECK_FALSE_RETURN(processDisplayScreenChange(Screen::MAIN, nullptr), false,
@@ -51,6 +51,9 @@ constexpr base::Display::Data STYLESHEET_320_240_DARK_CORE_DISPLAY_DATA = {
             { .outline_width = 2, .outline_color = gui::StyleColor::COLOR(0x2d98da), },
         },
     },
+    .icon_cache = {
+        .memory_budget = 1024 * 1024,
+    },
 };
 
 constexpr base::Manager::Data STYLESHEET_320_240_DARK_CORE_MANAGER_DATA = {
@@ -60,6 +63,13 @@ constexpr base::Manager::Data STYLESHEET_320_240_DARK_CORE_MANAGER_DATA = {
     .flags = {
         .enable_app_save_snapshot = 1,
     },
+    .snapshot = {
+        .memory_budget = 512 * 1024,
+    },
+    .retain = {
+        .max_app_num = 2,
+        .memory_budget = 256 * 1024,
+    },
 };
 
 constexpr const char *STYLESHEET_320_240_DARK_CORE_INFO_DATA_NAME = "320x240 Dark";
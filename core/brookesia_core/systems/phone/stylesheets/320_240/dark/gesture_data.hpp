@@ -55,6 +55,8 @@ constexpr Gesture::Data STYLESHEET_320_240_DARK_GESTURE_DATA = {
         .vertical_edge = 20,
         .duration_short_ms = 800,
         .speed_slow_px_per_ms = 0.1,
+        .speed_fling_px_per_ms = 0.6,
+        .fling_prediction_ms = 40,
     },
     .indicator_bars = {
         [static_cast<int>(Gesture::IndicatorBarType::LEFT)] =
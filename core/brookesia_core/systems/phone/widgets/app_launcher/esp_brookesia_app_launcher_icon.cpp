@@ -20,8 +20,8 @@ AppLauncherIcon::AppLauncherIcon(base::Context &core, const Info &info, const Da
     _info(info),
     _data(data),
     _flags{},
-    _image_default_zoom(LV_SCALE_NONE),
-    _image_press_zoom(LV_SCALE_NONE),
+    _image_default_state{},
+    _image_press_state{},
     _main_obj(nullptr),
     _icon_main_obj(nullptr),
     _icon_image_obj(nullptr),
@@ -122,6 +122,9 @@ bool AppLauncherIcon::del(void)
     _icon_main_obj.reset();
     _icon_image_obj.reset();
     _name_label.reset();
+    // The rendered icons are not displayed anymore
+    releaseImageState(_image_default_state);
+    releaseImageState(_image_press_state);
 
     return true;
 }
@@ -143,9 +146,6 @@ bool AppLauncherIcon::toggleClickable(bool clickable)
 
 bool AppLauncherIcon::updateByNewData(void)
 {
-    float h_factor = 0;
-    float w_factor = 0;
-
     ESP_UTILS_LOGD("Update(%d: @0x%p)", _info.id, this);
     ESP_UTILS_CHECK_FALSE_RETURN(checkInitialized(), false, "Icon is not initialized");
 
@@ -159,32 +159,52 @@ bool AppLauncherIcon::updateByNewData(void)
     lv_obj_set_style_text_color(_name_label.get(), lv_color_hex(_data.label.text_color.color), 0);
     lv_obj_set_style_text_opa(_name_label.get(), _data.label.text_color.opacity, 0);
     // Image
-    // Calculate the multiple of the size between the target and the image.
-    h_factor = (float)(_data.image.default_size.width) / ((lv_img_dsc_t *)_info.image.resource)->header.h;
-    w_factor = (float)(_data.image.default_size.height) / ((lv_img_dsc_t *)_info.image.resource)->header.w;
-    // Scale the image to a suitable size.
-    // So you don’t have to consider the size of the source image.
-    if (h_factor < w_factor) {
-        _image_default_zoom = (int)(h_factor * LV_SCALE_NONE);
-        lv_image_set_scale(_icon_image_obj.get(), _image_default_zoom);
-    } else {
-        _image_default_zoom = (int)(w_factor * LV_SCALE_NONE);
-        lv_image_set_scale(_icon_image_obj.get(), _image_default_zoom);
+    // Render the icon once for each state, instead of scaling it on every redraw. The new icons are acquired before
+    // the old ones are released, so the unchanged ones are not rendered again
+    ImageState default_state = acquireImageState(_data.image.default_size);
+    ImageState press_state = acquireImageState(_data.image.press_size);
+    releaseImageState(_image_default_state);
+    releaseImageState(_image_press_state);
+    _image_default_state = default_state;
+    _image_press_state = press_state;
+    applyImageState(_icon_image_obj.get(), _image_default_state, _data.image.default_size);
+
+    return true;
+}
+
+AppLauncherIcon::ImageState AppLauncherIcon::acquireImageState(const StyleSize &size)
+{
+    const lv_draw_buf_t *icon = _system_context.getDisplay().getIconCache().acquire(_info.image.resource, size);
+    if (icon == nullptr) {
+        // Not cached, scale the original image on draw
+        return ImageState{
+            .src = _info.image.resource,
+            .zoom = base::IconCache::calculateScale(_info.image.resource, size),
+            .cache_size = {},
+        };
     }
-    lv_obj_set_size(_icon_image_obj.get(), _data.image.default_size.width, _data.image.default_size.height);
-    lv_obj_refr_size(_icon_image_obj.get());
-    // Calculate the multiple of the size between the target and the image.
-    h_factor = (float)(_data.image.press_size.width) / ((lv_img_dsc_t *)_info.image.resource)->header.h;
-    w_factor = (float)(_data.image.press_size.height) / ((lv_img_dsc_t *)_info.image.resource)->header.w;
-    // Scale the image to a suitable size.
-    // So you don’t have to consider the size of the source image.
-    if (h_factor < w_factor) {
-        _image_press_zoom = (int)(h_factor * LV_SCALE_NONE);
-    } else {
-        _image_press_zoom = (int)(w_factor * LV_SCALE_NONE);
+
+    return ImageState{
+        .src = icon,
+        .zoom = LV_SCALE_NONE,
+        .cache_size = size,
+    };
+}
+
+void AppLauncherIcon::releaseImageState(ImageState &state)
+{
+    if ((state.cache_size.width > 0) && (state.cache_size.height > 0)) {
+        _system_context.getDisplay().getIconCache().release(_info.image.resource, state.cache_size);
     }
+    state = {};
+}
 
-    return true;
+void AppLauncherIcon::applyImageState(lv_obj_t *image_obj, const ImageState &state, const StyleSize &size)
+{
+    lv_image_set_src(image_obj, state.src);
+    lv_image_set_scale(image_obj, state.zoom);
+    lv_obj_set_size(image_obj, size.width, size.height);
+    lv_obj_refr_size(image_obj);
 }
 
 void AppLauncherIcon::onIconTouchEventCallback(lv_event_t *event)
@@ -220,9 +240,7 @@ void AppLauncherIcon::onIconTouchEventCallback(lv_event_t *event)
             break;
         }
         // Zoom out icon
-        lv_image_set_scale(icon_image_obj, icon->_image_press_zoom);
-        lv_obj_set_size(icon_image_obj, icon->_data.image.press_size.width, icon->_data.image.press_size.height);
-        lv_obj_refr_size(icon_image_obj);
+        icon->applyImageState(icon_image_obj, icon->_image_press_state, icon->_data.image.press_size);
         icon->_flags.is_pressed_losted = false;
         break;
     case LV_EVENT_PRESS_LOST:
@@ -232,9 +250,7 @@ void AppLauncherIcon::onIconTouchEventCallback(lv_event_t *event)
     case LV_EVENT_RELEASED:
         ESP_UTILS_LOGD("Released");
         // Zoom in icon
-        lv_image_set_scale(icon_image_obj, icon->_image_default_zoom);
-        lv_obj_set_size(icon_image_obj, icon->_data.image.default_size.width, icon->_data.image.default_size.height);
-        lv_obj_refr_size(icon_image_obj);
+        icon->applyImageState(icon_image_obj, icon->_image_default_state, icon->_data.image.default_size);
         break;
     default:
         ESP_UTILS_CHECK_FALSE_EXIT(false, "Invalid event code(%d)", event_code);
@@ -50,6 +50,16 @@ public:
     bool updateByNewData(void);
 
 private:
+    struct ImageState {
+        const void *src;                // Rendered icon of the icon cache, or the original image
+        int zoom;                       // `LV_SCALE_NONE` if rendered
+        gui::StyleSize cache_size;      // Size acquired from the icon cache, `0` if not cached
+    };
+
+    ImageState acquireImageState(const gui::StyleSize &size);
+    void releaseImageState(ImageState &state);
+    void applyImageState(lv_obj_t *image_obj, const ImageState &state, const gui::StyleSize &size);
+
     static void onIconTouchEventCallback(lv_event_t *event);
 
     base::Context &_system_context;
@@ -60,8 +70,8 @@ private:
         uint8_t is_pressed_losted: 1;
         uint8_t is_click_disable: 1;
     } _flags;
-    int _image_default_zoom;
-    int _image_press_zoom;
+    ImageState _image_default_state;
+    ImageState _image_press_state;
     gui::LvObjSharedPtr _main_obj;
     gui::LvObjSharedPtr _icon_main_obj;
     gui::LvObjSharedPtr _icon_image_obj;
@@ -5,6 +5,7 @@
  */
 #include <limits>
 #include <cmath>
+#include <map>
 #include "esp_brookesia_systems_internal.h"
 #if !ESP_BROOKESIA_PHONE_GESTURE_ENABLE_DEBUG_LOG
 #   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
@@ -17,6 +18,22 @@ using namespace esp_brookesia::gui;
 
 namespace esp_brookesia::systems::phone {
 
+static_assert(
+    (Gesture::DIR_UP == GestureRecognizer::DIR_UP) && (Gesture::DIR_DOWN == GestureRecognizer::DIR_DOWN) &&
+    (Gesture::DIR_LEFT == GestureRecognizer::DIR_LEFT) && (Gesture::DIR_RIGHT == GestureRecognizer::DIR_RIGHT),
+    "Gesture directions mismatch"
+);
+static_assert(
+    (Gesture::AREA_TOP_EDGE == GestureRecognizer::AREA_TOP_EDGE) &&
+    (Gesture::AREA_BOTTOM_EDGE == GestureRecognizer::AREA_BOTTOM_EDGE) &&
+    (Gesture::AREA_LEFT_EDGE == GestureRecognizer::AREA_LEFT_EDGE) &&
+    (Gesture::AREA_RIGHT_EDGE == GestureRecognizer::AREA_RIGHT_EDGE),
+    "Gesture areas mismatch"
+);
+
+// The gestures fed by the events of the touch devices
+static map<lv_indev_t *, Gesture *> touch_device_gestures;
+
 Gesture::Gesture(base::Context &core_in, const Gesture::Data &data_in)
     : core(core_in)
     , data(data_in)
@@ -33,7 +50,6 @@ Gesture::~Gesture()
 
 bool Gesture::begin(lv_obj_t *parent)
 {
-    ESP_Brookesia_LvTimer_t detect_timer = nullptr;
     ESP_Brookesia_LvObj_t event_mask_obj = nullptr;
     array<ESP_Brookesia_LvObj_t, static_cast<int>(Gesture::IndicatorBarType::MAX)> indicator_bars = {};
     array<ESP_Brookesia_LvAnim_t, static_cast<int>(Gesture::IndicatorBarType::MAX)> indicator_bar_scale_back_anims = {};
@@ -43,10 +59,12 @@ bool Gesture::begin(lv_obj_t *parent)
 
     ESP_UTILS_LOGD("Begin(0x%p)", this);
     ESP_UTILS_CHECK_NULL_RETURN(core.getTouchDevice(), false, "Invalid core touch device");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        touch_device_gestures.find(core.getTouchDevice()) == touch_device_gestures.end(), false,
+        "Touch device is already used by another gesture"
+    );
 
     /* Create objects */
-    detect_timer = ESP_BROOKESIA_LV_TIMER(onTouchDetectTimerCallback, data.detect_period_ms, this);
-    ESP_UTILS_CHECK_NULL_RETURN(detect_timer, false, "Create detect timer failed");
     event_mask_obj = ESP_BROOKESIA_LV_OBJ(obj, parent);
     ESP_UTILS_CHECK_NULL_RETURN(event_mask_obj, false, "Create event & mask object failed");
     press_event_code = core.getFreeEventCode();
@@ -93,7 +111,6 @@ bool Gesture::begin(lv_obj_t *parent)
 
     // Save objects
     _touch_device = core.getTouchDevice();
-    _detect_timer = detect_timer;
     _event_mask_obj = event_mask_obj;
     _press_event_code = press_event_code;
     _pressing_event_code = pressing_event_code;
@@ -104,6 +121,13 @@ bool Gesture::begin(lv_obj_t *parent)
     // Update the object style
     ESP_UTILS_CHECK_FALSE_GOTO(updateByNewData(), err, "Update failed");
 
+    // The samples are processed as they are read, instead of polling the touch device. The events are sent once LVGL
+    // has transformed (e.g. rotated) the point of each read
+    lv_indev_add_event_cb(_touch_device, onTouchDeviceEventCallback, LV_EVENT_PRESSING, this);
+    lv_indev_add_event_cb(_touch_device, onTouchDeviceEventCallback, LV_EVENT_RELEASED, this);
+    lv_indev_add_event_cb(_touch_device, onTouchDeviceEventCallback, LV_EVENT_PRESS_LOST, this);
+    touch_device_gestures[_touch_device] = this;
+
     return true;
 
 err:
@@ -116,9 +140,17 @@ bool Gesture::del(void)
 {
     ESP_UTILS_LOGD("Delete(0x%p)", this);
 
-    _direction_tan_threshold = 0;
-    _touch_start_tick = 0;
-    _detect_timer.reset();
+    auto it = touch_device_gestures.find(_touch_device);
+    if ((it != touch_device_gestures.end()) && (it->second == this)) {
+        lv_indev_remove_event_cb_with_user_data(_touch_device, onTouchDeviceEventCallback, this);
+        touch_device_gestures.erase(it);
+    }
+    _flags.is_touch_sample_pressed = false;
+    _touch_sample_tick = 0;
+    _touch_sample_x = -1;
+    _touch_sample_y = -1;
+    _pressing_event_tick = 0;
+    _recognizer.reset();
     resetGestureInfo();
     _event_mask_obj.reset();
     for (int i = 0; i < static_cast<int>(Gesture::IndicatorBarType::MAX); i++) {
@@ -206,6 +238,7 @@ bool Gesture::calibrateData(const gui::StyleSize &screen_size, const base::Displ
     ESP_UTILS_CHECK_VALUE_RETURN(data.threshold.vertical_edge, 1, parent_h, false, "Invalid top edge threshold");
     ESP_UTILS_CHECK_FALSE_RETURN(data.threshold.speed_slow_px_per_ms > 0, false, "Invalid speed slow threshold");
     ESP_UTILS_CHECK_FALSE_RETURN(data.threshold.duration_short_ms > 0, false, "Invalid duration short threshold");
+    ESP_UTILS_CHECK_FALSE_RETURN(data.threshold.speed_fling_px_per_ms >= 0, false, "Invalid speed fling threshold");
     // Left/Right indicator bar
     for (int i = 0; i < static_cast<int>(Gesture::IndicatorBarType::MAX); i++) {
         if (!data.flags.enable_indicator_bars[i]) {
@@ -402,8 +435,22 @@ bool Gesture::updateByNewData(void)
     int align_x_offset = 0;
     int align_y_offset = 0;
     lv_align_t align = LV_ALIGN_DEFAULT;
-    // Timer
-    lv_timer_set_period(_detect_timer.get(), data.detect_period_ms);
+    // Recognizer
+    GestureRecognizer::Config recognizer_config = {
+        .screen_width = core.getData().screen_size.width,
+        .screen_height = core.getData().screen_size.height,
+        .direction_vertical = data.threshold.direction_vertical,
+        .direction_horizon = data.threshold.direction_horizon,
+        .direction_angle = data.threshold.direction_angle,
+        .horizontal_edge = data.threshold.horizontal_edge,
+        .vertical_edge = data.threshold.vertical_edge,
+        .duration_short_ms = data.threshold.duration_short_ms,
+        .speed_slow_px_per_ms = data.threshold.speed_slow_px_per_ms,
+        .speed_fling_px_per_ms = data.threshold.speed_fling_px_per_ms,
+        .fling_prediction_ms = data.threshold.fling_prediction_ms,
+    };
+    ESP_UTILS_CHECK_FALSE_RETURN(_recognizer.setConfig(recognizer_config), false, "Set recognizer config failed");
+    resetGestureInfo();
     // Mask
     lv_obj_set_size(_event_mask_obj.get(), core.getData().screen_size.width, core.getData().screen_size.height);
     // Indicator bar
@@ -452,8 +499,6 @@ bool Gesture::updateByNewData(void)
                                            (float)bar_range;
         lv_obj_align(_indicator_bars[i].get(), align, align_x_offset, align_y_offset);
     }
-    // Data
-    _direction_tan_threshold = tan((int)data.threshold.direction_angle * M_PI / 180);
 
     return true;
 }
@@ -471,123 +516,109 @@ void Gesture::onDataUpdateEventCallback(lv_event_t *event)
     ESP_UTILS_CHECK_FALSE_EXIT(gesture->updateByNewData(), "Update gesture object style failed");
 }
 
-void Gesture::onTouchDetectTimerCallback(struct _lv_timer_t *t)
+bool Gesture::processTouchSample(void)
 {
-    bool touched = false;
-    int distance_x = 0;
-    int distance_y = 0;
-    float distance_tan = numeric_limits<float>::infinity();
     lv_event_code_t event_code = LV_EVENT_ALL;
+    GestureRecognizer::Sample sample = {
+        .x = _info.stop_x,
+        .y = _info.stop_y,
+        .pressed = false,
+        .time_ms = _touch_sample_tick,
+    };
 
-    Gesture *gesture = (Gesture *)t->user_data;
-    ESP_UTILS_CHECK_NULL_EXIT(gesture, "Invalid gesture");
-
-    const Gesture::Data &data = gesture->data;
-    const int &display_w = gesture->core.getData().screen_size.width;
-    const int &display_h = gesture->core.getData().screen_size.height;
-    const float &distance_tan_threshold = gesture->_direction_tan_threshold;
-    Gesture::Info &info = gesture->_info;
-
-    // Check if touched and save the last touch point
-    touched = gesture->readTouchPoint(info.stop_x, info.stop_y);
-
-    // Process the stop area
-    info.stop_area = Gesture::AREA_CENTER;
-    info.stop_area |= (info.stop_y < data.threshold.vertical_edge) ? Gesture::AREA_TOP_EDGE : 0;
-    info.stop_area |= ((display_h - info.stop_y) < data.threshold.vertical_edge) ? Gesture::AREA_BOTTOM_EDGE : 0;
-    info.stop_area |= (info.stop_x < data.threshold.horizontal_edge) ? Gesture::AREA_LEFT_EDGE : 0;
-    info.stop_area |= ((display_w - info.stop_x) < data.threshold.horizontal_edge) ? Gesture::AREA_RIGHT_EDGE : 0;
+    ESP_UTILS_CHECK_FALSE_RETURN(checkInitialized(), false, "Not initialized");
 
-    // If not touched before and now, just ignore and return
-    if (!gesture->checkGestureStart() && !touched) {
-        return;
+    sample.pressed = readTouchPoint(sample.x, sample.y);
+    auto event = _recognizer.feed(sample);
+    if (event == GestureRecognizer::Event::NONE) {
+        return true;
     }
 
-    // If not touched before but touched now, it means the gesture is started
-    if (!gesture->checkGestureStart() && touched) {
-        // Save the first touch point
-        gesture->_touch_start_tick = lv_tick_get();
-        info.start_x = info.stop_x;
-        info.start_y = info.stop_y;
-
-        // Process the start area
-        info.start_area = Gesture::AREA_CENTER;
-        info.start_area |= (info.start_y < data.threshold.vertical_edge) ? Gesture::AREA_TOP_EDGE : 0;
-        info.start_area |= ((display_h - info.start_y) < data.threshold.vertical_edge) ? Gesture::AREA_BOTTOM_EDGE : 0;
-        info.start_area |= (info.start_x < data.threshold.horizontal_edge) ? Gesture::AREA_LEFT_EDGE : 0;
-        info.start_area |= ((display_w - info.start_x) < data.threshold.horizontal_edge) ? Gesture::AREA_RIGHT_EDGE : 0;
-
-        // Set the press event code
-        event_code = gesture->_press_event_code;
+    const GestureRecognizer::Track &track = _recognizer.getTrack();
+    Gesture::Info &info = _info;
+    info.direction = static_cast<Gesture::Direction>(track.direction);
+    info.start_area = track.start_area;
+    info.stop_area = track.stop_area;
+    info.start_x = track.start_x;
+    info.start_y = track.start_y;
+    info.stop_x = track.stop_x;
+    info.stop_y = track.stop_y;
+    info.duration_ms = track.duration_ms;
+    info.speed_px_per_ms = track.speed_px_per_ms;
+    info.distance_px = track.distance_px;
+    info.velocity_x_px_per_ms = track.velocity_x_px_per_ms;
+    info.velocity_y_px_per_ms = track.velocity_y_px_per_ms;
+    info.flags.slow_speed = track.flags.slow_speed;
+    info.flags.short_duration = track.flags.short_duration;
+    info.flags.fling = track.flags.fling;
+
+    switch (event) {
+    case GestureRecognizer::Event::PRESS:
+        event_code = _press_event_code;
+        _pressing_event_tick = sample.time_ms;
         ESP_UTILS_LOGD("Gesture send press event");
-
-        goto event_process;
-    }
-
-    // Process the duration
-    info.duration_ms = lv_tick_elaps(gesture->_touch_start_tick);
-    info.flags.short_duration = (info.duration_ms < data.threshold.duration_short_ms);
-
-    // Set the event code according to the touch status
-    if (touched) {
-        event_code = gesture->_pressing_event_code;
+        break;
+    case GestureRecognizer::Event::PRESSING:
+        // Not more often than the former detection, unless the direction is just recognized
+        if (((sample.time_ms - _pressing_event_tick) < data.detect_period_ms) &&
+                (info.direction == _event_data.direction)) {
+            return true;
+        }
+        event_code = _pressing_event_code;
+        _pressing_event_tick = sample.time_ms;
         ESP_UTILS_LOGD("Gesture send pressing event");
-    } else {
-        event_code = gesture->_release_event_code;
+        break;
+    default:
+        event_code = _release_event_code;
         ESP_UTILS_LOGD("Gesture send release event");
+        break;
     }
 
-    // If not touched now but touched before, it means the gesture is finished
-    distance_x = info.stop_x - info.start_x;
-    distance_y = info.stop_y - info.start_y;
-    if ((distance_x == 0) && (distance_y == 0)) {
-        // If the distance is too small, just ignore and go to the end
-        goto event_process;
+    ESP_UTILS_LOGD(
+        "\n\tpoint(%d,%d->%d,%d), area(%d->%d), dir(%d), distance(%.2f), duration(%dms), speed(%.2f), "
+        "velocity(%.2f,%.2f), fling(%d), event(%d)", info.start_x, info.start_y, info.stop_x, info.stop_y,
+        info.start_area, info.stop_area, (int)info.direction, info.distance_px, (int)info.duration_ms,
+        info.speed_px_per_ms, info.velocity_x_px_per_ms, info.velocity_y_px_per_ms, (int)info.flags.fling,
+        (int)event_code
+    );
+
+    _event_data = info;
+    lv_obj_send_event(_event_mask_obj.get(), event_code, (void *)&_event_data);
+    if (event_code == _release_event_code) {
+        resetGestureInfo();
     }
 
-    // Process the distance and speed
-    info.distance_px = (float)sqrt(distance_x * distance_x + distance_y * distance_y);
-    info.speed_px_per_ms = (info.duration_ms > 0) ? (info.distance_px / info.duration_ms) :
-                           numeric_limits<float>::infinity();
-    info.flags.slow_speed = (info.speed_px_per_ms < data.threshold.speed_slow_px_per_ms);
-
-    /* Process the direction */
-    // Calculate the tan value of the gesture
-    distance_tan = (distance_x == 0) ? numeric_limits<float>::infinity() : (float)distance_y / distance_x;
-    // Check if the tan absolute value is large enoughd
-    // if so, it means the gesture is up or down, otherwise, it's left or right
-    if ((distance_tan == numeric_limits<float>::infinity()) || (distance_tan > distance_tan_threshold) ||
-            (distance_tan < -distance_tan_threshold)) {
-        // Check the distance in y axis
-        if (distance_y > data.threshold.direction_vertical) {
-            info.direction = Gesture::DIR_DOWN;
-        } else if (distance_y < -data.threshold.direction_vertical) {
-            info.direction = Gesture::DIR_UP;
-        }
-    } else {
-        // Check the distance in x axis
-        if (distance_x > data.threshold.direction_horizon) {
-            info.direction = Gesture::DIR_RIGHT;
-        } else if (distance_x < -data.threshold.direction_horizon) {
-            info.direction = Gesture::DIR_LEFT;
-        }
-    }
+    return true;
+}
+
+void Gesture::onTouchDeviceEventCallback(lv_event_t *event)
+{
+    ESP_UTILS_CHECK_NULL_EXIT(event, "Invalid event");
+
+    Gesture *gesture = static_cast<Gesture *>(lv_event_get_user_data(event));
+    ESP_UTILS_CHECK_NULL_EXIT(gesture, "Invalid gesture");
 
-event_process:
-    if (gesture->checkGestureStart()) {
-        ESP_UTILS_LOGD(
-            "\n\tpoint(%d,%d->%d,%d), area(%d->%d), dir(%d), distance(%.2f), angle(%d), duration(%dms), speed(%.2f),"
-            "event(%d)", info.start_x, info.start_y, info.stop_x, info.stop_y, info.start_area, info.stop_area,
-            (int)info.direction, info.distance_px, (int)(atan(distance_tan) * -180 / M_PI), (int)info.duration_ms,
-            info.speed_px_per_ms, (int)event_code
-        );
+    // Nothing to do while not touched
+    lv_indev_t *indev = gesture->_touch_device;
+    bool pressed = (lv_indev_get_state(indev) == LV_INDEV_STATE_PRESSED);
+    if (!pressed && !gesture->_flags.is_touch_sample_pressed) {
+        return;
     }
 
-    gesture->_event_data = info;
-    lv_obj_send_event(gesture->_event_mask_obj.get(), event_code, (void *)&gesture->_event_data);
-    if (event_code == gesture->_release_event_code) {
-        gesture->resetGestureInfo();
+    // The events bubbling through the parents of the pressed object reach the device again, skip the repeated samples
+    lv_point_t point = {};
+    lv_indev_get_point(indev, &point);
+    uint32_t tick = lv_tick_get();
+    if (pressed && gesture->_flags.is_touch_sample_pressed && (tick == gesture->_touch_sample_tick) &&
+            (point.x == gesture->_touch_sample_x) && (point.y == gesture->_touch_sample_y)) {
+        return;
     }
+    gesture->_flags.is_touch_sample_pressed = pressed;
+    gesture->_touch_sample_tick = tick;
+    gesture->_touch_sample_x = point.x;
+    gesture->_touch_sample_y = point.y;
+
+    ESP_UTILS_CHECK_FALSE_EXIT(gesture->processTouchSample(), "Process touch sample failed");
 }
 
 void Gesture::onIndicatorBarScaleBackAnimationExecuteCallback(void *var, int32_t value)
@@ -7,6 +7,7 @@
 
 #include "systems/base/esp_brookesia_base_context.hpp"
 #include "lvgl/esp_brookesia_lv_helper.hpp"
+#include "esp_brookesia_gesture_recognizer.hpp"
 
 namespace esp_brookesia::systems::phone {
 
@@ -38,7 +39,7 @@ public:
     };
 
     struct Data {
-        uint8_t detect_period_ms;
+        uint8_t detect_period_ms;       // Min period of the pressing events, the touch samples are processed as read
         struct {
             int direction_vertical;
             int direction_horizon;
@@ -47,6 +48,8 @@ public:
             int vertical_edge;
             int duration_short_ms;
             float speed_slow_px_per_ms;
+            float speed_fling_px_per_ms;    // Min speed to predict the direction of a fling, `0` disables it
+            uint16_t fling_prediction_ms;
         } threshold;
         Gesture::IndicatorBarData indicator_bars[static_cast<int>(Gesture::IndicatorBarType::MAX)];
         struct {
@@ -83,9 +86,12 @@ public:
         uint32_t duration_ms;
         float speed_px_per_ms;
         float distance_px;
+        float velocity_x_px_per_ms;
+        float velocity_y_px_per_ms;
         struct {
             uint8_t slow_speed: 1;
             uint8_t short_duration: 1;
+            uint8_t fling: 1;
         } flags;
     };
 
@@ -147,9 +153,10 @@ private:
     };
     void resetGestureInfo(void);
     bool updateByNewData(void);
+    bool processTouchSample(void);
 
     static void onDataUpdateEventCallback(lv_event_t *event);
-    static void onTouchDetectTimerCallback(struct _lv_timer_t *t);
+    static void onTouchDeviceEventCallback(lv_event_t *event);
     static void onIndicatorBarScaleBackAnimationExecuteCallback(void *var, int32_t value);
     static void onIndicatorBarScaleBackAnimationReadyCallback(lv_anim_t *anim);
 
@@ -163,9 +170,12 @@ private:
         .stop_y = -1,
         .duration_ms = 0,
         .distance_px = 0,
+        .velocity_x_px_per_ms = 0,
+        .velocity_y_px_per_ms = 0,
         .flags = {
             .slow_speed = 0,
             .short_duration = 0,
+            .fling = 0,
         },
     };
 
@@ -173,13 +183,16 @@ private:
     lv_indev_t *_touch_device = nullptr;
 
     struct {
+        uint8_t is_touch_sample_pressed: 1;
         std::array<bool, static_cast<int>(Gesture::IndicatorBarType::MAX)>  is_indicator_bar_scale_back_anim_running;
     } _flags = {};
-    float _direction_tan_threshold = 0;
+    GestureRecognizer _recognizer;
+    uint32_t _touch_sample_tick = 0;
+    int32_t _touch_sample_x = -1;
+    int32_t _touch_sample_y = -1;
+    uint32_t _pressing_event_tick = 0;
     std::array<int, static_cast<int>(Gesture::IndicatorBarType::MAX)>  _indicator_bar_min_lengths;
     std::array<int, static_cast<int>(Gesture::IndicatorBarType::MAX)>  _indicator_bar_max_lengths;
-    uint32_t _touch_start_tick = 0;
-    ESP_Brookesia_LvTimer_t _detect_timer;
     ESP_Brookesia_LvObj_t _event_mask_obj;
     std::array<ESP_Brookesia_LvObj_t, static_cast<int>(Gesture::IndicatorBarType::MAX)>  _indicator_bars;
     std::array<IndicatorBarAnimVar_t, static_cast<int>(Gesture::IndicatorBarType::MAX)>  _indicator_bar_anim_var;
@@ -0,0 +1,189 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <cmath>
+#include <limits>
+#include "esp_brookesia_gesture_recognizer.hpp"
+
+using namespace std;
+
+namespace esp_brookesia::systems::phone {
+
+bool GestureRecognizer::setConfig(const Config &config)
+{
+    if ((config.screen_width <= 0) || (config.screen_height <= 0) || (config.direction_angle >= 90) ||
+            (config.speed_fling_px_per_ms < 0) || (config.velocity_filter_ms == 0)) {
+        return false;
+    }
+
+    _config = config;
+    _direction_tan_threshold = tanf(static_cast<float>(config.direction_angle) * static_cast<float>(M_PI) / 180);
+    reset();
+
+    return true;
+}
+
+GestureRecognizer::Event GestureRecognizer::feed(const Sample &sample)
+{
+    if (!_is_active) {
+        if (!sample.pressed) {
+            return Event::NONE;
+        }
+
+        _is_active = true;
+        _has_velocity = false;
+        _start_time_ms = sample.time_ms;
+        _last_time_ms = sample.time_ms;
+        _track = TRACK_INIT;
+        _track.start_x = sample.x;
+        _track.start_y = sample.y;
+        _track.stop_x = sample.x;
+        _track.stop_y = sample.y;
+        _track.start_area = getArea(sample.x, sample.y);
+        _track.stop_area = _track.start_area;
+
+        return Event::PRESS;
+    }
+
+    if (sample.pressed) {
+        updateMotion(sample.x, sample.y, sample.time_ms);
+        _track.stop_x = sample.x;
+        _track.stop_y = sample.y;
+        _track.stop_area = getArea(sample.x, sample.y);
+    } else if ((sample.time_ms - _last_time_ms) > 2U * _config.velocity_filter_ms) {
+        // The touch was held still before the release, it isn't a fling
+        _track.velocity_x_px_per_ms = 0;
+        _track.velocity_y_px_per_ms = 0;
+        _track.acceleration_x_px_per_ms2 = 0;
+        _track.acceleration_y_px_per_ms2 = 0;
+    }
+
+    _track.duration_ms = sample.time_ms - _start_time_ms;
+    _track.flags.short_duration = (_track.duration_ms < static_cast<uint32_t>(_config.duration_short_ms));
+    updateDirection();
+
+    if (!sample.pressed) {
+        _is_active = false;
+
+        return Event::RELEASE;
+    }
+
+    return Event::PRESSING;
+}
+
+void GestureRecognizer::reset(void)
+{
+    _is_active = false;
+    _has_velocity = false;
+    _track = TRACK_INIT;
+}
+
+uint8_t GestureRecognizer::getArea(int x, int y) const
+{
+    uint8_t area = AREA_CENTER;
+
+    area |= (y < _config.vertical_edge) ? AREA_TOP_EDGE : 0;
+    area |= ((_config.screen_height - y) < _config.vertical_edge) ? AREA_BOTTOM_EDGE : 0;
+    area |= (x < _config.horizontal_edge) ? AREA_LEFT_EDGE : 0;
+    area |= ((_config.screen_width - x) < _config.horizontal_edge) ? AREA_RIGHT_EDGE : 0;
+
+    return area;
+}
+
+void GestureRecognizer::updateMotion(int x, int y, uint32_t time_ms)
+{
+    uint32_t dt_ms = time_ms - _last_time_ms;
+    if (dt_ms == 0) {
+        // Merged with the next sample, which gets the whole displacement
+        return;
+    }
+
+    float dt = static_cast<float>(dt_ms);
+    float velocity_x = (x - _track.stop_x) / dt;
+    float velocity_y = (y - _track.stop_y) / dt;
+    _last_time_ms = time_ms;
+
+    // The first velocity isn't filtered, the filter would start from a still touch
+    if (!_has_velocity) {
+        _has_velocity = true;
+        _track.velocity_x_px_per_ms = velocity_x;
+        _track.velocity_y_px_per_ms = velocity_y;
+        return;
+    }
+
+    // First-order low-pass filters, their time constant doesn't depend on the sample rate
+    float alpha = dt / (dt + _config.velocity_filter_ms);
+    float last_velocity_x = _track.velocity_x_px_per_ms;
+    float last_velocity_y = _track.velocity_y_px_per_ms;
+    _track.velocity_x_px_per_ms += alpha * (velocity_x - last_velocity_x);
+    _track.velocity_y_px_per_ms += alpha * (velocity_y - last_velocity_y);
+    _track.acceleration_x_px_per_ms2 +=
+        alpha * ((_track.velocity_x_px_per_ms - last_velocity_x) / dt - _track.acceleration_x_px_per_ms2);
+    _track.acceleration_y_px_per_ms2 +=
+        alpha * ((_track.velocity_y_px_per_ms - last_velocity_y) / dt - _track.acceleration_y_px_per_ms2);
+}
+
+uint8_t GestureRecognizer::getDirection(float distance_x, float distance_y) const
+{
+    // If the tan value of the gesture is large enough, it's up or down, otherwise, it's left or right
+    if (fabsf(distance_y) > fabsf(distance_x) * _direction_tan_threshold) {
+        if (distance_y > _config.direction_vertical) {
+            return DIR_DOWN;
+        } else if (distance_y < -_config.direction_vertical) {
+            return DIR_UP;
+        }
+    } else {
+        if (distance_x > _config.direction_horizon) {
+            return DIR_RIGHT;
+        } else if (distance_x < -_config.direction_horizon) {
+            return DIR_LEFT;
+        }
+    }
+
+    return DIR_NONE;
+}
+
+void GestureRecognizer::updateDirection(void)
+{
+    float distance_x = static_cast<float>(_track.stop_x - _track.start_x);
+    float distance_y = static_cast<float>(_track.stop_y - _track.start_y);
+
+    _track.distance_px = sqrtf(distance_x * distance_x + distance_y * distance_y);
+    if (_track.distance_px == 0) {
+        return;
+    }
+    _track.speed_px_per_ms = (_track.duration_ms > 0) ? (_track.distance_px / _track.duration_ms) :
+                             numeric_limits<float>::infinity();
+    _track.flags.slow_speed = (_track.speed_px_per_ms < _config.speed_slow_px_per_ms);
+
+    // A travelled direction replaces the predicted one, a predicted direction never replaces another direction
+    uint8_t direction = getDirection(distance_x, distance_y);
+    if (direction != DIR_NONE) {
+        _track.direction = direction;
+        _track.flags.fling = 0;
+        return;
+    }
+    if ((_track.direction != DIR_NONE) || (_config.speed_fling_px_per_ms <= 0) || (_config.fling_prediction_ms == 0)) {
+        return;
+    }
+
+    float velocity_x = _track.velocity_x_px_per_ms;
+    float velocity_y = _track.velocity_y_px_per_ms;
+    if (sqrtf(velocity_x * velocity_x + velocity_y * velocity_y) < _config.speed_fling_px_per_ms) {
+        return;
+    }
+
+    // Predict the point the fling is heading to
+    direction = getDirection(
+                    distance_x + velocity_x * _config.fling_prediction_ms,
+                    distance_y + velocity_y * _config.fling_prediction_ms
+                );
+    if (direction != DIR_NONE) {
+        _track.direction = direction;
+        _track.flags.fling = 1;
+    }
+}
+
+} // namespace esp_brookesia::systems::phone
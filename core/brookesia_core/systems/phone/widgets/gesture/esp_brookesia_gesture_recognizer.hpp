@@ -0,0 +1,160 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace esp_brookesia::systems::phone {
+
+/**
+ * @brief Recognizes the gestures from the raw touch samples, as they are read from the touch device.
+ *
+ * It tracks the start and stop points, areas and direction of a gesture like `Gesture` always did, and estimates the
+ * velocity and acceleration of the touch with a first-order filter. When a fling prediction is configured, a fast
+ * gesture gets its direction from the point it is heading to, before it has travelled the direction threshold.
+ *
+ * Nothing is done between the gestures, only the samples fed while (or right after) touching are processed.
+ *
+ * @note It doesn't depend on LVGL, so the recognition can be replayed from recorded traces on the host.
+ */
+class GestureRecognizer {
+public:
+    // Same values as `Gesture::Direction` and `Gesture::Area`
+    enum Direction : uint8_t {
+        DIR_NONE  = 0,
+        DIR_UP    = (1 << 0),
+        DIR_DOWN  = (1 << 1),
+        DIR_LEFT  = (1 << 2),
+        DIR_RIGHT = (1 << 3),
+    };
+
+    enum Area : uint8_t {
+        AREA_CENTER      = 0,
+        AREA_TOP_EDGE    = (1 << 0),
+        AREA_BOTTOM_EDGE = (1 << 1),
+        AREA_LEFT_EDGE   = (1 << 2),
+        AREA_RIGHT_EDGE  = (1 << 3),
+    };
+
+    enum class Event {
+        NONE,
+        PRESS,
+        PRESSING,
+        RELEASE,
+    };
+
+    struct Config {
+        int screen_width;
+        int screen_height;
+        int direction_vertical;
+        int direction_horizon;
+        uint8_t direction_angle;
+        int horizontal_edge;
+        int vertical_edge;
+        int duration_short_ms;
+        float speed_slow_px_per_ms;
+        float speed_fling_px_per_ms = 0;    // Min speed to predict the direction, `0` disables the prediction
+        uint16_t fling_prediction_ms = 0;   // How far ahead the point a fling is heading to is predicted
+        uint16_t velocity_filter_ms = 16;   // Time constant of the velocity and acceleration filters
+    };
+
+    struct Sample {
+        int x;
+        int y;
+        bool pressed;
+        uint32_t time_ms;
+    };
+
+    struct Track {
+        uint8_t direction;
+        uint8_t start_area;
+        uint8_t stop_area;
+        int start_x;
+        int start_y;
+        int stop_x;
+        int stop_y;
+        uint32_t duration_ms;
+        float speed_px_per_ms;              // Average, from the start to the stop point
+        float distance_px;
+        float velocity_x_px_per_ms;         // Filtered, from the last samples
+        float velocity_y_px_per_ms;
+        float acceleration_x_px_per_ms2;
+        float acceleration_y_px_per_ms2;
+        struct {
+            uint8_t slow_speed: 1;
+            uint8_t short_duration: 1;
+            uint8_t fling: 1;               // The direction is predicted, not travelled yet
+        } flags;
+    };
+
+    GestureRecognizer() = default;
+
+    bool setConfig(const Config &config);
+    const Config &getConfig(void) const
+    {
+        return _config;
+    }
+
+    /**
+     * @brief Process a sample of the touch device
+     *
+     * @param[in] sample The sample, `pressed` is `false` once the touch is released (the point is then ignored)
+     *
+     * @return The event of the sample, `Event::NONE` if no gesture is in progress. The track is updated before.
+     */
+    Event feed(const Sample &sample);
+    void reset(void);
+
+    bool checkActive(void) const
+    {
+        return _is_active;
+    }
+    /**
+     * @brief Get the track of the current gesture, or of the last one once released
+     */
+    const Track &getTrack(void) const
+    {
+        return _track;
+    }
+
+    static constexpr Track TRACK_INIT = {
+        .direction = DIR_NONE,
+        .start_area = AREA_CENTER,
+        .stop_area = AREA_CENTER,
+        .start_x = -1,
+        .start_y = -1,
+        .stop_x = -1,
+        .stop_y = -1,
+        .duration_ms = 0,
+        .speed_px_per_ms = 0,
+        .distance_px = 0,
+        .velocity_x_px_per_ms = 0,
+        .velocity_y_px_per_ms = 0,
+        .acceleration_x_px_per_ms2 = 0,
+        .acceleration_y_px_per_ms2 = 0,
+        .flags = {
+            .slow_speed = 0,
+            .short_duration = 0,
+            .fling = 0,
+        },
+    };
+
+private:
+    uint8_t getArea(int x, int y) const;
+    void updateMotion(int x, int y, uint32_t time_ms);
+    uint8_t getDirection(float distance_x, float distance_y) const;
+    void updateDirection(void);
+
+    Config _config = {};
+    float _direction_tan_threshold = 0;
+    bool _is_active = false;
+    bool _has_velocity = false;
+    uint32_t _start_time_ms = 0;
+    uint32_t _last_time_ms = 0;
+    Track _track = TRACK_INIT;
+};
+
+} // namespace esp_brookesia::systems::phone
@@ -85,7 +85,7 @@ bool RecentsScreenSnapshot::begin(lv_obj_t *parent)
     lv_obj_add_style(title_icon.get(), _system_context.getDisplay().getCoreContainerStyle(), 0);
     // lv_obj_set_size(title_icon.get(), LV_SIZE_CONTENT, LV_SIZE_CONTENT);
     lv_image_set_inner_align(title_icon.get(), LV_IMAGE_ALIGN_CENTER);
-    lv_img_set_src(title_icon.get(), _conf.icon_image_resource);
+    lv_image_set_src(title_icon.get(), _conf.icon_image_resource);
     // Tile label
     lv_obj_add_style(title_label.get(), _system_context.getDisplay().getCoreContainerStyle(), 0);
     lv_label_set_text_static(title_label.get(), _conf.name);
@@ -138,6 +138,7 @@ bool RecentsScreenSnapshot::del(void)
     _title_label.reset();
     _snapshot_obj.reset();
     _snapshot_image.reset();
+    releaseTitleIcon();
 
     return true;
 }
@@ -168,13 +169,19 @@ bool RecentsScreenSnapshot::updateByNewData(void)
     // Title
     lv_obj_set_size(_title_obj.get(), _data.title.main_size.width, _data.title.main_size.height);
     lv_obj_set_style_pad_column(_title_obj.get(), _data.title.main_layout_column_pad, 0);
-    // Title icon
-    h_factor = (float)(_data.title.icon_size.height) / ((const lv_img_dsc_t *)_conf.icon_image_resource)->header.h;
-    w_factor = (float)(_data.title.icon_size.width) / ((const lv_img_dsc_t *)_conf.icon_image_resource)->header.w;
-    if (h_factor < w_factor) {
-        lv_image_set_scale(_title_icon.get(), (int)(h_factor * LV_SCALE_NONE));
+    // Title icon, shares the rendered icons with the app launcher
+    const lv_draw_buf_t *title_icon =
+        _system_context.getDisplay().getIconCache().acquire(_conf.icon_image_resource, _data.title.icon_size);
+    releaseTitleIcon();
+    if (title_icon != nullptr) {
+        lv_image_set_src(_title_icon.get(), title_icon);
+        lv_image_set_scale(_title_icon.get(), LV_SCALE_NONE);
+        _title_icon_cache_size = _data.title.icon_size;
     } else {
-        lv_image_set_scale(_title_icon.get(), (int)(w_factor * LV_SCALE_NONE));
+        lv_image_set_src(_title_icon.get(), _conf.icon_image_resource);
+        lv_image_set_scale(
+            _title_icon.get(), base::IconCache::calculateScale(_conf.icon_image_resource, _data.title.icon_size)
+        );
     }
     lv_obj_set_size(_title_icon.get(), _data.title.icon_size.width, _data.title.icon_size.height);
     lv_obj_refr_size(_title_icon.get());
@@ -201,9 +208,17 @@ bool RecentsScreenSnapshot::updateByNewData(void)
         lv_obj_center(_snapshot_image.get());
     }
     lv_obj_set_size(_snapshot_image.get(), _data.image.main_size.width, _data.image.main_size.height);
-    lv_img_set_src(_snapshot_image.get(), _conf.snapshot_image_resource);
+    lv_image_set_src(_snapshot_image.get(), _conf.snapshot_image_resource);
 
     return true;
 }
 
+void RecentsScreenSnapshot::releaseTitleIcon(void)
+{
+    if ((_title_icon_cache_size.width > 0) && (_title_icon_cache_size.height > 0)) {
+        _system_context.getDisplay().getIconCache().release(_conf.icon_image_resource, _title_icon_cache_size);
+    }
+    _title_icon_cache_size = {};
+}
+
 } // namespace esp_brookesia::systems::phone
@@ -69,11 +69,14 @@ public:
     bool updateByNewData(void);
 
 private:
+    void releaseTitleIcon(void);
+
     base::Context &_system_context;
     const Conf &_conf;
     const Data &_data;
 
     int _origin_y = 0;
+    gui::StyleSize _title_icon_cache_size = {};     // Size acquired from the icon cache, `0` if not cached
     ESP_Brookesia_LvObj_t _main_obj;
     ESP_Brookesia_LvObj_t _drag_obj;
     ESP_Brookesia_LvObj_t _title_obj;
@@ -329,25 +329,26 @@ bool StatusBar::updateMainByNewData(void)
     ESP_UTILS_LOGD("Update main(0x%p)", this);
     ESP_UTILS_CHECK_FALSE_RETURN(checkMainInitialized(), false, "Not initialized");
 
-    lv_obj_set_size(_main_obj.get(), _data.main.size.width, _data.main.size.height);
-    lv_obj_set_style_text_font(_main_obj.get(), (lv_font_t *)_data.main.text_font.font_resource, 0);
-    lv_obj_set_style_text_color(_main_obj.get(), lv_color_hex(_data.main.text_color.color), 0);
-    lv_obj_set_style_text_opa(_main_obj.get(), _data.main.text_color.opacity, 0);
-    lv_obj_set_style_bg_color(_main_obj.get(), lv_color_hex(_data.main.background_color.color), 0);
-    lv_obj_set_style_bg_opa(_main_obj.get(), _data.main.background_color.opacity, 0);
+    // Only the changed properties are set, the data update event is sent for any change of the stylesheet
+    updateLvObjSize(_main_obj.get(), _data.main.size.width, _data.main.size.height);
+    updateLvObjStylePtr(_main_obj.get(), LV_STYLE_TEXT_FONT, _data.main.text_font.font_resource);
+    updateLvObjStyleColor(_main_obj.get(), LV_STYLE_TEXT_COLOR, lv_color_hex(_data.main.text_color.color));
+    updateLvObjStyleNum(_main_obj.get(), LV_STYLE_TEXT_OPA, _data.main.text_color.opacity);
+    updateLvObjStyleColor(_main_obj.get(), LV_STYLE_BG_COLOR, lv_color_hex(_data.main.background_color.color));
+    updateLvObjStyleNum(_main_obj.get(), LV_STYLE_BG_OPA, _data.main.background_color.opacity);
 
     lv_flex_align_t main_align = LV_FLEX_ALIGN_START;
     for (size_t i = 0; i < _area_objs.size(); i++) {
-        lv_obj_set_size(_area_objs[i].get(), _data.area.data[i].size.width, _data.area.data[i].size.height);
-        lv_obj_set_style_pad_column(_area_objs[i].get(), _data.area.data[i].layout_column_pad, 0);
+        updateLvObjSize(_area_objs[i].get(), _data.area.data[i].size.width, _data.area.data[i].size.height);
+        updateLvObjStyleNum(_area_objs[i].get(), LV_STYLE_PAD_COLUMN, _data.area.data[i].layout_column_pad);
         switch (_data.area.data[i].layout_column_align) {
         case StatusBar::AreaAlign::START:
             main_align = LV_FLEX_ALIGN_START;
-            lv_obj_set_style_pad_left(_area_objs[i].get(), _data.area.data[i].layout_column_start_offset, 0);
+            updateLvObjStyleNum(_area_objs[i].get(), LV_STYLE_PAD_LEFT, _data.area.data[i].layout_column_start_offset);
             break;
         case StatusBar::AreaAlign::END:
             main_align = LV_FLEX_ALIGN_END;
-            lv_obj_set_style_pad_right(_area_objs[i].get(), _data.area.data[i].layout_column_start_offset, 0);
+            updateLvObjStyleNum(_area_objs[i].get(), LV_STYLE_PAD_RIGHT, _data.area.data[i].layout_column_start_offset);
             break;
         case StatusBar::AreaAlign::CENTER:
             main_align = LV_FLEX_ALIGN_CENTER;
@@ -356,7 +357,9 @@ bool StatusBar::updateMainByNewData(void)
             ESP_UTILS_CHECK_FALSE_RETURN(false, false, "Invalid layout align");
             break;
         }
-        lv_obj_set_flex_align(_area_objs[i].get(), main_align, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+        updateLvObjStyleNum(_area_objs[i].get(), LV_STYLE_FLEX_MAIN_PLACE, main_align);
+        updateLvObjStyleNum(_area_objs[i].get(), LV_STYLE_FLEX_CROSS_PLACE, LV_FLEX_ALIGN_CENTER);
+        updateLvObjStyleNum(_area_objs[i].get(), LV_STYLE_FLEX_TRACK_PLACE, LV_FLEX_ALIGN_CENTER);
     }
 
     return true;
@@ -395,7 +398,12 @@ bool StatusBar::beginBattery(void)
                                      "Add battery icon failed");
     }
 
-    ESP_UTILS_CHECK_FALSE_GOTO(setBatteryPercent(false, 100), err, "Set battery percent failed");
+    // The objects are new, they are updated even if the content is retained
+    _state.setBatteryPercent(false, 100);
+    ESP_UTILS_CHECK_FALSE_GOTO(
+        updateByState(StatusBarState::PART_BATTERY_LABEL | StatusBarState::PART_BATTERY_ICON), err,
+        "Update battery failed"
+    );
 
     _is_battery_initialed = true;
 
@@ -424,8 +432,8 @@ bool StatusBar::updateBatteryByNewData(void)
             lv_obj_add_flag(_battery_label.get(), LV_OBJ_FLAG_HIDDEN);
             ESP_UTILS_LOGE("Battery label out of area, hide it");
         } else {
-            lv_obj_set_style_text_color(_battery_label.get(), lv_color_hex(_data.main.text_color.color), 0);
-            lv_obj_set_style_text_opa(_battery_label.get(), _data.main.text_color.opacity, 0);
+            updateLvObjStyleColor(_battery_label.get(), LV_STYLE_TEXT_COLOR, lv_color_hex(_data.main.text_color.color));
+            updateLvObjStyleNum(_battery_label.get(), LV_STYLE_TEXT_OPA, _data.main.text_color.opacity);
         }
     }
 
@@ -454,18 +462,9 @@ bool StatusBar::setBatteryPercent(bool charge_flag, int percent) const
     ESP_UTILS_LOGD("Set battery percent(0x%p: %d%%)", this, percent);
 
     percent = max(min(percent, 100), 1);
-    if (_data.flags.enable_battery_label && (_battery_label != nullptr)) {
-        lv_label_set_text_fmt(_battery_label.get(), "%d%%", percent);
-    }
-
-    if (_data.flags.enable_battery_icon) {
-        if (charge_flag) {
-            _battery_state = 4;
-        } else {
-            _battery_state = (int)((percent - 1) / 25);
-        }
-        ESP_UTILS_CHECK_FALSE_RETURN(setIconState(_battery_id, _battery_state), false, "Set battery icon state failed");
-    }
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        updateByState(_state.setBatteryPercent(charge_flag, percent)), false, "Update battery failed"
+    );
 
     return true;
 }
@@ -493,7 +492,9 @@ bool StatusBar::hideBatteryPercent(void) const
 bool StatusBar::showBatteryIcon(void) const
 {
     ESP_UTILS_LOGD("Show battery icon(0x%p)", this);
-    ESP_UTILS_CHECK_FALSE_RETURN(setIconState(_battery_id, _battery_state), false, "Set battery icon state failed");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        setIconState(_battery_id, _state.getBatteryIconState()), false, "Set battery icon state failed"
+    );
 
     return true;
 }
@@ -587,8 +588,14 @@ bool StatusBar::beginClock(void)
     _clock_period_label = clock_period_label;
 
     ESP_UTILS_CHECK_FALSE_GOTO(updateClockByNewData(), err, "Update clock style failed");
-    ESP_UTILS_CHECK_FALSE_GOTO(setClockFormat(_clock_format), err, "Set clock format failed");
-    ESP_UTILS_CHECK_FALSE_GOTO(setClock(_clock_hour, _clock_min, false), err, "Set clock failed");
+    // The objects are new, they are updated even if the content is retained
+    _state.setClockFormat(_clock_format == ClockFormat::FORMAT_12H);
+    _state.setClock(_state.getClockHour(), _state.getClockMin(), _state.getClockHour() >= 12);
+    ESP_UTILS_CHECK_FALSE_GOTO(
+        updateByState(
+            StatusBarState::PART_CLOCK_HOUR | StatusBarState::PART_CLOCK_MIN | StatusBarState::PART_CLOCK_PERIOD
+        ), err, "Update clock failed"
+    );
 
     return true;
 
@@ -612,14 +619,13 @@ bool StatusBar::updateClockByNewData(void)
         lv_obj_add_flag(_clock_obj.get(), LV_OBJ_FLAG_HIDDEN);
         ESP_UTILS_LOGE("Clock out of area, hide it");
     } else {
-        lv_obj_set_style_text_color(_clock_hour_label.get(), lv_color_hex(_data.main.text_color.color), 0);
-        lv_obj_set_style_text_opa(_clock_hour_label.get(), _data.main.text_color.opacity, 0);
-        lv_obj_set_style_text_color(_clock_min_label.get(), lv_color_hex(_data.main.text_color.color), 0);
-        lv_obj_set_style_text_opa(_clock_min_label.get(), _data.main.text_color.opacity, 0);
-        lv_obj_set_style_text_color(_clock_dot_label.get(), lv_color_hex(_data.main.text_color.color), 0);
-        lv_obj_set_style_text_opa(_clock_dot_label.get(), _data.main.text_color.opacity, 0);
-        lv_obj_set_style_text_color(_clock_period_label.get(), lv_color_hex(_data.main.text_color.color), 0);
-        lv_obj_set_style_text_opa(_clock_period_label.get(), _data.main.text_color.opacity, 0);
+        lv_obj_t *labels[] = {
+            _clock_hour_label.get(), _clock_dot_label.get(), _clock_min_label.get(), _clock_period_label.get()
+        };
+        for (auto label : labels) {
+            updateLvObjStyleColor(label, LV_STYLE_TEXT_COLOR, lv_color_hex(_data.main.text_color.color));
+            updateLvObjStyleNum(label, LV_STYLE_TEXT_OPA, _data.main.text_color.opacity);
+        }
     }
 
     return true;
@@ -646,20 +652,15 @@ bool StatusBar::setClockFormat(ClockFormat format) const
 {
     ESP_UTILS_LOGD("Set clock format(%d)", static_cast<int>(format));
     ESP_UTILS_CHECK_NULL_RETURN(_clock_period_label, false, "Invalid clock period label");
-
-    switch (format) {
-    case ClockFormat::FORMAT_12H:
-        lv_obj_clear_flag(_clock_period_label.get(), LV_OBJ_FLAG_HIDDEN);
-        break;
-    case ClockFormat::FORMAT_24H:
-        lv_obj_add_flag(_clock_period_label.get(), LV_OBJ_FLAG_HIDDEN);
-        break;
-    default:
-        ESP_UTILS_CHECK_FALSE_RETURN(false, false, "Invalid clock format");
-        break;
-    }
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (format == ClockFormat::FORMAT_12H) || (format == ClockFormat::FORMAT_24H), false, "Invalid clock format"
+    );
 
     _clock_format = format;
+    // The hour is also displayed differently
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        updateByState(_state.setClockFormat(format == ClockFormat::FORMAT_12H)), false, "Update clock failed"
+    );
 
     return true;
 }
@@ -669,26 +670,8 @@ bool StatusBar::setClock(int hour, int minute, bool is_pm) const
     ESP_UTILS_LOGD("Set clock(%02d:%02d %s)", hour, minute, is_pm ? "PM" : "AM");
     ESP_UTILS_CHECK_NULL_RETURN(_clock_obj, false, "Invalid clock");
 
-    hour = max(min(hour, 23), 0);
-    minute = max(min(minute, 59), 0);
-
-    if (_clock_hour != hour) {
-        _clock_hour = hour;
-        if (_clock_format == ClockFormat::FORMAT_12H) {
-            hour = hour % 12;
-            if (hour == 0) {
-                hour = 12;
-            }
-        }
-        lv_label_set_text_fmt(_clock_hour_label.get(), "%02d", hour);
-    }
-    if (_clock_min != minute) {
-        _clock_min = minute;
-        lv_label_set_text_fmt(_clock_min_label.get(), "%02d", minute);
-    }
-    if (_clock_format == ClockFormat::FORMAT_12H) {
-        lv_label_set_text(_clock_period_label.get(), is_pm ? " PM " : " AM ");
-    }
+    // Usually set every second, only the changed labels are updated
+    ESP_UTILS_CHECK_FALSE_RETURN(updateByState(_state.setClock(hour, minute, is_pm)), false, "Update clock failed");
 
     return true;
 }
@@ -706,6 +689,45 @@ bool StatusBar::setClock(int hour, int minute) const
     return true;
 }
 
+bool StatusBar::updateByState(uint32_t parts) const
+{
+    if (parts == StatusBarState::PART_NONE) {
+        return true;
+    }
+
+    ESP_UTILS_LOGD("Update by state(0x%p: 0x%x)", this, static_cast<unsigned>(parts));
+
+    // Clock
+    if ((parts & StatusBarState::PART_CLOCK_HOUR) && (_clock_hour_label != nullptr)) {
+        updateLvLabelText(_clock_hour_label.get(), _state.getClockHourText());
+    }
+    if ((parts & StatusBarState::PART_CLOCK_MIN) && (_clock_min_label != nullptr)) {
+        updateLvLabelText(_clock_min_label.get(), _state.getClockMinText());
+    }
+    if ((parts & StatusBarState::PART_CLOCK_PERIOD) && (_clock_period_label != nullptr)) {
+        if (_state.checkClock12h()) {
+            updateLvLabelText(_clock_period_label.get(), _state.getClockPeriodText());
+            if (lv_obj_has_flag(_clock_period_label.get(), LV_OBJ_FLAG_HIDDEN)) {
+                lv_obj_clear_flag(_clock_period_label.get(), LV_OBJ_FLAG_HIDDEN);
+            }
+        } else if (!lv_obj_has_flag(_clock_period_label.get(), LV_OBJ_FLAG_HIDDEN)) {
+            lv_obj_add_flag(_clock_period_label.get(), LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+    // Battery
+    if ((parts & StatusBarState::PART_BATTERY_LABEL) && _data.flags.enable_battery_label &&
+            (_battery_label != nullptr)) {
+        updateLvLabelText(_battery_label.get(), _state.getBatteryLabelText());
+    }
+    if ((parts & StatusBarState::PART_BATTERY_ICON) && _data.flags.enable_battery_icon) {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            setIconState(_battery_id, _state.getBatteryIconState()), false, "Set battery icon state failed"
+        );
+    }
+
+    return true;
+}
+
 void StatusBar::onDataUpdateEventCallback(lv_event_t *event)
 {
     StatusBar *status_bar = nullptr;
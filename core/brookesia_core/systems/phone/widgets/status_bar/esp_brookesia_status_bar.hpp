@@ -12,6 +12,7 @@
 #include "systems/base/esp_brookesia_base_context.hpp"
 #include "lvgl/esp_brookesia_lv_helper.hpp"
 #include "esp_brookesia_status_bar_icon.hpp"
+#include "esp_brookesia_status_bar_state.hpp"
 
 namespace esp_brookesia::systems::phone {
 
@@ -139,6 +140,8 @@ private:
 
     bool beginWifi(void);
 
+    bool updateByState(uint32_t parts) const;
+
     bool beginClock(void);
     bool updateClockByNewData(void);
     bool delClock(void);
@@ -160,14 +163,11 @@ private:
     // Battery
     int _battery_id = -1;
     bool _is_battery_initialed = false;
-    mutable int _battery_state = -1;
     bool _is_battery_lable_out_of_area = false;
     ESP_Brookesia_LvObj_t _battery_label;
     // Wifi
     int _wifi_id = -1;
     // Clock
-    mutable int _clock_hour = -1;
-    mutable int _clock_min = -1;
     mutable ClockFormat _clock_format = ClockFormat::FORMAT_24H;
     bool _is_clock_out_of_area = false;
     ESP_Brookesia_LvObj_t _clock_obj;
@@ -175,6 +175,8 @@ private:
     ESP_Brookesia_LvObj_t _clock_dot_label;
     ESP_Brookesia_LvObj_t _clock_min_label;
     ESP_Brookesia_LvObj_t _clock_period_label;
+    // Retained content, only the changed parts are updated
+    mutable StatusBarState _state;
 };
 
 } // namespace esp_brookesia::systems::phone
@@ -142,8 +142,8 @@ bool StatusBarIcon::updateByNewData(void)
     ESP_UTILS_LOGD("Update(0x%p)", this);
     ESP_UTILS_CHECK_FALSE_RETURN(checkInitialized(), false, "Icon is not initialized");
 
-    // Update main object style
-    lv_obj_set_size(main_obj.get(), _data.size.width, _data.size.height);
+    // Update main object style, only the changed properties are set
+    updateLvObjSize(main_obj.get(), _data.size.width, _data.size.height);
     if (_is_out_of_parent && _current_state >= 0) {
         _is_out_of_parent = false;
         lv_obj_clear_flag(main_obj.get(), LV_OBJ_FLAG_HIDDEN);
@@ -156,22 +156,29 @@ bool StatusBarIcon::updateByNewData(void)
 
     // Update the size of the image object
     for (int i = 0; i < image_resource_num; i++) {
+        bool is_changed = false;
         img_dsc = (const lv_img_dsc_t *)_data.icon.images[i].resource;
         image_obj = _image_objs[i];
-        lv_img_set_src(image_obj.get(), img_dsc);
-        lv_obj_set_style_img_recolor(image_obj.get(), lv_color_hex(_data.icon.images[i].recolor.color), 0);
-        lv_obj_set_style_img_recolor_opa(image_obj.get(), _data.icon.images[i].recolor.opacity, 0);
+        is_changed |= updateLvImageSrc(image_obj.get(), img_dsc);
+        is_changed |= updateLvObjStyleColor(
+                          image_obj.get(), LV_STYLE_IMAGE_RECOLOR, lv_color_hex(_data.icon.images[i].recolor.color)
+                      );
+        is_changed |= updateLvObjStyleNum(
+                          image_obj.get(), LV_STYLE_IMAGE_RECOLOR_OPA, _data.icon.images[i].recolor.opacity
+                      );
         // Calculate the multiple of the size between the target and the image.
         h_factor = (float)(_data.size.height) / img_dsc->header.h;
         w_factor = (float)(_data.size.width) / img_dsc->header.w;
         // Scale the image to a suitable size.
         // So you don’t have to consider the size of the source image.
         if (h_factor < w_factor) {
-            lv_image_set_scale(image_obj.get(), (int)(h_factor * LV_SCALE_NONE));
+            is_changed |= updateLvImageScale(image_obj.get(), (int)(h_factor * LV_SCALE_NONE));
         } else {
-            lv_image_set_scale(image_obj.get(), (int)(w_factor * LV_SCALE_NONE));
+            is_changed |= updateLvImageScale(image_obj.get(), (int)(w_factor * LV_SCALE_NONE));
+        }
+        if (is_changed) {
+            lv_obj_refr_size(image_obj.get());
         }
-        lv_obj_refr_size(image_obj.get());
     }
 
     return true;
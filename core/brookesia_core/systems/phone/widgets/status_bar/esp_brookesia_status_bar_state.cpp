@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include "esp_brookesia_status_bar_state.hpp"
+
+using namespace std;
+
+namespace esp_brookesia::systems::phone {
+
+void StatusBarState::reset(void)
+{
+    _is_clock_pm = false;
+    _is_clock_period_known = false;
+    _clock_hour = -1;
+    _clock_min = -1;
+    _battery_percent = -1;
+    _battery_icon_state = -1;
+    _clock_hour_text[0] = '\0';
+    _clock_min_text[0] = '\0';
+    _battery_label_text[0] = '\0';
+}
+
+uint32_t StatusBarState::setClockFormat(bool is_12h)
+{
+    if (is_12h == _is_clock_12h) {
+        return PART_NONE;
+    }
+    _is_clock_12h = is_12h;
+
+    // The period is shown or hidden, and the hour may be displayed differently
+    uint32_t parts = PART_CLOCK_PERIOD;
+    if ((_clock_hour >= 0) && updateClockHourText()) {
+        parts |= PART_CLOCK_HOUR;
+    }
+
+    return parts;
+}
+
+uint32_t StatusBarState::setClock(int hour, int minute, bool is_pm)
+{
+    uint32_t parts = PART_NONE;
+
+    hour = max(min(hour, 23), 0);
+    minute = max(min(minute, 59), 0);
+
+    if (hour != _clock_hour) {
+        _clock_hour = hour;
+        if (updateClockHourText()) {
+            parts |= PART_CLOCK_HOUR;
+        }
+    }
+    if (minute != _clock_min) {
+        _clock_min = minute;
+        snprintf(_clock_min_text, sizeof(_clock_min_text), "%02d", minute);
+        parts |= PART_CLOCK_MIN;
+    }
+    if (!_is_clock_period_known || (is_pm != _is_clock_pm)) {
+        _is_clock_period_known = true;
+        _is_clock_pm = is_pm;
+        parts |= PART_CLOCK_PERIOD;
+    }
+
+    return parts;
+}
+
+uint32_t StatusBarState::setBatteryPercent(bool charge_flag, int percent)
+{
+    uint32_t parts = PART_NONE;
+
+    if (percent != _battery_percent) {
+        _battery_percent = percent;
+        snprintf(_battery_label_text, sizeof(_battery_label_text), "%d%%", percent);
+        parts |= PART_BATTERY_LABEL;
+    }
+
+    int icon_state = charge_flag ? BATTERY_ICON_STATE_CHARGING : ((percent - 1) / 25);
+    if (icon_state != _battery_icon_state) {
+        _battery_icon_state = icon_state;
+        parts |= PART_BATTERY_ICON;
+    }
+
+    return parts;
+}
+
+bool StatusBarState::updateClockHourText(void)
+{
+    int hour = _clock_hour;
+    if (_is_clock_12h) {
+        hour = hour % 12;
+        if (hour == 0) {
+            hour = 12;
+        }
+    }
+
+    char text[sizeof(_clock_hour_text)] = {};
+    // The hour is already clamped to [0, 23], the narrowing only lets the compiler see that it fits in the buffer
+    snprintf(text, sizeof(text), "%02u", static_cast<unsigned>(static_cast<uint8_t>(hour)));
+    if (strcmp(text, _clock_hour_text) == 0) {
+        return false;
+    }
+    memcpy(_clock_hour_text, text, sizeof(text));
+
+    return true;
+}
+
+} // namespace esp_brookesia::systems::phone
@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace esp_brookesia::systems::phone {
+
+/**
+ * @brief Retained content of the status bar: the clock, the battery label and icon.
+ *
+ * The setters return the parts whose content changed, only their objects need to be updated (and redrawn). The
+ * clock is usually set every second and the battery on every reading, while they change once a minute or less.
+ *
+ * @note It doesn't depend on LVGL, so the updates of an idle UI can be measured on the host.
+ */
+class StatusBarState {
+public:
+    enum Part : uint32_t {
+        PART_NONE          = 0,
+        PART_CLOCK_HOUR    = (1 << 0),
+        PART_CLOCK_MIN     = (1 << 1),
+        PART_CLOCK_PERIOD  = (1 << 2),  // Text and visibility of the AM/PM label
+        PART_BATTERY_LABEL = (1 << 3),
+        PART_BATTERY_ICON  = (1 << 4),
+        PART_ALL           = (1 << 5) - 1,
+    };
+
+    static constexpr int BATTERY_ICON_STATE_CHARGING = 4;
+
+    StatusBarState()
+    {
+        reset();
+    }
+
+    /**
+     * @brief Forget the retained content, the next setters report all their parts as changed
+     */
+    void reset(void);
+
+    uint32_t setClockFormat(bool is_12h);
+    uint32_t setClock(int hour, int minute, bool is_pm);
+    uint32_t setBatteryPercent(bool charge_flag, int percent);
+
+    bool checkClock12h(void) const
+    {
+        return _is_clock_12h;
+    }
+    int getClockHour(void) const
+    {
+        return _clock_hour;
+    }
+    int getClockMin(void) const
+    {
+        return _clock_min;
+    }
+    const char *getClockHourText(void) const
+    {
+        return _clock_hour_text;
+    }
+    const char *getClockMinText(void) const
+    {
+        return _clock_min_text;
+    }
+    const char *getClockPeriodText(void) const
+    {
+        return _is_clock_pm ? " PM " : " AM ";
+    }
+    const char *getBatteryLabelText(void) const
+    {
+        return _battery_label_text;
+    }
+    int getBatteryIconState(void) const
+    {
+        return _battery_icon_state;
+    }
+
+private:
+    bool updateClockHourText(void);
+
+    bool _is_clock_12h = false;
+    bool _is_clock_pm = false;
+    bool _is_clock_period_known = false;
+    int _clock_hour = -1;
+    int _clock_min = -1;
+    int _battery_percent = -1;
+    int _battery_icon_state = -1;
+    char _clock_hour_text[4] = {};
+    char _clock_min_text[4] = {};
+    char _battery_label_text[8] = {};
+};
+
+} // namespace esp_brookesia::systems::phone
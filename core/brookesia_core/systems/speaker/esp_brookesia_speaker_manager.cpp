@@ -130,7 +130,7 @@ bool Manager::begin(void)
         );
     });
     // Process quick settings storage service event signal
-    StorageNVS::requestInstance().connectEventSignal([this](const StorageNVS::Event & event) {
+    _storage_service_connection = StorageNVS::requestInstance().connectEventSignal([this](const StorageNVS::Event & event) {
         if ((event.operation != StorageNVS::Operation::UpdateNVS) || (event.sender == &display.getQuickSettings())) {
             ESP_UTILS_LOGD("Ignore event: operation(%d), sender(%p)", static_cast<int>(event.operation), event.sender);
             return;
@@ -382,6 +382,10 @@ bool Manager::del(void)
         goto end;
     }
 
+    // Stop the storage service from posting UI commands, then drop the pending ones
+    _storage_service_connection.disconnect();
+    LvCommandQueue::getInstance().cancel(this);
+
     _gesture.reset();
     _draw_dummy_timer.reset();
     _quick_settings_update_clock_timer.reset();
@@ -787,30 +791,44 @@ bool Manager::processQuickSettingsStorageServiceEventSignal(std::string key)
         StorageNVS::requestInstance().getLocalParam(key, value), false, "Get local param failed"
     );
 
-    LvLockGuard gui_guard;
+    StorageCommandTag tag = StorageCommandTag::WLAN_SWITCH;
     if (key == SETTINGS_WLAN_SWITCH) {
-        auto wifi_button = display.getQuickSettings().getWifiButton();
-        ESP_UTILS_CHECK_NULL_RETURN(wifi_button, false, "Invalid wifi button");
-
-        ESP_UTILS_CHECK_FALSE_RETURN(std::holds_alternative<int>(value), false, "Invalid value");
-
-        auto is_checked = std::get<int>(value);
-        if (is_checked) {
-            lv_obj_add_state(wifi_button->getNativeHandle(), LV_STATE_CHECKED);
-        } else {
-            lv_obj_remove_state(wifi_button->getNativeHandle(), LV_STATE_CHECKED);
-        }
+        tag = StorageCommandTag::WLAN_SWITCH;
     } else if (key == SETTINGS_VOLUME) {
-        ESP_UTILS_CHECK_FALSE_RETURN(std::holds_alternative<int>(value), false, "Invalid value");
-
-        auto percent = std::get<int>(value);
-        ESP_UTILS_CHECK_FALSE_RETURN(display.getQuickSettings().setVolume(percent), false, "Set volume failed");
+        tag = StorageCommandTag::VOLUME;
     } else if (key == SETTINGS_BRIGHTNESS) {
-        ESP_UTILS_CHECK_FALSE_RETURN(std::holds_alternative<int>(value), false, "Invalid value");
-
-        auto percent = std::get<int>(value);
-        ESP_UTILS_CHECK_FALSE_RETURN(display.getQuickSettings().setBrightness(percent), false, "Set brightness failed");
+        tag = StorageCommandTag::BRIGHTNESS;
+    } else {
+        return true;
     }
+    ESP_UTILS_CHECK_FALSE_RETURN(std::holds_alternative<int>(value), false, "Invalid value");
+
+    // Update the widgets in the LVGL task instead of locking it, only the latest value of each key is applied
+    int value_int = std::get<int>(value);
+    ESP_UTILS_CHECK_FALSE_RETURN(
+    LvCommandQueue::getInstance().post(this, static_cast<uint32_t>(tag), [this, tag, value_int]() {
+        auto &quick_settings = display.getQuickSettings();
+        switch (tag) {
+        case StorageCommandTag::WLAN_SWITCH: {
+            auto wifi_button = quick_settings.getWifiButton();
+            ESP_UTILS_CHECK_NULL_EXIT(wifi_button, "Invalid wifi button");
+
+            if (value_int) {
+                lv_obj_add_state(wifi_button->getNativeHandle(), LV_STATE_CHECKED);
+            } else {
+                lv_obj_remove_state(wifi_button->getNativeHandle(), LV_STATE_CHECKED);
+            }
+            break;
+        }
+        case StorageCommandTag::VOLUME:
+            ESP_UTILS_CHECK_FALSE_EXIT(quick_settings.setVolume(value_int), "Set volume failed");
+            break;
+        case StorageCommandTag::BRIGHTNESS:
+            ESP_UTILS_CHECK_FALSE_EXIT(quick_settings.setBrightness(value_int), "Set brightness failed");
+            break;
+        }
+    }), false, "Post quick settings update failed"
+    );
 
     return true;
 }
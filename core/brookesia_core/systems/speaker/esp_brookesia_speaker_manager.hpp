@@ -9,6 +9,7 @@
 #include <string>
 #include <unordered_map>
 #include "lvgl.h"
+#include "boost/signals2.hpp"
 #include "esp_brookesia_systems_internal.h"
 #include "systems/base/esp_brookesia_base_context.hpp"
 #include "widgets/gesture/esp_brookesia_gesture.hpp"
@@ -114,6 +115,13 @@ private:
         return _display_active_screen;
     }
 
+    // Keys of the UI commands posted by the storage service
+    enum class StorageCommandTag : uint32_t {
+        WLAN_SWITCH,
+        VOLUME,
+        BRIGHTNESS,
+    };
+
     // Flags
     struct {
         // Main
@@ -141,6 +149,8 @@ private:
     Screen _display_active_screen = Screen::MAX;
     // Gesture
     std::unique_ptr<Gesture> _gesture;
+    // Storage service
+    boost::signals2::scoped_connection _storage_service_connection;
     // Timer
     gui::LvTimerUniquePtr _draw_dummy_timer;
     gui::LvTimerUniquePtr _quick_settings_update_clock_timer;
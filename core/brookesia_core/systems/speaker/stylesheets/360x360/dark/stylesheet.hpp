@@ -137,6 +137,8 @@ constexpr AI_Buddy::Data STYLESHEET_360_360_DARK_AI_BUDDY_DATA = {
                     },
                     .flags = {
                         .enable_data_swap_bytes = true,
+                        .enable_pipeline = true,
+                        .enable_dirty_rect = true,
                     },
                 },
             },
@@ -202,6 +204,8 @@ constexpr AI_Buddy::Data STYLESHEET_360_360_DARK_AI_BUDDY_DATA = {
                     },
                     .flags = {
                         .enable_data_swap_bytes = true,
+                        .enable_pipeline = true,
+                        .enable_dirty_rect = true,
                     },
                 },
             },
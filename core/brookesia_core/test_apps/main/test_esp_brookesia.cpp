@@ -93,8 +93,123 @@ TEST_CASE("test esp-brookesia to add stylesheet", "[esp-brookesia][phone][add_st
     test_esp_brookesia_phone_deinit(phone);
     test_lvgl_deinit(disp, tp);
 }
+
+TEST_CASE("test esp-brookesia to add built-in stylesheets", "[esp-brookesia][phone][add_builtin_stylesheets]")
+{
+    lv_display_t *disp = nullptr;
+    lv_indev_t *tp = nullptr;
+    systems::phone::Phone *phone = nullptr;
+
+    test_lvgl_init(&disp, &tp);
+    phone = test_esp_brookesia_phone_init(disp, tp, false);
+
+    TEST_ASSERT_TRUE_MESSAGE(phone->addBuiltinStylesheets(), "Failed to add built-in stylesheets");
+    TEST_ASSERT_TRUE_MESSAGE(phone->begin(), "Failed to begin phone");
+    // Only the stylesheet of the display resolution is activated
+    TEST_ASSERT_EQUAL_STRING(TEST_ESP_BROOKESIA_PHONE_DARK_STYLESHEET().core.name, phone->getStylesheet()->core.name);
+
+    test_esp_brookesia_phone_deinit(phone);
+    test_lvgl_deinit(disp, tp);
+}
 #endif
 
+class TestRetainApp: public systems::phone::App {
+public:
+    TestRetainApp():
+        App(getCoreConfig(), Config::SIMPLE_CONSTRUCTOR(nullptr, true, false))
+    {
+    }
+
+    bool run(void) override
+    {
+        run_count++;
+        for (int i = 0; i < 20; i++) {
+            lv_obj_t *label = lv_label_create(lv_screen_active());
+            lv_label_set_text_fmt(label, "Retained label %d", i);
+        }
+        return true;
+    }
+
+    bool back(void) override
+    {
+        return notifyCoreClosed();
+    }
+
+    bool close(void) override
+    {
+        close_count++;
+        return true;
+    }
+
+    int run_count = 0;
+    int close_count = 0;
+
+private:
+    static systems::base::App::Config getCoreConfig(void)
+    {
+        auto config = systems::base::App::Config::SIMPLE_CONSTRUCTOR("Retain", nullptr, true);
+        config.flags.enable_retain_screen = 1;
+        return config;
+    }
+};
+
+TEST_CASE("test esp-brookesia to retain APPs", "[esp-brookesia][phone][retain_app]")
+{
+    lv_display_t *disp = nullptr;
+    lv_indev_t *tp = nullptr;
+    systems::phone::Phone *phone = nullptr;
+    TestRetainApp *app = nullptr;
+
+    test_lvgl_init(&disp, &tp);
+    phone = test_esp_brookesia_phone_init(disp, tp, true);
+    auto &manager = phone->getManager();
+
+    app = new TestRetainApp();
+    TEST_ASSERT_NOT_NULL_MESSAGE(app, "Failed to create retain app");
+    int app_id = phone->installApp(app);
+    TEST_ASSERT_TRUE_MESSAGE(app_id >= 0, "Failed to install retain app");
+
+    systems::base::Context::AppEventData start_event = {
+        .id = app_id,
+        .type = systems::base::Context::AppEventType::START,
+        .data = nullptr,
+    };
+
+    ESP_LOGI(TAG, "Start the app cold, then close it from the app");
+    TEST_ASSERT_TRUE_MESSAGE(phone->sendAppEvent(&start_event), "Failed to start app");
+    TEST_ASSERT_EQUAL(1, app->run_count);
+    TEST_ASSERT_TRUE_MESSAGE(app->back(), "Failed to close app");
+    TEST_ASSERT_TRUE_MESSAGE(manager.checkAppRetained(app_id), "App is not retained");
+    TEST_ASSERT_EQUAL(0, app->close_count);
+    TEST_ASSERT_NULL(manager.getRunningAppById(app_id));
+    // The memory taken by `run()` is measured for the retain budget
+    TEST_ASSERT_GREATER_THAN(0, manager.getRetainedMemorySize());
+
+    ESP_LOGI(TAG, "Start the retained app hot");
+    TEST_ASSERT_TRUE_MESSAGE(phone->sendAppEvent(&start_event), "Failed to start app");
+    TEST_ASSERT_EQUAL(1, app->run_count);
+    TEST_ASSERT_FALSE(manager.checkAppRetained(app_id));
+    TEST_ASSERT_NOT_NULL(manager.getRunningAppById(app_id));
+
+    auto stats = manager.getAppLaunchStats(app_id);
+    TEST_ASSERT_EQUAL(1, stats.cold_num);
+    TEST_ASSERT_EQUAL(1, stats.hot_num);
+    ESP_LOGI(
+        TAG, "Launch time: cold(%d us), hot(%d us)", static_cast<int>(stats.last_cold_time_us),
+        static_cast<int>(stats.last_hot_time_us)
+    );
+
+    ESP_LOGI(TAG, "Retain the app again, then uninstall it which closes it");
+    TEST_ASSERT_TRUE_MESSAGE(app->back(), "Failed to close app");
+    TEST_ASSERT_TRUE_MESSAGE(manager.checkAppRetained(app_id), "App is not retained");
+    TEST_ASSERT_TRUE_MESSAGE(phone->uninstallApp(app_id), "Failed to uninstall app");
+    TEST_ASSERT_EQUAL(1, app->close_count);
+    delete app;
+
+    test_esp_brookesia_phone_deinit(phone);
+    test_lvgl_deinit(disp, tp);
+}
+
 // TEST_CASE("test esp-brookesia to install and uninstall APPs", "[esp-brookesia][phone][install_uninstall_app]")
 // {
 //     lv_display_t *disp = nullptr;
@@ -0,0 +1,317 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <atomic>
+#include <string_view>
+#include "boost/asio.hpp"
+#include "coze_token_cache.hpp"
+#include "benchmark.hpp"
+
+using namespace esp_brookesia::ai_framework;
+using boost::asio::ip::tcp;
+
+namespace esp_brookesia::benchmark {
+
+// Reconnects of the disconnect storm, and the tasks reconnecting at the same time after the token is dropped
+constexpr size_t TOKEN_STORM_RECONNECTS = 2000;
+constexpr size_t TOKEN_STORM_THREADS = 8;
+constexpr size_t TOKEN_UNCACHED_ITERATIONS = 200;
+
+/**
+ * @brief Stand-in of the Coze token endpoint on the loopback, counting the token requests
+ *
+ * Answers each POST with a new token named after the request count, valid `token_lifetime` seconds.
+ */
+class TokenServer {
+public:
+    TokenServer()
+        : acceptor_(io_context_, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0))
+    {
+        thread_ = std::thread([this]() {
+            serve();
+        });
+    }
+
+    ~TokenServer()
+    {
+        is_stopping_ = true;
+        // Unblock the accept
+        boost::system::error_code ec;
+        tcp::socket socket(io_context_);
+        socket.connect(acceptor_.local_endpoint(), ec);
+        thread_.join();
+    }
+
+    unsigned short get_port() const
+    {
+        return acceptor_.local_endpoint().port();
+    }
+
+    size_t get_request_count() const
+    {
+        return request_count_;
+    }
+
+    std::atomic<int> token_lifetime{86399};
+
+private:
+    void serve()
+    {
+        while (true) {
+            tcp::socket socket(io_context_);
+            boost::system::error_code ec;
+            acceptor_.accept(socket, ec);
+            if (is_stopping_) {
+                return;
+            }
+            if (ec) {
+                continue;
+            }
+
+            boost::asio::streambuf buffer;
+            auto header_size = boost::asio::read_until(socket, buffer, "\r\n\r\n", ec);
+            if (ec) {
+                continue;
+            }
+            std::string request(
+                boost::asio::buffers_begin(buffer.data()), boost::asio::buffers_begin(buffer.data()) + header_size
+            );
+            size_t content_length = 0;
+            auto length_pos = request.find("Content-Length: ");
+            if (length_pos != std::string::npos) {
+                content_length = std::stoul(request.substr(length_pos + 16));
+            }
+            if (buffer.size() - header_size < content_length) {
+                boost::asio::read(
+                    socket, buffer, boost::asio::transfer_exactly(content_length - (buffer.size() - header_size)), ec
+                );
+            }
+
+            auto count = ++request_count_;
+            std::string body = "{\"access_token\":\"token_" + std::to_string(count) + "\",\"expires_in\":" +
+                               std::to_string(token_lifetime.load()) + "}";
+            std::string response = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: " +
+                                   std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+            boost::asio::write(socket, boost::asio::buffer(response), ec);
+        }
+    }
+
+    boost::asio::io_context io_context_;
+    tcp::acceptor acceptor_;
+    std::thread thread_;
+    std::atomic<bool> is_stopping_ = false;
+    std::atomic<size_t> request_count_ = 0;
+};
+
+// Same request as `coze_fetch_access_token()` of the Coze chat app, without the JWT
+static std::optional<CozeTokenCache::Token> fetch_token(unsigned short port)
+{
+    boost::asio::io_context io_context;
+    tcp::socket socket(io_context);
+    boost::system::error_code ec;
+    socket.connect(tcp::endpoint(boost::asio::ip::address_v4::loopback(), port), ec);
+    if (ec) {
+        return std::nullopt;
+    }
+
+    std::string body = "{\"duration_seconds\":86399,\"grant_type\":\"urn:ietf:params:oauth:grant-type:jwt-bearer\"}";
+    std::string request = "POST /api/permission/oauth2/token HTTP/1.1\r\nHost: 127.0.0.1\r\n"
+                          "Content-Type: application/json\r\nContent-Length: " + std::to_string(body.size()) +
+                          "\r\n\r\n" + body;
+    boost::asio::write(socket, boost::asio::buffer(request), ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    std::string response;
+    boost::asio::read(socket, boost::asio::dynamic_buffer(response), ec);
+    if (ec && (ec != boost::asio::error::eof)) {
+        return std::nullopt;
+    }
+
+    auto token_pos = response.find("\"access_token\":\"");
+    auto expires_pos = response.find("\"expires_in\":");
+    if ((token_pos == std::string::npos) || (expires_pos == std::string::npos)) {
+        return std::nullopt;
+    }
+    token_pos += 16;
+    auto token_end = response.find('"', token_pos);
+    if (token_end == std::string::npos) {
+        return std::nullopt;
+    }
+
+    return CozeTokenCache::Token{
+        .access_token = response.substr(token_pos, token_end - token_pos),
+        .expires_at = CozeTokenCache::Clock::now() + std::chrono::seconds(std::stol(response.substr(expires_pos + 13))),
+    };
+}
+
+// A reconnect signing and requesting a token each time, as before the cache
+static void run_uncached_case(Runner &runner, TokenServer &server)
+{
+    runner.run("coze_token.reconnect_uncached", TOKEN_UNCACHED_ITERATIONS, [&](size_t) {
+        fetch_token(server.get_port());
+    });
+}
+
+// Disconnect storm: the reconnects only request the first token, also when several tasks reconnect at once
+static void run_storm_case(Runner &runner, TokenServer &server)
+{
+    const std::string name = "coze_token.reconnect_cached";
+    if (!runner.is_selected(name)) {
+        return;
+    }
+
+    CozeTokenCache cache;
+    bool is_begun = cache.begin({}, [&]() {
+        return fetch_token(server.get_port());
+    });
+    if (!is_begun) {
+        runner.add_failure(name, "Failed to begin the cache");
+        return;
+    }
+
+    auto request_count = server.get_request_count();
+    size_t failure_count = 0;
+    runner.run(name, TOKEN_STORM_RECONNECTS, [&](size_t) {
+        if (!cache.getToken().has_value()) {
+            failure_count++;
+        }
+    });
+    if ((failure_count > 0) || (server.get_request_count() - request_count != 1)) {
+        runner.add_failure(
+            name, std::to_string(server.get_request_count() - request_count) + " token requests for the storm"
+        );
+        return;
+    }
+
+    // The token is rejected, and all the tasks reconnect at once: their fetches are merged into one
+    cache.invalidate();
+    request_count = server.get_request_count();
+    std::atomic<size_t> ready_count = 0;
+    std::atomic<size_t> got_count = 0;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < TOKEN_STORM_THREADS; i++) {
+        threads.emplace_back([&]() {
+            ready_count++;
+            wait_until([&]() {
+                return ready_count == TOKEN_STORM_THREADS;
+            });
+            if (cache.getToken().has_value()) {
+                got_count++;
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    if ((got_count != TOKEN_STORM_THREADS) || (server.get_request_count() - request_count != 1)) {
+        runner.add_failure(
+            name, std::to_string(server.get_request_count() - request_count) + " token requests for " +
+            std::to_string(TOKEN_STORM_THREADS) + " concurrent reconnects"
+        );
+    }
+}
+
+// A short-lived token is replaced in the background before it expires, and the replacement is persisted
+static void run_refresh_case(Runner &runner, TokenServer &server)
+{
+    const std::string name = "coze_token.background_refresh";
+    if (!runner.is_selected(name)) {
+        return;
+    }
+
+    server.token_lifetime = 2;
+    std::optional<CozeTokenCache::Token> stored_token;
+    std::mutex stored_mutex;
+    auto store = [&](const CozeTokenCache::Token &token) {
+        std::lock_guard lock(stored_mutex);
+        stored_token = token;
+    };
+    CozeTokenCache cache;
+    bool is_begun = cache.begin({
+        .refresh_margin = std::chrono::seconds(1),
+        .min_remaining = std::chrono::seconds(0),
+    }, [&]() {
+        return fetch_token(server.get_port());
+    }, nullptr, store);
+    if (!is_begun) {
+        server.token_lifetime = 86399;
+        runner.add_failure(name, "Failed to begin the cache");
+        return;
+    }
+
+    auto first_token = cache.getToken();
+    // The replacement is a regular token
+    server.token_lifetime = 86399;
+    auto start = Clock::now();
+    bool is_refreshed = wait_until([&]() {
+        return cache.getStatistics().background_fetch_count > 0;
+    }, std::chrono::milliseconds(3000));
+    auto refresh_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    auto second_token = cache.getToken();
+    auto statistics = cache.getStatistics();
+    cache.end();
+    if (!is_refreshed || !first_token.has_value() || !second_token.has_value() || (first_token == second_token)) {
+        runner.add_failure(name, "Token not refreshed in the background");
+        return;
+    }
+    if (statistics.fetch_count != 2) {
+        runner.add_failure(name, std::to_string(statistics.fetch_count) + " token requests instead of 2");
+        return;
+    }
+
+    // After a reboot, the persisted token is used without any request
+    auto request_count = server.get_request_count();
+    is_begun = cache.begin({}, [&]() {
+        return fetch_token(server.get_port());
+    }, [&]() {
+        std::lock_guard lock(stored_mutex);
+        return stored_token;
+    });
+    auto loaded_token = cache.getToken();
+    if (!is_begun || (loaded_token != second_token) || (server.get_request_count() != request_count)) {
+        runner.add_failure(name, "Persisted token not used");
+        return;
+    }
+    cache.end();
+
+    // Before the clock is set, the persisted token is stale and the tokens are fetched on each connect, then cached
+    std::atomic<bool> is_clock_synced = false;
+    request_count = server.get_request_count();
+    is_begun = cache.begin({
+        .is_clock_synced = [&]() {
+            return is_clock_synced.load();
+        },
+    }, [&]() {
+        return fetch_token(server.get_port());
+    }, [&]() {
+        std::lock_guard lock(stored_mutex);
+        return stored_token;
+    });
+    bool is_fetched = is_begun && cache.getToken().has_value() && cache.getToken().has_value();
+    is_clock_synced = true;
+    bool is_cached = cache.getToken().has_value() && cache.getToken().has_value();
+    cache.end();
+    if (!is_fetched || !is_cached || (server.get_request_count() - request_count != 2)) {
+        runner.add_failure(
+            name, std::to_string(server.get_request_count() - request_count) +
+            " token requests instead of 2 around the clock sync"
+        );
+        return;
+    }
+
+    // Time from the first token to its background replacement, the refresh time is 1 s before it expires
+    runner.add_latency_samples(name, {refresh_ns});
+}
+
+void run_coze_token_cases(Runner &runner)
+{
+    TokenServer server;
+    run_uncached_case(runner, server);
+    run_storm_case(runner, server);
+    run_refresh_case(runner, server);
+}
+
+} // namespace esp_brookesia::benchmark
@@ -0,0 +1,191 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include "audio_uplink_encoder.hpp"
+#include "benchmark.hpp"
+
+using namespace esp_brookesia::ai_framework;
+
+namespace esp_brookesia::benchmark {
+
+// Same as `AUDIO_RECORDER_READ_SIZE` of the Coze chat app, 128 ms of G.711 A-law at 8 kHz
+constexpr size_t UPLINK_FRAME_SIZE = 1024;
+constexpr size_t UPLINK_SAMPLE_RATE = 8000;
+constexpr size_t UPLINK_RECORD_SECONDS = 10;
+// Sends slower than this are congested, and the link of the stream case is that slow for a third of the recording
+constexpr uint32_t UPLINK_CONGESTION_THRESHOLD_MS = 1;
+constexpr auto UPLINK_CONGESTED_SEND_DURATION = std::chrono::milliseconds(2);
+
+// G.711 A-law of a 16-bit sample
+static uint8_t encode_alaw(int16_t sample)
+{
+    int sign = (sample >= 0) ? 0x80 : 0;
+    int magnitude = std::min(std::abs(static_cast<int>(sample)), 32767) >> 3;
+    int exponent = 0;
+    while ((magnitude > 0x1F) && (exponent < 7)) {
+        magnitude >>= 1;
+        exponent++;
+    }
+    int mantissa = (exponent == 0) ? (magnitude >> 1) : (magnitude & 0x0F);
+
+    return static_cast<uint8_t>((sign | (exponent << 4) | mantissa) ^ 0x55);
+}
+
+// Stand-in for a recording: a voice-like mix of tones, with some noise
+static std::vector<uint8_t> make_recorded_alaw(size_t seconds)
+{
+    std::vector<uint8_t> recorded(UPLINK_SAMPLE_RATE * seconds);
+    uint32_t noise = 1;
+    for (size_t i = 0; i < recorded.size(); i++) {
+        double t = static_cast<double>(i) / UPLINK_SAMPLE_RATE;
+        noise = noise * 1664525 + 1013904223;
+        double value = 8000 * std::sin(2 * M_PI * 220 * t) + 3000 * std::sin(2 * M_PI * 660 * t) +
+                       static_cast<int>(noise >> 22) - 512;
+        recorded[i] = encode_alaw(static_cast<int16_t>(value));
+    }
+
+    return recorded;
+}
+
+static bool decode_base64(std::string_view encoded, std::vector<uint8_t> &decoded)
+{
+    constexpr std::string_view CHARS = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    if (encoded.size() % 4 != 0) {
+        return false;
+    }
+    for (size_t i = 0; i < encoded.size(); i += 4) {
+        uint32_t value = 0;
+        size_t padding = 0;
+        for (size_t j = 0; j < 4; j++) {
+            auto c = encoded[i + j];
+            auto index = CHARS.find(c);
+            if (c == '=') {
+                padding++;
+                index = 0;
+            } else if ((index == std::string_view::npos) || (padding > 0)) {
+                return false;
+            }
+            value = (value << 6) | static_cast<uint32_t>(index);
+        }
+        decoded.push_back(static_cast<uint8_t>(value >> 16));
+        if (padding < 2) {
+            decoded.push_back(static_cast<uint8_t>(value >> 8));
+        }
+        if (padding < 1) {
+            decoded.push_back(static_cast<uint8_t>(value));
+        }
+    }
+
+    return true;
+}
+
+// Encoding kernels on a frame of the recording
+static void run_kernel_cases(Runner &runner, const std::vector<uint8_t> &recorded)
+{
+    std::vector<char> encoded(Base64Encoder::getEncodedSize(UPLINK_FRAME_SIZE));
+    size_t frame_count = recorded.size() / UPLINK_FRAME_SIZE;
+
+    runner.run("coze_uplink.base64_1024", SYNC_ITERATIONS, [&](size_t index) {
+        Base64Encoder::encode(&recorded[(index % frame_count) * UPLINK_FRAME_SIZE], UPLINK_FRAME_SIZE, encoded.data());
+    });
+    runner.run("coze_uplink.base64_1024_scalar", SYNC_ITERATIONS, [&](size_t index) {
+        Base64Encoder::encodeScalar(
+            &recorded[(index % frame_count) * UPLINK_FRAME_SIZE], UPLINK_FRAME_SIZE, encoded.data()
+        );
+    });
+
+    // Both kernels give the same output, including the padding of the tails
+    if (runner.is_selected("coze_uplink.base64_1024")) {
+        std::vector<char> scalar_encoded(encoded.size());
+        for (size_t size = 0; size <= 7; size++) {
+            auto encoded_size = Base64Encoder::encode(recorded.data(), size, encoded.data());
+            auto scalar_size = Base64Encoder::encodeScalar(recorded.data(), size, scalar_encoded.data());
+            std::vector<uint8_t> decoded;
+            if ((encoded_size != scalar_size) || (std::memcmp(encoded.data(), scalar_encoded.data(), encoded_size) != 0) ||
+                    !decode_base64({encoded.data(), encoded_size}, decoded) ||
+                    !std::equal(decoded.begin(), decoded.end(), recorded.begin(), recorded.begin() + size)) {
+                runner.add_failure("coze_uplink.base64_1024", "Kernels disagree on " + std::to_string(size) + " bytes");
+                return;
+            }
+        }
+    }
+}
+
+// The recording read frame by frame through the uplink encoder, the link being congested for its middle third
+static void run_stream_case(Runner &runner, const std::vector<uint8_t> &recorded)
+{
+    const std::string name = "coze_uplink.recorded_stream";
+    if (!runner.is_selected(name)) {
+        return;
+    }
+
+    size_t frame_count = recorded.size() / UPLINK_FRAME_SIZE;
+    size_t frame_index = 0;
+    std::vector<uint8_t> decoded;
+    bool is_decoded = true;
+    AudioUplinkEncoder encoder;
+    bool is_begun = encoder.begin({
+        .frame_size = UPLINK_FRAME_SIZE,
+        .max_batch_frames = 4,
+        .congestion_threshold_ms = UPLINK_CONGESTION_THRESHOLD_MS,
+    }, [&](const char *data, size_t size) {
+        if ((frame_index >= frame_count / 3) && (frame_index < frame_count * 2 / 3)) {
+            std::this_thread::sleep_for(UPLINK_CONGESTED_SEND_DURATION);
+        }
+        // Each send is a message of its own, decoded on its own by the server
+        is_decoded = is_decoded && (data[size] == '\0') && decode_base64({data, size}, decoded);
+        return true;
+    });
+    if (!is_begun) {
+        runner.add_failure(name, "Failed to begin the encoder");
+        return;
+    }
+
+    std::vector<int64_t> samples;
+    samples.reserve(frame_count);
+    auto begin = Clock::now();
+    for (frame_index = 0; frame_index < frame_count; frame_index++) {
+        auto start = Clock::now();
+        if (!encoder.push(&recorded[frame_index * UPLINK_FRAME_SIZE], UPLINK_FRAME_SIZE)) {
+            runner.add_failure(name, "Failed to push frame " + std::to_string(frame_index));
+            return;
+        }
+        samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+    encoder.flush();
+    auto total_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count();
+
+    const auto &statistics = encoder.getStatistics();
+    printf(
+        "[bench] %-36s %zu frames, %zu sends, %zu congested, largest batch %zu frames\n", name.c_str(),
+        statistics.pushed_frames, statistics.sent_batches, statistics.congested_sends, statistics.max_batch_frames
+    );
+
+    if (!is_decoded || (decoded.size() != frame_count * UPLINK_FRAME_SIZE) ||
+            !std::equal(decoded.begin(), decoded.end(), recorded.begin())) {
+        runner.add_failure(name, "Sent audio differs from the recording");
+        return;
+    }
+    if ((statistics.max_batch_frames < 2) || (statistics.sent_batches >= frame_count)) {
+        runner.add_failure(name, "Frames not batched while congested");
+        return;
+    }
+
+    runner.add_samples(name, std::move(samples), total_ns);
+}
+
+void run_coze_uplink_cases(Runner &runner)
+{
+    auto recorded = make_recorded_alaw(UPLINK_RECORD_SECONDS);
+    run_kernel_cases(runner, recorded);
+    run_stream_case(runner, recorded);
+}
+
+} // namespace esp_brookesia::benchmark
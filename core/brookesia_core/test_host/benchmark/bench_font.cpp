@@ -0,0 +1,175 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <algorithm>
+#include <cmath>
+#include "lvgl/esp_brookesia_lv_glyph_cache.hpp"
+#include "benchmark.hpp"
+
+using namespace esp_brookesia::gui;
+
+namespace esp_brookesia::benchmark {
+
+// Like the Maison Neue master of the scaled fonts: 48 px, 4 bpp, the printable ASCII glyphs
+constexpr int FONT_MASTER_SIZE = 48;
+constexpr uint32_t FONT_GLYPH_NUM = 95;
+// Sizes used by the stylesheets of the phone, and the text of a screen drawn with them
+constexpr int FONT_SIZES[] = {12, 16, 20, 24};
+constexpr size_t FONT_TEXT_LENGTH = 200;
+constexpr size_t FONT_CACHE_BUDGET = 64 * 1024;
+
+struct MasterGlyph {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> packed;    // 4 bpp, rows not aligned, as generated by `lv_font_conv`
+};
+
+// Stand-in for the outlines: antialiased rings of different widths
+static std::vector<MasterGlyph> make_master_glyphs()
+{
+    std::vector<MasterGlyph> glyphs(FONT_GLYPH_NUM);
+    for (uint32_t id = 0; id < FONT_GLYPH_NUM; id++) {
+        auto &glyph = glyphs[id];
+        glyph.width = 14 + static_cast<int>(id % 20);
+        glyph.height = 34;
+        glyph.packed.assign((glyph.width * glyph.height + 1) / 2, 0);
+        float radius_x = glyph.width / 2.0f;
+        float radius_y = glyph.height / 2.0f;
+        for (int y = 0; y < glyph.height; y++) {
+            for (int x = 0; x < glyph.width; x++) {
+                float dx = (x + 0.5f - radius_x) / radius_x;
+                float dy = (y + 0.5f - radius_y) / radius_y;
+                float distance = std::fabs(std::sqrt(dx * dx + dy * dy) - 0.8f) * radius_y;
+                int value = std::clamp(static_cast<int>((3.0f - distance) * 8), 0, 15);
+                int index = y * glyph.width + x;
+                glyph.packed[index / 2] |= static_cast<uint8_t>(value << ((index % 2) ? 0 : 4));
+            }
+        }
+    }
+
+    return glyphs;
+}
+
+// Same box as the scaled fonts: the master box scaled, rounded outwards
+struct ScaledGlyph {
+    int width;
+    int height;
+    float src_x;
+    float src_y;
+    float step;
+};
+
+static ScaledGlyph get_scaled_glyph(const MasterGlyph &master, int size)
+{
+    float scale = static_cast<float>(size) / FONT_MASTER_SIZE;
+    int right = static_cast<int>(std::ceil(master.width * scale));
+    int top = static_cast<int>(std::ceil(master.height * scale));
+
+    return ScaledGlyph{right, top, 0, master.height - top / scale, 1 / scale};
+}
+
+// What the scaled fonts do on a miss: unpack the master and scale it
+static bool render_glyph(const MasterGlyph &master, const ScaledGlyph &scaled, uint8_t *bitmap, uint32_t stride)
+{
+    thread_local std::vector<uint8_t> unpacked;
+    unpacked.resize(master.width * master.height);
+    for (size_t i = 0; i < unpacked.size(); i++) {
+        uint8_t value = (master.packed[i / 2] >> ((i % 2) ? 0 : 4)) & 0x0F;
+        unpacked[i] = value * 17;
+    }
+    GlyphCache::scaleBitmap(
+        unpacked.data(), master.width, master.height, master.width, scaled.src_x, scaled.src_y, scaled.step,
+        bitmap, scaled.width, scaled.height, stride
+    );
+
+    return true;
+}
+
+static void run_text_case(
+    Runner &runner, const std::string &name, const std::vector<MasterGlyph> &masters, size_t memory_budget
+)
+{
+    if (!runner.is_selected(name)) {
+        return;
+    }
+
+    // Fonts are identified by their size, as a font address would be
+    GlyphCache cache(memory_budget);
+    std::vector<uint8_t> draw_buf(FONT_MASTER_SIZE * FONT_MASTER_SIZE);
+    uint32_t text_seed = 1;
+    runner.run(name, SYNC_ITERATIONS / 100, [&](size_t) {
+        for (size_t i = 0; i < FONT_TEXT_LENGTH; i++) {
+            text_seed = text_seed * 1664525 + 1013904223;
+            uint32_t id = (text_seed >> 16) % FONT_GLYPH_NUM;
+            int size = FONT_SIZES[i % std::size(FONT_SIZES)];
+            const auto &master = masters[id];
+            auto scaled = get_scaled_glyph(master, size);
+            cache.get(reinterpret_cast<const void *>(static_cast<uintptr_t>(size)), id, scaled.width, scaled.height,
+            [&](uint8_t *bitmap, uint32_t stride) {
+                return render_glyph(master, scaled, bitmap, stride);
+            }, draw_buf.data(), FONT_MASTER_SIZE);
+        }
+    });
+
+    auto stats = cache.getStats();
+    printf(
+        "[bench] %-36s %zu glyphs, %zu bytes, %u hits, %u misses, %u evicted\n", name.c_str(), stats.glyph_num,
+        stats.used_bytes, stats.hit_count, stats.miss_count, stats.evicted_count
+    );
+    if ((memory_budget > 0) && (stats.used_bytes > memory_budget)) {
+        runner.add_failure(name, "Cache over its budget");
+    }
+}
+
+static void run_glyph_cases(Runner &runner, const std::vector<MasterGlyph> &masters)
+{
+    std::vector<uint8_t> draw_buf(FONT_MASTER_SIZE * FONT_MASTER_SIZE);
+    const auto &master = masters['O' - ' '];
+    auto scaled = get_scaled_glyph(master, 16);
+    auto render = [&](uint8_t *bitmap, uint32_t stride) {
+        return render_glyph(master, scaled, bitmap, stride);
+    };
+
+    // First render of a glyph, then the next ones from the cache
+    GlyphCache uncached;
+    runner.run("font.glyph_first_render", SYNC_ITERATIONS, [&](size_t) {
+        uncached.get(&master, 0, scaled.width, scaled.height, render, draw_buf.data(), FONT_MASTER_SIZE);
+    });
+    GlyphCache cache(FONT_CACHE_BUDGET);
+    runner.run("font.glyph_cached", SYNC_ITERATIONS, [&](size_t) {
+        cache.get(&master, 0, scaled.width, scaled.height, render, draw_buf.data(), FONT_MASTER_SIZE);
+    });
+
+    // A full-coverage master must stay opaque inside once scaled, whatever the scale
+    const std::string name = "font.scale_coverage";
+    if (runner.is_selected(name)) {
+        std::vector<uint8_t> opaque(FONT_MASTER_SIZE * FONT_MASTER_SIZE, 0xFF);
+        std::vector<uint8_t> scaled_bitmap(FONT_MASTER_SIZE * FONT_MASTER_SIZE);
+        for (int size = 8; size < FONT_MASTER_SIZE; size += 2) {
+            GlyphCache::scaleBitmap(
+                opaque.data(), FONT_MASTER_SIZE, FONT_MASTER_SIZE, FONT_MASTER_SIZE, 0, 0,
+                static_cast<float>(FONT_MASTER_SIZE) / size, scaled_bitmap.data(), size, size, size
+            );
+            for (int i = 0; i < size * size; i++) {
+                if (scaled_bitmap[i] != 0xFF) {
+                    runner.add_failure(name, "Coverage lost at " + std::to_string(size) + " px");
+                    return;
+                }
+            }
+        }
+    }
+}
+
+void run_font_cases(Runner &runner)
+{
+    auto masters = make_master_glyphs();
+
+    run_glyph_cases(runner, masters);
+    // A screen of text in several sizes, rendered on every draw or once in the shared cache
+    run_text_case(runner, "font.text_uncached", masters, 0);
+    run_text_case(runner, "font.text_cached", masters, FONT_CACHE_BUDGET);
+}
+
+} // namespace esp_brookesia::benchmark
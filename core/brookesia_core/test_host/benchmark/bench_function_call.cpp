@@ -0,0 +1,160 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <atomic>
+#include <stdexcept>
+#include "function_call_executor.hpp"
+#include "benchmark.hpp"
+
+using namespace esp_brookesia::ai_framework;
+
+namespace esp_brookesia::benchmark {
+
+// Tool calls of a turn, spread over the registered functions, the first one serialized
+constexpr size_t CALL_BURST_SIZE = 8;
+constexpr size_t CALL_FUNCTION_NUM = 4;
+constexpr size_t CALL_WORKER_NUM = 2;
+constexpr auto CALL_DURATION = std::chrono::microseconds(200);
+
+static void run_tool_call()
+{
+    auto deadline = Clock::now() + CALL_DURATION;
+    while (Clock::now() < deadline) {
+    }
+}
+
+// A thread per call, as before the executor
+static void run_thread_per_call_case(Runner &runner)
+{
+    std::atomic<size_t> done_count = 0;
+    runner.run("function_call.burst_thread_per_call", ASYNC_ITERATIONS, [&](size_t) {
+        done_count = 0;
+        for (size_t i = 0; i < CALL_BURST_SIZE; i++) {
+            boost::thread([&]() {
+                run_tool_call();
+                done_count++;
+            }).detach();
+        }
+        wait_until([&]() {
+            return done_count == CALL_BURST_SIZE;
+        });
+    });
+}
+
+static void run_pooled_case(Runner &runner)
+{
+    const std::string name = "function_call.burst_pooled";
+    if (!runner.is_selected(name)) {
+        return;
+    }
+
+    FunctionCallExecutor executor;
+    if (!executor.begin({.worker_num = CALL_WORKER_NUM, .max_queue_size = CALL_BURST_SIZE})) {
+        runner.add_failure(name, "Failed to begin the executor");
+        return;
+    }
+
+    std::atomic<size_t> done_count = 0;
+    std::atomic<size_t> serial_running = 0;
+    std::atomic<bool> is_overlapped = false;
+    size_t rejected_count = 0;
+    runner.run(name, ASYNC_ITERATIONS, [&](size_t) {
+        done_count = 0;
+        for (size_t i = 0; i < CALL_BURST_SIZE; i++) {
+            size_t key = i % CALL_FUNCTION_NUM;
+            bool is_serial = (key == 0);
+            bool is_posted = executor.post(key, [&, is_serial]() {
+                if (is_serial && (serial_running++ > 0)) {
+                    is_overlapped = true;
+                }
+                run_tool_call();
+                if (is_serial) {
+                    serial_running--;
+                }
+                done_count++;
+            }, is_serial);
+            if (!is_posted) {
+                rejected_count++;
+            }
+        }
+        wait_until([&]() {
+            return done_count + rejected_count == CALL_BURST_SIZE;
+        });
+    });
+
+    auto statistics = executor.getStatistics(0);
+    printf(
+        "[bench] %-36s serialized function: %zu calls, max %zu waiting, max latency %u us\n", name.c_str(),
+        statistics.call_count, statistics.max_queue_depth, statistics.max_latency_us
+    );
+    if ((rejected_count > 0) || is_overlapped || (statistics.call_count == 0)) {
+        runner.add_failure(name, "Calls rejected or serialized calls overlapped");
+        return;
+    }
+
+    // A burst larger than the queue is rejected beyond it, instead of queued without bound
+    std::atomic<bool> is_released = false;
+    size_t posted_count = 0;
+    for (size_t i = 0; i < CALL_WORKER_NUM + CALL_BURST_SIZE * 2; i++) {
+        posted_count += executor.post(1, [&]() {
+            wait_until([&]() {
+                return is_released.load();
+            });
+        }) ? 1 : 0;
+    }
+    is_released = true;
+    executor.end();
+    if ((posted_count > CALL_WORKER_NUM + CALL_BURST_SIZE) || (executor.getStatistics(1).rejected_count == 0)) {
+        runner.add_failure(name, std::to_string(posted_count) + " calls queued beyond the queue size");
+    }
+}
+
+// A call which throws is reported as failed, the worker keeps running the next serialized call
+static void run_failed_call_case(Runner &runner)
+{
+    const std::string name = "function_call.failed_call";
+    if (!runner.is_selected(name)) {
+        return;
+    }
+
+    FunctionCallExecutor executor;
+    if (!executor.begin({.worker_num = 1, .max_queue_size = CALL_BURST_SIZE})) {
+        runner.add_failure(name, "Failed to begin the executor");
+        return;
+    }
+
+    std::atomic<size_t> done_count = 0;
+    size_t rejected_count = 0;
+    runner.run(name, ASYNC_ITERATIONS, [&](size_t) {
+        done_count = 0;
+        rejected_count += executor.post(0, []() {
+            throw std::runtime_error("tool failed");
+        }, true) ? 0 : 1;
+        rejected_count += executor.post(0, [&]() {
+            done_count++;
+        }, true) ? 0 : 1;
+        wait_until([&]() {
+            return done_count.load() == 1;
+        });
+    });
+    executor.end();
+
+    auto statistics = executor.getStatistics(0);
+    if ((rejected_count > 0) || (statistics.failed_count * 2 != statistics.call_count)) {
+        runner.add_failure(
+            name, std::to_string(statistics.failed_count) + " of " + std::to_string(statistics.call_count) +
+            " calls failed, expected half of them"
+        );
+    }
+}
+
+void run_function_call_cases(Runner &runner)
+{
+    run_thread_per_call_case(runner);
+    run_pooled_case(runner);
+    run_failed_call_case(runner);
+}
+
+} // namespace esp_brookesia::benchmark
@@ -0,0 +1,262 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <algorithm>
+#include <cmath>
+#include "esp_brookesia_gesture_recognizer.hpp"
+#include "benchmark.hpp"
+
+using esp_brookesia::systems::phone::GestureRecognizer;
+
+namespace esp_brookesia::benchmark {
+
+// Thresholds of the 480x480 stylesheet of the phone
+constexpr GestureRecognizer::Config GESTURE_CONFIG = {
+    .screen_width = 480,
+    .screen_height = 480,
+    .direction_vertical = 50,
+    .direction_horizon = 50,
+    .direction_angle = 60,
+    .horizontal_edge = 10,
+    .vertical_edge = 20,
+    .duration_short_ms = 800,
+    .speed_slow_px_per_ms = 0.1,
+};
+constexpr float GESTURE_FLING_SPEED_PX_PER_MS = 0.6;
+constexpr uint16_t GESTURE_FLING_PREDICTION_MS = 40;
+// Period of the former detection timer, and of the touch reads
+constexpr uint32_t GESTURE_POLL_PERIOD_MS = 20;
+constexpr uint32_t GESTURE_SAMPLE_PERIOD_MS = 10;
+// No more recognized gestures than the polling, and not less than this
+constexpr float GESTURE_MIN_ACCURACY = 0.95;
+
+struct GestureTrace {
+    uint8_t expected_direction;
+    std::vector<GestureRecognizer::Sample> samples;   // The last one is the release
+};
+
+// Like the touch reads of a finger, with jittered periods and noisy points
+class TraceRecorder {
+public:
+    explicit TraceRecorder(uint32_t seed)
+        : seed_(seed)
+    {}
+
+    /**
+     * @brief Record a gesture from (x, y), moving by (dx, dy) in `move_ms` with a smooth start and stop, after being
+     *        held still for `hold_before_ms` and before being held still for `hold_after_ms`
+     */
+    GestureTrace record(
+        uint8_t expected_direction, int x, int y, int dx, int dy, uint32_t move_ms, uint32_t hold_before_ms = 0,
+        uint32_t hold_after_ms = 0
+    )
+    {
+        GestureTrace trace = {expected_direction, {}};
+        uint32_t end_ms = hold_before_ms + move_ms + hold_after_ms;
+        uint32_t time_ms = next() % GESTURE_POLL_PERIOD_MS;
+        uint32_t start_ms = time_ms;
+        while ((time_ms - start_ms) <= end_ms) {
+            float t = static_cast<float>(time_ms - start_ms) - hold_before_ms;
+            float progress = (move_ms > 0) ? std::clamp(t / move_ms, 0.0f, 1.0f) : 1.0f;
+            progress = progress * progress * (3 - 2 * progress);
+            trace.samples.push_back({
+                .x = std::clamp(static_cast<int>(lroundf(x + dx * progress)) + noise(), 0, GESTURE_CONFIG.screen_width - 1),
+                .y = std::clamp(static_cast<int>(lroundf(y + dy * progress)) + noise(), 0, GESTURE_CONFIG.screen_height - 1),
+                .pressed = true,
+                .time_ms = time_ms,
+            });
+            time_ms += GESTURE_SAMPLE_PERIOD_MS - 1 + next() % 3;
+        }
+        trace.samples.push_back({0, 0, false, time_ms});
+
+        return trace;
+    }
+
+private:
+    uint32_t next()
+    {
+        seed_ = seed_ * 1664525 + 1013904223;
+        return seed_ >> 16;
+    }
+
+    int noise()
+    {
+        return static_cast<int>(next() % 5) - 2;
+    }
+
+    uint32_t seed_;
+};
+
+static std::vector<GestureTrace> make_gesture_traces()
+{
+    TraceRecorder recorder(1);
+    std::vector<GestureTrace> traces;
+    struct {
+        uint8_t direction;
+        int dx;
+        int dy;
+    } swipes[] = {
+        {GestureRecognizer::DIR_UP, 0, -1}, {GestureRecognizer::DIR_DOWN, 0, 1},
+        {GestureRecognizer::DIR_LEFT, -1, 0}, {GestureRecognizer::DIR_RIGHT, 1, 0},
+    };
+
+    for (const auto &swipe : swipes) {
+        // From the center and from the edges (e.g. the navigation gestures), slow drags to fast flings
+        for (int distance : {80, 140, 200}) {
+            for (float speed : {0.2f, 0.5f, 1.0f, 2.0f, 3.0f}) {
+                auto move_ms = static_cast<uint32_t>(distance / speed);
+                int start_x = 240 - swipe.dx * 30;
+                int start_y = 240 - swipe.dy * 30;
+                traces.push_back(recorder.record(
+                                     swipe.direction, start_x, start_y, swipe.dx * distance, swipe.dy * distance, move_ms
+                                 ));
+                start_x = (swipe.dx != 0) ? ((swipe.dx > 0) ? 4 : 475) : 240;
+                start_y = (swipe.dy != 0) ? ((swipe.dy > 0) ? 8 : 470) : 240;
+                traces.push_back(recorder.record(
+                                     swipe.direction, start_x, start_y, swipe.dx * distance, swipe.dy * distance, move_ms,
+                                     30
+                                 ));
+            }
+        }
+        // Slightly diagonal swipes
+        traces.push_back(recorder.record(
+                             swipe.direction, 240, 240, swipe.dx * 120 + swipe.dy * 30, swipe.dy * 120 + swipe.dx * 30,
+                             90
+                         ));
+        // Nudges, and drags held still before the release
+        traces.push_back(recorder.record(GestureRecognizer::DIR_NONE, 240, 240, swipe.dx * 25, swipe.dy * 25, 120));
+        traces.push_back(recorder.record(
+                             GestureRecognizer::DIR_NONE, 240, 240, swipe.dx * 30, swipe.dy * 30, 150, 100, 300
+                         ));
+    }
+    // Taps and long presses
+    for (uint32_t duration_ms : {40, 80, 150, 600, 1200}) {
+        traces.push_back(recorder.record(GestureRecognizer::DIR_NONE, 100, 300, 0, 0, 0, duration_ms));
+    }
+
+    return traces;
+}
+
+struct GestureReplay {
+    size_t correct_num = 0;
+    size_t wrong_num = 0;                       // Recognized in a wrong direction at any time
+    std::vector<int64_t> latencies_ns;          // From the start of the movement to the recognition of its direction
+};
+
+/**
+ * @brief Replay the traces through a recognizer, every sample as read (the gesture is fed by the pressing and
+ *        released events of each read), or only the last one on each period of a polling timer (`poll_period_ms` > 0)
+ */
+static GestureReplay replay_gesture_traces(
+    const std::vector<GestureTrace> &traces, const GestureRecognizer::Config &config, uint32_t poll_period_ms
+)
+{
+    GestureRecognizer recognizer;
+    GestureReplay replay;
+    recognizer.setConfig(config);
+
+    for (const auto &trace : traces) {
+        uint32_t start_ms = trace.samples.front().time_ms;
+        bool is_recognized = false;
+        bool is_wrong = false;
+        auto process = [&](GestureRecognizer::Sample sample) {
+            if (recognizer.feed(sample) == GestureRecognizer::Event::NONE) {
+                return;
+            }
+            uint8_t direction = recognizer.getTrack().direction;
+            if ((direction != GestureRecognizer::DIR_NONE) && (direction != trace.expected_direction)) {
+                is_wrong = true;
+            }
+            if (!is_recognized && (direction != GestureRecognizer::DIR_NONE) && (direction == trace.expected_direction)) {
+                is_recognized = true;
+                replay.latencies_ns.push_back(static_cast<int64_t>(sample.time_ms - start_ms) * 1000000);
+            }
+        };
+
+        if (poll_period_ms == 0) {
+            for (const auto &sample : trace.samples) {
+                process(sample);
+            }
+        } else {
+            // The timer reads the last sample, and only sees the release on its next period
+            size_t index = 0;
+            for (uint32_t tick_ms = start_ms; index < trace.samples.size(); tick_ms += poll_period_ms) {
+                while (((index + 1) < trace.samples.size()) && (trace.samples[index + 1].time_ms <= tick_ms)) {
+                    index++;
+                }
+                if (trace.samples[index].time_ms > tick_ms) {
+                    continue;
+                }
+                auto sample = trace.samples[index];
+                sample.time_ms = tick_ms;
+                process(sample);
+                if (!sample.pressed) {
+                    break;
+                }
+            }
+        }
+
+        uint8_t direction = recognizer.getTrack().direction;
+        if (!is_wrong && (direction == trace.expected_direction)) {
+            replay.correct_num++;
+        }
+        replay.wrong_num += is_wrong ? 1 : 0;
+    }
+
+    return replay;
+}
+
+static float run_replay_case(
+    Runner &runner, const std::string &name, const std::vector<GestureTrace> &traces,
+    const GestureRecognizer::Config &config, uint32_t poll_period_ms
+)
+{
+    auto replay = replay_gesture_traces(traces, config, poll_period_ms);
+    float accuracy = static_cast<float>(replay.correct_num) / traces.size();
+    printf(
+        "[bench] %-36s %zu traces, accuracy %.1f%%, %zu wrong directions\n", name.c_str(), traces.size(),
+        accuracy * 100, replay.wrong_num
+    );
+    // The latencies are in the time of the traces, not of the replay, so the case has no ops/s
+    runner.add_latency_samples(name, std::move(replay.latencies_ns));
+
+    return accuracy;
+}
+
+void run_gesture_cases(Runner &runner)
+{
+    auto traces = make_gesture_traces();
+    GestureRecognizer::Config event_config = GESTURE_CONFIG;
+    event_config.speed_fling_px_per_ms = GESTURE_FLING_SPEED_PX_PER_MS;
+    event_config.fling_prediction_ms = GESTURE_FLING_PREDICTION_MS;
+
+    // Recognition latency and accuracy on the recorded traces, polled like before or processed as read
+    float polling_accuracy = 0;
+    float event_accuracy = 0;
+    if (runner.is_selected("gesture.latency_polling")) {
+        polling_accuracy = run_replay_case(
+                               runner, "gesture.latency_polling", traces, GESTURE_CONFIG, GESTURE_POLL_PERIOD_MS
+                           );
+    }
+    if (runner.is_selected("gesture.latency_event")) {
+        event_accuracy = run_replay_case(runner, "gesture.latency_event", traces, GESTURE_CONFIG, 0);
+    }
+    if (runner.is_selected("gesture.latency_fling")) {
+        float accuracy = run_replay_case(runner, "gesture.latency_fling", traces, event_config, 0);
+        if ((accuracy < GESTURE_MIN_ACCURACY) || (accuracy < std::min(polling_accuracy, event_accuracy))) {
+            runner.add_failure("gesture.latency_fling", "Accuracy lost by the fling prediction");
+        }
+    }
+
+    // Cost of a sample
+    GestureRecognizer recognizer;
+    recognizer.setConfig(event_config);
+    const auto &samples = traces.front().samples;
+    runner.run("gesture.feed", SYNC_ITERATIONS, [&](size_t index) {
+        recognizer.feed(samples[index % samples.size()]);
+    });
+}
+
+} // namespace esp_brookesia::benchmark
@@ -0,0 +1,230 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <algorithm>
+#include "esp_brookesia_status_bar_state.hpp"
+#include "benchmark.hpp"
+
+using esp_brookesia::systems::phone::StatusBarState;
+
+namespace esp_brookesia::benchmark {
+
+// Status bar of the 480x480 stylesheet: 16 px text, 24 px icons
+constexpr int STATUS_BAR_WIDTH = 480;
+constexpr int STATUS_BAR_HEIGHT = 36;
+constexpr int STATUS_BAR_CHAR_WIDTH = 9;
+constexpr int STATUS_BAR_LINE_HEIGHT = 19;
+constexpr int STATUS_BAR_ICON_SIZE = 24;
+// One minute of idle UI: the clock set every second like the products do, the battery read every 5 seconds
+constexpr uint32_t STATUS_BAR_REFRESH_PERIOD_MS = 33;
+constexpr uint32_t STATUS_BAR_MINUTE_MS = 60 * 1000;
+constexpr uint32_t STATUS_BAR_CLOCK_PERIOD_MS = 1000;
+constexpr uint32_t STATUS_BAR_BATTERY_PERIOD_MS = 5000;
+
+struct StatusBarRect {
+    int x1;
+    int y1;
+    int x2;
+    int y2;
+
+    int get_area() const
+    {
+        return (x2 - x1 + 1) * (y2 - y1 + 1);
+    }
+};
+
+// Boxes of the parts, laid out like the areas of the status bar: clock at the start, battery at the end
+static StatusBarRect get_part_rect(uint32_t part)
+{
+    int y1 = (STATUS_BAR_HEIGHT - STATUS_BAR_LINE_HEIGHT) / 2;
+    int y2 = y1 + STATUS_BAR_LINE_HEIGHT - 1;
+    int char_w = STATUS_BAR_CHAR_WIDTH;
+    switch (part) {
+    case StatusBarState::PART_CLOCK_HOUR:
+        return {16, y1, 16 + 2 * char_w - 1, y2};
+    case StatusBarState::PART_CLOCK_MIN:
+        return {16 + 3 * char_w, y1, 16 + 5 * char_w - 1, y2};
+    case StatusBarState::PART_CLOCK_PERIOD:
+        return {16 + 5 * char_w, y1, 16 + 9 * char_w - 1, y2};
+    case StatusBarState::PART_BATTERY_LABEL:
+        return {STATUS_BAR_WIDTH - 16 - STATUS_BAR_ICON_SIZE - 4 * char_w, y1, STATUS_BAR_WIDTH - 17 - STATUS_BAR_ICON_SIZE, y2};
+    default: {
+        int icon_y1 = (STATUS_BAR_HEIGHT - STATUS_BAR_ICON_SIZE) / 2;
+        return {STATUS_BAR_WIDTH - 16 - STATUS_BAR_ICON_SIZE, icon_y1, STATUS_BAR_WIDTH - 17, icon_y1 + STATUS_BAR_ICON_SIZE - 1};
+    }
+    }
+}
+
+// Invalidated areas of a frame, joined like LVGL does when the union isn't larger than the both areas
+class StatusBarFrame {
+public:
+    void invalidate(uint32_t parts)
+    {
+        for (uint32_t part = 1; part < StatusBarState::PART_ALL; part <<= 1) {
+            if (parts & part) {
+                add(get_part_rect(part));
+            }
+        }
+    }
+
+    const std::vector<StatusBarRect> &get_rects() const
+    {
+        return rects_;
+    }
+
+    void clear()
+    {
+        rects_.clear();
+    }
+
+private:
+    void add(StatusBarRect rect)
+    {
+        for (auto &joined : rects_) {
+            StatusBarRect united = {
+                std::min(joined.x1, rect.x1), std::min(joined.y1, rect.y1),
+                std::max(joined.x2, rect.x2), std::max(joined.y2, rect.y2)
+            };
+            if (united.get_area() <= joined.get_area() + rect.get_area()) {
+                joined = united;
+                return;
+            }
+        }
+        rects_.push_back(rect);
+    }
+
+    std::vector<StatusBarRect> rects_;
+};
+
+// Software redraw of the invalidated areas into a RGB565 buffer: background, then antialiased text
+class StatusBarRenderer {
+public:
+    StatusBarRenderer()
+        : buffer_(STATUS_BAR_WIDTH * STATUS_BAR_HEIGHT)
+        , mask_(STATUS_BAR_WIDTH * STATUS_BAR_HEIGHT)
+    {
+        for (size_t i = 0; i < mask_.size(); i++) {
+            mask_[i] = static_cast<uint8_t>((i * 37) ^ (i >> 3));
+        }
+    }
+
+    void redraw(const StatusBarRect &rect)
+    {
+        for (int y = rect.y1; y <= rect.y2; y++) {
+            uint16_t *row = &buffer_[y * STATUS_BAR_WIDTH];
+            const uint8_t *mask = &mask_[y * STATUS_BAR_WIDTH];
+            for (int x = rect.x1; x <= rect.x2; x++) {
+                // Black background, white text
+                uint32_t opa = mask[x];
+                uint32_t r = (31 * opa) / 255;
+                uint32_t g = (63 * opa) / 255;
+                row[x] = static_cast<uint16_t>((r << 11) | (g << 5) | r);
+            }
+        }
+    }
+
+    uint16_t get_checksum() const
+    {
+        uint16_t checksum = 0;
+        for (auto pixel : buffer_) {
+            checksum ^= pixel;
+        }
+        return checksum;
+    }
+
+private:
+    std::vector<uint16_t> buffer_;
+    std::vector<uint8_t> mask_;
+};
+
+struct StatusBarMinute {
+    size_t invalidated_px = 0;
+    size_t redrawn_frames = 0;
+};
+
+/**
+ * @brief Replay one minute of idle UI, every setter touching its objects like before, or only the changed ones
+ */
+static StatusBarMinute replay_status_bar_minute(
+    bool is_12h, bool is_retained, StatusBarState &state, StatusBarRenderer &renderer, uint32_t minute_index
+)
+{
+    StatusBarMinute minute;
+    StatusBarFrame frame;
+    int battery_percent = 80 - static_cast<int>(minute_index % 50);
+    int hour = 9 + (minute_index / 60) % 12;
+
+    for (uint32_t time_ms = 0; time_ms < STATUS_BAR_MINUTE_MS; time_ms += STATUS_BAR_REFRESH_PERIOD_MS) {
+        uint32_t tick_ms = time_ms + STATUS_BAR_REFRESH_PERIOD_MS;
+        // The clock changes at the last second of the minute, the battery drops once per minute
+        if ((tick_ms / STATUS_BAR_CLOCK_PERIOD_MS) != (time_ms / STATUS_BAR_CLOCK_PERIOD_MS)) {
+            bool is_next_minute = (tick_ms >= STATUS_BAR_MINUTE_MS - STATUS_BAR_CLOCK_PERIOD_MS);
+            int min = (minute_index + (is_next_minute ? 1 : 0)) % 60;
+            uint32_t parts = state.setClock(hour, min, hour >= 12);
+            if (!is_retained) {
+                // Hour and minute were already compared, the period was set every time
+                parts |= is_12h ? static_cast<uint32_t>(StatusBarState::PART_CLOCK_PERIOD) : 0;
+            }
+            frame.invalidate(parts);
+        }
+        if ((tick_ms / STATUS_BAR_BATTERY_PERIOD_MS) != (time_ms / STATUS_BAR_BATTERY_PERIOD_MS)) {
+            bool is_dropped = (tick_ms >= STATUS_BAR_MINUTE_MS / 2);
+            uint32_t parts = state.setBatteryPercent(false, battery_percent - (is_dropped ? 1 : 0));
+            if (!is_retained) {
+                // The label was set every time, the icon compared its state
+                parts |= StatusBarState::PART_BATTERY_LABEL;
+            }
+            frame.invalidate(parts);
+        }
+
+        // Refresh
+        if (frame.get_rects().empty()) {
+            continue;
+        }
+        for (const auto &rect : frame.get_rects()) {
+            renderer.redraw(rect);
+            minute.invalidated_px += rect.get_area();
+        }
+        minute.redrawn_frames++;
+        frame.clear();
+    }
+
+    return minute;
+}
+
+static void run_idle_case(Runner &runner, const std::string &name, bool is_12h, bool is_retained)
+{
+    if (!runner.is_selected(name)) {
+        return;
+    }
+
+    StatusBarState state;
+    StatusBarRenderer renderer;
+    StatusBarMinute total;
+    size_t minute_num = 0;
+    state.setClockFormat(is_12h);
+    runner.run(name, SYNC_ITERATIONS / 10, [&](size_t index) {
+        auto minute = replay_status_bar_minute(is_12h, is_retained, state, renderer, static_cast<uint32_t>(index));
+        total.invalidated_px += minute.invalidated_px;
+        total.redrawn_frames += minute.redrawn_frames;
+        minute_num++;
+    });
+
+    printf(
+        "[bench] %-36s %zu px invalidated, %zu frames redrawn per minute (checksum %04x)\n", name.c_str(),
+        total.invalidated_px / minute_num, total.redrawn_frames / minute_num, renderer.get_checksum()
+    );
+}
+
+void run_status_bar_cases(Runner &runner)
+{
+    // Each sample is one minute of idle UI, the updates and the redraw of the invalidated areas
+    run_idle_case(runner, "status_bar.idle_24h_before", false, false);
+    run_idle_case(runner, "status_bar.idle_24h_retained", false, true);
+    run_idle_case(runner, "status_bar.idle_12h_before", true, false);
+    run_idle_case(runner, "status_bar.idle_12h_retained", true, true);
+}
+
+} // namespace esp_brookesia::benchmark
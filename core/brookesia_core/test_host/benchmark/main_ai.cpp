@@ -0,0 +1,21 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include "benchmark.hpp"
+
+namespace esp_brookesia::benchmark {
+
+void run_coze_uplink_cases(Runner &runner);
+void run_coze_token_cases(Runner &runner);
+void run_function_call_cases(Runner &runner);
+
+void run_cases(Runner &runner)
+{
+    run_coze_uplink_cases(runner);
+    run_coze_token_cases(runner);
+    run_function_call_cases(runner);
+}
+
+} // namespace esp_brookesia::benchmark
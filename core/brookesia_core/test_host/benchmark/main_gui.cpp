@@ -0,0 +1,21 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include "benchmark.hpp"
+
+namespace esp_brookesia::benchmark {
+
+void run_font_cases(Runner &runner);
+void run_gesture_cases(Runner &runner);
+void run_status_bar_cases(Runner &runner);
+
+void run_cases(Runner &runner)
+{
+    run_font_cases(runner);
+    run_gesture_cases(runner);
+    run_status_bar_cases(runner);
+}
+
+} // namespace esp_brookesia::benchmark
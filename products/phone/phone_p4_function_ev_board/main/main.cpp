@@ -85,21 +85,8 @@ extern "C" void app_main(void)
     Phone *phone = new (std::nothrow) Phone();
     ESP_UTILS_CHECK_NULL_EXIT(phone, "Create phone failed");
 
-    /* Try using a stylesheet that corresponds to the resolution */
-    Stylesheet *stylesheet = nullptr;
-    if ((BSP_LCD_H_RES == 1024) && (BSP_LCD_V_RES == 600)) {
-        stylesheet = new (std::nothrow) Stylesheet(STYLESHEET_1024_600_DARK);
-        ESP_UTILS_CHECK_NULL_EXIT(stylesheet, "Create stylesheet failed");
-    } else if ((BSP_LCD_H_RES == 800) && (BSP_LCD_V_RES == 1280)) {
-        stylesheet = new (std::nothrow) Stylesheet(STYLESHEET_800_1280_DARK);
-        ESP_UTILS_CHECK_NULL_EXIT(stylesheet, "Create stylesheet failed");
-    }
-    if (stylesheet) {
-        ESP_UTILS_LOGI("Using stylesheet (%s)", stylesheet->core.name);
-        ESP_UTILS_CHECK_FALSE_EXIT(phone->addStylesheet(stylesheet), "Add stylesheet failed");
-        ESP_UTILS_CHECK_FALSE_EXIT(phone->activateStylesheet(stylesheet), "Activate stylesheet failed");
-        delete stylesheet;
-    }
+    /* Add the built-in stylesheets, the one of the resolution is calibrated and activated by `begin()` */
+    ESP_UTILS_CHECK_FALSE_EXIT(phone->addBuiltinStylesheets(), "Add built-in stylesheets failed");
 
     {
         // When operating on non-GUI tasks, should acquire a lock before operating on LVGL
@@ -157,14 +144,14 @@ extern "C" void app_main(void)
                         heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM), external_free, external_total);
                 ESP_UTILS_LOGI("\n%s", buffer);
 
-                {
-                    LvLockGuard gui_guard;
+                // Post the update to the LVGL task instead of blocking on the LVGL lock
+                LvCommandQueue::getInstance().post(phone, 0, [ = ]() {
                     ESP_UTILS_CHECK_FALSE_EXIT(
                         phone->getDisplay().getRecentsScreen()->setMemoryLabel(
                             internal_free / 1024, internal_total / 1024, external_free / 1024, external_total / 1024
                         ), "Set memory label failed"
                     );
-                }
+                });
 
                 boost::this_thread::sleep_for(boost::chrono::seconds(5));
             }
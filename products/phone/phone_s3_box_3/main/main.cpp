@@ -135,14 +135,14 @@ extern "C" void app_main(void)
                         heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM), external_free, external_total);
                 ESP_UTILS_LOGI("\n%s", buffer);
 
-                {
-                    LvLockGuard gui_guard;
+                // Post the update to the LVGL task instead of blocking on the LVGL lock
+                LvCommandQueue::getInstance().post(phone, 0, [ = ]() {
                     ESP_UTILS_CHECK_FALSE_EXIT(
                         phone->getDisplay().getRecentsScreen()->setMemoryLabel(
                             internal_free / 1024, internal_total / 1024, external_free / 1024, external_total / 1024
                         ), "Set memory label failed"
                     );
-                }
+                });
 
                 boost::this_thread::sleep_for(boost::chrono::seconds(5));
             }
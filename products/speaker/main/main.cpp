@@ -18,6 +18,7 @@
 #include "modules/system.hpp" // 包含系统相关函数
 #include "modules/file_system.hpp" // 包含文件系统相关函数(SD卡/flash文件系统)
 #include "modules/led_indicator.h" // 包含 LED 指示灯相关函数
+#include "modules/lv_mem_core_custom.h" // 包含 LVGL 内存分配器统计
 #include "blufi_app.h" // 包含 BluFi 应用程序相关函数
 #include "esp_brookesia.hpp" //Brookesia 框架（可能是本项目使用的应用框架）。
 #include "ai_framework/agent/audio_processor.h" //AI 音频处理相关。
@@ -71,6 +72,9 @@ extern "C" void app_main()
                       {
             while (1) {
                 esp_utils_mem_print_info();
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+                lv_mem_core_print_stats();
+#endif
 
                 audio_sys_get_real_time_stats();
 
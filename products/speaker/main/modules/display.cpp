@@ -3,9 +3,11 @@
  *
  * SPDX-License-Identifier: CC0-1.0
  */
+#include <atomic>
 #include "lvgl.h"
 #include "bsp/esp-bsp.h"
 #include "esp_lvgl_port_disp.h"
+#include "esp_timer.h"
 #include "esp_brookesia.hpp"
 #ifdef ESP_UTILS_LOG_TAG
 #   undef ESP_UTILS_LOG_TAG
@@ -23,19 +25,26 @@ constexpr bool LVGL_TASK_STACK_CAPS_EXT  = true;
 constexpr int  BRIGHTNESS_MIN            = 10;
 constexpr int  BRIGHTNESS_MAX            = 100;
 constexpr int  BRIGHTNESS_DEFAULT        = 100;
+constexpr int  CLEAR_STRIPE_ROWS         = 16;
 
 using namespace esp_brookesia::gui;
 using namespace esp_brookesia::services;
 using namespace esp_brookesia::systems::speaker;
 
 static bool draw_bitmap_with_lock(lv_disp_t *disp, int x_start, int y_start, int x_end, int y_end, const void *data);
+static bool clear_area(lv_disp_t *disp, int x_start, int y_start, int x_end, int y_end);
 static bool clear_display(lv_disp_t *disp);
 
+// Zeroed full-width rows, the cleared areas are streamed from it in bands. Never written, but not `const` to keep
+// it in internal RAM (.bss) for the LCD DMA instead of flash.
+alignas(4) static uint8_t clear_stripe[BSP_LCD_H_RES * CLEAR_STRIPE_ROWS * 2] = {};
+
 bool display_init(bool default_dummy_draw)
 {
     ESP_UTILS_LOG_TRACE_GUARD();
 
-    static bool is_lvgl_dummy_draw = true;
+    // Read by the flush of the animations, from their own thread
+    static std::atomic<bool> is_lvgl_dummy_draw = true;
 
     /* Initialize BSP */
     bsp_power_init(true);
@@ -111,16 +120,19 @@ bool display_init(bool default_dummy_draw)
     ) {
         // ESP_UTILS_LOGD("Flush ready: %d, %d, %d, %d", x_start, y_start, x_end, y_end);
 
+        // A region which is not drawn is reported as such, so the player doesn't skip it next time
+        bool is_drawn = false;
         if (is_lvgl_dummy_draw) {
-            ESP_UTILS_CHECK_FALSE_EXIT(
-                draw_bitmap_with_lock(disp, x_start, y_start, x_end, y_end, data), "Draw bitmap failed"
-            );
+            is_drawn = draw_bitmap_with_lock(disp, x_start, y_start, x_end, y_end, data);
+            if (!is_drawn) {
+                ESP_UTILS_LOGE("Draw bitmap failed");
+            }
         }
 
         auto player = static_cast<AnimPlayer *>(user_data);
         ESP_UTILS_CHECK_NULL_EXIT(player, "Get player failed");
 
-        player->notifyFlushFinished();
+        player->notifyFlushFinished(is_drawn);
     });
     AnimPlayer::animation_stop_signal.connect(
         [ = ](int x_start, int y_start, int x_end, int y_end, void *user_data
@@ -128,10 +140,7 @@ bool display_init(bool default_dummy_draw)
         // ESP_UTILS_LOGD("Clear area: %d, %d, %d, %d", x_start, y_start, x_end, y_end);
 
         if (is_lvgl_dummy_draw) {
-            std::vector<uint8_t> buffer((x_end - x_start) * (y_end - y_start) * 2, 0);
-            ESP_UTILS_CHECK_FALSE_EXIT(
-                draw_bitmap_with_lock(disp, x_start, y_start, x_end, y_end, buffer.data()), "Draw bitmap failed"
-            );
+            ESP_UTILS_CHECK_FALSE_EXIT(clear_area(disp, x_start, y_start, x_end, y_end), "Clear area failed");
         }
     });
     Display::on_dummy_draw_signal.connect([ = ](bool enable) {
@@ -141,14 +150,18 @@ bool display_init(bool default_dummy_draw)
         lvgl_port_disp_set_dummy_draw(disp, enable);
         lvgl_port_disp_give_trans_sem(disp, false);
 
+        // Set before the invalidation, so every region checked after it is drawn
+        is_lvgl_dummy_draw = enable;
+
         if (!enable) {
             LvLockGuard gui_guard;
             lv_obj_invalidate(lv_screen_active());
         } else {
             ESP_UTILS_CHECK_FALSE_EXIT(clear_display(disp), "Clear display failed");
+            // The animations were not drawn while LVGL owned the screen, flush them fully again. The regions drawn
+            // before the clear are invalidated too, even if their flush finishes later.
+            AnimPlayer::invalidateDirtyRegions();
         }
-
-        is_lvgl_dummy_draw = enable;
     });
 
     return true;
@@ -180,13 +193,39 @@ static bool draw_bitmap_with_lock(lv_disp_t *disp, int x_start, int y_start, int
     return true;
 }
 
+static bool clear_area(lv_disp_t *disp, int x_start, int y_start, int x_end, int y_end)
+{
+    x_start = std::max(x_start, 0);
+    y_start = std::max(y_start, 0);
+    x_end = std::min(x_end, BSP_LCD_H_RES);
+    y_end = std::min(y_end, BSP_LCD_V_RES);
+    if ((x_end <= x_start) || (y_end <= y_start)) {
+        return true;
+    }
+
+    // A narrower area fits more rows in the stripe
+    int band_rows = sizeof(clear_stripe) / ((x_end - x_start) * 2);
+    auto start_time = esp_timer_get_time();
+    for (int y = y_start; y < y_end; y += band_rows) {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            draw_bitmap_with_lock(disp, x_start, y, x_end, std::min(y + band_rows, y_end), clear_stripe), false,
+            "Draw bitmap failed"
+        );
+    }
+    ESP_UTILS_LOGD(
+        "Clear area(%d, %d, %d, %d) in %d us", x_start, y_start, x_end, y_end,
+        static_cast<int>(esp_timer_get_time() - start_time)
+    );
+
+    return true;
+}
+
 static bool clear_display(lv_disp_t *disp)
 {
     ESP_UTILS_LOG_TRACE_GUARD();
 
-    std::vector<uint8_t> buffer(BSP_LCD_H_RES * BSP_LCD_V_RES * 2, 0);
     ESP_UTILS_CHECK_FALSE_RETURN(
-        draw_bitmap_with_lock(disp, 0, 0, BSP_LCD_H_RES, BSP_LCD_V_RES, buffer.data()), false, "Draw bitmap failed"
+        clear_area(disp, 0, 0, BSP_LCD_H_RES, BSP_LCD_V_RES), false, "Clear area failed"
     );
 
     return true;
@@ -13,42 +13,100 @@
 #include "lvgl.h"
 #if LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
 
+#include <stdio.h>
+#include <stdlib.h>
+#include "freertos/FreeRTOS.h"
 #include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "lv_mem_slab.h"
+#include "lv_mem_core_custom.h"
 
 /*********************
  *      DEFINES
  *********************/
-#define MEM_CAPS (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
-// #define MEM_CAPS (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
-
-/**********************
- *      TYPEDEFS
- **********************/
+#define LARGE_MEM_CAPS  (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+#define HOT_MEM_CAPS    (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+
+#ifdef CONFIG_EXAMPLE_LVGL_MEM_HOT_ARENA_SIZE
+#   define HOT_ARENA_SIZE   CONFIG_EXAMPLE_LVGL_MEM_HOT_ARENA_SIZE
+#else
+#   define HOT_ARENA_SIZE   (128 * 1024)
+#endif
+
+/* Raw lines without the log prefix, parsed by `test_host/lv_mem_slab` */
+#ifdef CONFIG_EXAMPLE_LVGL_MEM_ENABLE_TRACE
+#   define MEM_TRACE(fmt, ...)  printf("LVMT " fmt "\n", ##__VA_ARGS__)
+#else
+#   define MEM_TRACE(...)
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void *large_malloc(size_t size);
+static void *large_realloc(void *p, size_t size);
+static size_t large_get_size(void *p);
+static void slab_lock(void *ctx);
+static void slab_unlock(void *ctx);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static const char *TAG = "LV_MEM";
+static mem_slab_t s_slab;
+static void *s_hot_arena = NULL;
+static bool s_is_initialized = false;
+static portMUX_TYPE s_slab_mux = portMUX_INITIALIZER_UNLOCKED;
 
-/**********************
- *      MACROS
- **********************/
 /**********************
  *   GLOBAL FUNCTIONS
  **********************/
 
 void lv_mem_init(void)
 {
-    return; /*Nothing to init*/
+    if (s_is_initialized) {
+        return;
+    }
+
+    /* Reserve the hot arena once, it stays in internal SRAM for the whole lifetime of LVGL */
+    if (HOT_ARENA_SIZE > 0) {
+        s_hot_arena = heap_caps_malloc(HOT_ARENA_SIZE, HOT_MEM_CAPS);
+        if (s_hot_arena == NULL) {
+            ESP_LOGW(TAG, "Hot arena (%d bytes) is not available, use PSRAM only", HOT_ARENA_SIZE);
+        }
+    }
+
+    mem_slab_config_t config = {
+        .arena = s_hot_arena,
+        .arena_size = (s_hot_arena != NULL) ? HOT_ARENA_SIZE : 0,
+        .large = {
+            .malloc = large_malloc,
+            .realloc = large_realloc,
+            .free = free,
+            .get_size = large_get_size,
+        },
+        .lock = slab_lock,
+        .unlock = slab_unlock,
+        .lock_ctx = &s_slab_mux,
+    };
+    s_is_initialized = mem_slab_init(&s_slab, &config);
+    if (!s_is_initialized) {
+        ESP_LOGE(TAG, "Initialize slab allocator failed");
+    }
 }
 
 void lv_mem_deinit(void)
 {
-    return; /*Nothing to deinit*/
-
+    if (!s_is_initialized) {
+        return;
+    }
+
+    mem_slab_deinit(&s_slab);
+    if (s_hot_arena != NULL) {
+        heap_caps_free(s_hot_arena);
+        s_hot_arena = NULL;
+    }
+    s_is_initialized = false;
 }
 
 lv_mem_pool_t lv_mem_add_pool(void *mem, size_t bytes)
@@ -68,24 +126,47 @@ void lv_mem_remove_pool(lv_mem_pool_t pool)
 
 void *lv_malloc_core(size_t size)
 {
-    return heap_caps_malloc(size, MEM_CAPS);
+    void *p = mem_slab_malloc(&s_slab, size);
+    MEM_TRACE("a %p %u", p, (unsigned)size);
+    return p;
 }
 
 void *lv_realloc_core(void *p, size_t new_size)
 {
-    return heap_caps_realloc(p, new_size, MEM_CAPS);
+    void *new_p = mem_slab_realloc(&s_slab, p, new_size);
+    MEM_TRACE("r %p %p %u", p, new_p, (unsigned)new_size);
+    return new_p;
 }
 
 void lv_free_core(void *p)
 {
-    free(p);
+    MEM_TRACE("f %p", p);
+    mem_slab_free(&s_slab, p);
 }
 
 void lv_mem_monitor_core(lv_mem_monitor_t *mon_p)
 {
-    /*Not supported*/
-    LV_UNUSED(mon_p);
-    return;
+    mem_slab_stats_t stats;
+    mem_slab_get_stats(&s_slab, &stats);
+
+    /* Only the hot arena is a pool owned by LVGL, the large buffers are part of the PSRAM heap */
+    size_t used_size = stats.arena_size - stats.arena_free_size;
+    size_t peak_size = 0;
+    size_t total_blocks = 0;
+    size_t free_blocks = 0;
+    for (int i = 0; i < MEM_SLAB_CLASS_NUM; i++) {
+        peak_size += stats.classes[i].peak_used_blocks * stats.classes[i].block_size;
+        total_blocks += stats.classes[i].total_blocks;
+        free_blocks += stats.classes[i].total_blocks - stats.classes[i].used_blocks;
+    }
+    mon_p->total_size = stats.arena_size;
+    mon_p->free_size = stats.arena_free_size;
+    mon_p->free_biggest_size = (stats.free_page_num > 0) ? MEM_SLAB_PAGE_SIZE : 0;
+    mon_p->free_cnt = free_blocks + stats.free_page_num;
+    mon_p->used_cnt = total_blocks - free_blocks + stats.large_used_num;
+    mon_p->max_used = peak_size;
+    mon_p->used_pct = (stats.arena_size > 0) ? (used_size * 100 / stats.arena_size) : 0;
+    mon_p->frag_pct = (total_blocks > 0) ? (free_blocks * 100 / total_blocks) : 0;
 }
 
 lv_result_t lv_mem_test_core(void)
@@ -94,8 +175,66 @@ lv_result_t lv_mem_test_core(void)
     return LV_RESULT_OK;
 }
 
+bool lv_mem_core_get_stats(mem_slab_stats_t *stats)
+{
+    if (!s_is_initialized || (stats == NULL)) {
+        return false;
+    }
+
+    mem_slab_get_stats(&s_slab, stats);
+
+    return true;
+}
+
+void lv_mem_core_print_stats(void)
+{
+    mem_slab_stats_t stats;
+    if (!lv_mem_core_get_stats(&stats)) {
+        return;
+    }
+
+    ESP_LOGI(TAG, "Hot arena %u/%u KB used, large %u KB (peak %u KB, %u blocks)",
+             (unsigned)((stats.arena_size - stats.arena_free_size) / 1024), (unsigned)(stats.arena_size / 1024),
+             (unsigned)(stats.large_used_size / 1024), (unsigned)(stats.large_peak_used_size / 1024),
+             (unsigned)stats.large_used_num);
+    for (int i = 0; i < MEM_SLAB_CLASS_NUM; i++) {
+        const mem_slab_class_stats_t *cls = &stats.classes[i];
+        if ((cls->alloc_count == 0) && (cls->fallback_count == 0)) {
+            continue;
+        }
+        ESP_LOGI(TAG, "  %3u B: used %4u/%4u, peak %4u, frag %3u%%, fallback %u", (unsigned)cls->block_size,
+                 (unsigned)cls->used_blocks, (unsigned)cls->total_blocks, (unsigned)cls->peak_used_blocks,
+                 (unsigned)mem_slab_get_class_fragmentation(cls), (unsigned)cls->fallback_count);
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
-#endif /*LV_STDLIB_CLIB*/
+static void *large_malloc(size_t size)
+{
+    return heap_caps_malloc(size, LARGE_MEM_CAPS);
+}
+
+static void *large_realloc(void *p, size_t size)
+{
+    return heap_caps_realloc(p, size, LARGE_MEM_CAPS);
+}
+
+static size_t large_get_size(void *p)
+{
+    return heap_caps_get_allocated_size(p);
+}
+
+static void slab_lock(void *ctx)
+{
+    taskENTER_CRITICAL((portMUX_TYPE *)ctx);
+}
+
+static void slab_unlock(void *ctx)
+{
+    taskEXIT_CRITICAL((portMUX_TYPE *)ctx);
+}
+
+#endif /*LV_STDLIB_CUSTOM*/
@@ -0,0 +1,23 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#pragma once
+
+#include <stdbool.h>
+#include "lv_mem_slab.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Get the statistics of the LVGL allocator, only available with `CONFIG_LV_USE_CUSTOM_MALLOC`
+ */
+bool lv_mem_core_get_stats(mem_slab_stats_t *stats);
+void lv_mem_core_print_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
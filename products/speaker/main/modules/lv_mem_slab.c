@@ -0,0 +1,359 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <string.h>
+#include "lv_mem_slab.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define PAGE_NONE           (0xFFFF)
+#define CLASS_NONE          (0xFF)
+#define ARENA_ALIGN         (16)
+#define ALIGN_UP(x, a)      (((x) + ((a) - 1)) & ~((uintptr_t)(a) - 1))
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void slab_lock(mem_slab_t *slab);
+static void slab_unlock(mem_slab_t *slab);
+static void page_list_remove(mem_slab_t *slab, uint16_t *head, uint16_t index);
+static void page_list_push(mem_slab_t *slab, uint16_t *head, uint16_t index);
+static void *class_alloc(mem_slab_t *slab, uint8_t class_index);
+static void class_free(mem_slab_t *slab, void *p);
+static void large_stats_add(mem_slab_t *slab, void *p, bool is_new, uint8_t fallback_class);
+static void large_stats_sub(mem_slab_t *slab, size_t size);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const uint16_t s_class_sizes[MEM_SLAB_CLASS_NUM] = {16, 32, 48, 64, 96, 128, 192, 256};
+/* Blocks per page of each class, precomputed to keep the division out of the allocation path */
+static const uint16_t s_class_capacities[MEM_SLAB_CLASS_NUM] = {
+    MEM_SLAB_PAGE_SIZE / 16, MEM_SLAB_PAGE_SIZE / 32, MEM_SLAB_PAGE_SIZE / 48, MEM_SLAB_PAGE_SIZE / 64,
+    MEM_SLAB_PAGE_SIZE / 96, MEM_SLAB_PAGE_SIZE / 128, MEM_SLAB_PAGE_SIZE / 192, MEM_SLAB_PAGE_SIZE / 256
+};
+/* Index is `(size + 15) / 16`, value is the smallest class which fits */
+static const uint8_t s_class_lookup[MEM_SLAB_MAX_BLOCK_SIZE / 16 + 1] = {
+    0, 0, 1, 2, 3, 4, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7
+};
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+bool mem_slab_init(mem_slab_t *slab, const mem_slab_config_t *config)
+{
+    if ((slab == NULL) || (config == NULL) || (config->large.malloc == NULL) || (config->large.realloc == NULL) ||
+            (config->large.free == NULL)) {
+        return false;
+    }
+
+    memset(slab, 0, sizeof(mem_slab_t));
+    slab->config = *config;
+    slab->free_page_head = PAGE_NONE;
+    for (int i = 0; i < MEM_SLAB_CLASS_NUM; i++) {
+        slab->partial_heads[i] = PAGE_NONE;
+        slab->stats.classes[i].block_size = s_class_sizes[i];
+    }
+
+    if ((config->arena != NULL) && (config->arena_size > 0)) {
+        uintptr_t start = ALIGN_UP((uintptr_t)config->arena, ARENA_ALIGN);
+        uintptr_t end = (uintptr_t)config->arena + config->arena_size;
+        size_t page_num = (end > start) ? (end - start) / (MEM_SLAB_PAGE_SIZE + sizeof(mem_slab_page_t)) : 0;
+        if (page_num >= PAGE_NONE) {
+            page_num = PAGE_NONE - 1;
+        }
+        /* The page descriptors are placed at the beginning of the arena, followed by the aligned pages */
+        while ((page_num > 0) &&
+                (ALIGN_UP(start + page_num * sizeof(mem_slab_page_t), ARENA_ALIGN) + page_num * MEM_SLAB_PAGE_SIZE > end)) {
+            page_num--;
+        }
+        slab->pages = (mem_slab_page_t *)start;
+        slab->page_base = (uint8_t *)ALIGN_UP(start + page_num * sizeof(mem_slab_page_t), ARENA_ALIGN);
+        slab->page_num = (uint16_t)page_num;
+        for (size_t i = 0; i < page_num; i++) {
+            slab->pages[i].class_index = CLASS_NONE;
+            page_list_push(slab, &slab->free_page_head, (uint16_t)(page_num - 1 - i));
+        }
+    }
+    slab->stats.page_num = slab->page_num;
+    slab->stats.free_page_num = slab->page_num;
+    slab->stats.arena_size = (size_t)slab->page_num * MEM_SLAB_PAGE_SIZE;
+
+    return true;
+}
+
+void mem_slab_deinit(mem_slab_t *slab)
+{
+    if (slab == NULL) {
+        return;
+    }
+    /* The arena and the large blocks are owned by the caller */
+    memset(slab, 0, sizeof(mem_slab_t));
+}
+
+void *mem_slab_malloc(mem_slab_t *slab, size_t size)
+{
+    if (size == 0) {
+        size = 1;
+    }
+
+    uint8_t fallback_class = CLASS_NONE;
+    if ((size <= MEM_SLAB_MAX_BLOCK_SIZE) && (slab->page_num > 0)) {
+        uint8_t class_index = s_class_lookup[(size + 15) >> 4];
+        /* Once the arena is full most of the small blocks fall back, peek at the lists to skip the lock for them. A
+         * stale value only costs one useless attempt or one more block in the large heap. */
+        if ((slab->partial_heads[class_index] != PAGE_NONE) || (slab->free_page_head != PAGE_NONE)) {
+            slab_lock(slab);
+            void *p = class_alloc(slab, class_index);
+            slab_unlock(slab);
+            if (p != NULL) {
+                return p;
+            }
+        }
+        fallback_class = class_index;
+    }
+
+    void *p = slab->config.large.malloc(size);
+    if (p != NULL) {
+        large_stats_add(slab, p, true, fallback_class);
+    }
+
+    return p;
+}
+
+void *mem_slab_realloc(mem_slab_t *slab, void *p, size_t new_size)
+{
+    if (p == NULL) {
+        return mem_slab_malloc(slab, new_size);
+    }
+    if (new_size == 0) {
+        mem_slab_free(slab, p);
+        return NULL;
+    }
+
+    if (mem_slab_check_in_arena(slab, p)) {
+        size_t index = ((uint8_t *)p - slab->page_base) / MEM_SLAB_PAGE_SIZE;
+        size_t block_size = s_class_sizes[slab->pages[index].class_index];
+        if (new_size <= block_size) {
+            return p;
+        }
+        void *new_p = mem_slab_malloc(slab, new_size);
+        if (new_p == NULL) {
+            return NULL;
+        }
+        memcpy(new_p, p, block_size);
+        mem_slab_free(slab, p);
+        return new_p;
+    }
+
+    size_t old_size = (slab->config.large.get_size != NULL) ? slab->config.large.get_size(p) : 0;
+    void *new_p = slab->config.large.realloc(p, new_size);
+    if (new_p != NULL) {
+        large_stats_sub(slab, old_size);
+        large_stats_add(slab, new_p, false, CLASS_NONE);
+    }
+
+    return new_p;
+}
+
+void mem_slab_free(mem_slab_t *slab, void *p)
+{
+    if (p == NULL) {
+        return;
+    }
+
+    if (mem_slab_check_in_arena(slab, p)) {
+        slab_lock(slab);
+        class_free(slab, p);
+        slab_unlock(slab);
+        return;
+    }
+
+    size_t size = (slab->config.large.get_size != NULL) ? slab->config.large.get_size(p) : 0;
+    slab->config.large.free(p);
+    large_stats_sub(slab, size);
+}
+
+bool mem_slab_check_in_arena(const mem_slab_t *slab, const void *p)
+{
+    return ((const uint8_t *)p >= slab->page_base) &&
+           ((const uint8_t *)p < slab->page_base + (size_t)slab->page_num * MEM_SLAB_PAGE_SIZE);
+}
+
+void mem_slab_get_stats(mem_slab_t *slab, mem_slab_stats_t *stats)
+{
+    slab_lock(slab);
+    *stats = slab->stats;
+    slab_unlock(slab);
+
+    stats->arena_free_size = stats->free_page_num * MEM_SLAB_PAGE_SIZE;
+    for (int i = 0; i < MEM_SLAB_CLASS_NUM; i++) {
+        const mem_slab_class_stats_t *class_stats = &stats->classes[i];
+        stats->arena_free_size += (class_stats->total_blocks - class_stats->used_blocks) * class_stats->block_size;
+    }
+}
+
+size_t mem_slab_get_class_fragmentation(const mem_slab_class_stats_t *class_stats)
+{
+    if (class_stats->total_blocks == 0) {
+        return 0;
+    }
+    return (class_stats->total_blocks - class_stats->used_blocks) * 100 / class_stats->total_blocks;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void slab_lock(mem_slab_t *slab)
+{
+    if (slab->config.lock != NULL) {
+        slab->config.lock(slab->config.lock_ctx);
+    }
+}
+
+static void slab_unlock(mem_slab_t *slab)
+{
+    if (slab->config.unlock != NULL) {
+        slab->config.unlock(slab->config.lock_ctx);
+    }
+}
+
+static void page_list_remove(mem_slab_t *slab, uint16_t *head, uint16_t index)
+{
+    mem_slab_page_t *page = &slab->pages[index];
+    if (page->prev != PAGE_NONE) {
+        slab->pages[page->prev].next = page->next;
+    } else {
+        *head = page->next;
+    }
+    if (page->next != PAGE_NONE) {
+        slab->pages[page->next].prev = page->prev;
+    }
+    page->prev = PAGE_NONE;
+    page->next = PAGE_NONE;
+}
+
+static void page_list_push(mem_slab_t *slab, uint16_t *head, uint16_t index)
+{
+    mem_slab_page_t *page = &slab->pages[index];
+    page->prev = PAGE_NONE;
+    page->next = *head;
+    if (*head != PAGE_NONE) {
+        slab->pages[*head].prev = index;
+    }
+    *head = index;
+}
+
+static void *class_alloc(mem_slab_t *slab, uint8_t class_index)
+{
+    mem_slab_class_stats_t *class_stats = &slab->stats.classes[class_index];
+    const uint16_t block_size = s_class_sizes[class_index];
+    const uint16_t capacity = s_class_capacities[class_index];
+
+    uint16_t index = slab->partial_heads[class_index];
+    if (index == PAGE_NONE) {
+        /* Assign a free page to the class */
+        index = slab->free_page_head;
+        if (index == PAGE_NONE) {
+            return NULL;
+        }
+        page_list_remove(slab, &slab->free_page_head, index);
+        mem_slab_page_t *page = &slab->pages[index];
+        page->class_index = class_index;
+        page->used = 0;
+        page->bump = 0;
+        page->free_list = NULL;
+        page_list_push(slab, &slab->partial_heads[class_index], index);
+        slab->stats.free_page_num--;
+        class_stats->page_num++;
+        class_stats->total_blocks += capacity;
+    }
+
+    mem_slab_page_t *page = &slab->pages[index];
+    void *p = NULL;
+    if (page->free_list != NULL) {
+        p = page->free_list;
+        page->free_list = *(void **)p;
+    } else {
+        p = slab->page_base + (size_t)index * MEM_SLAB_PAGE_SIZE + (size_t)page->bump * block_size;
+        page->bump++;
+    }
+    page->used++;
+    if (page->used == capacity) {
+        page_list_remove(slab, &slab->partial_heads[class_index], index);
+    }
+
+    class_stats->used_blocks++;
+    class_stats->alloc_count++;
+    if (class_stats->used_blocks > class_stats->peak_used_blocks) {
+        class_stats->peak_used_blocks = class_stats->used_blocks;
+    }
+
+    return p;
+}
+
+static void class_free(mem_slab_t *slab, void *p)
+{
+    uint16_t index = (uint16_t)(((uint8_t *)p - slab->page_base) / MEM_SLAB_PAGE_SIZE);
+    mem_slab_page_t *page = &slab->pages[index];
+    uint8_t class_index = page->class_index;
+    mem_slab_class_stats_t *class_stats = &slab->stats.classes[class_index];
+    const uint16_t capacity = s_class_capacities[class_index];
+
+    *(void **)p = page->free_list;
+    page->free_list = p;
+    if (page->used == capacity) {
+        page_list_push(slab, &slab->partial_heads[class_index], index);
+    }
+    page->used--;
+    class_stats->used_blocks--;
+
+    /* Give the empty page back to the arena, but keep the last partial page to avoid thrashing */
+    if ((page->used == 0) && ((slab->partial_heads[class_index] != index) || (page->next != PAGE_NONE))) {
+        page_list_remove(slab, &slab->partial_heads[class_index], index);
+        page->class_index = CLASS_NONE;
+        page->free_list = NULL;
+        page_list_push(slab, &slab->free_page_head, index);
+        slab->stats.free_page_num++;
+        class_stats->page_num--;
+        class_stats->total_blocks -= capacity;
+    }
+}
+
+static void large_stats_add(mem_slab_t *slab, void *p, bool is_new, uint8_t fallback_class)
+{
+    size_t size = (slab->config.large.get_size != NULL) ? slab->config.large.get_size(p) : 0;
+    mem_slab_stats_t *stats = &slab->stats;
+
+    slab_lock(slab);
+    if (is_new) {
+        stats->large_alloc_count++;
+    }
+    if (fallback_class != CLASS_NONE) {
+        stats->classes[fallback_class].fallback_count++;
+    }
+    stats->large_used_num++;
+    stats->large_used_size += size;
+    if (stats->large_used_num > stats->large_peak_used_num) {
+        stats->large_peak_used_num = stats->large_used_num;
+    }
+    if (stats->large_used_size > stats->large_peak_used_size) {
+        stats->large_peak_used_size = stats->large_used_size;
+    }
+    slab_unlock(slab);
+}
+
+static void large_stats_sub(mem_slab_t *slab, size_t size)
+{
+    mem_slab_stats_t *stats = &slab->stats;
+
+    slab_lock(slab);
+    stats->large_used_num--;
+    stats->large_used_size -= size;
+    slab_unlock(slab);
+}
@@ -0,0 +1,108 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Size-class slab allocator used as the LVGL memory backend.
+ *
+ * Small blocks (up to `MEM_SLAB_MAX_BLOCK_SIZE`) are carved from fixed-size pages of a reserved "hot" arena, each
+ * page serves one size class and is given back to the arena once it is empty. Larger buffers, and small blocks which
+ * do not fit in the arena anymore, are forwarded to the "large" allocator.
+ *
+ * The allocator does not depend on ESP-IDF, so it can be built and benchmarked on the host.
+ */
+
+#define MEM_SLAB_PAGE_SIZE          (1024)
+#define MEM_SLAB_CLASS_NUM          (8)
+#define MEM_SLAB_MAX_BLOCK_SIZE     (256)
+
+typedef struct {
+    void *(*malloc)(size_t size);
+    void *(*realloc)(void *p, size_t size);
+    void (*free)(void *p);
+    size_t (*get_size)(void *p);    /*!< Optional, usable size of a block, used for the statistics */
+} mem_slab_large_ops_t;
+
+typedef struct {
+    void *arena;                    /*!< Memory of the hot arena, `NULL` to forward all the allocations */
+    size_t arena_size;
+    mem_slab_large_ops_t large;     /*!< Allocator of the large buffers, required */
+    void (*lock)(void *ctx);        /*!< Optional, protect the slab state */
+    void (*unlock)(void *ctx);
+    void *lock_ctx;
+} mem_slab_config_t;
+
+typedef struct {
+    size_t block_size;
+    size_t page_num;                /*!< Pages owned by the class */
+    size_t total_blocks;            /*!< Blocks of the owned pages */
+    size_t used_blocks;
+    size_t peak_used_blocks;
+    uint32_t alloc_count;
+    uint32_t fallback_count;        /*!< Allocations forwarded to the large allocator because the arena is full */
+} mem_slab_class_stats_t;
+
+typedef struct {
+    mem_slab_class_stats_t classes[MEM_SLAB_CLASS_NUM];
+    size_t arena_size;              /*!< Usable size of the arena (pages only) */
+    size_t arena_free_size;         /*!< Free pages and free blocks of the owned pages */
+    size_t page_num;
+    size_t free_page_num;
+    size_t large_used_num;          /*!< Live blocks of the large allocator */
+    size_t large_peak_used_num;
+    size_t large_used_size;         /*!< Only valid if `get_size` is provided */
+    size_t large_peak_used_size;
+    uint32_t large_alloc_count;
+} mem_slab_stats_t;
+
+typedef struct {
+    uint16_t prev;
+    uint16_t next;
+    uint16_t used;                  /*!< Allocated blocks */
+    uint16_t bump;                  /*!< Blocks which have never been allocated since the page is assigned */
+    uint8_t class_index;
+    void *free_list;                /*!< Blocks freed back to the page */
+} mem_slab_page_t;
+
+typedef struct {
+    mem_slab_config_t config;
+    mem_slab_page_t *pages;
+    uint8_t *page_base;
+    uint16_t page_num;
+    uint16_t free_page_head;
+    uint16_t partial_heads[MEM_SLAB_CLASS_NUM];
+    mem_slab_stats_t stats;
+} mem_slab_t;
+
+/**
+ * @brief Initialize the allocator, the arena is split into page descriptors and pages.
+ */
+bool mem_slab_init(mem_slab_t *slab, const mem_slab_config_t *config);
+void mem_slab_deinit(mem_slab_t *slab);
+
+void *mem_slab_malloc(mem_slab_t *slab, size_t size);
+void *mem_slab_realloc(mem_slab_t *slab, void *p, size_t new_size);
+void mem_slab_free(mem_slab_t *slab, void *p);
+
+bool mem_slab_check_in_arena(const mem_slab_t *slab, const void *p);
+void mem_slab_get_stats(mem_slab_t *slab, mem_slab_stats_t *stats);
+
+/**
+ * @brief Free blocks held by the class relative to its owned blocks, the class fragmentation of the arena.
+ */
+size_t mem_slab_get_class_fragmentation(const mem_slab_class_stats_t *class_stats);
+
+#ifdef __cplusplus
+}
+#endif
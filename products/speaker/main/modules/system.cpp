@@ -48,6 +48,10 @@ constexpr size_t FUNCTION_BRIGHTNESS_CHANGE_THREAD_STACK_SIZE = 6 * 1024;
 constexpr bool FUNCTION_BRIGHTNESS_CHANGE_THREAD_STACK_CAPS_EXT = true;
 constexpr int FUNCTION_BRIGHTNESS_CHANGE_STEP = 30;
 
+// Keys of the battery updates posted to the LVGL task
+constexpr uint32_t BATTERY_PERCENT_COMMAND_TAG = 0;
+constexpr uint32_t BATTERY_INFO_COMMAND_TAG = 1;
+
 constexpr int DEVELOPER_MODE_KEY = 0x655;
 
 using namespace esp_brookesia;
@@ -269,17 +273,20 @@ bool system_init()
                     wait_count++;
                 }
 
-                LvLockGuard gui_guard;
-                speaker->getManager().processDisplayScreenChange(
-                    Manager::Screen::MAIN, nullptr
-                );
-                speaker->sendAppEvent(&event_data);
+                // Open it in the LVGL task instead of waiting for the lock
+                ESP_UTILS_CHECK_FALSE_EXIT(LvCommandQueue::getInstance().post([speaker, event_data]() {
+                    speaker->getManager().processDisplayScreenChange(
+                        Manager::Screen::MAIN, nullptr
+                    );
+                    speaker->sendAppEvent(&event_data);
+                }), "Post open app failed");
             }
         } }, std::make_optional<FunctionDefinition::CallbackThreadConfig>({
                                  .name = FUNCTION_OPEN_APP_THREAD_NAME,
                                  .stack_size = FUNCTION_OPEN_APP_THREAD_STACK_SIZE,
                                  .stack_in_ext = FUNCTION_OPEN_APP_THREAD_STACK_CAPS_EXT,
                              }));
+    openApp.setSerialized(true);
     FunctionDefinitionList::requestInstance().addFunction(openApp);
 
     FunctionDefinition setVolume("set_volume", "Adjust the system volume. Range is from 0 to 100.");
@@ -329,6 +336,7 @@ bool system_init()
                                    .stack_size = FUNCTION_VOLUME_CHANGE_THREAD_STACK_SIZE,
                                    .stack_in_ext = FUNCTION_VOLUME_CHANGE_THREAD_STACK_CAPS_EXT,
                                }));
+    setVolume.setSerialized(true);
     FunctionDefinitionList::requestInstance().addFunction(setVolume);
 
     FunctionDefinition setBrightness("set_brightness", "Adjust the system brightness. Range is from 10 to 100.");
@@ -372,6 +380,7 @@ bool system_init()
                                        .stack_size = FUNCTION_BRIGHTNESS_CHANGE_THREAD_STACK_SIZE,
                                        .stack_in_ext = FUNCTION_BRIGHTNESS_CHANGE_THREAD_STACK_CAPS_EXT,
                                    }));
+    setBrightness.setSerialized(true);
     FunctionDefinitionList::requestInstance().addFunction(setBrightness);
 
     /* Process quick settings */
@@ -449,11 +458,15 @@ bool system_init()
             {
                 bat_last_status = status;
 
-                LvLockGuard gui_guard;
-                auto &quick_settings = speaker->getDisplay().getQuickSettings();
+                // Update in the LVGL task instead of locking it, only the latest percent is applied
+                bool is_charging = !status.DSG;
+                int percent = battery_monitor.getBatterySOC();
                 ESP_UTILS_CHECK_FALSE_EXIT(
-                    quick_settings.setBatteryPercent(!status.DSG, battery_monitor.getBatterySOC()),
-                    "Set battery percent failed");
+                    LvCommandQueue::getInstance().post(speaker, BATTERY_PERCENT_COMMAND_TAG, [speaker, is_charging, percent]() {
+                        auto &quick_settings = speaker->getDisplay().getQuickSettings();
+                        ESP_UTILS_CHECK_FALSE_EXIT(
+                            quick_settings.setBatteryPercent(is_charging, percent), "Set battery percent failed");
+                    }), "Post battery percent failed");
             }
         });
     battery_monitor.setMonitorPeriodCallback([speaker, app_settings]()
@@ -759,40 +772,48 @@ static void update_battery_info(Speaker *speaker, const Settings *app_settings)
 {
     ESP_UTILS_LOG_TRACE_GUARD();
 
-    LvLockGuard gui_guard;
+    bool is_charging = battery_monitor.is_charging();
+    int percent = battery_monitor.getBatterySOC();
+    int capacity = battery_monitor.getCapacity();
+    int voltage = battery_monitor.getVoltage();
+    int current = battery_monitor.getCurrent();
 
-    auto &quick_settings = speaker->getDisplay().getQuickSettings();
+    // Update in the LVGL task instead of locking it, only the latest info is applied
     ESP_UTILS_CHECK_FALSE_EXIT(
-        quick_settings.setBatteryPercent(battery_monitor.is_charging(), battery_monitor.getBatterySOC()),
-        "Set battery percent failed");
-
-    char battery_info_str[32] = {0};
-    auto _cell = app_settings->ui.screen_about.getCell(
-        static_cast<int>(SettingsUI_ScreenAboutContainerIndex::DEVICE),
-        static_cast<int>(SettingsUI_ScreenAboutCellIndex::DEVICE_BATTERY_CAPACITY));
-    if (_cell)
+        LvCommandQueue::getInstance().post(speaker, BATTERY_INFO_COMMAND_TAG, [=]()
     {
-        snprintf(battery_info_str, sizeof(battery_info_str), "%dmAh", battery_monitor.getCapacity());
-        _cell->updateRightMainLabel(battery_info_str);
-    }
+        auto &quick_settings = speaker->getDisplay().getQuickSettings();
+        ESP_UTILS_CHECK_FALSE_EXIT(
+            quick_settings.setBatteryPercent(is_charging, percent), "Set battery percent failed");
+
+        char battery_info_str[32] = {0};
+        auto _cell = app_settings->ui.screen_about.getCell(
+            static_cast<int>(SettingsUI_ScreenAboutContainerIndex::DEVICE),
+            static_cast<int>(SettingsUI_ScreenAboutCellIndex::DEVICE_BATTERY_CAPACITY));
+        if (_cell)
+        {
+            snprintf(battery_info_str, sizeof(battery_info_str), "%dmAh", capacity);
+            _cell->updateRightMainLabel(battery_info_str);
+        }
 
-    _cell = app_settings->ui.screen_about.getCell(
-        static_cast<int>(SettingsUI_ScreenAboutContainerIndex::DEVICE),
-        static_cast<int>(SettingsUI_ScreenAboutCellIndex::DEVICE_BATTERY_VOLTAGE));
-    if (_cell)
-    {
-        snprintf(battery_info_str, sizeof(battery_info_str), "%dmV", battery_monitor.getVoltage());
-        _cell->updateRightMainLabel(battery_info_str);
-    }
+        _cell = app_settings->ui.screen_about.getCell(
+            static_cast<int>(SettingsUI_ScreenAboutContainerIndex::DEVICE),
+            static_cast<int>(SettingsUI_ScreenAboutCellIndex::DEVICE_BATTERY_VOLTAGE));
+        if (_cell)
+        {
+            snprintf(battery_info_str, sizeof(battery_info_str), "%dmV", voltage);
+            _cell->updateRightMainLabel(battery_info_str);
+        }
 
-    _cell = app_settings->ui.screen_about.getCell(
-        static_cast<int>(SettingsUI_ScreenAboutContainerIndex::DEVICE),
-        static_cast<int>(SettingsUI_ScreenAboutCellIndex::DEVICE_BATTERY_CURRENT));
-    if (_cell)
-    {
-        snprintf(battery_info_str, sizeof(battery_info_str), "%dmA", battery_monitor.getCurrent());
-        _cell->updateRightMainLabel(battery_info_str);
-    }
+        _cell = app_settings->ui.screen_about.getCell(
+            static_cast<int>(SettingsUI_ScreenAboutContainerIndex::DEVICE),
+            static_cast<int>(SettingsUI_ScreenAboutCellIndex::DEVICE_BATTERY_CURRENT));
+        if (_cell)
+        {
+            snprintf(battery_info_str, sizeof(battery_info_str), "%dmA", current);
+            _cell->updateRightMainLabel(battery_info_str);
+        }
+    }), "Post battery info failed");
 }
 
 void restart_usb_serial_jtag()
@@ -0,0 +1,463 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+/**
+ * Replay LVGL allocation traces on the host, with the slab allocator and with the plain heap, to compare their
+ * speed and fragmentation. Every block is filled with a pattern which is checked before it is freed, so overlapping
+ * blocks are detected as well.
+ *
+ * The trace is the log of the device with `CONFIG_EXAMPLE_LVGL_MEM_ENABLE_TRACE` enabled, only the lines containing
+ * "LVMT " are used:
+ *  - `LVMT a <ptr> <size>`: allocation
+ *  - `LVMT r <old_ptr> <new_ptr> <size>`: reallocation
+ *  - `LVMT f <ptr>`: free
+ *
+ * Without argument, a synthetic trace mimicking the LVGL workload (many small objects, styles, events, timers and
+ * animations plus a few large buffers) is generated, `-` selects it as well. The second argument is the size of the
+ * hot arena, to pick `CONFIG_EXAMPLE_LVGL_MEM_HOT_ARENA_SIZE` from a device trace.
+ *
+ * The host heap is glibc, whose thread cache serves small blocks about as fast as the slab does, and the memory is
+ * all the same, so the speed reported here is only the CPU overhead of the allocator. On the device the large heap is
+ * the PSRAM one, the gain comes from the blocks served by the arena (`arena hit`), which stay in internal SRAM.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__GLIBC__)
+#   include <malloc.h>
+#endif
+#include "lv_mem_slab.h"
+
+#define HOT_ARENA_SIZE      (128 * 1024)
+#define HOT_ARENA_SIZE_MAX  (256 * 1024)
+#define SLOT_NUM_MAX        (1 << 16)
+#define SYNTHETIC_OPS       (200000)
+#define SYNTHETIC_LIVE_MAX  (1500)
+#define REPLAY_ROUNDS       (7)
+
+#define CHECK(cond, fmt, ...) do { \
+        if (!(cond)) { \
+            fprintf(stderr, "FAILED at line %d: " fmt "\n", __LINE__, ##__VA_ARGS__); \
+            exit(1); \
+        } \
+    } while (0)
+
+typedef enum {
+    OP_ALLOC,
+    OP_REALLOC,
+    OP_FREE,
+} op_type_t;
+
+typedef struct {
+    op_type_t type;
+    uint32_t slot;          /*!< Index of the live block, the pointers of the trace are mapped to slots */
+    uint32_t size;
+} op_t;
+
+typedef struct {
+    op_t *ops;
+    size_t op_num;
+    size_t op_cap;
+    uint32_t slot_num;
+} trace_t;
+
+typedef struct {
+    void *p;
+    uint32_t size;
+} slot_t;
+
+typedef struct {
+    const char *name;
+    double ns_per_op;
+    size_t peak_live_size;      /*!< Peak of the requested bytes */
+    size_t large_alloc_count;   /*!< Allocations which reached the large (PSRAM) heap */
+    size_t large_peak_size;
+    mem_slab_stats_t stats;
+} result_t;
+
+/**********************
+ *   TRACE
+ **********************/
+
+static void trace_push(trace_t *trace, op_type_t type, uint32_t slot, uint32_t size)
+{
+    if (trace->op_num == trace->op_cap) {
+        trace->op_cap = (trace->op_cap == 0) ? 1024 : trace->op_cap * 2;
+        trace->ops = realloc(trace->ops, trace->op_cap * sizeof(op_t));
+        CHECK(trace->ops != NULL, "Out of memory");
+    }
+    trace->ops[trace->op_num++] = (op_t) {
+        .type = type, .slot = slot, .size = size
+    };
+    if (slot + 1 > trace->slot_num) {
+        trace->slot_num = slot + 1;
+    }
+}
+
+/* Map the pointers of the trace to slots, the slots of the freed pointers are reused */
+typedef struct {
+    unsigned long long ptrs[SLOT_NUM_MAX];
+    uint32_t free_slots[SLOT_NUM_MAX];
+    uint32_t free_slot_num;
+    uint32_t next_slot;
+} slot_map_t;
+
+static int slot_map_find(slot_map_t *map, unsigned long long ptr)
+{
+    for (uint32_t i = 0; i < map->next_slot; i++) {
+        if (map->ptrs[i] == ptr) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+static uint32_t slot_map_add(slot_map_t *map, unsigned long long ptr)
+{
+    uint32_t slot = (map->free_slot_num > 0) ? map->free_slots[--map->free_slot_num] : map->next_slot++;
+    CHECK(slot < SLOT_NUM_MAX, "Too many live blocks in trace");
+    map->ptrs[slot] = ptr;
+    return slot;
+}
+
+static void slot_map_remove(slot_map_t *map, uint32_t slot)
+{
+    map->ptrs[slot] = 0;
+    map->free_slots[map->free_slot_num++] = slot;
+}
+
+static bool trace_load(trace_t *trace, const char *path)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        return false;
+    }
+
+    static slot_map_t map;
+    memset(&map, 0, sizeof(map));
+    char line[256];
+    while (fgets(line, sizeof(line), file) != NULL) {
+        const char *record = strstr(line, "LVMT ");
+        if (record == NULL) {
+            continue;
+        }
+        record += 5;
+
+        char type = 0;
+        unsigned long long p = 0, new_p = 0;
+        unsigned size = 0;
+        if ((sscanf(record, "%c %llx %u", &type, &p, &size) == 3) && (type == 'a')) {
+            if (p != 0) {
+                trace_push(trace, OP_ALLOC, slot_map_add(&map, p), size);
+            }
+        } else if ((sscanf(record, "%c %llx %llx %u", &type, &p, &new_p, &size) == 4) && (type == 'r')) {
+            int slot = (p != 0) ? slot_map_find(&map, p) : -1;
+            if (slot < 0) {
+                if (new_p != 0) {
+                    trace_push(trace, OP_ALLOC, slot_map_add(&map, new_p), size);
+                }
+            } else if (new_p != 0) {
+                map.ptrs[slot] = new_p;
+                trace_push(trace, OP_REALLOC, (uint32_t)slot, size);
+            }
+        } else if ((sscanf(record, "%c %llx", &type, &p) == 2) && (type == 'f')) {
+            int slot = (p != 0) ? slot_map_find(&map, p) : -1;
+            if (slot >= 0) {
+                trace_push(trace, OP_FREE, (uint32_t)slot, 0);
+                slot_map_remove(&map, (uint32_t)slot);
+            }
+        }
+    }
+    fclose(file);
+
+    return true;
+}
+
+static uint32_t rand_next(uint32_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static uint32_t synthetic_size(uint32_t *state)
+{
+    uint32_t r = rand_next(state) % 1000;
+    if (r < 300) {
+        return 8 + rand_next(state) % 24;       /* Event descriptors, style properties */
+    } else if (r < 600) {
+        return 32 + rand_next(state) % 48;      /* Objects, timers */
+    } else if (r < 850) {
+        return 80 + rand_next(state) % 80;      /* Animations, style arrays */
+    } else if (r < 990) {
+        return 160 + rand_next(state) % 256;    /* Labels text, groups */
+    }
+    return 1024 + rand_next(state) % (32 * 1024); /* Draw buffers, images */
+}
+
+static void trace_generate(trace_t *trace)
+{
+    static uint32_t live[SYNTHETIC_LIVE_MAX];
+    uint32_t live_num = 0;
+    uint32_t next_slot = 0;
+    uint32_t free_slots[SYNTHETIC_LIVE_MAX];
+    uint32_t free_slot_num = 0;
+    uint32_t state = 0x12345678;
+
+    for (int i = 0; i < SYNTHETIC_OPS; i++) {
+        uint32_t r = rand_next(&state) % 100;
+        if ((live_num == 0) || ((r < 50) && (live_num < SYNTHETIC_LIVE_MAX))) {
+            uint32_t slot = (free_slot_num > 0) ? free_slots[--free_slot_num] : next_slot++;
+            live[live_num++] = slot;
+            trace_push(trace, OP_ALLOC, slot, synthetic_size(&state));
+        } else if (r < 55) {
+            trace_push(trace, OP_REALLOC, live[rand_next(&state) % live_num], synthetic_size(&state));
+        } else {
+            uint32_t index = rand_next(&state) % live_num;
+            trace_push(trace, OP_FREE, live[index], 0);
+            free_slots[free_slot_num++] = live[index];
+            live[index] = live[--live_num];
+        }
+    }
+}
+
+/**********************
+ *   REPLAY
+ **********************/
+
+static size_t host_get_size(void *p)
+{
+#if defined(__GLIBC__)
+    return malloc_usable_size(p);
+#else
+    (void)p;
+    return 0;
+#endif
+}
+
+static void fill(const slot_t *slot, uint32_t index)
+{
+    memset(slot->p, (int)(index & 0xFF), slot->size);
+}
+
+static void verify(const slot_t *slot, uint32_t index, uint32_t size)
+{
+    const uint8_t *p = slot->p;
+    for (uint32_t i = 0; i < size; i++) {
+        CHECK(p[i] == (index & 0xFF), "Block of slot %u is corrupted at offset %u", index, i);
+    }
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void replay(const trace_t *trace, const char *name, size_t arena_size, bool check, result_t *result)
+{
+    static uint8_t arena[HOT_ARENA_SIZE_MAX];
+    mem_slab_t slab;
+    mem_slab_config_t config = {
+        .arena = (arena_size > 0) ? arena : NULL,
+        .arena_size = arena_size,
+        .large = {
+            .malloc = malloc,
+            .realloc = realloc,
+            .free = free,
+            .get_size = host_get_size,
+        },
+    };
+    CHECK(mem_slab_init(&slab, &config), "Init slab failed");
+
+    slot_t *slots = calloc(trace->slot_num, sizeof(slot_t));
+    CHECK(slots != NULL, "Out of memory");
+    size_t live_size = 0;
+    memset(result, 0, sizeof(result_t));
+    result->name = name;
+
+    double start = now_ns();
+    for (size_t i = 0; i < trace->op_num; i++) {
+        const op_t *op = &trace->ops[i];
+        slot_t *slot = &slots[op->slot];
+        switch (op->type) {
+        case OP_ALLOC:
+            CHECK(slot->p == NULL, "Slot %u is already allocated", op->slot);
+            slot->p = mem_slab_malloc(&slab, op->size);
+            CHECK(slot->p != NULL, "Alloc %u bytes failed", op->size);
+            slot->size = op->size;
+            live_size += op->size;
+            break;
+        case OP_REALLOC:
+            CHECK(slot->p != NULL, "Slot %u is not allocated", op->slot);
+            if (check) {
+                verify(slot, op->slot, slot->size);
+            }
+            slot->p = mem_slab_realloc(&slab, slot->p, op->size);
+            CHECK(slot->p != NULL, "Realloc %u bytes failed", op->size);
+            if (check) {
+                verify(slot, op->slot, (slot->size < op->size) ? slot->size : op->size);
+            }
+            live_size = live_size - slot->size + op->size;
+            slot->size = op->size;
+            break;
+        case OP_FREE:
+            CHECK(slot->p != NULL, "Slot %u is not allocated", op->slot);
+            if (check) {
+                verify(slot, op->slot, slot->size);
+            }
+            mem_slab_free(&slab, slot->p);
+            live_size -= slot->size;
+            slot->p = NULL;
+            slot->size = 0;
+            break;
+        }
+        if (check && (slot->p != NULL)) {
+            fill(slot, op->slot);
+        }
+        if (live_size > result->peak_live_size) {
+            result->peak_live_size = live_size;
+        }
+    }
+    double elapsed = now_ns() - start;
+
+    mem_slab_get_stats(&slab, &result->stats);
+    result->ns_per_op = (trace->op_num > 0) ? (elapsed / trace->op_num) : 0;
+    result->large_alloc_count = result->stats.large_alloc_count;
+    result->large_peak_size = result->stats.large_peak_used_size;
+
+    for (uint32_t i = 0; i < trace->slot_num; i++) {
+        mem_slab_free(&slab, slots[i].p);
+    }
+    mem_slab_get_stats(&slab, &result->stats);
+    CHECK(result->stats.large_used_num == 0, "Large blocks leaked: %zu", result->stats.large_used_num);
+    CHECK(result->stats.free_page_num + MEM_SLAB_CLASS_NUM >= result->stats.page_num, "Arena pages leaked");
+    for (int i = 0; i < MEM_SLAB_CLASS_NUM; i++) {
+        CHECK(result->stats.classes[i].used_blocks == 0, "Blocks of class %d leaked", i);
+    }
+    // Keep the statistics at the end of the trace for the report
+    result->stats.large_used_num = 0;
+    mem_slab_deinit(&slab);
+    free(slots);
+}
+
+static void print_result(const result_t *result)
+{
+    const mem_slab_stats_t *stats = &result->stats;
+    printf("[%s]\n", result->name);
+    printf("  speed: %.1f ns/op, peak requested: %zu KB\n", result->ns_per_op, result->peak_live_size / 1024);
+    printf("  large heap: %zu allocations, peak %zu KB\n", result->large_alloc_count, result->large_peak_size / 1024);
+    if (stats->page_num == 0) {
+        return;
+    }
+    printf("  hot arena: %zu pages of %d bytes\n", stats->page_num, MEM_SLAB_PAGE_SIZE);
+    for (int i = 0; i < MEM_SLAB_CLASS_NUM; i++) {
+        const mem_slab_class_stats_t *cls = &stats->classes[i];
+        printf("  %3zu B: allocs %7u, peak %5zu blocks, fallback %6u\n", cls->block_size, cls->alloc_count,
+               cls->peak_used_blocks, cls->fallback_count);
+    }
+}
+
+static void test_edge_cases(void)
+{
+    static uint8_t arena[3 * MEM_SLAB_PAGE_SIZE + 256];
+    mem_slab_t slab;
+    mem_slab_config_t config = {
+        .arena = arena + 3,     /* Unaligned on purpose */
+        .arena_size = sizeof(arena) - 3,
+        .large = {.malloc = malloc, .realloc = realloc, .free = free, .get_size = host_get_size},
+    };
+    CHECK(mem_slab_init(&slab, &config), "Init slab failed");
+    CHECK(slab.page_num == 3, "Unexpected page number %u", slab.page_num);
+
+    // Small blocks are in the arena and aligned
+    void *p = mem_slab_malloc(&slab, 20);
+    CHECK(mem_slab_check_in_arena(&slab, p) && (((uintptr_t)p & 15) == 0), "Small block is not in arena");
+    // Growing within the class keeps the block, growing beyond moves it
+    CHECK(mem_slab_realloc(&slab, p, 32) == p, "Realloc within class moved the block");
+    memset(p, 0x5A, 32);
+    void *q = mem_slab_realloc(&slab, p, 1000);
+    CHECK((q != NULL) && !mem_slab_check_in_arena(&slab, q) && (((uint8_t *)q)[31] == 0x5A), "Realloc failed");
+    mem_slab_free(&slab, q);
+
+    // The emptied page of the 32-byte class is kept, so 2 pages (8 blocks of 256 bytes) are left, the next one falls
+    // back to the large heap
+    void *blocks[9];
+    for (int i = 0; i < 9; i++) {
+        blocks[i] = mem_slab_malloc(&slab, 256);
+        CHECK(blocks[i] != NULL, "Alloc failed");
+    }
+    CHECK(!mem_slab_check_in_arena(&slab, blocks[8]), "Arena should be full");
+    mem_slab_stats_t stats;
+    mem_slab_get_stats(&slab, &stats);
+    CHECK(stats.classes[7].fallback_count == 1, "Fallback is not counted");
+    CHECK(stats.free_page_num == 0, "Arena should have no free page");
+    // Empty pages are given back to the arena, except the last one of the class
+    for (int i = 0; i < 9; i++) {
+        mem_slab_free(&slab, blocks[i]);
+    }
+    mem_slab_get_stats(&slab, &stats);
+    CHECK(stats.free_page_num == 1, "Empty pages are not released: %zu", stats.free_page_num);
+    CHECK(stats.large_used_num == 0, "Large block is not released");
+    CHECK(mem_slab_check_in_arena(&slab, p = mem_slab_malloc(&slab, 1)), "Released page is not reused");
+    mem_slab_free(&slab, p);
+    mem_slab_deinit(&slab);
+
+    printf("Edge cases passed\n");
+}
+
+int main(int argc, char **argv)
+{
+    test_edge_cases();
+
+    trace_t trace = {0};
+    if ((argc > 1) && (strcmp(argv[1], "-") != 0)) {
+        CHECK(trace_load(&trace, argv[1]), "Open trace %s failed", argv[1]);
+        printf("Replay %zu operations of %s\n", trace.op_num, argv[1]);
+    } else {
+        trace_generate(&trace);
+        printf("Replay %zu synthetic operations\n", trace.op_num);
+    }
+    size_t arena_size = (argc > 2) ? strtoul(argv[2], NULL, 0) : HOT_ARENA_SIZE;
+    CHECK((arena_size > 0) && (arena_size <= HOT_ARENA_SIZE_MAX), "Arena size must be in (0, %d]", HOT_ARENA_SIZE_MAX);
+
+    // Check the content of every block first, then measure without the checks
+    result_t result;
+    replay(&trace, "check", arena_size, true, &result);
+
+    // Alternate the allocators and keep the fastest round of each, a single round is dominated by the host noise
+    result_t heap_only;
+    result_t slab;
+    for (int i = 0; i < REPLAY_ROUNDS; i++) {
+        result_t round;
+        replay(&trace, "heap only", 0, false, &round);
+        if ((i == 0) || (round.ns_per_op < heap_only.ns_per_op)) {
+            heap_only = round;
+        }
+        replay(&trace, "slab + hot arena", arena_size, false, &round);
+        if ((i == 0) || (round.ns_per_op < slab.ns_per_op)) {
+            slab = round;
+        }
+    }
+    print_result(&heap_only);
+    print_result(&slab);
+
+    if (heap_only.large_alloc_count > 0) {
+        size_t arena_alloc_count = 0;
+        for (int i = 0; i < MEM_SLAB_CLASS_NUM; i++) {
+            arena_alloc_count += slab.stats.classes[i].alloc_count;
+        }
+        printf("Large heap allocations reduced by %.1f%%, arena hit %.1f%%, speed %.2fx\n",
+               100.0 * (double)(heap_only.large_alloc_count - slab.large_alloc_count) / heap_only.large_alloc_count,
+               100.0 * (double)arena_alloc_count / (arena_alloc_count + slab.large_alloc_count),
+               (slab.ns_per_op > 0) ? heap_only.ns_per_op / slab.ns_per_op : 0);
+    }
+    free(trace.ops);
+
+    return 0;
+}
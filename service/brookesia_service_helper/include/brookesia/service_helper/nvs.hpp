@@ -5,10 +5,15 @@
  */
 #pragma once
 
-#include "boost/format.hpp"
+#include <array>
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
 #include "brookesia/lib_utils/describe_helpers.hpp"
 #include "brookesia/service_manager/function/definition.hpp"
 #include "brookesia/service_manager/event/definition.hpp"
+#include "brookesia/service_manager/service/function_stub.hpp"
 
 namespace esp_brookesia::service::helper {
 
@@ -22,6 +27,7 @@ public:
     };
 
     using Value = std::variant<bool, int, std::string>;
+    using Entries = std::map<std::string, Value>;    // key -> value
 
     struct KeyValuePair {
         std::string key;
@@ -39,160 +45,201 @@ public:
         FunctionIndexSet,
         FunctionIndexGet,
         FunctionIndexErase,
+        FunctionIndexFlush,
         FunctionIndexMax,
     };
 
     static constexpr const char *SERVICE_NAME = "nvs";
     static constexpr const char *DEFAULT_NAMESPACE = "storage";
 
+    /**
+     * @brief Get the function definitions, indexed by `FunctionIndex`
+     *
+     * @note The definitions are built from the constant views on the first call
+     */
     static const FunctionSchema *get_function_definitions()
     {
-        static const FunctionSchema FUNCTION_DEFINITIONS[FunctionIndexMax] = {
-            [FunctionIndexList] = {
-                // name
-                "list",
-                // description
-                (boost::format("List information of key-value pairs in the NVS namespace. "
-                               "Return a JSON array of objects. Example: %1%")
-                % BROOKESIA_DESCRIBE_JSON_SERIALIZE(std::vector<EntryInfo>({
-                    {"storage", "key1", ValueType::String},
-                    {"storage", "key2", ValueType::Int}
-                }))).str(),
-                // parameters
-                {
-                    // parameters[0]
-                    {
-                        // name
-                        "nspace",
-                        // description
-                        "The namespace of the NVS namespace to list, optional. "
-                        "If not provided, the default namespace will be used.",
-                        // type
-                        FunctionValueType::String,
-                        // default value
-                        DEFAULT_NAMESPACE
-                    }
-                },
-            },
-            [FunctionIndexSet] = {
-                // name
-                "set",
-                // description
-                "Set key-value pairs in the NVS namespace",
-                // parameters
-                {
-                    // parameters[0]
-                    {
-                        // name
-                        "nspace",
-                        // description
-                        "The namespace of the key-value pairs to set. "
-                        "Optional. If not provided, the default namespace will be used. "
-                        "If provided empty, the default namespace will be used",
-                        // type
-                        FunctionValueType::String,
-                        // default value
-                        DEFAULT_NAMESPACE
-                    },
-                    // parameters[1]
-                    {
-                        // name
-                        "key_value_pairs",
-                        // description
-                        (boost::format("The JSON array of key-value pairs to set. "
-                                       "The value type can be one of the following: %1%. Example: %2%")
-                        % BROOKESIA_DESCRIBE_JSON_SERIALIZE(std::vector<ValueType>({
-                            ValueType::Bool, ValueType::Int, ValueType::String
-                        }))
-                        % BROOKESIA_DESCRIBE_JSON_SERIALIZE(std::vector<KeyValuePair>({
-                            {"key1", std::string("value1")}, {"key2", 2}, {"key3", true}
-                        }))).str(),
-                        // type
-                        FunctionValueType::Array
-                    }
-                }
-            },
-            [FunctionIndexGet] = {
-                // name
-                "get",
-                // description
-                (boost::format("Get key-value pairs from the NVS namespace by keys. "
-                               "Return a JSON object of key-value pairs. Example: %1%")
-                % BROOKESIA_DESCRIBE_JSON_SERIALIZE(boost::json::object({
-                    {"key1", "value1"}, {"key2", 2}, {"key3", true}
-                }))).str(),
-                // parameters
-                {
-                    // parameters[0]
-                    {
-                        // name
-                        "nspace",
-                        // description
-                        "The namespace of the key-value pairs to get, optional. "
-                        "If not provided, the default namespace will be used.",
-                        // type
-                        FunctionValueType::String,
-                        // default value
-                        DEFAULT_NAMESPACE
-                    },
-                    // parameters[1]
-                    {
-                        // name
-                        "keys",
-                        // description
-                        (boost::format("The JSON array of keys to get, optional. "
-                                       "If not provided, all key-value pairs in the namespace will be returned. "
-                                       "Example: %1%")
-                        % BROOKESIA_DESCRIBE_JSON_SERIALIZE(std::vector<std::string>({"key1", "key2", "key3"}))).str(),
-                        // type
-                        FunctionValueType::Array,
-                        // default value
-                        boost::json::array()
-                    }
-                }
-            },
-            [FunctionIndexErase] = {
-                // name
-                "erase",
-                // description
-                "Erase key-value pairs from the NVS namespace",
-                // parameters
-                {
-                    // parameters[0]
-                    {
-                        // name
-                        "nspace",
-                        // description
-                        "The namespace of the key-value pairs to erase, optional. "
-                        "If not provided, the default namespace will be used.",
-                        // type
-                        FunctionValueType::String,
-                        // default value
-                        DEFAULT_NAMESPACE
-                    },
-                    // parameters[1]
-                    {
-                        // name
-                        "keys",
-                        // description
-                        (boost::format("The keys of the key-value pairs to erase, optional. "
-                                       "If not provided or empty, all key-value pairs in the namespace will be erased. "
-                                       "Example: %1%")
-                        % BROOKESIA_DESCRIBE_JSON_SERIALIZE(std::vector<std::string>({"key1", "key2", "key3"}))).str(),
-                        // type
-                        FunctionValueType::Array,
-                        // default value
-                        boost::json::array()
-                    }
-                }
-            },
-        };
+        static const std::array<FunctionSchema, FunctionIndexMax> definitions = [] {
+            std::array<FunctionSchema, FunctionIndexMax> schemas;
+            for (size_t i = 0; i < schemas.size(); i++) {
+                schemas[i] = FUNCTION_DEFINITIONS[i].to_schema();
+            }
+            return schemas;
+        }();
+        return definitions.data();
+    }
+    /**
+     * @brief Get the function definitions as constant views, which are kept in flash
+     */
+    static constexpr std::span<const FunctionSchemaView> get_function_schema_views()
+    {
         return FUNCTION_DEFINITIONS;
     }
+
+    // Typed stubs of the functions, e.g. `NVS::set.call_sync(*nvs, timeout_ms, nspace, {{"key", 1}})`
+    static const FunctionStub<std::vector<EntryInfo>(std::string)> list;
+    static const FunctionStub<void(std::string, std::vector<KeyValuePair>)> set;
+    static const FunctionStub<Entries(std::string, std::vector<std::string>)> get;
+    static const FunctionStub<void(std::string, std::vector<std::string>)> erase;
+    static const FunctionStub<void()> flush;
+
+private:
+    // The examples are the JSON serialized by `BROOKESIA_DESCRIBE_JSON_SERIALIZE()`, written as literals so the
+    // whole table is built at compile time and stays in flash
+    static constexpr FunctionParameterSchemaView LIST_PARAMETERS[] = {
+        {
+            // name
+            "nspace",
+            // description
+            "The namespace of the NVS namespace to list, optional. "
+            "If not provided, the default namespace will be used.",
+            // type
+            FunctionValueType::String,
+            // default value
+            DEFAULT_NAMESPACE
+        },
+    };
+    static constexpr FunctionParameterSchemaView SET_PARAMETERS[] = {
+        {
+            // name
+            "nspace",
+            // description
+            "The namespace of the key-value pairs to set. "
+            "Optional. If not provided, the default namespace will be used. "
+            "If provided empty, the default namespace will be used",
+            // type
+            FunctionValueType::String,
+            // default value
+            DEFAULT_NAMESPACE
+        },
+        {
+            // name
+            "key_value_pairs",
+            // description
+            "The JSON array of key-value pairs to set. "
+            "The value type can be one of the following: [\"Bool\",\"Int\",\"String\"]. "
+            "Example: [{\"key\":\"key1\",\"value\":\"value1\"},{\"key\":\"key2\",\"value\":2},"
+            "{\"key\":\"key3\",\"value\":true}]",
+            // type
+            FunctionValueType::Array
+        },
+    };
+    static constexpr FunctionParameterSchemaView GET_PARAMETERS[] = {
+        {
+            // name
+            "nspace",
+            // description
+            "The namespace of the key-value pairs to get, optional. "
+            "If not provided, the default namespace will be used.",
+            // type
+            FunctionValueType::String,
+            // default value
+            DEFAULT_NAMESPACE
+        },
+        {
+            // name
+            "keys",
+            // description
+            "The JSON array of keys to get, optional. "
+            "If not provided, all key-value pairs in the namespace will be returned. "
+            "Example: [\"key1\",\"key2\",\"key3\"]",
+            // type
+            FunctionValueType::Array,
+            // default value
+            FunctionDefaultValue::from_json("[]")
+        },
+    };
+    static constexpr FunctionParameterSchemaView ERASE_PARAMETERS[] = {
+        {
+            // name
+            "nspace",
+            // description
+            "The namespace of the key-value pairs to erase, optional. "
+            "If not provided, the default namespace will be used.",
+            // type
+            FunctionValueType::String,
+            // default value
+            DEFAULT_NAMESPACE
+        },
+        {
+            // name
+            "keys",
+            // description
+            "The keys of the key-value pairs to erase, optional. "
+            "If not provided or empty, all key-value pairs in the namespace will be erased. "
+            "Example: [\"key1\",\"key2\",\"key3\"]",
+            // type
+            FunctionValueType::Array,
+            // default value
+            FunctionDefaultValue::from_json("[]")
+        },
+    };
+    static constexpr FunctionSchemaView FUNCTION_DEFINITIONS[FunctionIndexMax] = {
+        [FunctionIndexList] = {
+            // name
+            "list",
+            // description
+            "List information of key-value pairs in the NVS namespace. "
+            "Return a JSON array of objects. Example: [{\"nspace\":\"storage\",\"key\":\"key1\",\"type\":\"String\"},"
+            "{\"nspace\":\"storage\",\"key\":\"key2\",\"type\":\"Int\"}]",
+            // parameters
+            LIST_PARAMETERS
+        },
+        [FunctionIndexSet] = {
+            // name
+            "set",
+            // description
+            "Set key-value pairs in the NVS namespace",
+            // parameters
+            SET_PARAMETERS
+        },
+        [FunctionIndexGet] = {
+            // name
+            "get",
+            // description
+            "Get key-value pairs from the NVS namespace by keys. "
+            "Return a JSON object of key-value pairs. Example: {\"key1\":\"value1\",\"key2\":2,\"key3\":true}",
+            // parameters
+            GET_PARAMETERS
+        },
+        [FunctionIndexErase] = {
+            // name
+            "erase",
+            // description
+            "Erase key-value pairs from the NVS namespace",
+            // parameters
+            ERASE_PARAMETERS
+        },
+        [FunctionIndexFlush] = {
+            // name
+            "flush",
+            // description
+            "Commit the pending changes of all the namespaces to the NVS partition immediately. "
+            "The changes are also committed automatically after a short delay",
+            // parameters
+            {}
+        },
+    };
 };
 
 BROOKESIA_DESCRIBE_ENUM(NVS::ValueType, Bool, Int, String, Max);
 BROOKESIA_DESCRIBE_STRUCT(NVS::EntryInfo, (), (nspace, key, type));
 BROOKESIA_DESCRIBE_STRUCT(NVS::KeyValuePair, (), (key, value));
 
+inline constexpr FunctionStub<std::vector<NVS::EntryInfo>(std::string)> NVS::list{
+    SERVICE_NAME, FUNCTION_DEFINITIONS[FunctionIndexList]
+};
+inline constexpr FunctionStub<void(std::string, std::vector<NVS::KeyValuePair>)> NVS::set{
+    SERVICE_NAME, FUNCTION_DEFINITIONS[FunctionIndexSet]
+};
+inline constexpr FunctionStub<NVS::Entries(std::string, std::vector<std::string>)> NVS::get{
+    SERVICE_NAME, FUNCTION_DEFINITIONS[FunctionIndexGet]
+};
+inline constexpr FunctionStub<void(std::string, std::vector<std::string>)> NVS::erase{
+    SERVICE_NAME, FUNCTION_DEFINITIONS[FunctionIndexErase]
+};
+inline constexpr FunctionStub<void()> NVS::flush{
+    SERVICE_NAME, FUNCTION_DEFINITIONS[FunctionIndexFlush]
+};
+
 } // namespace esp_brookesia::service::helper
@@ -5,10 +5,14 @@
  */
 #pragma once
 
-#include "boost/format.hpp"
+#include <array>
+#include <span>
+#include <string>
+#include "boost/json.hpp"
 #include "brookesia/lib_utils/describe_helpers.hpp"
 #include "brookesia/service_manager/function/definition.hpp"
 #include "brookesia/service_manager/event/definition.hpp"
+#include "brookesia/service_manager/service/function_stub.hpp"
 
 namespace esp_brookesia::service::helper {
 
@@ -52,10 +56,11 @@ public:
 
     struct ApInfo {
         ApInfo() = default;
-        ApInfo(const std::string &ssid, bool is_locked, int rssi)
+        ApInfo(const std::string &ssid, bool is_locked, int rssi, const std::string &bssid = "")
             : ssid(ssid)
             , is_locked(is_locked)
             , rssi(rssi)
+            , bssid(bssid)
         {
             if (rssi <= -81) {
                 signal_level = ApSignalLevel::LEVEL_0;
@@ -74,6 +79,7 @@ public:
         bool is_locked;
         int rssi;
         ApSignalLevel signal_level;
+        std::string bssid;      // e.g. "aa:bb:cc:dd:ee:01", empty if not reported by the driver
     };
 
     enum FunctionIndex {
@@ -84,6 +90,7 @@ public:
         FunctionIndexSetConnectAp,
         FunctionIndexGetConnectAp,
         FunctionIndexGetConnectedAps,
+        FunctionIndexGetScanApInfos,
         FunctionIndexMax,
     };
 
@@ -91,222 +98,344 @@ public:
         EventIndexGeneralActionTriggered,
         EventIndexGeneralEventHappened,
         EventIndexScanApInfosUpdated,
+        EventIndexScanApInfosChanged,
         EventIndexMax,
     };
 
     static constexpr const char *SERVICE_NAME = "wifi";
 
+    /**
+     * @brief Get the function definitions, indexed by `FunctionIndex`
+     *
+     * @note The definitions are built from the constant views on the first call
+     */
     static const FunctionSchema *get_function_definitions()
     {
-        static const FunctionSchema FUNCTION_DEFINITIONS[FunctionIndexMax] = {
-            [FunctionIndexTriggerGeneralAction] = {
-                // name
-                "trigger_general_action",
-                // description
-                "Trigger a general action",
-                // parameters
-                {
-                    // parameters[0]
-                    {
-                        // name
-                        "action",
-                        // description
-                        (boost::format("The general action, can be one of the following: %1%") %
-                        BROOKESIA_DESCRIBE_JSON_SERIALIZE(std::vector<GeneralAction>({
-                            GeneralAction::Init, GeneralAction::Deinit, GeneralAction::Start, GeneralAction::Stop,
-                            GeneralAction::Connect, GeneralAction::Disconnect
-                        }))).str(),
-                        // type
-                        FunctionValueType::String
-                    }
-                }
-            },
-            [FunctionIndexTriggerScanStart] = {
-                // name
-                "trigger_scan_start",
-                // description
-                "Trigger WiFi scan start",
-                // parameters
-                {}
-            },
-            [FunctionIndexTriggerScanStop] = {
-                // name
-                "trigger_scan_stop",
-                // description
-                "Trigger WiFi scan stop",
-                // parameters
-                {}
-            },
-            [FunctionIndexSetScanParams] = {
-                // name
-                "set_scan_params",
-                // description
-                "Set the scan parameters",
-                // parameters
-                {
-                    // parameters[0]
-                    {
-                        // name
-                        "ap_count",
-                        // description
-                        "The number of APs to scan, optional",
-                        // type
-                        FunctionValueType::Number,
-                        // default value
-                        20.0
-                    },
-                    // parameters[1]
-                    {
-                        // name
-                        "interval_ms",
-                        // description
-                        "The interval of the scan in milliseconds, optional",
-                        // type
-                        FunctionValueType::Number,
-                        // default value
-                        10000.0
-                    },
-                    // parameters[2]
-                    {
-                        // name
-                        "timeout_ms",
-                        // description
-                        "The timeout of the scan in milliseconds, optional",
-                        // type
-                        FunctionValueType::Number,
-                        // default value
-                        60000.0
-                    }
-                }
-            },
-            [FunctionIndexSetConnectAp] = {
-                // name
-                "set_connect_ap",
-                // description
-                "Set the SSID and password of the AP to connect to",
-                // parameters
-                {
-                    // parameters[0]
-                    {
-                        // name
-                        "ssid",
-                        // description
-                        "The SSID of the AP, required",
-                        // type
-                        FunctionValueType::String
-                    },
-                    // parameters[1]
-                    {
-                        // name
-                        "password",
-                        // description
-                        "The password of the AP, optional",
-                        // type
-                        FunctionValueType::String,
-                        // default value
-                        ""
-                    }
-                }
-            },
-            [FunctionIndexGetConnectAp] = {
-                // name
-                "get_connect_ap",
-                // description
-                (boost::format("Get the connect AP SSID. Return a string. Example: %1%")
-                 % BROOKESIA_DESCRIBE_JSON_SERIALIZE(std::string("ssid1"))).str(),
-                // parameters
-                {}
-            },
-            [FunctionIndexGetConnectedAps] = {
-                // name
-                "get_connected_aps",
-                // description
-                (boost::format("Get the connected AP SSIDs. Return a JSON array of strings. Example: %1%")
-                % BROOKESIA_DESCRIBE_JSON_SERIALIZE(std::vector<std::string>({"ssid1", "ssid2", "ssid3"}))).str(),
-                // parameters
-                {}
-            },
-        };
+        static const std::array<FunctionSchema, FunctionIndexMax> definitions = [] {
+            std::array<FunctionSchema, FunctionIndexMax> schemas;
+            for (size_t i = 0; i < schemas.size(); i++) {
+                schemas[i] = FUNCTION_DEFINITIONS[i].to_schema();
+            }
+            return schemas;
+        }();
+        return definitions.data();
+    }
+    /**
+     * @brief Get the function definitions as constant views, which are kept in flash
+     */
+    static constexpr std::span<const FunctionSchemaView> get_function_schema_views()
+    {
         return FUNCTION_DEFINITIONS;
     }
+    /**
+     * @brief Get the event definitions, indexed by `EventIndex`
+     *
+     * @note The definitions are built from the constant views on the first call
+     */
     static const EventSchema *get_event_definitions()
     {
-        static const EventSchema EVENT_DEFINITIONS[EventIndexMax] = {
-            [EventIndexGeneralActionTriggered] = {
-                // name
-                "general_action_triggered",
-                // description
-                "General action triggered event, will be triggered when a general action is triggered successfully",
-                // items
-                {
-                    // items[0]
-                    {
-                        // name
-                        "action",
-                        // description
-                        (boost::format("The general action, can be one of the following: %1%") %
-                        BROOKESIA_DESCRIBE_JSON_SERIALIZE(std::vector<GeneralAction>({
-                            GeneralAction::Init, GeneralAction::Deinit, GeneralAction::Start, GeneralAction::Stop,
-                            GeneralAction::Connect, GeneralAction::Disconnect
-                        }))).str(),
-                        // type
-                        EventItemType::String
-                    },
-                }
-            },
-            [EventIndexGeneralEventHappened] = {
-                // name
-                "general_event_happened",
-                // description
-                "General event happened event, will be triggered when a general event happens",
-                // items
-                {
-                    // items[0]
-                    {
-                        // name
-                        "event",
-                        // description
-                        (boost::format("The general event happened, can be one of the following: %1%") %
-                        BROOKESIA_DESCRIBE_JSON_SERIALIZE(std::vector<GeneralEvent>({
-                            GeneralEvent::Deinited, GeneralEvent::Inited, GeneralEvent::Stopped, GeneralEvent::Started,
-                            GeneralEvent::Disconnected, GeneralEvent::Connected
-                        }))).str(),
-                        // type
-                        EventItemType::String
-                    },
-                }
-            },
-            [EventIndexScanApInfosUpdated] = {
-                // name
-                "scan_ap_infos_updated",
-                // description
-                "Scan AP infos updated event, will be triggered when the scan AP infos are updated",
-                // items
-                {
-                    // items[0]
-                    {
-                        // name
-                        "ap_infos",
-                        // description
-                        (boost::format("The scan AP infos, a JSON array of objects. Example: %1%") %
-                        BROOKESIA_DESCRIBE_JSON_SERIALIZE(std::vector<ApInfo>({
-                            ApInfo("ssid1", false, -81), ApInfo("ssid2", true, -71), ApInfo("ssid3", false, -61),
-                            ApInfo("ssid4", true, -51), ApInfo("ssid5", false, -41)
-                        }))).str(),
-                        // type
-                        EventItemType::Array
-                    }
-                }
-            },
-        };
+        static const std::array<EventSchema, EventIndexMax> definitions = [] {
+            std::array<EventSchema, EventIndexMax> schemas;
+            for (size_t i = 0; i < schemas.size(); i++) {
+                schemas[i] = EVENT_DEFINITIONS[i].to_schema();
+            }
+            return schemas;
+        }();
+        return definitions.data();
+    }
+    /**
+     * @brief Get the event definitions as constant views, which are kept in flash
+     */
+    static constexpr std::span<const EventSchemaView> get_event_schema_views()
+    {
         return EVENT_DEFINITIONS;
     }
+
+    // Typed stubs of the functions, e.g. `Wifi::set_connect_ap.call_sync(*wifi, timeout_ms, ssid, password)`
+    static const FunctionStub<void(std::string)> trigger_general_action;
+    static const FunctionStub<void()> trigger_scan_start;
+    static const FunctionStub<void()> trigger_scan_stop;
+    static const FunctionStub<void(double, double, double)> set_scan_params;
+    static const FunctionStub<void(std::string, std::string)> set_connect_ap;
+    static const FunctionStub<std::string()> get_connect_ap;
+    static const FunctionStub<boost::json::array()> get_connected_aps;
+    static const FunctionStub<boost::json::object()> get_scan_ap_infos;
+
+private:
+    // The examples are the JSON serialized by `BROOKESIA_DESCRIBE_JSON_SERIALIZE()`, written as literals so the
+    // whole table is built at compile time and stays in flash
+    static constexpr FunctionParameterSchemaView TRIGGER_GENERAL_ACTION_PARAMETERS[] = {
+        {
+            // name
+            "action",
+            // description
+            "The general action, can be one of the following: "
+            "[\"Init\",\"Deinit\",\"Start\",\"Stop\",\"Connect\",\"Disconnect\"]",
+            // type
+            FunctionValueType::String
+        },
+    };
+    static constexpr FunctionParameterSchemaView SET_SCAN_PARAMS_PARAMETERS[] = {
+        {
+            // name
+            "ap_count",
+            // description
+            "The number of APs to scan, optional",
+            // type
+            FunctionValueType::Number,
+            // default value
+            20.0
+        },
+        {
+            // name
+            "interval_ms",
+            // description
+            "The interval of the scan in milliseconds, optional",
+            // type
+            FunctionValueType::Number,
+            // default value
+            10000.0
+        },
+        {
+            // name
+            "timeout_ms",
+            // description
+            "The timeout of the scan in milliseconds, optional",
+            // type
+            FunctionValueType::Number,
+            // default value
+            60000.0
+        },
+    };
+    static constexpr FunctionParameterSchemaView SET_CONNECT_AP_PARAMETERS[] = {
+        {
+            // name
+            "ssid",
+            // description
+            "The SSID of the AP, required",
+            // type
+            FunctionValueType::String
+        },
+        {
+            // name
+            "password",
+            // description
+            "The password of the AP, optional",
+            // type
+            FunctionValueType::String,
+            // default value
+            ""
+        },
+    };
+    static constexpr FunctionSchemaView FUNCTION_DEFINITIONS[FunctionIndexMax] = {
+        [FunctionIndexTriggerGeneralAction] = {
+            // name
+            "trigger_general_action",
+            // description
+            "Trigger a general action",
+            // parameters
+            TRIGGER_GENERAL_ACTION_PARAMETERS
+        },
+        [FunctionIndexTriggerScanStart] = {
+            // name
+            "trigger_scan_start",
+            // description
+            "Trigger WiFi scan start",
+        },
+        [FunctionIndexTriggerScanStop] = {
+            // name
+            "trigger_scan_stop",
+            // description
+            "Trigger WiFi scan stop",
+        },
+        [FunctionIndexSetScanParams] = {
+            // name
+            "set_scan_params",
+            // description
+            "Set the scan parameters",
+            // parameters
+            SET_SCAN_PARAMS_PARAMETERS
+        },
+        [FunctionIndexSetConnectAp] = {
+            // name
+            "set_connect_ap",
+            // description
+            "Set the SSID and password of the AP to connect to",
+            // parameters
+            SET_CONNECT_AP_PARAMETERS
+        },
+        [FunctionIndexGetConnectAp] = {
+            // name
+            "get_connect_ap",
+            // description
+            "Get the connect AP SSID. Return a string. Example: \"ssid1\"",
+        },
+        [FunctionIndexGetConnectedAps] = {
+            // name
+            "get_connected_aps",
+            // description
+            "Get the connected AP SSIDs. Return a JSON array of strings. Example: [\"ssid1\",\"ssid2\",\"ssid3\"]",
+        },
+        [FunctionIndexGetScanApInfos] = {
+            // name
+            "get_scan_ap_infos",
+            // description
+            "Get all the scanned APs, sorted by RSSI in descending order, and the sequence number of the last "
+            "`scan_ap_infos_changed` event they include. Call it after subscribing to `scan_ap_infos_changed`, then "
+            "only apply the events with a greater sequence number. Return a JSON object. Example: "
+            "{\"sequence\":3,\"ap_infos\":["
+            "{\"ssid\":\"ssid1\",\"is_locked\":true,\"rssi\":-51,\"signal_level\":\"LEVEL_3\","
+            "\"bssid\":\"aa:bb:cc:dd:ee:01\"}]}",
+        },
+    };
+
+    static constexpr EventItemSchemaView GENERAL_ACTION_TRIGGERED_ITEMS[] = {
+        {
+            // name
+            "action",
+            // description
+            "The general action, can be one of the following: "
+            "[\"Init\",\"Deinit\",\"Start\",\"Stop\",\"Connect\",\"Disconnect\"]",
+            // type
+            EventItemType::String
+        },
+    };
+    static constexpr EventItemSchemaView GENERAL_EVENT_HAPPENED_ITEMS[] = {
+        {
+            // name
+            "event",
+            // description
+            "The general event happened, can be one of the following: "
+            "[\"Deinited\",\"Inited\",\"Stopped\",\"Started\",\"Disconnected\",\"Connected\"]",
+            // type
+            EventItemType::String
+        },
+    };
+    static constexpr EventItemSchemaView SCAN_AP_INFOS_UPDATED_ITEMS[] = {
+        {
+            // name
+            "ap_infos",
+            // description
+            "The scan AP infos, a JSON array of objects. Example: ["
+            "{\"ssid\":\"ssid1\",\"is_locked\":false,\"rssi\":-81,\"signal_level\":\"LEVEL_0\","
+            "\"bssid\":\"aa:bb:cc:dd:ee:01\"},"
+            "{\"ssid\":\"ssid2\",\"is_locked\":true,\"rssi\":-71,\"signal_level\":\"LEVEL_1\","
+            "\"bssid\":\"aa:bb:cc:dd:ee:02\"},"
+            "{\"ssid\":\"ssid3\",\"is_locked\":false,\"rssi\":-61,\"signal_level\":\"LEVEL_2\","
+            "\"bssid\":\"aa:bb:cc:dd:ee:03\"},"
+            "{\"ssid\":\"ssid4\",\"is_locked\":true,\"rssi\":-51,\"signal_level\":\"LEVEL_3\","
+            "\"bssid\":\"aa:bb:cc:dd:ee:04\"},"
+            "{\"ssid\":\"ssid5\",\"is_locked\":false,\"rssi\":-41,\"signal_level\":\"LEVEL_4\","
+            "\"bssid\":\"aa:bb:cc:dd:ee:05\"}]",
+            // type
+            EventItemType::Array
+        },
+    };
+    static constexpr EventItemSchemaView SCAN_AP_INFOS_CHANGED_ITEMS[] = {
+        {
+            // name
+            "sequence",
+            // description
+            "The sequence number of the change, incremented by one for each event",
+            // type
+            EventItemType::Number
+        },
+        {
+            // name
+            "added",
+            // description
+            "The APs scanned for the first time, a JSON array of objects. Example: ["
+            "{\"ssid\":\"ssid1\",\"is_locked\":false,\"rssi\":-81,\"signal_level\":\"LEVEL_0\","
+            "\"bssid\":\"aa:bb:cc:dd:ee:01\"}]",
+            // type
+            EventItemType::Array
+        },
+        {
+            // name
+            "changed",
+            // description
+            "The APs whose lock or RSSI changed, a JSON array of objects. Example: ["
+            "{\"ssid\":\"ssid2\",\"is_locked\":true,\"rssi\":-61,\"signal_level\":\"LEVEL_2\","
+            "\"bssid\":\"aa:bb:cc:dd:ee:02\"}]",
+            // type
+            EventItemType::Array
+        },
+        {
+            // name
+            "removed",
+            // description
+            "The BSSIDs of the APs no longer scanned (their SSIDs if the BSSIDs are not reported), a JSON array of "
+            "strings. Example: [\"aa:bb:cc:dd:ee:03\"]",
+            // type
+            EventItemType::Array
+        },
+    };
+    static constexpr EventSchemaView EVENT_DEFINITIONS[EventIndexMax] = {
+        [EventIndexGeneralActionTriggered] = {
+            // name
+            "general_action_triggered",
+            // description
+            "General action triggered event, will be triggered when a general action is triggered successfully",
+            // items
+            GENERAL_ACTION_TRIGGERED_ITEMS
+        },
+        [EventIndexGeneralEventHappened] = {
+            // name
+            "general_event_happened",
+            // description
+            "General event happened event, will be triggered when a general event happens",
+            // items
+            GENERAL_EVENT_HAPPENED_ITEMS
+        },
+        [EventIndexScanApInfosUpdated] = {
+            // name
+            "scan_ap_infos_updated",
+            // description
+            "Scan AP infos updated event, will be triggered with all the scanned APs when they change",
+            // items
+            SCAN_AP_INFOS_UPDATED_ITEMS
+        },
+        [EventIndexScanApInfosChanged] = {
+            // name
+            "scan_ap_infos_changed",
+            // description
+            "Scan AP infos changed event, will be triggered with the added, changed and removed APs when the scanned "
+            "APs change",
+            // items
+            SCAN_AP_INFOS_CHANGED_ITEMS
+        },
+    };
 };
 
 BROOKESIA_DESCRIBE_ENUM(Wifi::GeneralState, Deinited, Inited, Started, Connected, Max);
 BROOKESIA_DESCRIBE_ENUM(Wifi::GeneralAction, Init, Deinit, Start, Stop, Connect, Disconnect);
 BROOKESIA_DESCRIBE_ENUM(Wifi::GeneralEvent, Deinited, Inited, Stopped, Started, Disconnected, Connected);
 BROOKESIA_DESCRIBE_ENUM(Wifi::ApSignalLevel, LEVEL_0, LEVEL_1, LEVEL_2, LEVEL_3, LEVEL_4);
-BROOKESIA_DESCRIBE_STRUCT(Wifi::ApInfo, (), (ssid, is_locked, rssi, signal_level));
+BROOKESIA_DESCRIBE_STRUCT(Wifi::ApInfo, (), (ssid, is_locked, rssi, signal_level, bssid));
+
+inline constexpr FunctionStub<void(std::string)> Wifi::trigger_general_action{
+    SERVICE_NAME, FUNCTION_DEFINITIONS[FunctionIndexTriggerGeneralAction]
+};
+inline constexpr FunctionStub<void()> Wifi::trigger_scan_start{
+    SERVICE_NAME, FUNCTION_DEFINITIONS[FunctionIndexTriggerScanStart]
+};
+inline constexpr FunctionStub<void()> Wifi::trigger_scan_stop{
+    SERVICE_NAME, FUNCTION_DEFINITIONS[FunctionIndexTriggerScanStop]
+};
+inline constexpr FunctionStub<void(double, double, double)> Wifi::set_scan_params{
+    SERVICE_NAME, FUNCTION_DEFINITIONS[FunctionIndexSetScanParams]
+};
+inline constexpr FunctionStub<void(std::string, std::string)> Wifi::set_connect_ap{
+    SERVICE_NAME, FUNCTION_DEFINITIONS[FunctionIndexSetConnectAp]
+};
+inline constexpr FunctionStub<std::string()> Wifi::get_connect_ap{
+    SERVICE_NAME, FUNCTION_DEFINITIONS[FunctionIndexGetConnectAp]
+};
+inline constexpr FunctionStub<boost::json::array()> Wifi::get_connected_aps{
+    SERVICE_NAME, FUNCTION_DEFINITIONS[FunctionIndexGetConnectedAps]
+};
+inline constexpr FunctionStub<boost::json::object()> Wifi::get_scan_ap_infos{
+    SERVICE_NAME, FUNCTION_DEFINITIONS[FunctionIndexGetScanApInfos]
+};
 
 } // namespace esp_brookesia::service::helper
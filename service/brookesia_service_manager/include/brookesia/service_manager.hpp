@@ -13,10 +13,13 @@
 /* Function */
 #include "service_manager/function/definition.hpp"
 #include "service_manager/function/registry.hpp"
+#include "service_manager/function/typed_handler.hpp"
 /* Service */
 #include "service_manager/service/base.hpp"
+#include "service_manager/service/function_stub.hpp"
 #include "service_manager/service/manager.hpp"
 #include "service_manager/service/local_runner.hpp"
+#include "service_manager/service/tool_adapter.hpp"
 /* RPC */
 #include "service_manager/rpc/data_link_base.hpp"
 #include "service_manager/rpc/data_link_client.hpp"
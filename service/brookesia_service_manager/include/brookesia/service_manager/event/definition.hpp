@@ -5,11 +5,15 @@
  */
 #pragma once
 
+#include <functional>
+#include <map>
+#include <span>
 #include <string>
 #include <vector>
 #include <variant>
 #include "boost/json.hpp"
 #include "brookesia/lib_utils/describe_helpers.hpp"
+#include "brookesia/service_manager/schema_string.hpp"
 
 namespace esp_brookesia::service {
 
@@ -23,7 +27,26 @@ enum class EventItemType {
 BROOKESIA_DESCRIBE_ENUM(EventItemType, Boolean, Number, String, Object, Array)
 
 using EventItem = std::variant <bool, double, std::string, boost::json::object, boost::json::array>;
-using EventItemMap = std::map<std::string /* name */, EventItem /* value */>;
+// Transparent comparator, so the schema names are looked up without building a `std::string`
+using EventItemMap = std::map<std::string /* name */, EventItem /* value */, std::less<>>;
+
+inline bool is_compatible_event_item(EventItemType type, const EventItem &item)
+{
+    switch (type) {
+    case EventItemType::Boolean:
+        return std::holds_alternative<bool>(item);
+    case EventItemType::Number:
+        return std::holds_alternative<double>(item);
+    case EventItemType::String:
+        return std::holds_alternative<std::string>(item);
+    case EventItemType::Object:
+        return std::holds_alternative<boost::json::object>(item);
+    case EventItemType::Array:
+        return std::holds_alternative<boost::json::array>(item);
+    default:
+        return false;
+    }
+}
 
 struct EventItemSchema {
     std::string name;
@@ -32,20 +55,7 @@ struct EventItemSchema {
 
     bool is_compatible_item(const EventItem &item) const
     {
-        switch (type) {
-        case EventItemType::Boolean:
-            return std::holds_alternative<bool>(item);
-        case EventItemType::Number:
-            return std::holds_alternative<double>(item);
-        case EventItemType::String:
-            return std::holds_alternative<std::string>(item);
-        case EventItemType::Object:
-            return std::holds_alternative<boost::json::object>(item);
-        case EventItemType::Array:
-            return std::holds_alternative<boost::json::array>(item);
-        default:
-            return false;
-        }
+        return is_compatible_event_item(type, item);
     }
 };
 BROOKESIA_DESCRIBE_STRUCT(EventItemSchema, (), (name, description, type))
@@ -57,4 +67,48 @@ struct EventSchema {
 };
 BROOKESIA_DESCRIBE_STRUCT(EventSchema, (), (name, description, items))
 
+/**
+ * @brief Constant counterpart of `EventItemSchema`, which can be built in a constant expression
+ */
+struct EventItemSchemaView {
+    SchemaString name;
+    SchemaString description = {};
+    EventItemType type = EventItemType::String;
+
+    bool is_compatible_item(const EventItem &item) const
+    {
+        return is_compatible_event_item(type, item);
+    }
+    EventItemSchema to_schema() const
+    {
+        return EventItemSchema{
+            .name = name,
+            .description = description,
+            .type = type,
+        };
+    }
+};
+
+/**
+ * @brief Constant counterpart of `EventSchema`, the strings and the items are only referenced
+ */
+struct EventSchemaView {
+    SchemaString name;
+    SchemaString description = {};
+    std::span<const EventItemSchemaView> items = {};
+
+    EventSchema to_schema() const
+    {
+        EventSchema schema{
+            .name = name,
+            .description = description,
+        };
+        schema.items.reserve(items.size());
+        for (const auto &item : items) {
+            schema.items.push_back(item.to_schema());
+        }
+        return schema;
+    }
+};
+
 } // namespace esp_brookesia::service
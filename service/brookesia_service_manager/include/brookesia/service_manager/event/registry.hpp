@@ -10,6 +10,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 #include "boost/json.hpp"
 #include "boost/signals2.hpp"
 #include "boost/thread.hpp"
@@ -28,6 +29,10 @@ public:
     ~EventRegistry() = default;
 
     bool add(EventSchema &&event_def);
+    /**
+     * @brief Add an event with a constant schema, the schema is referenced and must outlive the registry
+     */
+    bool add(const EventSchemaView &event_def);
     void remove(const std::string &event_name);
     void remove_all();
 
@@ -48,14 +53,23 @@ public:
     }
     std::vector<EventSchema> get_schemas();
     boost::json::array get_schemas_json();
+    bool get_item_names(const std::string &event_name, std::vector<std::string> &names);
     Subscriptions get_subscriptions(const std::string &event_name);
     Signal *get_signal(const std::string &event_name);
 
 private:
-    using EventInfo = std::tuple<Subscriptions, EventSchema, std::unique_ptr<Signal>>;
+    // Storage of the schemas registered by value, the view of the event points into it
+    struct OwnedSchema {
+        EventSchema schema;
+        std::vector<EventItemSchemaView> items;
+    };
+    using EventInfo = std::tuple<Subscriptions, EventSchemaView, std::unique_ptr<Signal>, std::unique_ptr<OwnedSchema>>;
+
+    bool add_internal(const EventSchemaView &event_def, std::unique_ptr<OwnedSchema> owned);
 
     boost::mutex event_infos_mutex_;
-    std::map<std::string /*name*/, EventInfo> event_infos_;
+    // The keys reference the names of the schemas
+    std::map<std::string_view /*name*/, EventInfo> event_infos_;
 };
 
 } // namespace esp_brookesia::service
@@ -5,13 +5,17 @@
  */
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <optional>
 #include <map>
+#include <span>
 #include <vector>
 #include <variant>
 #include "boost/json.hpp"
 #include "brookesia/lib_utils/describe_helpers.hpp"
+#include "brookesia/service_manager/schema_string.hpp"
 
 namespace esp_brookesia::service {
 
@@ -24,7 +28,26 @@ enum class FunctionValueType {
 };
 
 using FunctionValue = std::variant <bool, double, std::string, boost::json::object, boost::json::array>;
-using FunctionParameterMap = std::map<std::string, FunctionValue>;
+// Transparent comparator, so the schema names are looked up without building a `std::string`
+using FunctionParameterMap = std::map<std::string, FunctionValue, std::less<>>;
+
+inline bool is_compatible_function_value(FunctionValueType type, const FunctionValue &value)
+{
+    switch (type) {
+    case FunctionValueType::Boolean:
+        return std::holds_alternative<bool>(value);
+    case FunctionValueType::Number:
+        return std::holds_alternative<double>(value);
+    case FunctionValueType::String:
+        return std::holds_alternative<std::string>(value);
+    case FunctionValueType::Object:
+        return std::holds_alternative<boost::json::object>(value);
+    case FunctionValueType::Array:
+        return std::holds_alternative<boost::json::array>(value);
+    default:
+        return false;
+    }
+}
 
 struct FunctionParameterSchema {
     std::string name;
@@ -34,20 +57,7 @@ struct FunctionParameterSchema {
 
     bool is_compatible_value(const FunctionValue &value) const
     {
-        switch (type) {
-        case FunctionValueType::Boolean:
-            return std::holds_alternative<bool>(value);
-        case FunctionValueType::Number:
-            return std::holds_alternative<double>(value);
-        case FunctionValueType::String:
-            return std::holds_alternative<std::string>(value);
-        case FunctionValueType::Object:
-            return std::holds_alternative<boost::json::object>(value);
-        case FunctionValueType::Array:
-            return std::holds_alternative<boost::json::array>(value);
-        default:
-            return false;
-        }
+        return is_compatible_function_value(type, value);
     }
     bool is_required() const
     {
@@ -61,6 +71,158 @@ struct FunctionSchema {
     std::vector<FunctionParameterSchema> parameters = {};
 };
 
+/**
+ * @brief Default value of a constant parameter schema
+ *
+ * Booleans, numbers and strings are stored as is. Objects and arrays are stored as a JSON literal (e.g. `"[]"`) and
+ * only parsed when the default value is actually used.
+ */
+class FunctionDefaultValue {
+public:
+    constexpr FunctionDefaultValue() = default;
+    constexpr FunctionDefaultValue(bool value)
+        : kind_(Kind::Boolean)
+        , boolean_(value)
+    {}
+    constexpr FunctionDefaultValue(double value)
+        : kind_(Kind::Number)
+        , number_(value)
+    {}
+    constexpr FunctionDefaultValue(const char *value)
+        : kind_(Kind::String)
+        , text_(value)
+    {}
+
+    static constexpr FunctionDefaultValue from_json(std::string_view json)
+    {
+        FunctionDefaultValue value;
+        value.kind_ = Kind::Json;
+        value.text_ = json;
+        return value;
+    }
+    static FunctionDefaultValue from_value(const FunctionValue &value)
+    {
+        FunctionDefaultValue default_value;
+        default_value.kind_ = Kind::Reference;
+        default_value.reference_ = &value;
+        return default_value;
+    }
+
+    constexpr bool has_value() const
+    {
+        return kind_ != Kind::None;
+    }
+
+    FunctionValue value() const
+    {
+        switch (kind_) {
+        case Kind::Boolean:
+            return boolean_;
+        case Kind::Number:
+            return number_;
+        case Kind::String:
+            return std::string(text_);
+        case Kind::Json: {
+            boost::system::error_code ec;
+            auto json = boost::json::parse(text_, ec);
+            if (!ec && json.is_object()) {
+                return std::move(json.as_object());
+            }
+            if (!ec && json.is_array()) {
+                return std::move(json.as_array());
+            }
+            // Keep the raw text, it will be reported as a type mismatch by the handler
+            return std::string(text_);
+        }
+        case Kind::Reference:
+            return *reference_;
+        default:
+            return FunctionValue();
+        }
+    }
+
+private:
+    enum class Kind : uint8_t {
+        None,
+        Boolean,
+        Number,
+        String,
+        Json,
+        Reference,  // Points to the default value of a `FunctionParameterSchema`
+    };
+
+    Kind kind_ = Kind::None;
+    bool boolean_ = false;
+    double number_ = 0;
+    std::string_view text_ = {};
+    const FunctionValue *reference_ = nullptr;
+};
+
+/**
+ * @brief Constant counterpart of `FunctionParameterSchema`, which can be built in a constant expression
+ */
+struct FunctionParameterSchemaView {
+    SchemaString name;
+    SchemaString description = {};
+    FunctionValueType type = FunctionValueType::String;
+    FunctionDefaultValue default_value = {};
+
+    bool is_compatible_value(const FunctionValue &value) const
+    {
+        return is_compatible_function_value(type, value);
+    }
+    constexpr bool is_required() const
+    {
+        return !default_value.has_value();
+    }
+    FunctionParameterSchema to_schema() const
+    {
+        FunctionParameterSchema schema{
+            .name = name,
+            .description = description,
+            .type = type,
+        };
+        if (default_value.has_value()) {
+            schema.default_value = default_value.value();
+        }
+        return schema;
+    }
+};
+
+/**
+ * @brief Constant counterpart of `FunctionSchema`
+ *
+ * The strings and the parameters are only referenced, so a table of `FunctionSchemaView` declared `constexpr` is
+ * placed in flash/rodata and can be registered without any heap allocation.
+ *
+ * @example
+ * static constexpr FunctionParameterSchemaView ADD_PARAMETERS[] = {
+ *     {"a", "First", FunctionValueType::Number},
+ *     {"b", "Second", FunctionValueType::Number, 1.0},
+ * };
+ * static constexpr FunctionSchemaView FUNCTIONS[] = {
+ *     {"add", "Add numbers", ADD_PARAMETERS},
+ * };
+ */
+struct FunctionSchemaView {
+    SchemaString name;
+    SchemaString description = {};
+    std::span<const FunctionParameterSchemaView> parameters = {};
+
+    FunctionSchema to_schema() const
+    {
+        FunctionSchema schema{
+            .name = name,
+            .description = description,
+        };
+        schema.parameters.reserve(parameters.size());
+        for (const auto &parameter : parameters) {
+            schema.parameters.push_back(parameter.to_schema());
+        }
+        return schema;
+    }
+};
+
 struct FunctionResult {
     bool success = false;
     std::string error_message = "";
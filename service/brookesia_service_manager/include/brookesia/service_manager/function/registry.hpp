@@ -5,32 +5,110 @@
  */
 #pragma once
 
+#include <atomic>
 #include <string>
+#include <string_view>
 #include <map>
+#include <expected>
 #include <vector>
 #include <functional>
 #include <memory>
 #include "boost/json.hpp"
 #include "boost/thread.hpp"
 #include "brookesia/service_manager/function/definition.hpp"
+#include "brookesia/service_manager/function/typed_handler.hpp"
 
 namespace esp_brookesia::service {
 
 using FunctionHandler = std::function < FunctionResult(FunctionParameterMap &&) >;
 
+/**
+ * @brief Handlers of a function: the generic one, always called over RPC, and the optional typed one for the local
+ *        callers with native C++ values
+ *
+ * Implicitly constructible from a generic handler, so that a plain lambda can still be used.
+ */
+struct FunctionHandlerEntry {
+    FunctionHandlerEntry() = default;
+    template <typename F>
+    requires (!std::is_same_v<std::remove_cvref_t<F>, FunctionHandlerEntry> && std::is_constructible_v<FunctionHandler, F>)
+    FunctionHandlerEntry(F &&generic_handler)
+        : handler(std::forward<F>(generic_handler))
+    {}
+    FunctionHandlerEntry(FunctionHandler &&generic_handler, TypedFunctionHandler &&typed)
+        : handler(std::move(generic_handler))
+        , typed_handler(std::move(typed))
+    {}
+
+    FunctionHandler handler;
+    TypedFunctionHandler typed_handler;
+};
+
 class FunctionRegistry {
 public:
     FunctionRegistry() = default;
     ~FunctionRegistry() = default;
 
-    bool add(FunctionSchema &&func_schema, FunctionHandler &&func_handler);
+    bool add(FunctionSchema &&func_schema, FunctionHandler &&func_handler, TypedFunctionHandler &&typed_handler = {});
+    /**
+     * @brief Add a function with a constant schema, the schema is referenced and must outlive the registry
+     */
+    bool add(
+        const FunctionSchemaView &func_schema, FunctionHandler &&func_handler, TypedFunctionHandler &&typed_handler = {}
+    );
     bool remove(const std::string &func_name);
     bool remove_all();
 
     FunctionResult call(const std::string &func_name, FunctionParameterMap &&parameters);
 
+    /**
+     * @brief Call a function with native C++ values
+     *
+     * If the function has a typed handler of the signature `R(Args...)`, the values are passed to it by reference
+     * without any conversion or validation. Otherwise they are converted to a `FunctionParameterMap` in the order of
+     * the parameters of the schema, and the generic handler is called as by `call()`.
+     */
+    template <typename R, typename... Args>
+    std::expected<R, std::string> call_typed(const std::string &func_name, Args &...args)
+    {
+        boost::lock_guard lock(functions_mutex_);
+
+        auto func_it = functions_.find(func_name);
+        if (func_it == functions_.end()) {
+            return std::unexpected("Function not found: " + func_name);
+        }
+
+        auto &func_info = func_it->second;
+        if (auto typed_handler = func_info.typed_handler.template get<R, std::remove_cvref_t<Args>...>()) {
+            return (*typed_handler)(args...);
+        }
+
+        auto &func_schema = func_info.schema;
+        if (sizeof...(Args) > func_schema.parameters.size()) {
+            return std::unexpected("Too many parameters for function: " + func_name);
+        }
+        FunctionParameterMap parameters;
+        size_t index = 0;
+        (parameters.emplace(std::string(func_schema.parameters[index++].name), to_function_value(std::move(args))), ...);
+        (void)index;
+
+        std::string error_message;
+        if (!validate_parameters(func_schema, parameters, error_message)) {
+            return std::unexpected(std::move(error_message));
+        }
+
+        return from_function_result<R>(func_info.handler(std::move(parameters)));
+    }
+
     std::vector<FunctionSchema> get_schemas();
     boost::json::array get_schemas_json();
+    /**
+     * @brief Visit the schemas of the functions, in the order of their names, without copying them
+     *
+     * @note The registry is locked during the visit, the visitor must not call it
+     */
+    void visit_schemas(const std::function<void(const FunctionSchemaView &)> &visitor);
+    bool get_parameter_names(const std::string &func_name, std::vector<std::string> &names);
     bool has(const std::string &func_name)
     {
         boost::lock_guard lock(functions_mutex_);
@@ -42,13 +120,43 @@ public:
         return functions_.size();
     }
 
+    /**
+     * @brief Get the number of changes of all the registries: functions added or removed
+     *
+     * Lets the caches built from the schemas (e.g. the tools of `ServiceToolAdapter`) check that they are up to date
+     * without locking any registry.
+     */
+    static uint64_t get_change_count()
+    {
+        return change_count_.load(std::memory_order_acquire);
+    }
+
 private:
+    // Storage of the schemas registered by value, the view of the function points into it
+    struct OwnedSchema {
+        FunctionSchema schema;
+        std::vector<FunctionParameterSchemaView> parameters;
+    };
+    struct FunctionInfo {
+        FunctionSchemaView schema;
+        FunctionHandler handler;
+        TypedFunctionHandler typed_handler;
+        std::unique_ptr<OwnedSchema> owned;
+    };
+
+    bool add_internal(
+        const FunctionSchemaView &func_schema, FunctionHandler &&func_handler, TypedFunctionHandler &&typed_handler,
+        std::unique_ptr<OwnedSchema> owned
+    );
     bool validate_parameters(
-        const FunctionSchema &func_schema, FunctionParameterMap &parameters, std::string &error_msg
+        const FunctionSchemaView &func_schema, FunctionParameterMap &parameters, std::string &error_msg
     );
 
     boost::mutex functions_mutex_;
-    std::map<std::string, std::pair<FunctionSchema, FunctionHandler>> functions_;
+    // The keys reference the names of the schemas
+    std::map<std::string_view, FunctionInfo> functions_;
+
+    inline static std::atomic<uint64_t> change_count_ = 0;
 };
 
 } // namespace esp_brookesia::service
@@ -0,0 +1,217 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <expected>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "boost/json.hpp"
+#include "brookesia/lib_utils/describe_helpers.hpp"
+#include "brookesia/service_manager/function/definition.hpp"
+
+namespace esp_brookesia::service {
+
+/**
+ * @brief Get the schema type of the values of a native C++ type
+ *
+ * The alternatives of `FunctionValue` map to their own type, arithmetic types to `Number`, described enums to
+ * `String`, vectors to `Array`, and maps and described structs to `Object`.
+ */
+template <typename T>
+constexpr FunctionValueType get_function_value_type()
+{
+    if constexpr (std::is_same_v<T, bool>) {
+        return FunctionValueType::Boolean;
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        return FunctionValueType::Number;
+    } else if constexpr (std::is_same_v<T, std::string> || lib_utils::detail::is_described_enum_v<T>) {
+        return FunctionValueType::String;
+    } else if constexpr (std::is_same_v<T, boost::json::array> || lib_utils::detail::is_vector_v<T>) {
+        return FunctionValueType::Array;
+    } else {
+        static_assert(
+            std::is_same_v<T, boost::json::object> || lib_utils::detail::is_map_v<T> ||
+            lib_utils::detail::is_described_v<T>, "Type can not be converted to a function value"
+        );
+        return FunctionValueType::Object;
+    }
+}
+
+/**
+ * @brief Convert a native C++ value to a `FunctionValue`
+ *
+ * The alternatives of `FunctionValue` are moved as is, the other types go through their JSON representation.
+ */
+template <typename T>
+FunctionValue to_function_value(T &&value)
+{
+    using Type = std::remove_cvref_t<T>;
+
+    if constexpr (std::is_same_v<Type, bool> || std::is_same_v<Type, std::string> ||
+                  std::is_same_v<Type, boost::json::object> || std::is_same_v<Type, boost::json::array>) {
+        return FunctionValue(std::forward<T>(value));
+    } else if constexpr (std::is_arithmetic_v<Type>) {
+        return FunctionValue(static_cast<double>(value));
+    } else {
+        static_assert(get_function_value_type<Type>() != FunctionValueType::Boolean);
+        auto value_json = BROOKESIA_DESCRIBE_TO_JSON(value);
+        if constexpr (get_function_value_type<Type>() == FunctionValueType::String) {
+            return FunctionValue(std::string(value_json.as_string()));
+        } else if constexpr (get_function_value_type<Type>() == FunctionValueType::Array) {
+            return FunctionValue(std::move(value_json.as_array()));
+        } else {
+            return FunctionValue(std::move(value_json.as_object()));
+        }
+    }
+}
+
+/**
+ * @brief Convert a `FunctionValue` to a native C++ value, the inverse of `to_function_value()`
+ *
+ * @param[in] value Value to convert, moved from if it holds the requested type
+ * @param[out] ret_value Converted value
+ * @return true if converted, false if the value does not hold a compatible type
+ */
+template <typename T>
+bool from_function_value(FunctionValue &&value, T &ret_value)
+{
+    if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, std::string> ||
+                  std::is_same_v<T, boost::json::object> || std::is_same_v<T, boost::json::array>) {
+        auto alternative = std::get_if<T>(&value);
+        if (alternative == nullptr) {
+            return false;
+        }
+        ret_value = std::move(*alternative);
+        return true;
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        auto number = std::get_if<double>(&value);
+        if (number == nullptr) {
+            return false;
+        }
+        ret_value = static_cast<T>(*number);
+        return true;
+    } else {
+        auto value_json = std::visit([](auto && alternative) {
+            return boost::json::value(std::move(alternative));
+        }, std::move(value));
+        return BROOKESIA_DESCRIBE_FROM_JSON(value_json, ret_value);
+    }
+}
+
+/**
+ * @brief Convert the result of a generic call to the result of a typed call
+ */
+template <typename R>
+std::expected<R, std::string> from_function_result(FunctionResult &&result)
+{
+    if (!result.success) {
+        return std::unexpected(std::move(result.error_message));
+    }
+    if constexpr (std::is_void_v<R>) {
+        return {};
+    } else {
+        if (!result.data.has_value()) {
+            return std::unexpected("Function returned no data");
+        }
+        R value{};
+        if (!from_function_value(std::move(result.data.value()), value)) {
+            return std::unexpected("Function returned data of an unexpected type");
+        }
+        return value;
+    }
+}
+
+/**
+ * @brief Take a parameter out of the parameters of a generic call, for the handlers with native parameter types
+ *
+ * @return true if taken, false if missing or not convertible, with the reason in `error_message`
+ */
+template <typename T>
+bool take_function_parameter(
+    FunctionParameterMap &parameters, const std::string &name, T &ret_value, std::string &error_message
+)
+{
+    auto it = parameters.find(name);
+    if (it == parameters.end()) {
+        error_message = "Missing parameter: " + name;
+        return false;
+    }
+    if (!from_function_value(std::move(it->second), ret_value)) {
+        error_message = "Invalid parameter: " + name;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Handler of a function taking its parameters as native C++ values
+ *
+ * Stored next to the generic `FunctionHandler` of a function, so that a local caller with the same signature skips
+ * the `FunctionParameterMap`, the parameter validation and the `FunctionValue` of the result. The callable is type
+ * erased, `get()` only returns it for the exact signature it was created with.
+ */
+class TypedFunctionHandler {
+public:
+    template <typename R, typename... Args>
+    using Function = std::function<std::expected<R, std::string>(Args &...)>;
+
+    TypedFunctionHandler() = default;
+
+    template <typename R, typename... Args>
+    static TypedFunctionHandler create(std::type_identity_t<Function<R, Args...>> &&function)
+    {
+        TypedFunctionHandler handler;
+        handler.signature_ = &signature_tag<R, Args...>;
+        handler.function_ = std::make_shared<Function<R, Args...>>(std::move(function));
+        return handler;
+    }
+
+    /**
+     * @brief Get the callable if created with the signature `R(Args...)`
+     *
+     * @return Pointer to the callable, nullptr if empty or created with another signature
+     */
+    template <typename R, typename... Args>
+    const Function<R, Args...> *get() const
+    {
+        if (signature_ != &signature_tag<R, Args...>) {
+            return nullptr;
+        }
+        return static_cast<const Function<R, Args...> *>(function_.get());
+    }
+
+    explicit operator bool() const
+    {
+        return (function_ != nullptr);
+    }
+
+private:
+    // One address per signature, compared instead of `typeid` so that RTTI is not required
+    template <typename R, typename... Args>
+    static constexpr char signature_tag = 0;
+
+    const void *signature_ = nullptr;
+    std::shared_ptr<const void> function_;
+};
+
+/**
+ * @brief Create a typed handler from a callable taking `Args &...`, the result type is deduced from the
+ *        `std::expected<R, std::string>` it returns
+ */
+template <typename... Args, typename F>
+TypedFunctionHandler make_typed_function_handler(F &&function)
+{
+    using Expected = std::invoke_result_t<F, Args &...>;
+    using R = typename Expected::value_type;
+    static_assert(std::is_same_v<Expected, std::expected<R, std::string>>, "Must return std::expected<R, std::string>");
+
+    return TypedFunctionHandler::create<R, Args...>(std::forward<F>(function));
+}
+
+} // namespace esp_brookesia::service
@@ -0,0 +1,42 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace esp_brookesia::service {
+
+/**
+ * @brief Non-owning string used by the constant schemas
+ *
+ * It is a `std::string_view` which can be built in a constant expression, so the schemas made of it stay in
+ * flash/rodata. It also converts implicitly to `std::string`, so the schema fields can still be passed to the APIs
+ * taking `const std::string &` (function names, parameter names, map keys, etc.).
+ *
+ * It never owns the characters: build it from literals or static storage. The construction from a `std::string` is
+ * explicit, since the string must outlive the schema (e.g. the owned copy kept by the registries).
+ */
+class SchemaString: public std::string_view {
+public:
+    constexpr SchemaString() = default;
+    constexpr SchemaString(const char *str)
+        : std::string_view(str)
+    {}
+    constexpr SchemaString(std::string_view str)
+        : std::string_view(str)
+    {}
+    explicit SchemaString(const std::string &str)
+        : std::string_view(str)
+    {}
+
+    operator std::string() const
+    {
+        return std::string(data(), size());
+    }
+};
+
+} // namespace esp_brookesia::service
@@ -9,6 +9,7 @@
 #include <functional>
 #include <future>
 #include <map>
+#include <span>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -93,6 +94,36 @@ public:
         return {};
     }
 
+    /**
+     * @brief Get the constant function definitions
+     *
+     * Preferred over `get_function_definitions()` for the definitions known at compile time: they are referenced by
+     * the function registry instead of being copied. If not empty, `get_function_definitions()` is not used.
+     *
+     * @return std::span<const FunctionSchemaView> Constant function definitions, must outlive the service
+     *
+     * @example
+     * std::span<const FunctionSchemaView> get_function_schema_views() override {
+     *     return FUNCTION_SCHEMAS;  // static constexpr FunctionSchemaView FUNCTION_SCHEMAS[] = {...};
+     * }
+     */
+    virtual std::span<const FunctionSchemaView> get_function_schema_views()
+    {
+        return {};
+    }
+
+    /**
+     * @brief Get the constant event definitions
+     *
+     * Same as `get_function_schema_views()`, but for the events. If not empty, `get_event_definitions()` is not used.
+     *
+     * @return std::span<const EventSchemaView> Constant event definitions, must outlive the service
+     */
+    virtual std::span<const EventSchemaView> get_event_schema_views()
+    {
+        return {};
+    }
+
     /**
      * @brief Call a function asynchronously with parameters map (non-blocking)
      *
@@ -165,6 +196,36 @@ public:
         const std::string &name, boost::json::object &&parameters_json, uint32_t timeout_ms = 10
     );
 
+    /**
+     * @brief Call a function asynchronously with native C++ values (non-blocking)
+     *
+     * The values are moved into the task and passed by reference to the typed handler of the function if it has the
+     * signature `R(Args...)`, without any `FunctionParameterMap` or `FunctionValue`. Otherwise they are converted in
+     * the order of the parameters of the definition and the generic handler is called. Usually called through a
+     * `FunctionStub`, which fixes `R` and `Args` from the definition.
+     *
+     * @tparam R Result type, void if the function returns no data
+     * @param[in] name Function name to call
+     * @param[in] args Parameter values, in the order of the definition, the trailing ones can be omitted
+     * @return std::future<std::expected<R, std::string>> Future that will contain the result
+     */
+    template <typename R, typename... Args>
+    std::future<std::expected<R, std::string>> call_function_typed_async(const std::string &name, Args... args)
+    {
+        auto result_promise = std::make_shared<std::promise<std::expected<R, std::string>>>();
+        auto result_future = result_promise->get_future();
+
+        auto call = [result_promise, name, ...args = std::move(args)](FunctionRegistry & registry) mutable {
+            result_promise->set_value(registry.call_typed<R, Args...>(name, args...));
+        };
+        std::string error_message;
+        if (!post_function_call(name, std::move(call), error_message)) {
+            result_promise->set_value(std::unexpected(std::move(error_message)));
+        }
+
+        return result_future;
+    }
+
     /**
      * @brief Subscribe to an event
      *
@@ -217,13 +278,25 @@ public:
         return attributes_;
     }
 
+    /**
+     * @brief Get the function registry, filled while the service is running, e.g. to expose its functions
+     *        through `ServiceToolAdapter`
+     *
+     * @return std::shared_ptr<FunctionRegistry> Shared pointer to the function registry, nullptr if not initialized
+     */
+    std::shared_ptr<FunctionRegistry> get_function_registry() const
+    {
+        boost::shared_lock lock(registry_mutex_);
+        return function_registry_;
+    }
+
 protected:
-    using FunctionHandlerMap = std::map<std::string, FunctionHandler>;
+    using FunctionHandlerMap = std::map<std::string, FunctionHandlerEntry>;
 
     /**
      * @brief Helper function to convert std::expected to FunctionResult
      *
-     * @tparam T Return value type, can be void or any type convertible to FunctionValue
+     * @tparam T Return value type, can be void or any type supported by `to_function_value()`
      * @param[in] result std::expected object
      * @return FunctionResult Converted result
      */
@@ -236,7 +309,7 @@ protected:
             } else {
                 return FunctionResult{
                     .success = true,
-                    .data = FunctionValue(std::move(result.value()))
+                    .data = to_function_value(std::move(result.value()))
                 };
             }
         } else {
@@ -377,6 +450,28 @@ private:
     void disconnect_from_server();
     void try_override_connection_request_handler();
 
+    /**
+     * @brief Post a function call to the task scheduler, or to the io_context without it (internal use)
+     *
+     * @param[in] name Function name, checked in the registry before posting
+     * @param[in] call Call run by the task with the registry
+     * @param[out] error_message Reason of the failure
+     * @return true if posted, false otherwise
+     */
+    bool post_function_call(
+        const std::string &name, std::function<void(FunctionRegistry &)> &&call, std::string &error_message
+    );
+
+    /**
+     * @brief Get the parameter names of a function from the definitions of the service, used while the function
+     *        registry is not filled (internal use)
+     *
+     * @param[in] name Function name
+     * @param[out] names Parameter names, in the order of the definition
+     * @return true if the function is defined, false otherwise
+     */
+    bool get_defined_parameter_names(const std::string &name, std::vector<std::string> &names);
+
     /**
      * @brief Register function list (internal use)
      *
@@ -385,6 +480,7 @@ private:
      * @return true if registered successfully, false otherwise
      */
     bool register_functions(std::vector<FunctionSchema> &&definitions, FunctionHandlerMap &&handlers);
+    bool register_functions(std::span<const FunctionSchemaView> definitions, FunctionHandlerMap &&handlers);
 
     /**
      * @brief Register event list (internal use)
@@ -393,6 +489,7 @@ private:
      * @return true if registered successfully, false otherwise
      */
     bool register_events(std::vector<EventSchema> &&definitions);
+    bool register_events(std::span<const EventSchemaView> definitions);
 
     Attributes attributes_;
     boost::asio::io_context *io_context_ = nullptr;
@@ -415,6 +512,20 @@ BROOKESIA_DESCRIBE_STRUCT(ServiceBase::Attributes, (), (name, dependencies, task
 // ============================================================================
 // Helper macros: Simplify FunctionHandlerMap writing
 // ============================================================================
+//
+// Each macro creates both the generic handler, which takes the parameters out of the `FunctionParameterMap`, and the
+// typed handler, which receives them as native values from `call_function_typed_async()`. The parameter types can
+// be any type supported by `to_function_value()`, e.g. `std::vector<KeyValuePair>` for an array parameter, but can
+// not contain a comma (use an alias instead).
+
+/**
+ * @brief Take a parameter out of `args` into `param`, or return a failed `FunctionResult` (internal use)
+ */
+#define BROOKESIA_SERVICE_FUNC_TAKE_PARAM(args, param_name, param) \
+    if (std::string error_message; \
+            !esp_brookesia::service::take_function_parameter(args, param_name, param, error_message)) { \
+        return esp_brookesia::service::FunctionResult{.success = false, .error_message = std::move(error_message)}; \
+    }
 
 /**
  * @brief Create a zero-parameter function handler
@@ -428,9 +539,14 @@ BROOKESIA_DESCRIBE_STRUCT(ServiceBase::Attributes, (), (name, dependencies, task
 #define BROOKESIA_SERVICE_FUNC_HANDLER_0(func_name, func_call) \
     { \
         func_name, \
-        [this](esp_brookesia::service::FunctionParameterMap &&) -> esp_brookesia::service::FunctionResult { \
-            return to_function_result(func_call); \
-        } \
+        esp_brookesia::service::FunctionHandlerEntry( \
+            [this](esp_brookesia::service::FunctionParameterMap &&) -> esp_brookesia::service::FunctionResult { \
+                return to_function_result(func_call); \
+            }, \
+            esp_brookesia::service::make_typed_function_handler<>([this]() { \
+                return func_call; \
+            }) \
+        ) \
     }
 
 /**
@@ -443,16 +559,21 @@ BROOKESIA_DESCRIBE_STRUCT(ServiceBase::Attributes, (), (name, dependencies, task
  *
  * Example:
  * BROOKESIA_SERVICE_FUNC_HANDLER_1("play_url", "url", std::string, function_play_url(PARAM))
- * BROOKESIA_SERVICE_FUNC_HANDLER_1("set_volume", "volume", uint8_t,
- *                     function_set_volume(static_cast<uint8_t>(PARAM)))
+ * BROOKESIA_SERVICE_FUNC_HANDLER_1("set_volume", "volume", uint8_t, function_set_volume(PARAM))
  */
 #define BROOKESIA_SERVICE_FUNC_HANDLER_1(func_name, param_name, param_type, func_call) \
     { \
         func_name, \
-        [this](esp_brookesia::service::FunctionParameterMap &&args) -> esp_brookesia::service::FunctionResult { \
-            auto &PARAM = std::get<param_type>(args.at(param_name)); \
-            return to_function_result(func_call); \
-        } \
+        esp_brookesia::service::FunctionHandlerEntry( \
+            [this](esp_brookesia::service::FunctionParameterMap &&args) -> esp_brookesia::service::FunctionResult { \
+                param_type PARAM{}; \
+                BROOKESIA_SERVICE_FUNC_TAKE_PARAM(args, param_name, PARAM); \
+                return to_function_result(func_call); \
+            }, \
+            esp_brookesia::service::make_typed_function_handler<param_type>([this](param_type &PARAM) { \
+                return func_call; \
+            }) \
+        ) \
     }
 
 /**
@@ -472,11 +593,19 @@ BROOKESIA_DESCRIBE_STRUCT(ServiceBase::Attributes, (), (name, dependencies, task
 #define BROOKESIA_SERVICE_FUNC_HANDLER_2(func_name, param1_name, param1_type, param2_name, param2_type, func_call) \
     { \
         func_name, \
-        [this](esp_brookesia::service::FunctionParameterMap &&args) -> esp_brookesia::service::FunctionResult { \
-            auto &PARAM1 = std::get<param1_type>(args.at(param1_name)); \
-            auto &PARAM2 = std::get<param2_type>(args.at(param2_name)); \
-            return to_function_result(func_call); \
-        } \
+        esp_brookesia::service::FunctionHandlerEntry( \
+            [this](esp_brookesia::service::FunctionParameterMap &&args) -> esp_brookesia::service::FunctionResult { \
+                param1_type PARAM1{}; \
+                param2_type PARAM2{}; \
+                BROOKESIA_SERVICE_FUNC_TAKE_PARAM(args, param1_name, PARAM1); \
+                BROOKESIA_SERVICE_FUNC_TAKE_PARAM(args, param2_name, PARAM2); \
+                return to_function_result(func_call); \
+            }, \
+            esp_brookesia::service::make_typed_function_handler<param1_type, param2_type>( \
+            [this](param1_type &PARAM1, param2_type &PARAM2) { \
+                return func_call; \
+            }) \
+        ) \
     }
 
 /**
@@ -487,12 +616,21 @@ BROOKESIA_DESCRIBE_STRUCT(ServiceBase::Attributes, (), (name, dependencies, task
 #define BROOKESIA_SERVICE_FUNC_HANDLER_3(func_name, p1_name, p1_type, p2_name, p2_type, p3_name, p3_type, func_call) \
     { \
         func_name, \
-        [this](esp_brookesia::service::FunctionParameterMap &&args) -> esp_brookesia::service::FunctionResult { \
-            auto &PARAM1 = std::get<p1_type>(args.at(p1_name)); \
-            auto &PARAM2 = std::get<p2_type>(args.at(p2_name)); \
-            auto &PARAM3 = std::get<p3_type>(args.at(p3_name)); \
-            return to_function_result(func_call); \
-        } \
+        esp_brookesia::service::FunctionHandlerEntry( \
+            [this](esp_brookesia::service::FunctionParameterMap &&args) -> esp_brookesia::service::FunctionResult { \
+                p1_type PARAM1{}; \
+                p2_type PARAM2{}; \
+                p3_type PARAM3{}; \
+                BROOKESIA_SERVICE_FUNC_TAKE_PARAM(args, p1_name, PARAM1); \
+                BROOKESIA_SERVICE_FUNC_TAKE_PARAM(args, p2_name, PARAM2); \
+                BROOKESIA_SERVICE_FUNC_TAKE_PARAM(args, p3_name, PARAM3); \
+                return to_function_result(func_call); \
+            }, \
+            esp_brookesia::service::make_typed_function_handler<p1_type, p2_type, p3_type>( \
+            [this](p1_type &PARAM1, p2_type &PARAM2, p3_type &PARAM3) { \
+                return func_call; \
+            }) \
+        ) \
     }
 
 } // namespace esp_brookesia::service
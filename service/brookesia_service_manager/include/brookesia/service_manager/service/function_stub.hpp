@@ -0,0 +1,140 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include "boost/format.hpp"
+#include "boost/json.hpp"
+#include "brookesia/service_manager/function/definition.hpp"
+#include "brookesia/service_manager/function/typed_handler.hpp"
+#include "brookesia/service_manager/rpc/client.hpp"
+#include "brookesia/service_manager/service/base.hpp"
+
+namespace esp_brookesia::service {
+
+template <typename Signature>
+class FunctionStub;
+
+/**
+ * @brief Typed stub of a function, declared next to its constant definition
+ *
+ * A local call moves the native values to the typed handler of the function when it has the same signature, without
+ * any JSON, `FunctionParameterMap` or `FunctionValue`, and returns the native result. The values are only serialized
+ * by `call_rpc()`, or when the handler has no typed counterpart. The number and the schema types of the parameters
+ * are checked against the definition when the stub is constant-initialized, so a stub out of sync with its
+ * definition does not compile.
+ *
+ * @tparam R Result type, void if the function returns no data
+ * @tparam Args Parameter types, in the order of the definition
+ *
+ * @example
+ * // Helper of the service
+ * class NVS {
+ * public:
+ *     static const FunctionStub<void(std::string, std::vector<KeyValuePair>)> set;
+ *     ...
+ * };
+ * inline constexpr FunctionStub<void(std::string, std::vector<NVS::KeyValuePair>)> NVS::set{
+ *     SERVICE_NAME, FUNCTION_DEFINITIONS[FunctionIndexSet]
+ * };
+ *
+ * // Caller
+ * auto result = helper::NVS::set.call_sync(*nvs, 100, "storage", {{"key1", 1}, {"key2", true}});
+ */
+template <typename R, typename... Args>
+class FunctionStub<R(Args...)> {
+public:
+    using Result = std::expected<R, std::string>;
+
+    constexpr FunctionStub(const char *service_name, const FunctionSchemaView &schema)
+        : service_name_(service_name)
+        , schema_(&schema)
+    {
+        if (schema.parameters.size() != sizeof...(Args)) {
+            throw std::logic_error("Parameter count of the stub does not match the definition");
+        }
+        size_t index = 0;
+        if (!((schema.parameters[index++].type == get_function_value_type<Args>()) && ...)) {
+            throw std::logic_error("Parameter types of the stub do not match the definition");
+        }
+    }
+
+    /**
+     * @brief Call the function of a local service asynchronously (non-blocking)
+     */
+    std::future<Result> call_async(ServiceBase &service, Args... args) const
+    {
+        return service.call_function_typed_async<R, Args...>(std::string(schema_->name), std::move(args)...);
+    }
+
+    /**
+     * @brief Call the function of a local service synchronously (blocking with timeout)
+     */
+    Result call_sync(ServiceBase &service, uint32_t timeout_ms, Args... args) const
+    {
+        auto result_future = call_async(service, std::move(args)...);
+        if (result_future.wait_for(std::chrono::milliseconds(timeout_ms)) == std::future_status::timeout) {
+            return std::unexpected((boost::format("Timeout after %1%ms") % timeout_ms).str());
+        }
+
+        return result_future.get();
+    }
+
+    /**
+     * @brief Call the function of a remote service through an RPC client (blocking with timeout)
+     */
+    Result call_rpc(rpc::Client &client, uint32_t timeout_ms, Args... args) const
+    {
+        return from_function_result<R>(client.call_function_sync(
+                                           service_name_, std::string(schema_->name), to_json(std::move(args)...),
+                                           timeout_ms
+                                       ));
+    }
+
+    /**
+     * @brief Serialize the parameters to the JSON object of a request, keyed by the names of the definition
+     */
+    boost::json::object to_json(Args... args) const
+    {
+        boost::json::object parameters;
+        size_t index = 0;
+        ((parameters[schema_->parameters[index++].name] = std::visit([](auto && value) {
+            return boost::json::value(std::move(value));
+        }, to_function_value(std::move(args)))), ...);
+        (void)index;
+
+        return parameters;
+    }
+
+    /**
+     * @brief Convert the result of a generic call, e.g. `ServiceBase::call_function_sync()`, to the result type
+     */
+    static Result from_result(FunctionResult &&result)
+    {
+        return from_function_result<R>(std::move(result));
+    }
+
+    constexpr const char *get_service_name() const
+    {
+        return service_name_;
+    }
+
+    constexpr const FunctionSchemaView &get_schema() const
+    {
+        return *schema_;
+    }
+
+private:
+    const char *service_name_;
+    const FunctionSchemaView *schema_;
+};
+
+} // namespace esp_brookesia::service
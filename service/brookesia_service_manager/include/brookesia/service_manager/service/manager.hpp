@@ -298,6 +298,22 @@ public:
         return (it != services_.end()) ? std::get<1>(it->second) : nullptr;
     }
 
+    /**
+     * @brief Get all the services
+     *
+     * @return std::vector<std::shared_ptr<ServiceBase>> Services, in the order of their names
+     */
+    std::vector<std::shared_ptr<ServiceBase>> get_services()
+    {
+        boost::lock_guard lock(service_mutex_);
+        std::vector<std::shared_ptr<ServiceBase>> services;
+        services.reserve(services_.size());
+        for (const auto &[_, info] : services_) {
+            services.push_back(std::get<1>(info));
+        }
+        return services;
+    }
+
     /**
      * @brief Get the singleton instance
      *
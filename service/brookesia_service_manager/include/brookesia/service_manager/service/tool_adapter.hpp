@@ -0,0 +1,131 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "boost/json.hpp"
+#include "boost/thread/mutex.hpp"
+#include "brookesia/service_manager/function/definition.hpp"
+#include "brookesia/service_manager/service/base.hpp"
+#include "brookesia/service_manager/service/manager.hpp"
+
+namespace esp_brookesia::service {
+
+/**
+ * @brief Exposes the functions of the running services as the tools of an LLM agent
+ *
+ * Each function is a tool named `<service><separator><function>`, described in the format of the function calling of
+ * the agents:
+ *
+ * @code
+ * {"name": "...", "description": "...",
+ *  "parameters": {"type": "object", "properties": {"<param>": {"type": "...", "description": "..."}}, "required": []}}
+ * @endcode
+ *
+ * The descriptors and the table of the tools are built once, and only rebuilt when a function registry has changed
+ * (see `FunctionRegistry::get_change_count()`), e.g. when a service is started or stopped. A tool call is routed into
+ * `ServiceBase::call_function_async()` of its service, with the arguments converted from JSON to a
+ * `FunctionParameterMap` directly.
+ *
+ * The AI agent of `brookesia_core` plugs it into its function calling when
+ * `CONFIG_ESP_BROOKESIA_AGENT_ENABLE_SERVICE_TOOLS` is enabled:
+ *
+ * @code
+ * static ServiceToolAdapter adapter;
+ * FunctionDefinitionList::requestInstance().setToolProvider({
+ *     .get_json = []() { return *adapter.get_tools_json(); },
+ *     .invoke = [](const std::string &name, std::string_view arguments) {
+ *         return adapter.has_tool(name) && adapter.call_tool_async(name, arguments).valid();
+ *     },
+ * });
+ * @endcode
+ */
+class ServiceToolAdapter {
+public:
+    struct Config {
+        std::vector<std::string> services = {};  ///< Services whose functions are exposed, all if empty
+        std::string name_separator = "__";       ///< Between the service name and the function name of a tool
+    };
+
+    ServiceToolAdapter()
+        : ServiceToolAdapter(Config())
+    {}
+    explicit ServiceToolAdapter(Config config, ServiceManager &manager = ServiceManager::get_instance())
+        : config_(std::move(config))
+        , manager_(manager)
+    {}
+
+    /**
+     * @brief Get the descriptors of the tools
+     *
+     * @return std::shared_ptr<const std::string> JSON array of the descriptors, shared with the cache, so it is not
+     *         copied and stays valid after a rebuild
+     */
+    std::shared_ptr<const std::string> get_tools_json();
+
+    /**
+     * @brief Call a tool (non-blocking)
+     *
+     * @param[in] tool_name Name of the tool
+     * @param[in] arguments Arguments of the call, a `null` argument gets the default value of its parameter
+     * @return std::future<FunctionResult> Future that will contain the result of the function
+     */
+    std::future<FunctionResult> call_tool_async(std::string_view tool_name, boost::json::object &&arguments);
+
+    /**
+     * @brief Call a tool with the arguments as JSON text, as received from the LLM (non-blocking)
+     *
+     * @param[in] tool_name Name of the tool
+     * @param[in] arguments_json JSON object of the arguments, empty for none
+     * @return std::future<FunctionResult> Future that will contain the result of the function
+     */
+    std::future<FunctionResult> call_tool_async(std::string_view tool_name, std::string_view arguments_json);
+
+    /**
+     * @brief Check if a tool exists
+     */
+    bool has_tool(std::string_view tool_name);
+
+    /**
+     * @brief Get the number of times the tools were built, for the tests and the diagnostics
+     */
+    size_t get_build_count()
+    {
+        boost::lock_guard lock(cache_mutex_);
+        return build_count_;
+    }
+
+private:
+    struct Tool {
+        std::weak_ptr<ServiceBase> service;
+        std::string function_name;
+    };
+    struct Cache {
+        uint64_t change_count = 0;
+        std::string json;
+        std::map<std::string, Tool, std::less<>> tools;
+    };
+
+    // Up to date with the registries, rebuilt if needed
+    std::shared_ptr<const Cache> get_cache();
+    std::shared_ptr<const Cache> build_cache(uint64_t change_count);
+
+    Config config_;
+    ServiceManager &manager_;
+
+    boost::mutex cache_mutex_;
+    std::shared_ptr<const Cache> cache_;
+    size_t build_count_ = 0;
+};
+
+} // namespace esp_brookesia::service
@@ -18,22 +18,37 @@ bool EventRegistry::add(EventSchema &&event_schema)
 
     BROOKESIA_LOGD("Params: event_schema(%1%)", BROOKESIA_DESCRIBE_TO_STR(event_schema));
 
-    BROOKESIA_CHECK_FALSE_RETURN(!event_schema.name.empty(), false, "Event name is empty");
+    std::unique_ptr<OwnedSchema> owned;
+    BROOKESIA_CHECK_EXCEPTION_RETURN(
+        owned = std::make_unique<OwnedSchema>(), false, "Failed to create owned schema"
+    );
+    owned->schema = std::move(event_schema);
+
+    // Build the view after the schema is moved into its final place, so the referenced strings stay valid
+    owned->items.reserve(owned->schema.items.size());
+    for (const auto &item : owned->schema.items) {
+        owned->items.push_back(EventItemSchemaView{
+            .name = SchemaString(item.name),
+            .description = SchemaString(item.description),
+            .type = item.type,
+        });
+    }
+    EventSchemaView view{
+        .name = SchemaString(owned->schema.name),
+        .description = SchemaString(owned->schema.description),
+        .items = owned->items,
+    };
 
-    boost::lock_guard lock(event_infos_mutex_);
+    return add_internal(view, std::move(owned));
+}
 
-    if (event_infos_.find(event_schema.name) != event_infos_.end()) {
-        BROOKESIA_LOGD("Event already exists, skip register");
-        return true;
-    }
+bool EventRegistry::add(const EventSchemaView &event_schema)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
-    std::unique_ptr<Signal> signal;
-    BROOKESIA_CHECK_EXCEPTION_RETURN(
-        signal = std::make_unique<Signal>(), false, "Failed to create signal"
-    );
-    event_infos_[event_schema.name] = std::make_tuple(Subscriptions(), event_schema, std::move(signal));
+    BROOKESIA_LOGD("Params: event_schema(%1%)", std::string_view(event_schema.name));
 
-    return true;
+    return add_internal(event_schema, nullptr);
 }
 
 void EventRegistry::remove(const std::string &event_name)
@@ -68,24 +83,22 @@ bool EventRegistry::validate_items(const std::string &event_name, const EventIte
 
     BROOKESIA_CHECK_FALSE_RETURN(!event_items.empty(), false, "Event items map is empty");
 
-    EventSchema event_schema;
-    {
-        boost::lock_guard lock(event_infos_mutex_);
-        auto event_it = event_infos_.find(event_name);
-        BROOKESIA_CHECK_FALSE_RETURN(event_it != event_infos_.end(), false, "Event not found");
+    // The schema is only referenced, so keep the lock while validating
+    boost::lock_guard lock(event_infos_mutex_);
+    auto event_it = event_infos_.find(event_name);
+    BROOKESIA_CHECK_FALSE_RETURN(event_it != event_infos_.end(), false, "Event not found");
 
-        event_schema = std::get<1>(event_it->second);
-    }
+    auto &event_schema = std::get<1>(event_it->second);
 
     // Validate the event items against the event schema
     for (const auto &item_schema : event_schema.items) {
-        auto item_it = event_items.find(item_schema.name);
+        auto item_it = event_items.find(std::string_view(item_schema.name));
         BROOKESIA_CHECK_FALSE_RETURN(
-            item_it != event_items.end(), false, "Missing event item: `%1%`", item_schema.name
+            item_it != event_items.end(), false, "Missing event item: `%1%`", std::string_view(item_schema.name)
         );
         BROOKESIA_CHECK_FALSE_RETURN(
             item_schema.is_compatible_item(item_it->second), false,
-            "Invalid value for event item: `%1%`", item_schema.name
+            "Invalid value for event item: `%1%`", std::string_view(item_schema.name)
         );
     }
 
@@ -153,7 +166,7 @@ void EventRegistry::on_unsubscribe_by_subscriptions(const Subscriptions &subscri
 
     for (const auto &subscription_id : subscriptions) {
         for (auto& [name, event_info] : event_infos_) {
-            auto &[subscriptions, schema, signal] = event_info;
+            auto &subscriptions = std::get<0>(event_info);
             auto it = subscriptions.find(subscription_id);
             if (it != subscriptions.end()) {
                 subscriptions.erase(it);
@@ -168,8 +181,8 @@ std::vector<EventSchema> EventRegistry::get_schemas()
 
     std::vector<EventSchema> schemas;
     for (const auto& [name, event_info] : event_infos_) {
-        auto &[subscriptions, schema, signal] = event_info;
-        schemas.push_back(schema);
+        auto &[subscriptions, schema, signal, owned] = event_info;
+        schemas.push_back(owned ? owned->schema : schema.to_schema());
     }
     return schemas;
 }
@@ -180,13 +193,36 @@ boost::json::array EventRegistry::get_schemas_json()
 
     boost::json::array schemas;
     for (const auto& [name, event_info] : event_infos_) {
-        auto &[subscriptions, schema, signal] = event_info;
-        schemas.push_back(std::move(BROOKESIA_DESCRIBE_TO_JSON(schema)));
+        auto &[subscriptions, schema, signal, owned] = event_info;
+        if (owned) {
+            schemas.push_back(std::move(BROOKESIA_DESCRIBE_TO_JSON(owned->schema)));
+        } else {
+            schemas.push_back(std::move(BROOKESIA_DESCRIBE_TO_JSON(schema.to_schema())));
+        }
     }
 
     return schemas;
 }
 
+bool EventRegistry::get_item_names(const std::string &event_name, std::vector<std::string> &names)
+{
+    boost::lock_guard lock(event_infos_mutex_);
+
+    auto it = event_infos_.find(event_name);
+    if (it == event_infos_.end()) {
+        return false;
+    }
+
+    auto &schema = std::get<1>(it->second);
+    names.clear();
+    names.reserve(schema.items.size());
+    for (const auto &item : schema.items) {
+        names.emplace_back(item.name);
+    }
+
+    return true;
+}
+
 EventRegistry::Subscriptions EventRegistry::get_subscriptions(const std::string &event_name)
 {
     boost::lock_guard lock(event_infos_mutex_);
@@ -207,4 +243,28 @@ EventRegistry::Signal *EventRegistry::get_signal(const std::string &event_name)
     return std::get<2>(it->second).get();
 }
 
+bool EventRegistry::add_internal(const EventSchemaView &event_schema, std::unique_ptr<OwnedSchema> owned)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_CHECK_FALSE_RETURN(!event_schema.name.empty(), false, "Event name is empty");
+
+    boost::lock_guard lock(event_infos_mutex_);
+
+    if (event_infos_.find(event_schema.name) != event_infos_.end()) {
+        BROOKESIA_LOGD("Event already exists, skip register");
+        return true;
+    }
+
+    std::unique_ptr<Signal> signal;
+    BROOKESIA_CHECK_EXCEPTION_RETURN(
+        signal = std::make_unique<Signal>(), false, "Failed to create signal"
+    );
+    event_infos_.emplace(
+        event_schema.name, std::make_tuple(Subscriptions(), event_schema, std::move(signal), std::move(owned))
+    );
+
+    return true;
+}
+
 } // namespace esp_brookesia::service
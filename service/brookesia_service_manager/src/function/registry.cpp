@@ -12,7 +12,9 @@
 
 namespace esp_brookesia::service {
 
-bool FunctionRegistry::add(FunctionSchema &&func_schema, FunctionHandler &&func_handler)
+bool FunctionRegistry::add(
+    FunctionSchema &&func_schema, FunctionHandler &&func_handler, TypedFunctionHandler &&typed_handler
+)
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
@@ -21,23 +23,44 @@ bool FunctionRegistry::add(FunctionSchema &&func_schema, FunctionHandler &&func_
         BROOKESIA_DESCRIBE_TO_STR(func_handler)
     );
 
-    BROOKESIA_CHECK_FALSE_RETURN(!func_schema.name.empty(), false, "Function name is empty");
-    BROOKESIA_CHECK_FALSE_RETURN(func_handler != nullptr, false, "Function handler is null");
-
-    boost::lock_guard lock(functions_mutex_);
-
-    BROOKESIA_CHECK_FALSE_RETURN(
-        functions_.find(func_schema.name) == functions_.end(), false,
-        "Function `%1%` already registered", func_schema.name
+    std::unique_ptr<OwnedSchema> owned;
+    BROOKESIA_CHECK_EXCEPTION_RETURN(
+        owned = std::make_unique<OwnedSchema>(), false, "Failed to create owned schema"
     );
+    owned->schema = std::move(func_schema);
+
+    // Build the view after the schema is moved into its final place, so the referenced strings stay valid
+    owned->parameters.reserve(owned->schema.parameters.size());
+    for (const auto &param : owned->schema.parameters) {
+        owned->parameters.push_back(FunctionParameterSchemaView{
+            .name = SchemaString(param.name),
+            .description = SchemaString(param.description),
+            .type = param.type,
+            .default_value = param.default_value.has_value() ?
+            FunctionDefaultValue::from_value(param.default_value.value()) : FunctionDefaultValue(),
+        });
+    }
+    FunctionSchemaView view{
+        .name = SchemaString(owned->schema.name),
+        .description = SchemaString(owned->schema.description),
+        .parameters = owned->parameters,
+    };
 
-    // Copy the function name because func_schema.name will be moved afterwards
-    auto func_name = func_schema.name;
-    functions_[func_name] = std::make_pair(std::move(func_schema), std::move(func_handler));
+    return add_internal(view, std::move(func_handler), std::move(typed_handler), std::move(owned));
+}
 
-    BROOKESIA_LOGD("Register function `%1%`", func_name);
+bool FunctionRegistry::add(
+    const FunctionSchemaView &func_schema, FunctionHandler &&func_handler, TypedFunctionHandler &&typed_handler
+)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
-    return true;
+    BROOKESIA_LOGD(
+        "Params: func_schema(%1%), func_handler(%2%)", std::string_view(func_schema.name),
+        BROOKESIA_DESCRIBE_TO_STR(func_handler)
+    );
+
+    return add_internal(func_schema, std::move(func_handler), std::move(typed_handler), nullptr);
 }
 
 bool FunctionRegistry::remove(const std::string &func_name)
@@ -54,6 +77,7 @@ bool FunctionRegistry::remove(const std::string &func_name)
     );
 
     functions_.erase(it);
+    change_count_.fetch_add(1, std::memory_order_release);
 
     BROOKESIA_LOGD("Unregister function `%1%`", func_name);
 
@@ -65,7 +89,10 @@ bool FunctionRegistry::remove_all()
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
     boost::lock_guard lock(functions_mutex_);
-    functions_.clear();
+    if (!functions_.empty()) {
+        functions_.clear();
+        change_count_.fetch_add(1, std::memory_order_release);
+    }
 
     return true;
 }
@@ -89,8 +116,8 @@ FunctionResult FunctionRegistry::call(const std::string &func_name, FunctionPara
         BROOKESIA_CHECK_FALSE_RETURN(false, error_result, "%1%", error_message);
     }
 
-    auto &func_schema = func_it->second.first;
-    auto &func_handler = func_it->second.second;
+    auto &func_schema = func_it->second.schema;
+    auto &func_handler = func_it->second.handler;
 
     // Validate parameters and fill default values
     FunctionParameterMap validated_parameters = std::move(parameters);
@@ -106,8 +133,8 @@ std::vector<FunctionSchema> FunctionRegistry::get_schemas()
 {
     std::vector<FunctionSchema> definitions;
     boost::lock_guard lock(functions_mutex_);
-    for (const auto& [func_name, func_schema_handler] : functions_) {
-        definitions.push_back(func_schema_handler.first);
+    for (const auto& [func_name, func_info] : functions_) {
+        definitions.push_back(func_info.owned ? func_info.owned->schema : func_info.schema.to_schema());
     }
 
     return definitions;
@@ -117,31 +144,90 @@ boost::json::array FunctionRegistry::get_schemas_json()
 {
     boost::json::array schema;
     boost::lock_guard lock(functions_mutex_);
-    for (const auto& [_, func_schema_handler] : functions_) {
-        const auto &[func_schema, handler] = func_schema_handler;
-        schema.push_back(std::move(BROOKESIA_DESCRIBE_TO_JSON(func_schema)));
+    for (const auto& [_, func_info] : functions_) {
+        if (func_info.owned) {
+            schema.push_back(std::move(BROOKESIA_DESCRIBE_TO_JSON(func_info.owned->schema)));
+        } else {
+            schema.push_back(std::move(BROOKESIA_DESCRIBE_TO_JSON(func_info.schema.to_schema())));
+        }
     }
 
     return schema;
 }
 
+void FunctionRegistry::visit_schemas(const std::function<void(const FunctionSchemaView &)> &visitor)
+{
+    boost::lock_guard lock(functions_mutex_);
+    for (const auto& [_, func_info] : functions_) {
+        visitor(func_info.schema);
+    }
+}
+
+bool FunctionRegistry::get_parameter_names(const std::string &func_name, std::vector<std::string> &names)
+{
+    boost::lock_guard lock(functions_mutex_);
+
+    auto func_it = functions_.find(func_name);
+    if (func_it == functions_.end()) {
+        return false;
+    }
+
+    names.clear();
+    names.reserve(func_it->second.schema.parameters.size());
+    for (const auto &param : func_it->second.schema.parameters) {
+        names.emplace_back(param.name);
+    }
+
+    return true;
+}
+
+bool FunctionRegistry::add_internal(
+    const FunctionSchemaView &func_schema, FunctionHandler &&func_handler, TypedFunctionHandler &&typed_handler,
+    std::unique_ptr<OwnedSchema> owned
+)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_CHECK_FALSE_RETURN(!func_schema.name.empty(), false, "Function name is empty");
+    BROOKESIA_CHECK_FALSE_RETURN(func_handler != nullptr, false, "Function handler is null");
+
+    boost::lock_guard lock(functions_mutex_);
+
+    BROOKESIA_CHECK_FALSE_RETURN(
+        functions_.find(func_schema.name) == functions_.end(), false,
+        "Function `%1%` already registered", std::string_view(func_schema.name)
+    );
+
+    functions_.emplace(func_schema.name, FunctionInfo{
+        .schema = func_schema,
+        .handler = std::move(func_handler),
+        .typed_handler = std::move(typed_handler),
+        .owned = std::move(owned),
+    });
+    change_count_.fetch_add(1, std::memory_order_release);
+
+    BROOKESIA_LOGD("Register function `%1%`", std::string_view(func_schema.name));
+
+    return true;
+}
+
 bool FunctionRegistry::validate_parameters(
-    const FunctionSchema &func_schema, FunctionParameterMap &parameters, std::string &error_msg
+    const FunctionSchemaView &func_schema, FunctionParameterMap &parameters, std::string &error_msg
 )
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
     // Check required parameters and fill default values
     for (const auto &param : func_schema.parameters) {
-        auto it = parameters.find(param.name);
+        auto it = parameters.find(std::string_view(param.name));
 
         if (it == parameters.end()) {
             if (param.is_required()) {
-                error_msg = "Missing required parameter: `" + param.name + "`";
+                error_msg = "Missing required parameter: `" + std::string(param.name) + "`";
                 break;
             } else {
                 // Fill default value for optional parameters
-                parameters[param.name] = param.default_value.value();
+                parameters.emplace(param.name, param.default_value.value());
             }
         } else {
             // Validate the type of the provided parameter
@@ -159,7 +245,7 @@ bool FunctionRegistry::validate_parameters(
                 } else if (std::holds_alternative<boost::json::array>(it->second)) {
                     actual_type = FunctionValueType::Array;
                 }
-                error_msg = "Invalid type for parameter `" + param.name +
+                error_msg = "Invalid type for parameter `" + std::string(param.name) +
                             "`: expected `" + BROOKESIA_DESCRIBE_TO_STR(param.type) +
                             "`, but got `" + BROOKESIA_DESCRIBE_TO_STR(actual_type) + "`";
                 break;
@@ -143,34 +143,32 @@ std::future<FunctionResult> ServiceBase::call_function_async(
         result_promise->set_value(std::move(result));
     };
 
-    // Get the function definitions
-    auto function_definitions = get_function_definitions();
-
-    // Find the corresponding function definition
-    const FunctionSchema *function_def = nullptr;
-    for (const auto &def : function_definitions) {
-        if (def.name == name) {
-            function_def = &def;
-            break;
-        }
+    // Get the parameter names of the function, in the order of the definition. The registry is only filled while
+    // running, otherwise they are taken from the definitions, so the errors are the same as the map overload
+    std::shared_ptr<FunctionRegistry> registry;
+    {
+        boost::shared_lock lock(registry_mutex_);
+        registry = function_registry_;
     }
-
-    if (!function_def) {
+    std::vector<std::string> parameter_names;
+    bool is_found = (registry && registry->get_parameter_names(name, parameter_names)) ||
+                    get_defined_parameter_names(name, parameter_names);
+    if (!is_found) {
         set_error("Function definition not found: " + name);
         return result_future;
     }
 
     // Check if the parameter count matches
-    if (parameters_values.size() != function_def->parameters.size()) {
+    if (parameters_values.size() != parameter_names.size()) {
         set_error((boost::format("Function parameter count mismatch: expected %1%, got %2%")
-                   % function_def->parameters.size() % parameters_values.size()).str());
+                   % parameter_names.size() % parameters_values.size()).str());
         return result_future;
     }
 
     // Convert the vector to map according to the function definition parameter order
     FunctionParameterMap parameters_map;
-    for (size_t i = 0; i < function_def->parameters.size(); i++) {
-        parameters_map[function_def->parameters[i].name] = std::move(parameters_values[i]);
+    for (size_t i = 0; i < parameter_names.size(); i++) {
+        parameters_map[std::move(parameter_names[i])] = std::move(parameters_values[i]);
     }
 
     return call_function_async(name, std::move(parameters_map));
@@ -259,6 +257,65 @@ FunctionResult ServiceBase::call_function_sync(
     return result_future.get();
 }
 
+bool ServiceBase::post_function_call(
+    const std::string &name, std::function<void(FunctionRegistry &)> &&call, std::string &error_message
+)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_LOGD("Params: name(%1%)", name);
+
+    if (!is_running()) {
+        error_message = "Service is not running";
+        BROOKESIA_LOGE("%1%", error_message);
+        return false;
+    }
+
+    // Thread-safe get the copies of registry and scheduler
+    std::shared_ptr<FunctionRegistry> registry;
+    std::shared_ptr<lib_utils::TaskScheduler> scheduler;
+    boost::asio::io_context *io_ctx;
+    {
+        boost::shared_lock lock(registry_mutex_);
+        registry = function_registry_;
+        scheduler = task_scheduler_;
+        io_ctx = io_context_;
+    }
+
+    if (!registry) {
+        error_message = "Function registry not initialized";
+        BROOKESIA_LOGE("%1%", error_message);
+        return false;
+    }
+
+    if (!registry->has(name)) {
+        error_message = "Function not found: " + name;
+        BROOKESIA_LOGE("%1%", error_message);
+        return false;
+    }
+
+    auto task = [registry, call = std::move(call)]() {
+        BROOKESIA_LOG_TRACE_GUARD();
+        call(*registry);
+    };
+
+    if (scheduler) {
+        if (!scheduler->post(std::move(task), nullptr, SERVICE_REQUEST_TASK_GROUP)) {
+            error_message = "Failed to post task";
+            BROOKESIA_LOGE("%1%", error_message);
+            return false;
+        }
+    } else if (io_ctx) {
+        boost::asio::post(*io_ctx, std::move(task));
+    } else {
+        error_message = "Neither task scheduler nor io_context available";
+        BROOKESIA_LOGE("%1%", error_message);
+        return false;
+    }
+
+    return true;
+}
+
 EventRegistry::SignalConnection ServiceBase::subscribe_event(
     const std::string &event_name, const EventRegistry::SignalSlot &slot
 )
@@ -360,29 +417,28 @@ bool ServiceBase::publish_event(const std::string &event_name, std::vector<Event
 
     BROOKESIA_CHECK_FALSE_RETURN(is_running(), false, "Not running");
 
-    // Get the event definitions
-    auto event_definitions = get_event_definitions();
-
-    // Find the corresponding event definition
-    const EventSchema *event_def = nullptr;
-    for (const auto &def : event_definitions) {
-        if (def.name == event_name) {
-            event_def = &def;
-            break;
-        }
+    // Get the item names of the event, in the order of the definition
+    std::shared_ptr<EventRegistry> registry;
+    {
+        boost::shared_lock lock(registry_mutex_);
+        registry = event_registry_;
     }
-    BROOKESIA_CHECK_NULL_RETURN(event_def, false, "Event definition not found: %1%", event_name);
+    std::vector<std::string> item_names;
+    BROOKESIA_CHECK_FALSE_RETURN(
+        registry && registry->get_item_names(event_name, item_names), false, "Event definition not found: %1%",
+        event_name
+    );
 
     // Check if the value count matches
     BROOKESIA_CHECK_FALSE_RETURN(
-        data_values.size() == event_def->items.size(), false,
-        "Event value count mismatch: expected %1%, got %2%", event_def->items.size(), data_values.size()
+        data_values.size() == item_names.size(), false,
+        "Event value count mismatch: expected %1%, got %2%", item_names.size(), data_values.size()
     );
 
     // Convert the vector to map according to the event definition data order
     EventItemMap event_items;
-    for (size_t i = 0; i < event_def->items.size(); i++) {
-        event_items[event_def->items[i].name] = std::move(data_values[i]);
+    for (size_t i = 0; i < item_names.size(); i++) {
+        event_items[std::move(item_names[i])] = std::move(data_values[i]);
     }
 
     return publish_event(event_name, std::move(event_items));
@@ -523,20 +579,32 @@ bool ServiceBase::start_internal()
 
     BROOKESIA_CHECK_FALSE_RETURN(on_start(), false, "Failed to start service");
 
-    // Auto-register functions
-    auto function_definitions = get_function_definitions();
-    auto function_handlers = get_function_handlers();
-    if (!function_definitions.empty()) {
+    // Auto-register functions, the constant definitions are preferred since they are referenced instead of copied
+    auto function_schema_views = get_function_schema_views();
+    if (!function_schema_views.empty()) {
         BROOKESIA_CHECK_FALSE_RETURN(
-            register_functions(std::move(function_definitions), std::move(function_handlers)), false,
-            "Failed to register functions"
+            register_functions(function_schema_views, get_function_handlers()), false, "Failed to register functions"
         );
+    } else {
+        auto function_definitions = get_function_definitions();
+        auto function_handlers = get_function_handlers();
+        if (!function_definitions.empty()) {
+            BROOKESIA_CHECK_FALSE_RETURN(
+                register_functions(std::move(function_definitions), std::move(function_handlers)), false,
+                "Failed to register functions"
+            );
+        }
     }
 
     // Auto-register events
-    auto event_definitions = get_event_definitions();
-    if (!event_definitions.empty()) {
-        BROOKESIA_CHECK_FALSE_RETURN(register_events(std::move(event_definitions)), false, "Failed to register events");
+    auto event_schema_views = get_event_schema_views();
+    if (!event_schema_views.empty()) {
+        BROOKESIA_CHECK_FALSE_RETURN(register_events(event_schema_views), false, "Failed to register events");
+    } else {
+        auto event_definitions = get_event_definitions();
+        if (!event_definitions.empty()) {
+            BROOKESIA_CHECK_FALSE_RETURN(register_events(std::move(event_definitions)), false, "Failed to register events");
+        }
     }
 
     if (is_server_connected()) {
@@ -687,6 +755,31 @@ void ServiceBase::try_override_connection_request_handler()
     server_connection_->set_request_handler(request_handler);
 }
 
+bool ServiceBase::get_defined_parameter_names(const std::string &name, std::vector<std::string> &names)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    names.clear();
+    for (const auto &definition : get_function_schema_views()) {
+        if (definition.name == name) {
+            for (const auto &parameter : definition.parameters) {
+                names.emplace_back(parameter.name);
+            }
+            return true;
+        }
+    }
+    for (auto &definition : get_function_definitions()) {
+        if (definition.name == name) {
+            for (auto &parameter : definition.parameters) {
+                names.push_back(std::move(parameter.name));
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
 bool ServiceBase::register_functions(std::vector<FunctionSchema> &&definitions, FunctionHandlerMap &&handlers)
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
@@ -712,7 +805,9 @@ bool ServiceBase::register_functions(std::vector<FunctionSchema> &&definitions,
             continue;
         }
 
-        if (!function_registry_->add(std::move(def), std::move(it->second))) {
+        if (!function_registry_->add(
+                    std::move(def), std::move(it->second.handler), std::move(it->second.typed_handler)
+                )) {
             BROOKESIA_LOGE("Failed to register function: %1%", func_name);
             continue;
         }
@@ -725,6 +820,43 @@ bool ServiceBase::register_functions(std::vector<FunctionSchema> &&definitions,
     return true;
 }
 
+bool ServiceBase::register_functions(std::span<const FunctionSchemaView> definitions, FunctionHandlerMap &&handlers)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_CHECK_FALSE_RETURN(is_initialized(), false, "Not initialized");
+
+    // Use write lock to protect the registry modifications
+    boost::lock_guard lock(registry_mutex_);
+
+    size_t registered_count = 0;
+    const size_t total_count = definitions.size();
+    // Avoid compiler warning about unused variable
+    (void)total_count;
+
+    for (const auto &def : definitions) {
+        BROOKESIA_LOGD("Registering function: %1%", std::string_view(def.name));
+
+        auto it = handlers.find(def.name);
+        if (it == handlers.end()) {
+            BROOKESIA_LOGE("Handler not found for function: %1%", std::string_view(def.name));
+            continue;
+        }
+
+        // Only the view is stored, the schema itself stays where it is defined
+        if (!function_registry_->add(def, std::move(it->second.handler), std::move(it->second.typed_handler))) {
+            BROOKESIA_LOGE("Failed to register function: %1%", std::string_view(def.name));
+            continue;
+        }
+
+        registered_count++;
+    }
+
+    BROOKESIA_LOGI("[%1%] Registered %2%/%3% functions", attributes_.name, registered_count, total_count);
+
+    return true;
+}
+
 bool ServiceBase::register_events(std::vector<EventSchema> &&definitions)
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
@@ -757,4 +889,34 @@ bool ServiceBase::register_events(std::vector<EventSchema> &&definitions)
     return true;
 }
 
+bool ServiceBase::register_events(std::span<const EventSchemaView> definitions)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_CHECK_FALSE_RETURN(is_initialized(), false, "Not initialized");
+
+    // Use write lock to protect the registry modifications
+    boost::lock_guard lock(registry_mutex_);
+
+    size_t registered_count = 0;
+    const size_t total_count = definitions.size();
+    // Avoid compiler warning about unused variable
+    (void)total_count;
+
+    for (const auto &def : definitions) {
+        BROOKESIA_LOGD("Registering event: %1%", std::string_view(def.name));
+
+        if (!event_registry_->add(def)) {
+            BROOKESIA_LOGE("Failed to register event: %1%", std::string_view(def.name));
+            continue;
+        }
+
+        registered_count++;
+    }
+
+    BROOKESIA_LOGI("[%1%] Registered %2%/%3% events", attributes_.name, registered_count, total_count);
+
+    return true;
+}
+
 } // namespace esp_brookesia::service
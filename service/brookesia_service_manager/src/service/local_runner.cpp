@@ -3,8 +3,10 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
+#if defined(ESP_PLATFORM)
+#   include "freertos/FreeRTOS.h"
+#   include "freertos/task.h"
+#endif
 #include "brookesia/lib_utils.hpp"
 #include "brookesia/service_manager/service/manager.hpp"
 #include "brookesia/service_manager/service/local_runner.hpp"
@@ -4,7 +4,9 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <chrono>
-#include "esp_netif.h"
+#if defined(ESP_PLATFORM)
+#   include "esp_netif.h"
+#endif
 #include "brookesia/service_manager/macro_configs.h"
 #if !BROOKESIA_SERVICE_MANAGER_SERVICE_ENABLE_DEBUG_LOG
 #   define BROOKESIA_LOG_DISABLE_DEBUG_TRACE 1
@@ -401,7 +403,9 @@ bool ServiceManager::start_rpc_server(const rpc::Server::Config &config, uint32_
         rpc_server_.reset();
     });
 
+#if defined(ESP_PLATFORM)
     BROOKESIA_CHECK_ESP_ERR_RETURN(esp_netif_init(), false, "Failed to initialize ESP-NETIF");
+#endif
 
     BROOKESIA_CHECK_EXCEPTION_RETURN(
         rpc_server_ = std::make_unique<rpc::Server>(io_context_, config), false, "Failed to create RPC server"
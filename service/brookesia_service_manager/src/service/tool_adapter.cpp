@@ -0,0 +1,213 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include "brookesia/service_manager/macro_configs.h"
+#if !BROOKESIA_SERVICE_MANAGER_SERVICE_ENABLE_DEBUG_LOG
+#   define BROOKESIA_LOG_DISABLE_DEBUG_TRACE 1
+#endif
+#include "private/utils.hpp"
+#include "brookesia/service_manager/service/tool_adapter.hpp"
+
+namespace esp_brookesia::service {
+
+namespace {
+
+const char *get_json_type(FunctionValueType type)
+{
+    switch (type) {
+    case FunctionValueType::Boolean:
+        return "boolean";
+    case FunctionValueType::Number:
+        return "number";
+    case FunctionValueType::String:
+        return "string";
+    case FunctionValueType::Object:
+        return "object";
+    case FunctionValueType::Array:
+        return "array";
+    default:
+        return "string";
+    }
+}
+
+boost::json::value to_json_value(const FunctionValue &value)
+{
+    return std::visit([](const auto & v) -> boost::json::value {
+        return boost::json::value(v);
+    }, value);
+}
+
+std::future<FunctionResult> make_error_future(std::string error_message)
+{
+    BROOKESIA_LOGE("%1%", error_message);
+
+    std::promise<FunctionResult> promise;
+    promise.set_value(FunctionResult{
+        .success = false,
+        .error_message = std::move(error_message),
+    });
+
+    return promise.get_future();
+}
+
+} // namespace
+
+std::shared_ptr<const std::string> ServiceToolAdapter::get_tools_json()
+{
+    auto cache = get_cache();
+
+    // Shares the ownership of the cache
+    return std::shared_ptr<const std::string>(cache, &cache->json);
+}
+
+std::future<FunctionResult> ServiceToolAdapter::call_tool_async(
+    std::string_view tool_name, boost::json::object &&arguments
+)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    auto cache = get_cache();
+    auto tool_it = cache->tools.find(tool_name);
+    if (tool_it == cache->tools.end()) {
+        return make_error_future("Tool not found: " + std::string(tool_name));
+    }
+    auto service = tool_it->second.service.lock();
+    if (!service) {
+        return make_error_future("Service of the tool is removed: " + std::string(tool_name));
+    }
+
+    // JSON numbers are integers or doubles, the functions only take doubles
+    FunctionParameterMap parameters;
+    for (auto &argument : arguments) {
+        std::string key(argument.key());
+        auto &value = argument.value();
+        switch (value.kind()) {
+        case boost::json::kind::bool_:
+            parameters.emplace(std::move(key), value.get_bool());
+            break;
+        case boost::json::kind::int64:
+        case boost::json::kind::uint64:
+        case boost::json::kind::double_:
+            parameters.emplace(std::move(key), value.to_number<double>());
+            break;
+        case boost::json::kind::string:
+            parameters.emplace(std::move(key), std::string(value.get_string()));
+            break;
+        case boost::json::kind::object:
+            parameters.emplace(std::move(key), std::move(value.get_object()));
+            break;
+        case boost::json::kind::array:
+            parameters.emplace(std::move(key), std::move(value.get_array()));
+            break;
+        default:
+            // `null`, left to the default value
+            break;
+        }
+    }
+
+    return service->call_function_async(tool_it->second.function_name, std::move(parameters));
+}
+
+std::future<FunctionResult> ServiceToolAdapter::call_tool_async(
+    std::string_view tool_name, std::string_view arguments_json
+)
+{
+    if (arguments_json.empty()) {
+        return call_tool_async(tool_name, boost::json::object());
+    }
+
+    boost::system::error_code ec;
+    auto arguments = boost::json::parse(arguments_json, ec);
+    if (ec || !arguments.is_object()) {
+        return make_error_future(
+                   "Invalid arguments of tool " + std::string(tool_name) + ": " + std::string(arguments_json)
+               );
+    }
+
+    return call_tool_async(tool_name, std::move(arguments.as_object()));
+}
+
+bool ServiceToolAdapter::has_tool(std::string_view tool_name)
+{
+    auto cache = get_cache();
+    return cache->tools.find(tool_name) != cache->tools.end();
+}
+
+std::shared_ptr<const ServiceToolAdapter::Cache> ServiceToolAdapter::get_cache()
+{
+    // Read before building, so that a change during the build triggers another one
+    auto change_count = FunctionRegistry::get_change_count();
+
+    boost::lock_guard lock(cache_mutex_);
+    if (!cache_ || (cache_->change_count != change_count)) {
+        cache_ = build_cache(change_count);
+        build_count_++;
+    }
+
+    return cache_;
+}
+
+std::shared_ptr<const ServiceToolAdapter::Cache> ServiceToolAdapter::build_cache(uint64_t change_count)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    auto cache = std::make_shared<Cache>();
+    cache->change_count = change_count;
+
+    boost::json::array tools_json;
+    for (const auto &service : manager_.get_services()) {
+        const auto &service_name = service->get_attributes().name;
+        if (!config_.services.empty() &&
+                (std::find(config_.services.begin(), config_.services.end(), service_name) == config_.services.end())) {
+            continue;
+        }
+        auto registry = service->get_function_registry();
+        if (!registry) {
+            continue;
+        }
+
+        registry->visit_schemas([&](const FunctionSchemaView & schema) {
+            std::string tool_name = service_name + config_.name_separator + std::string(schema.name);
+
+            boost::json::object properties;
+            boost::json::array required;
+            for (const auto &param : schema.parameters) {
+                boost::json::object property{
+                    {"type", get_json_type(param.type)},
+                    {"description", std::string_view(param.description)},
+                };
+                if (param.default_value.has_value()) {
+                    property["default"] = to_json_value(param.default_value.value());
+                } else {
+                    required.emplace_back(std::string_view(param.name));
+                }
+                properties[std::string_view(param.name)] = std::move(property);
+            }
+            tools_json.emplace_back(boost::json::object{
+                {"name", tool_name},
+                {"description", std::string_view(schema.description)},
+                {
+                    "parameters", boost::json::object{
+                        {"type", "object"},
+                        {"properties", std::move(properties)},
+                        {"required", std::move(required)},
+                    }
+                },
+            });
+            cache->tools.emplace(std::move(tool_name), Tool{
+                .service = service,
+                .function_name = std::string(schema.name),
+            });
+        });
+    }
+    cache->json = boost::json::serialize(tools_json);
+
+    BROOKESIA_LOGD("Built %1% tools: %2%", cache->tools.size(), cache->json);
+
+    return cache;
+}
+
+} // namespace esp_brookesia::service
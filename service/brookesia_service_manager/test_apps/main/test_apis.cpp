@@ -5,12 +5,16 @@
  */
 #include <atomic>
 #include <memory>
+#include <span>
 #include <string>
 #include "unity.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "brookesia/lib_utils/thread_config.hpp"
+#include "boost/json.hpp"
 #include "brookesia/service_manager.hpp"
+#include "brookesia/service_helper/nvs.hpp"
+#include "brookesia/service_helper/wifi.hpp"
 #include "common_def.hpp"
 
 using namespace esp_brookesia::service;
@@ -1318,6 +1322,194 @@ TEST_CASE("Test APIs: async call with mixed sync and async", "[brookesia][servic
     service_manager.deinit();
 }
 
+TEST_CASE("Test APIs: constant schema registry", "[brookesia][service][api][schema_view]")
+{
+    BROOKESIA_LOGI("=== Test constant schema registry ===");
+
+    static constexpr FunctionParameterSchemaView PARAMETERS[] = {
+        {"text", "Required text", FunctionValueType::String},
+        {"count", "Optional count", FunctionValueType::Number, 3.0},
+        {"items", "Optional items", FunctionValueType::Array, FunctionDefaultValue::from_json("[1,2]")},
+    };
+    static constexpr FunctionSchemaView SCHEMA = {"repeat", "Repeat a text", PARAMETERS};
+
+    FunctionRegistry registry;
+    TEST_ASSERT_TRUE(registry.add(SCHEMA, [](FunctionParameterMap && args) -> FunctionResult {
+        auto count = std::get<double>(args.at("count"));
+        auto &items = std::get<boost::json::array>(args.at("items"));
+        return FunctionResult{
+            .success = true,
+            .data = FunctionValue(count + static_cast<double>(items.size())),
+        };
+    }));
+    TEST_ASSERT_FALSE(registry.add(SCHEMA, [](FunctionParameterMap &&) -> FunctionResult {
+        return FunctionResult{};
+    }));
+    TEST_ASSERT_TRUE(registry.has("repeat"));
+
+    // The default values are filled from the constant schema
+    auto result = registry.call("repeat", {{"text", std::string("hello")}});
+    TEST_ASSERT_TRUE(result.success);
+    TEST_ASSERT_EQUAL(5, static_cast<int>(std::get<double>(result.data.value())));
+
+    // The required parameter and the types are still checked
+    TEST_ASSERT_FALSE(registry.call("repeat", {}).success);
+    TEST_ASSERT_FALSE(registry.call("repeat", {{"text", 1.0}}).success);
+
+    std::vector<std::string> names;
+    TEST_ASSERT_TRUE(registry.get_parameter_names("repeat", names));
+    TEST_ASSERT_EQUAL(3, names.size());
+    TEST_ASSERT_EQUAL_STRING("items", names[2].c_str());
+
+    auto schemas = registry.get_schemas();
+    TEST_ASSERT_EQUAL(1, schemas.size());
+    TEST_ASSERT_EQUAL_STRING("repeat", schemas[0].name.c_str());
+    TEST_ASSERT_TRUE(schemas[0].parameters[1].default_value.has_value());
+}
+
+TEST_CASE("Test APIs: typed call and function stub", "[brookesia][service][api][function_stub]")
+{
+    BROOKESIA_LOGI("=== Test typed call and function stub ===");
+
+    static constexpr FunctionParameterSchemaView REPEAT_PARAMETERS[] = {
+        {"text", "Text to repeat", FunctionValueType::String},
+        {"count", "Repeat count", FunctionValueType::Number},
+    };
+    static constexpr FunctionSchemaView REPEAT_SCHEMA = {"repeat", "Repeat a text", REPEAT_PARAMETERS};
+
+    auto repeat = [](const std::string & text, int count) {
+        std::string result;
+        for (int i = 0; i < count; i++) {
+            result += text;
+        }
+        return result;
+    };
+    int typed_count = 0;
+    FunctionRegistry registry;
+    TEST_ASSERT_TRUE(registry.add(REPEAT_SCHEMA, [&](FunctionParameterMap && args) -> FunctionResult {
+        return FunctionResult{
+            .success = true,
+            .data = FunctionValue(repeat(
+                std::get<std::string>(args.at("text")), static_cast<int>(std::get<double>(args.at("count")))
+            )),
+        };
+    }, make_typed_function_handler<std::string, int>([&](std::string & text, int &count) {
+        typed_count++;
+        return std::expected<std::string, std::string>(repeat(text, count));
+    })));
+
+    // Same signature as the typed handler: called directly
+    std::string text = "ab";
+    int count = 2;
+    auto typed_result = registry.call_typed<std::string, std::string, int>("repeat", text, count);
+    TEST_ASSERT_TRUE(typed_result.has_value());
+    TEST_ASSERT_EQUAL_STRING("abab", typed_result.value().c_str());
+    TEST_ASSERT_EQUAL(1, typed_count);
+
+    // Other signature: converted and passed to the generic handler
+    double count_number = 3;
+    auto generic_result = registry.call_typed<std::string, std::string, double>("repeat", text, count_number);
+    TEST_ASSERT_TRUE(generic_result.has_value());
+    TEST_ASSERT_EQUAL_STRING("ababab", generic_result.value().c_str());
+    TEST_ASSERT_EQUAL(1, typed_count);
+
+    // Wrong types are still rejected on the generic path
+    bool flag = true;
+    TEST_ASSERT_FALSE((registry.call_typed<std::string, std::string, bool>("repeat", text, flag).has_value()));
+
+    // Stub of the `add` function of the test service, which only has generic handlers
+    static constexpr FunctionParameterSchemaView ADD_PARAMETERS[] = {
+        {"a", "First number", FunctionValueType::Number},
+        {"b", "Second number", FunctionValueType::Number},
+    };
+    static constexpr FunctionSchemaView ADD_SCHEMA = {"add", "Add two numbers", ADD_PARAMETERS};
+    static constexpr FunctionStub<double(double, double)> ADD_STUB{TestService::SERVICE_NAME, ADD_SCHEMA};
+
+    auto parameters_json = ADD_STUB.to_json(1.0, 2.0);
+    TEST_ASSERT_EQUAL(2, parameters_json.size());
+    TEST_ASSERT_EQUAL(2, static_cast<int>(parameters_json.at("b").as_double()));
+
+    TEST_ASSERT_TRUE(service_manager.init());
+    TEST_ASSERT_TRUE(service_manager.start());
+
+    auto binding = service_manager.bind(TestService::SERVICE_NAME);
+    TEST_ASSERT_TRUE(binding.is_valid());
+    auto service = binding.get_service();
+    TEST_ASSERT_NOT_NULL(service);
+
+    auto add_result = ADD_STUB.call_sync(*service, 100, 10.0, 20.0);
+    TEST_ASSERT_TRUE(add_result.has_value());
+    TEST_ASSERT_EQUAL(30, static_cast<int>(add_result.value()));
+
+    auto add_future = ADD_STUB.call_async(*service, 1.0, 2.0);
+    TEST_ASSERT_EQUAL(3, static_cast<int>(add_future.get().value()));
+
+    // Not running
+    binding.release();
+    TEST_ASSERT_FALSE(ADD_STUB.call_sync(*service, 100, 1.0, 2.0).has_value());
+
+    service_manager.stop();
+    service_manager.deinit();
+}
+
+TEST_CASE("Test APIs: service tool adapter", "[brookesia][service][api][tool_adapter]")
+{
+    BROOKESIA_LOGI("=== Test service tool adapter ===");
+
+    TEST_ASSERT_TRUE(service_manager.init());
+    TEST_ASSERT_TRUE(service_manager.start());
+
+    auto binding = service_manager.bind(TestService::SERVICE_NAME);
+    TEST_ASSERT_TRUE(binding.is_valid());
+
+    ServiceToolAdapter adapter({.services = {TestService::SERVICE_NAME}});
+    auto tools_json = adapter.get_tools_json();
+    TEST_ASSERT_NOT_NULL(tools_json.get());
+    BROOKESIA_LOGI("Tools: %1%", *tools_json);
+
+    auto tools = boost::json::parse(*tools_json).as_array();
+    TEST_ASSERT_EQUAL(2, tools.size());
+    bool is_add_found = false;
+    for (const auto &tool : tools) {
+        const auto &tool_object = tool.as_object();
+        if (tool_object.at("name").as_string() != "test_service__add") {
+            continue;
+        }
+        is_add_found = true;
+        const auto &parameters = tool_object.at("parameters").as_object();
+        TEST_ASSERT_EQUAL_STRING("number", parameters.at("properties").at("a").at("type").as_string().c_str());
+        TEST_ASSERT_EQUAL(2, parameters.at("required").as_array().size());
+    }
+    TEST_ASSERT_TRUE(is_add_found);
+    TEST_ASSERT_TRUE(adapter.has_tool("test_service__echo"));
+    TEST_ASSERT_FALSE(adapter.has_tool("test_service__not_exist"));
+
+    // Not rebuilt until a registry changes
+    auto build_count = adapter.get_build_count();
+    TEST_ASSERT_EQUAL_PTR(tools_json.get(), adapter.get_tools_json().get());
+    TEST_ASSERT_EQUAL(build_count, adapter.get_build_count());
+
+    // Arguments as received from the LLM, integers are converted to numbers
+    auto add_result = adapter.call_tool_async("test_service__add", R"({"a": 10, "b": 2.5})").get();
+    TEST_ASSERT_TRUE_MESSAGE(add_result.success, add_result.error_message.c_str());
+    TEST_ASSERT_EQUAL_DOUBLE(12.5, std::get<double>(*add_result.data));
+
+    auto echo_result = adapter.call_tool_async("test_service__echo", boost::json::object{{"message", "hi"}}).get();
+    TEST_ASSERT_TRUE_MESSAGE(echo_result.success, echo_result.error_message.c_str());
+    TEST_ASSERT_EQUAL_STRING("hi", std::get<std::string>(*echo_result.data).c_str());
+
+    TEST_ASSERT_FALSE(adapter.call_tool_async("test_service__not_exist", "{}").get().success);
+    TEST_ASSERT_FALSE(adapter.call_tool_async("test_service__add", "not json").get().success);
+
+    // Stopping the service removes its functions
+    binding.release();
+    TEST_ASSERT_FALSE(adapter.has_tool("test_service__add"));
+    TEST_ASSERT_GREATER_THAN(build_count, adapter.get_build_count());
+
+    service_manager.stop();
+    service_manager.deinit();
+}
+
 TEST_CASE("Test APIs: async call before service running", "[brookesia][service][api][call_function_async_not_running]")
 {
     BROOKESIA_LOGI("=== Test async call before service running ===");
@@ -1348,10 +1540,98 @@ TEST_CASE("Test APIs: async call before service running", "[brookesia][service][
     TEST_ASSERT_FALSE(result.error_message.empty());
     BROOKESIA_LOGI("Expected error: %1%", result.error_message);
 
+    // The positional call reports the same error, its parameter names come from the definitions
+    auto positional_future = service->call_function_async("add", std::vector<FunctionValue> {10.0, 20.0});
+    auto positional_result = positional_future.get();
+    TEST_ASSERT_FALSE(positional_result.success);
+    TEST_ASSERT_EQUAL_STRING(result.error_message.c_str(), positional_result.error_message.c_str());
+
+    // The parameter count is still checked against the definitions
+    auto mismatch_future = service->call_function_async("add", std::vector<FunctionValue> {10.0});
+    auto mismatch_result = mismatch_future.get();
+    TEST_ASSERT_FALSE(mismatch_result.success);
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, mismatch_result.error_message.find("count mismatch"));
+    BROOKESIA_LOGI("Expected error: %1%", mismatch_result.error_message);
+
     service_manager.stop();
     service_manager.deinit();
 }
 
+// ============================================================================
+// Helper schemas
+// ============================================================================
+
+// The examples are written as JSON literals in the descriptions, make sure they stay valid
+static void check_description_example(const std::string &owner, std::string_view description)
+{
+    constexpr std::string_view EXAMPLE_PREFIX = "Example: ";
+
+    auto pos = description.find(EXAMPLE_PREFIX);
+    if (pos == std::string_view::npos) {
+        return;
+    }
+    auto example = description.substr(pos + EXAMPLE_PREFIX.size());
+    boost::system::error_code ec;
+    boost::json::parse(example, ec);
+    if (ec) {
+        BROOKESIA_LOGE("Invalid example of %1%: %2% (%3%)", owner, example, ec.message());
+    }
+    TEST_ASSERT_FALSE(ec);
+}
+
+static void check_function_examples(std::span<const FunctionSchemaView> definitions)
+{
+    for (const auto &definition : definitions) {
+        std::string name = definition.name;
+        check_description_example(name, definition.description);
+        for (const auto &parameter : definition.parameters) {
+            std::string parameter_name = name + "." + std::string(parameter.name);
+            check_description_example(parameter_name, parameter.description);
+            if (!parameter.default_value.has_value()) {
+                continue;
+            }
+            // The object/array defaults are JSON literals too, parsed when used
+            auto value = parameter.default_value.value();
+            if (parameter.type == FunctionValueType::Object) {
+                TEST_ASSERT_NOT_NULL_MESSAGE(std::get_if<boost::json::object>(&value), parameter_name.c_str());
+            } else if (parameter.type == FunctionValueType::Array) {
+                TEST_ASSERT_NOT_NULL_MESSAGE(std::get_if<boost::json::array>(&value), parameter_name.c_str());
+            }
+        }
+    }
+}
+
+static void check_event_examples(std::span<const EventSchemaView> definitions)
+{
+    for (const auto &definition : definitions) {
+        std::string name = definition.name;
+        check_description_example(name, definition.description);
+        for (const auto &item : definition.items) {
+            check_description_example(name + "." + std::string(item.name), item.description);
+        }
+    }
+}
+
+TEST_CASE("Test APIs: helper schema examples", "[brookesia][service][api][helper_schema_examples]")
+{
+    BROOKESIA_LOGI("=== Test helper schema examples ===");
+
+    using esp_brookesia::service::helper::NVS;
+    using esp_brookesia::service::helper::Wifi;
+
+    check_function_examples(NVS::get_function_schema_views());
+    check_function_examples(Wifi::get_function_schema_views());
+    check_event_examples(Wifi::get_event_schema_views());
+
+    // The definitions built from the views match them
+    auto nvs_definitions = NVS::get_function_definitions();
+    for (size_t i = 0; i < NVS::FunctionIndexMax; i++) {
+        const auto &view = NVS::get_function_schema_views()[i];
+        TEST_ASSERT_EQUAL_STRING(std::string(view.name).c_str(), nvs_definitions[i].name.c_str());
+        TEST_ASSERT_EQUAL(view.parameters.size(), nvs_definitions[i].parameters.size());
+    }
+}
+
 // ============================================================================
 // Stress testing
 // ============================================================================
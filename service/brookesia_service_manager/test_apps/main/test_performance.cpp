@@ -9,6 +9,8 @@
 #include <chrono>
 #include <variant>
 #include "unity.h"
+#include "esp_system.h"
+#include "esp_timer.h"
 #include "boost/format.hpp"
 #include "brookesia/lib_utils.hpp"
 #include "brookesia/service_manager.hpp"
@@ -178,6 +180,61 @@ TEST_CASE("Test Performance with scheduler: concurrent call function", "[brookes
     TEST_ASSERT_TRUE_MESSAGE(result, "Concurrent call function with scheduler test failed");
 }
 
+// A schema table similar to the service helpers, large enough to make the difference measurable
+static constexpr FunctionParameterSchemaView TEST_SCHEMA_PARAMETERS[] = {
+    {"nspace", "The namespace of the key-value pairs, optional. If not provided, the default namespace will be used.",
+     FunctionValueType::String, "storage"},
+    {"keys", "The JSON array of keys, optional. Example: [\"key1\",\"key2\",\"key3\"]", FunctionValueType::Array,
+     FunctionDefaultValue::from_json("[]")},
+    {"timeout_ms", "The timeout in milliseconds, optional", FunctionValueType::Number, 1000.0},
+};
+static constexpr FunctionSchemaView TEST_SCHEMAS[] = {
+    {"schema_function_0", "Return a JSON object of key-value pairs. Example: {\"key1\":\"value1\",\"key2\":2}", TEST_SCHEMA_PARAMETERS},
+    {"schema_function_1", "Return a JSON object of key-value pairs. Example: {\"key1\":\"value1\",\"key2\":2}", TEST_SCHEMA_PARAMETERS},
+    {"schema_function_2", "Return a JSON object of key-value pairs. Example: {\"key1\":\"value1\",\"key2\":2}", TEST_SCHEMA_PARAMETERS},
+    {"schema_function_3", "Return a JSON object of key-value pairs. Example: {\"key1\":\"value1\",\"key2\":2}", TEST_SCHEMA_PARAMETERS},
+    {"schema_function_4", "Return a JSON object of key-value pairs. Example: {\"key1\":\"value1\",\"key2\":2}", TEST_SCHEMA_PARAMETERS},
+    {"schema_function_5", "Return a JSON object of key-value pairs. Example: {\"key1\":\"value1\",\"key2\":2}", TEST_SCHEMA_PARAMETERS},
+    {"schema_function_6", "Return a JSON object of key-value pairs. Example: {\"key1\":\"value1\",\"key2\":2}", TEST_SCHEMA_PARAMETERS},
+    {"schema_function_7", "Return a JSON object of key-value pairs. Example: {\"key1\":\"value1\",\"key2\":2}", TEST_SCHEMA_PARAMETERS},
+};
+
+TEST_CASE("Test Performance: register constant schemas", "[brookesia][service][schema][register]")
+{
+    auto handler = [](FunctionParameterMap &&) -> FunctionResult {
+        return FunctionResult{.success = true};
+    };
+
+    // Register the same table by value (as the schemas built at runtime) and by reference
+    auto measure = [&](bool use_view, size_t &heap_used, int64_t &time_us) {
+        FunctionRegistry registry;
+        size_t free_before = esp_get_free_heap_size();
+        int64_t start_us = esp_timer_get_time();
+        for (const auto &schema : TEST_SCHEMAS) {
+            if (use_view) {
+                TEST_ASSERT_TRUE(registry.add(schema, handler));
+            } else {
+                TEST_ASSERT_TRUE(registry.add(schema.to_schema(), handler));
+            }
+        }
+        time_us = esp_timer_get_time() - start_us;
+        heap_used = free_before - esp_get_free_heap_size();
+    };
+
+    size_t owned_heap = 0;
+    size_t view_heap = 0;
+    int64_t owned_time_us = 0;
+    int64_t view_time_us = 0;
+    measure(false, owned_heap, owned_time_us);
+    measure(true, view_heap, view_time_us);
+
+    BROOKESIA_LOGI(
+        "Register %1% schemas: by value %2% bytes / %3% us, by reference %4% bytes / %5% us", std::size(TEST_SCHEMAS),
+        owned_heap, owned_time_us, view_heap, view_time_us
+    );
+    TEST_ASSERT_LESS_THAN(owned_heap, view_heap);
+}
+
 static boost::json::object service_test_build_add_params()
 {
     boost::json::object params;
@@ -0,0 +1,292 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <atomic>
+#include <fcntl.h>
+#include <unistd.h>
+#include "brookesia/lib_utils.hpp"
+#include "benchmark.hpp"
+
+using namespace esp_brookesia::lib_utils;
+
+namespace esp_brookesia::benchmark {
+
+constexpr int PERIODIC_INTERVAL_MS = 1;
+constexpr uint32_t WAIT_TIMEOUT_MS = 1000;
+constexpr size_t BACKLOG_TASK_COUNT = 32;
+constexpr auto BACKLOG_TASK_DURATION = std::chrono::microseconds(20);
+
+enum class BenchMode {
+    Idle,
+    Active,
+    Sleep,
+};
+
+// Similar to the payloads exchanged by the services
+struct BenchPayload {
+    std::string name;
+    BenchMode mode = BenchMode::Idle;
+    double value = 0;
+    int count = 0;
+    bool enabled = false;
+    std::vector<int> history;
+};
+BROOKESIA_DESCRIBE_ENUM(BenchMode, Idle, Active, Sleep)
+BROOKESIA_DESCRIBE_STRUCT(BenchPayload, (), (name, mode, value, count, enabled, history))
+
+static void run_task_scheduler_cases(Runner &runner, std::shared_ptr<TaskScheduler> scheduler)
+{
+    // Latency from `post()` to the end of the task, on an idle scheduler
+    std::atomic<size_t> finished_count = 0;
+    size_t posted_count = 0;
+    runner.run("task_scheduler.post", ASYNC_ITERATIONS, [&](size_t) {
+        posted_count++;
+        scheduler->post([&finished_count]() {
+            finished_count.fetch_add(1, std::memory_order_release);
+        });
+        wait_until([&]() {
+            return finished_count.load(std::memory_order_acquire) == posted_count;
+        });
+    });
+    scheduler->wait_all(WAIT_TIMEOUT_MS);
+
+    // `dispatch()` from a worker runs the task inline
+    if (runner.is_selected("task_scheduler.dispatch")) {
+        std::atomic<bool> done = false;
+        scheduler->post([&]() {
+            size_t count = 0;
+            runner.run("task_scheduler.dispatch", SYNC_ITERATIONS, [&](size_t) {
+                scheduler->dispatch([&count]() {
+                    count++;
+                });
+            });
+            done.store(true, std::memory_order_release);
+        });
+        bool is_done = wait_until([&]() {
+            return done.load(std::memory_order_acquire);
+        }, std::chrono::milliseconds(60 * 1000));
+        if (!is_done) {
+            runner.add_failure("task_scheduler.dispatch", "Timeout");
+        }
+    }
+
+    // Period measured between two runs of a periodic task, the jitter shows in the percentiles
+    if (runner.is_selected("task_scheduler.periodic_1ms")) {
+        size_t iterations = runner.get_iterations(ASYNC_ITERATIONS);
+        std::vector<int64_t> samples;
+        samples.reserve(iterations);
+        std::atomic<bool> done = false;
+        Clock::time_point last_time{};
+        auto begin = Clock::now();
+        bool is_posted = scheduler->post_periodic([&]() {
+            auto now = Clock::now();
+            if (last_time != Clock::time_point{}) {
+                samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_time).count());
+            }
+            last_time = now;
+            if (samples.size() < iterations) {
+                return true;
+            }
+            done.store(true, std::memory_order_release);
+            return false;
+        }, PERIODIC_INTERVAL_MS);
+        bool is_done = is_posted && wait_until([&]() {
+            return done.load(std::memory_order_acquire);
+        }, std::chrono::milliseconds(iterations * 20 + WAIT_TIMEOUT_MS));
+        if (!is_done) {
+            // The task may still be running, stop it before the samples go out of scope
+            scheduler->cancel_all();
+            scheduler->wait_all(WAIT_TIMEOUT_MS);
+            runner.add_failure("task_scheduler.periodic_1ms", "Timeout");
+        } else {
+            auto total_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count();
+            runner.add_samples("task_scheduler.periodic_1ms", std::move(samples), total_ns);
+        }
+    }
+
+    // Latency from `post()` to the start of a high priority task, posted behind a backlog of low priority tasks
+    if (runner.is_selected("task_scheduler.post_high_over_backlog")) {
+        size_t iterations = runner.get_iterations(ASYNC_ITERATIONS);
+        std::vector<int64_t> samples;
+        samples.reserve(iterations);
+        auto begin = Clock::now();
+        for (size_t i = 0; i < iterations; i++) {
+            for (size_t j = 0; j < BACKLOG_TASK_COUNT; j++) {
+                scheduler->post([]() {
+                    auto end = Clock::now() + BACKLOG_TASK_DURATION;
+                    while (Clock::now() < end) {
+                    }
+                }, nullptr, "", {.priority = TaskScheduler::TaskPriority::Low});
+            }
+            std::atomic<bool> done = false;
+            Clock::time_point start_time{};
+            auto post_time = Clock::now();
+            scheduler->post([&]() {
+                start_time = Clock::now();
+                done.store(true, std::memory_order_release);
+            }, nullptr, "", {.priority = TaskScheduler::TaskPriority::High});
+            if (!wait_until([&]() {
+            return done.load(std::memory_order_acquire);
+            })) {
+                break;
+            }
+            samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(start_time - post_time).count());
+            scheduler->wait_all(WAIT_TIMEOUT_MS);
+        }
+        if (samples.size() < iterations) {
+            scheduler->wait_all(WAIT_TIMEOUT_MS);
+            runner.add_failure("task_scheduler.post_high_over_backlog", "Timeout");
+        } else {
+            auto total_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count();
+            runner.add_samples("task_scheduler.post_high_over_backlog", std::move(samples), total_ns);
+        }
+    }
+}
+
+// `post_delayed()` then `cancel()` of a far timer, the cost of arming and disarming a timer of each backend
+static void run_timer_backend_case(Runner &runner, TaskScheduler::TimerBackend backend, const std::string &name)
+{
+    if (!runner.is_selected(name)) {
+        return;
+    }
+
+    TaskScheduler scheduler;
+    if (!scheduler.start({.timer_backend = backend})) {
+        runner.add_failure(name, "Failed to start the task scheduler");
+        return;
+    }
+
+    runner.run(name, SYNC_ITERATIONS, [&](size_t) {
+        TaskScheduler::TaskId id = 0;
+        scheduler.post_delayed([]() {}, 60 * 1000, &id);
+        scheduler.cancel(id);
+    });
+    scheduler.stop();
+}
+
+// Transitions per second, with the actions dispatched inline from the group of the state machine
+static void run_state_machine_case(
+    Runner &runner, std::shared_ptr<TaskScheduler> scheduler, const std::string &name, bool use_id
+)
+{
+    if (!runner.is_selected(name)) {
+        return;
+    }
+
+    StateMachine state_machine(name);
+    state_machine.add_state("idle", std::make_shared<StateBase>());
+    state_machine.add_state("active", std::make_shared<StateBase>());
+    state_machine.add_transition("idle", "toggle", "active");
+    state_machine.add_transition("active", "toggle", "idle");
+    // `start()` compiles the machine, the string case only adds the name lookup
+    if (!state_machine.start(scheduler, "idle")) {
+        runner.add_failure(name, "Failed to start the state machine");
+        return;
+    }
+
+    auto toggle_id = state_machine.get_action_id("toggle");
+    std::atomic<bool> done = false;
+    scheduler->post([&]() {
+        runner.run(name, SYNC_ITERATIONS, [&](size_t) {
+            if (use_id) {
+                state_machine.trigger_action(toggle_id, true);
+            } else {
+                state_machine.trigger_action("toggle", true);
+            }
+        });
+        done.store(true, std::memory_order_release);
+    }, nullptr, name);
+    bool is_done = wait_until([&]() {
+        return done.load(std::memory_order_acquire);
+    }, std::chrono::milliseconds(60 * 1000));
+    if (!is_done) {
+        runner.add_failure(name, "Timeout");
+    }
+
+    state_machine.stop();
+}
+
+static void run_state_machine_cases(Runner &runner, std::shared_ptr<TaskScheduler> scheduler)
+{
+    run_state_machine_case(runner, scheduler, "state_machine.trigger_action", false);
+    run_state_machine_case(runner, scheduler, "state_machine.trigger_action_id", true);
+}
+
+static void run_describe_cases(Runner &runner)
+{
+    BenchPayload payload{
+        .name = "benchmark",
+        .mode = BenchMode::Active,
+        .value = 3.1415926,
+        .count = 42,
+        .enabled = true,
+        .history = {1, 2, 3, 4, 5, 6, 7, 8},
+    };
+
+    runner.run("describe.json_round_trip", SYNC_ITERATIONS, [&](size_t index) {
+        payload.count = static_cast<int>(index);
+        auto str = BROOKESIA_DESCRIBE_JSON_SERIALIZE(payload);
+        BenchPayload result;
+        BROOKESIA_DESCRIBE_JSON_DESERIALIZE(str, result);
+    });
+}
+
+static void run_log_cases(Runner &runner)
+{
+    if (!runner.is_selected("log.info")) {
+        return;
+    }
+
+    // Discard the output, only the formatting and the `printf()` are measured
+    fflush(stdout);
+    int stdout_fd = dup(STDOUT_FILENO);
+    int null_fd = open("/dev/null", O_WRONLY);
+    if ((stdout_fd < 0) || (null_fd < 0)) {
+        runner.add_failure("log.info", "Failed to redirect stdout");
+        return;
+    }
+    dup2(null_fd, STDOUT_FILENO);
+
+    std::vector<int64_t> samples;
+    size_t iterations = runner.get_iterations(SYNC_ITERATIONS);
+    samples.reserve(iterations);
+    auto begin = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        auto start = Clock::now();
+        BROOKESIA_LOGI("Benchmark log: index(%1%), value(%2%), name(%3%)", i, 3.14, "benchmark");
+        samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+    fflush(stdout);
+    auto total_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count();
+
+    dup2(stdout_fd, STDOUT_FILENO);
+    close(stdout_fd);
+    close(null_fd);
+
+    runner.add_samples("log.info", std::move(samples), total_ns);
+}
+
+void run_lib_utils_cases(Runner &runner)
+{
+    auto scheduler = std::make_shared<TaskScheduler>();
+    if (!scheduler->start()) {
+        runner.add_failure("task_scheduler", "Failed to start the task scheduler");
+        return;
+    }
+
+    run_task_scheduler_cases(runner, scheduler);
+    run_state_machine_cases(runner, scheduler);
+    scheduler->stop();
+
+    run_timer_backend_case(runner, TaskScheduler::TimerBackend::Asio, "task_scheduler.post_delayed_cancel");
+    run_timer_backend_case(
+        runner, TaskScheduler::TimerBackend::TimingWheel, "task_scheduler.post_delayed_cancel_timing_wheel"
+    );
+
+    run_describe_cases(runner);
+    run_log_cases(runner);
+}
+
+} // namespace esp_brookesia::benchmark
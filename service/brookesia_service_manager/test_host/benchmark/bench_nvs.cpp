@@ -0,0 +1,105 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include "brookesia/service_nvs/backend.hpp"
+#include "brookesia/service_nvs/cache.hpp"
+#include "benchmark.hpp"
+
+using namespace esp_brookesia::service;
+
+namespace esp_brookesia::benchmark {
+
+constexpr const char *NVS_NAMESPACE = "bench";
+// Keys written in turn, like the settings of a UI page
+constexpr size_t NVS_KEY_COUNT = 8;
+// Writes merged into one flush by the write-back cache, about what a 1 s flush interval merges while dragging a slider
+constexpr size_t NVS_FLUSH_BATCH = 50;
+
+static std::string get_key(size_t index)
+{
+    return "key" + std::to_string(index % NVS_KEY_COUNT);
+}
+
+static void print_statistics(const std::string &name, const NVSCache::Statistics &statistics)
+{
+    printf(
+        "[bench] %-36s %u writes, %u backend writes, %u avoided, %u commits\n", name.c_str(), statistics.write_count,
+        statistics.backend_write_count, statistics.writes_avoided, statistics.commit_count
+    );
+}
+
+void run_nvs_cases(Runner &runner)
+{
+    constexpr const char *CASE_NAMES[] = {
+        "nvs.set_write_through", "nvs.set_write_back", "nvs.get_cached", "nvs.get_backend",
+    };
+    if (std::none_of(std::begin(CASE_NAMES), std::end(CASE_NAMES), [&runner](const char *name) {
+    return runner.is_selected(name);
+    })) {
+        return;
+    }
+
+    char dir_template[] = "/tmp/brookesia_nvs_XXXXXX";
+    if (mkdtemp(dir_template) == nullptr) {
+        runner.add_failure("nvs", "Failed to create the data directory");
+        return;
+    }
+    auto backend = std::make_shared<NVSFileBackend>(dir_template);
+    if (!backend->init()) {
+        runner.add_failure("nvs", "Failed to initialize the file backend");
+        return;
+    }
+
+    // One commit per request, as without the cache
+    {
+        NVSCache cache(backend);
+        runner.run("nvs.set_write_through", SYNC_ITERATIONS, [&](size_t index) {
+            cache.set(NVS_NAMESPACE, {{get_key(index), static_cast<int>(index)}});
+            cache.flush();
+        });
+        if (runner.is_selected("nvs.set_write_through")) {
+            print_statistics("nvs.set_write_through", cache.get_statistics());
+        }
+    }
+
+    // Flushed once every `NVS_FLUSH_BATCH` writes, the flush is included in the timings
+    {
+        NVSCache cache(backend);
+        runner.run("nvs.set_write_back", SYNC_ITERATIONS, [&](size_t index) {
+            cache.set(NVS_NAMESPACE, {{get_key(index), static_cast<int>(index)}});
+            if ((index % NVS_FLUSH_BATCH) == (NVS_FLUSH_BATCH - 1)) {
+                cache.flush();
+            }
+        });
+        cache.flush();
+        if (runner.is_selected("nvs.set_write_back")) {
+            print_statistics("nvs.set_write_back", cache.get_statistics());
+        }
+
+        // All the keys exist even if the case above is filtered out
+        for (size_t i = 0; i < NVS_KEY_COUNT; i++) {
+            cache.set(NVS_NAMESPACE, {{get_key(i), static_cast<int>(i)}});
+        }
+        cache.flush();
+
+        runner.run("nvs.get_cached", SYNC_ITERATIONS, [&](size_t index) {
+            cache.get(NVS_NAMESPACE, {get_key(index)});
+        });
+    }
+
+    // What each read costs without the cache
+    runner.run("nvs.get_backend", SYNC_ITERATIONS, [&](size_t) {
+        backend->load(NVS_NAMESPACE);
+    });
+
+    backend->deinit();
+    std::error_code ec;
+    std::filesystem::remove_all(dir_template, ec);
+}
+
+} // namespace esp_brookesia::benchmark
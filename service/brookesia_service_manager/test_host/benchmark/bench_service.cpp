@@ -0,0 +1,247 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <atomic>
+#include "brookesia/lib_utils.hpp"
+#include "brookesia/service_manager.hpp"
+#include "benchmark.hpp"
+
+using namespace esp_brookesia::lib_utils;
+using namespace esp_brookesia::service;
+
+namespace esp_brookesia::benchmark {
+
+constexpr uint16_t RPC_LISTEN_PORT = 18765;
+constexpr uint32_t RPC_TIMEOUT_MS = 1000;
+
+class BenchService : public ServiceBase {
+public:
+    static constexpr const char *SERVICE_NAME = "bench_service";
+    inline static const FunctionSchema FUNCTION_ADD = {
+        "add",
+        "Add two numbers together",
+        {
+            {"a", "First number", FunctionValueType::Number},
+            {"b", "Second number", FunctionValueType::Number}
+        }
+    };
+    inline static const EventSchema EVENT_TICK = {
+        "tick",
+        "Tick event",
+        {
+            {"value", "Tick value", EventItemType::Number}
+        }
+    };
+
+    BenchService()
+        : ServiceBase({
+        .name = SERVICE_NAME,
+    })
+    {}
+
+    std::vector<FunctionSchema> get_function_definitions() override
+    {
+        return {FUNCTION_ADD};
+    }
+
+    std::vector<EventSchema> get_event_definitions() override
+    {
+        return {EVENT_TICK};
+    }
+
+    bool publish_tick(double value)
+    {
+        return publish_event(EVENT_TICK.name, EventItemMap{{EVENT_TICK.items[0].name, value}});
+    }
+
+protected:
+    ServiceBase::FunctionHandlerMap get_function_handlers() override
+    {
+        return {
+            BROOKESIA_SERVICE_FUNC_HANDLER_2(
+                FUNCTION_ADD.name,
+                FUNCTION_ADD.parameters[0].name, double,
+                FUNCTION_ADD.parameters[1].name, double,
+                function_add(PARAM1, PARAM2)
+            ),
+        };
+    }
+
+private:
+    std::expected<double, std::string> function_add(double a, double b)
+    {
+        return a + b;
+    }
+};
+
+static void run_function_registry_cases(Runner &runner)
+{
+    FunctionRegistry registry;
+    registry.add(FunctionSchema(BenchService::FUNCTION_ADD), [](FunctionParameterMap && args) {
+        return FunctionResult{
+            .success = true,
+            .data = std::get<double>(args.at("a")) + std::get<double>(args.at("b")),
+        };
+    });
+
+    // Including the validation of the parameters
+    runner.run("function_registry.call", SYNC_ITERATIONS, [&](size_t index) {
+        registry.call(BenchService::FUNCTION_ADD.name, FunctionParameterMap{
+            {"a", static_cast<double>(index)},
+            {"b", 1.0},
+        });
+    });
+
+    FunctionRegistry typed_registry;
+    typed_registry.add(FunctionSchema(BenchService::FUNCTION_ADD), [](FunctionParameterMap &&) {
+        return FunctionResult{};
+    }, make_typed_function_handler<double, double>([](double & a, double & b) {
+        return std::expected<double, std::string>(a + b);
+    }));
+
+    // Same function through its typed handler: no map, no validation and no `FunctionValue`
+    runner.run("function_registry.call_typed", SYNC_ITERATIONS, [&](size_t index) {
+        double a = static_cast<double>(index);
+        double b = 1.0;
+        typed_registry.call_typed<double, double, double>(BenchService::FUNCTION_ADD.name, a, b);
+    });
+}
+
+static void run_local_call_cases(Runner &runner, std::shared_ptr<BenchService> service)
+{
+    // Round trip through the task scheduler of the service, with the generic handler
+    runner.run("service.call", ASYNC_ITERATIONS, [&](size_t index) {
+        service->call_function_sync(BenchService::FUNCTION_ADD.name, FunctionParameterMap{
+            {"a", static_cast<double>(index)},
+            {"b", 1.0},
+        }, RPC_TIMEOUT_MS);
+    });
+
+    // Same round trip with the native values, as done by a `FunctionStub`
+    runner.run("service.call_typed", ASYNC_ITERATIONS, [&](size_t index) {
+        service->call_function_typed_async<double>(
+            BenchService::FUNCTION_ADD.name, static_cast<double>(index), 1.0
+        ).wait_for(std::chrono::milliseconds(RPC_TIMEOUT_MS));
+    });
+}
+
+static void run_event_registry_cases(Runner &runner)
+{
+    EventRegistry registry;
+    registry.add(EventSchema(BenchService::EVENT_TICK));
+    auto signal = registry.get_signal(BenchService::EVENT_TICK.name);
+    if (signal == nullptr) {
+        runner.add_failure("event_registry.publish", "Signal not found");
+        return;
+    }
+
+    size_t received_count = 0;
+    EventRegistry::SignalConnection connection = signal->connect(
+    [&received_count](const std::string &, const EventItemMap &) {
+        received_count++;
+    });
+
+    // Same steps as `ServiceBase::publish_event()` without the task scheduler: validation, then the local signal
+    runner.run("event_registry.publish", SYNC_ITERATIONS, [&](size_t index) {
+        EventItemMap items{{"value", static_cast<double>(index)}};
+        if (registry.validate_items(BenchService::EVENT_TICK.name, items)) {
+            (*registry.get_signal(BenchService::EVENT_TICK.name))(BenchService::EVENT_TICK.name, items);
+        }
+    });
+}
+
+static void run_rpc_cases(Runner &runner, std::shared_ptr<BenchService> service)
+{
+    auto &service_manager = ServiceManager::get_instance();
+
+    rpc::Server::Config server_config;
+    server_config.listen_port = RPC_LISTEN_PORT;
+    if (!service_manager.start_rpc_server(server_config, RPC_TIMEOUT_MS) ||
+            !service_manager.connect_rpc_server_to_services({BenchService::SERVICE_NAME})) {
+        runner.add_failure("rpc", "Failed to start the RPC server");
+        return;
+    }
+
+    auto client = service_manager.new_rpc_client();
+    if (!client || !client->connect("127.0.0.1", RPC_LISTEN_PORT, RPC_TIMEOUT_MS)) {
+        runner.add_failure("rpc", "Failed to connect to the RPC server");
+        service_manager.stop_rpc_server();
+        return;
+    }
+
+    // Request and response over the loopback
+    runner.run("rpc.call", ASYNC_ITERATIONS, [&](size_t index) {
+        client->call_function_sync(
+            BenchService::SERVICE_NAME, BenchService::FUNCTION_ADD.name,
+            boost::json::object{{"a", static_cast<double>(index)}, {"b", 1.0}}, RPC_TIMEOUT_MS
+        );
+    });
+
+    // From `publish_event()` in the service to the callback of the client
+    if (runner.is_selected("rpc.notify")) {
+        std::atomic<size_t> received_count = 0;
+        auto subscription_id = client->subscribe_event(
+                                   BenchService::SERVICE_NAME, BenchService::EVENT_TICK.name,
+        [&received_count](const EventItemMap &) {
+            received_count.fetch_add(1, std::memory_order_release);
+        }, RPC_TIMEOUT_MS);
+        if (subscription_id.empty()) {
+            runner.add_failure("rpc.notify", "Failed to subscribe to the event");
+        } else {
+            size_t published_count = 0;
+            runner.run("rpc.notify", ASYNC_ITERATIONS, [&](size_t index) {
+                published_count++;
+                service->publish_tick(static_cast<double>(index));
+                wait_until([&]() {
+                    return received_count.load(std::memory_order_acquire) >= published_count;
+                });
+            });
+            client->unsubscribe_events(BenchService::SERVICE_NAME, {subscription_id}, RPC_TIMEOUT_MS);
+        }
+    }
+
+    client->disconnect();
+    service_manager.disconnect_rpc_server_from_services({BenchService::SERVICE_NAME});
+    service_manager.stop_rpc_server();
+}
+
+void run_service_cases(Runner &runner)
+{
+    run_function_registry_cases(runner);
+    run_event_registry_cases(runner);
+
+    if (!runner.is_selected("service.call") && !runner.is_selected("service.call_typed") &&
+            !runner.is_selected("rpc.call") && !runner.is_selected("rpc.notify")) {
+        return;
+    }
+
+    ServiceRegistry::register_plugin<BenchService>(BenchService::SERVICE_NAME, []() {
+        return std::make_shared<BenchService>();
+    });
+
+    auto &service_manager = ServiceManager::get_instance();
+    if (!service_manager.init() || !service_manager.start()) {
+        runner.add_failure("rpc", "Failed to start the service manager");
+        return;
+    }
+
+    {
+        auto binding = service_manager.bind(BenchService::SERVICE_NAME);
+        auto service = std::dynamic_pointer_cast<BenchService>(binding.get_service());
+        if (service) {
+            run_local_call_cases(runner, service);
+            if (runner.is_selected("rpc.call") || runner.is_selected("rpc.notify")) {
+                run_rpc_cases(runner, service);
+            }
+        } else {
+            runner.add_failure("rpc", "Failed to bind the service");
+        }
+    }
+
+    service_manager.stop();
+    service_manager.deinit();
+}
+
+} // namespace esp_brookesia::benchmark
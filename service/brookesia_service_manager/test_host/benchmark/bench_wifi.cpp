@@ -0,0 +1,325 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include "brookesia/lib_utils.hpp"
+#include "brookesia/service_wifi/macro_configs.h"
+#include "brookesia/service_wifi/hal.hpp"
+#include "brookesia/service_wifi/scan_ap_table.hpp"
+#include "benchmark.hpp"
+
+using namespace esp_brookesia::lib_utils;
+using namespace esp_brookesia::service::wifi;
+
+namespace esp_brookesia::benchmark {
+
+// The simulated time runs 1000 times faster, so the latencies of the script (in simulated ms) become microseconds
+constexpr uint32_t WIFI_TIME_SCALE = 1000;
+// Same as the default `ap_count` of the scan parameters
+constexpr size_t WIFI_AP_COUNT = 20;
+// Real time between two drops of a storm, longer than a reconnection
+constexpr uint32_t WIFI_DROP_INTERVAL_MS = 20;
+// Real interval of the scans running during the churn
+constexpr uint32_t WIFI_SCAN_INTERVAL_MS = 5;
+constexpr uint32_t WIFI_WAIT_TIMEOUT_MS = 2000;
+constexpr const char *WIFI_SSID = "bench_ap";
+constexpr const char *WIFI_PASSWORD = "password";
+
+/**
+ * @brief HAL on a simulated driver, with its own task scheduler configured like the one of the WiFi service
+ */
+struct HalContext {
+    ~HalContext()
+    {
+        if (hal) {
+            hal->stop();
+            hal->deinit();
+        }
+        if (scheduler) {
+            scheduler->stop();
+        }
+    }
+
+    bool start(SimulatedDriver::Script script)
+    {
+        scheduler = std::make_shared<TaskScheduler>();
+        TaskScheduler::StartConfig config{
+            .worker_configs = {
+                {.name = BROOKESIA_SERVICE_WIFI_TASK_SCHEDULER_WORKER1_NAME},
+                {.name = BROOKESIA_SERVICE_WIFI_TASK_SCHEDULER_WORKER2_NAME},
+            },
+            .worker_poll_interval_ms = BROOKESIA_SERVICE_WIFI_TASK_SCHEDULER_WORKER_POLL_INTERVAL_MS,
+        };
+        if (!scheduler->start(config)) {
+            return false;
+        }
+
+        driver = std::make_shared<SimulatedDriver>(std::move(script));
+        hal = std::make_shared<Hal>(scheduler, driver);
+
+        return hal->init() && hal->start() && hal->do_general_action(GeneralAction::Init) &&
+               hal->do_general_action(GeneralAction::Start);
+    }
+
+    std::shared_ptr<TaskScheduler> scheduler;
+    std::shared_ptr<SimulatedDriver> driver;
+    std::shared_ptr<Hal> hal;
+};
+
+static SimulatedDriver::Script get_script(uint32_t run_ms)
+{
+    SimulatedDriver::Script script;
+    script.time_scale = WIFI_TIME_SCALE;
+    script.aps.push_back({
+        .ssid = WIFI_SSID,
+        .password = WIFI_PASSWORD,
+        .rssi = -45,
+        .rssi_drift = 6,
+    });
+    // Neighbours fading in and out over the run, so that consecutive scans differ
+    uint32_t run_simulated_ms = run_ms * WIFI_TIME_SCALE;
+    for (size_t i = 1; i < WIFI_AP_COUNT; i++) {
+        uint32_t window_ms = run_simulated_ms / 4;
+        uint32_t appear_ms = (i % 2 == 0) ? 0 : static_cast<uint32_t>(i * run_simulated_ms / WIFI_AP_COUNT);
+        script.aps.push_back({
+            .ssid = "neighbour_" + std::to_string(i),
+            .password = (i % 3 == 0) ? "" : "secret",
+            .rssi = -50 - static_cast<int>(i * 2),
+            .rssi_drift = 10,
+            .appear_ms = appear_ms,
+            .disappear_ms = (i % 2 == 0) ? UINT32_MAX : appear_ms + window_ms,
+        });
+    }
+
+    return script;
+}
+
+// Time from the request of a scan to the `scan_ap_infos` callback, with a scan of no duration: only the stack
+static void run_scan_case(Runner &runner)
+{
+    constexpr const char *CASE_NAME = "wifi.scan_to_event";
+    if (!runner.is_selected(CASE_NAME)) {
+        return;
+    }
+
+    std::atomic<size_t> update_count = 0;
+    size_t timeout_count = 0;
+
+    auto script = get_script(runner.get_iterations(ASYNC_ITERATIONS) * 10);
+    script.scan_duration_ms = 0;
+    HalContext context;
+    if (!context.start(std::move(script))) {
+        runner.add_failure(CASE_NAME, "Failed to start the HAL");
+        return;
+    }
+    context.hal->register_scan_ap_infos_updated_callback([&update_count](const std::vector<ApInfo> &) {
+        update_count.fetch_add(1, std::memory_order_release);
+    });
+
+    runner.run(CASE_NAME, ASYNC_ITERATIONS, [&](size_t) {
+        auto target_count = update_count.load(std::memory_order_acquire) + 1;
+        context.hal->start_ap_scan();
+        bool is_done = wait_until([&]() {
+            return update_count.load(std::memory_order_acquire) >= target_count;
+        }, std::chrono::milliseconds(WIFI_WAIT_TIMEOUT_MS));
+        if (!is_done) {
+            timeout_count++;
+        }
+    });
+    context.hal->stop_ap_scan();
+    context.hal->register_scan_ap_infos_updated_callback(nullptr);
+
+    if (timeout_count > 0) {
+        runner.add_failure(CASE_NAME, std::to_string(timeout_count) + " scans timed out");
+    }
+}
+
+/**
+ * Time from the `Disconnected` event of a dropped link to the `Connected` event of the reconnection, the HAL
+ * reconnecting at once like the WiFi service does. With `is_churn`, the scans run all along while the neighbours
+ * come and go, and the event volume is printed at the end.
+ *
+ * @note No attempt fails: the HAL waits for `Connected` until its timeout after a failed attempt, which would make
+ *       the run last minutes
+ */
+static void run_reconnect_case(Runner &runner, const std::string &name, bool is_churn)
+{
+    if (!runner.is_selected(name)) {
+        return;
+    }
+
+    size_t iterations = runner.get_iterations(ASYNC_ITERATIONS);
+    uint32_t run_ms = (iterations + 2) * WIFI_DROP_INTERVAL_MS;
+
+    std::mutex samples_mutex;
+    std::vector<int64_t> samples;
+    samples.reserve(iterations);
+    Clock::time_point drop_time{};
+    std::atomic<size_t> general_event_count = 0;
+    std::atomic<size_t> scan_update_count = 0;
+    std::atomic<size_t> scan_delta_count = 0;
+    ScanApTable scan_ap_table;
+
+    auto script = get_script(run_ms);
+    script.connect_latency_ms = 0;
+    script.disconnect_storms.push_back({
+        .start_ms = WIFI_DROP_INTERVAL_MS * WIFI_TIME_SCALE,
+        .count = static_cast<uint32_t>(iterations * 2),
+        .interval_ms = WIFI_DROP_INTERVAL_MS * WIFI_TIME_SCALE,
+    });
+    HalContext context;
+    if (!context.start(std::move(script))) {
+        runner.add_failure(name, "Failed to start the HAL");
+        return;
+    }
+    auto hal = context.hal;
+
+    hal->register_general_event_callback(
+    [&, hal](GeneralEvent event, const GeneralStateFlags &, const GeneralStateFlags & new_flags) {
+        general_event_count.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(samples_mutex);
+        if (event == GeneralEvent::Disconnected) {
+            // Only the drops, not the disconnections requested by the HAL
+            if (new_flags.test(BROOKESIA_DESCRIBE_ENUM_TO_NUM(GeneralStateFlagBit::Disconnecting)) ||
+                    new_flags.test(BROOKESIA_DESCRIBE_ENUM_TO_NUM(GeneralStateFlagBit::Stopping))) {
+                return;
+            }
+            drop_time = Clock::now();
+            context.scheduler->post([hal]() {
+                hal->do_general_action(GeneralAction::Connect);
+            });
+        } else if ((event == GeneralEvent::Connected) && (drop_time != Clock::time_point{})) {
+            if (samples.size() < iterations) {
+                samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - drop_time).count());
+            }
+            drop_time = {};
+        }
+    });
+    hal->register_scan_ap_infos_updated_callback([&](const std::vector<ApInfo> &ap_infos) {
+        scan_update_count.fetch_add(1, std::memory_order_relaxed);
+        ScanApTable::Delta delta;
+        if (scan_ap_table.update(ap_infos, delta)) {
+            scan_delta_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    auto begin = Clock::now();
+    auto driver_statistics_begin = context.driver->get_statistics();
+    bool is_started = hal->set_target_connect_ap_info(ConnectApInfo(WIFI_SSID, WIFI_PASSWORD)) &&
+                      hal->do_general_action(GeneralAction::Connect);
+    if (is_started && is_churn) {
+        is_started = hal->set_scan_params({
+            .ap_count = WIFI_AP_COUNT,
+            .interval_ms = WIFI_SCAN_INTERVAL_MS,
+            .timeout_ms = run_ms * 4,
+        }) && hal->start_ap_scan();
+    }
+    bool is_done = is_started && wait_until([&]() {
+        std::lock_guard<std::mutex> lock(samples_mutex);
+        return samples.size() >= iterations;
+    }, std::chrono::milliseconds(run_ms * 2 + WIFI_WAIT_TIMEOUT_MS));
+    auto total_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count();
+
+    // The callbacks use the locals, stop them first
+    hal->stop_ap_scan();
+    hal->register_general_event_callback(nullptr);
+    hal->register_scan_ap_infos_updated_callback(nullptr);
+    context.scheduler->wait_all(WIFI_WAIT_TIMEOUT_MS);
+    auto driver_statistics = context.driver->get_statistics();
+
+    if (!is_done) {
+        runner.add_failure(name, is_started ? "Timeout" : "Failed to connect");
+        return;
+    }
+    runner.add_samples(name, std::move(samples), total_ns);
+
+    uint32_t driver_event_count = 0;
+    for (size_t i = 0; i < driver_statistics.event_counts.size(); i++) {
+        driver_event_count += driver_statistics.event_counts[i] - driver_statistics_begin.event_counts[i];
+    }
+    printf(
+        "[bench] %-36s %u driver events, %zu general events, %zu scans (%zu deltas), %u drops, %u attempts "
+        "(%u failed) in %.1f simulated s\n", name.c_str(), driver_event_count, general_event_count.load(),
+        scan_update_count.load(), scan_delta_count.load(),
+        driver_statistics.link_drop_count, driver_statistics.connect_count, driver_statistics.connect_failure_count,
+        static_cast<double>(total_ns) * WIFI_TIME_SCALE / 1e9
+    );
+}
+
+/**
+ * Cost of publishing the results of a scan: the whole list as JSON, or only the changes from the AP table. The scans
+ * are generated beforehand, with the RSSI jitter of a static device and a few APs coming and going.
+ */
+static void run_scan_publish_cases(Runner &runner)
+{
+    constexpr const char *FULL_CASE_NAME = "wifi.scan_publish_full";
+    constexpr const char *DELTA_CASE_NAME = "wifi.scan_publish_delta";
+    constexpr size_t SCAN_COUNT = 64;
+    constexpr int RSSI_JITTER = 3;
+    if (!runner.is_selected(FULL_CASE_NAME) && !runner.is_selected(DELTA_CASE_NAME)) {
+        return;
+    }
+
+    std::mt19937 random_engine(1);
+    std::uniform_int_distribution<int> jitter(-RSSI_JITTER, RSSI_JITTER);
+    std::vector<std::vector<ApInfo>> scans(SCAN_COUNT);
+    for (size_t i = 0; i < SCAN_COUNT; i++) {
+        for (size_t j = 0; j < WIFI_AP_COUNT; j++) {
+            // The last APs are only visible in half of the scans
+            if ((j >= WIFI_AP_COUNT - 2) && (((i / 8) + j) % 2 == 0)) {
+                continue;
+            }
+            int rssi = -40 - static_cast<int>(j * 3) + jitter(random_engine);
+            const uint8_t bssid[6] = {0x02, 0, 0, 0, 0, static_cast<uint8_t>(j)};
+            scans[i].emplace_back("ap_" + std::to_string(j), (j % 3) != 0, rssi, Driver::format_bssid(bssid));
+        }
+        std::sort(scans[i].begin(), scans[i].end(), [](const ApInfo & a, const ApInfo & b) {
+            return a.rssi > b.rssi;
+        });
+    }
+
+    size_t full_bytes = 0;
+    size_t full_scan_count = 0;
+    runner.run(FULL_CASE_NAME, SYNC_ITERATIONS, [&](size_t index) {
+        full_scan_count++;
+        full_bytes += boost::json::serialize(BROOKESIA_DESCRIBE_TO_JSON(scans[index % SCAN_COUNT])).size();
+    });
+
+    size_t delta_bytes = 0;
+    size_t delta_count = 0;
+    size_t delta_scan_count = 0;
+    ScanApTable scan_ap_table;
+    runner.run(DELTA_CASE_NAME, SYNC_ITERATIONS, [&](size_t index) {
+        delta_scan_count++;
+        ScanApTable::Delta delta;
+        if (!scan_ap_table.update(scans[index % SCAN_COUNT], delta)) {
+            return;
+        }
+        delta_count++;
+        delta_bytes += boost::json::serialize(BROOKESIA_DESCRIBE_TO_JSON(delta.added)).size() +
+                       boost::json::serialize(BROOKESIA_DESCRIBE_TO_JSON(delta.changed)).size() +
+                       boost::json::serialize(BROOKESIA_DESCRIBE_TO_JSON(delta.removed)).size();
+    });
+
+    if ((full_scan_count > 0) && (delta_scan_count > 0)) {
+        printf(
+            "[bench] %-36s %zu bytes per scan in full, %zu in deltas (%zu deltas for %zu scans)\n", "wifi.scan_publish",
+            full_bytes / full_scan_count, delta_bytes / delta_scan_count, delta_count, delta_scan_count
+        );
+    }
+}
+
+void run_wifi_cases(Runner &runner)
+{
+    run_scan_case(runner);
+    run_scan_publish_cases(runner);
+    run_reconnect_case(runner, "wifi.reconnect", false);
+    run_reconnect_case(runner, "wifi.reconnect_churn", true);
+}
+
+} // namespace esp_brookesia::benchmark
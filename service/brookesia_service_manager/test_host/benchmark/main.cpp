@@ -0,0 +1,23 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include "benchmark.hpp"
+
+namespace esp_brookesia::benchmark {
+
+void run_lib_utils_cases(Runner &runner);
+void run_service_cases(Runner &runner);
+void run_nvs_cases(Runner &runner);
+void run_wifi_cases(Runner &runner);
+
+void run_cases(Runner &runner)
+{
+    run_lib_utils_cases(runner);
+    run_service_cases(runner);
+    run_nvs_cases(runner);
+    run_wifi_cases(runner);
+}
+
+} // namespace esp_brookesia::benchmark
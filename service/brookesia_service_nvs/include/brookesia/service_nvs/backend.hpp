@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <expected>
+#include <map>
+#include <optional>
+#include <string>
+#include "brookesia/service_helper/nvs.hpp"
+
+namespace esp_brookesia::service {
+
+/**
+ * @brief Storage backend of the NVS service
+ *
+ * The service keeps the key-value pairs in RAM (see `NVSCache`) and only calls the backend to load a namespace
+ * the first time it is accessed, and to commit the pending changes of a namespace in one batch.
+ */
+class NVSBackend {
+public:
+    using Value = helper::NVS::Value;
+    using Entries = std::map<std::string, Value>;                // key -> value
+    using Changes = std::map<std::string, std::optional<Value>>; // key -> value to write, or `std::nullopt` to erase
+
+    virtual ~NVSBackend() = default;
+
+    /**
+     * @brief Initialize the storage
+     *
+     * @return true on success, false on failure
+     */
+    virtual bool init() = 0;
+
+    /**
+     * @brief Deinitialize the storage
+     */
+    virtual void deinit() = 0;
+
+    /**
+     * @brief Load all the key-value pairs of a namespace
+     *
+     * @param[in] nspace Namespace, a namespace which does not exist yet is loaded as empty
+     * @return The key-value pairs on success, the error message on failure
+     */
+    virtual std::expected<Entries, std::string> load(const std::string &nspace) = 0;
+
+    /**
+     * @brief Apply the changes of a namespace and commit them at once
+     *
+     * @param[in] nspace Namespace
+     * @param[in] erase_all Erase all the key-value pairs of the namespace before applying the changes
+     * @param[in] changes Changes to apply
+     * @return Nothing on success, the error message on failure
+     */
+    virtual std::expected<void, std::string> commit(
+        const std::string &nspace, bool erase_all, const Changes &changes
+    ) = 0;
+};
+
+#if defined(ESP_PLATFORM)
+/**
+ * @brief Backend on the NVS partition of the flash
+ */
+class NVSFlashBackend : public NVSBackend {
+public:
+    bool init() override;
+    void deinit() override;
+    std::expected<Entries, std::string> load(const std::string &nspace) override;
+    std::expected<void, std::string> commit(const std::string &nspace, bool erase_all, const Changes &changes) override;
+};
+#endif // ESP_PLATFORM
+
+/**
+ * @brief Backend storing each namespace as a JSON file, used as a stand-in of the flash off-device
+ *
+ * Each commit rewrites `<root_dir>/<nspace>.json` through a temporary file, so a namespace is never left half
+ * written.
+ */
+class NVSFileBackend : public NVSBackend {
+public:
+    explicit NVSFileBackend(std::string root_dir)
+        : root_dir_(std::move(root_dir))
+    {}
+
+    bool init() override;
+    void deinit() override;
+    std::expected<Entries, std::string> load(const std::string &nspace) override;
+    std::expected<void, std::string> commit(const std::string &nspace, bool erase_all, const Changes &changes) override;
+
+    const std::string &get_root_dir() const
+    {
+        return root_dir_;
+    }
+
+private:
+    std::string get_file_path(const std::string &nspace) const
+    {
+        return root_dir_ + "/" + nspace + ".json";
+    }
+
+    std::string root_dir_;
+};
+
+} // namespace esp_brookesia::service
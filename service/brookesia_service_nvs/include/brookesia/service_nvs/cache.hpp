@@ -0,0 +1,135 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+#include <expected>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "boost/thread/lock_guard.hpp"
+#include "boost/thread/mutex.hpp"
+#include "brookesia/service_nvs/backend.hpp"
+
+namespace esp_brookesia::service {
+
+/**
+ * @brief Write-back cache of the NVS service
+ *
+ * A namespace is loaded from the backend the first time it is accessed, then all the reads are served from RAM.
+ * Writes update RAM immediately (so reads always see them) and are recorded as pending changes, which are merged
+ * until `flush()` commits them to the backend in one batch per namespace.
+ *
+ * @note All the methods are thread-safe
+ */
+class NVSCache {
+public:
+    using Value = NVSBackend::Value;
+    using Entries = NVSBackend::Entries;
+
+    // Same limits as the NVS partition, checked here so that the errors are reported by the request, not by the flush
+    static constexpr size_t MAX_NAMESPACE_LENGTH = 15;
+    static constexpr size_t MAX_KEY_LENGTH = 15;
+
+    struct Statistics {
+        uint32_t read_count = 0;            // Keys read by the requests
+        uint32_t load_count = 0;            // Namespaces loaded from the backend
+        uint32_t write_count = 0;           // Keys set or erased by the requests
+        uint32_t backend_write_count = 0;   // Keys written or erased in the backend
+        uint32_t writes_avoided = 0;        // Writes which never reached the backend (unchanged or overwritten)
+        uint32_t commit_count = 0;          // Commits of the backend
+        uint32_t flush_count = 0;           // Calls of `flush()`, including the ones with nothing to commit
+    };
+
+    explicit NVSCache(std::shared_ptr<NVSBackend> backend)
+        : backend_(std::move(backend))
+    {}
+
+    /**
+     * @brief Get all the key-value pairs of a namespace
+     *
+     * @param[in] nspace Namespace
+     * @return The key-value pairs on success, the error message on failure
+     */
+    std::expected<Entries, std::string> get_all(const std::string &nspace);
+
+    /**
+     * @brief Get the values of some keys, the keys which do not exist are skipped
+     *
+     * @param[in] nspace Namespace
+     * @param[in] keys Keys
+     * @return The key-value pairs found on success, the error message on failure
+     */
+    std::expected<Entries, std::string> get(const std::string &nspace, const std::vector<std::string> &keys);
+
+    /**
+     * @brief Set key-value pairs, visible to the reads immediately and written to the backend by `flush()`
+     *
+     * @param[in] nspace Namespace
+     * @param[in] pairs Key-value pairs
+     * @return Nothing on success, the error message on failure (nothing is set in that case)
+     */
+    std::expected<void, std::string> set(const std::string &nspace, std::vector<helper::NVS::KeyValuePair> &&pairs);
+
+    /**
+     * @brief Erase keys, visible to the reads immediately and written to the backend by `flush()`
+     *
+     * @param[in] nspace Namespace
+     * @param[in] keys Keys, all the keys of the namespace if empty
+     * @return Number of keys erased on success, the error message on failure
+     */
+    std::expected<size_t, std::string> erase(const std::string &nspace, const std::vector<std::string> &keys);
+
+    /**
+     * @brief Commit the pending changes of all the namespaces to the backend
+     *
+     * @note The changes of a namespace whose commit fails are kept and retried by the next flush
+     *
+     * @return Nothing on success, the error message of the first failure otherwise
+     */
+    std::expected<void, std::string> flush();
+
+    /**
+     * @brief Check if there are pending changes
+     */
+    bool is_dirty() const;
+
+    Statistics get_statistics() const
+    {
+        boost::lock_guard lock(mutex_);
+        return statistics_;
+    }
+
+    void reset_statistics()
+    {
+        boost::lock_guard lock(mutex_);
+        statistics_ = {};
+    }
+
+private:
+    struct Namespace {
+        Entries values;                 // Current values, including the pending changes
+        NVSBackend::Changes changes;    // Pending changes
+        bool erase_all = false;         // Erase the namespace in the backend before applying `changes`
+
+        bool is_dirty() const
+        {
+            return erase_all || !changes.empty();
+        }
+    };
+
+    // Must be called with the lock held
+    std::expected<Namespace *, std::string> get_namespace(const std::string &nspace);
+
+    std::shared_ptr<NVSBackend> backend_;
+
+    mutable boost::mutex mutex_;
+    std::map<std::string, Namespace> namespaces_;   // Loaded namespaces
+    Statistics statistics_;
+};
+
+} // namespace esp_brookesia::service
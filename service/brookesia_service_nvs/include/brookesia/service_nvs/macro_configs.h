@@ -67,3 +67,18 @@
 #      endif
 #   endif
 #endif // BROOKESIA_SERVICE_NVS_ENABLE_TASK_SCHEDULER
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////// Write-Back Cache ///////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+#if !defined(BROOKESIA_SERVICE_NVS_FLUSH_INTERVAL_MS)
+#   if defined(CONFIG_BROOKESIA_SERVICE_NVS_FLUSH_INTERVAL_MS)
+#       define BROOKESIA_SERVICE_NVS_FLUSH_INTERVAL_MS  CONFIG_BROOKESIA_SERVICE_NVS_FLUSH_INTERVAL_MS
+#   else
+#       define BROOKESIA_SERVICE_NVS_FLUSH_INTERVAL_MS  (1000)
+#   endif
+#endif
+/* Directory of the file backend, used when not running on ESP */
+#if !defined(BROOKESIA_SERVICE_NVS_FILE_BACKEND_DIR)
+#   define BROOKESIA_SERVICE_NVS_FILE_BACKEND_DIR  "nvs_data"
+#endif
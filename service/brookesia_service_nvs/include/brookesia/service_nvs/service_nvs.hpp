@@ -5,10 +5,16 @@
  */
 #pragma once
 
+#include <atomic>
 #include <expected>
+#include <memory>
 #include <string>
+#include "boost/thread/lock_guard.hpp"
+#include "boost/thread/mutex.hpp"
 #include "brookesia/service_manager/service/base.hpp"
 #include "brookesia/service_helper/nvs.hpp"
+#include "brookesia/service_nvs/backend.hpp"
+#include "brookesia/service_nvs/cache.hpp"
 
 namespace esp_brookesia::service {
 
@@ -22,8 +28,49 @@ public:
         return instance;
     }
 
+    /**
+     * @brief Replace the storage backend, must be called before the service is initialized
+     *
+     * @note By default, the NVS partition is used on ESP, and `NVSFileBackend` in
+     *       `BROOKESIA_SERVICE_NVS_FILE_BACKEND_DIR` otherwise
+     *
+     * @param[in] backend Backend
+     * @return true on success, false if already initialized
+     */
+    bool set_backend(std::shared_ptr<NVSBackend> backend);
+
+    /**
+     * @brief Commit the pending changes to the backend immediately
+     *
+     * @note Same as the `flush` function, but can be called from any thread (e.g. a power-loss handler)
+     *
+     * @return true on success or if there is nothing to commit, false on failure
+     */
+    bool flush();
+
+    /**
+     * @brief Get the statistics of the write-back cache
+     *
+     * @return The statistics, all zero if not initialized
+     */
+    NVSCache::Statistics get_cache_statistics() const
+    {
+        auto cache = get_cache();
+        return cache ? cache->get_statistics() : NVSCache::Statistics{};
+    }
+
+    /**
+     * @brief Reset the statistics of the write-back cache
+     */
+    void reset_cache_statistics()
+    {
+        if (auto cache = get_cache(); cache) {
+            cache->reset_statistics();
+        }
+    }
+
 private:
-    inline static const FunctionSchema *FUNCTION_DEFINITIONS = Helper::get_function_definitions();
+    static constexpr std::span<const FunctionSchemaView> FUNCTION_DEFINITIONS = Helper::get_function_schema_views();
 
     NVS()
         : ServiceBase({
@@ -48,19 +95,31 @@ private:
 
     bool on_init() override;
     void on_deinit() override;
+    void on_stop() override;
 
-    std::expected<boost::json::array, std::string> function_list(const std::string &nspace);
-    std::expected<void, std::string> function_set(const std::string &nspace, boost::json::array &&key_value_pairs);
-    std::expected<boost::json::object, std::string> function_get(
-        const std::string &nspace, boost::json::array &&keys
+    // Native parameter and result types, so that the typed stubs of `Helper` reach the cache without any JSON
+    std::expected<std::vector<Helper::EntryInfo>, std::string> function_list(const std::string &nspace);
+    std::expected<void, std::string> function_set(
+        const std::string &nspace, std::vector<Helper::KeyValuePair> &&key_value_pairs
+    );
+    std::expected<Helper::Entries, std::string> function_get(
+        const std::string &nspace, const std::vector<std::string> &keys
     );
-    std::expected<void, std::string> function_erase(const std::string &nspace, boost::json::array &&keys);
+    std::expected<void, std::string> function_erase(const std::string &nspace, const std::vector<std::string> &keys);
+    std::expected<void, std::string> function_flush();
+
+    std::shared_ptr<NVSCache> get_cache() const
+    {
+        boost::lock_guard lock(cache_mutex_);
+        return cache_;
+    }
+
+    // Commit now if the flush interval is 0 or there is no task scheduler, otherwise post a delayed flush
+    std::expected<void, std::string> schedule_flush();
 
-    std::vector<FunctionSchema> get_function_definitions() override
+    std::span<const FunctionSchemaView> get_function_schema_views() override
     {
-        return std::vector<FunctionSchema>(
-                   FUNCTION_DEFINITIONS, FUNCTION_DEFINITIONS + Helper::FunctionIndexMax
-               );
+        return FUNCTION_DEFINITIONS;
     }
     ServiceBase::FunctionHandlerMap get_function_handlers() override
     {
@@ -73,23 +132,33 @@ private:
             BROOKESIA_SERVICE_FUNC_HANDLER_2(
                 FUNCTION_DEFINITIONS[Helper::FunctionIndexSet].name,
                 FUNCTION_DEFINITIONS[Helper::FunctionIndexSet].parameters[0].name, std::string,
-                FUNCTION_DEFINITIONS[Helper::FunctionIndexSet].parameters[1].name, boost::json::array,
+                FUNCTION_DEFINITIONS[Helper::FunctionIndexSet].parameters[1].name,
+                std::vector<Helper::KeyValuePair>,
                 function_set(PARAM1, std::move(PARAM2))
             ),
             BROOKESIA_SERVICE_FUNC_HANDLER_2(
                 FUNCTION_DEFINITIONS[Helper::FunctionIndexGet].name,
                 FUNCTION_DEFINITIONS[Helper::FunctionIndexGet].parameters[0].name, std::string,
-                FUNCTION_DEFINITIONS[Helper::FunctionIndexGet].parameters[1].name, boost::json::array,
-                function_get(PARAM1, std::move(PARAM2))
+                FUNCTION_DEFINITIONS[Helper::FunctionIndexGet].parameters[1].name, std::vector<std::string>,
+                function_get(PARAM1, PARAM2)
             ),
             BROOKESIA_SERVICE_FUNC_HANDLER_2(
                 FUNCTION_DEFINITIONS[Helper::FunctionIndexErase].name,
                 FUNCTION_DEFINITIONS[Helper::FunctionIndexErase].parameters[0].name, std::string,
-                FUNCTION_DEFINITIONS[Helper::FunctionIndexErase].parameters[1].name, boost::json::array,
-                function_erase(PARAM1, std::move(PARAM2))
+                FUNCTION_DEFINITIONS[Helper::FunctionIndexErase].parameters[1].name, std::vector<std::string>,
+                function_erase(PARAM1, PARAM2)
+            ),
+            BROOKESIA_SERVICE_FUNC_HANDLER_0(
+                FUNCTION_DEFINITIONS[Helper::FunctionIndexFlush].name,
+                function_flush()
             )
         };
     }
+
+    std::shared_ptr<NVSBackend> backend_;
+    mutable boost::mutex cache_mutex_;
+    std::shared_ptr<NVSCache> cache_;
+    std::atomic<bool> is_flush_scheduled_ = false;
 };
 
 } // namespace esp_brookesia::service
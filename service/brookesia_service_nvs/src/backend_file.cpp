@@ -0,0 +1,141 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include "boost/format.hpp"
+#include "boost/json.hpp"
+#include "brookesia/service_nvs/macro_configs.h"
+#if !BROOKESIA_SERVICE_NVS_ENABLE_DEBUG_LOG
+#   define BROOKESIA_LOG_DISABLE_DEBUG_TRACE 1
+#endif
+#include "private/utils.hpp"
+#include "brookesia/service_nvs/backend.hpp"
+
+namespace esp_brookesia::service {
+
+bool NVSFileBackend::init()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_LOGD("Params: root_dir(%1%)", root_dir_);
+
+    struct stat st;
+    if (stat(root_dir_.c_str(), &st) == 0) {
+        BROOKESIA_CHECK_FALSE_RETURN(S_ISDIR(st.st_mode), false, "'%1%' is not a directory", root_dir_);
+        return true;
+    }
+
+    BROOKESIA_CHECK_FALSE_RETURN(
+        mkdir(root_dir_.c_str(), 0755) == 0, false, "Failed to create directory '%1%': %2%", root_dir_,
+        strerror(errno)
+    );
+    BROOKESIA_LOGI("Created directory '%1%'", root_dir_);
+
+    return true;
+}
+
+void NVSFileBackend::deinit()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+}
+
+std::expected<NVSBackend::Entries, std::string> NVSFileBackend::load(const std::string &nspace)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_LOGD("Params: nspace(%1%)", nspace);
+
+    Entries entries;
+
+    auto path = get_file_path(nspace);
+    std::ifstream file(path);
+    if (!file) {
+        BROOKESIA_LOGD("File '%1%' does not exist, namespace '%2%' is empty", path, nspace);
+        return entries;
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+
+    boost::system::error_code ec;
+    auto json = boost::json::parse(content.str(), ec);
+    if (ec || !json.is_object()) {
+        return std::unexpected((boost::format("Invalid content in file '%1%'") % path).str());
+    }
+
+    // The JSON types match the value types: bool, int64 (from int) and string
+    for (const auto &[key, value] : json.as_object()) {
+        if (value.is_bool()) {
+            entries.emplace(key, value.as_bool());
+        } else if (value.is_int64()) {
+            entries.emplace(key, static_cast<int>(value.as_int64()));
+        } else if (value.is_string()) {
+            entries.emplace(key, std::string(value.as_string()));
+        } else {
+            BROOKESIA_LOGW("Skip key '%1%' of unsupported type in file '%2%'", std::string(key), path);
+        }
+    }
+
+    return entries;
+}
+
+std::expected<void, std::string> NVSFileBackend::commit(
+    const std::string &nspace, bool erase_all, const Changes &changes
+)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_LOGD("Params: nspace(%1%), erase_all(%2%), changes(%3%)", nspace, erase_all, changes.size());
+
+    Entries entries;
+    if (!erase_all) {
+        auto result = load(nspace);
+        if (!result) {
+            return std::unexpected(result.error());
+        }
+        entries = std::move(result.value());
+    }
+
+    for (const auto & [key, value] : changes) {
+        if (value.has_value()) {
+            entries.insert_or_assign(key, value.value());
+        } else {
+            entries.erase(key);
+        }
+    }
+
+    boost::json::object json;
+    for (const auto & [key, value] : entries) {
+        std::visit([&json, &key](auto &&value) {
+            json[key] = value;
+        }, value);
+    }
+
+    // Write to a temporary file, then replace the old one at once
+    auto path = get_file_path(nspace);
+    auto tmp_path = path + ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::trunc);
+        file << boost::json::serialize(json);
+        file.flush();
+        if (!file) {
+            return std::unexpected((boost::format("Failed to write file '%1%'") % tmp_path).str());
+        }
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        return std::unexpected((
+                                   boost::format("Failed to rename '%1%' to '%2%': %3%") % tmp_path % path %
+                                   strerror(errno)
+                               ).str());
+    }
+
+    return {};
+}
+
+} // namespace esp_brookesia::service
@@ -0,0 +1,221 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#if defined(ESP_PLATFORM)
+#include <vector>
+#include "nvs_flash.h"
+#include "nvs.h"
+#include "nvs_handle.hpp"
+#include "boost/format.hpp"
+#include "brookesia/service_nvs/macro_configs.h"
+#if !BROOKESIA_SERVICE_NVS_ENABLE_DEBUG_LOG
+#   define BROOKESIA_LOG_DISABLE_DEBUG_TRACE 1
+#endif
+#include "private/utils.hpp"
+#include "brookesia/lib_utils/function_guard.hpp"
+#include "brookesia/service_nvs/backend.hpp"
+
+namespace esp_brookesia::service {
+
+bool NVSFlashBackend::init()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    /* Initialize NVS flash */
+    esp_err_t ret = nvs_flash_init();
+    if ((ret == ESP_ERR_NVS_NO_FREE_PAGES) || (ret == ESP_ERR_NVS_NEW_VERSION_FOUND)) {
+        BROOKESIA_LOGI("NVS partition was truncated and needs to be erased");
+        BROOKESIA_CHECK_ESP_ERR_RETURN(nvs_flash_erase(), false, "Erase NVS flash failed");
+        BROOKESIA_CHECK_ESP_ERR_RETURN(nvs_flash_init(), false, "Init NVS flash failed");
+    } else {
+        BROOKESIA_CHECK_ESP_ERR_RETURN(ret, false, "Initialize NVS flash failed");
+    }
+
+    return true;
+}
+
+void NVSFlashBackend::deinit()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    /* Deinitialize NVS flash */
+    BROOKESIA_CHECK_ESP_ERR_EXECUTE(nvs_flash_deinit(), {}, {
+        BROOKESIA_LOGE("Deinitialize NVS flash failed");
+    });
+}
+
+std::expected<NVSBackend::Entries, std::string> NVSFlashBackend::load(const std::string &nspace)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_LOGD("Params: nspace(%1%)", nspace);
+
+    Entries entries;
+
+    // Collect the keys and types first, the handle is opened once to read all of them
+    std::vector<nvs_entry_info_t> infos;
+    nvs_iterator_t it = NULL;
+    lib_utils::FunctionGuard release_iterator_guard([&]() {
+        BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+        if (it != NULL) {
+            nvs_release_iterator(it);
+        }
+    });
+
+    esp_err_t ret = nvs_entry_find(NVS_DEFAULT_PART_NAME, nspace.c_str(), NVS_TYPE_ANY, &it);
+    while (ret == ESP_OK) {
+        nvs_entry_info_t info;
+        ret = nvs_entry_info(it, &info);
+        if (ret != ESP_OK) {
+            return std::unexpected((
+                                       boost::format("Failed to get entry info in namespace '%1%': %2%") %
+                                       nspace % esp_err_to_name(ret)
+                                   ).str());
+        }
+        infos.push_back(info);
+        ret = nvs_entry_next(&it);
+    }
+    if (ret != ESP_ERR_NVS_NOT_FOUND) {
+        return std::unexpected((
+                                   boost::format("Error occurred when iterating entries in namespace '%1%': %2%") %
+                                   nspace % esp_err_to_name(ret)
+                               ).str());
+    }
+    if (infos.empty()) {
+        BROOKESIA_LOGD("Namespace '%1%' is empty", nspace);
+        return entries;
+    }
+
+    auto handle = nvs::open_nvs_handle(nspace.c_str(), NVS_READONLY, &ret);
+    if (ret != ESP_OK) {
+        return std::unexpected((
+                                   boost::format("Failed to open NVS namespace '%1%': %2%") % nspace %
+                                   esp_err_to_name(ret)
+                               ).str());
+    }
+
+    for (const auto &info : infos) {
+        switch (info.type) {
+        case NVS_TYPE_U8: {
+            // Boolean is stored as uint8_t (0 or 1)
+            uint8_t bool_value = 0;
+            ret = handle->get_item(info.key, bool_value);
+            if (ret == ESP_OK) {
+                entries.emplace(info.key, bool_value != 0);
+            }
+            break;
+        }
+        case NVS_TYPE_I32: {
+            int32_t i32_value = 0;
+            ret = handle->get_item(info.key, i32_value);
+            if (ret == ESP_OK) {
+                entries.emplace(info.key, static_cast<int>(i32_value));
+            }
+            break;
+        }
+        case NVS_TYPE_STR: {
+            size_t required_size = 0;
+            ret = handle->get_item_size(nvs::ItemType::SZ, info.key, required_size);
+            if ((ret == ESP_OK) && (required_size > 0)) {
+                std::vector<char> buffer(required_size);
+                ret = handle->get_string(info.key, buffer.data(), required_size);
+                if (ret == ESP_OK) {
+                    entries.emplace(info.key, std::string(buffer.data()));
+                }
+            } else if (ret == ESP_OK) {
+                entries.emplace(info.key, std::string());
+            }
+            break;
+        }
+        default:
+            BROOKESIA_LOGD("Skip key '%1%' of unsupported type %2%", info.key, static_cast<int>(info.type));
+            continue;
+        }
+
+        if (ret != ESP_OK) {
+            return std::unexpected((
+                                       boost::format("Failed to get key '%1%' in namespace '%2%': %3%") % info.key %
+                                       nspace % esp_err_to_name(ret)
+                                   ).str());
+        }
+    }
+
+    return entries;
+}
+
+std::expected<void, std::string> NVSFlashBackend::commit(
+    const std::string &nspace, bool erase_all, const Changes &changes
+)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_LOGD("Params: nspace(%1%), erase_all(%2%), changes(%3%)", nspace, erase_all, changes.size());
+
+    esp_err_t ret = ESP_OK;
+    auto handle = nvs::open_nvs_handle(nspace.c_str(), NVS_READWRITE, &ret);
+    if (ret != ESP_OK) {
+        return std::unexpected((
+                                   boost::format("Failed to open NVS namespace '%1%': %2%") % nspace %
+                                   esp_err_to_name(ret)
+                               ).str());
+    }
+
+    if (erase_all) {
+        ret = handle->erase_all();
+        if (ret != ESP_OK) {
+            return std::unexpected((
+                                       boost::format("Failed to erase all keys in namespace '%1%': %2%") % nspace %
+                                       esp_err_to_name(ret)
+                                   ).str());
+        }
+    }
+
+    for (const auto & [key, value] : changes) {
+        const char *key_str = key.c_str();
+        if (!value.has_value()) {
+            ret = handle->erase_item(key_str);
+            if (ret == ESP_ERR_NVS_NOT_FOUND) {
+                // Already erased by `erase_all`, or never committed
+                ret = ESP_OK;
+            }
+        } else {
+            std::visit([&](auto &&value) {
+                using T = std::decay_t<decltype(value)>;
+                if constexpr (std::is_same_v<T, bool>) {
+                    // Store boolean as uint8_t (0 or 1)
+                    uint8_t bool_value = value ? 1 : 0;
+                    ret = handle->set_item(key_str, bool_value);
+                } else if constexpr (std::is_same_v<T, int>) {
+                    // Store int as int32_t
+                    ret = handle->set_item(key_str, static_cast<int32_t>(value));
+                } else if constexpr (std::is_same_v<T, std::string>) {
+                    // Store string
+                    ret = handle->set_string(key_str, value.c_str());
+                }
+            }, value.value());
+        }
+
+        if (ret != ESP_OK) {
+            return std::unexpected((
+                                       boost::format("Failed to write key '%1%' in namespace '%2%': %3%") % key %
+                                       nspace % esp_err_to_name(ret)
+                                   ).str());
+        }
+    }
+
+    // Commit changes
+    ret = handle->commit();
+    if (ret != ESP_OK) {
+        return std::unexpected((
+                                   boost::format("Failed to commit NVS changes in namespace '%1%': %2%") % nspace %
+                                   esp_err_to_name(ret)
+                               ).str());
+    }
+
+    return {};
+}
+
+} // namespace esp_brookesia::service
+#endif // ESP_PLATFORM
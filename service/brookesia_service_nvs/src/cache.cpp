@@ -0,0 +1,248 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "boost/format.hpp"
+#include "brookesia/service_nvs/macro_configs.h"
+#if !BROOKESIA_SERVICE_NVS_ENABLE_DEBUG_LOG
+#   define BROOKESIA_LOG_DISABLE_DEBUG_TRACE 1
+#endif
+#include "private/utils.hpp"
+#include "brookesia/service_nvs/cache.hpp"
+
+namespace esp_brookesia::service {
+
+static std::expected<void, std::string> check_name(const char *what, const std::string &name, size_t max_length)
+{
+    if (name.empty() || (name.size() > max_length)) {
+        return std::unexpected((
+                                   boost::format("Invalid %1% '%2%': length must be in [1, %3%]") % what % name %
+                                   max_length
+                               ).str());
+    }
+    return {};
+}
+
+std::expected<NVSCache::Entries, std::string> NVSCache::get_all(const std::string &nspace)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_LOGD("Params: nspace(%1%)", nspace);
+
+    boost::lock_guard lock(mutex_);
+
+    auto ns = get_namespace(nspace);
+    if (!ns) {
+        return std::unexpected(ns.error());
+    }
+
+    statistics_.read_count += ns.value()->values.size();
+
+    return ns.value()->values;
+}
+
+std::expected<NVSCache::Entries, std::string> NVSCache::get(
+    const std::string &nspace, const std::vector<std::string> &keys
+)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_LOGD("Params: nspace(%1%), keys(%2%)", nspace, BROOKESIA_DESCRIBE_TO_STR(keys));
+
+    boost::lock_guard lock(mutex_);
+
+    auto ns = get_namespace(nspace);
+    if (!ns) {
+        return std::unexpected(ns.error());
+    }
+
+    Entries entries;
+    const auto &values = ns.value()->values;
+    for (const auto &key : keys) {
+        auto it = values.find(key);
+        if (it == values.end()) {
+            BROOKESIA_LOGW("Key '%1%' not found in namespace '%2%'", key, nspace);
+            continue;
+        }
+        entries.emplace(key, it->second);
+    }
+    statistics_.read_count += keys.size();
+
+    return entries;
+}
+
+std::expected<void, std::string> NVSCache::set(
+    const std::string &nspace, std::vector<helper::NVS::KeyValuePair> &&pairs
+)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_LOGD("Params: nspace(%1%), pairs(%2%)", nspace, BROOKESIA_DESCRIBE_TO_STR(pairs));
+
+    // Validate everything first, so that a request is applied entirely or not at all
+    for (const auto &pair : pairs) {
+        auto result = check_name("key", pair.key, MAX_KEY_LENGTH);
+        if (!result) {
+            return result;
+        }
+    }
+
+    boost::lock_guard lock(mutex_);
+
+    auto ns = get_namespace(nspace);
+    if (!ns) {
+        return std::unexpected(ns.error());
+    }
+
+    auto &values = ns.value()->values;
+    auto &changes = ns.value()->changes;
+    for (auto &pair : pairs) {
+        statistics_.write_count++;
+
+        auto value_it = values.find(pair.key);
+        if ((value_it != values.end()) && (value_it->second == pair.value)) {
+            BROOKESIA_LOGD("Key '%1%' is unchanged, skip", pair.key);
+            statistics_.writes_avoided++;
+            continue;
+        }
+
+        auto change_it = changes.find(pair.key);
+        if (change_it != changes.end()) {
+            // The pending write is replaced before reaching the backend
+            statistics_.writes_avoided++;
+            change_it->second = pair.value;
+        } else {
+            changes.emplace(pair.key, pair.value);
+        }
+        values.insert_or_assign(std::move(pair.key), std::move(pair.value));
+    }
+
+    return {};
+}
+
+std::expected<size_t, std::string> NVSCache::erase(const std::string &nspace, const std::vector<std::string> &keys)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_LOGD("Params: nspace(%1%), keys(%2%)", nspace, BROOKESIA_DESCRIBE_TO_STR(keys));
+
+    boost::lock_guard lock(mutex_);
+
+    auto ns = get_namespace(nspace);
+    if (!ns) {
+        return std::unexpected(ns.error());
+    }
+
+    auto &values = ns.value()->values;
+    auto &changes = ns.value()->changes;
+    size_t erased_count = 0;
+
+    if (keys.empty()) {
+        // One erase of the whole namespace replaces all the pending changes
+        erased_count = values.size();
+        statistics_.write_count++;
+        statistics_.writes_avoided += changes.size();
+        values.clear();
+        changes.clear();
+        ns.value()->erase_all = true;
+        return erased_count;
+    }
+
+    for (const auto &key : keys) {
+        auto value_it = values.find(key);
+        if (value_it == values.end()) {
+            BROOKESIA_LOGW("Key '%1%' not found in namespace '%2%'", key, nspace);
+            continue;
+        }
+        values.erase(value_it);
+        erased_count++;
+        statistics_.write_count++;
+
+        auto change_it = changes.find(key);
+        if (change_it != changes.end()) {
+            statistics_.writes_avoided++;
+            change_it->second = std::nullopt;
+        } else {
+            changes.emplace(key, std::nullopt);
+        }
+    }
+
+    return erased_count;
+}
+
+std::expected<void, std::string> NVSCache::flush()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    boost::lock_guard lock(mutex_);
+
+    statistics_.flush_count++;
+
+    std::expected<void, std::string> result;
+    for (auto & [nspace, ns] : namespaces_) {
+        if (!ns.is_dirty()) {
+            continue;
+        }
+
+        auto commit_result = backend_->commit(nspace, ns.erase_all, ns.changes);
+        if (!commit_result) {
+            BROOKESIA_LOGE("Failed to commit namespace '%1%': %2%", nspace, commit_result.error());
+            if (result) {
+                result = std::unexpected(commit_result.error());
+            }
+            continue;
+        }
+
+        BROOKESIA_LOGD(
+            "Committed namespace '%1%' (erase all: %2%, changes: %3%)", nspace, ns.erase_all, ns.changes.size()
+        );
+        statistics_.commit_count++;
+        statistics_.backend_write_count += ns.changes.size() + (ns.erase_all ? 1 : 0);
+        ns.changes.clear();
+        ns.erase_all = false;
+    }
+
+    return result;
+}
+
+bool NVSCache::is_dirty() const
+{
+    boost::lock_guard lock(mutex_);
+
+    for (const auto & [nspace, ns] : namespaces_) {
+        if (ns.is_dirty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::expected<NVSCache::Namespace *, std::string> NVSCache::get_namespace(const std::string &nspace)
+{
+    auto it = namespaces_.find(nspace);
+    if (it != namespaces_.end()) {
+        return &it->second;
+    }
+
+    auto check_result = check_name("namespace", nspace, MAX_NAMESPACE_LENGTH);
+    if (!check_result) {
+        return std::unexpected(check_result.error());
+    }
+
+    auto entries = backend_->load(nspace);
+    if (!entries) {
+        return std::unexpected((
+                                   boost::format("Failed to load namespace '%1%': %2%") % nspace % entries.error()
+                               ).str());
+    }
+    statistics_.load_count++;
+    BROOKESIA_LOGD("Loaded %1% keys from namespace '%2%'", entries.value().size(), nspace);
+
+    auto &ns = namespaces_[nspace];
+    ns.values = std::move(entries.value());
+
+    return &ns;
+}
+
+} // namespace esp_brookesia::service
@@ -747,6 +747,94 @@ TEST_CASE("Test ServiceNvs - list result structure", "[service][nvs][list_struct
     TEST_ASSERT_TRUE_MESSAGE(all_passed, "Not all tests passed");
 }
 
+TEST_CASE("Test ServiceNvs - write-back cache", "[service][nvs][cache]")
+{
+    BROOKESIA_TIME_PROFILER_SCOPE("test_service_nvs_cache");
+    BROOKESIA_LOGI("=== Test ServiceNvs - write-back cache ===");
+
+    BROOKESIA_CHECK_FALSE_RETURN(startup(),, "Failed to startup");
+    lib_utils::FunctionGuard shutdown_guard([]() {
+        shutdown();
+    });
+
+    const std::string test_namespace = "test_cache";
+    auto &nvs = service::NVS::get_instance();
+    nvs.reset_cache_statistics();
+
+    auto set_item = [&](const std::string & name, int value) {
+        return service::LocalTestItem(
+                   name,
+                   nvs_functions[nvs_helper::FunctionIndexSet].name,
+        boost::json::object{
+            {nvs_functions[nvs_helper::FunctionIndexSet].parameters[0].name, test_namespace},
+            {
+                nvs_functions[nvs_helper::FunctionIndexSet].parameters[1].name,
+                BROOKESIA_DESCRIBE_TO_JSON(std::vector<nvs_helper::KeyValuePair>({{"counter", value}}))
+            }
+        }
+               );
+    };
+
+    std::vector<service::LocalTestItem> test_items = {
+        set_item("Set counter to 1", 1),
+        // Same value, never written
+        set_item("Set counter to 1 again", 1),
+        set_item("Set counter to 2", 2),
+        // Read-your-writes, whether the change is committed or not
+        service::LocalTestItem(
+            "Get counter before flush",
+            nvs_functions[nvs_helper::FunctionIndexGet].name,
+        boost::json::object{
+            {nvs_functions[nvs_helper::FunctionIndexGet].parameters[0].name, test_namespace},
+            {
+                nvs_functions[nvs_helper::FunctionIndexGet].parameters[1].name,
+                BROOKESIA_DESCRIBE_TO_JSON(std::vector<std::string>({"counter"}))
+            }
+        }
+        , [](const service::FunctionValue & value)
+        {
+            auto object_ptr = std::get_if<boost::json::object>(&value);
+            if (!object_ptr || !object_ptr->contains("counter")) {
+                BROOKESIA_LOGE("Get counter before flush: key 'counter' not found");
+                return false;
+            }
+            return object_ptr->at("counter").to_number<int>() == 2;
+        }
+        ),
+        service::LocalTestItem(
+            "Flush",
+            nvs_functions[nvs_helper::FunctionIndexFlush].name
+        ),
+        service::LocalTestItem(
+            "Erase all entries",
+            nvs_functions[nvs_helper::FunctionIndexErase].name,
+        boost::json::object{
+            {nvs_functions[nvs_helper::FunctionIndexErase].parameters[0].name, test_namespace},
+            {
+                nvs_functions[nvs_helper::FunctionIndexErase].parameters[1].name,
+                BROOKESIA_DESCRIBE_TO_JSON(std::vector<std::string>({}))
+            }
+        }
+        ),
+    };
+
+    service::LocalTestRunner runner;
+    bool all_passed = runner.run_tests(nvs_helper::SERVICE_NAME, test_items);
+    TEST_ASSERT_TRUE_MESSAGE(all_passed, "Not all tests passed");
+
+    TEST_ASSERT_TRUE(nvs.flush());
+    auto statistics = nvs.get_cache_statistics();
+    BROOKESIA_LOGI(
+        "Cache statistics: writes(%1%), backend writes(%2%), avoided(%3%), commits(%4%), loads(%5%)",
+        statistics.write_count, statistics.backend_write_count, statistics.writes_avoided, statistics.commit_count,
+        statistics.load_count
+    );
+    TEST_ASSERT_EQUAL(4, statistics.write_count);
+    TEST_ASSERT_GREATER_OR_EQUAL(1, statistics.writes_avoided);
+    TEST_ASSERT_LESS_OR_EQUAL(statistics.write_count - statistics.writes_avoided, statistics.backend_write_count);
+    TEST_ASSERT_EQUAL(1, statistics.load_count);
+}
+
 static bool startup()
 {
     // Configure TimeProfiler
@@ -7,5 +7,6 @@
 
 #include "service_wifi/macro_configs.h"
 #include "service_wifi/hal.hpp"
+#include "service_wifi/scan_ap_table.hpp"
 #include "service_wifi/state_machine.hpp"
 #include "service_wifi/service_wifi.hpp"
@@ -0,0 +1,251 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "boost/thread/lock_guard.hpp"
+#include "boost/thread/mutex.hpp"
+#include "brookesia/lib_utils/describe_helpers.hpp"
+#include "brookesia/lib_utils/task_scheduler.hpp"
+#include "brookesia/service_helper/wifi.hpp"
+#if defined(ESP_PLATFORM)
+#   include "esp_wifi.h"
+#endif
+
+namespace esp_brookesia::service::wifi {
+
+/**
+ * @brief Radio driver of the WiFi HAL
+ *
+ * `Hal` keeps the state flags, the waits and the callbacks, and only calls the driver for the operations of the
+ * radio. The results of the asynchronous operations are reported through the event callback, which may be called
+ * from any thread.
+ */
+class Driver {
+public:
+    enum class Event {
+        StaStarted,
+        StaStopped,
+        StaDisconnected,    // Also reported when a connection attempt fails
+        StaGotIp,
+        ScanDone,           // Also reported when a scan is stopped
+        Max,
+    };
+
+    using EventCallback = std::function<void(Event event)>;
+
+    virtual ~Driver() = default;
+
+    /**
+     * @brief Initialize the resources shared with other components (e.g. the network interface and event loop)
+     */
+    virtual bool init() = 0;
+    virtual void deinit() = 0;
+
+    /**
+     * @brief Start reporting the events to `callback`, until `detach()` is called
+     */
+    virtual bool attach(EventCallback callback) = 0;
+    virtual void detach() = 0;
+
+    virtual bool wifi_init() = 0;
+    virtual bool wifi_deinit() = 0;
+    virtual bool wifi_start() = 0;
+    virtual bool wifi_stop() = 0;
+    virtual bool connect(const std::string &ssid, const std::string &password) = 0;
+    virtual bool disconnect() = 0;
+    virtual bool scan_start() = 0;
+    virtual bool scan_stop() = 0;
+
+    /**
+     * @brief Get the results of the last scan, sorted by RSSI in descending order
+     *
+     * @note The APs should have their `bssid` set, it identifies them across the scans
+     *
+     * @param[in] max_count Maximum number of APs
+     * @param[out] ap_infos APs
+     * @return true on success, false on failure
+     */
+    virtual bool get_scan_results(size_t max_count, std::vector<helper::Wifi::ApInfo> &ap_infos) = 0;
+
+    /**
+     * @brief Format a BSSID like the `bssid` of `ApInfo`, e.g. "aa:bb:cc:dd:ee:01"
+     */
+    static std::string format_bssid(const uint8_t (&bssid)[6])
+    {
+        char text[sizeof("aa:bb:cc:dd:ee:ff")] = {};
+        snprintf(
+            text, sizeof(text), "%02x:%02x:%02x:%02x:%02x:%02x", bssid[0], bssid[1], bssid[2], bssid[3], bssid[4],
+            bssid[5]
+        );
+        return text;
+    }
+};
+BROOKESIA_DESCRIBE_ENUM(Driver::Event, StaStarted, StaStopped, StaDisconnected, StaGotIp, ScanDone, Max);
+
+#if defined(ESP_PLATFORM)
+/**
+ * @brief Driver on `esp_wifi` and the default event loop
+ */
+class EspDriver : public Driver {
+public:
+    bool init() override;
+    void deinit() override;
+    bool attach(EventCallback callback) override;
+    void detach() override;
+    bool wifi_init() override;
+    bool wifi_deinit() override;
+    bool wifi_start() override;
+    bool wifi_stop() override;
+    bool connect(const std::string &ssid, const std::string &password) override;
+    bool disconnect() override;
+    bool scan_start() override;
+    bool scan_stop() override;
+    bool get_scan_results(size_t max_count, std::vector<helper::Wifi::ApInfo> &ap_infos) override;
+
+private:
+    static void on_event_handler(void *arg, esp_event_base_t base, int32_t id, void *data);
+
+    EventCallback event_callback_;
+    esp_netif_t *sta_netif_ = nullptr;
+    esp_event_handler_instance_t wifi_event_handler_instance_ = nullptr;
+    esp_event_handler_instance_t ip_event_handler_instance_ = nullptr;
+};
+#endif // ESP_PLATFORM
+
+/**
+ * @brief Driver replaying a scripted radio environment, used to run and load-test the HAL off-device
+ *
+ * All the durations of the script are in simulated time, which runs `Script::time_scale` times faster than the real
+ * time and starts at `init()`. The events are reported from the thread of the driver, like the event task of
+ * `esp_wifi`.
+ */
+class SimulatedDriver : public Driver {
+public:
+    struct AccessPoint {
+        std::string ssid;
+        std::string bssid;                  // Empty to derive one from the index of the AP in the script
+        std::string password;               // Empty for an open AP
+        int rssi = -50;                     // RSSI around which the scanned values drift
+        int rssi_drift = 0;                 // Each scan reports a RSSI in [rssi - rssi_drift, rssi + rssi_drift]
+        uint32_t appear_ms = 0;             // The AP is visible in [appear_ms, disappear_ms)
+        uint32_t disappear_ms = UINT32_MAX;
+    };
+
+    struct DisconnectStorm {
+        uint32_t start_ms = 0;              // Time of the first drop of the link
+        uint32_t count = 0;                 // Number of drops, a drop while not connected is ignored
+        uint32_t interval_ms = 0;           // Time between two drops
+    };
+
+    struct Script {
+        std::vector<AccessPoint> aps;
+        std::vector<DisconnectStorm> disconnect_storms;
+        uint32_t start_latency_ms = 50;
+        uint32_t stop_latency_ms = 20;
+        uint32_t scan_duration_ms = 1500;
+        uint32_t connect_latency_ms = 1000; // Until the IP is got, or the attempt fails
+        uint32_t disconnect_latency_ms = 20;
+        uint32_t connect_failure_percent = 0;   // Chance that an attempt with the right password fails anyway
+        uint32_t time_scale = 1;
+        uint32_t seed = 1;                  // Seed of the RSSI drift and of the connection failures
+    };
+
+    struct Statistics {
+        std::array<uint32_t, static_cast<size_t>(Event::Max)> event_counts = {};
+        uint32_t scan_count = 0;
+        uint32_t connect_count = 0;
+        uint32_t connect_failure_count = 0;
+        uint32_t link_drop_count = 0;       // Drops of an established link, by a storm or a disappearing AP
+    };
+
+    SimulatedDriver();
+    explicit SimulatedDriver(Script script);
+    ~SimulatedDriver() override;
+
+    bool init() override;
+    void deinit() override;
+    bool attach(EventCallback callback) override;
+    void detach() override;
+    bool wifi_init() override;
+    bool wifi_deinit() override;
+    bool wifi_start() override;
+    bool wifi_stop() override;
+    bool connect(const std::string &ssid, const std::string &password) override;
+    bool disconnect() override;
+    bool scan_start() override;
+    bool scan_stop() override;
+    bool get_scan_results(size_t max_count, std::vector<helper::Wifi::ApInfo> &ap_infos) override;
+
+    /**
+     * @brief Get the simulated time elapsed since `init()`
+     */
+    uint32_t get_time_ms() const;
+
+    /**
+     * @brief Convert a simulated duration to the real one
+     */
+    uint32_t to_real_ms(uint32_t simulated_ms) const
+    {
+        return simulated_ms / std::max<uint32_t>(script_.time_scale, 1);
+    }
+
+    Statistics get_statistics() const
+    {
+        boost::lock_guard lock(mutex_);
+        return statistics_;
+    }
+
+    void reset_statistics()
+    {
+        boost::lock_guard lock(mutex_);
+        statistics_ = {};
+    }
+
+private:
+    inline static constexpr const char *RADIO_GROUP = "radio";
+
+    // Must be called with the lock held
+    bool post_delayed(
+        uint32_t delay_ms, lib_utils::TaskScheduler::OnceTask task, lib_utils::TaskScheduler::TaskId *id = nullptr
+    );
+    bool post_at(uint32_t time_ms, lib_utils::TaskScheduler::OnceTask task);
+    void post_event(uint32_t delay_ms, Event event);
+    const AccessPoint *find_visible_ap(const std::string &ssid, uint32_t time_ms) const;
+    void post_disconnect_storms();
+
+    void drop_link(uint32_t link_generation);
+    void emit_event(Event event);
+
+    const Script script_;
+
+    mutable boost::mutex mutex_;
+    std::shared_ptr<lib_utils::TaskScheduler> task_scheduler_;
+    std::chrono::steady_clock::time_point start_time_;
+    std::mt19937 random_engine_;
+    EventCallback event_callback_;
+    bool is_wifi_inited_ = false;
+    bool is_wifi_started_ = false;
+    bool is_connected_ = false;
+    std::string connected_ssid_;
+    uint32_t link_generation_ = 0;  // Changed by each connection and drop, so that stale drops are ignored
+    lib_utils::TaskScheduler::TaskId connect_task_ = 0;
+    uint32_t connect_attempt_ = 0;  // Changed by each attempt and cancellation, so that stale attempts are ignored
+    lib_utils::TaskScheduler::TaskId scan_task_ = 0;
+    std::vector<helper::Wifi::ApInfo> scan_results_;
+    Statistics statistics_;
+};
+
+} // namespace esp_brookesia::service::wifi
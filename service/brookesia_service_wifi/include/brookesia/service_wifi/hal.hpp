@@ -7,11 +7,14 @@
 
 #include <bitset>
 #include <cstdint>
+#include <list>
+#include <memory>
 #include <string>
-#include "esp_wifi.h"
+#include <vector>
 #include "brookesia/lib_utils/describe_helpers.hpp"
 #include "brookesia/lib_utils/task_scheduler.hpp"
 #include "brookesia/service_helper/wifi.hpp"
+#include "brookesia/service_wifi/driver.hpp"
 
 namespace esp_brookesia::service::wifi {
 
@@ -90,10 +93,11 @@ public:
                                      const GeneralStateFlags &new_flags
                                  )>;
     using GeneralActionCallback = std::function<void(GeneralAction action)>;
-    using ScanApRecordsUpdatedCallback = std::function<void(const boost::json::array &scan_ap_infos)>;
+    using ScanApRecordsUpdatedCallback = std::function<void(const std::vector<ApInfo> &scan_ap_infos)>;
 
-    Hal(std::shared_ptr<lib_utils::TaskScheduler> task_scheduler)
+    Hal(std::shared_ptr<lib_utils::TaskScheduler> task_scheduler, std::shared_ptr<Driver> driver)
         : task_scheduler_(task_scheduler)
+        , driver_(driver)
     {}
     ~Hal();
 
@@ -224,8 +228,8 @@ public:
     );
 
 private:
-    inline static const FunctionSchema *FUNCTION_DEFINITIONS = Helper::get_function_definitions();
-    inline static const EventSchema *EVENT_DEFINITIONS = Helper::get_event_definitions();
+    static constexpr std::span<const FunctionSchemaView> FUNCTION_DEFINITIONS = Helper::get_function_schema_views();
+    static constexpr std::span<const EventSchemaView> EVENT_DEFINITIONS = Helper::get_event_schema_views();
 
     void stop_internal();
     void deinit_internal();
@@ -247,12 +251,11 @@ private:
     void trigger_general_event(GeneralEvent event);
     bool wait_for_general_event(GeneralEvent event, uint32_t timeout_ms);
 
-    bool process_wifi_event(wifi_event_t event, void *data);
-    bool process_ip_event(ip_event_t event, void *data);
-    static void on_wifi_ip_event_handler(void *arg, esp_event_base_t base, int32_t id, void *data);
+    bool process_driver_event(Driver::Event event);
+    void on_driver_event(Driver::Event event);
 
     bool post_scan_interval_task();
-    bool update_scan_ap_infos();
+    bool update_scan_ap_infos(bool is_aborted);
 
     std::atomic<bool> is_initialized_{false};
     std::atomic<bool> is_running_{false};
@@ -262,6 +265,7 @@ private:
     GeneralStateFlags state_flags_;
 
     std::shared_ptr<lib_utils::TaskScheduler> task_scheduler_;
+    std::shared_ptr<Driver> driver_;
 
     GeneralEventCallback general_event_callback_;
     GeneralActionCallback general_action_callback_;
@@ -269,18 +273,14 @@ private:
 
     boost::mutex operation_mutex_;
 
-    esp_netif_t *sta_netif_ = nullptr;
-    esp_event_handler_instance_t wifi_event_handler_instance_ = nullptr;
-    esp_event_handler_instance_t ip_event_handler_instance_ = nullptr;
-    wifi_config_t target_wifi_config_ = {};
     ConnectApInfo target_connect_ap_info_;
     ConnectApInfo connecting_ap_info_;
     ConnectApInfo last_connected_ap_info_;
     std::list<ConnectApInfo> connected_ap_info_list_;
 
     std::atomic<bool> is_scanning_{false};
+    std::atomic<bool> is_scan_aborted_{false};
     ScanParams scan_params_;
-    boost::json::array scan_ap_infos_;
     lib_utils::TaskScheduler::TaskId scan_ap_periodic_task = 0;
     lib_utils::TaskScheduler::TaskId scan_ap_timeout_task = 0;
 };
@@ -127,3 +127,28 @@
 #       define BROOKESIA_SERVICE_WIFI_TASK_SCHEDULER_WORKER_POLL_INTERVAL_MS  (5)
 #   endif
 #endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////// Scan /////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+#if !defined(BROOKESIA_SERVICE_WIFI_SCAN_RSSI_HYSTERESIS)
+#   if defined(CONFIG_BROOKESIA_SERVICE_WIFI_SCAN_RSSI_HYSTERESIS)
+#       define BROOKESIA_SERVICE_WIFI_SCAN_RSSI_HYSTERESIS  CONFIG_BROOKESIA_SERVICE_WIFI_SCAN_RSSI_HYSTERESIS
+#   else
+#       define BROOKESIA_SERVICE_WIFI_SCAN_RSSI_HYSTERESIS  (5)
+#   endif
+#endif
+#if !defined(BROOKESIA_SERVICE_WIFI_SCAN_MISSED_SCANS_TO_REMOVE)
+#   if defined(CONFIG_BROOKESIA_SERVICE_WIFI_SCAN_MISSED_SCANS_TO_REMOVE)
+#       define BROOKESIA_SERVICE_WIFI_SCAN_MISSED_SCANS_TO_REMOVE  CONFIG_BROOKESIA_SERVICE_WIFI_SCAN_MISSED_SCANS_TO_REMOVE
+#   else
+#       define BROOKESIA_SERVICE_WIFI_SCAN_MISSED_SCANS_TO_REMOVE  (2)
+#   endif
+#endif
+#if !defined(BROOKESIA_SERVICE_WIFI_SCAN_PUBLISH_FULL_AP_INFOS)
+#   if defined(CONFIG_BROOKESIA_SERVICE_WIFI_SCAN_PUBLISH_FULL_AP_INFOS)
+#       define BROOKESIA_SERVICE_WIFI_SCAN_PUBLISH_FULL_AP_INFOS  CONFIG_BROOKESIA_SERVICE_WIFI_SCAN_PUBLISH_FULL_AP_INFOS
+#   else
+#       define BROOKESIA_SERVICE_WIFI_SCAN_PUBLISH_FULL_AP_INFOS  (0)
+#   endif
+#endif
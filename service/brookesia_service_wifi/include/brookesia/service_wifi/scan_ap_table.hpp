@@ -0,0 +1,110 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "boost/thread/lock_guard.hpp"
+#include "boost/thread/mutex.hpp"
+#include "brookesia/service_helper/wifi.hpp"
+#include "brookesia/service_wifi/macro_configs.h"
+
+namespace esp_brookesia::service::wifi {
+
+/**
+ * @brief Table of the scanned APs, keyed by BSSID, turning the results of consecutive scans into deltas
+ *
+ * Each AP (radio) of a SSID is tracked on its own, so that the APs of a mesh network do not replace each other. The
+ * APs without BSSID (e.g. from a driver not reporting it) are keyed by their SSID instead.
+ *
+ * An AP is added when first scanned, changed when its RSSI moves by at least `rssi_hysteresis` dB from the last
+ * reported value (or when its lock changes), and removed after `missed_scans_to_remove` consecutive scans without
+ * it. Each non-empty delta increments the sequence number, so that a client can take a snapshot, then apply the
+ * deltas with a greater sequence only.
+ */
+class ScanApTable {
+public:
+    using ApInfo = helper::Wifi::ApInfo;
+
+    struct Delta {
+        bool empty() const
+        {
+            return added.empty() && changed.empty() && removed.empty();
+        }
+
+        uint32_t sequence = 0;
+        std::vector<ApInfo> added;
+        std::vector<ApInfo> changed;
+        std::vector<std::string> removed;   // Keys, see `get_key()`
+    };
+
+    ScanApTable(
+        int rssi_hysteresis = BROOKESIA_SERVICE_WIFI_SCAN_RSSI_HYSTERESIS,
+        uint32_t missed_scans_to_remove = BROOKESIA_SERVICE_WIFI_SCAN_MISSED_SCANS_TO_REMOVE
+    )
+        : rssi_hysteresis_(rssi_hysteresis)
+        , missed_scans_to_remove_(missed_scans_to_remove)
+    {}
+
+    /**
+     * @brief Merge the results of a scan
+     *
+     * @note The APs without SSID are ignored. If an AP is reported several times, the strongest report is kept,
+     *       whatever the order of the results
+     *
+     * @param[in] ap_infos Results of the scan
+     * @param[out] delta Changes of the table, with the new sequence number if not empty
+     * @return true if the table changed, false otherwise
+     */
+    bool update(const std::vector<ApInfo> &ap_infos, Delta &delta);
+
+    /**
+     * @brief Remove all the APs, e.g. when the radio is stopped
+     *
+     * @param[out] delta Removed APs, with the new sequence number if not empty
+     * @return true if the table changed, false otherwise
+     */
+    bool clear(Delta &delta);
+
+    /**
+     * @brief Get all the APs, sorted by RSSI in descending order
+     *
+     * @param[out] ap_infos APs
+     * @return Sequence number of the last delta included in the snapshot
+     */
+    uint32_t get_snapshot(std::vector<ApInfo> &ap_infos) const;
+
+    uint32_t get_sequence() const
+    {
+        boost::lock_guard lock(mutex_);
+        return sequence_;
+    }
+
+    /**
+     * @brief Get the key of an AP in the table: its BSSID, or its SSID if the BSSID is unknown
+     */
+    static const std::string &get_key(const ApInfo &ap_info)
+    {
+        return ap_info.bssid.empty() ? ap_info.ssid : ap_info.bssid;
+    }
+
+private:
+    struct Entry {
+        ApInfo info;                // As last reported
+        uint32_t missed_scans = 0;
+    };
+
+    const int rssi_hysteresis_;
+    const uint32_t missed_scans_to_remove_;
+
+    mutable boost::mutex mutex_;
+    std::map<std::string, Entry, std::less<>> entries_;
+    uint32_t sequence_ = 0;
+};
+
+} // namespace esp_brookesia::service::wifi
@@ -12,7 +12,9 @@
 #include "brookesia/lib_utils/task_scheduler.hpp"
 #include "brookesia/service_helper/wifi.hpp"
 #include "brookesia/service_helper/nvs.hpp"
+#include "brookesia/service_wifi/driver.hpp"
 #include "brookesia/service_wifi/hal.hpp"
+#include "brookesia/service_wifi/scan_ap_table.hpp"
 #include "brookesia/service_wifi/state_machine.hpp"
 
 namespace esp_brookesia::service::wifi {
@@ -27,9 +29,20 @@ public:
         return instance;
     }
 
+    /**
+     * @brief Replace the radio driver, must be called before the service is initialized
+     *
+     * @note By default, `EspDriver` is used on ESP, and a `SimulatedDriver` without any AP otherwise. Pass `nullptr`
+     *       to restore the default one
+     *
+     * @param[in] driver Driver
+     * @return true on success, false if already initialized
+     */
+    bool set_driver(std::shared_ptr<Driver> driver);
+
 private:
-    inline static const FunctionSchema *FUNCTION_DEFINITIONS = Helper::get_function_definitions();
-    inline static const EventSchema *EVENT_DEFINITIONS = Helper::get_event_definitions();
+    static constexpr std::span<const FunctionSchemaView> FUNCTION_DEFINITIONS = Helper::get_function_schema_views();
+    static constexpr std::span<const EventSchemaView> EVENT_DEFINITIONS = Helper::get_event_schema_views();
 
     Wifi()
         : ServiceBase({
@@ -69,19 +82,16 @@ private:
     std::expected<void, std::string> function_set_connect_ap(const std::string &ssid, const std::string &password);
     std::expected<std::string, std::string> function_get_connect_ap();
     std::expected<boost::json::array, std::string> function_get_connected_aps();
+    std::expected<boost::json::object, std::string> function_get_scan_ap_infos();
 
-    std::vector<FunctionSchema> get_function_definitions() override
+    std::span<const FunctionSchemaView> get_function_schema_views() override
     {
-        return std::vector<FunctionSchema>(
-                   FUNCTION_DEFINITIONS, FUNCTION_DEFINITIONS + Helper::FunctionIndexMax
-               );
+        return FUNCTION_DEFINITIONS;
     }
 
-    std::vector<EventSchema> get_event_definitions() override
+    std::span<const EventSchemaView> get_event_schema_views() override
     {
-        return std::vector<EventSchema>(
-                   EVENT_DEFINITIONS, EVENT_DEFINITIONS + Helper::EventIndexMax
-               );
+        return EVENT_DEFINITIONS;
     }
     FunctionHandlerMap get_function_handlers() override
     {
@@ -120,10 +130,15 @@ private:
                 FUNCTION_DEFINITIONS[Helper::FunctionIndexGetConnectedAps].name,
                 function_get_connected_aps()
             ),
+            BROOKESIA_SERVICE_FUNC_HANDLER_0(
+                FUNCTION_DEFINITIONS[Helper::FunctionIndexGetScanApInfos].name,
+                function_get_scan_ap_infos()
+            ),
         };
     }
 
     std::string get_target_event_state(GeneralEvent event);
+    void publish_scan_ap_infos(const ScanApTable::Delta &delta);
 
     bool is_nvs_valid();
     void try_load_from_nvs();
@@ -131,13 +146,13 @@ private:
     void try_save_connected_ap_info_list_to_nvs();
     void try_save_scan_params_to_nvs();
 
-    std::vector<FunctionSchema> function_definitions_;
-    std::vector<EventSchema> event_definitions_;
     FunctionHandlerMap function_handlers_;
 
     std::shared_ptr<lib_utils::TaskScheduler> task_scheduler_;
+    std::shared_ptr<Driver> driver_;
     std::shared_ptr<Hal> hal_;
     std::unique_ptr<StateMachine> state_machine_;
+    ScanApTable scan_ap_table_;
 };
 
 } // namespace esp_brookesia::service::wifi
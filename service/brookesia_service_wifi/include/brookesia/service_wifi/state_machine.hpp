@@ -5,6 +5,7 @@
  */
 #pragma once
 
+#include <array>
 #include <string>
 #include "brookesia/lib_utils/describe_helpers.hpp"
 #include "brookesia/lib_utils/state_base.hpp"
@@ -47,6 +48,8 @@ private:
     std::shared_ptr<Hal> hal_;
     std::shared_ptr<lib_utils::TaskScheduler> task_scheduler_;
     std::unique_ptr<lib_utils::StateMachine> state_machine_;
+    // GeneralAction -> action ID of the compiled state machine
+    std::array<lib_utils::StateMachine::ActionId, static_cast<size_t>(GeneralAction::Max)> action_ids_{};
 };
 
 } // namespace esp_brookesia::service::wifi
@@ -0,0 +1,304 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#if defined(ESP_PLATFORM)
+#include <algorithm>
+#include <cstring>
+#include "nvs_flash.h"
+#include "esp_netif.h"
+#include "brookesia/service_wifi/macro_configs.h"
+#if !defined(BROOKESIA_SERVICE_WIFI_HAL_ENABLE_DEBUG_LOG)
+#   define BROOKESIA_LOG_DISABLE_DEBUG_TRACE 1
+#endif
+#include "private/utils.hpp"
+#include "brookesia/service_wifi/driver.hpp"
+
+// Since the event callback is called in the event handler, make sure the sys_event stack size is sufficient
+#if CONFIG_ESP_SYSTEM_EVENT_TASK_STACK_SIZE < 3072
+#   error "`CONFIG_ESP_SYSTEM_EVENT_TASK_STACK_SIZE` must be greater than `3072` to avoid stack overflow"
+#endif
+
+namespace esp_brookesia::service::wifi {
+
+bool EspDriver::init()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    esp_netif_init();
+
+    auto result = esp_event_loop_create_default();
+    if (result != ESP_ERR_INVALID_STATE) {
+        BROOKESIA_CHECK_ESP_ERR_RETURN(result, false, "Create default event loop failed");
+    }
+
+    return true;
+}
+
+void EspDriver::deinit()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    // esp_netif_deinit();
+}
+
+bool EspDriver::attach(EventCallback callback)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    /* Initialize NVS flash */
+    esp_err_t ret = nvs_flash_init();
+    if ((ret == ESP_ERR_NVS_NO_FREE_PAGES) || (ret == ESP_ERR_NVS_NEW_VERSION_FOUND)) {
+        BROOKESIA_LOGI("NVS partition was truncated and needs to be erased");
+        BROOKESIA_CHECK_ESP_ERR_RETURN(nvs_flash_erase(), false, "Erase NVS flash failed");
+        BROOKESIA_CHECK_ESP_ERR_RETURN(nvs_flash_init(), false, "Init NVS flash failed");
+    } else {
+        BROOKESIA_CHECK_ESP_ERR_RETURN(ret, false, "Initialize NVS flash failed");
+    }
+
+    event_callback_ = std::move(callback);
+
+    BROOKESIA_CHECK_ESP_ERR_RETURN(
+        esp_event_handler_instance_register(
+            WIFI_EVENT, ESP_EVENT_ANY_ID, on_event_handler, this, &wifi_event_handler_instance_
+        ), false, "Register WiFi event handler failed"
+    );
+    BROOKESIA_CHECK_ESP_ERR_RETURN(
+        esp_event_handler_instance_register(
+            IP_EVENT, ESP_EVENT_ANY_ID, on_event_handler, this, &ip_event_handler_instance_
+        ), false, "Register IP event handler failed"
+    );
+
+    return true;
+}
+
+void EspDriver::detach()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    if (wifi_event_handler_instance_ != nullptr) {
+        BROOKESIA_CHECK_ESP_ERR_EXECUTE(
+        esp_event_handler_instance_unregister(WIFI_EVENT, ESP_EVENT_ANY_ID, wifi_event_handler_instance_), {}, {
+            BROOKESIA_LOGE("Unregister WiFi event handler failed");
+        });
+        wifi_event_handler_instance_ = nullptr;
+    }
+    if (ip_event_handler_instance_ != nullptr) {
+        BROOKESIA_CHECK_ESP_ERR_EXECUTE(
+        esp_event_handler_instance_unregister(IP_EVENT, ESP_EVENT_ANY_ID, ip_event_handler_instance_), {}, {
+            BROOKESIA_LOGE("Unregister IP event handler failed");
+        });
+        ip_event_handler_instance_ = nullptr;
+    }
+    event_callback_ = nullptr;
+}
+
+bool EspDriver::wifi_init()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    // Check if netif already exists
+    if (sta_netif_ != nullptr) {
+        BROOKESIA_LOGD("Already initialized, skip");
+        return true;
+    }
+
+    wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
+    BROOKESIA_CHECK_ESP_ERR_RETURN(esp_wifi_init(&cfg), false, "Initialize WiFi failed");
+    BROOKESIA_CHECK_ESP_ERR_RETURN(esp_wifi_set_mode(WIFI_MODE_STA), false, "Set WiFi mode failed");
+
+    if (sta_netif_ == nullptr) {
+        // If netif doesn't exist, create a new one
+        BROOKESIA_LOGD("No existing STA netif found, creating new one");
+        sta_netif_ = esp_netif_create_default_wifi_sta();
+        BROOKESIA_CHECK_NULL_RETURN(sta_netif_, false, "Create default STA netif failed");
+    }
+
+    return true;
+}
+
+bool EspDriver::wifi_deinit()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+#if !defined(CONFIG_ESP_HOSTED_ENABLED)
+    if (sta_netif_ != nullptr) {
+        esp_netif_destroy_default_wifi(sta_netif_);
+        sta_netif_ = nullptr;
+    }
+
+    BROOKESIA_CHECK_ESP_ERR_EXECUTE(esp_wifi_deinit(), {}, {
+        BROOKESIA_LOGE("Deinitialize WiFi failed");
+    });
+#else
+    BROOKESIA_LOGW("Not supported on ESP32-P4, skip");
+#endif
+
+    return true;
+}
+
+bool EspDriver::wifi_start()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_CHECK_ESP_ERR_RETURN(esp_wifi_set_mode(WIFI_MODE_STA), false, "Set WiFi mode failed");
+    BROOKESIA_CHECK_ESP_ERR_RETURN(esp_wifi_start(), false, "Failed to start WiFi");
+
+    return true;
+}
+
+bool EspDriver::wifi_stop()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_CHECK_ESP_ERR_EXECUTE(esp_wifi_stop(), {}, {
+        BROOKESIA_LOGE("Stop WiFi failed");
+    });
+
+    return true;
+}
+
+bool EspDriver::connect(const std::string &ssid, const std::string &password)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    // Avoid warning: missing field initializers in initializer list
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+    wifi_config_t wifi_config = {
+        .sta = {
+            .ssid = "",
+            .password = "",
+            .scan_method = WIFI_FAST_SCAN,
+            .sort_method = WIFI_CONNECT_AP_BY_SIGNAL,
+            .threshold = {
+                .rssi = -127,
+                .authmode = WIFI_AUTH_OPEN,
+            },
+        },
+    };
+#pragma GCC diagnostic pop
+
+    strncpy(reinterpret_cast<char *>(wifi_config.sta.ssid), ssid.c_str(), sizeof(wifi_config.sta.ssid) - 1);
+    if (!password.empty()) {
+        strncpy(
+            reinterpret_cast<char *>(wifi_config.sta.password), password.c_str(), sizeof(wifi_config.sta.password) - 1
+        );
+    }
+
+    BROOKESIA_CHECK_ESP_ERR_RETURN(esp_wifi_set_config(WIFI_IF_STA, &wifi_config), false, "Failed to set WiFi config");
+    BROOKESIA_CHECK_ESP_ERR_RETURN(esp_wifi_connect(), false, "Failed to connect WiFi");
+
+    return true;
+}
+
+bool EspDriver::disconnect()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_CHECK_ESP_ERR_EXECUTE(esp_wifi_disconnect(), {}, {
+        BROOKESIA_LOGE("Disconnect WiFi failed");
+    });
+
+    return true;
+}
+
+bool EspDriver::scan_start()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_CHECK_ESP_ERR_RETURN(esp_wifi_scan_start(nullptr, false), false, "Start scan failed");
+
+    return true;
+}
+
+bool EspDriver::scan_stop()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_CHECK_ESP_ERR_EXECUTE(esp_wifi_scan_stop(), {}, {
+        BROOKESIA_LOGE("Stop WiFi scan failed");
+    });
+
+    return true;
+}
+
+bool EspDriver::get_scan_results(size_t max_count, std::vector<helper::Wifi::ApInfo> &ap_infos)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    ap_infos.clear();
+
+    uint16_t actual_ap_count = 0;
+    BROOKESIA_CHECK_ESP_ERR_RETURN(esp_wifi_scan_get_ap_num(&actual_ap_count), false, "Get AP number failed");
+
+    if (actual_ap_count == 0) {
+        return true;
+    }
+
+    actual_ap_count = std::min(actual_ap_count, static_cast<uint16_t>(max_count));
+    std::vector<wifi_ap_record_t> ap_records(actual_ap_count);
+    BROOKESIA_CHECK_ESP_ERR_RETURN(
+        esp_wifi_scan_get_ap_records(&actual_ap_count, ap_records.data()), false, "Get AP records failed"
+    );
+
+    ap_infos.reserve(actual_ap_count);
+    for (uint16_t i = 0; i < actual_ap_count; i++) {
+        const auto &ap_record = ap_records[i];
+        ap_infos.emplace_back(
+            reinterpret_cast<const char *>(ap_record.ssid), ap_record.authmode != WIFI_AUTH_OPEN, ap_record.rssi,
+            format_bssid(ap_record.bssid)
+        );
+    }
+
+    return true;
+}
+
+void EspDriver::on_event_handler(void *arg, esp_event_base_t base, int32_t id, void *data)
+{
+    BROOKESIA_LOG_TRACE_GUARD();
+
+    BROOKESIA_LOGD("Params: arg(%1%), base(%2%), id(%3%), data(%4%)", arg, base, id, data);
+
+    auto context = static_cast<EspDriver *>(arg);
+    BROOKESIA_CHECK_NULL_EXIT(context, "Invalid context");
+
+    Event event = Event::Max;
+    if (base == WIFI_EVENT) {
+        switch (id) {
+        case WIFI_EVENT_STA_START:
+            event = Event::StaStarted;
+            break;
+        case WIFI_EVENT_STA_STOP:
+            event = Event::StaStopped;
+            break;
+        case WIFI_EVENT_STA_DISCONNECTED:
+            event = Event::StaDisconnected;
+            break;
+        case WIFI_EVENT_SCAN_DONE:
+            event = Event::ScanDone;
+            break;
+        default:
+            break;
+        }
+    } else if (base == IP_EVENT) {
+        if (id == IP_EVENT_STA_GOT_IP) {
+            event = Event::StaGotIp;
+        }
+    } else {
+        BROOKESIA_CHECK_FALSE_EXIT(false, "Invalid event base: %1%", base);
+    }
+
+    if (event == Event::Max) {
+        BROOKESIA_LOGD("Ignored");
+        return;
+    }
+
+    if (context->event_callback_ != nullptr) {
+        context->event_callback_(event);
+    }
+}
+
+} // namespace esp_brookesia::service::wifi
+#endif // ESP_PLATFORM
@@ -0,0 +1,477 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include "brookesia/service_wifi/macro_configs.h"
+#if !defined(BROOKESIA_SERVICE_WIFI_HAL_ENABLE_DEBUG_LOG)
+#   define BROOKESIA_LOG_DISABLE_DEBUG_TRACE 1
+#endif
+#include "private/utils.hpp"
+#include "brookesia/service_wifi/driver.hpp"
+
+namespace esp_brookesia::service::wifi {
+
+// Range of the RSSI reported by `esp_wifi`
+constexpr int RSSI_MIN = -127;
+constexpr int RSSI_MAX = 0;
+
+SimulatedDriver::SimulatedDriver()
+    : SimulatedDriver(Script{})
+{
+}
+
+SimulatedDriver::SimulatedDriver(Script script)
+    : script_(std::move(script))
+{
+}
+
+SimulatedDriver::~SimulatedDriver()
+{
+    deinit();
+}
+
+bool SimulatedDriver::init()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    boost::lock_guard lock(mutex_);
+
+    if (task_scheduler_ != nullptr) {
+        BROOKESIA_LOGD("Already initialized, skip");
+        return true;
+    }
+
+    std::shared_ptr<lib_utils::TaskScheduler> task_scheduler;
+    BROOKESIA_CHECK_EXCEPTION_RETURN(
+        task_scheduler = std::make_shared<lib_utils::TaskScheduler>(), false, "Failed to create task scheduler"
+    );
+    // Polled every 1 ms, so that the radio adds as little latency as possible to the one measured on the HAL
+    lib_utils::TaskScheduler::StartConfig config;
+    config.worker_configs[0].name = "wifi_sim";
+    config.worker_poll_interval_ms = 1;
+    BROOKESIA_CHECK_FALSE_RETURN(task_scheduler->start(config), false, "Failed to start task scheduler");
+
+    task_scheduler_ = std::move(task_scheduler);
+    start_time_ = std::chrono::steady_clock::now();
+    random_engine_.seed(script_.seed);
+
+    BROOKESIA_LOGI(
+        "Simulated driver initialized (APs: %1%, disconnect storms: %2%, time scale: %3%)", script_.aps.size(),
+        script_.disconnect_storms.size(), script_.time_scale
+    );
+
+    return true;
+}
+
+void SimulatedDriver::deinit()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    std::shared_ptr<lib_utils::TaskScheduler> task_scheduler;
+    {
+        boost::lock_guard lock(mutex_);
+        task_scheduler = std::move(task_scheduler_);
+        event_callback_ = nullptr;
+        is_wifi_inited_ = false;
+        is_wifi_started_ = false;
+        is_connected_ = false;
+        connected_ssid_.clear();
+        connect_task_ = 0;
+        scan_task_ = 0;
+        scan_results_.clear();
+    }
+
+    // Stopped without the lock, the running task may be waiting for it
+    if (task_scheduler != nullptr) {
+        task_scheduler->stop();
+    }
+}
+
+bool SimulatedDriver::attach(EventCallback callback)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    boost::lock_guard lock(mutex_);
+
+    BROOKESIA_CHECK_NULL_RETURN(task_scheduler_, false, "Not initialized");
+
+    event_callback_ = std::move(callback);
+
+    return true;
+}
+
+void SimulatedDriver::detach()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    boost::lock_guard lock(mutex_);
+    event_callback_ = nullptr;
+}
+
+bool SimulatedDriver::wifi_init()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    boost::lock_guard lock(mutex_);
+
+    BROOKESIA_CHECK_NULL_RETURN(task_scheduler_, false, "Not initialized");
+
+    is_wifi_inited_ = true;
+
+    return true;
+}
+
+bool SimulatedDriver::wifi_deinit()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    boost::lock_guard lock(mutex_);
+
+    BROOKESIA_CHECK_FALSE_RETURN(!is_wifi_started_, false, "WiFi is not stopped");
+
+    is_wifi_inited_ = false;
+
+    return true;
+}
+
+bool SimulatedDriver::wifi_start()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    boost::lock_guard lock(mutex_);
+
+    BROOKESIA_CHECK_FALSE_RETURN(is_wifi_inited_, false, "WiFi is not initialized");
+
+    if (is_wifi_started_) {
+        BROOKESIA_LOGD("Already started, skip");
+        return true;
+    }
+
+    is_wifi_started_ = true;
+    post_event(script_.start_latency_ms, Event::StaStarted);
+    post_disconnect_storms();
+
+    return true;
+}
+
+bool SimulatedDriver::wifi_stop()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    boost::lock_guard lock(mutex_);
+
+    if (!is_wifi_started_) {
+        BROOKESIA_LOGD("Not started, skip");
+        return true;
+    }
+
+    // Drop the pending connection, scan and storms, then report what `esp_wifi_stop()` reports
+    task_scheduler_->cancel_group(RADIO_GROUP);
+    connect_task_ = 0;
+    connect_attempt_++;
+    if (scan_task_ != 0) {
+        scan_task_ = 0;
+        post_event(0, Event::ScanDone);
+    }
+    if (is_connected_) {
+        is_connected_ = false;
+        link_generation_++;
+        post_event(0, Event::StaDisconnected);
+    }
+    is_wifi_started_ = false;
+    post_event(script_.stop_latency_ms, Event::StaStopped);
+
+    return true;
+}
+
+bool SimulatedDriver::connect(const std::string &ssid, const std::string &password)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_LOGD("Params: ssid(%1%)", ssid);
+
+    boost::lock_guard lock(mutex_);
+
+    BROOKESIA_CHECK_FALSE_RETURN(is_wifi_started_, false, "WiFi is not started");
+
+    // A new attempt replaces the pending one, and leaves the current AP first
+    if (connect_task_ != 0) {
+        task_scheduler_->cancel(connect_task_);
+        connect_task_ = 0;
+    }
+    auto connect_attempt = ++connect_attempt_;
+    if (is_connected_) {
+        is_connected_ = false;
+        link_generation_++;
+        post_event(0, Event::StaDisconnected);
+    }
+    statistics_.connect_count++;
+
+    auto connect_task = [this, ssid, password, connect_attempt]() {
+        BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+        bool is_connected = false;
+        {
+            boost::lock_guard lock(mutex_);
+            // Already running when it was replaced or cancelled
+            if (connect_attempt != connect_attempt_) {
+                return;
+            }
+            connect_task_ = 0;
+
+            auto time_ms = get_time_ms();
+            auto ap = find_visible_ap(ssid, time_ms);
+            std::uniform_int_distribution<uint32_t> percent(0, 99);
+            if (ap == nullptr) {
+                BROOKESIA_LOGD("AP '%1%' is not visible at %2%ms", ssid, time_ms);
+            } else if (ap->password != password) {
+                BROOKESIA_LOGD("Wrong password of AP '%1%'", ssid);
+            } else if (percent(random_engine_) < script_.connect_failure_percent) {
+                BROOKESIA_LOGD("Connection to AP '%1%' failed by the script", ssid);
+            } else {
+                is_connected = true;
+            }
+
+            if (!is_connected) {
+                statistics_.connect_failure_count++;
+            } else {
+                is_connected_ = true;
+                connected_ssid_ = ssid;
+                auto link_generation = ++link_generation_;
+                if (ap->disappear_ms != UINT32_MAX) {
+                    BROOKESIA_CHECK_FALSE_EXECUTE(post_at(ap->disappear_ms, [this, link_generation]() {
+                        drop_link(link_generation);
+                    }), {}, {
+                        BROOKESIA_LOGE("Post AP disappearing task failed");
+                    });
+                }
+            }
+        }
+
+        emit_event(is_connected ? Event::StaGotIp : Event::StaDisconnected);
+    };
+    BROOKESIA_CHECK_FALSE_RETURN(
+        post_delayed(script_.connect_latency_ms, std::move(connect_task), &connect_task_), false,
+        "Post connect task failed"
+    );
+
+    return true;
+}
+
+bool SimulatedDriver::disconnect()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    boost::lock_guard lock(mutex_);
+
+    BROOKESIA_CHECK_FALSE_RETURN(is_wifi_started_, false, "WiFi is not started");
+
+    if (connect_task_ != 0) {
+        task_scheduler_->cancel(connect_task_);
+        connect_task_ = 0;
+    }
+    connect_attempt_++;
+    is_connected_ = false;
+    link_generation_++;
+    post_event(script_.disconnect_latency_ms, Event::StaDisconnected);
+
+    return true;
+}
+
+bool SimulatedDriver::scan_start()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    boost::lock_guard lock(mutex_);
+
+    BROOKESIA_CHECK_FALSE_RETURN(is_wifi_started_, false, "WiFi is not started");
+
+    if (scan_task_ != 0) {
+        BROOKESIA_LOGD("Scan is already running, skip");
+        return true;
+    }
+    statistics_.scan_count++;
+
+    // The APs are sampled when the scan completes, as the last channel of a real scan
+    auto scan_task = [this]() {
+        BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+        {
+            boost::lock_guard lock(mutex_);
+            // Already running when it was stopped
+            if (scan_task_ == 0) {
+                return;
+            }
+            scan_task_ = 0;
+
+            auto time_ms = get_time_ms();
+            scan_results_.clear();
+            for (size_t i = 0; i < script_.aps.size(); i++) {
+                const auto &ap = script_.aps[i];
+                if ((time_ms < ap.appear_ms) || (time_ms >= ap.disappear_ms)) {
+                    continue;
+                }
+                int rssi = ap.rssi;
+                if (ap.rssi_drift > 0) {
+                    rssi += std::uniform_int_distribution<int>(-ap.rssi_drift, ap.rssi_drift)(random_engine_);
+                }
+                // A locally administered address made of the index, if not scripted
+                std::string bssid = ap.bssid;
+                if (bssid.empty()) {
+                    const uint8_t address[6] = {0x02, 0, 0, 0, static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i)};
+                    bssid = format_bssid(address);
+                }
+                scan_results_.emplace_back(
+                    ap.ssid, !ap.password.empty(), std::clamp(rssi, RSSI_MIN, RSSI_MAX), std::move(bssid)
+                );
+            }
+            std::stable_sort(scan_results_.begin(), scan_results_.end(), [](const auto & a, const auto & b) {
+                return a.rssi > b.rssi;
+            });
+        }
+
+        emit_event(Event::ScanDone);
+    };
+    BROOKESIA_CHECK_FALSE_RETURN(
+        post_delayed(script_.scan_duration_ms, std::move(scan_task), &scan_task_), false, "Post scan task failed"
+    );
+
+    return true;
+}
+
+bool SimulatedDriver::scan_stop()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    boost::lock_guard lock(mutex_);
+
+    if (scan_task_ == 0) {
+        BROOKESIA_LOGD("Scan is not running, skip");
+        return true;
+    }
+
+    task_scheduler_->cancel(scan_task_);
+    scan_task_ = 0;
+    scan_results_.clear();
+    post_event(0, Event::ScanDone);
+
+    return true;
+}
+
+bool SimulatedDriver::get_scan_results(size_t max_count, std::vector<helper::Wifi::ApInfo> &ap_infos)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    boost::lock_guard lock(mutex_);
+
+    auto count = std::min(max_count, scan_results_.size());
+    ap_infos.assign(scan_results_.begin(), scan_results_.begin() + count);
+
+    return true;
+}
+
+uint32_t SimulatedDriver::get_time_ms() const
+{
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - start_time_
+                   ).count();
+
+    return static_cast<uint32_t>(elapsed * std::max<uint32_t>(script_.time_scale, 1));
+}
+
+bool SimulatedDriver::post_delayed(
+    uint32_t delay_ms, lib_utils::TaskScheduler::OnceTask task, lib_utils::TaskScheduler::TaskId *id
+)
+{
+    BROOKESIA_CHECK_NULL_RETURN(task_scheduler_, false, "Not initialized");
+
+    auto real_delay_ms = to_real_ms(delay_ms);
+    if (real_delay_ms == 0) {
+        // Keep the order of the events posted at the same time
+        return task_scheduler_->post(std::move(task), id, RADIO_GROUP);
+    }
+
+    return task_scheduler_->post_delayed(std::move(task), static_cast<int>(real_delay_ms), id, RADIO_GROUP);
+}
+
+bool SimulatedDriver::post_at(uint32_t time_ms, lib_utils::TaskScheduler::OnceTask task)
+{
+    auto now_ms = get_time_ms();
+
+    return post_delayed((time_ms > now_ms) ? (time_ms - now_ms) : 0, std::move(task));
+}
+
+void SimulatedDriver::post_event(uint32_t delay_ms, Event event)
+{
+    BROOKESIA_CHECK_FALSE_EXECUTE(post_delayed(delay_ms, [this, event]() {
+        emit_event(event);
+    }), {}, {
+        BROOKESIA_LOGE("Post event(%1%) failed", BROOKESIA_DESCRIBE_TO_STR(event));
+    });
+}
+
+const SimulatedDriver::AccessPoint *SimulatedDriver::find_visible_ap(const std::string &ssid, uint32_t time_ms) const
+{
+    auto it = std::find_if(script_.aps.begin(), script_.aps.end(), [&ssid, time_ms](const auto & ap) {
+        return (ap.ssid == ssid) && (time_ms >= ap.appear_ms) && (time_ms < ap.disappear_ms);
+    });
+
+    return (it != script_.aps.end()) ? &(*it) : nullptr;
+}
+
+void SimulatedDriver::post_disconnect_storms()
+{
+    // Only the drops still to come, the storms are in the time of the script, not of the current start
+    auto now_ms = get_time_ms();
+    for (const auto &storm : script_.disconnect_storms) {
+        for (uint32_t i = 0; i < storm.count; i++) {
+            uint64_t time_ms = storm.start_ms + static_cast<uint64_t>(i) * storm.interval_ms;
+            if (time_ms >= UINT32_MAX) {
+                break;
+            }
+            if (time_ms < now_ms) {
+                continue;
+            }
+            BROOKESIA_CHECK_FALSE_EXIT(post_at(static_cast<uint32_t>(time_ms), [this]() {
+                drop_link(0);
+            }), "Post disconnect storm task failed");
+        }
+    }
+}
+
+void SimulatedDriver::drop_link(uint32_t link_generation)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    {
+        boost::lock_guard lock(mutex_);
+        // `0` drops any link, others only the link they were posted for
+        if (!is_connected_ || ((link_generation != 0) && (link_generation != link_generation_))) {
+            return;
+        }
+        BROOKESIA_LOGD("Drop the link to AP '%1%' at %2%ms", connected_ssid_, get_time_ms());
+        is_connected_ = false;
+        link_generation_++;
+        statistics_.link_drop_count++;
+    }
+
+    emit_event(Event::StaDisconnected);
+}
+
+void SimulatedDriver::emit_event(Event event)
+{
+    EventCallback callback;
+    {
+        boost::lock_guard lock(mutex_);
+        statistics_.event_counts[static_cast<size_t>(event)]++;
+        callback = event_callback_;
+    }
+
+    if (callback != nullptr) {
+        callback(event);
+    }
+}
+
+} // namespace esp_brookesia::service::wifi
@@ -3,8 +3,6 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
-#include "nvs_flash.h"
-#include "esp_netif.h"
 #include "brookesia/service_wifi/macro_configs.h"
 #if !defined(BROOKESIA_SERVICE_WIFI_HAL_ENABLE_DEBUG_LOG)
 #   define BROOKESIA_LOG_DISABLE_DEBUG_TRACE 1
@@ -13,11 +11,6 @@
 #include "brookesia/lib_utils/function_guard.hpp"
 #include "brookesia/service_wifi/hal.hpp"
 
-// Since it is necessary to call task_scheduler in wifi_event_handler, make sure the sys_event stack size is sufficient
-#if CONFIG_ESP_SYSTEM_EVENT_TASK_STACK_SIZE < 3072
-#   error "`CONFIG_ESP_SYSTEM_EVENT_TASK_STACK_SIZE` must be greater than `3072` to avoid stack overflow"
-#endif
-
 namespace esp_brookesia::service::wifi {
 
 #if defined(CONFIG_ESP_HOSTED_ENABLED)
@@ -48,14 +41,11 @@ bool Hal::init()
         deinit_internal();
     });
 
-    is_initialized_.store(true);
+    BROOKESIA_CHECK_NULL_RETURN(driver_, false, "Invalid driver");
 
-    esp_netif_init();
+    is_initialized_.store(true);
 
-    auto result = esp_event_loop_create_default();
-    if (result != ESP_ERR_INVALID_STATE) {
-        BROOKESIA_CHECK_ESP_ERR_RETURN(result, false, "Create default event loop failed");
-    }
+    BROOKESIA_CHECK_FALSE_RETURN(driver_->init(), false, "Initialize driver failed");
 
     BROOKESIA_LOGI("HAL initialized");
 
@@ -88,7 +78,9 @@ void Hal::deinit_internal()
 
     is_initialized_.store(false);
 
-    // esp_netif_deinit();
+    if (driver_ != nullptr) {
+        driver_->deinit();
+    }
 
     BROOKESIA_LOGI("HAL deinitialized");
 }
@@ -114,26 +106,9 @@ bool Hal::start()
         .enable_post_execute_in_order = true
     }), false, "Failed to configure general callback group");
 
-    /* Initialize NVS flash */
-    esp_err_t ret = nvs_flash_init();
-    if ((ret == ESP_ERR_NVS_NO_FREE_PAGES) || (ret == ESP_ERR_NVS_NEW_VERSION_FOUND)) {
-        BROOKESIA_LOGI("NVS partition was truncated and needs to be erased");
-        BROOKESIA_CHECK_ESP_ERR_RETURN(nvs_flash_erase(), false, "Erase NVS flash failed");
-        BROOKESIA_CHECK_ESP_ERR_RETURN(nvs_flash_init(), false, "Init NVS flash failed");
-    } else {
-        BROOKESIA_CHECK_ESP_ERR_RETURN(ret, false, "Initialize NVS flash failed");
-    }
-
-    BROOKESIA_CHECK_ESP_ERR_RETURN(
-        esp_event_handler_instance_register(
-            WIFI_EVENT, ESP_EVENT_ANY_ID, on_wifi_ip_event_handler, this, &wifi_event_handler_instance_
-        ), false, "Register WiFi event handler failed"
-    );
-    BROOKESIA_CHECK_ESP_ERR_RETURN(
-        esp_event_handler_instance_register(
-            IP_EVENT, ESP_EVENT_ANY_ID, on_wifi_ip_event_handler, this, &ip_event_handler_instance_
-        ), false, "Register IP event handler failed"
-    );
+    BROOKESIA_CHECK_FALSE_RETURN(driver_->attach([this](Driver::Event event) {
+        on_driver_event(event);
+    }), false, "Attach driver failed");
 
     reset_internal();
 
@@ -166,20 +141,7 @@ void Hal::stop_internal()
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
-    if (wifi_event_handler_instance_ != nullptr) {
-        BROOKESIA_CHECK_ESP_ERR_EXECUTE(
-        esp_event_handler_instance_unregister(WIFI_EVENT, ESP_EVENT_ANY_ID, wifi_event_handler_instance_), {}, {
-            BROOKESIA_LOGE("Unregister WiFi event handler failed");
-        });
-        wifi_event_handler_instance_ = nullptr;
-    }
-    if (ip_event_handler_instance_ != nullptr) {
-        BROOKESIA_CHECK_ESP_ERR_EXECUTE(
-        esp_event_handler_instance_unregister(IP_EVENT, ESP_EVENT_ANY_ID, ip_event_handler_instance_), {}, {
-            BROOKESIA_LOGE("Unregister IP event handler failed");
-        });
-        ip_event_handler_instance_ = nullptr;
-    }
+    driver_->detach();
 
     reset_internal();
 }
@@ -201,22 +163,6 @@ void Hal::reset_internal()
         state_flags_.reset();
     }
 
-    // Avoid warning: missing field initializers in initializer list
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wmissing-field-initializers"
-    target_wifi_config_ = {
-        .sta = {
-            .ssid = "",
-            .password = "",
-            .scan_method = WIFI_FAST_SCAN,
-            .sort_method = WIFI_CONNECT_AP_BY_SIGNAL,
-            .threshold = {
-                .rssi = -127,
-                .authmode = WIFI_AUTH_OPEN,
-            },
-        },
-    };
-#pragma GCC diagnostic pop
     target_connect_ap_info_ = ConnectApInfo();
     connecting_ap_info_ = ConnectApInfo();
     last_connected_ap_info_ = ConnectApInfo();
@@ -245,65 +191,28 @@ bool Hal::do_init()
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
-    // Check if netif already exists
-    if (sta_netif_ != nullptr) {
-        BROOKESIA_LOGD("Already initialized, skip");
-        return true;
-    }
-
-    wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
-    BROOKESIA_CHECK_ESP_ERR_RETURN(esp_wifi_init(&cfg), false, "Initialize WiFi failed");
-    BROOKESIA_CHECK_ESP_ERR_RETURN(esp_wifi_set_mode(WIFI_MODE_STA), false, "Set WiFi mode failed");
-
-    if (sta_netif_ == nullptr) {
-        // If netif doesn't exist, create a new one
-        BROOKESIA_LOGD("No existing STA netif found, creating new one");
-        sta_netif_ = esp_netif_create_default_wifi_sta();
-        BROOKESIA_CHECK_NULL_RETURN(sta_netif_, false, "Create default STA netif failed");
-    }
-
-    return true;
+    return driver_->wifi_init();
 }
 
 bool Hal::do_deinit()
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
-#if !defined(CONFIG_ESP_HOSTED_ENABLED)
-    if (sta_netif_ != nullptr) {
-        esp_netif_destroy_default_wifi(sta_netif_);
-        sta_netif_ = nullptr;
-    }
-
-    BROOKESIA_CHECK_ESP_ERR_EXECUTE(esp_wifi_deinit(), {}, {
-        BROOKESIA_LOGE("Deinitialize WiFi failed");
-    });
-#else
-    BROOKESIA_LOGW("Not supported on ESP32-P4, skip");
-#endif
-
-    return true;
+    return driver_->wifi_deinit();
 }
 
 bool Hal::do_start()
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
-    BROOKESIA_CHECK_ESP_ERR_RETURN(esp_wifi_set_mode(WIFI_MODE_STA), false, "Set WiFi mode failed");
-    BROOKESIA_CHECK_ESP_ERR_RETURN(esp_wifi_start(), false, "Failed to start WiFi");
-
-    return true;
+    return driver_->wifi_start();
 }
 
 bool Hal::do_stop()
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
-    BROOKESIA_CHECK_ESP_ERR_EXECUTE(esp_wifi_stop(), {}, {
-        BROOKESIA_LOGE("Stop WiFi failed");
-    });
-
-    return true;
+    return driver_->wifi_stop();
 }
 
 bool Hal::do_connect()
@@ -312,36 +221,14 @@ bool Hal::do_connect()
 
     BROOKESIA_LOGI("Connecting to %1% (password: %2%)...", target_connect_ap_info_.ssid, target_connect_ap_info_.password);
 
-    strncpy(
-        reinterpret_cast<char *>(target_wifi_config_.sta.ssid), target_connect_ap_info_.ssid.c_str(),
-        sizeof(target_wifi_config_.sta.ssid) - 1
-    );
-    if (!target_connect_ap_info_.password.empty()) {
-        strncpy(
-            reinterpret_cast<char *>(target_wifi_config_.sta.password), target_connect_ap_info_.password.c_str(),
-            sizeof(target_wifi_config_.sta.password) - 1
-        );
-    } else {
-        target_wifi_config_.sta.password[0] = '\0';
-    }
-
-    BROOKESIA_CHECK_ESP_ERR_RETURN(
-        esp_wifi_set_config(WIFI_IF_STA, &target_wifi_config_), false, "Failed to set WiFi config"
-    );
-    BROOKESIA_CHECK_ESP_ERR_RETURN(esp_wifi_connect(), false, "Failed to connect WiFi");
-
-    return true;
+    return driver_->connect(target_connect_ap_info_.ssid, target_connect_ap_info_.password);
 }
 
 bool Hal::do_disconnect()
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
-    BROOKESIA_CHECK_ESP_ERR_EXECUTE(esp_wifi_disconnect(), {}, {
-        BROOKESIA_LOGE("Disconnect WiFi failed");
-    });
-
-    return true;
+    return driver_->disconnect();
 }
 
 bool Hal::do_scan_start()
@@ -354,6 +241,7 @@ bool Hal::do_scan_start()
     }
 
     is_scanning_.store(true);
+    is_scan_aborted_.store(false);
     lib_utils::FunctionGuard scan_guard([this]() {
         BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
         is_scanning_.store(false);
@@ -361,7 +249,7 @@ bool Hal::do_scan_start()
 
     {
         boost::lock_guard lock(operation_mutex_);
-        BROOKESIA_CHECK_ESP_ERR_RETURN(esp_wifi_scan_start(nullptr, false), false, "Start scan failed");
+        BROOKESIA_CHECK_FALSE_RETURN(driver_->scan_start(), false, "Start scan failed");
     }
 
     scan_guard.release();
@@ -380,9 +268,8 @@ bool Hal::do_scan_stop()
 
     {
         boost::lock_guard lock(operation_mutex_);
-        BROOKESIA_CHECK_ESP_ERR_EXECUTE(esp_wifi_scan_stop(), {}, {
-            BROOKESIA_LOGE("Stop WiFi scan failed");
-        });
+        is_scan_aborted_.store(true);
+        driver_->scan_stop();
     }
 
     return true;
@@ -888,25 +775,31 @@ bool Hal::is_general_action_running(GeneralAction action)
     return state_flags_.test(BROOKESIA_DESCRIBE_ENUM_TO_NUM(flag_bit));
 }
 
-bool Hal::process_wifi_event(wifi_event_t event, void *data)
+bool Hal::process_driver_event(Driver::Event event)
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
-    BROOKESIA_LOGD("Params: event(%1%), data(%2%)", event, data);
-
-    auto event_id = static_cast<int>(event);
+    BROOKESIA_LOGD("Params: event(%1%)", BROOKESIA_DESCRIBE_TO_STR(event));
 
-    switch (event_id) {
-    case WIFI_EVENT_STA_START:
+    switch (event) {
+    case Driver::Event::StaStarted:
         trigger_general_event(GeneralEvent::Started);
         break;
-    case WIFI_EVENT_STA_STOP:
+    case Driver::Event::StaStopped:
         trigger_general_event(GeneralEvent::Stopped);
         break;
-    case WIFI_EVENT_STA_DISCONNECTED:
+    case Driver::Event::StaDisconnected:
         trigger_general_event(GeneralEvent::Disconnected);
         break;
-    case WIFI_EVENT_SCAN_DONE: {
+    case Driver::Event::StaGotIp: {
+        {
+            boost::lock_guard lock(operation_mutex_);
+            target_connect_ap_info_.is_connectable = true;
+        }
+        trigger_general_event(GeneralEvent::Connected);
+        break;
+    }
+    case Driver::Event::ScanDone: {
         {
             boost::lock_guard lock(operation_mutex_);
             is_scanning_.store(false);
@@ -919,7 +812,7 @@ bool Hal::process_wifi_event(wifi_event_t event, void *data)
             break;
         }
         // Update scan AP infos
-        BROOKESIA_CHECK_FALSE_EXECUTE(update_scan_ap_infos(), {}, {
+        BROOKESIA_CHECK_FALSE_EXECUTE(update_scan_ap_infos(is_scan_aborted_.exchange(false)), {}, {
             BROOKESIA_LOGE("Update scan AP infos failed");
         });
         break;
@@ -931,55 +824,19 @@ bool Hal::process_wifi_event(wifi_event_t event, void *data)
     return true;
 }
 
-bool Hal::process_ip_event(ip_event_t event, void *data)
+void Hal::on_driver_event(Driver::Event event)
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
-    BROOKESIA_LOGD("Params: event(%1%), data(%2%)", event, data);
-
-    auto event_id = static_cast<int>(event);
-
-    switch (event_id) {
-    case IP_EVENT_STA_GOT_IP: {
-        {
-            boost::lock_guard lock(operation_mutex_);
-            target_connect_ap_info_.is_connectable = true;
-        }
-        trigger_general_event(GeneralEvent::Connected);
-        break;
-    }
-    default:
-        BROOKESIA_LOGD("Ignored");
-    }
-
-    return true;
-}
+    BROOKESIA_LOGD("Params: event(%1%)", BROOKESIA_DESCRIBE_TO_STR(event));
 
-void Hal::on_wifi_ip_event_handler(void *arg, esp_event_base_t base, int32_t id, void *data)
-{
-    BROOKESIA_LOG_TRACE_GUARD();
-
-    BROOKESIA_LOGD("Params: arg(%1%), base(%2%), id(%3%), data(%4%)", arg, base, id, data);
-
-    auto context = static_cast<Hal *>(arg);
-    BROOKESIA_CHECK_NULL_EXIT(context, "Invalid context");
-
-    auto process_event_task = [context, base, id, data]() {
-        BROOKESIA_LOG_TRACE_GUARD();
-        if (base == WIFI_EVENT) {
-            BROOKESIA_CHECK_FALSE_EXIT(
-                context->process_wifi_event(static_cast<wifi_event_t>(id), data), "Process WiFi event failed"
-            );
-        } else if (base == IP_EVENT) {
-            BROOKESIA_CHECK_FALSE_EXIT(
-                context->process_ip_event(static_cast<ip_event_t>(id), data), "Process IP event failed"
-            );
-        } else {
-            BROOKESIA_CHECK_FALSE_EXIT(false, "Invalid event base: %1%", base);
-        }
+    // The driver may call it from its own thread (e.g. the event task of `esp_wifi`), so process it in the scheduler
+    auto process_event_task = [this, event]() {
+        BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+        BROOKESIA_CHECK_FALSE_EXIT(process_driver_event(event), "Process driver event failed");
     };
     BROOKESIA_CHECK_FALSE_EXIT(
-        context->task_scheduler_->post(std::move(process_event_task), nullptr, WIFI_EVENT_PROCESS_GROUP),
+        task_scheduler_->post(std::move(process_event_task), nullptr, WIFI_EVENT_PROCESS_GROUP),
         "Post process event task failed"
     );
 }
@@ -991,35 +848,29 @@ bool Hal::post_scan_interval_task()
     return true;
 }
 
-bool Hal::update_scan_ap_infos()
+bool Hal::update_scan_ap_infos(bool is_aborted)
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
-    uint16_t actual_ap_count = 0;
-    BROOKESIA_CHECK_ESP_ERR_RETURN(esp_wifi_scan_get_ap_num(&actual_ap_count), false, "Get AP number failed");
+    BROOKESIA_LOGD("Params: is_aborted(%1%)", is_aborted);
+
+    // Always fetched, so that the driver can release the results
+    std::vector<ApInfo> ap_infos;
+    BROOKESIA_CHECK_FALSE_RETURN(
+        driver_->get_scan_results(scan_params_.ap_count, ap_infos), false, "Get scan results failed"
+    );
 
-    if (actual_ap_count == 0) {
-        BROOKESIA_LOGD("No AP found, skip");
+    // The results of a stopped scan are partial, reporting them would remove the APs not scanned yet
+    if (is_aborted) {
+        BROOKESIA_LOGD("Scan aborted, skip");
         return true;
     }
 
-    actual_ap_count = std::min(actual_ap_count, static_cast<uint16_t>(scan_params_.ap_count));
-    std::vector<wifi_ap_record_t> ap_records(actual_ap_count);
-    BROOKESIA_CHECK_ESP_ERR_RETURN(
-        esp_wifi_scan_get_ap_records(&actual_ap_count, ap_records.data()), false, "Get AP records failed"
-    );
-
-    BROOKESIA_LOGI("Scanned AP count: %d", actual_ap_count);
+    BROOKESIA_LOGI("Scanned AP count: %1%", ap_infos.size());
 
+    // Also reported when empty, so that the APs which are gone can be removed
     if (scan_ap_infos_updated_callback_ != nullptr) {
-        std::vector<ApInfo> ap_infos;
-        for (const auto &ap_record : ap_records) {
-            ap_infos.emplace_back(
-                reinterpret_cast<const char *>(ap_record.ssid), ap_record.authmode != WIFI_AUTH_OPEN, ap_record.rssi
-            );
-        }
-        scan_ap_infos_ = std::move(BROOKESIA_DESCRIBE_TO_JSON(ap_infos).as_array());
-        scan_ap_infos_updated_callback_(scan_ap_infos_);
+        scan_ap_infos_updated_callback_(ap_infos);
     }
 
     return true;
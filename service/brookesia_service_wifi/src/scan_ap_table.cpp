@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cstdlib>
+#include <string_view>
+#include "brookesia/service_wifi/macro_configs.h"
+#if !defined(BROOKESIA_SERVICE_WIFI_SERVICE_ENABLE_DEBUG_LOG)
+#   define BROOKESIA_LOG_DISABLE_DEBUG_TRACE 1
+#endif
+#include "private/utils.hpp"
+#include "brookesia/service_wifi/scan_ap_table.hpp"
+
+namespace esp_brookesia::service::wifi {
+
+bool ScanApTable::update(const std::vector<ApInfo> &ap_infos, Delta &delta)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    delta = Delta();
+
+    boost::lock_guard lock(mutex_);
+
+    for (auto &[key, entry] : entries_) {
+        entry.missed_scans++;
+    }
+
+    // Keep the strongest report of each AP, the results may not be sorted
+    std::map<std::string_view, const ApInfo *> scanned;
+    for (const auto &ap_info : ap_infos) {
+        if (ap_info.ssid.empty()) {
+            continue;
+        }
+        auto [it, is_inserted] = scanned.try_emplace(get_key(ap_info), &ap_info);
+        if (!is_inserted && (ap_info.rssi > it->second->rssi)) {
+            it->second = &ap_info;
+        }
+    }
+
+    for (const auto &[key, ap_info] : scanned) {
+        auto it = entries_.find(key);
+        if (it == entries_.end()) {
+            entries_.emplace(key, Entry{*ap_info, 0});
+            delta.added.push_back(*ap_info);
+            continue;
+        }
+        auto &entry = it->second;
+        entry.missed_scans = 0;
+
+        if ((ap_info->is_locked != entry.info.is_locked) ||
+                (std::abs(ap_info->rssi - entry.info.rssi) >= rssi_hysteresis_)) {
+            entry.info = *ap_info;
+            delta.changed.push_back(*ap_info);
+        }
+    }
+
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (it->second.missed_scans >= missed_scans_to_remove_) {
+            delta.removed.push_back(it->first);
+            it = entries_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (delta.empty()) {
+        delta.sequence = sequence_;
+        return false;
+    }
+
+    delta.sequence = ++sequence_;
+    BROOKESIA_LOGD(
+        "Delta %1%: added(%2%), changed(%3%), removed(%4%)", delta.sequence, delta.added.size(), delta.changed.size(),
+        delta.removed.size()
+    );
+
+    return true;
+}
+
+bool ScanApTable::clear(Delta &delta)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    delta = Delta();
+
+    boost::lock_guard lock(mutex_);
+
+    if (entries_.empty()) {
+        delta.sequence = sequence_;
+        return false;
+    }
+
+    delta.removed.reserve(entries_.size());
+    for (const auto &[key, entry] : entries_) {
+        delta.removed.push_back(key);
+    }
+    entries_.clear();
+    delta.sequence = ++sequence_;
+
+    return true;
+}
+
+uint32_t ScanApTable::get_snapshot(std::vector<ApInfo> &ap_infos) const
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    ap_infos.clear();
+
+    boost::lock_guard lock(mutex_);
+
+    ap_infos.reserve(entries_.size());
+    for (const auto &[key, entry] : entries_) {
+        ap_infos.push_back(entry.info);
+    }
+    std::stable_sort(ap_infos.begin(), ap_infos.end(), [](const ApInfo & a, const ApInfo & b) {
+        return a.rssi > b.rssi;
+    });
+
+    return sequence_;
+}
+
+} // namespace esp_brookesia::service::wifi
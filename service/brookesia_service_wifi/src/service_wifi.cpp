@@ -23,7 +23,17 @@ constexpr const char *NVS_SCAN_PARAMS_OBJECT_KEY = "scan_params";
 constexpr uint32_t NVS_CALL_TIMEOUT_MS = 100;
 
 static auto &service_manager = ServiceManager::get_instance();
-static const FunctionSchema *NVS_FUNCTION_DEFINITIONS = helper::NVS::get_function_definitions();
+
+bool Wifi::set_driver(std::shared_ptr<Driver> driver)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_CHECK_FALSE_RETURN(!is_initialized(), false, "Cannot set driver after initialization");
+
+    driver_ = std::move(driver);
+
+    return true;
+}
 
 bool Wifi::on_init()
 {
@@ -32,8 +42,20 @@ bool Wifi::on_init()
     task_scheduler_ = get_task_scheduler();
 
     /* Create and initialize wifi context */
+    std::shared_ptr<Driver> driver = driver_;
+    if (!driver) {
+#if defined(ESP_PLATFORM)
+        BROOKESIA_CHECK_EXCEPTION_RETURN(
+            driver = std::make_shared<EspDriver>(), false, "Failed to create ESP driver"
+        );
+#else
+        BROOKESIA_CHECK_EXCEPTION_RETURN(
+            driver = std::make_shared<SimulatedDriver>(), false, "Failed to create simulated driver"
+        );
+#endif
+    }
     BROOKESIA_CHECK_EXCEPTION_RETURN(
-        hal_ = std::make_shared<Hal>(task_scheduler_), false, "Failed to create Hal"
+        hal_ = std::make_shared<Hal>(task_scheduler_, std::move(driver)), false, "Failed to create Hal"
     );
     BROOKESIA_CHECK_FALSE_RETURN(hal_->init(), false, "Failed to initialize wifi context");
     /* Register wifi general event callback */
@@ -201,6 +223,14 @@ bool Wifi::on_init()
             });
         }
 
+        /* The scanned APs are stale once the radio is stopped */
+        if (event == GeneralEvent::Stopped) {
+            ScanApTable::Delta delta;
+            if (scan_ap_table_.clear(delta)) {
+                publish_scan_ap_infos(delta);
+            }
+        }
+
         /* Publish general event happened event */
         if (hal_->is_general_event_changed(event, old_flags, new_flags)) {
             BROOKESIA_CHECK_FALSE_EXECUTE(publish_event(EVENT_DEFINITIONS[Helper::EventIndexGeneralEventHappened].name, {
@@ -228,17 +258,18 @@ bool Wifi::on_init()
     };
     hal_->register_general_action_callback(std::move(general_action_callback));
     /* Register scan AP infos updated callback */
-    auto scan_ap_infos_updated_callback = [this](const boost::json::array & ap_infos) {
+    auto scan_ap_infos_updated_callback = [this](const std::vector<ApInfo> & ap_infos) {
         BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
-        BROOKESIA_LOGD("Params: ap_infos(%1%)", boost::json::serialize(ap_infos));
+        BROOKESIA_LOGD("Params: ap_infos(%1%)", BROOKESIA_DESCRIBE_TO_STR(ap_infos));
 
-        /* Publish scan infos updated event */
-        BROOKESIA_CHECK_FALSE_EXECUTE(publish_event(EVENT_DEFINITIONS[Helper::EventIndexScanApInfosUpdated].name, {
-            {ap_infos}
-        }), {}, {
-            BROOKESIA_LOGE("Failed to publish scan infos updated event");
-        });
+        /* Publish the changes of the scanned APs, if any */
+        ScanApTable::Delta delta;
+        if (scan_ap_table_.update(ap_infos, delta)) {
+            publish_scan_ap_infos(delta);
+        } else {
+            BROOKESIA_LOGD("Scanned APs are not changed, skip publish");
+        }
 
         /* Check if connected AP appeared in the scan infos */
         // If already connecting or connected, skip
@@ -249,15 +280,7 @@ bool Wifi::on_init()
         // Find first connectable AP in scan infos
         bool is_connectable = false;
         for (const auto &record : ap_infos) {
-            if (!record.is_object()) {
-                continue;
-            }
-            const auto &obj = record.as_object();
-            auto ssid_it = obj.find("ssid");
-            if (ssid_it == obj.end() || !ssid_it->value().is_string()) {
-                continue;
-            }
-            std::string ssid = std::string(ssid_it->value().as_string());
+            const auto &ssid = record.ssid;
 
             // Get connectable AP info
             ConnectApInfo ap_info;
@@ -311,6 +334,9 @@ void Wifi::on_deinit()
     state_machine_.reset();
     hal_.reset();
     task_scheduler_.reset();
+
+    ScanApTable::Delta delta;
+    scan_ap_table_.clear(delta);
 }
 
 bool Wifi::on_start()
@@ -458,6 +484,43 @@ std::expected<boost::json::array, std::string> Wifi::function_get_connected_aps(
     return array;
 }
 
+std::expected<boost::json::object, std::string> Wifi::function_get_scan_ap_infos()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    std::vector<ApInfo> ap_infos;
+    auto sequence = scan_ap_table_.get_snapshot(ap_infos);
+
+    return boost::json::object{
+        {"sequence", sequence},
+        {"ap_infos", std::move(BROOKESIA_DESCRIBE_TO_JSON(ap_infos).as_array())},
+    };
+}
+
+void Wifi::publish_scan_ap_infos(const ScanApTable::Delta &delta)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_CHECK_FALSE_EXECUTE(publish_event(EVENT_DEFINITIONS[Helper::EventIndexScanApInfosChanged].name, {
+        static_cast<double>(delta.sequence),
+        std::move(BROOKESIA_DESCRIBE_TO_JSON(delta.added).as_array()),
+        std::move(BROOKESIA_DESCRIBE_TO_JSON(delta.changed).as_array()),
+        std::move(BROOKESIA_DESCRIBE_TO_JSON(delta.removed).as_array()),
+    }), {}, {
+        BROOKESIA_LOGE("Failed to publish scan infos changed event");
+    });
+
+#if BROOKESIA_SERVICE_WIFI_SCAN_PUBLISH_FULL_AP_INFOS
+    std::vector<ApInfo> ap_infos;
+    scan_ap_table_.get_snapshot(ap_infos);
+    BROOKESIA_CHECK_FALSE_EXECUTE(publish_event(EVENT_DEFINITIONS[Helper::EventIndexScanApInfosUpdated].name, {
+        std::move(BROOKESIA_DESCRIBE_TO_JSON(ap_infos).as_array())
+    }), {}, {
+        BROOKESIA_LOGE("Failed to publish scan infos updated event");
+    });
+#endif
+}
+
 std::string Wifi::get_target_event_state(GeneralEvent event)
 {
     switch (event) {
@@ -498,49 +561,51 @@ void Wifi::try_load_from_nvs()
     auto nvs = binding.get_service();
     BROOKESIA_CHECK_NULL_EXIT(nvs, "Failed to get NVS service");
 
-    auto result = nvs->call_function_sync(NVS_FUNCTION_DEFINITIONS[helper::NVS::FunctionIndexGet].name,
-    FunctionParameterMap{
-        {NVS_FUNCTION_DEFINITIONS[helper::NVS::FunctionIndexGet].parameters[0].name, NVS_NAMESPACE}
-    }, NVS_CALL_TIMEOUT_MS);
-    if (!result.success) {
-        BROOKESIA_LOGW("Failed to get NVS data: %1%", result.error_message);
+    auto result = helper::NVS::get.call_sync(*nvs, NVS_CALL_TIMEOUT_MS, NVS_NAMESPACE, {});
+    if (!result) {
+        BROOKESIA_LOGW("Failed to get NVS data: %1%", result.error());
         return;
     }
 
-    auto data_obj = std::get_if<boost::json::object>(&result.data.value());
-    BROOKESIA_CHECK_NULL_EXIT(data_obj, "Invalid NVS data");
+    auto &entries = result.value();
+    // The data are stored as serialized JSON strings
+    auto get_string_value = [&](const char *key) -> const std::string * {
+        auto it = entries.find(key);
+        if (it == entries.end()) {
+            return nullptr;
+        }
+        return std::get_if<std::string>(&it->second);
+    };
 
     auto load_last_connected_ap_info = [&]() {
-        if (!data_obj->contains(NVS_LAST_CONNECTED_AP_INFO_OBJECT_KEY)) {
+        if (!entries.contains(NVS_LAST_CONNECTED_AP_INFO_OBJECT_KEY)) {
             return;
         }
 
-        auto value_json = data_obj->at(NVS_LAST_CONNECTED_AP_INFO_OBJECT_KEY);
-        BROOKESIA_CHECK_FALSE_EXIT(value_json.is_string(), "Invalid last connected AP info");
+        auto value_str = get_string_value(NVS_LAST_CONNECTED_AP_INFO_OBJECT_KEY);
+        BROOKESIA_CHECK_NULL_EXIT(value_str, "Invalid last connected AP info");
 
-        auto value_str = std::string(value_json.as_string());
         ConnectApInfo ap_info;
         BROOKESIA_CHECK_FALSE_EXIT(
-            BROOKESIA_DESCRIBE_JSON_DESERIALIZE(value_str, ap_info),
-            "Failed to deserialize last connected AP info from: %1%", value_str
+            BROOKESIA_DESCRIBE_JSON_DESERIALIZE(*value_str, ap_info),
+            "Failed to deserialize last connected AP info from: %1%", *value_str
         );
 
         hal_->set_target_connect_ap_info(ap_info);
         hal_->set_last_connected_ap_info(ap_info);
     };
     auto load_connected_ap_info_list = [&]() {
-        if (!data_obj->contains(NVS_CONNECTED_AP_INFO_LIST_ARRAY_KEY)) {
+        if (!entries.contains(NVS_CONNECTED_AP_INFO_LIST_ARRAY_KEY)) {
             return;
         }
 
-        auto value_json = data_obj->at(NVS_CONNECTED_AP_INFO_LIST_ARRAY_KEY);
-        BROOKESIA_CHECK_FALSE_EXIT(value_json.is_string(), "Invalid connected AP info list");
+        auto value_str = get_string_value(NVS_CONNECTED_AP_INFO_LIST_ARRAY_KEY);
+        BROOKESIA_CHECK_NULL_EXIT(value_str, "Invalid connected AP info list");
 
-        auto value_str = std::string(value_json.as_string());
         std::vector<ConnectApInfo> ap_infos;
         BROOKESIA_CHECK_FALSE_EXIT(
-            BROOKESIA_DESCRIBE_JSON_DESERIALIZE(value_str, ap_infos),
-            "Failed to deserialize connected AP info list from: %1%", value_str
+            BROOKESIA_DESCRIBE_JSON_DESERIALIZE(*value_str, ap_infos),
+            "Failed to deserialize connected AP info list from: %1%", *value_str
         );
 
         for (const auto &ap_info : ap_infos) {
@@ -548,18 +613,17 @@ void Wifi::try_load_from_nvs()
         }
     };
     auto load_scan_params = [&]() {
-        if (!data_obj->contains(NVS_SCAN_PARAMS_OBJECT_KEY)) {
+        if (!entries.contains(NVS_SCAN_PARAMS_OBJECT_KEY)) {
             return;
         }
 
-        auto value_json = data_obj->at(NVS_SCAN_PARAMS_OBJECT_KEY);
-        BROOKESIA_CHECK_FALSE_EXIT(value_json.is_string(), "Invalid scan params");
+        auto value_str = get_string_value(NVS_SCAN_PARAMS_OBJECT_KEY);
+        BROOKESIA_CHECK_NULL_EXIT(value_str, "Invalid scan params");
 
-        auto value_str = std::string(value_json.as_string());
         ScanParams params;
         BROOKESIA_CHECK_FALSE_EXIT(
-            BROOKESIA_DESCRIBE_JSON_DESERIALIZE(value_str, params),
-            "Failed to deserialize scan params from: %1%", value_str
+            BROOKESIA_DESCRIBE_JSON_DESERIALIZE(*value_str, params),
+            "Failed to deserialize scan params from: %1%", *value_str
         );
 
         hal_->set_scan_params(params);
@@ -581,15 +645,10 @@ static bool save_data_to_nvs(const T &data, const char *key)
     auto nvs = binding.get_service();
     BROOKESIA_CHECK_NULL_RETURN(nvs, false, "Failed to get NVS service");
 
-    boost::json::object data_object{{key, std::move(BROOKESIA_DESCRIBE_JSON_SERIALIZE(data))}};
-    auto result = nvs->call_function_sync(NVS_FUNCTION_DEFINITIONS[helper::NVS::FunctionIndexSet].name,
-    FunctionParameterMap{
-        {NVS_FUNCTION_DEFINITIONS[helper::NVS::FunctionIndexSet].parameters[0].name, NVS_NAMESPACE},
-        {NVS_FUNCTION_DEFINITIONS[helper::NVS::FunctionIndexSet].parameters[1].name, std::move(data_object)}
-    }, NVS_CALL_TIMEOUT_MS);
-    BROOKESIA_CHECK_FALSE_RETURN(
-        result.success, false, "Failed to save %1% to NVS: %2%", key, result.error_message
-    );
+    auto result = helper::NVS::set.call_sync(
+                      *nvs, NVS_CALL_TIMEOUT_MS, NVS_NAMESPACE, {{key, BROOKESIA_DESCRIBE_JSON_SERIALIZE(data)}}
+                  );
+    BROOKESIA_CHECK_FALSE_RETURN(result.has_value(), false, "Failed to save %1% to NVS: %2%", key, result.error());
 
     return true;
 }
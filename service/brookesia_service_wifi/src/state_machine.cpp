@@ -217,6 +217,17 @@ bool StateMachine::init()
         ), false, "Failed to add transition: Connected -> Connect -> Connected"
     );
 
+    // Resolve the actions once, so that triggering one is a plain table lookup
+    BROOKESIA_CHECK_FALSE_RETURN(state_machine_->compile(), false, "Failed to compile state machine");
+    for (size_t i = 0; i < action_ids_.size(); i++) {
+        auto action = static_cast<GeneralAction>(i);
+        action_ids_[i] = state_machine_->get_action_id(BROOKESIA_DESCRIBE_TO_STR(action));
+        BROOKESIA_CHECK_FALSE_RETURN(
+            action_ids_[i] != lib_utils::StateMachine::INVALID_ID, false, "Action %1% has no transition",
+            BROOKESIA_DESCRIBE_TO_STR(action)
+        );
+    }
+
     deinit_guard.release();
 
     BROOKESIA_LOGI("State machine initialized");
@@ -332,7 +343,7 @@ bool StateMachine::trigger_general_action(GeneralAction action, bool use_dispatc
 
     // Trigger target action
     BROOKESIA_CHECK_FALSE_RETURN(
-        state_machine_->trigger_action(BROOKESIA_DESCRIBE_TO_STR(action), use_dispatch), false,
+        state_machine_->trigger_action(action_ids_[static_cast<size_t>(action)], use_dispatch), false,
         "Failed to trigger target action: %1%", BROOKESIA_DESCRIBE_TO_STR(action)
     );
 
@@ -6,6 +6,7 @@
 #include "unity.h"
 #include "boost/json.hpp"
 #include "boost/thread.hpp"
+#include <algorithm>
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
@@ -1430,6 +1431,169 @@ TEST_CASE("Test ServiceWifi - repeatedly switch between TEST_WIFI_SSID1 and TEST
 #endif // defined(TEST_WIFI_SSID2) && defined(TEST_WIFI_PASSWORD2)
 #endif // defined(TEST_WIFI_SSID1) && defined(TEST_WIFI_PASSWORD1)
 
+// ==================== Simulated Driver Tests ====================
+
+// The service stays initialized on ESP32-P4 after `shutdown()`, so that the driver cannot be replaced
+#if !defined(CONFIG_IDF_TARGET_ESP32P4)
+TEST_CASE("Test ServiceWifi - simulated driver: scan, connect and reconnect after drops", "[service][wifi][simulated]")
+{
+    BROOKESIA_TIME_PROFILER_SCOPE("test_service_wifi_simulated");
+    BROOKESIA_LOGI("=== Test ServiceWifi - simulated driver: scan, connect and reconnect after drops ===");
+
+    constexpr const char *SIM_SSID = "sim_ap";
+    constexpr const char *SIM_PASSWORD = "sim_password";
+    constexpr uint32_t SIM_DROP_COUNT = 3;
+
+    service::wifi::SimulatedDriver::Script script;
+    script.aps = {
+        {.ssid = SIM_SSID, .password = SIM_PASSWORD, .rssi = -40, .rssi_drift = 5},
+        {.ssid = "sim_open_ap", .rssi = -70, .rssi_drift = 5},
+    };
+    script.scan_duration_ms = 500;
+    script.connect_latency_ms = 300;
+    // Dropped well after the connection, then once per second
+    script.disconnect_storms.push_back({.start_ms = 4000, .count = SIM_DROP_COUNT, .interval_ms = 1000});
+    auto driver = std::make_shared<service::wifi::SimulatedDriver>(script);
+
+    auto &wifi_service = service::wifi::Wifi::get_instance();
+    TEST_ASSERT_TRUE_MESSAGE(wifi_service.set_driver(driver), "Failed to set simulated driver");
+    lib_utils::FunctionGuard driver_guard([&wifi_service]() {
+        wifi_service.set_driver(nullptr);
+    });
+
+    BROOKESIA_CHECK_FALSE_RETURN(startup(),, "Failed to startup");
+    lib_utils::FunctionGuard shutdown_guard([]() {
+        shutdown();
+    });
+
+    // Setup event subscriptions
+    EventCollector collector;
+    auto connections = setup_event_subscriptions(wifi_binding, collector);
+
+    service::LocalTestRunner runner;
+    std::vector<service::LocalTestItem> test_items = {
+        service::LocalTestItem{
+            .name = "Start scan",
+            .method = wifi_functions[wifi_helper::FunctionIndexTriggerScanStart].name,
+        },
+        service::LocalTestItem{
+            .name = "Set connect AP to simulated AP",
+            .method = wifi_functions[wifi_helper::FunctionIndexSetConnectAp].name,
+            .params = boost::json::object{
+                {wifi_functions[wifi_helper::FunctionIndexSetConnectAp].parameters[0].name, SIM_SSID},
+                {wifi_functions[wifi_helper::FunctionIndexSetConnectAp].parameters[1].name, SIM_PASSWORD}
+            }
+        },
+        service::LocalTestItem{
+            .name = "Trigger connect action",
+            .method = wifi_functions[wifi_helper::FunctionIndexTriggerGeneralAction].name,
+            .params = boost::json::object{{
+                    wifi_functions[wifi_helper::FunctionIndexTriggerGeneralAction].parameters[0].name,
+                    BROOKESIA_DESCRIBE_TO_STR(wifi_helper::GeneralAction::Connect)
+                }},
+            .run_duration_ms = TEST_WIFI_CONNECT_DURATION_MS
+        },
+    };
+    TEST_ASSERT_TRUE_MESSAGE(runner.run_tests(wifi_helper::SERVICE_NAME, test_items), "Failed to connect");
+
+    // Both APs are scanned, the strongest first
+    TEST_ASSERT_TRUE_MESSAGE(collector.wait_for_scan_ap_infos_updated(1, TEST_WIFI_SCAN_DURATION_MS), "No scan result");
+    {
+        std::lock_guard<std::mutex> lock(collector.mutex);
+        const auto &ap_infos = collector.scan_ap_infos_updated.front().ap_infos;
+        TEST_ASSERT_EQUAL(2, ap_infos.size());
+        TEST_ASSERT_EQUAL_STRING(SIM_SSID, ap_infos[0].ssid.c_str());
+        TEST_ASSERT_TRUE(ap_infos[0].is_locked);
+        TEST_ASSERT_FALSE(ap_infos[1].is_locked);
+    }
+
+    // Each drop of the storm must be followed by an automatic reconnection
+    auto count_events = [&collector](const std::string & event) {
+        std::lock_guard<std::mutex> lock(collector.mutex);
+        return std::count_if(collector.general_events.begin(), collector.general_events.end(), [&](const auto & evt) {
+            return evt.event == event;
+        });
+    };
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(
+                        4000 + SIM_DROP_COUNT * 1000 + TEST_WIFI_CONNECT_DURATION_MS
+                    );
+    while ((count_events("Connected") < static_cast<long>(SIM_DROP_COUNT + 1)) &&
+            (std::chrono::steady_clock::now() < deadline)) {
+        boost::this_thread::sleep_for(boost::chrono::milliseconds(100));
+    }
+
+    auto statistics = driver->get_statistics();
+    BROOKESIA_LOGI(
+        "Simulated driver: %u drops, %u connection attempts, %u scans", statistics.link_drop_count,
+        statistics.connect_count, statistics.scan_count
+    );
+    TEST_ASSERT_EQUAL(SIM_DROP_COUNT, statistics.link_drop_count);
+    TEST_ASSERT_EQUAL(SIM_DROP_COUNT + 1, count_events("Connected"));
+    TEST_ASSERT_EQUAL(SIM_DROP_COUNT, count_events("Disconnected"));
+
+    // Connections will be automatically disconnected when they go out of scope
+}
+#endif // !defined(CONFIG_IDF_TARGET_ESP32P4)
+
+TEST_CASE("Test ServiceWifi - scan AP table deltas", "[service][wifi][scan][delta]")
+{
+    BROOKESIA_LOGI("=== Test ServiceWifi - scan AP table deltas ===");
+
+    using ApInfo = wifi_helper::ApInfo;
+    service::wifi::ScanApTable table(5, 2);
+    service::wifi::ScanApTable::Delta delta;
+    const std::string bssid1 = "aa:bb:cc:dd:ee:01";
+    const std::string bssid2 = "aa:bb:cc:dd:ee:02";
+    const std::string bssid3 = "aa:bb:cc:dd:ee:03";
+
+    // Hidden APs are ignored, the APs of a SSID are kept apart, and the strongest report of an AP is kept whatever
+    // the order of the results
+    TEST_ASSERT_TRUE(table.update({ApInfo("ap1", true, -70, bssid1), ApInfo("ap2", false, -60, bssid2),
+                                   ApInfo("ap1", true, -40, bssid1), ApInfo("ap1", true, -65, bssid3),
+                                   ApInfo("", false, -30, "aa:bb:cc:dd:ee:04")}, delta));
+    TEST_ASSERT_EQUAL(1, delta.sequence);
+    TEST_ASSERT_EQUAL(3, delta.added.size());
+    for (const auto &ap_info : delta.added) {
+        if (ap_info.bssid == bssid1) {
+            TEST_ASSERT_EQUAL(-40, ap_info.rssi);
+        }
+    }
+
+    // Within the hysteresis, nothing is reported
+    TEST_ASSERT_FALSE(table.update({ApInfo("ap1", true, -43, bssid1), ApInfo("ap2", false, -56, bssid2),
+                                    ApInfo("ap1", true, -65, bssid3)}, delta));
+    TEST_ASSERT_EQUAL(1, delta.sequence);
+
+    TEST_ASSERT_TRUE(table.update({ApInfo("ap1", true, -45, bssid1), ApInfo("ap2", false, -56, bssid2),
+                                   ApInfo("ap1", true, -65, bssid3)}, delta));
+    TEST_ASSERT_EQUAL(2, delta.sequence);
+    TEST_ASSERT_EQUAL(1, delta.changed.size());
+    TEST_ASSERT_EQUAL(-45, delta.changed[0].rssi);
+
+    // Removed after two scans without it, by BSSID
+    TEST_ASSERT_FALSE(table.update({ApInfo("ap1", true, -45, bssid1), ApInfo("ap1", true, -65, bssid3)}, delta));
+    TEST_ASSERT_TRUE(table.update({ApInfo("ap1", true, -45, bssid1), ApInfo("ap1", true, -65, bssid3)}, delta));
+    TEST_ASSERT_EQUAL(1, delta.removed.size());
+    TEST_ASSERT_EQUAL_STRING(bssid2.c_str(), delta.removed[0].c_str());
+
+    // The APs without BSSID are keyed by SSID
+    TEST_ASSERT_TRUE(table.update({ApInfo("ap1", true, -45, bssid1), ApInfo("ap1", true, -65, bssid3),
+                                   ApInfo("ap5", false, -80), ApInfo("ap5", false, -50)}, delta));
+    TEST_ASSERT_EQUAL(1, delta.added.size());
+    TEST_ASSERT_EQUAL(-50, delta.added[0].rssi);
+    TEST_ASSERT_EQUAL_STRING("ap5", service::wifi::ScanApTable::get_key(delta.added[0]).c_str());
+
+    std::vector<ApInfo> snapshot;
+    TEST_ASSERT_EQUAL(4, table.get_snapshot(snapshot));
+    TEST_ASSERT_EQUAL(3, snapshot.size());
+    TEST_ASSERT_EQUAL(-45, snapshot[0].rssi);
+
+    TEST_ASSERT_TRUE(table.clear(delta));
+    TEST_ASSERT_EQUAL(5, delta.sequence);
+    TEST_ASSERT_EQUAL(3, delta.removed.size());
+    TEST_ASSERT_FALSE(table.clear(delta));
+}
+
 // ==================== Error Handling Tests ====================
 
 TEST_CASE("Test ServiceWifi - error handling: invalid parameters", "[service][wifi][error][invalid_params]")
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "lib_utils/macro_configs.h"
+#include "lib_utils/alloc_tracker.hpp"
 #include "lib_utils/check.hpp"
 #include "lib_utils/describe_helpers.hpp"
 #include "lib_utils/function_guard.hpp"
@@ -18,3 +19,4 @@
 #include "lib_utils/thread_config.hpp"
 #include "lib_utils/thread_profiler.hpp"
 #include "lib_utils/time_profiler.hpp"
+#include "lib_utils/timing_wheel.hpp"
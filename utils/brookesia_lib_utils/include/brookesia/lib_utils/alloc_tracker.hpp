@@ -0,0 +1,181 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "brookesia/lib_utils/macro_configs.h"
+#include "brookesia/lib_utils/describe_helpers.hpp"
+
+namespace esp_brookesia::lib_utils {
+
+/**
+ * @brief Heap allocation tracker for the host build
+ *
+ * When `BROOKESIA_UTILS_ALLOC_TRACKER_AVAILABLE` is set, `malloc()`, `calloc()`, `realloc()`, `free()`, the aligned
+ * variants and the global `operator new` are interposed, and every allocation is attributed to a site:
+ * - the `TaskScheduler` group of the task being executed (or any tag set with `ScopedTag`);
+ * - otherwise the return address of the caller of `malloc()` / `operator new`.
+ *
+ * The tracker never allocates from the heap while recording, its tables are mapped once with `mmap()`. On other
+ * platforms all the APIs are no-ops and return false.
+ */
+class AllocTracker {
+public:
+    // Longest tag of a site, including the terminating null character, longer tags are truncated
+    static constexpr size_t TAG_SIZE_MAX = 32;
+
+    /**
+     * @brief How an allocation site is identified
+     */
+    enum class SiteType {
+        CallSite,       // Return address of the allocating code
+        Tag,            // Tag of the current thread, e.g. the `TaskScheduler` group
+        Overflow,       // All sites which do not fit in the site table
+    };
+
+    /**
+     * @brief Counters of an allocation site
+     */
+    struct SiteInfo {
+        SiteType type = SiteType::CallSite;
+        std::string name;           // Tag, or symbolized call site (`function+0xoffset` or `module+0xoffset`)
+        uintptr_t address = 0;      // Call site address (0 if not a call site)
+        size_t alloc_count = 0;     // Allocations since the last reset
+        size_t free_count = 0;      // Frees since the last reset
+        size_t alloc_bytes = 0;     // Bytes allocated since the last reset
+        size_t live_count = 0;      // Allocations still alive (for a leak report: alive and made after `mark()`)
+        size_t live_bytes = 0;      // Bytes still alive (for a leak report: alive and made after `mark()`)
+        size_t peak_live_bytes = 0; // Peak of `live_bytes` since the last reset
+    };
+
+    /**
+     * @brief Totals of all sites
+     */
+    struct Summary {
+        size_t alloc_count = 0;     // Allocations since the last reset
+        size_t free_count = 0;      // Frees since the last reset
+        size_t alloc_bytes = 0;     // Bytes allocated since the last reset
+        size_t live_count = 0;      // Allocations currently alive
+        size_t live_bytes = 0;      // Bytes currently alive
+        size_t peak_live_bytes = 0; // Peak of `live_bytes` since the last reset
+        size_t untracked_count = 0; // Allocations not recorded because the live table was full
+    };
+
+    /**
+     * @brief Report of the busiest sites
+     */
+    struct Report {
+        Summary summary;
+        std::vector<SiteInfo> sites;
+    };
+
+    /**
+     * @brief RAII helper attributing the allocations of the current thread to a tag
+     *
+     * @note `TaskScheduler` uses it to tag the allocations of a task with its group. Nested tags restore the
+     *       previous one when destroyed. An empty tag keeps the current one.
+     * @note The tag is copied (truncated to `TAG_SIZE_MAX - 1` characters), it may be a temporary
+     */
+    class ScopedTag {
+    public:
+#if BROOKESIA_UTILS_ALLOC_TRACKER_AVAILABLE
+        explicit ScopedTag(std::string_view tag);
+        ~ScopedTag();
+#else
+        explicit ScopedTag(std::string_view) {}
+#endif
+
+        ScopedTag(const ScopedTag &) = delete;
+        ScopedTag &operator=(const ScopedTag &) = delete;
+
+#if BROOKESIA_UTILS_ALLOC_TRACKER_AVAILABLE
+    private:
+        char tag_[TAG_SIZE_MAX] = {};
+        const char *prev_tag_ = nullptr;
+        bool is_set_ = false;
+#endif
+    };
+
+    AllocTracker() = delete;
+
+    /**
+     * @brief Check if the allocations are tracked in this build
+     *
+     * @return true if available, false otherwise
+     */
+    static bool is_available()
+    {
+        return BROOKESIA_UTILS_ALLOC_TRACKER_AVAILABLE;
+    }
+
+    /**
+     * @brief Get the totals of all sites
+     *
+     * @param[out] summary Output totals
+     * @return true on success, false if the tracker is not available
+     */
+    static bool get_summary(Summary &summary);
+
+    /**
+     * @brief Get the sites with the most allocations since the last reset
+     *
+     * @param[out] report Output report, sites are sorted by `alloc_count` (descending)
+     * @param[in] max_sites Maximum number of sites in the report (0 = all)
+     * @return true on success, false if the tracker is not available
+     */
+    static bool get_churn_report(Report &report, size_t max_sites = 10);
+
+    /**
+     * @brief Get the sites holding allocations made after the last `mark()` and not freed yet
+     *
+     * @param[out] report Output report, sites are sorted by `live_bytes` (descending)
+     * @param[in] max_sites Maximum number of sites in the report (0 = all)
+     * @return true on success, false if the tracker is not available
+     */
+    static bool get_leak_report(Report &report, size_t max_sites = 10);
+
+    /**
+     * @brief Start a new leak detection window, the allocations alive at this point are not reported as leaks
+     */
+    static void mark();
+
+    /**
+     * @brief Reset the churn counters and peaks of all sites, live allocations are kept
+     */
+    static void reset();
+
+    /**
+     * @brief Print the churn report to log in formatted table
+     *
+     * @param max_sites Maximum number of sites to print (0 = all)
+     */
+    static void print_churn_report(size_t max_sites = 10);
+
+    /**
+     * @brief Print the leak report to log in formatted table
+     *
+     * @param max_sites Maximum number of sites to print (0 = all)
+     */
+    static void print_leak_report(size_t max_sites = 10);
+};
+
+BROOKESIA_DESCRIBE_ENUM(AllocTracker::SiteType, CallSite, Tag, Overflow)
+BROOKESIA_DESCRIBE_STRUCT(
+    AllocTracker::SiteInfo, (), (
+        type, name, address, alloc_count, free_count, alloc_bytes, live_count, live_bytes, peak_live_bytes
+    )
+)
+BROOKESIA_DESCRIBE_STRUCT(
+    AllocTracker::Summary, (), (
+        alloc_count, free_count, alloc_bytes, live_count, live_bytes, peak_live_bytes, untracked_count
+    )
+)
+
+} // namespace esp_brookesia::lib_utils
@@ -185,6 +185,34 @@
 #if defined(ESP_PLATFORM) && defined(CONFIG_FREERTOS_VTASKLIST_INCLUDE_COREID) && \
     defined(CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS)
 #   define BROOKESIA_UTILS_THREAD_PROFILER_AVAILABLE (1)
+#elif !defined(ESP_PLATFORM) && defined(__linux__)
+// Threads are sampled from `/proc/self/task` on the host
+#   define BROOKESIA_UTILS_THREAD_PROFILER_AVAILABLE (1)
 #else
 #   define BROOKESIA_UTILS_THREAD_PROFILER_AVAILABLE (0)
 #endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////// Memory Profiler ////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Heap size reported by the memory profiler on the host (bytes), useful to emulate the RAM of a device when
+ *        load testing. If it is 0, the memory available to the process is used instead.
+ */
+#if !defined(BROOKESIA_UTILS_MEMORY_PROFILER_HOST_HEAP_SIZE)
+#   define BROOKESIA_UTILS_MEMORY_PROFILER_HOST_HEAP_SIZE (0)
+#endif
+
+/**
+ * @brief Allocation tracker, which interposes `malloc()` and `operator new` on the host (Linux + glibc only).
+ *        Enabled by the `BROOKESIA_UTILS_ENABLE_ALLOC_TRACKER` CMake option (OFF by default).
+ */
+#if !defined(BROOKESIA_UTILS_ALLOC_TRACKER_ENABLE)
+#   define BROOKESIA_UTILS_ALLOC_TRACKER_ENABLE (0)
+#endif
+
+#if BROOKESIA_UTILS_ALLOC_TRACKER_ENABLE && !defined(ESP_PLATFORM) && defined(__linux__)
+#   define BROOKESIA_UTILS_ALLOC_TRACKER_AVAILABLE (1)
+#else
+#   define BROOKESIA_UTILS_ALLOC_TRACKER_AVAILABLE (0)
+#endif
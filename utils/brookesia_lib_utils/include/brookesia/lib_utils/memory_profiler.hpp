@@ -29,6 +29,9 @@ namespace esp_brookesia::lib_utils {
  * This class provides a C++ interface to monitor ESP32 heap memory usage,
  * including internal SRAM and external PSRAM. It integrates naturally with
  * TaskScheduler for periodic profiling.
+ *
+ * On the host, the heap of the process is reported as the internal memory (see
+ * `BROOKESIA_UTILS_MEMORY_PROFILER_HOST_HEAP_SIZE`), and `AllocTracker` gives the per site details.
  */
 class MemoryProfiler {
 public:
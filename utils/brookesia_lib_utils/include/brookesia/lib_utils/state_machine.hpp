@@ -10,6 +10,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 #include <cstdint>
 #include <boost/thread/mutex.hpp>
 
@@ -25,6 +26,7 @@ namespace esp_brookesia::lib_utils {
  * - Asynchronous state transitions via action queue
  * - Serial execution guarantee (no concurrent state transitions)
  * - Transition rollback on entry failure
+ * - Integer state/action IDs and a flat transition table, compiled at the latest by `start()` (see `compile()`)
  *
  * @note All state transitions are executed serially through the task scheduler's group mechanism,
  *       ensuring thread-safe operations even when actions are triggered from multiple threads.
@@ -38,7 +40,11 @@ public:
                                      void(const std::string &from, const std::string &action, const std::string &to)
                                      >;
 
+    using StateId = uint16_t;
+    using ActionId = uint16_t;
+
     static constexpr const char *DEFAULT_TASK_GROUP_NAME = "state_machine";
+    static constexpr uint16_t INVALID_ID = UINT16_MAX;
 
     explicit StateMachine(const std::string &group_name = DEFAULT_TASK_GROUP_NAME)
         : task_group_name_(group_name)
@@ -51,7 +57,7 @@ public:
      *
      * @param name Unique name for the state
      * @param state Shared pointer to the state object
-     * @return true if added successfully, false if state already exists
+     * @return true if added successfully, false if state already exists or if already compiled
      */
     bool add_state(const std::string &name, StatePtr state);
 
@@ -61,10 +67,51 @@ public:
      * @param from Source state name
      * @param action Action that triggers the transition
      * @param to Target state name
-     * @return true if added successfully, false if transition already exists
+     * @return true if added successfully, false if transition already exists or if already compiled
      */
     bool add_transition(const std::string &from, const std::string &action, const std::string &to);
 
+    /**
+     * @brief Compile the states and transitions into integer-indexed tables
+     *
+     * States and actions are interned to dense IDs (sorted by name) and the transitions become a flat
+     * `state x action` table, so a transition is resolved with one array access instead of string-keyed map
+     * lookups. The string APIs only resolve the names to the IDs, all the transitions run on the IDs.
+     *
+     * @return true on success, false if running or if a transition refers to a state which does not exist
+     *
+     * @note `start()` compiles the state machine if not done before, so calling it is only needed to get the IDs
+     *       before starting. Once compiled, no state or transition can be added.
+     */
+    bool compile();
+
+    /**
+     * @brief Check if the state machine is compiled
+     *
+     * @return true if compiled, false otherwise
+     */
+    bool is_compiled() const
+    {
+        boost::lock_guard lock(mutex_);
+        return is_compiled_;
+    }
+
+    /**
+     * @brief Get the ID of a state
+     *
+     * @param name State name
+     * @return State ID, `INVALID_ID` if not found or not compiled
+     */
+    StateId get_state_id(const std::string &name) const;
+
+    /**
+     * @brief Get the ID of an action
+     *
+     * @param action Action name
+     * @return Action ID, `INVALID_ID` if not found or not compiled
+     */
+    ActionId get_action_id(const std::string &action) const;
+
     /**
      * @brief Start the state machine with an initial state
      *
@@ -96,9 +143,21 @@ public:
      *
      * @note The actual transition happens asynchronously in the task scheduler's serial queue.
      *       This ensures thread-safe state transitions even when called from multiple threads.
+     * @note The name is resolved to its ID, then the action goes through `trigger_action(ActionId)`.
      */
     bool trigger_action(const std::string &action, bool use_dispatch = false);
 
+    /**
+     * @brief Trigger an action by ID to cause a state transition
+     *
+     * @param action Action ID, from `get_action_id()`
+     * @param use_dispatch Whether to use 'dispatch' to trigger the action, default is false
+     * @return true if action was queued successfully, false if not running or invalid ID
+     *
+     * @note The queued task only captures the ID, so nothing is copied or looked up by string.
+     */
+    bool trigger_action(ActionId action, bool use_dispatch = false);
+
     /**
      * @brief Wait for all transitions to finish within a timeout
      *
@@ -127,8 +186,9 @@ public:
      */
     void register_transition_finish_callback(TransitionFinishCallback callback)
     {
+        auto callback_ptr = callback ? std::make_shared<TransitionFinishCallback>(std::move(callback)) : nullptr;
         boost::lock_guard lock(mutex_);
-        transition_finish_callback_ = std::move(callback);
+        transition_finish_callback_ = std::move(callback_ptr);
     }
 
     /**
@@ -157,6 +217,17 @@ public:
         return current_state_;
     }
 
+    /**
+     * @brief Get the current state ID
+     *
+     * @return Current state ID (`INVALID_ID` if not running or not started)
+     */
+    StateId get_current_state_id() const
+    {
+        boost::lock_guard lock(mutex_);
+        return current_state_id_;
+    }
+
     /**
      * @brief Get the state pointer by name
      *
@@ -176,10 +247,10 @@ private:
     /**
      * @brief Setup periodic and timeout tasks for a state
      *
-     * @param name State name
+     * @param state State object
      * @return true on success, false on failure
      */
-    bool setup_state_tasks(const std::string &name);
+    bool setup_state_tasks(const StatePtr &state);
 
     /**
      * @brief Enter the initial state (called during start)
@@ -190,13 +261,27 @@ private:
     bool enter_initial_state(const std::string &name);
 
     /**
-     * @brief Perform state transition (called from trigger_action)
+     * @brief Run a queued action (called from trigger_action)
+     *
+     * @param action Action ID
+     */
+    void run_action(ActionId action);
+
+    /**
+     * @brief Perform state transition (called from run_action)
      *
-     * @param next Next state name
-     * @param action Action name that triggered the transition
+     * @param next Next state ID
+     * @param action Action ID that triggered the transition
      * @return true on success, false on failure (with rollback)
      */
-    bool transition_to(const std::string &next, const std::string &action = "");
+    bool transition_to(StateId next, ActionId action);
+
+    /**
+     * @brief Set the current state, must be called with the lock held
+     *
+     * @param id State ID (`INVALID_ID` when stopped)
+     */
+    void set_current_state(StateId id);
 
     /**
      * @brief Cancel current state's periodic and timeout tasks
@@ -213,8 +298,16 @@ private:
     std::map<std::string, std::map<std::string, std::string>> transitions_; // from_state -> (action -> to_state)
     std::string current_state_;                                             // Current active state name
 
-    // Callbacks
-    TransitionFinishCallback transition_finish_callback_;  // Called after successful transition
+    // Compiled tables, read-only once compiled (no lock needed to read them)
+    bool is_compiled_ = false;
+    std::vector<std::string> state_names_;      // StateId -> name (sorted)
+    std::vector<StatePtr> state_ptrs_;          // StateId -> state object
+    std::vector<std::string> action_names_;     // ActionId -> name (sorted)
+    std::vector<StateId> transition_table_;     // [from * action count + action] -> to (INVALID_ID if none)
+    StateId current_state_id_ = INVALID_ID;     // Current active state ID
+
+    // Callbacks, shared so that they can be invoked without copying the function object
+    std::shared_ptr<TransitionFinishCallback> transition_finish_callback_;  // Called after successful transition
 
     // Task scheduler integration
     std::shared_ptr<TaskScheduler> task_scheduler_;  // Scheduler for async operations (nullptr when stopped)
@@ -7,6 +7,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <deque>
 #include <functional>
 #include <future>
 #include <memory>
@@ -14,12 +15,14 @@
 #include <string>
 #include <string_view>
 #include <map>
+#include <tuple>
 #include <unordered_set>
 #include <vector>
 #include <boost/asio.hpp>
 #include <boost/thread.hpp>
 #include "brookesia/lib_utils/describe_helpers.hpp"
 #include "brookesia/lib_utils/thread_config.hpp"
+#include "brookesia/lib_utils/timing_wheel.hpp"
 
 namespace esp_brookesia::lib_utils {
 
@@ -43,19 +46,76 @@ public:
         Finished
     };
 
+    enum class TaskPriority {
+        Low,            // Background work, e.g. profiler sampling and storage flushes
+        Normal,
+        High,           // Latency sensitive work, e.g. state machine transitions behind UI feedback
+        Critical,
+    };
+
+    /**
+     * @brief Order in which the ready tasks are picked by the workers
+     */
+    enum class DispatchPolicy {
+        StrictPriority,         // Higher priority first, then earlier deadline, then FIFO
+        EarliestDeadlineFirst,  // Earlier deadline first (tasks without deadline last), then priority, then FIFO
+    };
+
+    /**
+     * @brief Timers of the delayed and periodic tasks
+     */
+    enum class TimerBackend {
+        Asio,           // One `boost::asio::steady_timer` per task
+        TimingWheel,    // One hierarchical timing wheel driven by a single timer, expirations batched per tick
+    };
+
+    struct TaskOptions {
+        TaskPriority priority = TaskPriority::Normal;
+        // Time in milliseconds from when the task becomes ready (posted, delay or interval elapsed) to when it should
+        // be finished, -1 for no deadline. A late task still runs, it is only counted as a deadline miss
+        int deadline_ms = -1;
+        // Delayed and periodic tasks only: time in milliseconds the task may start later than its delay or interval,
+        // so that it shares a wake-up with other timers. Only honored by the `TimingWheel` timer backend
+        int slack_ms = 0;
+    };
+
     struct Statistics {
         size_t total_tasks{0};
         size_t completed_tasks{0};
         size_t failed_tasks{0};
         size_t canceled_tasks{0};
         size_t suspended_tasks{0};
+        size_t deadline_missed_tasks{0};
+        size_t timer_wakeups{0};    // Expirations of the timers of the tasks, or wake-ups of the timing wheel
+    };
+
+    /**
+     * @brief Statistics of the executions of a group, the group "" holds the tasks posted without group
+     *
+     * @note Updated when the task function returns, so right after its completion is reported to `wait()`
+     */
+    struct GroupStatistics {
+        size_t executed_tasks{0};
+        size_t deadline_missed_tasks{0};
+        size_t throttled_count{0};      // Times a ready task of the group was held back by the group quotas
+        uint64_t total_wait_us{0};      // From ready to started
+        uint64_t max_wait_us{0};
+        uint64_t total_run_us{0};
     };
 
     struct GroupConfig {
         // If true, all tasks posted via `post()` and `post_batch()` to this group are executed in sequence even if
-        // there are multiple threads running.
+        // there are multiple threads running. They keep the posting order within the group, and the next one enters
+        // the ready queue with its own priority when the previous one is finished, so it still overtakes the lower
+        // priority tasks of the other groups.
         // Note: Tasks posted using `post_delayed()` and `post_periodic()` are NOT affected by this setting.
         bool enable_post_execute_in_order = false;
+        // Maximum number of tasks of this group executing at the same time, 0 for no limit
+        size_t max_concurrent_tasks = 0;
+        // CPU time in milliseconds the tasks of this group may use in each `cpu_quota_period_ms`, 0 for no limit.
+        // Once used up, the ready tasks of the group wait for the next period
+        uint32_t cpu_quota_ms = 0;
+        uint32_t cpu_quota_period_ms = 100;
     };
 
     /**
@@ -89,6 +149,9 @@ public:
             }
         };
         size_t worker_poll_interval_ms = 5;
+        DispatchPolicy dispatch_policy = DispatchPolicy::StrictPriority;
+        TimerBackend timer_backend = TimerBackend::Asio;
+        size_t timing_wheel_tick_ms = 1;    // Resolution of the `TimingWheel` timer backend
         PreExecuteCallback pre_execute_callback = nullptr;
         PostExecuteCallback post_execute_callback = nullptr;
     };
@@ -158,6 +221,11 @@ public:
      */
     bool dispatch(OnceTask task, TaskId *id = nullptr, const Group &group = "");
 
+    /**
+     * @brief Same as `dispatch()`, with a priority and a deadline. A task executed immediately skips the ready queue
+     */
+    bool dispatch(OnceTask task, TaskId *id, const Group &group, const TaskOptions &options);
+
     /**
      * @brief Post an enqueued task for execution
      *
@@ -169,6 +237,21 @@ public:
      */
     bool post(OnceTask task, TaskId *id = nullptr, const Group &group = "");
 
+    /**
+     * @brief Post an enqueued task for execution, with a priority and a deadline
+     *
+     * The ready tasks are picked by the workers in the order of `StartConfig::dispatch_policy`, within the quotas of
+     * their groups.
+     *
+     * @param[in] task Task to execute
+     * @param[out] id Pointer to receive the task ID, nullptr if not needed
+     * @param[in] group Group name for the task, "" for none
+     * @param[in] options Priority and deadline of the task
+     *
+     * @return true if posted successfully, false otherwise
+     */
+    bool post(OnceTask task, TaskId *id, const Group &group, const TaskOptions &options);
+
     /**
      * @brief Post a delayed task for execution
      *
@@ -180,6 +263,11 @@ public:
      */
     bool post_delayed(OnceTask task, int delay_ms, TaskId *id = nullptr, const Group &group = "");
 
+    /**
+     * @brief Same as `post_delayed()`, with a priority and a deadline counted from the end of the delay
+     */
+    bool post_delayed(OnceTask task, int delay_ms, TaskId *id, const Group &group, const TaskOptions &options);
+
     /**
      * @brief Post a periodic task for execution
      *
@@ -194,6 +282,13 @@ public:
      */
     bool post_periodic(PeriodicTask task, int interval_ms, TaskId *id = nullptr, const Group &group = "");
 
+    /**
+     * @brief Same as `post_periodic()`, with a priority and a deadline counted from each elapsed interval
+     */
+    bool post_periodic(
+        PeriodicTask task, int interval_ms, TaskId *id, const Group &group, const TaskOptions &options
+    );
+
     /**
      * @brief Post multiple tasks in batch
      *
@@ -204,6 +299,13 @@ public:
      */
     bool post_batch(std::vector<OnceTask> tasks, std::vector<TaskId> *ids = nullptr, const Group &group = "");
 
+    /**
+     * @brief Same as `post_batch()`, with the same priority and deadline for all tasks
+     */
+    bool post_batch(
+        std::vector<OnceTask> tasks, std::vector<TaskId> *ids, const Group &group, const TaskOptions &options
+    );
+
     /**
      * @brief Cancel a task by ID
      *
@@ -336,19 +438,30 @@ public:
     Statistics get_statistics() const;
 
     /**
-     * @brief Reset all statistics counters to zero
+     * @brief Get statistics about the executions of a group
+     *
+     * @param[in] group Group name, "" for the tasks posted without group
+     * @return Statistics of the group, all zero if none of its tasks was executed
+     */
+    GroupStatistics get_group_statistics(const Group &group) const;
+
+    /**
+     * @brief Reset all statistics counters to zero, including the ones of the groups
      */
     void reset_statistics();
 
 private:
     struct TaskHandle {
         TaskId id;
-        std::shared_ptr<boost::asio::steady_timer> timer;
+        std::shared_ptr<boost::asio::steady_timer> timer; // `Asio` timer backend, delayed and periodic tasks only
+        uint64_t wheel_timer_id{0}; // `TimingWheel` timer backend, 0 if not armed
+        std::chrono::steady_clock::time_point timer_expiry;
         std::atomic<TaskState> state{TaskState::Running};
         TaskType type{TaskType::Immediate};
         bool repeat{false};
         int interval_ms{0};
         Group group; // Group that this task belongs to
+        TaskOptions options;
         std::shared_ptr<std::promise<bool>> promise; // Promise for task completion
         std::shared_future<bool> future; // Shared future for task completion
         std::atomic<bool> promise_fulfilled{false}; // Flag to prevent double-setting promise
@@ -360,6 +473,40 @@ private:
         PeriodicTask saved_periodic_task;  // Saved task closure for Periodic tasks
     };
 
+    // Task whose delay or interval elapsed, waiting in `ready_tasks_` for a worker
+    struct ReadyTask {
+        std::shared_ptr<TaskHandle> handle;
+        OnceTask run;
+        std::chrono::steady_clock::time_point ready_time;
+        std::chrono::steady_clock::time_point deadline;
+        bool is_in_order = false;  // Posted to a group executed in order, releases the next task of the group
+    };
+    // Ordered by the dispatch policy, the last element is the FIFO sequence
+    using ReadyKey = std::tuple<int64_t, int64_t, uint64_t>;
+
+    // Order state of a group whose posted tasks are executed in order
+    struct GroupOrder {
+        std::deque<ReadyTask> waiting_tasks;  // Posted behind the task of the group which is ready or executing
+        bool is_busy = false;                 // A task of the group is in `ready_tasks_` or executing
+        boost::thread::id executing_thread;   // Thread executing the task of the group, for the nested dispatches
+    };
+
+    // Timer of a task in the timing wheel
+    struct WheelTimer {
+        std::shared_ptr<TaskHandle> handle;
+        OnceTask run;
+    };
+
+    // Quota state of a group
+    struct GroupRuntime {
+        size_t running_tasks = 0;
+        size_t ready_tasks = 0;
+        std::chrono::steady_clock::time_point period_start;
+        std::chrono::microseconds period_used{0};
+        std::shared_ptr<boost::asio::steady_timer> period_timer;
+        bool is_period_timer_armed = false;
+    };
+
     // Generate next task ID
     TaskId next_id()
     {
@@ -367,13 +514,57 @@ private:
     }
 
     // Create task handle
-    std::shared_ptr<TaskHandle> create_handle(TaskType type, bool repeat, int interval_ms, const Group &group);
+    std::shared_ptr<TaskHandle> create_handle(
+        TaskType type, bool repeat, int interval_ms, const Group &group, const TaskOptions &options
+    );
+
+    // Make a task ready: queue it by priority and deadline, and wake a worker to pick the best ready task
+    void enqueue_ready(std::shared_ptr<TaskHandle> handle, OnceTask run);
+
+    // Make a task of a group executed in order ready, or wait behind the task of the group which is ready or executing
+    void enqueue_in_order(std::shared_ptr<TaskHandle> handle, OnceTask run);
+
+    // Internal method: queue a ready task without waking a worker (caller must have already acquired lock)
+    void insert_ready_internal(std::shared_ptr<TaskHandle> handle, OnceTask run);
+    void insert_ready_internal(ReadyTask ready);
+
+    // Create the ready task of a handle, with its deadline counted from now
+    ReadyTask make_ready_task(std::shared_ptr<TaskHandle> handle, OnceTask run) const;
+
+    // Executed by the workers once per ready task: run the best ready task whose group is within its quotas
+    void run_next_ready();
+
+    // Run a ready task and update the statistics of its group
+    void execute_ready(ReadyTask &ready, bool is_quota_counted);
 
-    // Schedule a one-time task
-    void schedule_once(std::shared_ptr<TaskHandle> handle, OnceTask task);
+    // Internal method: check the quotas of a group, arm the period timer if throttled (caller must have already
+    // acquired lock)
+    bool is_group_within_quota_internal(const Group &group, std::chrono::steady_clock::time_point now);
 
-    // Schedule a periodic task (supports return value control)
-    void schedule_periodic(std::shared_ptr<TaskHandle> handle, PeriodicTask task);
+    // Internal method: schedule a one-time task (caller must have already acquired lock)
+    void schedule_once_internal(std::shared_ptr<TaskHandle> handle, OnceTask task);
+
+    // Internal method: schedule a periodic task (supports return value control) (caller must have already acquired
+    // lock)
+    void schedule_periodic_internal(std::shared_ptr<TaskHandle> handle, PeriodicTask task);
+
+    // Internal method: arm the timer of a task with the selected backend, `run` is made ready when it expires (caller
+    // must have already acquired lock)
+    void arm_timer_internal(std::shared_ptr<TaskHandle> handle, int delay_ms, OnceTask run);
+
+    // Internal method: disarm the timer of a task (caller must have already acquired lock)
+    void disarm_timer_internal(TaskHandle &handle);
+
+    // Internal method: make the task of an expired timer ready, or drop it if canceled or suspended, return true if
+    // made ready (caller must have already acquired lock)
+    bool on_timer_expired_internal(std::shared_ptr<TaskHandle> handle, OnceTask run, bool is_aborted);
+
+    // Executed when the driver timer of the timing wheel expires: make the tasks of all the elapsed ticks ready
+    void run_timing_wheel();
+
+    // Internal method: arm the driver timer to the next expiry of the timing wheel if earlier than the armed one
+    // (caller must have already acquired lock)
+    void update_wheel_timer_internal();
 
     // Internal method: cancel task (caller must have already acquired lock)
     void cancel_internal(TaskId task_id);
@@ -384,6 +575,9 @@ private:
     // Internal method: resume task (caller must have already acquired lock)
     bool resume_internal(TaskId task_id);
 
+    // Internal method: reset all statistics counters (caller must have already acquired lock)
+    void reset_statistics_internal();
+
     // Internal method: wait for a set of tasks to complete
     bool wait_tasks_internal(const std::vector<TaskId> &task_ids, int timeout_ms);
 
@@ -391,7 +585,9 @@ private:
     void remove_task_internal(TaskId task_id, const Group &group);
 
     // Internal method: post or dispatch task based on enable_immediate flag
-    bool post_internal(OnceTask task, TaskId *id, const Group &group, bool enable_immediate);
+    bool post_internal(
+        OnceTask task, TaskId *id, const Group &group, const TaskOptions &options, bool enable_immediate
+    );
 
     // Mark task as finished
     void mark_finished(std::shared_ptr<TaskHandle> handle, bool success);
@@ -411,8 +607,19 @@ private:
     boost::thread_group threads_;
     std::map<TaskId, std::shared_ptr<TaskHandle>> tasks_;
     std::map<Group, std::unordered_set<TaskId>> groups_; // Mapping between groups and task IDs
-    std::map<Group, std::shared_ptr<boost::asio::strand<boost::asio::io_context::executor_type>>> strands_; // Strand for each group
+    std::map<Group, GroupOrder> group_orders_; // Order state of the groups executed in order
     std::map<Group, GroupConfig> group_configs_; // Group configurations
+    std::map<Group, GroupRuntime> group_runtimes_; // Quota state of the groups with quotas
+    std::map<Group, GroupStatistics> group_statistics_;
+    std::map<ReadyKey, ReadyTask> ready_tasks_;
+    uint64_t ready_sequence_ = 0;
+    DispatchPolicy dispatch_policy_ = DispatchPolicy::StrictPriority;
+    TimerBackend timer_backend_ = TimerBackend::Asio;
+    std::unique_ptr<TimingWheel<WheelTimer>> timing_wheel_;
+    std::shared_ptr<boost::asio::steady_timer> wheel_timer_; // Driver timer of the timing wheel
+    std::chrono::steady_clock::time_point wheel_timer_expiry_;
+    bool is_wheel_timer_armed_ = false;
+    std::vector<WheelTimer> wheel_expired_timers_;
     mutable boost::mutex mutex_;
     std::atomic<TaskId> task_id_counter_{1};
     std::atomic<TaskId> total_tasks_{0};
@@ -420,6 +627,8 @@ private:
     std::atomic<TaskId> failed_tasks_{0};
     std::atomic<TaskId> canceled_tasks_{0};
     std::atomic<TaskId> suspended_tasks_{0};
+    std::atomic<TaskId> deadline_missed_tasks_{0};
+    std::atomic<TaskId> timer_wakeups_{0};
     PreExecuteCallback pre_execute_callback_;
     PostExecuteCallback post_execute_callback_;
 };
@@ -427,8 +636,13 @@ private:
 // Describe macros for TaskScheduler types
 BROOKESIA_DESCRIBE_ENUM(TaskScheduler::TaskType, Immediate, Delayed, Periodic)
 BROOKESIA_DESCRIBE_ENUM(TaskScheduler::TaskState, Running, Suspended, Canceled, Finished)
-BROOKESIA_DESCRIBE_STRUCT(TaskScheduler::Statistics, (), (total_tasks, completed_tasks, failed_tasks, canceled_tasks, suspended_tasks))
-BROOKESIA_DESCRIBE_STRUCT(TaskScheduler::GroupConfig, (), (enable_post_execute_in_order))
-BROOKESIA_DESCRIBE_STRUCT(TaskScheduler::StartConfig, (), (worker_configs, worker_poll_interval_ms, pre_execute_callback, post_execute_callback))
+BROOKESIA_DESCRIBE_ENUM(TaskScheduler::TaskPriority, Low, Normal, High, Critical)
+BROOKESIA_DESCRIBE_ENUM(TaskScheduler::DispatchPolicy, StrictPriority, EarliestDeadlineFirst)
+BROOKESIA_DESCRIBE_ENUM(TaskScheduler::TimerBackend, Asio, TimingWheel)
+BROOKESIA_DESCRIBE_STRUCT(TaskScheduler::TaskOptions, (), (priority, deadline_ms, slack_ms))
+BROOKESIA_DESCRIBE_STRUCT(TaskScheduler::Statistics, (), (total_tasks, completed_tasks, failed_tasks, canceled_tasks, suspended_tasks, deadline_missed_tasks, timer_wakeups))
+BROOKESIA_DESCRIBE_STRUCT(TaskScheduler::GroupStatistics, (), (executed_tasks, deadline_missed_tasks, throttled_count, total_wait_us, max_wait_us, total_run_us))
+BROOKESIA_DESCRIBE_STRUCT(TaskScheduler::GroupConfig, (), (enable_post_execute_in_order, max_concurrent_tasks, cpu_quota_ms, cpu_quota_period_ms))
+BROOKESIA_DESCRIBE_STRUCT(TaskScheduler::StartConfig, (), (worker_configs, worker_poll_interval_ms, dispatch_policy, timer_backend, timing_wheel_tick_ms, pre_execute_callback, post_execute_callback))
 
 } // namespace esp_brookesia::lib_utils
@@ -8,6 +8,7 @@
 #include <atomic>
 #include <chrono>
 #include <functional>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -15,8 +16,10 @@
 #include <string>
 #include <vector>
 #include <boost/signals2.hpp>
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
+#if defined(ESP_PLATFORM)
+#   include "freertos/FreeRTOS.h"
+#   include "freertos/task.h"
+#endif
 #include "boost/thread/mutex.hpp"
 #include "brookesia/lib_utils/describe_helpers.hpp"
 #include "brookesia/lib_utils/task_scheduler.hpp"
@@ -29,9 +32,39 @@ namespace esp_brookesia::lib_utils {
  * This class provides a C++ interface to monitor FreeRTOS task CPU usage,
  * stack usage, and other runtime statistics. It integrates naturally with
  * TaskScheduler for periodic profiling.
+ *
+ * On the host (Linux), the threads of the process are sampled from `/proc/self/task` instead, so the same profiling
+ * and threshold signals can be used when load testing on a PC.
  */
 class ThreadProfiler {
 public:
+#if defined(ESP_PLATFORM)
+    using TaskHandle = TaskHandle_t;        // FreeRTOS task handle
+    using CoreId = BaseType_t;
+    using NativeTaskStatus = TaskStatus_t;
+#else
+    using TaskHandle = intptr_t;            // Thread ID (TID)
+    using CoreId = int;
+
+    /**
+     * @brief Status of a thread, sampled from `/proc/self/task/<tid>`
+     */
+    struct NativeTaskStatus {
+        TaskHandle tid = 0;                 // Thread ID
+        std::string name;                   // Thread name (`comm`)
+        char state = '?';                   // Thread state (`R`, `S`, `D`, `T`, `Z`, ...)
+        uint32_t priority = 0;              // Real-time priority (0 for normal threads)
+        CoreId core_id = -1;                // Core the thread is pinned to (-1 if it can run on several cores)
+        uint64_t runtime_us = 0;            // CPU time (user + system) in microseconds
+        uint32_t stack_high_water_mark = 0; // Stack never touched (bytes)
+    };
+#endif
+
+    /**
+     * @brief Stack high water mark of a thread whose stack can not be located (host only)
+     */
+    static constexpr uint32_t STACK_HIGH_WATER_MARK_UNKNOWN = std::numeric_limits<uint32_t>::max();
+
     /**
      * @brief Task state enumeration (from FreeRTOS eTaskState)
      */
@@ -85,10 +118,10 @@ public:
      */
     struct TaskInfo {
         std::string name;                       // Task name
-        TaskHandle_t handle = nullptr;          // Task handle
+        TaskHandle handle{};                    // Task handle (thread ID on the host)
         TaskState state = TaskState::Invalid;   // Current state
         uint32_t priority = 0;                  // Task priority
-        BaseType_t core_id = -1;                // CPU core ID (-1 if not bound)
+        CoreId core_id = -1;                    // CPU core ID (-1 if not bound)
         uint32_t stack_high_water_mark = 0;     // Stack high water mark (bytes)
         bool is_stack_external = false;         // Stack allocated in external RAM
         uint32_t runtime_counter = 0;           // Runtime counter (raw)
@@ -121,7 +154,7 @@ public:
 
     struct SampleResult {
         std::chrono::system_clock::time_point timestamp;
-        std::vector<TaskStatus_t> task_status;
+        std::vector<NativeTaskStatus> task_status;
         uint32_t runtime;
     };
 
@@ -331,6 +364,7 @@ private:
      */
     void check_thresholds_and_trigger_callbacks(const ProfileSnapshot &snapshot);
 
+#if defined(ESP_PLATFORM)
     /**
      * @brief Convert FreeRTOS eTaskState to TaskState enum
      *
@@ -338,6 +372,15 @@ private:
      * @return ThreadProfiler::TaskState
      */
     static TaskState convert_task_state(eTaskState state);
+#else
+    /**
+     * @brief Convert the state of `/proc/<pid>/task/<tid>/stat` to TaskState enum
+     *
+     * @param state Thread state character
+     * @return ThreadProfiler::TaskState
+     */
+    static TaskState convert_task_state(char state);
+#endif
 
     /**
      * @brief Get string representation of task state
@@ -0,0 +1,310 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace esp_brookesia::lib_utils {
+
+/**
+ * @brief Hierarchical timing wheel, holding a value of type `T` per timer
+ *
+ * Time is counted in ticks from the creation of the wheel. The timers closer than `SLOT_NUM` ticks are stored in the
+ * slot of their tick in the first level, the farther ones in the coarser levels, and move down a level each time the
+ * finer level wraps around. Adding and canceling a timer are O(1), and all the timers of a tick expire in a single
+ * `advance()`.
+ *
+ * A timer can be given a slack: it may then expire up to that much later, on the tick of its window that is aligned
+ * on the largest power of two, so that the timers with close windows share the same tick.
+ *
+ * @note Not thread-safe, the owner serializes the calls
+ */
+template <typename T>
+class TimingWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimerId = uint64_t; // 0 is never a valid ID
+
+    static constexpr size_t LEVEL_BITS = 6;
+    static constexpr size_t SLOT_NUM = 1 << LEVEL_BITS;
+    static constexpr size_t LEVEL_NUM = 4;
+
+    /**
+     * @brief Create a timing wheel
+     *
+     * @param[in] tick Duration of a tick, the resolution of the timers
+     * @param[in] origin Time of the tick 0
+     */
+    explicit TimingWheel(std::chrono::milliseconds tick, Clock::time_point origin = Clock::now())
+        : tick_(std::max(tick, std::chrono::milliseconds(1)))
+        , origin_(origin)
+    {
+        for (auto &level : heads_) {
+            level.fill(NIL);
+        }
+    }
+
+    /**
+     * @brief Add a timer
+     *
+     * @param[in] expiry Time at which the timer expires, never earlier than the next tick
+     * @param[in] slack Maximum delay allowed after `expiry` to share the tick of other timers
+     * @param[in] value Value returned by `advance()` when the timer expires
+     * @return ID of the timer
+     */
+    TimerId add(Clock::time_point expiry, std::chrono::milliseconds slack, T value)
+    {
+        uint64_t expiry_tick = to_tick_ceil(expiry);
+        uint64_t slack_ticks = (slack.count() > 0) ? static_cast<uint64_t>(slack / tick_) : 0;
+        if (slack_ticks > 0) {
+            // Latest tick of the window aligned on the largest power of two that fits in it
+            uint64_t granularity = std::bit_floor(slack_ticks + 1);
+            expiry_tick = (expiry_tick + slack_ticks) & ~(granularity - 1);
+        }
+        expiry_tick = std::max(expiry_tick, current_tick_ + 1);
+
+        uint32_t index = 0;
+        if (!free_nodes_.empty()) {
+            index = free_nodes_.back();
+            free_nodes_.pop_back();
+        } else {
+            index = static_cast<uint32_t>(nodes_.size());
+            nodes_.emplace_back();
+        }
+        auto &node = nodes_[index];
+        node.value = std::move(value);
+        node.expiry_tick = expiry_tick;
+        node.is_used = true;
+        link(index);
+        size_++;
+
+        return (static_cast<uint64_t>(node.generation) << 32) | (index + 1);
+    }
+
+    /**
+     * @brief Cancel a timer
+     *
+     * @param[in] id ID of the timer
+     * @return true if canceled, false if already expired, canceled, or unknown
+     */
+    bool cancel(TimerId id)
+    {
+        auto index = get_index(id);
+        if (!index.has_value()) {
+            return false;
+        }
+        unlink(*index);
+        release(*index);
+
+        return true;
+    }
+
+    /**
+     * @brief Move the wheel forward to `now`, and append the values of the expired timers to `expired`
+     *
+     * @param[in] now Current time
+     * @param[out] expired Values of the expired timers, in the order of their expiry
+     */
+    void advance(Clock::time_point now, std::vector<T> &expired)
+    {
+        uint64_t target_tick = to_tick_floor(now);
+        while (current_tick_ < target_tick) {
+            if (size_ == 0) {
+                current_tick_ = target_tick;
+                break;
+            }
+
+            uint64_t next_tick = current_tick_ + 1;
+            if (occupied_[0] == 0) {
+                // Nothing in the first level until it wraps around
+                next_tick = std::min(target_tick, (current_tick_ | (SLOT_NUM - 1)) + 1);
+            }
+            current_tick_ = next_tick;
+
+            if ((current_tick_ & (SLOT_NUM - 1)) == 0) {
+                cascade();
+            }
+
+            auto slot = current_tick_ & (SLOT_NUM - 1);
+            while (heads_[0][slot] != NIL) {
+                auto index = heads_[0][slot];
+                unlink(index);
+                expired.push_back(std::move(nodes_[index].value));
+                release(index);
+            }
+        }
+    }
+
+    /**
+     * @brief Get the time at which `advance()` has work to do: a timer expires or a level needs to be moved down
+     *
+     * @return Time of the next tick with work, `std::nullopt` if there is no timer
+     */
+    std::optional<Clock::time_point> get_next_expiry() const
+    {
+        if (size_ == 0) {
+            return std::nullopt;
+        }
+
+        uint64_t next_tick = std::numeric_limits<uint64_t>::max();
+        for (size_t level = 0; level < LEVEL_NUM; level++) {
+            if (occupied_[level] == 0) {
+                continue;
+            }
+            // The slots after the current one, then the current one on the next rotation
+            auto shift = LEVEL_BITS * level;
+            auto current_slot = (current_tick_ >> shift) & (SLOT_NUM - 1);
+            auto distance = std::countr_zero(std::rotr(occupied_[level], static_cast<int>(current_slot + 1))) + 1;
+            next_tick = std::min(next_tick, ((current_tick_ >> shift) + distance) << shift);
+        }
+
+        return origin_ + tick_ * next_tick;
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    bool empty() const
+    {
+        return (size_ == 0);
+    }
+
+private:
+    static constexpr uint32_t NIL = std::numeric_limits<uint32_t>::max();
+
+    struct Node {
+        T value{};
+        uint64_t expiry_tick = 0;
+        uint32_t generation = 0;
+        uint32_t prev = NIL;
+        uint32_t next = NIL;
+        uint8_t level = 0;
+        uint8_t slot = 0;
+        bool is_used = false;
+    };
+
+    uint64_t to_tick_floor(Clock::time_point time) const
+    {
+        return (time <= origin_) ? 0 : static_cast<uint64_t>((time - origin_) / tick_);
+    }
+
+    uint64_t to_tick_ceil(Clock::time_point time) const
+    {
+        if (time <= origin_) {
+            return 0;
+        }
+        auto tick = to_tick_floor(time);
+        return (origin_ + tick_ * tick < time) ? (tick + 1) : tick;
+    }
+
+    std::optional<uint32_t> get_index(TimerId id) const
+    {
+        auto index = static_cast<uint32_t>(id & 0xFFFFFFFF);
+        if ((index == 0) || (index > nodes_.size())) {
+            return std::nullopt;
+        }
+        index--;
+        const auto &node = nodes_[index];
+        if (!node.is_used || (node.generation != static_cast<uint32_t>(id >> 32))) {
+            return std::nullopt;
+        }
+
+        return index;
+    }
+
+    void link(uint32_t index)
+    {
+        auto &node = nodes_[index];
+        uint64_t delta = node.expiry_tick - std::min(node.expiry_tick, current_tick_);
+        size_t level = 0;
+        while ((level < LEVEL_NUM - 1) && (delta >= (uint64_t(1) << (LEVEL_BITS * (level + 1))))) {
+            level++;
+        }
+        // Beyond the range of the wheel, parked in the last level until it gets close enough
+        uint64_t placed_tick = std::min(
+                                   node.expiry_tick, current_tick_ + (uint64_t(1) << (LEVEL_BITS * LEVEL_NUM)) - 1
+                               );
+        auto slot = (placed_tick >> (LEVEL_BITS * level)) & (SLOT_NUM - 1);
+
+        node.level = static_cast<uint8_t>(level);
+        node.slot = static_cast<uint8_t>(slot);
+        node.prev = NIL;
+        node.next = heads_[level][slot];
+        if (node.next != NIL) {
+            nodes_[node.next].prev = index;
+        }
+        heads_[level][slot] = index;
+        occupied_[level] |= (uint64_t(1) << slot);
+    }
+
+    void unlink(uint32_t index)
+    {
+        auto &node = nodes_[index];
+        if (node.prev != NIL) {
+            nodes_[node.prev].next = node.next;
+        } else {
+            heads_[node.level][node.slot] = node.next;
+        }
+        if (node.next != NIL) {
+            nodes_[node.next].prev = node.prev;
+        }
+        if (heads_[node.level][node.slot] == NIL) {
+            occupied_[node.level] &= ~(uint64_t(1) << node.slot);
+        }
+        node.prev = NIL;
+        node.next = NIL;
+    }
+
+    void release(uint32_t index)
+    {
+        auto &node = nodes_[index];
+        node.value = T{};
+        node.is_used = false;
+        node.generation++;
+        free_nodes_.push_back(index);
+        size_--;
+    }
+
+    // Move the timers of the slots reached by the current tick down to the finer levels
+    void cascade()
+    {
+        for (size_t level = 1; level < LEVEL_NUM; level++) {
+            auto slot = (current_tick_ >> (LEVEL_BITS * level)) & (SLOT_NUM - 1);
+            auto index = heads_[level][slot];
+            heads_[level][slot] = NIL;
+            occupied_[level] &= ~(uint64_t(1) << slot);
+            while (index != NIL) {
+                auto next = nodes_[index].next;
+                link(index);
+                index = next;
+            }
+            if (slot != 0) {
+                break;
+            }
+        }
+    }
+
+    std::chrono::milliseconds tick_;
+    Clock::time_point origin_;
+    uint64_t current_tick_ = 0;
+    size_t size_ = 0;
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> free_nodes_;
+    std::array<std::array<uint32_t, SLOT_NUM>, LEVEL_NUM> heads_;
+    std::array<uint64_t, LEVEL_NUM> occupied_{};
+};
+
+} // namespace esp_brookesia::lib_utils
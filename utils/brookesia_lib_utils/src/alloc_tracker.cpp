@@ -0,0 +1,820 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include "brookesia/lib_utils/macro_configs.h"
+#if BROOKESIA_UTILS_ALLOC_TRACKER_AVAILABLE
+#   include <cerrno>
+#   include <new>
+#   include <thread>
+#   include <cxxabi.h>
+#   include <dlfcn.h>
+#   include <sys/mman.h>
+#endif
+#if !BROOKESIA_UTILS_MEMORY_PROFILER_ENABLE_DEBUG_LOG
+#   define BROOKESIA_LOG_DISABLE_DEBUG_TRACE 1
+#endif
+#include "private/utils.hpp"
+#include "brookesia/lib_utils/log.hpp"
+#include "brookesia/lib_utils/check.hpp"
+#include "brookesia/lib_utils/alloc_tracker.hpp"
+
+#if BROOKESIA_UTILS_ALLOC_TRACKER_AVAILABLE
+
+// The real allocator of glibc, they are used instead of `dlsym(RTLD_NEXT)` which may allocate itself
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void __libc_free(void *ptr);
+}
+
+namespace esp_brookesia::lib_utils {
+
+namespace {
+
+constexpr size_t SITE_NUM = 1024;
+constexpr size_t SITE_MAX_USED = SITE_NUM * 3 / 4;
+constexpr size_t SITE_TAG_SIZE = AllocTracker::TAG_SIZE_MAX;
+constexpr uint32_t SITE_OVERFLOW_INDEX = 0;
+constexpr size_t SHARD_NUM = 64;
+constexpr size_t SHARD_CAPACITY = 32 * 1024;
+constexpr size_t SHARD_MAX_USED = SHARD_CAPACITY * 7 / 8;
+constexpr size_t REPORT_NAME_WIDTH = 48;
+
+static_assert((SITE_NUM & (SITE_NUM - 1)) == 0, "SITE_NUM must be a power of 2");
+static_assert((SHARD_NUM & (SHARD_NUM - 1)) == 0, "SHARD_NUM must be a power of 2");
+static_assert((SHARD_CAPACITY & (SHARD_CAPACITY - 1)) == 0, "SHARD_CAPACITY must be a power of 2");
+
+class SpinLock {
+public:
+    void lock()
+    {
+        while (flag_.test_and_set(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+
+    void unlock()
+    {
+        flag_.clear(std::memory_order_release);
+    }
+
+private:
+    std::atomic_flag flag_ = ATOMIC_FLAG_INIT;
+};
+
+class SpinLockGuard {
+public:
+    explicit SpinLockGuard(SpinLock &lock)
+        : lock_(lock)
+    {
+        lock_.lock();
+    }
+    ~SpinLockGuard()
+    {
+        lock_.unlock();
+    }
+
+private:
+    SpinLock &lock_;
+};
+
+struct Site {
+    std::atomic<bool> is_used{false};
+    AllocTracker::SiteType type = AllocTracker::SiteType::CallSite;
+    uintptr_t address = 0;
+    char tag[SITE_TAG_SIZE] = {};
+    std::atomic<size_t> alloc_count{0};
+    std::atomic<size_t> free_count{0};
+    std::atomic<size_t> alloc_bytes{0};
+    std::atomic<size_t> live_count{0};
+    std::atomic<size_t> live_bytes{0};
+    std::atomic<size_t> peak_live_bytes{0};
+};
+
+struct LiveEntry {
+    uintptr_t ptr;
+    size_t size;
+    uint32_t site_index;
+    uint32_t generation;
+};
+
+struct Shard {
+    SpinLock lock;
+    size_t used = 0;
+    LiveEntry *entries = nullptr;
+};
+
+struct State {
+    Site sites[SITE_NUM];
+    SpinLock site_lock;
+    size_t site_used = 0;
+    Shard shards[SHARD_NUM];
+    std::atomic<uint32_t> generation{0};
+    std::atomic<size_t> live_bytes{0};
+    std::atomic<size_t> peak_live_bytes{0};
+    std::atomic<size_t> untracked_count{0};
+};
+
+enum class InitState : int {
+    None,
+    Initializing,
+    Ready,
+    Failed,
+};
+
+std::atomic<InitState> s_init_state{InitState::None};
+State *s_state = nullptr;
+
+// Plain `thread_local` of trivial types, accessing them never allocates
+__attribute__((tls_model("initial-exec"))) thread_local const char *t_tag = nullptr;
+__attribute__((tls_model("initial-exec"))) thread_local bool t_in_hook = false;
+
+inline uint64_t mix_hash(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+inline uint64_t hash_tag(const char *tag, size_t len)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ static_cast<uint8_t>(tag[i])) * 0x100000001b3ULL;
+    }
+    return mix_hash(hash);
+}
+
+State *get_state()
+{
+    auto init_state = s_init_state.load(std::memory_order_acquire);
+    if (init_state == InitState::Ready) {
+        return s_state;
+    }
+    if (init_state != InitState::None) {
+        return nullptr;
+    }
+
+    // Allocations made by other threads during the initialization are not tracked
+    auto expected = InitState::None;
+    if (!s_init_state.compare_exchange_strong(expected, InitState::Initializing, std::memory_order_acq_rel)) {
+        return nullptr;
+    }
+
+    // The live tables are reserved without backing memory, only the touched pages are committed
+    size_t state_size = (sizeof(State) + alignof(LiveEntry) - 1) / alignof(LiveEntry) * alignof(LiveEntry);
+    size_t map_size = state_size + SHARD_NUM * SHARD_CAPACITY * sizeof(LiveEntry);
+    void *mem = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (mem == MAP_FAILED) {
+        s_init_state.store(InitState::Failed, std::memory_order_release);
+        return nullptr;
+    }
+
+    auto state = new (mem) State();
+    auto entries = reinterpret_cast<LiveEntry *>(static_cast<uint8_t *>(mem) + state_size);
+    for (size_t i = 0; i < SHARD_NUM; i++) {
+        state->shards[i].entries = entries + i * SHARD_CAPACITY;
+    }
+    // The first site collects the allocations of all the sites which do not fit in the table
+    state->sites[SITE_OVERFLOW_INDEX].type = AllocTracker::SiteType::Overflow;
+    state->sites[SITE_OVERFLOW_INDEX].is_used.store(true, std::memory_order_release);
+    state->site_used = 1;
+
+    s_state = state;
+    s_init_state.store(InitState::Ready, std::memory_order_release);
+
+    return state;
+}
+
+bool is_site_matched(const Site &site, AllocTracker::SiteType type, uintptr_t address, const char *tag, size_t tag_len)
+{
+    if (site.type != type) {
+        return false;
+    }
+    if (type == AllocTracker::SiteType::Tag) {
+        return (std::memcmp(site.tag, tag, tag_len) == 0) && (site.tag[tag_len] == '\0');
+    }
+    return site.address == address;
+}
+
+uint32_t find_site(State &state, uintptr_t address, const char *tag)
+{
+    auto type = (tag != nullptr) ? AllocTracker::SiteType::Tag : AllocTracker::SiteType::CallSite;
+    size_t tag_len = (tag != nullptr) ? strnlen(tag, SITE_TAG_SIZE - 1) : 0;
+    uint64_t hash = (tag != nullptr) ? hash_tag(tag, tag_len) : mix_hash(address);
+
+    for (size_t i = 0; i < SITE_NUM; i++) {
+        uint32_t index = static_cast<uint32_t>((hash + i) & (SITE_NUM - 1));
+        auto &site = state.sites[index];
+        if (!site.is_used.load(std::memory_order_acquire)) {
+            SpinLockGuard lock(state.site_lock);
+            if (!site.is_used.load(std::memory_order_relaxed)) {
+                if (state.site_used >= SITE_MAX_USED) {
+                    return SITE_OVERFLOW_INDEX;
+                }
+                site.type = type;
+                site.address = address;
+                if (tag != nullptr) {
+                    std::memcpy(site.tag, tag, tag_len);
+                    site.tag[tag_len] = '\0';
+                }
+                state.site_used++;
+                site.is_used.store(true, std::memory_order_release);
+                return index;
+            }
+        }
+        if (is_site_matched(site, type, address, tag, tag_len)) {
+            return index;
+        }
+    }
+
+    return SITE_OVERFLOW_INDEX;
+}
+
+inline Shard &get_shard(State &state, uintptr_t ptr, size_t &home)
+{
+    uint64_t hash = mix_hash(ptr);
+    home = (hash / SHARD_NUM) & (SHARD_CAPACITY - 1);
+    return state.shards[hash & (SHARD_NUM - 1)];
+}
+
+inline size_t get_home(uintptr_t ptr)
+{
+    return (mix_hash(ptr) / SHARD_NUM) & (SHARD_CAPACITY - 1);
+}
+
+bool insert_entry(State &state, const LiveEntry &entry)
+{
+    size_t index = 0;
+    auto &shard = get_shard(state, entry.ptr, index);
+
+    SpinLockGuard lock(shard.lock);
+    if (shard.used >= SHARD_MAX_USED) {
+        return false;
+    }
+    while (shard.entries[index].ptr != 0) {
+        index = (index + 1) & (SHARD_CAPACITY - 1);
+    }
+    shard.entries[index] = entry;
+    shard.used++;
+
+    return true;
+}
+
+bool remove_entry(State &state, uintptr_t ptr, LiveEntry &entry)
+{
+    size_t index = 0;
+    auto &shard = get_shard(state, ptr, index);
+
+    SpinLockGuard lock(shard.lock);
+    while (shard.entries[index].ptr != ptr) {
+        if (shard.entries[index].ptr == 0) {
+            return false;
+        }
+        index = (index + 1) & (SHARD_CAPACITY - 1);
+    }
+    entry = shard.entries[index];
+    shard.used--;
+
+    // Backward shift deletion, so the probe chains never need tombstones
+    while (true) {
+        shard.entries[index].ptr = 0;
+        size_t next = index;
+        while (true) {
+            next = (next + 1) & (SHARD_CAPACITY - 1);
+            if (shard.entries[next].ptr == 0) {
+                return true;
+            }
+            size_t home = get_home(shard.entries[next].ptr);
+            bool is_in_place = (index <= next) ? ((index < home) && (home <= next)) : ((index < home) || (home <= next));
+            if (!is_in_place) {
+                break;
+            }
+        }
+        shard.entries[index] = shard.entries[next];
+        index = next;
+    }
+}
+
+inline void update_peak(std::atomic<size_t> &peak, size_t value)
+{
+    size_t cur_peak = peak.load(std::memory_order_relaxed);
+    while ((value > cur_peak) && !peak.compare_exchange_weak(cur_peak, value, std::memory_order_relaxed)) {
+    }
+}
+
+void record_alloc(void *ptr, size_t size, void *caller)
+{
+    if ((ptr == nullptr) || t_in_hook) {
+        return;
+    }
+    auto state = get_state();
+    if (state == nullptr) {
+        return;
+    }
+
+    t_in_hook = true;
+
+    uint32_t site_index = find_site(*state, reinterpret_cast<uintptr_t>(caller), t_tag);
+    auto &site = state->sites[site_index];
+    site.alloc_count.fetch_add(1, std::memory_order_relaxed);
+    site.alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    LiveEntry entry = {
+        reinterpret_cast<uintptr_t>(ptr), size, site_index, state->generation.load(std::memory_order_relaxed)
+    };
+    if (insert_entry(*state, entry)) {
+        site.live_count.fetch_add(1, std::memory_order_relaxed);
+        update_peak(site.peak_live_bytes, site.live_bytes.fetch_add(size, std::memory_order_relaxed) + size);
+        update_peak(state->peak_live_bytes, state->live_bytes.fetch_add(size, std::memory_order_relaxed) + size);
+    } else {
+        state->untracked_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    t_in_hook = false;
+}
+
+void record_free(const LiveEntry &entry)
+{
+    auto &site = s_state->sites[entry.site_index];
+    site.free_count.fetch_add(1, std::memory_order_relaxed);
+    site.live_count.fetch_sub(1, std::memory_order_relaxed);
+    site.live_bytes.fetch_sub(entry.size, std::memory_order_relaxed);
+    s_state->live_bytes.fetch_sub(entry.size, std::memory_order_relaxed);
+}
+
+// Must be called before the memory is returned to glibc, otherwise another thread may get the same address
+bool take_entry(void *ptr, LiveEntry &entry)
+{
+    if ((ptr == nullptr) || t_in_hook || (s_init_state.load(std::memory_order_acquire) != InitState::Ready)) {
+        return false;
+    }
+
+    t_in_hook = true;
+    bool is_found = remove_entry(*s_state, reinterpret_cast<uintptr_t>(ptr), entry);
+    t_in_hook = false;
+
+    return is_found;
+}
+
+void *allocate_new(size_t size, void *caller)
+{
+    if (size == 0) {
+        size = 1;
+    }
+    while (true) {
+        void *ptr = __libc_malloc(size);
+        if (ptr != nullptr) {
+            record_alloc(ptr, size, caller);
+            return ptr;
+        }
+        auto handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+std::string get_site_name(const AllocTracker::SiteInfo &info, const char *tag)
+{
+    switch (info.type) {
+    case AllocTracker::SiteType::Tag:
+        return std::string("[") + tag + "]";
+    case AllocTracker::SiteType::Overflow:
+        return "<other sites>";
+    default:
+        break;
+    }
+
+    std::ostringstream oss;
+    Dl_info dl_info = {};
+    if (dladdr(reinterpret_cast<void *>(info.address), &dl_info) == 0) {
+        oss << "0x" << std::hex << info.address;
+        return oss.str();
+    }
+    if ((dl_info.dli_sname != nullptr) && (dl_info.dli_saddr != nullptr)) {
+        int status = 0;
+        char *demangled = abi::__cxa_demangle(dl_info.dli_sname, nullptr, nullptr, &status);
+        oss << ((status == 0) ? demangled : dl_info.dli_sname) << "+0x" << std::hex
+            << (info.address - reinterpret_cast<uintptr_t>(dl_info.dli_saddr));
+        std::free(demangled);
+        return oss.str();
+    }
+    // Not exported, use `addr2line -e <module> <offset>` to resolve it
+    const char *module = (dl_info.dli_fname != nullptr) ? dl_info.dli_fname : "?";
+    const char *module_name = std::strrchr(module, '/');
+    oss << ((module_name != nullptr) ? (module_name + 1) : module) << "+0x" << std::hex
+        << (info.address - reinterpret_cast<uintptr_t>(dl_info.dli_fbase));
+    return oss.str();
+}
+
+bool collect_report(AllocTracker::Report &report, size_t max_sites, bool is_leak)
+{
+    auto state = get_state();
+    BROOKESIA_CHECK_NULL_RETURN(state, false, "Allocation tracker is not initialized");
+
+    BROOKESIA_CHECK_FALSE_RETURN(AllocTracker::get_summary(report.summary), false, "Failed to get summary");
+
+    // Only used by the leak report, allocated before locking any shard since allocating may need the same shard
+    std::vector<size_t> leak_counts;
+    std::vector<size_t> leak_bytes;
+    if (is_leak) {
+        leak_counts.resize(SITE_NUM, 0);
+        leak_bytes.resize(SITE_NUM, 0);
+        uint32_t generation = state->generation.load(std::memory_order_relaxed);
+        for (auto &shard : state->shards) {
+            SpinLockGuard lock(shard.lock);
+            for (size_t i = 0; i < SHARD_CAPACITY; i++) {
+                const auto &entry = shard.entries[i];
+                if ((entry.ptr != 0) && (entry.generation >= generation)) {
+                    leak_counts[entry.site_index]++;
+                    leak_bytes[entry.site_index] += entry.size;
+                }
+            }
+        }
+    }
+
+    std::vector<std::pair<uint32_t, AllocTracker::SiteInfo>> sites;
+    sites.reserve(SITE_NUM);
+    for (uint32_t i = 0; i < SITE_NUM; i++) {
+        const auto &site = state->sites[i];
+        if (!site.is_used.load(std::memory_order_acquire)) {
+            continue;
+        }
+        AllocTracker::SiteInfo info;
+        info.type = site.type;
+        info.address = site.address;
+        info.alloc_count = site.alloc_count.load(std::memory_order_relaxed);
+        info.free_count = site.free_count.load(std::memory_order_relaxed);
+        info.alloc_bytes = site.alloc_bytes.load(std::memory_order_relaxed);
+        info.peak_live_bytes = site.peak_live_bytes.load(std::memory_order_relaxed);
+        if (is_leak) {
+            info.live_count = leak_counts[i];
+            info.live_bytes = leak_bytes[i];
+            if (info.live_count == 0) {
+                continue;
+            }
+        } else {
+            info.live_count = site.live_count.load(std::memory_order_relaxed);
+            info.live_bytes = site.live_bytes.load(std::memory_order_relaxed);
+            if (info.alloc_count == 0) {
+                continue;
+            }
+        }
+        sites.emplace_back(i, std::move(info));
+    }
+
+    std::sort(sites.begin(), sites.end(), [is_leak](const auto & a, const auto & b) {
+        return is_leak ? (a.second.live_bytes > b.second.live_bytes) : (a.second.alloc_count > b.second.alloc_count);
+    });
+    if ((max_sites > 0) && (sites.size() > max_sites)) {
+        sites.resize(max_sites);
+    }
+
+    // Symbolize only the reported sites, `dladdr()` is slow
+    report.sites.clear();
+    report.sites.reserve(sites.size());
+    for (auto &[index, info] : sites) {
+        info.name = get_site_name(info, state->sites[index].tag);
+        report.sites.push_back(std::move(info));
+    }
+
+    return true;
+}
+
+void print_report(const char *title, const AllocTracker::Report &report, bool is_leak)
+{
+    std::ostringstream oss;
+    oss << "\n==================== " << title << " ====================\n";
+    oss << "Live: " << report.summary.live_count << " allocs, " << (report.summary.live_bytes / 1024) << " KB"
+        << " (peak " << (report.summary.peak_live_bytes / 1024) << " KB)"
+        << ", Allocs: " << report.summary.alloc_count << ", Frees: " << report.summary.free_count
+        << ", Untracked: " << report.summary.untracked_count << "\n";
+
+    auto print_name = [&oss](const std::string & name) {
+        if (name.size() > REPORT_NAME_WIDTH) {
+            oss << "| " << std::left << std::setw(REPORT_NAME_WIDTH) << (name.substr(0, REPORT_NAME_WIDTH - 3) + "...");
+        } else {
+            oss << "| " << std::left << std::setw(REPORT_NAME_WIDTH) << name;
+        }
+    };
+    std::string separator = "+" + std::string(REPORT_NAME_WIDTH + 2, '-');
+    if (is_leak) {
+        separator += "+------------+------------+";
+    } else {
+        separator += "+------------+------------+------------+------------+------------+";
+    }
+
+    oss << separator << "\n";
+    print_name("Site");
+    if (is_leak) {
+        oss << " | " << std::right << std::setw(10) << "Leaked"
+            << " | " << std::setw(10) << "Bytes" << " |\n";
+    } else {
+        oss << " | " << std::right << std::setw(10) << "Allocs"
+            << " | " << std::setw(10) << "Frees"
+            << " | " << std::setw(10) << "Alloc (KB)"
+            << " | " << std::setw(10) << "Live (KB)"
+            << " | " << std::setw(10) << "Peak (KB)" << " |\n";
+    }
+    oss << separator << "\n";
+
+    for (const auto &site : report.sites) {
+        print_name(site.name);
+        if (is_leak) {
+            oss << " | " << std::right << std::setw(10) << site.live_count
+                << " | " << std::setw(10) << site.live_bytes << " |\n";
+        } else {
+            oss << " | " << std::right << std::setw(10) << site.alloc_count
+                << " | " << std::setw(10) << site.free_count
+                << " | " << std::setw(10) << (site.alloc_bytes / 1024)
+                << " | " << std::setw(10) << (site.live_bytes / 1024)
+                << " | " << std::setw(10) << (site.peak_live_bytes / 1024) << " |\n";
+        }
+    }
+    oss << separator << "\n";
+
+    BROOKESIA_LOGI("%1%", oss.str());
+}
+
+} // namespace
+
+AllocTracker::ScopedTag::ScopedTag(std::string_view tag)
+{
+    if (tag.empty()) {
+        return;
+    }
+    // Copied without allocating, the tag of the caller may not outlive this scope
+    size_t tag_len = std::min(tag.size(), sizeof(tag_) - 1);
+    std::memcpy(tag_, tag.data(), tag_len);
+    tag_[tag_len] = '\0';
+    prev_tag_ = t_tag;
+    t_tag = tag_;
+    is_set_ = true;
+}
+
+AllocTracker::ScopedTag::~ScopedTag()
+{
+    if (is_set_) {
+        t_tag = prev_tag_;
+    }
+}
+
+bool AllocTracker::get_summary(Summary &summary)
+{
+    auto state = get_state();
+    BROOKESIA_CHECK_NULL_RETURN(state, false, "Allocation tracker is not initialized");
+
+    summary = Summary();
+    for (const auto &site : state->sites) {
+        if (!site.is_used.load(std::memory_order_acquire)) {
+            continue;
+        }
+        summary.alloc_count += site.alloc_count.load(std::memory_order_relaxed);
+        summary.free_count += site.free_count.load(std::memory_order_relaxed);
+        summary.alloc_bytes += site.alloc_bytes.load(std::memory_order_relaxed);
+        summary.live_count += site.live_count.load(std::memory_order_relaxed);
+    }
+    summary.live_bytes = state->live_bytes.load(std::memory_order_relaxed);
+    summary.peak_live_bytes = state->peak_live_bytes.load(std::memory_order_relaxed);
+    summary.untracked_count = state->untracked_count.load(std::memory_order_relaxed);
+
+    return true;
+}
+
+bool AllocTracker::get_churn_report(Report &report, size_t max_sites)
+{
+    BROOKESIA_LOG_TRACE_GUARD();
+
+    return collect_report(report, max_sites, false);
+}
+
+bool AllocTracker::get_leak_report(Report &report, size_t max_sites)
+{
+    BROOKESIA_LOG_TRACE_GUARD();
+
+    return collect_report(report, max_sites, true);
+}
+
+void AllocTracker::mark()
+{
+    BROOKESIA_LOG_TRACE_GUARD();
+
+    auto state = get_state();
+    BROOKESIA_CHECK_NULL_EXIT(state, "Allocation tracker is not initialized");
+
+    state->generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AllocTracker::reset()
+{
+    BROOKESIA_LOG_TRACE_GUARD();
+
+    auto state = get_state();
+    BROOKESIA_CHECK_NULL_EXIT(state, "Allocation tracker is not initialized");
+
+    for (auto &site : state->sites) {
+        if (!site.is_used.load(std::memory_order_acquire)) {
+            continue;
+        }
+        site.alloc_count.store(0, std::memory_order_relaxed);
+        site.free_count.store(0, std::memory_order_relaxed);
+        site.alloc_bytes.store(0, std::memory_order_relaxed);
+        site.peak_live_bytes.store(site.live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    state->peak_live_bytes.store(state->live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    state->untracked_count.store(0, std::memory_order_relaxed);
+}
+
+void AllocTracker::print_churn_report(size_t max_sites)
+{
+    BROOKESIA_LOG_TRACE_GUARD();
+
+    Report report;
+    BROOKESIA_CHECK_FALSE_EXIT(get_churn_report(report, max_sites), "Failed to get churn report");
+    print_report("Allocation Churn", report, false);
+}
+
+void AllocTracker::print_leak_report(size_t max_sites)
+{
+    BROOKESIA_LOG_TRACE_GUARD();
+
+    Report report;
+    BROOKESIA_CHECK_FALSE_EXIT(get_leak_report(report, max_sites), "Failed to get leak report");
+    print_report("Allocation Leaks", report, true);
+}
+
+} // namespace esp_brookesia::lib_utils
+
+/*
+ * Interposed allocator. The definitions of the executable take precedence over the ones of the shared libraries,
+ * so the allocations made by libstdc++, boost, etc. are tracked as well.
+ */
+using esp_brookesia::lib_utils::LiveEntry;
+
+extern "C" {
+
+__attribute__((noinline)) void *malloc(size_t size) noexcept
+{
+    void *ptr = __libc_malloc(size);
+    esp_brookesia::lib_utils::record_alloc(ptr, size, __builtin_return_address(0));
+    return ptr;
+}
+
+__attribute__((noinline)) void *calloc(size_t count, size_t size) noexcept
+{
+    void *ptr = __libc_calloc(count, size);
+    esp_brookesia::lib_utils::record_alloc(ptr, count * size, __builtin_return_address(0));
+    return ptr;
+}
+
+__attribute__((noinline)) void *realloc(void *ptr, size_t size) noexcept
+{
+    LiveEntry entry = {};
+    bool is_tracked = esp_brookesia::lib_utils::take_entry(ptr, entry);
+    void *new_ptr = __libc_realloc(ptr, size);
+    if ((new_ptr == nullptr) && (size != 0)) {
+        // The original memory is still valid, keep it tracked
+        if (is_tracked) {
+            esp_brookesia::lib_utils::insert_entry(*esp_brookesia::lib_utils::s_state, entry);
+        }
+        return nullptr;
+    }
+    if (is_tracked) {
+        esp_brookesia::lib_utils::record_free(entry);
+    }
+    esp_brookesia::lib_utils::record_alloc(new_ptr, size, __builtin_return_address(0));
+    return new_ptr;
+}
+
+void free(void *ptr) noexcept
+{
+    LiveEntry entry = {};
+    if (esp_brookesia::lib_utils::take_entry(ptr, entry)) {
+        esp_brookesia::lib_utils::record_free(entry);
+    }
+    __libc_free(ptr);
+}
+
+__attribute__((noinline)) int posix_memalign(void **memptr, size_t alignment, size_t size) noexcept
+{
+    if ((alignment % sizeof(void *) != 0) || ((alignment & (alignment - 1)) != 0) || (alignment == 0)) {
+        return EINVAL;
+    }
+    void *ptr = __libc_memalign(alignment, size);
+    if (ptr == nullptr) {
+        return ENOMEM;
+    }
+    esp_brookesia::lib_utils::record_alloc(ptr, size, __builtin_return_address(0));
+    *memptr = ptr;
+    return 0;
+}
+
+__attribute__((noinline)) void *aligned_alloc(size_t alignment, size_t size) noexcept
+{
+    void *ptr = __libc_memalign(alignment, size);
+    esp_brookesia::lib_utils::record_alloc(ptr, size, __builtin_return_address(0));
+    return ptr;
+}
+
+__attribute__((noinline)) void *memalign(size_t alignment, size_t size) noexcept
+{
+    void *ptr = __libc_memalign(alignment, size);
+    esp_brookesia::lib_utils::record_alloc(ptr, size, __builtin_return_address(0));
+    return ptr;
+}
+
+} // extern "C"
+
+/*
+ * `operator new` is replaced as well, otherwise all the C++ allocations would be attributed to libstdc++. The
+ * default `operator delete` calls `free()`, so it does not need to be replaced.
+ */
+__attribute__((noinline)) void *operator new(std::size_t size)
+{
+    return esp_brookesia::lib_utils::allocate_new(size, __builtin_return_address(0));
+}
+
+__attribute__((noinline)) void *operator new[](std::size_t size)
+{
+    return esp_brookesia::lib_utils::allocate_new(size, __builtin_return_address(0));
+}
+
+__attribute__((noinline)) void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    try {
+        return esp_brookesia::lib_utils::allocate_new(size, __builtin_return_address(0));
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+__attribute__((noinline)) void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    try {
+        return esp_brookesia::lib_utils::allocate_new(size, __builtin_return_address(0));
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+#else
+
+namespace esp_brookesia::lib_utils {
+
+bool AllocTracker::get_summary(Summary &summary)
+{
+    (void)summary;
+    return false;
+}
+
+bool AllocTracker::get_churn_report(Report &report, size_t max_sites)
+{
+    (void)report;
+    (void)max_sites;
+    return false;
+}
+
+bool AllocTracker::get_leak_report(Report &report, size_t max_sites)
+{
+    (void)report;
+    (void)max_sites;
+    return false;
+}
+
+void AllocTracker::mark()
+{
+}
+
+void AllocTracker::reset()
+{
+}
+
+void AllocTracker::print_churn_report(size_t max_sites)
+{
+    (void)max_sites;
+    BROOKESIA_LOGW("Allocation tracker is not available");
+}
+
+void AllocTracker::print_leak_report(size_t max_sites)
+{
+    (void)max_sites;
+    BROOKESIA_LOGW("Allocation tracker is not available");
+}
+
+} // namespace esp_brookesia::lib_utils
+
+#endif // BROOKESIA_UTILS_ALLOC_TRACKER_AVAILABLE
@@ -7,7 +7,13 @@
 #include <iomanip>
 #include <sstream>
 #include <ctime>
-#include "esp_heap_caps.h"
+#if defined(ESP_PLATFORM)
+#   include "esp_heap_caps.h"
+#else
+#   include <fstream>
+#   include <malloc.h>
+#   include <unistd.h>
+#endif
 #include "brookesia/lib_utils/macro_configs.h"
 #if !BROOKESIA_UTILS_MEMORY_PROFILER_ENABLE_DEBUG_LOG
 #   define BROOKESIA_LOG_DISABLE_DEBUG_TRACE 1
@@ -17,11 +23,53 @@
 #include "brookesia/lib_utils/check.hpp"
 #include "brookesia/lib_utils/function_guard.hpp"
 #include "brookesia/lib_utils/task_scheduler.hpp"
+#include "brookesia/lib_utils/alloc_tracker.hpp"
 #include "brookesia/lib_utils/memory_profiler.hpp"
 
 namespace esp_brookesia::lib_utils {
 
 constexpr uint32_t MEMORY_PROFILER_STOP_TIMEOUT_MS = 100;
+// Sampling may be slightly late, so that it shares a wake-up with other timers
+constexpr TaskScheduler::TaskOptions PROFILING_TASK_OPTIONS = {
+    .priority = TaskScheduler::TaskPriority::Low,
+    .slack_ms = 50,
+};
+
+#if !defined(ESP_PLATFORM)
+namespace {
+
+size_t get_host_heap_used()
+{
+    // Prefer the allocation tracker, it also counts the memory served by `mmap()` and is not affected by the arenas
+    AllocTracker::Summary summary;
+    if (AllocTracker::get_summary(summary)) {
+        return summary.live_bytes;
+    }
+#   if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 33))
+    auto info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#   else
+    return 0;
+#   endif
+}
+
+size_t get_host_available_memory()
+{
+    std::ifstream meminfo("/proc/meminfo");
+    std::string key;
+    size_t value_kb = 0;
+    std::string unit;
+    while (meminfo >> key >> value_kb >> unit) {
+        if (key == "MemAvailable:") {
+            return value_kb * 1024;
+        }
+    }
+
+    return static_cast<size_t>(sysconf(_SC_AVPHYS_PAGES)) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+} // namespace
+#endif
 
 MemoryProfiler::Statistics::Statistics(const MemoryInfo &cur_memory, const Statistics &last_stats)
     : sample_count(last_stats.sample_count + 1)
@@ -139,7 +187,7 @@ bool MemoryProfiler::start_profiling(std::shared_ptr<TaskScheduler> scheduler, u
         return true;
     };
     BROOKESIA_CHECK_FALSE_RETURN(
-        scheduler->post_periodic(profiling_task, period_ms, &profiling_task_id_), false,
+        scheduler->post_periodic(profiling_task, period_ms, &profiling_task_id_, "", PROFILING_TASK_OPTIONS), false,
         "Failed to schedule profiling task"
     );
 
@@ -270,7 +318,11 @@ void MemoryProfiler::print_snapshot(const ProfileSnapshot &snapshot)
     oss << header_separator << "\n";
 
     // Internal SRAM
+#if defined(ESP_PLATFORM)
     oss << "| " << std::left << std::setw(17) << "Internal (SRAM)"
+#else
+    oss << "| " << std::left << std::setw(17) << "Host (Process)"
+#endif
         << " | " << std::right << std::fixed << std::setprecision(3) << std::setw(11) << (snapshot.memory.internal.total_size / 1024)
         << " | " << std::setw(11) << (snapshot.memory.internal.free_size / 1024)
         << " | " << std::setw(12) << static_cast<size_t>(snapshot.memory.internal.largest_free_block / 1024)
@@ -411,6 +463,7 @@ void MemoryProfiler::sample_memory(MemoryInfo &mem_info)
 {
     BROOKESIA_LOG_TRACE_GUARD();
 
+#if defined(ESP_PLATFORM)
     // Sample internal SRAM
     size_t internal_total = heap_caps_get_total_size(MALLOC_CAP_INTERNAL);
     size_t internal_free = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
@@ -427,6 +480,23 @@ void MemoryProfiler::sample_memory(MemoryInfo &mem_info)
     mem_info.total_free = internal_free + external_free;
     mem_info.total_free_percent = mem_info.total_free * 100 / mem_info.total_size;
     mem_info.total_largest_free_block = std::max(internal_largest, external_largest);
+#else
+    // The heap of the process is reported as the internal memory, there is no external memory on the host. Its size
+    // is `BROOKESIA_UTILS_MEMORY_PROFILER_HOST_HEAP_SIZE` if set, so the thresholds of a device can be reused as is
+    size_t heap_used = get_host_heap_used();
+    size_t heap_total = BROOKESIA_UTILS_MEMORY_PROFILER_HOST_HEAP_SIZE;
+    if (heap_total == 0) {
+        heap_total = heap_used + get_host_available_memory();
+    }
+    size_t heap_free = (heap_total > heap_used) ? (heap_total - heap_used) : 0;
+    mem_info.internal = HeapInfo(heap_total, heap_free, heap_free);
+    mem_info.external = HeapInfo();
+
+    mem_info.total_size = heap_total;
+    mem_info.total_free = heap_free;
+    mem_info.total_free_percent = (heap_total > 0) ? (heap_free * 100 / heap_total) : 0;
+    mem_info.total_largest_free_block = heap_free;
+#endif
 }
 
 bool MemoryProfiler::check_threshold(const ProfileSnapshot &snapshot, ThresholdType type, uint32_t threshold_value)
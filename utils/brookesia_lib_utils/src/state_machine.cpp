@@ -3,6 +3,8 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <algorithm>
+#include <set>
 #include "brookesia/lib_utils/macro_configs.h"
 #if !BROOKESIA_UTILS_STATIC_MACHINE_ENABLE_DEBUG_LOG
 #   define BROOKESIA_LOG_DISABLE_DEBUG_TRACE 1
@@ -16,6 +18,18 @@
 namespace esp_brookesia::lib_utils {
 
 constexpr uint32_t STATE_MACHINE_STOP_TIMEOUT_MS = 100;
+// Transitions usually drive user feedback, so they run ahead of background work
+constexpr TaskScheduler::TaskOptions TRANSITION_TASK_OPTIONS = {.priority = TaskScheduler::TaskPriority::High};
+
+// Binary search in the sorted names of the compiled tables
+static uint16_t find_id(const std::vector<std::string> &names, const std::string &name)
+{
+    auto it = std::lower_bound(names.begin(), names.end(), name);
+    if ((it == names.end()) || (*it != name)) {
+        return StateMachine::INVALID_ID;
+    }
+    return static_cast<uint16_t>(it - names.begin());
+}
 
 StateMachine::~StateMachine()
 {
@@ -37,6 +51,7 @@ bool StateMachine::add_state(const std::string &name, StatePtr state)
     BROOKESIA_CHECK_NULL_RETURN(state, false, "Invalid argument");
 
     boost::lock_guard lock(mutex_);
+    BROOKESIA_CHECK_FALSE_RETURN(!is_compiled_, false, "Cannot add state '%1%' after compiling", name);
     BROOKESIA_CHECK_FALSE_RETURN(states_.find(name) == states_.end(), false, "State '%1%' already exists", name);
 
     states_[name] = state;
@@ -51,6 +66,9 @@ bool StateMachine::add_transition(const std::string &from, const std::string &ac
     BROOKESIA_LOGD("Params: from(%1%), action(%2%), to(%3%)", from, action, to);
 
     boost::lock_guard lock(mutex_);
+    BROOKESIA_CHECK_FALSE_RETURN(
+        !is_compiled_, false, "Cannot add transition '%1%' -> '%2%' after compiling", from, action
+    );
     BROOKESIA_CHECK_FALSE_RETURN(
         transitions_[from].find(action) == transitions_[from].end(), false,
         "Transition from '%1%' on action '%2%' already exists", from, action
@@ -61,6 +79,87 @@ bool StateMachine::add_transition(const std::string &from, const std::string &ac
     return true;
 }
 
+bool StateMachine::compile()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    boost::lock_guard lock(mutex_);
+
+    if (is_compiled_) {
+        BROOKESIA_LOGD("Already compiled");
+        return true;
+    }
+
+    BROOKESIA_CHECK_FALSE_RETURN(task_scheduler_ == nullptr, false, "Cannot compile while running");
+
+    // Intern states and actions, `states_` is already sorted by name
+    std::vector<std::string> state_names;
+    std::vector<StatePtr> state_ptrs;
+    state_names.reserve(states_.size());
+    state_ptrs.reserve(states_.size());
+    for (const auto & [name, state] : states_) {
+        state_names.push_back(name);
+        state_ptrs.push_back(state);
+    }
+
+    std::set<std::string> action_set;
+    for (const auto & [from, actions] : transitions_) {
+        for (const auto & [action, to] : actions) {
+            action_set.insert(action);
+        }
+    }
+    std::vector<std::string> action_names(action_set.begin(), action_set.end());
+
+    BROOKESIA_CHECK_FALSE_RETURN(
+        (state_names.size() < INVALID_ID) && (action_names.size() < INVALID_ID), false,
+        "Too many states (%1%) or actions (%2%)", state_names.size(), action_names.size()
+    );
+
+    // Flatten the transitions
+    std::vector<StateId> transition_table(state_names.size() * action_names.size(), INVALID_ID);
+    for (const auto & [from, actions] : transitions_) {
+        auto from_id = find_id(state_names, from);
+        BROOKESIA_CHECK_FALSE_RETURN(
+            from_id != INVALID_ID, false, "Transition from state '%1%' which does not exist", from
+        );
+        for (const auto & [action, to] : actions) {
+            auto to_id = find_id(state_names, to);
+            BROOKESIA_CHECK_FALSE_RETURN(
+                to_id != INVALID_ID, false, "Transition '%1%' -> '%2%' to state '%3%' which does not exist", from,
+                action, to
+            );
+            transition_table[from_id * action_names.size() + find_id(action_names, action)] = to_id;
+        }
+    }
+
+    state_names_ = std::move(state_names);
+    state_ptrs_ = std::move(state_ptrs);
+    action_names_ = std::move(action_names);
+    transition_table_ = std::move(transition_table);
+    is_compiled_ = true;
+
+    BROOKESIA_LOGD(
+        "Compiled %1% states, %2% actions and %3% transitions", state_names_.size(), action_names_.size(),
+        std::count_if(transition_table_.begin(), transition_table_.end(), [](StateId id) {
+        return id != INVALID_ID;
+    })
+    );
+
+    return true;
+}
+
+StateMachine::StateId StateMachine::get_state_id(const std::string &name) const
+{
+    boost::lock_guard lock(mutex_);
+    return is_compiled_ ? find_id(state_names_, name) : INVALID_ID;
+}
+
+StateMachine::ActionId StateMachine::get_action_id(const std::string &action) const
+{
+    boost::lock_guard lock(mutex_);
+    return is_compiled_ ? find_id(action_names_, action) : INVALID_ID;
+}
+
 bool StateMachine::start(std::shared_ptr<TaskScheduler> task_scheduler, const std::string &initial)
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
@@ -75,6 +174,9 @@ bool StateMachine::start(std::shared_ptr<TaskScheduler> task_scheduler, const st
         return true;
     }
 
+    // The transitions always run on the IDs, compile the tables if not done before
+    BROOKESIA_CHECK_FALSE_RETURN(compile(), false, "Failed to compile");
+
     // Ensure scheduler is running
     if (!task_scheduler->is_running()) {
         BROOKESIA_LOGW("Scheduler is not running, starting it...");
@@ -132,7 +234,7 @@ void StateMachine::stop()
         }
         scheduler = task_scheduler_;  // Keep alive during cleanup
         task_scheduler_.reset();      // Clear member to mark as stopped
-        current_state_ = "";
+        set_current_state(INVALID_ID);
     }
 
     // Cancel tasks without holding lock
@@ -151,68 +253,45 @@ bool StateMachine::trigger_action(const std::string &action, bool use_dispatch)
 
     BROOKESIA_LOGD("Params: action(%1%), use_dispatch(%2%)", action, use_dispatch);
 
-    // Get scheduler reference under lock
-    std::shared_ptr<TaskScheduler> scheduler;
+    // Only resolve the name here, the transition goes through the IDs
+    ActionId action_id = INVALID_ID;
     {
         boost::lock_guard lock(mutex_);
         BROOKESIA_CHECK_NULL_RETURN(task_scheduler_, false, "State machine is not running");
-        scheduler = task_scheduler_;
+        action_id = find_id(action_names_, action);
     }
+    BROOKESIA_CHECK_FALSE_RETURN(action_id != INVALID_ID, false, "Action '%1%' does not exist", action);
 
-    // Put action trigger logic into serial queue to avoid concurrency issues
-    auto task = [this, action]() {
-        BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
-
-        std::string last_state;
-        std::string next_state;
-        {
-            boost::lock_guard lock(mutex_);
-
-            BROOKESIA_CHECK_FALSE_EXIT(!current_state_.empty(), "State machine not started");
-
-            auto it = transitions_.find(current_state_);
-            BROOKESIA_CHECK_FALSE_EXIT(
-                it != transitions_.end(), "No transitions defined for state '%1%'", current_state_
-            );
-
-            auto trans_it = it->second.find(action);
-            BROOKESIA_CHECK_FALSE_EXIT(
-                trans_it != it->second.end(), "No transition for action '%1%' in state '%2%'", action, current_state_
-            );
+    return trigger_action(action_id, use_dispatch);
+}
 
-            last_state = current_state_;
-            next_state = trans_it->second;
-        }
+bool StateMachine::trigger_action(ActionId action, bool use_dispatch)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
-        // Call transition_to without holding the lock, passing action as action
-        auto is_success = transition_to(next_state, action);
-        if (!is_success) {
-            BROOKESIA_LOGE("Failed to transition to state '%1%'", next_state);
-            return;
-        }
+    BROOKESIA_LOGD("Params: action(%1%), use_dispatch(%2%)", action, use_dispatch);
 
-        // Get current state and callback without holding lock during callback execution
-        std::string final_state;
-        TransitionFinishCallback callback;
-        {
-            boost::lock_guard lock(mutex_);
-            final_state = current_state_;
-            callback = transition_finish_callback_;
-        }
+    // Get scheduler reference under lock
+    std::shared_ptr<TaskScheduler> scheduler;
+    {
+        boost::lock_guard lock(mutex_);
+        BROOKESIA_CHECK_NULL_RETURN(task_scheduler_, false, "State machine is not running");
+        BROOKESIA_CHECK_FALSE_RETURN(action < action_names_.size(), false, "Invalid action ID %1%", action);
+        scheduler = task_scheduler_;
+    }
 
-        // Call callback without holding the lock
-        if (callback) {
-            callback(last_state, action, final_state);
-        }
+    // Only `this` and the ID are captured, so the task is stored inline by `std::function`
+    auto task = [this, action]() {
+        run_action(action);
     };
     if (use_dispatch) {
         BROOKESIA_CHECK_FALSE_RETURN(
-            scheduler->dispatch(std::move(task), nullptr, task_group_name_), false,
+            scheduler->dispatch(std::move(task), nullptr, task_group_name_, TRANSITION_TASK_OPTIONS), false,
             "Failed to dispatch trigger action task"
         );
     } else {
         BROOKESIA_CHECK_FALSE_RETURN(
-            scheduler->post(std::move(task), nullptr, task_group_name_), false,
+            scheduler->post(std::move(task), nullptr, task_group_name_, TRANSITION_TASK_OPTIONS), false,
             "Failed to post trigger action task"
         );
     }
@@ -251,10 +330,12 @@ bool StateMachine::force_transition_to(const std::string &target_state)
     BROOKESIA_CHECK_FALSE_RETURN(is_running(), false, "Not running");
 
     std::shared_ptr<TaskScheduler> scheduler;
+    StateId target_id = INVALID_ID;
     {
         boost::lock_guard lock(mutex_);
+        target_id = find_id(state_names_, target_state);
         BROOKESIA_CHECK_FALSE_RETURN(
-            states_.find(target_state) != states_.end(), false, "Target state '%1%' does not exist", target_state
+            target_id != INVALID_ID, false, "Target state '%1%' does not exist", target_state
         );
         scheduler = task_scheduler_;
     }
@@ -273,30 +354,25 @@ bool StateMachine::force_transition_to(const std::string &target_state)
     // Transition to target state immediately
     {
         boost::lock_guard lock(mutex_);
-        current_state_ = target_state;
+        set_current_state(target_id);
     }
 
     return true;
 }
 
-bool StateMachine::setup_state_tasks(const std::string &name)
+bool StateMachine::setup_state_tasks(const StatePtr &state)
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
-    BROOKESIA_LOGD("Params: name(%1%)", name);
+    BROOKESIA_LOGD("Params: state(%1%)", state);
+
+    BROOKESIA_CHECK_NULL_RETURN(state, false, "Invalid state");
 
     std::shared_ptr<TaskScheduler> scheduler;
-    StatePtr state;
     {
         boost::lock_guard lock(mutex_);
         BROOKESIA_CHECK_NULL_RETURN(task_scheduler_, false, "Task scheduler is not available");
         scheduler = task_scheduler_;
-
-        auto it = states_.find(name);
-        BROOKESIA_CHECK_FALSE_RETURN(
-            it != states_.end(), false, "Cannot setup tasks for non-existent state '%1%'", name
-        );
-        state = it->second;
     }
 
     // Periodic task (without holding lock, as scheduler operations may be slow)
@@ -321,7 +397,7 @@ bool StateMachine::setup_state_tasks(const std::string &name)
         scheduler->post_delayed([this, ev = state->get_timeout_action()] {
             BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
             BROOKESIA_CHECK_FALSE_EXIT(this->trigger_action(ev, true), "Cannot trigger action '%1%'", ev);
-        }, state->get_timeout_ms(), &task_id, task_group_name_);
+        }, state->get_timeout_ms(), &task_id, task_group_name_, TRANSITION_TASK_OPTIONS);
 
         // Update task_id requires lock protection
         {
@@ -342,16 +418,10 @@ bool StateMachine::enter_initial_state(const std::string &name)
     // Step 1: Cancel any existing tasks (without holding lock)
     cancel_current_tasks();
 
-    // Step 2: Get state object under lock
-    StatePtr state;
-    {
-        boost::lock_guard lock(mutex_);
-        auto it = states_.find(name);
-        BROOKESIA_CHECK_FALSE_RETURN(
-            it != states_.end(), false, "Initial state '%1%' does not exist", name
-        );
-        state = it->second;
-    }
+    // Step 2: Get state object, the tables are read-only once compiled
+    auto id = find_id(state_names_, name);
+    BROOKESIA_CHECK_FALSE_RETURN(id != INVALID_ID, false, "Initial state '%1%' does not exist", name);
+    const auto &state = state_ptrs_[id];
 
     // Step 3: Call on_enter guard (without holding lock to allow state logic to run freely)
     BROOKESIA_CHECK_FALSE_RETURN(
@@ -361,57 +431,89 @@ bool StateMachine::enter_initial_state(const std::string &name)
     // Step 4: Update current state under lock
     {
         boost::lock_guard lock(mutex_);
-        current_state_ = name;
+        set_current_state(id);
     }
 
     // Step 5: Setup state tasks (without holding lock, setup_state_tasks manages its own locks)
-    BROOKESIA_CHECK_FALSE_RETURN(setup_state_tasks(name), false, "Cannot setup tasks for initial state '%1%'", name);
+    BROOKESIA_CHECK_FALSE_RETURN(setup_state_tasks(state), false, "Cannot setup tasks for initial state '%1%'", name);
 
     return true;
 }
 
-bool StateMachine::transition_to(const std::string &next, const std::string &action)
+void StateMachine::run_action(ActionId action)
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
-    BROOKESIA_LOGD("Params: next(%1%), action(%2%)", next, action);
+    // The tables are read-only once compiled, only the current state needs the lock
+    StateId last_state = INVALID_ID;
+    StateId next_state = INVALID_ID;
+    {
+        boost::lock_guard lock(mutex_);
 
-    std::string previous_state;
-    StatePtr current_state_obj;
-    StatePtr next_state_obj;
+        BROOKESIA_CHECK_FALSE_EXIT(current_state_id_ != INVALID_ID, "State machine not started");
 
-    // Step 1: Validate transition and get state objects under lock
+        next_state = transition_table_[current_state_id_ * action_names_.size() + action];
+        BROOKESIA_CHECK_FALSE_EXIT(
+            next_state != INVALID_ID, "No transition for action '%1%' in state '%2%'", action_names_[action],
+            state_names_[current_state_id_]
+        );
+
+        last_state = current_state_id_;
+    }
+
+    auto is_success = transition_to(next_state, action);
+    if (!is_success) {
+        BROOKESIA_LOGE("Failed to transition to state '%1%'", state_names_[next_state]);
+        return;
+    }
+
+    // Get current state and callback without holding lock during callback execution
+    StateId final_state = INVALID_ID;
+    std::shared_ptr<TransitionFinishCallback> callback;
+    {
+        boost::lock_guard lock(mutex_);
+        final_state = current_state_id_;
+        callback = transition_finish_callback_;
+    }
+
+    // Call callback without holding the lock, the names are the interned ones
+    if (callback && (final_state != INVALID_ID)) {
+        (*callback)(state_names_[last_state], action_names_[action], state_names_[final_state]);
+    }
+}
+
+bool StateMachine::transition_to(StateId next, ActionId action)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    const auto &next_name = state_names_[next];
+    const auto &action_name = action_names_[action];
+
+    BROOKESIA_LOGD("Params: next(%1%), action(%2%)", next_name, action_name);
+
+    // Step 1: Validate transition under lock
+    StateId previous = INVALID_ID;
     {
         boost::lock_guard lock(mutex_);
 
         // Ignore self-transition
-        if (current_state_ == next) {
-            BROOKESIA_LOGD("Ignoring self-transition to '%1%'", next);
+        if (current_state_id_ == next) {
+            BROOKESIA_LOGD("Ignoring self-transition to '%1%'", next_name);
             return true;
         }
 
-        // Verify current state exists
-        auto current_it = states_.find(current_state_);
-        BROOKESIA_CHECK_FALSE_RETURN(
-            current_it != states_.end(), false, "Current state '%1%' does not exist", current_state_
-        );
-
-        // Verify next state exists
-        auto next_it = states_.find(next);
-        BROOKESIA_CHECK_FALSE_RETURN(
-            next_it != states_.end(), false, "Next state '%1%' does not exist", next
-        );
-
-        previous_state = current_state_;
-        current_state_obj = current_it->second;
-        next_state_obj = next_it->second;
+        BROOKESIA_CHECK_FALSE_RETURN(current_state_id_ != INVALID_ID, false, "Current state does not exist");
+        previous = current_state_id_;
     }
 
+    const auto &previous_name = state_names_[previous];
+    const auto &current_state_obj = state_ptrs_[previous];
+    const auto &next_state_obj = state_ptrs_[next];
+
     // Step 2: Exit current state (without holding lock to allow state logic to run freely)
-    BROOKESIA_LOGD("Exiting state '%1%' to '%2%' by action '%3%'", previous_state, next, action);
-    auto is_success = current_state_obj->on_exit(next, action);
-    if (!is_success) {
-        BROOKESIA_LOGE("Exit denied: cannot exit '%1%' to '%2%'", previous_state, next);
+    BROOKESIA_LOGD("Exiting state '%1%' to '%2%' by action '%3%'", previous_name, next_name, action_name);
+    if (!current_state_obj->on_exit(next_name, action_name)) {
+        BROOKESIA_LOGE("Exit denied: cannot exit '%1%' to '%2%'", previous_name, next_name);
         return false;
     }
 
@@ -419,24 +521,23 @@ bool StateMachine::transition_to(const std::string &next, const std::string &act
     cancel_current_tasks();
 
     // Step 4: Enter new state (without holding lock to allow state logic to run freely)
-    BROOKESIA_LOGD("Entering state '%1%' from '%2%' by action '%3%'", next, previous_state, action);
-    if (!next_state_obj->on_enter(previous_state, action)) {
+    BROOKESIA_LOGD("Entering state '%1%' from '%2%' by action '%3%'", next_name, previous_name, action_name);
+    if (!next_state_obj->on_enter(previous_name, action_name)) {
         // Entry failed, rollback to original state
-        BROOKESIA_LOGE("Entry denied: cannot enter '%1%' from '%2%'", next, previous_state);
-        BROOKESIA_LOGW("Rolling back to state '%1%'", previous_state);
+        BROOKESIA_LOGE("Entry denied: cannot enter '%1%' from '%2%'", next_name, previous_name);
+        BROOKESIA_LOGW("Rolling back to state '%1%'", previous_name);
 
         // Re-enter previous state (best effort rollback)
         current_state_obj->on_enter("");
 
-        // Restore previous state under lock
         {
             boost::lock_guard lock(mutex_);
-            current_state_ = previous_state;
+            set_current_state(previous);
         }
 
-        // Re-setup tasks for previous state (setup_state_tasks manages its own locks)
         BROOKESIA_CHECK_FALSE_RETURN(
-            setup_state_tasks(previous_state), false, "Cannot setup tasks for state '%1%' during rollback", previous_state
+            setup_state_tasks(current_state_obj), false, "Cannot setup tasks for state '%1%' during rollback",
+            previous_name
         );
         return false;
     }
@@ -444,16 +545,24 @@ bool StateMachine::transition_to(const std::string &next, const std::string &act
     // Step 5: Successful transition - update state and setup new tasks
     {
         boost::lock_guard lock(mutex_);
-        current_state_ = next;
+        set_current_state(next);
     }
 
-    // Setup tasks for new state (setup_state_tasks manages its own locks)
-    BROOKESIA_CHECK_FALSE_RETURN(setup_state_tasks(next), false, "Cannot setup tasks for state '%1%'", next);
+    BROOKESIA_CHECK_FALSE_RETURN(
+        setup_state_tasks(next_state_obj), false, "Cannot setup tasks for state '%1%'", next_name
+    );
 
-    BROOKESIA_LOGD("Successfully transitioned from '%1%' to '%2%'", previous_state, next);
+    BROOKESIA_LOGD("Successfully transitioned from '%1%' to '%2%'", previous_name, next_name);
     return true;
 }
 
+void StateMachine::set_current_state(StateId id)
+{
+    current_state_id_ = id;
+    // Reuses the capacity of `current_state_`, no allocation once it fits the longest name
+    current_state_ = (id != INVALID_ID) ? state_names_[id] : std::string();
+}
+
 void StateMachine::cancel_current_tasks()
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
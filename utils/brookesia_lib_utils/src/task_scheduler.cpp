@@ -3,11 +3,13 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <algorithm>
 #include "brookesia/lib_utils/macro_configs.h"
 #if !BROOKESIA_UTILS_TASK_SCHEDULER_ENABLE_DEBUG_LOG
 #   define BROOKESIA_LOG_DISABLE_DEBUG_TRACE 1
 #endif
 #include "private/utils.hpp"
+#include "brookesia/lib_utils/alloc_tracker.hpp"
 #include "brookesia/lib_utils/check.hpp"
 #include "brookesia/lib_utils/describe_helpers.hpp"
 #include "brookesia/lib_utils/function_guard.hpp"
@@ -56,11 +58,25 @@ bool TaskScheduler::start(const StartConfig &config)
                          ), false, "Failed to create work guard"
     );
 
-    reset_statistics();
+    reset_statistics_internal();
 
     // Save callbacks from config
     pre_execute_callback_ = config.pre_execute_callback;
     post_execute_callback_ = config.post_execute_callback;
+    dispatch_policy_ = config.dispatch_policy;
+    timer_backend_ = config.timer_backend;
+    if (timer_backend_ == TimerBackend::TimingWheel) {
+        BROOKESIA_CHECK_EXCEPTION_RETURN(
+            timing_wheel_ = std::make_unique<TimingWheel<WheelTimer>>(
+                                std::chrono::milliseconds(config.timing_wheel_tick_ms)
+                            ), false, "Failed to create timing wheel"
+        );
+        BROOKESIA_CHECK_EXCEPTION_RETURN(
+            wheel_timer_ = std::make_shared<boost::asio::steady_timer>(*io_context_), false,
+            "Failed to create timing wheel timer"
+        );
+        is_wheel_timer_armed_ = false;
+    }
 
     for (const auto &thread_config : config.worker_configs) {
         auto thread_func =
@@ -116,10 +132,8 @@ void TaskScheduler::stop()
         task_count = tasks_.size();
         for (auto& [id, handle] : tasks_) {
             handle->state = TaskState::Canceled;
-            if (handle->timer) {
-                handle->timer->cancel();
-                handle->timer.reset(); // Immediately release timer
-            }
+            disarm_timer_internal(*handle);
+            handle->timer.reset(); // Immediately release timer
             // Set promise value for canceled task
             bool expected = false;
             if (handle->promise && handle->promise_fulfilled.compare_exchange_strong(expected, true)) {
@@ -145,8 +159,14 @@ void TaskScheduler::stop()
         boost::lock_guard<boost::mutex> lock(mutex_);
         tasks_.clear();
         groups_.clear();
-        strands_.clear();
         group_configs_.clear();
+        // Hold timers and handles of the io_context, released before it
+        group_orders_.clear();
+        ready_tasks_.clear();
+        group_runtimes_.clear();
+        timing_wheel_.reset();
+        wheel_timer_.reset();
+        wheel_expired_timers_.clear();
         io_work_guard_.reset();
         io_context_.reset();
     }
@@ -156,18 +176,26 @@ void TaskScheduler::stop()
     );
 }
 
-bool TaskScheduler::post_internal(OnceTask task, TaskId *id, const Group &group, bool enable_immediate)
+bool TaskScheduler::post_internal(
+    OnceTask task, TaskId *id, const Group &group, const TaskOptions &options, bool enable_immediate
+)
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
-    BROOKESIA_LOGD("Params: group(%1%), id(%2%), enable_immediate(%3%)", group, id, enable_immediate);
+    BROOKESIA_LOGD(
+        "Params: group(%1%), id(%2%), options(%3%), enable_immediate(%4%)", group, id,
+        BROOKESIA_DESCRIBE_TO_STR(options), enable_immediate
+    );
 
-    auto handle = create_handle(TaskType::Immediate, false, 0, group);
+    auto handle = create_handle(TaskType::Immediate, false, 0, group, options);
     BROOKESIA_CHECK_NULL_RETURN(handle, false, "Failed to create task handle");
 
     auto task_wrapper = [this, handle, task = std::move(task), enable_immediate]() {
         BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
+        // Attribute the allocations of the task to its group (host only)
+        AllocTracker::ScopedTag alloc_tag(handle->group);
+
         // Invoke pre-execute callback when task is about to execute
         invoke_pre_execute_callback(handle->id, handle->type);
 
@@ -194,28 +222,27 @@ bool TaskScheduler::post_internal(OnceTask task, TaskId *id, const Group &group,
         success = true;
     };
 
-    // Check if group has strand configured
-    std::shared_ptr<boost::asio::strand<boost::asio::io_context::executor_type>> strand;
+    // Check if the tasks of the group are executed in order, and if this is dispatched by the task of the group
+    bool is_in_order = false;
+    bool is_in_group_task = false;
     {
         boost::lock_guard<boost::mutex> lock(mutex_);
-        auto strand_it = strands_.find(group);
-        if (strand_it != strands_.end()) {
-            strand = strand_it->second;
+        auto order_it = group_orders_.find(group);
+        if (order_it != group_orders_.end()) {
+            is_in_order = true;
+            is_in_group_task = (order_it->second.executing_thread == boost::this_thread::get_id());
         }
     }
 
-    if (strand) {
-        if (enable_immediate) {
-            boost::asio::dispatch(*strand, std::move(task_wrapper));
-        } else {
-            boost::asio::post(*strand, std::move(task_wrapper));
-        }
+    if (is_in_order && !(enable_immediate && is_in_group_task)) {
+        // Keep the posting order of the group, each task still enters the ready queue with its priority
+        enqueue_in_order(handle, std::move(task_wrapper));
+    } else if (enable_immediate && (is_in_group_task || io_context_->get_executor().running_in_this_thread())) {
+        // Dispatched within a task, execute it immediately instead of queuing it
+        auto ready = make_ready_task(handle, std::move(task_wrapper));
+        execute_ready(ready, false);
     } else {
-        if (enable_immediate) {
-            boost::asio::dispatch(*io_context_, std::move(task_wrapper));
-        } else {
-            boost::asio::post(*io_context_, std::move(task_wrapper));
-        }
+        enqueue_ready(handle, std::move(task_wrapper));
     }
 
     if (id) {
@@ -227,27 +254,50 @@ bool TaskScheduler::post_internal(OnceTask task, TaskId *id, const Group &group,
 
 bool TaskScheduler::dispatch(OnceTask task, TaskId *id, const Group &group)
 {
-    return post_internal(std::move(task), id, group, true);
+    return post_internal(std::move(task), id, group, TaskOptions{}, true);
+}
+
+bool TaskScheduler::dispatch(OnceTask task, TaskId *id, const Group &group, const TaskOptions &options)
+{
+    return post_internal(std::move(task), id, group, options, true);
 }
 
 bool TaskScheduler::post(OnceTask task, TaskId *id, const Group &group)
 {
-    return post_internal(std::move(task), id, group, false);
+    return post_internal(std::move(task), id, group, TaskOptions{}, false);
+}
+
+bool TaskScheduler::post(OnceTask task, TaskId *id, const Group &group, const TaskOptions &options)
+{
+    return post_internal(std::move(task), id, group, options, false);
 }
 
 bool TaskScheduler::post_delayed(OnceTask task, int delay_ms, TaskId *id, const Group &group)
+{
+    return post_delayed(std::move(task), delay_ms, id, group, TaskOptions{});
+}
+
+bool TaskScheduler::post_delayed(
+    OnceTask task, int delay_ms, TaskId *id, const Group &group, const TaskOptions &options
+)
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
-    BROOKESIA_LOGD("Params: delay_ms(%1%), group(%2%), id(%3%)", delay_ms, group, id);
+    BROOKESIA_LOGD(
+        "Params: delay_ms(%1%), group(%2%), id(%3%), options(%4%)", delay_ms, group, id,
+        BROOKESIA_DESCRIBE_TO_STR(options)
+    );
 
-    auto handle = create_handle(TaskType::Delayed, false, delay_ms, group);
+    auto handle = create_handle(TaskType::Delayed, false, delay_ms, group, options);
     BROOKESIA_CHECK_NULL_RETURN(handle, false, "Failed to create task handle");
 
     // Save task for suspend/resume support (copy before move)
     handle->saved_task = task;
 
-    schedule_once(handle, std::move(task));
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        schedule_once_internal(handle, std::move(task));
+    }
 
     if (id) {
         *id = handle->id;
@@ -256,18 +306,31 @@ bool TaskScheduler::post_delayed(OnceTask task, int delay_ms, TaskId *id, const
 }
 
 bool TaskScheduler::post_periodic(PeriodicTask task, int interval_ms, TaskId *id, const Group &group)
+{
+    return post_periodic(std::move(task), interval_ms, id, group, TaskOptions{});
+}
+
+bool TaskScheduler::post_periodic(
+    PeriodicTask task, int interval_ms, TaskId *id, const Group &group, const TaskOptions &options
+)
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
-    BROOKESIA_LOGD("Params: interval_ms(%1%), group(%2%), id(%3%)", interval_ms, group, id);
+    BROOKESIA_LOGD(
+        "Params: interval_ms(%1%), group(%2%), id(%3%), options(%4%)", interval_ms, group, id,
+        BROOKESIA_DESCRIBE_TO_STR(options)
+    );
 
-    auto handle = create_handle(TaskType::Periodic, true, interval_ms, group);
+    auto handle = create_handle(TaskType::Periodic, true, interval_ms, group, options);
     BROOKESIA_CHECK_NULL_RETURN(handle, false, "Failed to create task handle");
 
     // Save task for suspend/resume support
     handle->saved_periodic_task = task;
 
-    schedule_periodic(handle, std::move(task));
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        schedule_periodic_internal(handle, std::move(task));
+    }
 
     if (id) {
         *id = handle->id;
@@ -276,10 +339,17 @@ bool TaskScheduler::post_periodic(PeriodicTask task, int interval_ms, TaskId *id
 }
 
 bool TaskScheduler::post_batch(std::vector<OnceTask> tasks, std::vector<TaskId> *ids, const Group &group)
+{
+    return post_batch(std::move(tasks), ids, group, TaskOptions{});
+}
+
+bool TaskScheduler::post_batch(
+    std::vector<OnceTask> tasks, std::vector<TaskId> *ids, const Group &group, const TaskOptions &options
+)
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
-    BROOKESIA_LOGD("Params: group(%1%)", group);
+    BROOKESIA_LOGD("Params: group(%1%), options(%2%)", group, BROOKESIA_DESCRIBE_TO_STR(options));
 
     if (ids) {
         ids->clear();
@@ -288,7 +358,7 @@ bool TaskScheduler::post_batch(std::vector<OnceTask> tasks, std::vector<TaskId>
 
     for (auto &task : tasks) {
         TaskId task_id = 0;
-        if (!post(OnceTask(std::move(task)), &task_id, group)) {
+        if (!post(OnceTask(std::move(task)), &task_id, group, options)) {
             BROOKESIA_LOGE("Failed to post task in batch");
             return false;
         }
@@ -628,38 +698,79 @@ TaskScheduler::Statistics TaskScheduler::get_statistics() const
     stats.failed_tasks = failed_tasks_.load();
     stats.canceled_tasks = canceled_tasks_.load();
     stats.suspended_tasks = suspended_tasks_.load();
+    stats.deadline_missed_tasks = deadline_missed_tasks_.load();
+    stats.timer_wakeups = timer_wakeups_.load();
 
     return stats;
 }
 
+TaskScheduler::GroupStatistics TaskScheduler::get_group_statistics(const Group &group) const
+{
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    auto it = group_statistics_.find(group);
+
+    return (it != group_statistics_.end()) ? it->second : GroupStatistics{};
+}
+
 void TaskScheduler::reset_statistics()
+{
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    reset_statistics_internal();
+}
+
+void TaskScheduler::reset_statistics_internal()
 {
     total_tasks_ = 0;
     completed_tasks_ = 0;
     failed_tasks_ = 0;
     canceled_tasks_ = 0;
     suspended_tasks_ = 0;
+    deadline_missed_tasks_ = 0;
+    timer_wakeups_ = 0;
+    group_statistics_.clear();
 }
 
 bool TaskScheduler::configure_group(const Group &group, const GroupConfig &config)
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
-    BROOKESIA_LOGD("Params: group(%1%), enable_post_execute_in_order(%2%)", group, config.enable_post_execute_in_order);
+    BROOKESIA_LOGD("Params: group(%1%), config(%2%)", group, BROOKESIA_DESCRIBE_TO_STR(config));
 
     BROOKESIA_CHECK_FALSE_RETURN(is_running(), false, "Not running");
     BROOKESIA_CHECK_FALSE_RETURN(!group.empty(), false, "Group name cannot be empty");
+    BROOKESIA_CHECK_FALSE_RETURN(
+        (config.cpu_quota_ms == 0) || (config.cpu_quota_period_ms > 0), false, "CPU quota period cannot be zero"
+    );
 
     boost::lock_guard<boost::mutex> lock(mutex_);
 
     group_configs_[group] = config;
 
-    // Create strand for group if configured
-    if (config.enable_post_execute_in_order && strands_.find(group) == strands_.end()) {
-        strands_[group] = std::make_shared<boost::asio::strand<boost::asio::io_context::executor_type>>(
-                              io_context_->get_executor()
-                          );
-        BROOKESIA_LOGD("Created strand for group '%1%'", group);
+    // Track the running tasks and the CPU time of the group only if it has quotas
+    if ((config.max_concurrent_tasks > 0) || (config.cpu_quota_ms > 0)) {
+        auto &runtime = group_runtimes_[group];
+        if (!runtime.period_timer) {
+            runtime.period_timer = std::make_shared<boost::asio::steady_timer>(*io_context_);
+            runtime.period_start = std::chrono::steady_clock::now();
+        }
+    } else {
+        auto runtime_it = group_runtimes_.find(group);
+        if (runtime_it != group_runtimes_.end()) {
+            runtime_it->second.period_timer->cancel();
+            group_runtimes_.erase(runtime_it);
+            // The ready tasks held back by the removed quotas need a worker
+            for (size_t i = 0; i < ready_tasks_.size(); i++) {
+                boost::asio::post(*io_context_, [this]() {
+                    run_next_ready();
+                });
+            }
+        }
+    }
+
+    // Create the order state of the group if configured
+    if (config.enable_post_execute_in_order && (group_orders_.find(group) == group_orders_.end())) {
+        group_orders_[group] = GroupOrder{};
+        BROOKESIA_LOGD("Created order state for group '%1%'", group);
     }
 
     return true;
@@ -701,7 +812,7 @@ bool TaskScheduler::wait_tasks_internal(const std::vector<TaskId> &task_ids, int
 }
 
 std::shared_ptr<TaskScheduler::TaskHandle> TaskScheduler::create_handle(
-    TaskType type, bool repeat, int interval_ms, const Group &group)
+    TaskType type, bool repeat, int interval_ms, const Group &group, const TaskOptions &options)
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
@@ -720,7 +831,13 @@ std::shared_ptr<TaskScheduler::TaskHandle> TaskScheduler::create_handle(
     handle->repeat = repeat;
     handle->interval_ms = interval_ms;
     handle->group = group;
-    handle->timer = std::make_shared<boost::asio::steady_timer>(*io_context_);
+    handle->options = options;
+    // Immediate tasks need no timer, and the timing wheel backend shares a single one
+    if ((type != TaskType::Immediate) && (timer_backend_ == TimerBackend::Asio)) {
+        BROOKESIA_CHECK_EXCEPTION_RETURN(
+            handle->timer = std::make_shared<boost::asio::steady_timer>(*io_context_), nullptr, "Failed to create timer"
+        );
+    }
     handle->promise = std::make_shared<std::promise<bool>>();
     handle->future = handle->promise->get_future().share();
 
@@ -739,31 +856,16 @@ std::shared_ptr<TaskScheduler::TaskHandle> TaskScheduler::create_handle(
     return handle;
 }
 
-void TaskScheduler::schedule_once(std::shared_ptr<TaskHandle> handle, OnceTask task)
+void TaskScheduler::schedule_once_internal(std::shared_ptr<TaskHandle> handle, OnceTask task)
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
     BROOKESIA_LOGD("Params: handle(%1%)", handle->id);
 
-    handle->timer->expires_after(std::chrono::milliseconds(handle->interval_ms));
-    handle->timer->async_wait([this, handle, task = std::move(task)](const boost::system::error_code & ec) {
-        BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
-
-        BROOKESIA_LOGD("Params: ec(%1%)", ec);
-
-        // If suspended, don't remove the task - it will be resumed later
-        if (handle->state == TaskState::Suspended) {
-            BROOKESIA_LOGD(
-                "Task %1% is %2%, keeping it alive", handle->id, BROOKESIA_DESCRIBE_TO_STR(handle->state.load())
-            );
-            return;
-        }
-
-        if (ec || handle->state == TaskState::Canceled) {
-            boost::lock_guard<boost::mutex> lock(mutex_);
-            remove_task_internal(handle->id, handle->group);
-            return;
-        }
+    // Executed by a worker in the order of the dispatch policy
+    arm_timer_internal(handle, handle->interval_ms, [this, handle, task = std::move(task)]() {
+        // Attribute the allocations of the task to its group (host only)
+        AllocTracker::ScopedTag alloc_tag(handle->group);
 
         // Invoke pre-execute callback when task is about to execute
         invoke_pre_execute_callback(handle->id, handle->type);
@@ -786,30 +888,16 @@ void TaskScheduler::schedule_once(std::shared_ptr<TaskHandle> handle, OnceTask t
     });
 }
 
-void TaskScheduler::schedule_periodic(std::shared_ptr<TaskHandle> handle, PeriodicTask task)
+void TaskScheduler::schedule_periodic_internal(std::shared_ptr<TaskHandle> handle, PeriodicTask task)
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
 
-    handle->timer->expires_after(std::chrono::milliseconds(handle->interval_ms));
-    handle->timer->async_wait([this, handle, task](const boost::system::error_code & ec) {
-        BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
-
-        BROOKESIA_LOGD("Params: ec(%1%)", ec);
-
-        // If suspended, don't remove the task - it will be resumed later
-        if (handle->state == TaskState::Suspended) {
-            BROOKESIA_LOGD(
-                "Periodic task %1% is %2%, keeping it alive", handle->id,
-                BROOKESIA_DESCRIBE_TO_STR(handle->state.load())
-            );
-            return;
-        }
+    BROOKESIA_LOGD("Params: handle(%1%)", handle->id);
 
-        if (ec || handle->state == TaskState::Canceled) {
-            boost::lock_guard<boost::mutex> lock(mutex_);
-            remove_task_internal(handle->id, handle->group);
-            return;
-        }
+    // Executed by a worker in the order of the dispatch policy
+    arm_timer_internal(handle, handle->interval_ms, [this, handle, task]() {
+        // Attribute the allocations of the task to its group (host only)
+        AllocTracker::ScopedTag alloc_tag(handle->group);
 
         // Invoke pre-execute callback when task is about to execute
         invoke_pre_execute_callback(handle->id, handle->type);
@@ -821,7 +909,8 @@ void TaskScheduler::schedule_periodic(std::shared_ptr<TaskHandle> handle, Period
 
             if (should_continue && handle->repeat && handle->state == TaskState::Running) {
                 // Task will continue, not finished yet
-                schedule_periodic(handle, task);
+                boost::lock_guard<boost::mutex> lock(mutex_);
+                schedule_periodic_internal(handle, task);
             } else {
                 // Task is finished
                 mark_finished(handle, true);
@@ -843,6 +932,417 @@ void TaskScheduler::schedule_periodic(std::shared_ptr<TaskHandle> handle, Period
     });
 }
 
+void TaskScheduler::arm_timer_internal(std::shared_ptr<TaskHandle> handle, int delay_ms, OnceTask run)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_LOGD("Params: handle(%1%), delay_ms(%2%)", handle->id, delay_ms);
+
+    handle->timer_expiry = std::chrono::steady_clock::now() + std::chrono::milliseconds(delay_ms);
+
+    if (timer_backend_ == TimerBackend::TimingWheel) {
+        if (!timing_wheel_) {
+            BROOKESIA_LOGD("Scheduler stopped, skip task %1%", handle->id);
+            return;
+        }
+        auto slack = std::chrono::milliseconds(std::max(handle->options.slack_ms, 0));
+        handle->wheel_timer_id = timing_wheel_->add(handle->timer_expiry, slack, WheelTimer{handle, std::move(run)});
+        update_wheel_timer_internal();
+        return;
+    }
+
+    // The timer is released once the task is removed
+    if (!handle->timer) {
+        BROOKESIA_LOGD("Task %1% removed, skip arming its timer", handle->id);
+        return;
+    }
+    handle->timer->expires_at(handle->timer_expiry);
+    handle->timer->async_wait([this, handle, run = std::move(run)](const boost::system::error_code & ec) mutable {
+        BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+        BROOKESIA_LOGD("Params: ec(%1%)", ec);
+
+        bool is_ready = false;
+        {
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            is_ready = on_timer_expired_internal(handle, std::move(run), static_cast<bool>(ec));
+        }
+        if (is_ready) {
+            timer_wakeups_++;
+            // One pass per ready task, which runs the best one at that time instead of this one
+            boost::asio::post(*io_context_, [this]() {
+                run_next_ready();
+            });
+        }
+    });
+}
+
+void TaskScheduler::disarm_timer_internal(TaskHandle &handle)
+{
+    if (handle.timer) {
+        handle.timer->cancel();
+    }
+    if ((handle.wheel_timer_id != 0) && timing_wheel_) {
+        timing_wheel_->cancel(handle.wheel_timer_id);
+    }
+    handle.wheel_timer_id = 0;
+}
+
+bool TaskScheduler::on_timer_expired_internal(std::shared_ptr<TaskHandle> handle, OnceTask run, bool is_aborted)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_LOGD("Params: handle(%1%), is_aborted(%2%)", handle->id, is_aborted);
+
+    handle->wheel_timer_id = 0;
+
+    // If suspended, don't remove the task - it will be resumed later
+    if (handle->state == TaskState::Suspended) {
+        BROOKESIA_LOGD(
+            "Task %1% is %2%, keeping it alive", handle->id, BROOKESIA_DESCRIBE_TO_STR(handle->state.load())
+        );
+        return false;
+    }
+
+    if (handle->state == TaskState::Canceled) {
+        remove_task_internal(handle->id, handle->group);
+        return false;
+    }
+
+    // Superseded by a new expiry, e.g. resumed before the wait of the suspended timer was aborted
+    if (is_aborted) {
+        return false;
+    }
+
+    insert_ready_internal(std::move(handle), std::move(run));
+
+    return true;
+}
+
+void TaskScheduler::run_timing_wheel()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    size_t ready_count = 0;
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+
+        if (!timing_wheel_) {
+            return;
+        }
+        is_wheel_timer_armed_ = false;
+        timer_wakeups_++;
+
+        // All the timers of the elapsed ticks become ready at once
+        wheel_expired_timers_.clear();
+        timing_wheel_->advance(std::chrono::steady_clock::now(), wheel_expired_timers_);
+        for (auto &expired : wheel_expired_timers_) {
+            if (on_timer_expired_internal(std::move(expired.handle), std::move(expired.run), false)) {
+                ready_count++;
+            }
+        }
+        wheel_expired_timers_.clear();
+
+        update_wheel_timer_internal();
+    }
+
+    BROOKESIA_LOGD("Made %1% tasks ready", ready_count);
+
+    // One pass per ready task, which runs the best one at that time
+    for (size_t i = 0; i < ready_count; i++) {
+        boost::asio::post(*io_context_, [this]() {
+            run_next_ready();
+        });
+    }
+}
+
+void TaskScheduler::update_wheel_timer_internal()
+{
+    auto next_expiry = timing_wheel_->get_next_expiry();
+    if (!next_expiry.has_value() || (is_wheel_timer_armed_ && (wheel_timer_expiry_ <= next_expiry.value()))) {
+        return;
+    }
+
+    // Re-arming cancels the pending wait, whose handler then returns without advancing the wheel
+    is_wheel_timer_armed_ = true;
+    wheel_timer_expiry_ = next_expiry.value();
+    wheel_timer_->expires_at(wheel_timer_expiry_);
+    wheel_timer_->async_wait([this](const boost::system::error_code & ec) {
+        if (ec) {
+            return;
+        }
+        run_timing_wheel();
+    });
+}
+
+TaskScheduler::ReadyTask TaskScheduler::make_ready_task(std::shared_ptr<TaskHandle> handle, OnceTask run) const
+{
+    auto now = std::chrono::steady_clock::now();
+    auto deadline = (handle->options.deadline_ms >= 0) ?
+                    (now + std::chrono::milliseconds(handle->options.deadline_ms)) :
+                    std::chrono::steady_clock::time_point::max();
+
+    return ReadyTask{
+        .handle = std::move(handle),
+        .run = std::move(run),
+        .ready_time = now,
+        .deadline = deadline,
+    };
+}
+
+void TaskScheduler::enqueue_ready(std::shared_ptr<TaskHandle> handle, OnceTask run)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_LOGD("Params: handle(%1%)", handle->id);
+
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        insert_ready_internal(std::move(handle), std::move(run));
+    }
+
+    // One pass per ready task, which runs the best one at that time instead of this one
+    boost::asio::post(*io_context_, [this]() {
+        run_next_ready();
+    });
+}
+
+void TaskScheduler::enqueue_in_order(std::shared_ptr<TaskHandle> handle, OnceTask run)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    BROOKESIA_LOGD("Params: handle(%1%)", handle->id);
+
+    auto ready = make_ready_task(std::move(handle), std::move(run));
+    ready.is_in_order = true;
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        auto &order = group_orders_[ready.handle->group];
+        if (order.is_busy) {
+            // Made ready when the previous tasks of the group are finished
+            order.waiting_tasks.push_back(std::move(ready));
+            return;
+        }
+        order.is_busy = true;
+        insert_ready_internal(std::move(ready));
+    }
+
+    boost::asio::post(*io_context_, [this]() {
+        run_next_ready();
+    });
+}
+
+void TaskScheduler::insert_ready_internal(std::shared_ptr<TaskHandle> handle, OnceTask run)
+{
+    insert_ready_internal(make_ready_task(std::move(handle), std::move(run)));
+}
+
+void TaskScheduler::insert_ready_internal(ReadyTask ready)
+{
+    auto priority = -static_cast<int64_t>(ready.handle->options.priority);
+    auto deadline = static_cast<int64_t>(ready.deadline.time_since_epoch().count());
+
+    auto key = (dispatch_policy_ == DispatchPolicy::EarliestDeadlineFirst) ?
+               ReadyKey{deadline, priority, ready_sequence_++} : ReadyKey{priority, deadline, ready_sequence_++};
+    ready_tasks_.emplace(key, std::move(ready));
+}
+
+void TaskScheduler::run_next_ready()
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    ReadyTask ready;
+    bool is_quota_counted = false;
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+
+        auto it = ready_tasks_.begin();
+        if (!group_runtimes_.empty()) {
+            // Skip the groups out of their quotas, checked once per pass
+            auto now = std::chrono::steady_clock::now();
+            std::vector<const Group *> throttled_groups;
+            auto is_throttled = [&throttled_groups](const Group & group) {
+                return std::any_of(throttled_groups.begin(), throttled_groups.end(), [&group](const Group * throttled) {
+                    return *throttled == group;
+                });
+            };
+            for (; it != ready_tasks_.end(); ++it) {
+                const auto &group = it->second.handle->group;
+                if (is_throttled(group)) {
+                    continue;
+                }
+                if (is_group_within_quota_internal(group, now)) {
+                    break;
+                }
+                throttled_groups.push_back(&group);
+                group_statistics_[group].throttled_count++;
+            }
+        }
+        if (it == ready_tasks_.end()) {
+            BROOKESIA_LOGD("No ready task within the quotas of its group");
+            return;
+        }
+
+        ready = std::move(it->second);
+        ready_tasks_.erase(it);
+
+        auto runtime_it = group_runtimes_.find(ready.handle->group);
+        if (runtime_it != group_runtimes_.end()) {
+            runtime_it->second.running_tasks++;
+            is_quota_counted = true;
+        }
+    }
+
+    execute_ready(ready, is_quota_counted);
+}
+
+void TaskScheduler::execute_ready(ReadyTask &ready, bool is_quota_counted)
+{
+    BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
+
+    auto &handle = ready.handle;
+    if (ready.is_in_order) {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        group_orders_[handle->group].executing_thread = boost::this_thread::get_id();
+    }
+    auto start_time = std::chrono::steady_clock::now();
+
+    // Suspended tasks are made ready again when resumed, canceled tasks are already removed
+    bool is_executed = (handle->state == TaskState::Running);
+    if (is_executed) {
+        ready.run();
+    } else {
+        BROOKESIA_LOGD(
+            "Task %1% is %2%, skip it", handle->id, BROOKESIA_DESCRIBE_TO_STR(handle->state.load())
+        );
+    }
+
+    auto end_time = std::chrono::steady_clock::now();
+
+    boost::lock_guard<boost::mutex> lock(mutex_);
+
+    // The next task of the group becomes ready, with its own priority
+    if (ready.is_in_order) {
+        auto order_it = group_orders_.find(handle->group);
+        if (order_it != group_orders_.end()) {
+            auto &order = order_it->second;
+            order.executing_thread = boost::thread::id();
+            if (order.waiting_tasks.empty()) {
+                order.is_busy = false;
+            } else {
+                insert_ready_internal(std::move(order.waiting_tasks.front()));
+                order.waiting_tasks.pop_front();
+                if (io_context_) {
+                    boost::asio::post(*io_context_, [this]() {
+                        run_next_ready();
+                    });
+                }
+            }
+        }
+    }
+
+    if (is_quota_counted) {
+        auto runtime_it = group_runtimes_.find(handle->group);
+        if (runtime_it != group_runtimes_.end()) {
+            auto &runtime = runtime_it->second;
+            if (runtime.running_tasks > 0) {
+                runtime.running_tasks--;
+            }
+            runtime.period_used += std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+        }
+        // A slot of the group is free, the ready tasks held back by its quota need a worker
+        if (!ready_tasks_.empty() && io_context_) {
+            boost::asio::post(*io_context_, [this]() {
+                run_next_ready();
+            });
+        }
+    }
+
+    if (!is_executed) {
+        return;
+    }
+
+    auto wait_us = static_cast<uint64_t>(
+                       std::chrono::duration_cast<std::chrono::microseconds>(start_time - ready.ready_time).count()
+                   );
+    auto &statistics = group_statistics_[handle->group];
+    statistics.executed_tasks++;
+    statistics.total_wait_us += wait_us;
+    statistics.max_wait_us = std::max(statistics.max_wait_us, wait_us);
+    statistics.total_run_us += static_cast<uint64_t>(
+                                   std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time).count()
+                               );
+    if (end_time > ready.deadline) {
+        statistics.deadline_missed_tasks++;
+        deadline_missed_tasks_++;
+        BROOKESIA_LOGD(
+            "Task %1% (group: %2%) missed its deadline by %3% us", handle->id, handle->group,
+            std::chrono::duration_cast<std::chrono::microseconds>(end_time - ready.deadline).count()
+        );
+    }
+}
+
+bool TaskScheduler::is_group_within_quota_internal(const Group &group, std::chrono::steady_clock::time_point now)
+{
+    auto runtime_it = group_runtimes_.find(group);
+    if (runtime_it == group_runtimes_.end()) {
+        return true;
+    }
+
+    auto &runtime = runtime_it->second;
+    const auto &config = group_configs_[group];
+    if ((config.max_concurrent_tasks > 0) && (runtime.running_tasks >= config.max_concurrent_tasks)) {
+        return false;
+    }
+    if (config.cpu_quota_ms == 0) {
+        return true;
+    }
+
+    auto period = std::chrono::milliseconds(config.cpu_quota_period_ms);
+    if ((now - runtime.period_start) >= period) {
+        runtime.period_start = now;
+        runtime.period_used = std::chrono::microseconds(0);
+    }
+    if (runtime.period_used < std::chrono::milliseconds(config.cpu_quota_ms)) {
+        return true;
+    }
+
+    // Wake a worker for each ready task of the group when the next period starts
+    if (!runtime.is_period_timer_armed) {
+        runtime.is_period_timer_armed = true;
+        runtime.period_timer->expires_at(runtime.period_start + period);
+        runtime.period_timer->async_wait([this, group](const boost::system::error_code & ec) {
+            if (ec) {
+                return;
+            }
+
+            size_t ready_count = 0;
+            {
+                boost::lock_guard<boost::mutex> lock(mutex_);
+                auto runtime_it = group_runtimes_.find(group);
+                if (runtime_it == group_runtimes_.end()) {
+                    return;
+                }
+                runtime_it->second.is_period_timer_armed = false;
+                for (const auto &[key, ready] : ready_tasks_) {
+                    if (ready.handle->group == group) {
+                        ready_count++;
+                    }
+                }
+            }
+            BROOKESIA_LOGD("Group %1% has a new CPU quota period, %2% ready tasks", group, ready_count);
+
+            for (size_t i = 0; i < ready_count; i++) {
+                boost::asio::post(*io_context_, [this]() {
+                    run_next_ready();
+                });
+            }
+        });
+    }
+
+    return false;
+}
+
 void TaskScheduler::cancel_internal(TaskId task_id)
 {
     BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
@@ -857,9 +1357,7 @@ void TaskScheduler::cancel_internal(TaskId task_id)
 
     auto &handle = it->second;
     handle->state = TaskState::Canceled;
-    if (handle->timer) {
-        handle->timer->cancel();
-    }
+    disarm_timer_internal(*handle);
     canceled_tasks_++;
 
     // Set promise value for canceled task (atomically check and set flag to prevent race condition)
@@ -903,13 +1401,10 @@ bool TaskScheduler::suspend_internal(TaskId task_id)
     }
 
     // Cancel current timer and record remaining time
-    if (handle->timer) {
-        auto expiry = handle->timer->expiry();
-        auto now = std::chrono::steady_clock::now();
-        handle->remaining_time = std::chrono::duration_cast<std::chrono::milliseconds>(expiry - now);
-        handle->suspend_time = now;
-        handle->timer->cancel();
-    }
+    auto now = std::chrono::steady_clock::now();
+    handle->remaining_time = std::chrono::duration_cast<std::chrono::milliseconds>(handle->timer_expiry - now);
+    handle->suspend_time = now;
+    disarm_timer_internal(*handle);
 
     handle->state = TaskState::Suspended;
     suspended_tasks_++;
@@ -962,13 +1457,13 @@ bool TaskScheduler::resume_internal(TaskId task_id)
         }
 
         // Use remaining time if positive, otherwise execute immediately
-        int delay_ms = std::max(0LL, handle->remaining_time.count());
+        int delay_ms = static_cast<int>(std::max<int64_t>(0, handle->remaining_time.count()));
 
         BROOKESIA_LOGD("Rescheduling delayed task %1% with remaining time: %2% ms", task_id, delay_ms);
 
         // Update interval_ms to remaining time for proper rescheduling
         handle->interval_ms = delay_ms;
-        schedule_once(handle, handle->saved_task);
+        schedule_once_internal(handle, handle->saved_task);
 
     } else if (handle->type == TaskType::Periodic) {
         // For Periodic task, reschedule with remaining time for first execution, then use original interval
@@ -978,32 +1473,16 @@ bool TaskScheduler::resume_internal(TaskId task_id)
         }
 
         // Use remaining time if positive, otherwise execute immediately
-        int delay_ms = std::max(0LL, handle->remaining_time.count());
+        int delay_ms = static_cast<int>(std::max<int64_t>(0, handle->remaining_time.count()));
 
         BROOKESIA_LOGD("Rescheduling periodic task %1% with remaining time: %2% ms, then interval: %3% ms",
                        task_id, delay_ms, handle->interval_ms);
 
         // First execution with remaining time
-        handle->timer->expires_after(std::chrono::milliseconds(delay_ms));
-        handle->timer->async_wait([this, handle, original_interval = handle->interval_ms](const boost::system::error_code & ec) {
-            BROOKESIA_LOG_TRACE_GUARD_WITH_THIS();
-
-            BROOKESIA_LOGD("Params: ec(%1%)", ec);
-
-            // If suspended again, don't remove the task
-            if (handle->state == TaskState::Suspended) {
-                BROOKESIA_LOGD(
-                    "Resumed periodic task %1% is %2%, keeping it alive", handle->id,
-                    BROOKESIA_DESCRIBE_TO_STR(handle->state.load())
-                );
-                return;
-            }
-
-            if (ec || handle->state == TaskState::Canceled) {
-                boost::lock_guard<boost::mutex> lock(mutex_);
-                remove_task_internal(handle->id, handle->group);
-                return;
-            }
+        // Executed by a worker in the order of the dispatch policy
+        arm_timer_internal(handle, delay_ms, [this, handle, original_interval = handle->interval_ms]() {
+            // Attribute the allocations of the task to its group (host only)
+            AllocTracker::ScopedTag alloc_tag(handle->group);
 
             // Invoke pre-execute callback when task is about to execute
             invoke_pre_execute_callback(handle->id, handle->type);
@@ -1017,7 +1496,8 @@ bool TaskScheduler::resume_internal(TaskId task_id)
                     // Task will continue, not finished yet
                     // Restore original interval for subsequent executions
                     handle->interval_ms = original_interval;
-                    schedule_periodic(handle, handle->saved_periodic_task);
+                    boost::lock_guard<boost::mutex> lock(mutex_);
+                    schedule_periodic_internal(handle, handle->saved_periodic_task);
                 } else {
                     // Task is finished
                     mark_finished(handle, true);
@@ -1065,8 +1545,8 @@ void TaskScheduler::remove_task_internal(TaskId task_id, const Group &group)
     auto it = tasks_.find(task_id);
     if (it != tasks_.end()) {
         // Ensure timer is canceled and cleaned up
-        if (it->second && it->second->timer) {
-            it->second->timer->cancel();
+        if (it->second) {
+            disarm_timer_internal(*it->second);
             it->second->timer.reset();
         }
         tasks_.erase(it);
@@ -24,6 +24,7 @@ namespace esp_brookesia::lib_utils {
 
 void ThreadConfig::from_pthread_cfg(const void *cfg)
 {
+#if defined(ESP_PLATFORM)
     BROOKESIA_CHECK_NULL_EXIT(cfg, "Invalid argument");
 
     const esp_pthread_cfg_t *pthread_cfg = static_cast<const esp_pthread_cfg_t *>(cfg);
@@ -32,10 +33,15 @@ void ThreadConfig::from_pthread_cfg(const void *cfg)
     priority = static_cast<size_t>(pthread_cfg->prio);
     stack_size = static_cast<size_t>(pthread_cfg->stack_size);
     stack_in_ext = (pthread_cfg->stack_alloc_caps & MALLOC_CAP_SPIRAM) != 0;
+#else
+    (void)cfg;
+    BROOKESIA_LOGW("Not supported on non-ESP platforms");
+#endif
 }
 
 void ThreadConfig::to_pthread_cfg(void *cfg) const
 {
+#if defined(ESP_PLATFORM)
     BROOKESIA_CHECK_NULL_EXIT(cfg, "Invalid argument");
 
     esp_pthread_cfg_t *pthread_cfg = static_cast<esp_pthread_cfg_t *>(cfg);
@@ -44,6 +50,10 @@ void ThreadConfig::to_pthread_cfg(void *cfg) const
     pthread_cfg->prio = static_cast<int>(priority);
     pthread_cfg->stack_size = static_cast<size_t>(stack_size);
     pthread_cfg->stack_alloc_caps = static_cast<uint32_t>(stack_in_ext ? MALLOC_CAP_SPIRAM : MALLOC_CAP_INTERNAL) | MALLOC_CAP_8BIT;
+#else
+    (void)cfg;
+    BROOKESIA_LOGW("Not supported on non-ESP platforms");
+#endif
 }
 
 void ThreadConfig::apply() const
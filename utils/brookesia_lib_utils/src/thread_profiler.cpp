@@ -6,8 +6,17 @@
 #include <algorithm>
 #include <iomanip>
 #include <sstream>
-#include "esp_heap_caps.h"
-#include "soc/soc_memory_layout.h"
+#if defined(ESP_PLATFORM)
+#   include "esp_heap_caps.h"
+#   include "soc/soc_memory_layout.h"
+#elif defined(__linux__)
+#   include <filesystem>
+#   include <fstream>
+#   include <sched.h>
+#   include <sys/mman.h>
+#   include <sys/resource.h>
+#   include <unistd.h>
+#endif
 #include "brookesia/lib_utils/macro_configs.h"
 #if !BROOKESIA_UTILS_THREAD_PROFILER_ENABLE_DEBUG_LOG
 #   define BROOKESIA_LOG_DISABLE_DEBUG_TRACE 1
@@ -22,6 +31,229 @@
 namespace esp_brookesia::lib_utils {
 
 constexpr uint32_t THREAD_PROFILER_STOP_TIMEOUT_MS = 100;
+// Sampling may be slightly late, so that it shares a wake-up with other timers
+constexpr TaskScheduler::TaskOptions PROFILING_TASK_OPTIONS = {
+    .priority = TaskScheduler::TaskPriority::Low,
+    .slack_ms = 50,
+};
+
+#if !defined(ESP_PLATFORM) && defined(__linux__)
+namespace {
+
+struct StackRange {
+    uintptr_t start = 0;
+    uintptr_t end = 0;
+    bool is_main = false;   // The `[stack]` mapping of the main thread, which grows up to `RLIMIT_STACK`
+};
+
+// Stacks of the threads which were blocked in a previous sample, a running thread does not expose its stack pointer
+struct StackCache {
+    boost::mutex mutex;
+    std::map<ThreadProfiler::TaskHandle, StackRange> ranges;
+};
+
+StackCache &get_stack_cache()
+{
+    static StackCache cache;
+    return cache;
+}
+
+std::vector<StackRange> read_writable_mappings()
+{
+    std::vector<StackRange> mappings;
+    std::ifstream maps("/proc/self/maps");
+    std::string line;
+    while (std::getline(maps, line)) {
+        // Format: "start-end perms offset dev inode [path]"
+        std::istringstream iss(line);
+        std::string range, perms, offset, dev, inode, path;
+        if (!(iss >> range >> perms >> offset >> dev >> inode)) {
+            continue;
+        }
+        iss >> path;
+        if ((perms.size() < 2) || (perms[0] != 'r') || (perms[1] != 'w')) {
+            continue;
+        }
+        char *range_end = nullptr;
+        StackRange mapping;
+        mapping.start = std::strtoull(range.c_str(), &range_end, 16);
+        if (*range_end != '-') {
+            continue;
+        }
+        mapping.end = std::strtoull(range_end + 1, nullptr, 16);
+        mapping.is_main = (path == "[stack]");
+        mappings.push_back(mapping);
+    }
+
+    return mappings;
+}
+
+/**
+ * Get an address inside the stack of a thread: a local variable for the calling thread, otherwise the stack pointer
+ * reported by `/proc/self/task/<tid>/syscall` ("<nr> <args...> <sp> <pc>", or "running")
+ */
+bool get_stack_pointer(ThreadProfiler::TaskHandle tid, uintptr_t &sp)
+{
+    if (tid == static_cast<ThreadProfiler::TaskHandle>(gettid())) {
+        volatile uint8_t local = 0;
+        sp = reinterpret_cast<uintptr_t>(&local);
+        return true;
+    }
+
+    std::ifstream file("/proc/self/task/" + std::to_string(tid) + "/syscall");
+    std::vector<std::string> tokens;
+    std::string token;
+    while (file >> token) {
+        tokens.push_back(token);
+    }
+    if ((tokens.size() < 3) || (tokens[0] == "running")) {
+        return false;
+    }
+    sp = std::strtoull(tokens[tokens.size() - 2].c_str(), nullptr, 16);
+
+    return (sp != 0);
+}
+
+/**
+ * Stack pages are only backed once touched, so the pages which are not resident at the low end of the stack have
+ * never been used. Swapped out pages are counted as untouched as well.
+ */
+uint32_t get_stack_high_water_mark(const StackRange &range)
+{
+    static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+    size_t length = range.end - range.start;
+    std::vector<unsigned char> residency((length + page_size - 1) / page_size);
+    if (mincore(reinterpret_cast<void *>(range.start), length, residency.data()) != 0) {
+        return ThreadProfiler::STACK_HIGH_WATER_MARK_UNKNOWN;
+    }
+    size_t untouched_pages = 0;
+    while ((untouched_pages < residency.size()) && ((residency[untouched_pages] & 1) == 0)) {
+        untouched_pages++;
+    }
+    size_t high_water_mark = untouched_pages * page_size;
+
+    if (range.is_main) {
+        rlimit limit = {};
+        if ((getrlimit(RLIMIT_STACK, &limit) == 0) && (limit.rlim_cur != RLIM_INFINITY) &&
+                (limit.rlim_cur > length)) {
+            high_water_mark += limit.rlim_cur - length;
+        }
+    }
+
+    return static_cast<uint32_t>(std::min<size_t>(high_water_mark, ThreadProfiler::STACK_HIGH_WATER_MARK_UNKNOWN - 1));
+}
+
+bool parse_task_status(const std::string &task_dir, ThreadProfiler::NativeTaskStatus &status)
+{
+    // Format: "tid (comm) state ppid ...", `comm` may contain spaces and parentheses
+    std::ifstream stat_file(task_dir + "/stat");
+    std::string stat;
+    if (!std::getline(stat_file, stat)) {
+        return false;
+    }
+    auto name_start = stat.find('(');
+    auto name_end = stat.rfind(')');
+    if ((name_start == std::string::npos) || (name_end == std::string::npos) || (name_end < name_start)) {
+        return false;
+    }
+    status.name = stat.substr(name_start + 1, name_end - name_start - 1);
+
+    // fields[0] is the 3rd field of `proc_pid_stat(5)`
+    std::istringstream iss(stat.substr(name_end + 1));
+    std::vector<std::string> fields;
+    std::string field;
+    while (iss >> field) {
+        fields.push_back(field);
+    }
+    if (fields.size() < 38) {
+        return false;
+    }
+    status.state = fields[0].empty() ? '?' : fields[0][0];
+    status.priority = static_cast<uint32_t>(std::stoul(fields[37]));   // rt_priority
+
+    // `schedstat` has the run time in nanoseconds, `stat` only in clock ticks
+    std::ifstream schedstat_file(task_dir + "/schedstat");
+    uint64_t runtime_ns = 0;
+    if (schedstat_file >> runtime_ns) {
+        status.runtime_us = runtime_ns / 1000;
+    } else {
+        static const uint64_t ticks_per_second = static_cast<uint64_t>(sysconf(_SC_CLK_TCK));
+        uint64_t ticks = std::stoull(fields[11]) + std::stoull(fields[12]);    // utime + stime
+        status.runtime_us = ticks * 1000000 / ticks_per_second;
+    }
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    if ((sched_getaffinity(static_cast<pid_t>(status.tid), sizeof(cpu_set), &cpu_set) == 0) &&
+            (CPU_COUNT(&cpu_set) == 1)) {
+        for (int i = 0; i < CPU_SETSIZE; i++) {
+            if (CPU_ISSET(i, &cpu_set)) {
+                status.core_id = i;
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool read_task_status(const std::string &task_dir, ThreadProfiler::NativeTaskStatus &status)
+{
+    try {
+        return parse_task_status(task_dir, status);
+    } catch (const std::exception &) {
+        return false;
+    }
+}
+
+void sample_stack_high_water_marks(std::vector<ThreadProfiler::NativeTaskStatus> &tasks)
+{
+    auto mappings = read_writable_mappings();
+    auto &cache = get_stack_cache();
+    boost::lock_guard lock(cache.mutex);
+
+    std::map<ThreadProfiler::TaskHandle, StackRange> ranges;
+    for (auto &task : tasks) {
+        task.stack_high_water_mark = ThreadProfiler::STACK_HIGH_WATER_MARK_UNKNOWN;
+
+        StackRange range;
+        uintptr_t sp = 0;
+        if (get_stack_pointer(task.tid, sp)) {
+            auto it = std::find_if(mappings.begin(), mappings.end(), [sp](const StackRange & mapping) {
+                return (sp >= mapping.start) && (sp < mapping.end);
+            });
+            if (it != mappings.end()) {
+                range = *it;
+            }
+        }
+        if (range.end == 0) {
+            auto it = cache.ranges.find(task.tid);
+            if (it == cache.ranges.end()) {
+                continue;
+            }
+            range = it->second;
+        }
+
+        ranges[task.tid] = range;
+        task.stack_high_water_mark = get_stack_high_water_mark(range);
+    }
+    // Also drops the threads which have exited
+    cache.ranges = std::move(ranges);
+}
+
+uint32_t get_core_num()
+{
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+        return 1;
+    }
+    return std::max(CPU_COUNT(&cpu_set), 1);
+}
+
+} // namespace
+#endif
 
 ThreadProfiler::~ThreadProfiler()
 {
@@ -146,14 +378,17 @@ bool ThreadProfiler::start_profiling(
             }
         };
         BROOKESIA_CHECK_FALSE_RETURN(
-            task_scheduler_->post_delayed(sampling_task, sampling_duration_ms, &sampling_task_id_), false,
+            task_scheduler_->post_delayed(
+                sampling_task, sampling_duration_ms, &sampling_task_id_, "", PROFILING_TASK_OPTIONS
+            ), false,
             "Failed to schedule delayed sampling task"
         );
 
         return true;
     };
     BROOKESIA_CHECK_FALSE_RETURN(
-        scheduler->post_periodic(profiling_task, profiling_interval_ms, &profiling_task_id_), false, "Failed to schedule profiling task"
+        scheduler->post_periodic(profiling_task, profiling_interval_ms, &profiling_task_id_, "", PROFILING_TASK_OPTIONS),
+        false, "Failed to schedule profiling task"
     );
     stop_guard.release();
 
@@ -241,6 +476,7 @@ std::shared_ptr<ThreadProfiler::SampleResult> ThreadProfiler::sample_tasks()
         result = std::make_shared<SampleResult>(), nullptr, "Failed to create sample result"
     );
 
+#if defined(ESP_PLATFORM)
     // Allocate array with extra space
     UBaseType_t array_size = uxTaskGetNumberOfTasks();
     result->task_status.resize(array_size);
@@ -248,6 +484,35 @@ std::shared_ptr<ThreadProfiler::SampleResult> ThreadProfiler::sample_tasks()
 
     // Get task system state
     uxTaskGetSystemState(result->task_status.data(), array_size, &result->runtime);
+#elif defined(__linux__)
+    result->timestamp = std::chrono::system_clock::now();
+    // The run time of the threads is in microseconds, so is the total run time
+    result->runtime = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+
+    std::error_code ec;
+    for (const auto &entry : std::filesystem::directory_iterator("/proc/self/task", ec)) {
+        auto tid_str = entry.path().filename().string();
+        char *tid_end = nullptr;
+        NativeTaskStatus status;
+        status.tid = std::strtol(tid_str.c_str(), &tid_end, 10);
+        if ((tid_end == tid_str.c_str()) || (*tid_end != '\0')) {
+            continue;
+        }
+        // The thread may exit while being sampled
+        if (!read_task_status(entry.path().string(), status)) {
+            BROOKESIA_LOGD("Skip task(%1%), it may have exited", status.tid);
+            continue;
+        }
+        result->task_status.push_back(std::move(status));
+    }
+    BROOKESIA_CHECK_FALSE_RETURN(!ec, nullptr, "Failed to list threads: %1%", ec.message());
+
+    sample_stack_high_water_marks(result->task_status);
+#else
+    BROOKESIA_LOGE("Not supported on this platform");
+    return nullptr;
+#endif
 
     return result;
 }
@@ -263,7 +528,7 @@ std::shared_ptr<ThreadProfiler::ProfileSnapshot> ThreadProfiler::take_snapshot(
     BROOKESIA_LOGE("Please enable `BROOKESIA_UTILS_THREAD_PROFILER_ENABLE_FREERTOS_CONFIG` in menuconfig");
 #   endif
     return nullptr;
-#else
+#elif defined(ESP_PLATFORM)
     std::shared_ptr<ProfileSnapshot> snapshot;
     BROOKESIA_CHECK_EXCEPTION_RETURN(
         snapshot = std::make_shared<ProfileSnapshot>(), nullptr, "Failed to create snapshot"
@@ -383,6 +648,88 @@ std::shared_ptr<ThreadProfiler::ProfileSnapshot> ThreadProfiler::take_snapshot(
     }
     snapshot->stats.total_tasks = snapshot->tasks.size();
 
+    return snapshot;
+#else
+    std::shared_ptr<ProfileSnapshot> snapshot;
+    BROOKESIA_CHECK_EXCEPTION_RETURN(
+        snapshot = std::make_shared<ProfileSnapshot>(), nullptr, "Failed to create snapshot"
+    );
+
+    // Calculate total elapsed time
+    uint32_t total_elapsed_time = end_result.runtime - start_result.runtime;
+    BROOKESIA_CHECK_FALSE_RETURN(
+        total_elapsed_time > 0, nullptr, "Total elapsed time is zero. Try increasing sampling_duration_ms"
+    );
+
+    snapshot->timestamp = std::chrono::system_clock::now();
+    snapshot->total_runtime = end_result.runtime;
+    snapshot->stats.sample_duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            end_result.timestamp - start_result.timestamp).count();
+
+    // Like `portNUM_PROCESSORS` on the device, the CPU usage is relative to all the cores the process may run on
+    uint64_t core_num = get_core_num();
+
+    auto to_task_info = [](const NativeTaskStatus & status, TaskStatus task_status) {
+        TaskInfo info;
+        info.name = status.name;
+        info.handle = status.tid;
+        info.state = convert_task_state(status.state);
+        info.priority = status.priority;
+        info.core_id = status.core_id;
+        info.stack_high_water_mark = status.stack_high_water_mark;
+        info.runtime_counter = static_cast<uint32_t>(status.runtime_us);
+        info.status = task_status;
+        return info;
+    };
+
+    std::map<TaskHandle, const NativeTaskStatus *> start_tasks;
+    for (const auto &status : start_result.task_status) {
+        start_tasks[status.tid] = &status;
+    }
+
+    for (const auto &status : end_result.task_status) {
+        auto it = start_tasks.find(status.tid);
+        // Handle newly created tasks (exist in end but not in start)
+        if (it == start_tasks.end()) {
+            snapshot->tasks.push_back(to_task_info(status, TaskStatus::Created));
+            continue;
+        }
+
+        // Process matched tasks (exist in both sample results)
+        auto info = to_task_info(status, TaskStatus::Normal);
+        uint64_t task_elapsed_time = status.runtime_us - it->second->runtime_us;
+        info.elapsed_time = static_cast<uint32_t>(task_elapsed_time);
+        info.cpu_percent = static_cast<uint32_t>((task_elapsed_time * 100) / (total_elapsed_time * core_num));
+        snapshot->tasks.push_back(info);
+        start_tasks.erase(it);
+
+        // Update statistics
+        switch (info.state) {
+        case TaskState::Running:
+            snapshot->stats.running_tasks++;
+            break;
+        case TaskState::Blocked:
+            snapshot->stats.blocked_tasks++;
+            break;
+        case TaskState::Suspended:
+            snapshot->stats.suspended_tasks++;
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Handle deleted tasks (exist in start but not in end)
+    for (const auto &[tid, status] : start_tasks) {
+        snapshot->tasks.push_back(to_task_info(*status, TaskStatus::Deleted));
+    }
+
+    // Calculate total CPU percentage
+    for (const auto &task : snapshot->tasks) {
+        snapshot->stats.total_cpu_percent += task.cpu_percent;
+    }
+    snapshot->stats.total_tasks = snapshot->tasks.size();
+
     return snapshot;
 #endif
 }
@@ -523,6 +870,15 @@ void ThreadProfiler::print_snapshot(
         }
     };
 
+    // Helper function to format the stack high water mark, which may be unknown on the host
+    auto get_hwm_string = [](const TaskInfo & task) -> std::string {
+        if (task.stack_high_water_mark == STACK_HIGH_WATER_MARK_UNKNOWN)
+        {
+            return "?";
+        }
+        return std::to_string(task.stack_high_water_mark);
+    };
+
     // Helper function to print primary sort column
     auto print_primary_sort_column = [&](const std::string & value) {
         if (primary_sort == PrimarySortBy::CoreId) {
@@ -559,7 +915,7 @@ void ThreadProfiler::print_snapshot(
             print_column(is_special_status ? "-" : std::to_string(task.priority), priority_width, true);
         }
         if (secondary_sort != SecondarySortBy::StackUsage) {
-            print_column(is_special_status ? "-" : std::to_string(task.stack_high_water_mark), hwm_width, true);
+            print_column(is_special_status ? "-" : get_hwm_string(task), hwm_width, true);
         }
     };
 
@@ -588,7 +944,7 @@ void ThreadProfiler::print_snapshot(
                 print_column(std::to_string(task.priority), priority_width, true);
                 break;
             case SecondarySortBy::StackUsage:
-                print_column(std::to_string(task.stack_high_water_mark), hwm_width, true);
+                print_column(get_hwm_string(task), hwm_width, true);
                 break;
             case SecondarySortBy::Name:
                 break;
@@ -718,7 +1074,7 @@ std::vector<ThreadProfiler::TaskInfo> ThreadProfiler::get_tasks_above_threshold(
         break;
 
     case ThresholdType::StackUsage:
-        // Return tasks with stack HWM <= threshold_value (lower = more critical)
+        // Return tasks with stack HWM <= threshold_value (lower = more critical), an unknown HWM never matches
         std::copy_if(tasks.begin(), tasks.end(), std::back_inserter(result),
         [threshold_value](const TaskInfo & task) {
             return task.stack_high_water_mark <= threshold_value;
@@ -747,6 +1103,7 @@ void ThreadProfiler::check_thresholds_and_trigger_callbacks(const ProfileSnapsho
     }
 }
 
+#if defined(ESP_PLATFORM)
 ThreadProfiler::TaskState ThreadProfiler::convert_task_state(eTaskState state)
 {
     switch (state) {
@@ -764,6 +1121,26 @@ ThreadProfiler::TaskState ThreadProfiler::convert_task_state(eTaskState state)
         return TaskState::Invalid;
     }
 }
+#else
+ThreadProfiler::TaskState ThreadProfiler::convert_task_state(char state)
+{
+    switch (state) {
+    case 'R':
+        return TaskState::Running;
+    case 'S':
+    case 'D':
+        return TaskState::Blocked;
+    case 'T':
+    case 't':
+        return TaskState::Suspended;
+    case 'Z':
+    case 'X':
+        return TaskState::Deleted;
+    default:
+        return TaskState::Invalid;
+    }
+}
+#endif
 
 const char *ThreadProfiler::get_state_string(TaskState state)
 {
@@ -16,6 +16,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "unity.h"
+#include "brookesia/lib_utils/alloc_tracker.hpp"
 #include "brookesia/lib_utils/check.hpp"
 #include "brookesia/lib_utils/describe_helpers.hpp"
 #include "brookesia/lib_utils/log.hpp"
@@ -1197,3 +1198,27 @@ TEST_CASE("Test SignalConnection connected() check", "[utils][memory_profiler][s
 
     BROOKESIA_LOGI("✓ connected() check verified");
 }
+
+TEST_CASE("Test allocation tracker is disabled on the device", "[utils][memory_profiler][alloc_tracker][device]")
+{
+    BROOKESIA_LOGI("=== Allocation Tracker Device Test ===");
+
+    // The tracker interposes the allocator of glibc, it is only built on the host
+    TEST_ASSERT_FALSE(AllocTracker::is_available());
+
+    {
+        std::string group = "test_group";
+        AllocTracker::ScopedTag tag(group);
+        auto data = std::make_unique<uint8_t[]>(64);
+        TEST_ASSERT_NOT_NULL(data.get());
+    }
+
+    AllocTracker::Summary summary;
+    AllocTracker::Report report;
+    TEST_ASSERT_FALSE(AllocTracker::get_summary(summary));
+    TEST_ASSERT_FALSE(AllocTracker::get_churn_report(report));
+    TEST_ASSERT_FALSE(AllocTracker::get_leak_report(report));
+    TEST_ASSERT_TRUE(report.sites.empty());
+
+    BROOKESIA_LOGI("✓ Allocation tracker APIs are no-ops");
+}
@@ -940,3 +940,123 @@ TEST_CASE("Test state machine with update and timeout", "[utils][state_machine][
     // Verify update has stopped or only increased very little (considering asynchronous scheduling delay)
     TEST_ASSERT_TRUE(updates_after_timeout <= updates_before_timeout + 2);
 }
+
+// ==================== Test Cases: Compiled Mode ====================
+
+TEST_CASE("Test state machine compiled mode", "[utils][state_machine][compiled]")
+{
+    BROOKESIA_LOGI("=== State Machine Compiled Mode Test ===");
+
+    auto scheduler = std::make_shared<TaskScheduler>();
+    scheduler->start();
+
+    StateMachine sm;
+
+    auto idle = std::make_shared<IdleState>(&sm);
+    auto running = std::make_shared<RunningState>();
+    auto error = std::make_shared<ErrorState>();
+
+    sm.add_state("idle", idle);
+    sm.add_state("running", running);
+    sm.add_state("error", error);
+    sm.add_transition("idle", "start", "running");
+    sm.add_transition("running", "stop", "idle");
+    sm.add_transition("running", "error", "error");
+
+    // No IDs before compiling
+    TEST_ASSERT_FALSE(sm.is_compiled());
+    TEST_ASSERT_EQUAL(StateMachine::INVALID_ID, sm.get_action_id("start"));
+
+    TEST_ASSERT_TRUE(sm.compile());
+    TEST_ASSERT_TRUE(sm.is_compiled());
+
+    // Nothing can be added once compiled
+    TEST_ASSERT_FALSE(sm.add_state("extra", std::make_shared<ErrorState>()));
+    TEST_ASSERT_FALSE(sm.add_transition("error", "reset", "idle"));
+
+    // IDs are dense and sorted by name
+    TEST_ASSERT_EQUAL(0, sm.get_state_id("error"));
+    TEST_ASSERT_EQUAL(1, sm.get_state_id("idle"));
+    TEST_ASSERT_EQUAL(2, sm.get_state_id("running"));
+    TEST_ASSERT_EQUAL(StateMachine::INVALID_ID, sm.get_state_id("extra"));
+    auto start_id = sm.get_action_id("start");
+    auto stop_id = sm.get_action_id("stop");
+    TEST_ASSERT_NOT_EQUAL(StateMachine::INVALID_ID, start_id);
+    TEST_ASSERT_NOT_EQUAL(StateMachine::INVALID_ID, stop_id);
+    TEST_ASSERT_EQUAL(StateMachine::INVALID_ID, sm.get_action_id("reset"));
+
+    std::vector<std::string> callbacks;
+    boost::mutex callbacks_mutex;
+    sm.register_transition_finish_callback(
+    [&](const std::string & from, const std::string & action, const std::string & to) {
+        boost::lock_guard<boost::mutex> lock(callbacks_mutex);
+        callbacks.push_back(from + ":" + action + ":" + to);
+    });
+
+    sm.start(scheduler, "idle");
+    vTaskDelay(pdMS_TO_TICKS(50));
+    TEST_ASSERT_EQUAL(sm.get_state_id("idle"), sm.get_current_state_id());
+
+    // Trigger by ID
+    TEST_ASSERT_TRUE(sm.trigger_action(start_id));
+    vTaskDelay(pdMS_TO_TICKS(50));
+    TEST_ASSERT_EQUAL(1, running->enter_count_.load());
+    TEST_ASSERT_EQUAL_STRING("running", sm.get_current_state().c_str());
+    TEST_ASSERT_EQUAL(sm.get_state_id("running"), sm.get_current_state_id());
+
+    // The string API goes through the IDs
+    TEST_ASSERT_TRUE(sm.trigger_action("stop"));
+    vTaskDelay(pdMS_TO_TICKS(50));
+    TEST_ASSERT_EQUAL(2, idle->enter_count_.load());
+    TEST_ASSERT_EQUAL_STRING("idle", sm.get_current_state().c_str());
+
+    // Unknown actions are rejected, and actions without a transition in the current state do nothing
+    TEST_ASSERT_FALSE(sm.trigger_action("reset"));
+    TEST_ASSERT_FALSE(sm.trigger_action(static_cast<StateMachine::ActionId>(100)));
+    TEST_ASSERT_TRUE(sm.trigger_action(stop_id));
+    vTaskDelay(pdMS_TO_TICKS(50));
+    TEST_ASSERT_EQUAL_STRING("idle", sm.get_current_state().c_str());
+
+    {
+        boost::lock_guard<boost::mutex> lock(callbacks_mutex);
+        TEST_ASSERT_EQUAL(2, callbacks.size());
+        TEST_ASSERT_EQUAL_STRING("idle:start:running", callbacks[0].c_str());
+        TEST_ASSERT_EQUAL_STRING("running:stop:idle", callbacks[1].c_str());
+    }
+
+    // Force transition keeps the ID in sync
+    TEST_ASSERT_TRUE(sm.force_transition_to("error"));
+    TEST_ASSERT_EQUAL(sm.get_state_id("error"), sm.get_current_state_id());
+
+    sm.stop();
+    TEST_ASSERT_EQUAL(StateMachine::INVALID_ID, sm.get_current_state_id());
+}
+
+TEST_CASE("Test state machine start compiles implicitly", "[utils][state_machine][compiled]")
+{
+    BROOKESIA_LOGI("=== State Machine Implicit Compile Test ===");
+
+    auto scheduler = std::make_shared<TaskScheduler>();
+    scheduler->start();
+
+    StateMachine sm;
+
+    auto idle = std::make_shared<IdleState>(&sm);
+    auto running = std::make_shared<RunningState>();
+
+    sm.add_state("idle", idle);
+    sm.add_state("running", running);
+    sm.add_transition("idle", "start", "running");
+
+    TEST_ASSERT_TRUE(sm.start(scheduler, "idle"));
+    TEST_ASSERT_TRUE(sm.is_compiled());
+    TEST_ASSERT_EQUAL(sm.get_state_id("idle"), sm.get_current_state_id());
+
+    // The string API resolves the name and runs the same ID path
+    TEST_ASSERT_TRUE(sm.trigger_action("start"));
+    vTaskDelay(pdMS_TO_TICKS(50));
+    TEST_ASSERT_EQUAL(1, running->enter_count_.load());
+    TEST_ASSERT_EQUAL(sm.get_state_id("running"), sm.get_current_state_id());
+
+    sm.stop();
+}
@@ -2492,3 +2492,355 @@ TEST_CASE("Test dispatch inside delayed task executes immediately", "[utils][tas
 
     scheduler.stop();
 }
+
+// ============================================================================
+// Priority, deadline and quota tests
+// ============================================================================
+
+TEST_CASE("Test strict priority dispatch", "[utils][task_scheduler][priority][strict]")
+{
+    BROOKESIA_LOGI("=== TaskScheduler Strict Priority Dispatch Test ===");
+
+    TaskScheduler scheduler;
+    scheduler.start(TEST_SCHEDULER_CONFIG_GENERIC);
+
+    std::vector<int> order_record;
+    boost::mutex order_mutex;
+    auto record = [&order_record, &order_mutex](int value) {
+        boost::lock_guard<boost::mutex> lock(order_mutex);
+        order_record.push_back(value);
+    };
+
+    // Keep the single worker busy while the other tasks are queued
+    std::atomic<bool> is_released{false};
+    scheduler.post([&is_released]() {
+        while (!is_released) {
+            vTaskDelay(pdMS_TO_TICKS(1));
+        }
+    });
+    vTaskDelay(pdMS_TO_TICKS(20));
+
+    for (int i = 0; i < 3; i++) {
+        scheduler.post([&record, i]() {
+            record(i);
+        }, nullptr, "background", {.priority = TaskScheduler::TaskPriority::Low});
+    }
+    scheduler.post([&record]() {
+        record(10);
+    });
+    for (int i = 20; i < 23; i++) {
+        scheduler.post([&record, i]() {
+            record(i);
+        }, nullptr, "ui", {.priority = TaskScheduler::TaskPriority::High});
+    }
+
+    is_released = true;
+    TEST_ASSERT_TRUE(scheduler.wait_all(1000));
+    vTaskDelay(pdMS_TO_TICKS(10));
+
+    // Higher priority first, FIFO within the same priority
+    std::vector<int> expected_order = {20, 21, 22, 10, 0, 1, 2};
+    TEST_ASSERT_EQUAL(expected_order.size(), order_record.size());
+    for (size_t i = 0; i < expected_order.size(); i++) {
+        TEST_ASSERT_EQUAL(expected_order[i], order_record[i]);
+    }
+
+    auto ui_statistics = scheduler.get_group_statistics("ui");
+    auto background_statistics = scheduler.get_group_statistics("background");
+    BROOKESIA_LOGI("UI statistics: %1%", BROOKESIA_DESCRIBE_TO_STR(ui_statistics));
+    BROOKESIA_LOGI("Background statistics: %1%", BROOKESIA_DESCRIBE_TO_STR(background_statistics));
+    TEST_ASSERT_EQUAL(3, ui_statistics.executed_tasks);
+    TEST_ASSERT_EQUAL(3, background_statistics.executed_tasks);
+    TEST_ASSERT_GREATER_OR_EQUAL(ui_statistics.max_wait_us, background_statistics.max_wait_us);
+
+    scheduler.stop();
+}
+
+TEST_CASE("Test strict priority dispatch of in-order group", "[utils][task_scheduler][priority][in_order]")
+{
+    BROOKESIA_LOGI("=== TaskScheduler Strict Priority Dispatch of In-Order Group Test ===");
+
+    TaskScheduler scheduler;
+    scheduler.start(TEST_SCHEDULER_CONFIG_GENERIC);
+
+    TaskScheduler::GroupConfig in_order_config;
+    in_order_config.enable_post_execute_in_order = true;
+    TEST_ASSERT_TRUE(scheduler.configure_group("ui", in_order_config));
+
+    std::vector<int> order_record;
+    boost::mutex order_mutex;
+    auto record = [&order_record, &order_mutex](int value) {
+        boost::lock_guard<boost::mutex> lock(order_mutex);
+        order_record.push_back(value);
+    };
+
+    // Keep the single worker busy while the other tasks are queued
+    std::atomic<bool> is_released{false};
+    scheduler.post([&is_released]() {
+        while (!is_released) {
+            vTaskDelay(pdMS_TO_TICKS(1));
+        }
+    });
+    vTaskDelay(pdMS_TO_TICKS(20));
+
+    for (int i = 0; i < 3; i++) {
+        scheduler.post([&record, i]() {
+            record(i);
+        }, nullptr, "background", {.priority = TaskScheduler::TaskPriority::Low});
+    }
+    // The in-order tasks overtake the queued lower priority tasks, and keep their posting order even with a lower
+    // priority for the last one
+    scheduler.post([&record]() {
+        record(20);
+    }, nullptr, "ui", {.priority = TaskScheduler::TaskPriority::High});
+    scheduler.post([&record]() {
+        record(21);
+    }, nullptr, "ui", {.priority = TaskScheduler::TaskPriority::High});
+    scheduler.post([&record]() {
+        record(22);
+    }, nullptr, "ui", {.priority = TaskScheduler::TaskPriority::Low});
+
+    is_released = true;
+    TEST_ASSERT_TRUE(scheduler.wait_all(1000));
+    vTaskDelay(pdMS_TO_TICKS(10));
+
+    // The last in-order task becomes ready after the first ones, behind the Low tasks queued before it
+    std::vector<int> expected_order = {20, 21, 0, 1, 2, 22};
+    TEST_ASSERT_EQUAL(expected_order.size(), order_record.size());
+    for (size_t i = 0; i < expected_order.size(); i++) {
+        TEST_ASSERT_EQUAL(expected_order[i], order_record[i]);
+    }
+
+    scheduler.stop();
+}
+
+TEST_CASE("Test earliest deadline first dispatch", "[utils][task_scheduler][priority][deadline]")
+{
+    BROOKESIA_LOGI("=== TaskScheduler Earliest Deadline First Dispatch Test ===");
+
+    TaskScheduler::StartConfig config;
+    config.dispatch_policy = TaskScheduler::DispatchPolicy::EarliestDeadlineFirst;
+    TaskScheduler scheduler;
+    scheduler.start(config);
+
+    std::vector<int> order_record;
+    std::atomic<bool> is_released{false};
+    scheduler.post([&is_released]() {
+        while (!is_released) {
+            vTaskDelay(pdMS_TO_TICKS(1));
+        }
+    });
+    vTaskDelay(pdMS_TO_TICKS(20));
+
+    scheduler.post([&order_record]() {
+        order_record.push_back(0);
+    }, nullptr, "", {.priority = TaskScheduler::TaskPriority::Critical});
+    scheduler.post([&order_record]() {
+        order_record.push_back(1);
+    }, nullptr, "", {.deadline_ms = 1000});
+    scheduler.post([&order_record]() {
+        order_record.push_back(2);
+    }, nullptr, "", {.deadline_ms = 10});
+
+    // The task with the 10ms deadline misses it
+    vTaskDelay(pdMS_TO_TICKS(30));
+    is_released = true;
+    TEST_ASSERT_TRUE(scheduler.wait_all(1000));
+    vTaskDelay(pdMS_TO_TICKS(10));
+
+    // Earlier deadline first, tasks without deadline last
+    TEST_ASSERT_EQUAL(3, order_record.size());
+    TEST_ASSERT_EQUAL(2, order_record[0]);
+    TEST_ASSERT_EQUAL(1, order_record[1]);
+    TEST_ASSERT_EQUAL(0, order_record[2]);
+
+    TEST_ASSERT_EQUAL(1, scheduler.get_statistics().deadline_missed_tasks);
+    TEST_ASSERT_EQUAL(1, scheduler.get_group_statistics("").deadline_missed_tasks);
+
+    scheduler.reset_statistics();
+    TEST_ASSERT_EQUAL(0, scheduler.get_group_statistics("").executed_tasks);
+
+    scheduler.stop();
+}
+
+TEST_CASE("Test group concurrency quota", "[utils][task_scheduler][quota][concurrency]")
+{
+    BROOKESIA_LOGI("=== TaskScheduler Group Concurrency Quota Test ===");
+
+    TaskScheduler scheduler;
+    scheduler.start(TEST_SCHEDULER_CONFIG_FOUR_THREADS);
+
+    TaskScheduler::GroupConfig group_config;
+    group_config.max_concurrent_tasks = 1;
+    TEST_ASSERT_TRUE(scheduler.configure_group("bulk", group_config));
+
+    std::atomic<int> running_count{0};
+    std::atomic<int> max_running_count{0};
+    std::atomic<int> other_count{0};
+    int task_count = 8;
+    for (int i = 0; i < task_count; i++) {
+        scheduler.post([&]() {
+            int running = ++running_count;
+            int max_running = max_running_count.load();
+            while ((running > max_running) && !max_running_count.compare_exchange_weak(max_running, running)) {
+            }
+            vTaskDelay(pdMS_TO_TICKS(10));
+            running_count--;
+        }, nullptr, "bulk");
+        // Tasks of other groups are not held back by the quota
+        scheduler.post([&other_count]() {
+            other_count++;
+        });
+    }
+
+    TEST_ASSERT_TRUE(scheduler.wait_all(2000));
+    vTaskDelay(pdMS_TO_TICKS(10));
+
+    TEST_ASSERT_EQUAL(1, max_running_count.load());
+    TEST_ASSERT_EQUAL(task_count, other_count.load());
+
+    auto statistics = scheduler.get_group_statistics("bulk");
+    BROOKESIA_LOGI("Bulk statistics: %1%", BROOKESIA_DESCRIBE_TO_STR(statistics));
+    TEST_ASSERT_EQUAL(task_count, statistics.executed_tasks);
+    TEST_ASSERT_GREATER_THAN(0, statistics.throttled_count);
+
+    scheduler.stop();
+}
+
+TEST_CASE("Test group CPU quota", "[utils][task_scheduler][quota][cpu]")
+{
+    BROOKESIA_LOGI("=== TaskScheduler Group CPU Quota Test ===");
+
+    TaskScheduler scheduler;
+    scheduler.start(TEST_SCHEDULER_CONFIG_TWO_THREADS);
+
+    // 5ms of CPU time every 50ms, one task at a time so that the budget is checked before each task
+    TaskScheduler::GroupConfig group_config;
+    group_config.max_concurrent_tasks = 1;
+    group_config.cpu_quota_ms = 5;
+    group_config.cpu_quota_period_ms = 50;
+    TEST_ASSERT_TRUE(scheduler.configure_group("sampling", group_config));
+
+    int task_count = 4;
+    auto start_time = esp_timer_get_time();
+    for (int i = 0; i < task_count; i++) {
+        scheduler.post([]() {
+            auto end_time = esp_timer_get_time() + 6000;
+            while (esp_timer_get_time() < end_time) {
+            }
+        }, nullptr, "sampling");
+    }
+    TEST_ASSERT_TRUE(scheduler.wait_all(2000));
+
+    // Each task uses up the budget of its period
+    int64_t elapsed_ms = (esp_timer_get_time() - start_time) / 1000;
+    BROOKESIA_LOGI("Elapsed: %1% ms", elapsed_ms);
+    TEST_ASSERT_GREATER_OR_EQUAL((task_count - 1) * 50 - 10, elapsed_ms);
+
+    // Removing the quota releases the group
+    group_config.cpu_quota_ms = 0;
+    group_config.max_concurrent_tasks = 0;
+    TEST_ASSERT_TRUE(scheduler.configure_group("sampling", group_config));
+    start_time = esp_timer_get_time();
+    for (int i = 0; i < task_count; i++) {
+        scheduler.post([]() {
+            vTaskDelay(pdMS_TO_TICKS(6));
+        }, nullptr, "sampling");
+    }
+    TEST_ASSERT_TRUE(scheduler.wait_all(2000));
+    elapsed_ms = (esp_timer_get_time() - start_time) / 1000;
+    TEST_ASSERT_LESS_THAN(100, elapsed_ms);
+
+    scheduler.stop();
+}
+
+TEST_CASE("Test timing wheel timer backend", "[utils][task_scheduler][timing_wheel][basic]")
+{
+    BROOKESIA_LOGI("=== TaskScheduler Timing Wheel Backend Test ===");
+
+    TaskScheduler scheduler;
+    auto config = TEST_SCHEDULER_CONFIG_TWO_THREADS;
+    config.timer_backend = TaskScheduler::TimerBackend::TimingWheel;
+    scheduler.start(config);
+
+    // Delayed task
+    std::atomic<int> delayed_count{0};
+    TaskScheduler::TaskId delayed_id = 0;
+    auto start_time = esp_timer_get_time();
+    TEST_ASSERT_TRUE(scheduler.post_delayed([&delayed_count]() {
+        delayed_count++;
+    }, 50, &delayed_id));
+    TEST_ASSERT_TRUE(scheduler.wait(delayed_id, 1000));
+    int64_t elapsed_ms = (esp_timer_get_time() - start_time) / 1000;
+    TEST_ASSERT_EQUAL(1, delayed_count.load());
+    TEST_ASSERT_GREATER_OR_EQUAL(49, elapsed_ms);
+
+    // Canceled delayed task
+    TEST_ASSERT_TRUE(scheduler.post_delayed([&delayed_count]() {
+        delayed_count++;
+    }, 30, &delayed_id));
+    scheduler.cancel(delayed_id);
+    vTaskDelay(pdMS_TO_TICKS(60));
+    TEST_ASSERT_EQUAL(1, delayed_count.load());
+
+    // Periodic task, suspended and resumed
+    std::atomic<int> periodic_count{0};
+    TaskScheduler::TaskId periodic_id = 0;
+    TEST_ASSERT_TRUE(scheduler.post_periodic([&periodic_count]() {
+        periodic_count++;
+        return true;
+    }, 20, &periodic_id));
+    vTaskDelay(pdMS_TO_TICKS(50));
+    TEST_ASSERT_TRUE(scheduler.suspend(periodic_id));
+    int suspended_count = periodic_count.load();
+    TEST_ASSERT_GREATER_THAN(0, suspended_count);
+    vTaskDelay(pdMS_TO_TICKS(60));
+    TEST_ASSERT_EQUAL(suspended_count, periodic_count.load());
+    TEST_ASSERT_TRUE(scheduler.resume(periodic_id));
+    vTaskDelay(pdMS_TO_TICKS(70));
+    TEST_ASSERT_GREATER_THAN(suspended_count, periodic_count.load());
+    scheduler.cancel(periodic_id);
+
+    scheduler.stop();
+}
+
+TEST_CASE("Test timing wheel timer coalescing", "[utils][task_scheduler][timing_wheel][slack]")
+{
+    BROOKESIA_LOGI("=== TaskScheduler Timing Wheel Coalescing Test ===");
+
+    auto run_timers = [](TaskScheduler::TimerBackend backend, int slack_ms) {
+        TaskScheduler scheduler;
+        auto config = TEST_SCHEDULER_CONFIG_TWO_THREADS;
+        config.timer_backend = backend;
+        scheduler.start(config);
+
+        // Timers 1ms apart, all within the slack of each other
+        std::atomic<int> count{0};
+        int task_count = 32;
+        for (int i = 0; i < task_count; i++) {
+            scheduler.post_delayed([&count]() {
+                count++;
+            }, 10 + i, nullptr, "", {.slack_ms = slack_ms});
+        }
+        TEST_ASSERT_TRUE(scheduler.wait_all(2000));
+        TEST_ASSERT_EQUAL(task_count, count.load());
+
+        auto statistics = scheduler.get_statistics();
+        BROOKESIA_LOGI(
+            "Backend: %1%, slack: %2% ms, statistics: %3%", BROOKESIA_DESCRIBE_TO_STR(backend), slack_ms,
+            BROOKESIA_DESCRIBE_TO_STR(statistics)
+        );
+        scheduler.stop();
+
+        return statistics.timer_wakeups;
+    };
+
+    auto asio_wakeups = run_timers(TaskScheduler::TimerBackend::Asio, 64);
+    auto wheel_wakeups = run_timers(TaskScheduler::TimerBackend::TimingWheel, 0);
+    auto coalesced_wakeups = run_timers(TaskScheduler::TimerBackend::TimingWheel, 64);
+
+    // One wake-up per timer without the wheel, a few with the slack
+    TEST_ASSERT_EQUAL(32, asio_wakeups);
+    TEST_ASSERT_LESS_OR_EQUAL(wheel_wakeups, coalesced_wakeups);
+    TEST_ASSERT_LESS_OR_EQUAL(4, coalesced_wakeups);
+}
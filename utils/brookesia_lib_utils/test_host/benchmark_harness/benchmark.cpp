@@ -0,0 +1,232 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include "benchmark.hpp"
+
+namespace esp_brookesia::benchmark {
+
+// Nearest-rank percentile of sorted samples
+static double get_percentile(const std::vector<int64_t> &sorted, double percent)
+{
+    if (sorted.empty()) {
+        return 0;
+    }
+    auto rank = static_cast<size_t>(std::ceil(percent / 100.0 * sorted.size()));
+    return static_cast<double>(sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1]);
+}
+
+// Escape a string for a JSON string literal
+static std::string escape_json(const std::string &text)
+{
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {
+        switch (c) {
+        case '"':
+            escaped += "\\\"";
+            break;
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        case '\r':
+            escaped += "\\r";
+            break;
+        case '\t':
+            escaped += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char code[8];
+                snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned>(c));
+                escaped += code;
+            } else {
+                escaped += c;
+            }
+            break;
+        }
+    }
+    return escaped;
+}
+
+void Runner::add_samples(const std::string &name, std::vector<int64_t> samples, int64_t total_ns)
+{
+    add_result(name, std::move(samples), total_ns, false);
+}
+
+void Runner::add_latency_samples(const std::string &name, std::vector<int64_t> samples)
+{
+    add_result(name, std::move(samples), 0, true);
+}
+
+void Runner::add_result(const std::string &name, std::vector<int64_t> samples, int64_t total_ns, bool is_latency_only)
+{
+    Result result{
+        .name = name,
+        .iterations = samples.size(),
+        .is_latency_only = is_latency_only,
+    };
+    if (!samples.empty()) {
+        std::sort(samples.begin(), samples.end());
+        double sum = 0;
+        for (auto sample : samples) {
+            sum += static_cast<double>(sample);
+        }
+        result.min_ns = static_cast<double>(samples.front());
+        result.max_ns = static_cast<double>(samples.back());
+        result.mean_ns = sum / samples.size();
+        result.p50_ns = get_percentile(samples, 50);
+        result.p90_ns = get_percentile(samples, 90);
+        result.p99_ns = get_percentile(samples, 99);
+        if (!is_latency_only && (total_ns > 0)) {
+            result.ops_per_sec = samples.size() * 1e9 / total_ns;
+        }
+    }
+
+    printf(
+        "[bench] %-36s p50 %10.0f ns, p99 %10.0f ns (%zu iterations)\n", result.name.c_str(), result.p50_ns,
+        result.p99_ns, result.iterations
+    );
+    fflush(stdout);
+
+    results_.push_back(std::move(result));
+}
+
+void Runner::print_results() const
+{
+    printf("\n%-36s %10s %12s %12s %12s %12s %12s %12s %14s\n", "case", "iterations", "min(ns)", "mean(ns)",
+           "p50(ns)", "p90(ns)", "p99(ns)", "max(ns)", "ops/s");
+    for (const auto &result : results_) {
+        printf("%-36s %10zu %12.0f %12.0f %12.0f %12.0f %12.0f %12.0f ", result.name.c_str(), result.iterations,
+               result.min_ns, result.mean_ns, result.p50_ns, result.p90_ns, result.p99_ns, result.max_ns);
+        if (result.is_latency_only) {
+            printf("%14s\n", "-");
+        } else {
+            printf("%14.0f\n", result.ops_per_sec);
+        }
+    }
+}
+
+bool Runner::write_json(const std::string &path) const
+{
+    std::ofstream file(path);
+    if (!file) {
+        fprintf(stderr, "Failed to open %s\n", path.c_str());
+        return false;
+    }
+
+    // `ops_per_sec` is `null` for the latency-only cases
+    file << std::fixed << std::setprecision(1);
+    file << "{\n  \"unit\": \"ns\",\n  \"results\": [\n";
+    for (size_t i = 0; i < results_.size(); i++) {
+        const auto &result = results_[i];
+        file << "    {\"name\": \"" << escape_json(result.name) << "\", \"iterations\": " << result.iterations
+             << ", \"min\": " << result.min_ns << ", \"mean\": " << result.mean_ns << ", \"p50\": " << result.p50_ns
+             << ", \"p90\": " << result.p90_ns << ", \"p99\": " << result.p99_ns << ", \"max\": " << result.max_ns
+             << ", \"ops_per_sec\": ";
+        if (result.is_latency_only) {
+            file << "null";
+        } else {
+            file << result.ops_per_sec;
+        }
+        file << "}" << ((i + 1 < results_.size()) ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+
+    return static_cast<bool>(file);
+}
+
+bool Runner::write_csv(const std::string &path) const
+{
+    std::ofstream file(path);
+    if (!file) {
+        fprintf(stderr, "Failed to open %s\n", path.c_str());
+        return false;
+    }
+
+    // `ops_per_sec` is empty for the latency-only cases
+    file << std::fixed << std::setprecision(1);
+    file << "name,iterations,min_ns,mean_ns,p50_ns,p90_ns,p99_ns,max_ns,ops_per_sec\n";
+    for (const auto &result : results_) {
+        file << result.name << "," << result.iterations << "," << result.min_ns << "," << result.mean_ns << ","
+             << result.p50_ns << "," << result.p90_ns << "," << result.p99_ns << "," << result.max_ns << ",";
+        if (!result.is_latency_only) {
+            file << result.ops_per_sec;
+        }
+        file << "\n";
+    }
+
+    return static_cast<bool>(file);
+}
+
+} // namespace esp_brookesia::benchmark
+
+using namespace esp_brookesia::benchmark;
+
+static void print_usage(const char *program)
+{
+    printf(
+        "Usage: %s [--iterations N] [--warmup N] [--filter NAME] [--json FILE] [--csv FILE]\n"
+        "  --iterations N  Measured iterations per case (default: 10000, or 500 for the cases waiting for another thread)\n"
+        "  --warmup N      Iterations run before measuring (default: 100)\n"
+        "  --filter NAME   Only run the cases whose name contains NAME\n"
+        "  --json FILE     Write the results as JSON\n"
+        "  --csv FILE      Write the results as CSV\n", program
+    );
+}
+
+int main(int argc, char *argv[])
+{
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if ((strcmp(arg, "-h") == 0) || (strcmp(arg, "--help") == 0)) {
+            print_usage(argv[0]);
+            return 0;
+        }
+        if (value == nullptr) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        if (strcmp(arg, "--iterations") == 0) {
+            options.iterations = std::max<size_t>(1, strtoull(value, nullptr, 10));
+        } else if (strcmp(arg, "--warmup") == 0) {
+            options.warmup_iterations = strtoull(value, nullptr, 10);
+        } else if (strcmp(arg, "--filter") == 0) {
+            options.filter = value;
+        } else if (strcmp(arg, "--json") == 0) {
+            options.json_path = value;
+        } else if (strcmp(arg, "--csv") == 0) {
+            options.csv_path = value;
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+        i++;
+    }
+
+    Runner runner(options);
+    run_cases(runner);
+    runner.print_results();
+
+    if (!options.json_path.empty() && !runner.write_json(options.json_path)) {
+        return 1;
+    }
+    if (!options.csv_path.empty() && !runner.write_csv(options.csv_path)) {
+        return 1;
+    }
+
+    return (runner.get_failure_count() > 0) ? 1 : 0;
+}
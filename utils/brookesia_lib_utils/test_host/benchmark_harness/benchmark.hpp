@@ -0,0 +1,171 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace esp_brookesia::benchmark {
+
+// Default iterations of the cases running on the caller thread, and of the ones waiting for another thread
+constexpr size_t SYNC_ITERATIONS = 10000;
+constexpr size_t ASYNC_ITERATIONS = 500;
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    size_t iterations = 0;          // Measured iterations per case (0 = default of each case)
+    size_t warmup_iterations = 100; // Iterations run before measuring
+    std::string filter;             // Only run the cases whose name contains it (empty = all)
+    std::string json_path;          // Write the results as JSON to this file (empty = disabled)
+    std::string csv_path;           // Write the results as CSV to this file (empty = disabled)
+};
+
+/**
+ * @brief Statistics of one case, all the durations are in nanoseconds
+ */
+struct Result {
+    std::string name;
+    size_t iterations = 0;
+    double min_ns = 0;
+    double mean_ns = 0;
+    double p50_ns = 0;
+    double p90_ns = 0;
+    double p99_ns = 0;
+    double max_ns = 0;
+    double ops_per_sec = 0; // Iterations per second of wall time, including the time spent between samples
+    bool is_latency_only = false;   // The samples are latencies (e.g. simulated or replayed), `ops_per_sec` is unset
+};
+
+class Runner {
+public:
+    explicit Runner(const Options &options)
+        : options_(options)
+    {}
+
+    /**
+     * @brief Check if a case is selected by the filter
+     */
+    bool is_selected(const std::string &name) const
+    {
+        return options_.filter.empty() || (name.find(options_.filter) != std::string::npos);
+    }
+
+    /**
+     * @brief Number of iterations of a case, the one of the options if set, otherwise `default_iterations`
+     */
+    size_t get_iterations(size_t default_iterations) const
+    {
+        return (options_.iterations > 0) ? options_.iterations : default_iterations;
+    }
+
+    /**
+     * @brief Time each call of `op(index)` and add the result
+     *
+     * @note `op` may be called from any thread, but only one case must run at a time.
+     */
+    template <typename Op>
+    void run(const std::string &name, size_t default_iterations, Op &&op)
+    {
+        if (!is_selected(name)) {
+            return;
+        }
+
+        size_t iterations = get_iterations(default_iterations);
+        for (size_t i = 0; i < options_.warmup_iterations; i++) {
+            op(i);
+        }
+
+        std::vector<int64_t> samples;
+        samples.reserve(iterations);
+        auto begin = Clock::now();
+        for (size_t i = 0; i < iterations; i++) {
+            auto start = Clock::now();
+            op(i);
+            samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        }
+        auto total_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count();
+
+        add_samples(name, std::move(samples), total_ns);
+    }
+
+    /**
+     * @brief Add a case whose samples were measured by the case itself (e.g. latencies across threads)
+     *
+     * @param name Case name
+     * @param samples Durations in nanoseconds
+     * @param total_ns Wall time of the case, used for `ops_per_sec`
+     */
+    void add_samples(const std::string &name, std::vector<int64_t> samples, int64_t total_ns);
+
+    /**
+     * @brief Add a case whose samples are latencies not tied to the wall time of the case (e.g. simulated or replayed
+     *        durations), no `ops_per_sec` is reported for it
+     *
+     * @param name Case name
+     * @param samples Durations in nanoseconds
+     */
+    void add_latency_samples(const std::string &name, std::vector<int64_t> samples);
+
+    /**
+     * @brief Record a case which could not run, the benchmark then exits with an error
+     */
+    void add_failure(const std::string &name, const std::string &reason)
+    {
+        fprintf(stderr, "[bench] %s failed: %s\n", name.c_str(), reason.c_str());
+        failure_count_++;
+    }
+
+    const std::vector<Result> &get_results() const
+    {
+        return results_;
+    }
+
+    size_t get_failure_count() const
+    {
+        return failure_count_;
+    }
+
+    void print_results() const;
+    bool write_json(const std::string &path) const;
+    bool write_csv(const std::string &path) const;
+
+private:
+    void add_result(const std::string &name, std::vector<int64_t> samples, int64_t total_ns, bool is_latency_only);
+
+    Options options_;
+    std::vector<Result> results_;
+    size_t failure_count_ = 0;
+};
+
+/**
+ * @brief Wait until `is_done()` returns true, spinning first to keep the wake-up latency out of the measurement
+ */
+template <typename Predicate>
+inline bool wait_until(Predicate &&is_done, std::chrono::milliseconds timeout = std::chrono::milliseconds(1000))
+{
+    auto deadline = Clock::now() + timeout;
+    for (size_t spin = 0; !is_done(); spin++) {
+        if (Clock::now() > deadline) {
+            return false;
+        }
+        if (spin > 1000) {
+            std::this_thread::yield();
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Run the cases of the benchmark, defined by each benchmark executable and called by the `main()` of the harness
+ */
+void run_cases(Runner &runner);
+
+} // namespace esp_brookesia::benchmark